@@ -133,5 +133,6 @@
 #include "hal/library/cryptlib/cryptlib_mldsa.h"
 #include "hal/library/cryptlib/cryptlib_mlkem.h"
 #include "hal/library/cryptlib/cryptlib_slhdsa.h"
+#include "hal/library/cryptlib/cryptlib_init.h"
 
 #endif /* CRYPTLIB_H */
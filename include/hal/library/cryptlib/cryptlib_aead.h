@@ -76,6 +76,98 @@ extern bool libspdm_aead_aes_gcm_decrypt(const uint8_t *key, size_t key_size,
                                          const uint8_t *data_in, size_t data_in_size,
                                          const uint8_t *tag, size_t tag_size,
                                          uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Allocates and initializes one AES-GCM context for subsequent use.
+ *
+ * The context holds the expanded key schedule so that it can be reused across many records
+ * without re-keying the cipher.
+ *
+ * @return  Pointer to the AES-GCM context that has been initialized.
+ *          If the allocation fails, NULL is returned.
+ **/
+extern void *libspdm_aead_aes_gcm_new(void);
+
+/**
+ * Release the specified AES-GCM context.
+ *
+ * The key material held by the context is cleared before the context is released.
+ *
+ * @param[in]  aead_ctx  Pointer to the AES-GCM context to be released.
+ **/
+extern void libspdm_aead_aes_gcm_free(void *aead_ctx);
+
+/**
+ * Sets the key of a AES-GCM context for subsequent encryption and decryption.
+ *
+ * key_size must be 16, 24 or 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the AES-GCM context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  Size of the encryption key in bytes.
+ *
+ * @retval true   The key was set successfully.
+ * @retval false  The key was not set.
+ **/
+extern bool libspdm_aead_aes_gcm_set_key(void *aead_ctx, const uint8_t *key, size_t key_size);
+
+/**
+ * Performs AEAD AES-GCM authenticated encryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ *
+ * @param[in]   aead_ctx       Pointer to the AES-GCM context that has been keyed.
+ * @param[in]   iv             Pointer to the IV value.
+ * @param[in]   iv_size        Size of the IV value in bytes.
+ * @param[in]   a_data         Pointer to the additional authenticated data.
+ * @param[in]   a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]   data_in        Pointer to the input data buffer to be encrypted.
+ * @param[in]   data_in_size   Size of the input data buffer in bytes.
+ * @param[out]  tag_out        Pointer to a buffer that receives the authentication tag output.
+ * @param[in]   tag_size       Size of the authentication tag in bytes.
+ * @param[out]  data_out       Pointer to a buffer that receives the encryption output.
+ * @param[out]  data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated encryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated encryption failed.
+ **/
+extern bool libspdm_aead_aes_gcm_encrypt_with_context(void *aead_ctx,
+                                                      const uint8_t *iv, size_t iv_size,
+                                                      const uint8_t *a_data, size_t a_data_size,
+                                                      const uint8_t *data_in, size_t data_in_size,
+                                                      uint8_t *tag_out, size_t tag_size,
+                                                      uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Performs AEAD AES-GCM authenticated decryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ *
+ * If data verification fails, false is returned.
+ *
+ * @param[in]   aead_ctx       Pointer to the AES-GCM context that has been keyed.
+ * @param[in]   iv             Pointer to the IV value.
+ * @param[in]   iv_size        Size of the IV value in bytes.
+ * @param[in]   a_data         Pointer to the additional authenticated data.
+ * @param[in]   a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]   data_in        Pointer to the input data buffer to be decrypted.
+ * @param[in]   data_in_size   Size of the input data buffer in bytes.
+ * @param[in]   tag            Pointer to a buffer that contains the authentication tag.
+ * @param[in]   tag_size       Size of the authentication tag in bytes.
+ * @param[out]  data_out       Pointer to a buffer that receives the decryption output.
+ * @param[out]  data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated decryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated decryption failed.
+ **/
+extern bool libspdm_aead_aes_gcm_decrypt_with_context(void *aead_ctx,
+                                                      const uint8_t *iv, size_t iv_size,
+                                                      const uint8_t *a_data, size_t a_data_size,
+                                                      const uint8_t *data_in, size_t data_in_size,
+                                                      const uint8_t *tag, size_t tag_size,
+                                                      uint8_t *data_out, size_t *data_out_size);
 #endif /* LIBSPDM_AEAD_GCM_SUPPORT */
 
 #if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
@@ -140,6 +232,98 @@ extern bool libspdm_aead_chacha20_poly1305_decrypt(
     size_t iv_size, const uint8_t *a_data, size_t a_data_size,
     const uint8_t *data_in, size_t data_in_size, const uint8_t *tag,
     size_t tag_size, uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Allocates and initializes one ChaCha20Poly1305 context for subsequent use.
+ *
+ * The context holds the expanded key schedule so that it can be reused across many records
+ * without re-keying the cipher.
+ *
+ * @return  Pointer to the ChaCha20Poly1305 context that has been initialized.
+ *          If the allocation fails, NULL is returned.
+ **/
+extern void *libspdm_aead_chacha20_poly1305_new(void);
+
+/**
+ * Release the specified ChaCha20Poly1305 context.
+ *
+ * The key material held by the context is cleared before the context is released.
+ *
+ * @param[in]  aead_ctx  Pointer to the ChaCha20Poly1305 context to be released.
+ **/
+extern void libspdm_aead_chacha20_poly1305_free(void *aead_ctx);
+
+/**
+ * Sets the key of a ChaCha20Poly1305 context for subsequent encryption and decryption.
+ *
+ * key_size must be 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the ChaCha20Poly1305 context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  Size of the encryption key in bytes.
+ *
+ * @retval true   The key was set successfully.
+ * @retval false  The key was not set.
+ **/
+extern bool libspdm_aead_chacha20_poly1305_set_key(void *aead_ctx, const uint8_t *key, size_t key_size);
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated encryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * @param[in]   aead_ctx       Pointer to the ChaCha20Poly1305 context that has been keyed.
+ * @param[in]   iv             Pointer to the IV value.
+ * @param[in]   iv_size        Size of the IV value in bytes.
+ * @param[in]   a_data         Pointer to the additional authenticated data.
+ * @param[in]   a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]   data_in        Pointer to the input data buffer to be encrypted.
+ * @param[in]   data_in_size   Size of the input data buffer in bytes.
+ * @param[out]  tag_out        Pointer to a buffer that receives the authentication tag output.
+ * @param[in]   tag_size       Size of the authentication tag in bytes.
+ * @param[out]  data_out       Pointer to a buffer that receives the encryption output.
+ * @param[out]  data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated encryption failed.
+ **/
+extern bool libspdm_aead_chacha20_poly1305_encrypt_with_context(void *aead_ctx,
+                                                                const uint8_t *iv, size_t iv_size,
+                                                                const uint8_t *a_data, size_t a_data_size,
+                                                                const uint8_t *data_in, size_t data_in_size,
+                                                                uint8_t *tag_out, size_t tag_size,
+                                                                uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated decryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * If data verification fails, false is returned.
+ *
+ * @param[in]   aead_ctx       Pointer to the ChaCha20Poly1305 context that has been keyed.
+ * @param[in]   iv             Pointer to the IV value.
+ * @param[in]   iv_size        Size of the IV value in bytes.
+ * @param[in]   a_data         Pointer to the additional authenticated data.
+ * @param[in]   a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]   data_in        Pointer to the input data buffer to be decrypted.
+ * @param[in]   data_in_size   Size of the input data buffer in bytes.
+ * @param[in]   tag            Pointer to a buffer that contains the authentication tag.
+ * @param[in]   tag_size       Size of the authentication tag in bytes.
+ * @param[out]  data_out       Pointer to a buffer that receives the decryption output.
+ * @param[out]  data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated decryption failed.
+ **/
+extern bool libspdm_aead_chacha20_poly1305_decrypt_with_context(void *aead_ctx,
+                                                                const uint8_t *iv, size_t iv_size,
+                                                                const uint8_t *a_data, size_t a_data_size,
+                                                                const uint8_t *data_in, size_t data_in_size,
+                                                                const uint8_t *tag, size_t tag_size,
+                                                                uint8_t *data_out, size_t *data_out_size);
 #endif /* LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT */
 
 #if LIBSPDM_AEAD_SM4_SUPPORT
@@ -206,6 +390,98 @@ extern bool libspdm_aead_sm4_gcm_decrypt(const uint8_t *key, size_t key_size,
                                          const uint8_t *data_in, size_t data_in_size,
                                          const uint8_t *tag, size_t tag_size,
                                          uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Allocates and initializes one SM4-GCM context for subsequent use.
+ *
+ * The context holds the expanded key schedule so that it can be reused across many records
+ * without re-keying the cipher.
+ *
+ * @return  Pointer to the SM4-GCM context that has been initialized.
+ *          If the allocation fails, NULL is returned.
+ **/
+extern void *libspdm_aead_sm4_gcm_new(void);
+
+/**
+ * Release the specified SM4-GCM context.
+ *
+ * The key material held by the context is cleared before the context is released.
+ *
+ * @param[in]  aead_ctx  Pointer to the SM4-GCM context to be released.
+ **/
+extern void libspdm_aead_sm4_gcm_free(void *aead_ctx);
+
+/**
+ * Sets the key of a SM4-GCM context for subsequent encryption and decryption.
+ *
+ * key_size must be 16, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the SM4-GCM context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  Size of the encryption key in bytes.
+ *
+ * @retval true   The key was set successfully.
+ * @retval false  The key was not set.
+ **/
+extern bool libspdm_aead_sm4_gcm_set_key(void *aead_ctx, const uint8_t *key, size_t key_size);
+
+/**
+ * Performs AEAD SM4-GCM authenticated encryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * @param[in]   aead_ctx       Pointer to the SM4-GCM context that has been keyed.
+ * @param[in]   iv             Pointer to the IV value.
+ * @param[in]   iv_size        Size of the IV value in bytes.
+ * @param[in]   a_data         Pointer to the additional authenticated data.
+ * @param[in]   a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]   data_in        Pointer to the input data buffer to be encrypted.
+ * @param[in]   data_in_size   Size of the input data buffer in bytes.
+ * @param[out]  tag_out        Pointer to a buffer that receives the authentication tag output.
+ * @param[in]   tag_size       Size of the authentication tag in bytes.
+ * @param[out]  data_out       Pointer to a buffer that receives the encryption output.
+ * @param[out]  data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD SM4-GCM authenticated encryption succeeded.
+ * @retval false  AEAD SM4-GCM authenticated encryption failed.
+ **/
+extern bool libspdm_aead_sm4_gcm_encrypt_with_context(void *aead_ctx,
+                                                      const uint8_t *iv, size_t iv_size,
+                                                      const uint8_t *a_data, size_t a_data_size,
+                                                      const uint8_t *data_in, size_t data_in_size,
+                                                      uint8_t *tag_out, size_t tag_size,
+                                                      uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Performs AEAD SM4-GCM authenticated decryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * If data verification fails, false is returned.
+ *
+ * @param[in]   aead_ctx       Pointer to the SM4-GCM context that has been keyed.
+ * @param[in]   iv             Pointer to the IV value.
+ * @param[in]   iv_size        Size of the IV value in bytes.
+ * @param[in]   a_data         Pointer to the additional authenticated data.
+ * @param[in]   a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]   data_in        Pointer to the input data buffer to be decrypted.
+ * @param[in]   data_in_size   Size of the input data buffer in bytes.
+ * @param[in]   tag            Pointer to a buffer that contains the authentication tag.
+ * @param[in]   tag_size       Size of the authentication tag in bytes.
+ * @param[out]  data_out       Pointer to a buffer that receives the decryption output.
+ * @param[out]  data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD SM4-GCM authenticated decryption succeeded.
+ * @retval false  AEAD SM4-GCM authenticated decryption failed.
+ **/
+extern bool libspdm_aead_sm4_gcm_decrypt_with_context(void *aead_ctx,
+                                                      const uint8_t *iv, size_t iv_size,
+                                                      const uint8_t *a_data, size_t a_data_size,
+                                                      const uint8_t *data_in, size_t data_in_size,
+                                                      const uint8_t *tag, size_t tag_size,
+                                                      uint8_t *data_out, size_t *data_out_size);
 #endif /* LIBSPDM_AEAD_SM4_SUPPORT */
 
 #endif /* CRYPTLIB_AEAD_H */
@@ -0,0 +1,36 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef CRYPTLIB_INIT_H
+#define CRYPTLIB_INIT_H
+
+/*=====================================================================================
+ *    Crypto Library Initialization
+ *=====================================================================================*/
+
+/**
+ * Prepares the crypto library for use.
+ *
+ * Calling this function is optional. A backend that keeps process-wide state, such as algorithm
+ * objects fetched from a provider, otherwise sets it up on first use. Calling it once at start-up
+ * moves that cost out of the first SPDM exchange. It may be called more than once.
+ *
+ * @retval true   The crypto library is ready.
+ * @retval false  The crypto library could not be initialized.
+ **/
+extern bool libspdm_cryptlib_init(void);
+
+/**
+ * Releases the process-wide state held by the crypto library.
+ *
+ * This function must not be called while another thread is using the crypto library. After it
+ * returns, the crypto library still works but no longer keeps process-wide state, and calling
+ * libspdm_cryptlib_init() again does not restore it. For the OpenSSL backend it must be called
+ * before OPENSSL_cleanup().
+ **/
+extern void libspdm_cryptlib_deinit(void);
+
+#endif /* CRYPTLIB_INIT_H */
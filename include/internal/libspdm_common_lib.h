@@ -39,6 +39,9 @@
 
 #define LIBSPDM_MAX_SPDM_SESSION_SEQUENCE_NUMBER 0xFFFFFFFFFFFFFFFFull
 
+/* Upper bound of libspdm_get_session_index_count, used to size the default session index. */
+#define LIBSPDM_SESSION_INDEX_MAX_COUNT(max_session_count) ((max_session_count) * 4)
+
 typedef struct {
     uint8_t spdm_version_count;
     spdm_version_number_t spdm_version[SPDM_MAX_VERSION_COUNT];
@@ -81,7 +84,12 @@ typedef struct {
 
 typedef struct {
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+#if LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+    /* Acquired through acquire_peer_cert_chain_buffer, NULL if the slot is empty. */
+    void *buffer;
+#else
     uint8_t buffer[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+#endif
     size_t buffer_size;
 #else
     uint8_t buffer_hash[LIBSPDM_MAX_HASH_SIZE];
@@ -124,6 +132,9 @@ typedef struct {
     bool basic_mut_auth_requested;
     uint8_t heartbeat_period;
 
+    /* Requester policy*/
+    bool portion_within_data_transfer_size;
+
     /*The device role*/
     bool is_requester;
 } libspdm_local_context_t;
@@ -375,6 +386,11 @@ typedef struct {
     libspdm_message_e_managed_buffer_t message_e;
     libspdm_message_e_managed_buffer_t message_encap_e;
 #else
+    /* VCA checkpoint: message_a hashed once with the hash algorithm and length it was built from.
+     * New M1M2, L1L2, IL1IL2 and TH digests start from a duplicate of it.*/
+    void *digest_context_vca;
+    uint32_t digest_context_vca_hash_algo;
+    size_t digest_context_vca_size;
     void *digest_context_m1m2;
     void *digest_context_mut_m1m2;
     void *digest_context_l1l2;
@@ -466,6 +482,11 @@ typedef struct {
     uint8_t end_session_attributes;
     uint8_t session_policy;
     uint8_t heartbeat_period;
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+    /* An APP message of a concurrent exchange ended the session. The session is not freed then,
+     * because other threads may look sessions up, but by libspdm_stop_session. */
+    bool free_pending;
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
     libspdm_session_transcript_t session_transcript;
     /* Register for the last KEY_UPDATE token and operation (responder only)*/
     spdm_key_update_request_t last_key_update_request;
@@ -492,6 +513,168 @@ typedef struct {
     bool use_large_cert_chain;
 } libspdm_encap_context_t;
 
+#if LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+/* Progress of a GET_CERTIFICATE exchange across the requests for each portion of the chain. */
+typedef struct {
+    uint8_t slot_id;
+    bool slot_storage_size_requested;
+    bool use_large_cert_chain;
+    bool chunk_enabled;
+    /* Length of each requested portion. */
+    uint32_t length;
+    uint32_t max_cert_chain_size;
+    uint32_t req_msg_header_size;
+    uint32_t rsp_msg_header_size;
+    /* Offset and length of the portion in flight. */
+    uint32_t req_msg_offset;
+    uint32_t req_msg_length;
+    uint32_t remainder_length;
+    uint32_t total_responder_cert_chain_buffer_length;
+    size_t cert_chain_capacity;
+    /* Size of the chain received so far. */
+    size_t cert_chain_size;
+} libspdm_get_certificate_state_t;
+#endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/* Key exchange contexts kept from the KEY_EXCHANGE request until its response is processed. */
+typedef struct {
+    void *dhe_context;
+    void *kem_context;
+} libspdm_key_exchange_state_t;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+/* Arguments of an asynchronous request. The pointers belong to the Integrator and must stay valid
+ * until the request is done. */
+typedef struct {
+    uint8_t *slot_mask;
+    void *total_digest_buffer;
+} libspdm_async_get_digest_param_t;
+
+typedef struct {
+    uint8_t request_attribute;
+    uint8_t measurement_operation;
+    uint8_t slot_id_param;
+    const void *requester_context;
+    uint8_t *content_changed;
+    uint8_t *number_of_blocks;
+    uint32_t *measurement_record_length;
+    void *measurement_record;
+    const void *requester_nonce_in;
+    void *requester_nonce;
+    void *responder_nonce;
+    void *opaque_data;
+    size_t *opaque_data_size;
+} libspdm_async_get_measurement_param_t;
+
+typedef struct {
+    bool get_version_only;
+} libspdm_async_init_connection_param_t;
+
+#if LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+typedef struct {
+    uint8_t slot_id;
+    uint32_t length;
+    size_t *cert_chain_size;
+    void *cert_chain;
+    const void **trust_anchor;
+    size_t *trust_anchor_size;
+    /* True once state is initialized for the request of the first portion. */
+    bool started;
+    libspdm_get_certificate_state_t state;
+} libspdm_async_get_certificate_param_t;
+#endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+typedef struct {
+    uint8_t slot_id;
+    const void *requester_context;
+    uint8_t measurement_hash_type;
+    void *measurement_hash;
+    uint8_t *slot_mask;
+    const void *requester_nonce_in;
+    void *requester_nonce;
+    void *responder_nonce;
+    void *opaque_data;
+    size_t *opaque_data_size;
+} libspdm_async_challenge_param_t;
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+typedef struct {
+    uint8_t measurement_hash_type;
+    uint8_t slot_id;
+    uint8_t session_policy;
+    uint32_t *session_id;
+    uint8_t *heartbeat_period;
+    void *measurement_hash;
+    /* From KEY_EXCHANGE_RSP, for FINISH. */
+    uint8_t req_slot_id_param;
+    libspdm_key_exchange_state_t state;
+} libspdm_async_start_session_param_t;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+typedef struct {
+    /* See libspdm_async_state_t. */
+    uint8_t state;
+    /* Request code of the operation in progress. */
+    uint8_t request_code;
+    /* Set by the operation when its response is processed, to continue with another request.
+     * Zero if the operation is done. */
+    uint8_t next_request_code;
+    /* True if the request in flight is RESPOND_IF_READY. */
+    bool respond_if_ready;
+    /* Number of BUSY responses that are still retried. */
+    uint8_t retry;
+    bool session_id_valid;
+    uint32_t session_id;
+    /* While state is LIBSPDM_ASYNC_STATE_NEED_SEND, the transport message in the acquired sender
+     * buffer. */
+    void *message;
+    size_t message_size;
+    /* Delay before sending, or time to wait for the response, in microseconds. */
+    uint64_t timeout;
+    /* Result of the operation once state is LIBSPDM_ASYNC_STATE_DONE. */
+    libspdm_return_t status;
+    union {
+        libspdm_async_get_digest_param_t get_digest;
+        libspdm_async_get_measurement_param_t get_measurement;
+        libspdm_async_init_connection_param_t init_connection;
+#if LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+        libspdm_async_get_certificate_param_t get_certificate;
+#endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+        libspdm_async_challenge_param_t challenge;
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+        libspdm_async_start_session_param_t start_session;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+    } param;
+} libspdm_async_context_t;
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/* The last verified measurement record of one measurement operation. */
+typedef struct {
+    bool valid;
+    /* The slot whose key signed the record, 0xF for the provisioned public key. */
+    uint8_t slot_id;
+    uint8_t measurement_operation;
+    uint8_t number_of_blocks;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record_digest[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_measurement_cache_entry_t;
+
+typedef struct {
+    libspdm_measurement_cache_entry_t entry[LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT];
+    /* The entry replaced when a new measurement operation is cached. */
+    uint8_t next_entry;
+    /* Size of the last measurement extension log, to detect that the log grew. */
+    size_t mel_size;
+} libspdm_measurement_cache_t;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
 #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
 typedef struct {
     bool chunk_in_use;
@@ -560,6 +743,12 @@ typedef struct {
     libspdm_device_acquire_receiver_buffer_func acquire_receiver_buffer;
     libspdm_device_release_receiver_buffer_func release_receiver_buffer;
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+    /* Storage for connection_info.peer_used_cert_chain[].buffer */
+    libspdm_acquire_peer_cert_chain_buffer_func acquire_peer_cert_chain_buffer;
+    libspdm_release_peer_cert_chain_buffer_func release_peer_cert_chain_buffer;
+#endif
+
     /* Transport Layer information */
     libspdm_transport_encode_message_func transport_encode_message;
     libspdm_transport_decode_message_func transport_decode_message;
@@ -608,7 +797,19 @@ typedef struct {
     libspdm_connection_info_t connection_info;
     libspdm_transcript_t transcript;
 
-    libspdm_session_info_t session_info[LIBSPDM_MAX_SESSION_COUNT];
+    /* Session table. It is session_info_default unless a table has been provided to
+     * libspdm_init_context_with_session_table. */
+    libspdm_session_info_t *session_info;
+    uint32_t max_session_count;
+
+    /* Open-addressing index from session ID to session table entry, see
+     * libspdm_get_session_info_via_session_id. Each entry holds the table index plus one,
+     * and 0 marks an empty entry. session_index_count is a power of two. */
+    uint16_t *session_index;
+    uint32_t session_index_count;
+
+    libspdm_session_info_t session_info_default[LIBSPDM_MAX_SESSION_COUNT];
+    uint16_t session_index_default[LIBSPDM_SESSION_INDEX_MAX_COUNT(LIBSPDM_MAX_SESSION_COUNT)];
 
     /* Buffer that the Responder uses to store the Requester's certificate chain for
      * mutual authentication. */
@@ -657,11 +858,24 @@ typedef struct {
 
     uint8_t sequence_number_endian;
 
+    /* see LIBSPDM_DATA_SEQUENCE_NUMBER_REPLAY_WINDOW */
+    uint8_t replay_window_size;
+
 #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
     /* Chunk specific context */
     libspdm_chunk_context_t chunk_context;
 #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+    /* State of the request that is run by the non-blocking Requester API (requester only) */
+    libspdm_async_context_t async_context;
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    /* Digests of verified measurement records for libspdm_get_measurement_cached (requester only) */
+    libspdm_measurement_cache_t measurement_cache;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
 #if LIBSPDM_ENABLE_MSG_LOG
     libspdm_msg_log_t msg_log;
 #endif /* LIBSPDM_ENABLE_MSG_LOG */
@@ -689,6 +903,11 @@ typedef struct {
 #if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
     libspdm_meas_log_reset_callback_func spdm_meas_log_reset_callback;
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+    /* Source of pre-generated ephemeral DHE key pairs (responder only) */
+    libspdm_acquire_dhe_key_pair_func acquire_dhe_key_pair;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
 } libspdm_context_t;
 
 #define LIBSPDM_CONTEXT_SIZE_WITHOUT_SECURED_CONTEXT (sizeof(libspdm_context_t))
@@ -772,6 +991,13 @@ void libspdm_internal_dump_hex(const uint8_t *data, size_t size);
  * |<-Secure msg ->|<-Large msg ->|<-Snd/Rcv buf for chunk ->|<-Snd/Rcv buf for large msg ->|<-last request ->|<-cache request->|
  *
  *
+ * If concurrent sessions are supported, one session area per entry of the session table follows.
+ * +------------------------------+------------------------------+
+ * |       SENDER_RECEIVER        |       SENDER_RECEIVER        |
+ * +------------------------------+------------------------------+
+ * |<-Transport msg of session  ->|<-App msg of session        ->|
+ *
+ *
  * The value is configurable based on max_spdm_msg_size.
  * The value MAY be changed in different libspdm version.
  * It is exposed here, just in case the libspdm consumer wants to configure the setting at build time.
@@ -806,6 +1032,13 @@ uint32_t libspdm_get_scratch_buffer_cache_spdm_request_offset(libspdm_context_t
 uint32_t libspdm_get_scratch_buffer_cache_spdm_request_capacity(libspdm_context_t *spdm_context);
 #endif
 
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+/* seventh section */
+uint32_t libspdm_get_scratch_buffer_session_message_offset(libspdm_context_t *spdm_context,
+                                                          size_t session_index);
+uint32_t libspdm_get_scratch_buffer_session_message_capacity(libspdm_context_t *spdm_context);
+#endif
+
 /* combination */
 uint32_t libspdm_get_scratch_buffer_capacity(libspdm_context_t *spdm_context);
 
@@ -868,9 +1101,21 @@ void libspdm_init_managed_buffer(void *managed_buffer, size_t max_buffer_size);
 void libspdm_reset_message_buffer_via_request_code(void *context, void *session_info,
                                                    uint8_t request_code);
 
+/**
+ * Return the number of session index entries used for a session table.
+ *
+ * @param  max_session_count  The number of entries in the session table.
+ *
+ * @return the smallest power of two that is at least twice max_session_count.
+ **/
+uint32_t libspdm_get_session_index_count(size_t max_session_count);
+
 /**
  * This function initializes the session info.
  *
+ * session_info must be an entry of the session table of spdm_context.
+ * The session ID index is updated to match the new session ID.
+ *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  session_id                    The SPDM session ID.
  **/
@@ -1013,6 +1258,30 @@ bool libspdm_verify_peer_cert_chain_buffer_authority(libspdm_context_t *spdm_con
                                                      size_t cert_chain_buffer_size,
                                                      const void **trust_anchor,
                                                      size_t *trust_anchor_size);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+ * This function stores a verified peer certificate chain buffer including spdm_cert_chain_t
+ * header for a slot.
+ *
+ * If LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL is 1 then the previous buffer of the slot is released
+ * and a new buffer of cert_chain_buffer_size bytes is acquired.
+ *
+ * @param  spdm_context            A pointer to the SPDM context.
+ * @param  slot_id                 The slot ID of the certificate chain.
+ * @param  cert_chain_buffer       Certificate chain buffer including spdm_cert_chain_t header.
+ * @param  cert_chain_buffer_size  Size in bytes of the certificate chain buffer.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS           The certificate chain is stored.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL  The certificate chain is larger than
+ *                                          LIBSPDM_MAX_CERT_CHAIN_SIZE.
+ * @retval LIBSPDM_STATUS_ACQUIRE_FAIL      Unable to acquire a buffer for the certificate chain.
+ **/
+libspdm_return_t libspdm_set_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
+                                                    uint8_t slot_id,
+                                                    const void *cert_chain_buffer,
+                                                    size_t cert_chain_buffer_size);
+#endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
+
 /**
  * This function generates the challenge signature based upon m1m2 for authentication.
  *
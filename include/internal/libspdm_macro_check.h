@@ -86,6 +86,16 @@
     #error If endpoint is an event recipient then ENCAP_CAP must also be enabled.
 #endif
 
+#if (LIBSPDM_MEASUREMENT_CACHE_SUPPORT) && !(LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP)
+    #error If the measurement cache is enabled then MEAS_CAP must also be enabled.
+#endif
+
+#if (LIBSPDM_MEASUREMENT_CACHE_SUPPORT) && \
+    (((LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT) == 0) || \
+    ((LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT) > 255))
+    #error LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT must be between 1 and 255 inclusive.
+#endif
+
 #if ((LIBSPDM_MAX_VERSION_COUNT) == 0) || ((LIBSPDM_MAX_VERSION_COUNT) > 255)
     #error LIBSPDM_MAX_VERSION_COUNT must be between 1 and 255 inclusive.
 #endif
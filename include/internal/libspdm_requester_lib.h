@@ -50,6 +50,77 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
                                           bool is_app_message,
                                           size_t *response_size, void **response);
 
+/**
+ * Encode an SPDM or an APP request into a transport message without sending it.
+ *
+ * The parameters are the same as libspdm_send_request.
+ *
+ * @param  transport_message_size  On output, the size in bytes of the transport message.
+ * @param  transport_message       On output, the transport message. It is in the sender buffer,
+ *                                 or in the scratch buffer for a chunk.
+ **/
+libspdm_return_t libspdm_encode_request(void *spdm_context, const uint32_t *session_id,
+                                        bool is_app_message,
+                                        size_t request_size, void *request,
+                                        size_t *transport_message_size, void **transport_message);
+
+/**
+ * Decode a transport message that was received from a device into an SPDM or an APP response.
+ *
+ * The parameters are the same as libspdm_receive_response.
+ *
+ * @param  transport_message_size  The size in bytes of the transport message.
+ * @param  transport_message       The transport message.
+ **/
+libspdm_return_t libspdm_decode_response(void *spdm_context, const uint32_t *session_id,
+                                         bool is_app_message,
+                                         size_t transport_message_size, void *transport_message,
+                                         size_t *response_size, void **response);
+
+/**
+ * Return the time, in microseconds, that the Requester waits for the response to the request
+ * that was sent last. It depends on whether the request is a cryptographic request.
+ **/
+uint64_t libspdm_get_response_timeout(const libspdm_context_t *spdm_context);
+
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+/**
+ * Send an APP request in a session and receive its response, using only the area of the session
+ * in the scratch buffer. It may run at the same time as the same function for another session.
+ *
+ * The parameters are the same as libspdm_send_receive_data.
+ **/
+libspdm_return_t libspdm_send_receive_session_app_data(libspdm_context_t *spdm_context,
+                                                       uint32_t session_id,
+                                                       const void *request, size_t request_size,
+                                                       void *response, size_t *response_size);
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
+
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+/**
+ * Build a RESPOND_IF_READY request for the ResponseNotReady error in spdm_context->error_data.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  spdm_request  A buffer of at least sizeof(spdm_response_if_ready_request_t) bytes.
+ **/
+void libspdm_build_respond_if_ready_request(libspdm_context_t *spdm_context,
+                                            spdm_response_if_ready_request_t *spdm_request);
+
+/**
+ * Validate a ResponseNotReady error response and save its extended data in
+ * spdm_context->error_data.
+ *
+ * @param  spdm_context           A pointer to the SPDM context.
+ * @param  response_size          The size of the error response.
+ * @param  response               The error response.
+ * @param  original_request_code  The request code of the request that the error responds to.
+ **/
+libspdm_return_t libspdm_check_response_not_ready(libspdm_context_t *spdm_context,
+                                                  size_t response_size,
+                                                  const void *response,
+                                                  uint8_t original_request_code);
+#endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+
 /**
  * This function handles simple error code.
  *
@@ -222,6 +293,54 @@ libspdm_return_t libspdm_send_receive_key_exchange_ex(
     const void *requester_opaque_data, size_t requester_opaque_data_size,
     void *responder_opaque_data, size_t *responder_opaque_data_size);
 
+/**
+ * Check the parameters and the Requester state, generate the key exchange data and build a
+ * KEY_EXCHANGE request. On success the key exchange contexts are kept in state until
+ * libspdm_free_key_exchange_state is called.
+ *
+ * The other parameters are the same as libspdm_send_receive_key_exchange_ex.
+ *
+ * @param  state              The state of the exchange.
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  request            The request buffer.
+ **/
+libspdm_return_t libspdm_build_key_exchange_request(
+    libspdm_context_t *spdm_context, uint8_t measurement_hash_type,
+    uint8_t slot_id, uint8_t session_policy,
+    const void *requester_random_in, void *requester_random,
+    const void *requester_opaque_data, size_t requester_opaque_data_size,
+    libspdm_key_exchange_state_t *state, size_t *spdm_request_size, void *request);
+
+/**
+ * Validate and process a KEY_EXCHANGE_RSP response, and create the session.
+ * The response must not be an ERROR response.
+ *
+ * The other parameters are the same as libspdm_send_receive_key_exchange_ex.
+ *
+ * @param  state               The state of the exchange.
+ * @param  request             The KEY_EXCHANGE request that was sent.
+ * @param  spdm_request_size   The size in bytes of the request.
+ * @param  response            The response.
+ * @param  spdm_response_size  The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_key_exchange_response(
+    libspdm_context_t *spdm_context, uint8_t measurement_hash_type,
+    uint8_t slot_id, uint8_t session_policy, uint32_t *session_id,
+    uint8_t *heartbeat_period, uint8_t *req_slot_id_param, void *measurement_hash,
+    void *responder_random, void *responder_opaque_data, size_t *responder_opaque_data_size,
+    libspdm_key_exchange_state_t *state, const void *request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size);
+
+/**
+ * Free the key exchange contexts that are still held by a KEY_EXCHANGE exchange.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  state         The state of the exchange.
+ **/
+void libspdm_free_key_exchange_state(libspdm_context_t *spdm_context,
+                                     libspdm_key_exchange_state_t *state);
+
 /**
  * This function sends FINISH and receives FINISH_RSP for SPDM finish.
  *
@@ -244,6 +363,43 @@ libspdm_return_t libspdm_send_receive_finish_ex(
     size_t requester_opaque_data_size,
     void *responder_opaque_data,
     size_t *responder_opaque_data_size);
+
+/**
+ * Check the parameters and the session state, and build a FINISH request.
+ *
+ * The other parameters are the same as libspdm_send_receive_finish_ex.
+ *
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  request            The request buffer.
+ **/
+libspdm_return_t libspdm_build_finish_request(libspdm_context_t *spdm_context,
+                                              uint32_t session_id,
+                                              uint8_t req_slot_id_param,
+                                              const void *requester_opaque_data,
+                                              size_t requester_opaque_data_size,
+                                              size_t *spdm_request_size,
+                                              void *request);
+
+/**
+ * Validate and process a FINISH_RSP response, and establish the session.
+ * The response must not be an ERROR response.
+ *
+ * The other parameters are the same as libspdm_send_receive_finish_ex.
+ *
+ * @param  request             The FINISH request that was sent.
+ * @param  spdm_request_size   The size in bytes of the request.
+ * @param  response            The response.
+ * @param  spdm_response_size  The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_finish_response(libspdm_context_t *spdm_context,
+                                                 uint32_t session_id,
+                                                 void *responder_opaque_data,
+                                                 size_t *responder_opaque_data_size,
+                                                 const void *request,
+                                                 size_t spdm_request_size,
+                                                 void *response,
+                                                 size_t spdm_response_size);
 #endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
 
 #if LIBSPDM_ENABLE_CAPABILITY_PSK_CAP
@@ -538,6 +694,337 @@ libspdm_return_t libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
                                                size_t *response_size,
                                                void **response);
 
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+/**
+ * Encode an SPDM request into a transport message without sending it.
+ *
+ * It is the non-blocking counterpart of libspdm_send_spdm_request. The request must fit in a
+ * single message, because the chunk transfer is not supported.
+ *
+ * @param  spdm_context            The SPDM context for the device.
+ * @param  session_id              Indicate if the request is a secured message.
+ * @param  request_size            Size in bytes of the request.
+ * @param  request                 The request. It must be in the sender buffer.
+ * @param  transport_message_size  On output, the size in bytes of the transport message.
+ * @param  transport_message       On output, the transport message in the sender buffer.
+ **/
+libspdm_return_t libspdm_encode_spdm_request(libspdm_context_t *spdm_context,
+                                             const uint32_t *session_id,
+                                             size_t request_size, void *request,
+                                             size_t *transport_message_size,
+                                             void **transport_message);
+
+/**
+ * Decode a transport message into an SPDM response.
+ *
+ * It is the non-blocking counterpart of libspdm_receive_spdm_response. A response that the
+ * Responder sends in chunks is returned as the ERROR(LargeResponse) response.
+ *
+ * @param  spdm_context            The SPDM context for the device.
+ * @param  session_id              Indicate if the response is a secured message.
+ * @param  transport_message_size  The size in bytes of the transport message.
+ * @param  transport_message       The transport message.
+ * @param  response_size           On output, the size in bytes of the response.
+ * @param  response                On output, the response. It is in the transport message or,
+ *                                 for a secured message, in the scratch buffer.
+ **/
+libspdm_return_t libspdm_decode_spdm_response(libspdm_context_t *spdm_context,
+                                              const uint32_t *session_id,
+                                              size_t transport_message_size,
+                                              void *transport_message,
+                                              size_t *response_size,
+                                              void **response);
+
+/**
+ * Start an asynchronous request and build its first message.
+ *
+ * @param  spdm_context  The SPDM context for the device.
+ * @param  session_id    Indicate if the request is a secured message.
+ * @param  request_code  The request code of the operation.
+ * @param  param         The arguments of the operation, copied to async_context.param.
+ * @param  param_size    The size in bytes of param.
+ *
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL  Another asynchronous request is in progress.
+ **/
+libspdm_return_t libspdm_async_start(libspdm_context_t *spdm_context,
+                                     const uint32_t *session_id,
+                                     uint8_t request_code,
+                                     const void *param, size_t param_size);
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
+/**
+ * Reset the connection and build a GET_VERSION request.
+ *
+ * @param  spdm_context       A pointer to the SPDM context.
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  spdm_request       The request buffer.
+ **/
+void libspdm_build_get_version_request(libspdm_context_t *spdm_context,
+                                       size_t *spdm_request_size,
+                                       spdm_get_version_request_t *spdm_request);
+
+/**
+ * Validate and process a VERSION response, including an ERROR response.
+ *
+ * @param  spdm_context                A pointer to the SPDM context.
+ * @param  version_number_entry_count  See libspdm_get_version.
+ * @param  version_number_entry        See libspdm_get_version.
+ * @param  spdm_request                The GET_VERSION request that was sent.
+ * @param  spdm_request_size           The size in bytes of the request.
+ * @param  response                    The response.
+ * @param  spdm_response_size          The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_version_response(libspdm_context_t *spdm_context,
+                                                  uint8_t *version_number_entry_count,
+                                                  spdm_version_number_t *version_number_entry,
+                                                  const spdm_get_version_request_t *spdm_request,
+                                                  size_t spdm_request_size,
+                                                  void *response,
+                                                  size_t spdm_response_size);
+
+/**
+ * Check the Requester state and build a GET_CAPABILITIES request.
+ *
+ * @param  spdm_context              A pointer to the SPDM context.
+ * @param  supported_algs_requested  Request the supported algorithms of the Responder.
+ * @param  spdm_request_size         On input, the size in bytes of the request buffer.
+ *                                   On output, the size in bytes of the request.
+ * @param  spdm_request              The request buffer.
+ **/
+libspdm_return_t libspdm_build_get_capabilities_request(
+    libspdm_context_t *spdm_context, bool supported_algs_requested,
+    size_t *spdm_request_size, spdm_get_capabilities_request_t *spdm_request);
+
+/**
+ * Validate and process a CAPABILITIES response, including an ERROR response.
+ *
+ * @param  spdm_context           A pointer to the SPDM context.
+ * @param  supported_algs_length  See libspdm_get_capabilities_with_supported_algs.
+ * @param  supported_algs         See libspdm_get_capabilities_with_supported_algs.
+ * @param  spdm_request           The GET_CAPABILITIES request that was sent.
+ * @param  spdm_request_size      The size in bytes of the request.
+ * @param  response               The response.
+ * @param  spdm_response_size     The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_capabilities_response(
+    libspdm_context_t *spdm_context, size_t *supported_algs_length, void *supported_algs,
+    const spdm_get_capabilities_request_t *spdm_request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size);
+
+/**
+ * Check the Requester state and build a NEGOTIATE_ALGORITHMS request.
+ *
+ * @param  spdm_context       A pointer to the SPDM context.
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  request            The request buffer.
+ **/
+libspdm_return_t libspdm_build_negotiate_algorithms_request(
+    libspdm_context_t *spdm_context, size_t *spdm_request_size, void *request);
+
+/**
+ * Validate and process an ALGORITHMS response, including an ERROR response.
+ *
+ * @param  spdm_context        A pointer to the SPDM context.
+ * @param  request             The NEGOTIATE_ALGORITHMS request that was sent.
+ * @param  spdm_request_size   The size in bytes of the request.
+ * @param  response            The response.
+ * @param  spdm_response_size  The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_algorithms_response(
+    libspdm_context_t *spdm_context, const void *request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size);
+
+#if LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+/**
+ * Check the Requester state and build a GET_DIGESTS request.
+ *
+ * @param  spdm_context       A pointer to the SPDM context.
+ * @param  session_id         Indicates if it is a secured message protected via SPDM session.
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  spdm_request       The request buffer.
+ **/
+libspdm_return_t libspdm_build_get_digest_request(libspdm_context_t *spdm_context,
+                                                  const uint32_t *session_id,
+                                                  size_t *spdm_request_size,
+                                                  spdm_get_digest_request_t *spdm_request);
+
+/**
+ * Validate and process a DIGESTS response. The response must not be an ERROR response.
+ *
+ * @param  spdm_context         A pointer to the SPDM context.
+ * @param  session_id           Indicates if it is a secured message protected via SPDM session.
+ * @param  slot_mask            See libspdm_get_digest.
+ * @param  total_digest_buffer  See libspdm_get_digest.
+ * @param  spdm_request         The GET_DIGESTS request that was sent.
+ * @param  spdm_request_size    The size in bytes of the request.
+ * @param  response             The response.
+ * @param  spdm_response_size   The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_digests_response(libspdm_context_t *spdm_context,
+                                                  const uint32_t *session_id,
+                                                  uint8_t *slot_mask,
+                                                  void *total_digest_buffer,
+                                                  const spdm_get_digest_request_t *spdm_request,
+                                                  size_t spdm_request_size,
+                                                  void *response,
+                                                  size_t spdm_response_size);
+
+/**
+ * Check the parameters and the Requester state of a GET_CERTIFICATE exchange, reset its
+ * transcript and initialize its state.
+ *
+ * The other parameters are the same as libspdm_get_certificate_ex.
+ *
+ * @param  cert_chain_capacity                The size in bytes of the certificate chain buffer.
+ * @param  slot_storage_size_requested        Request the slot storage size instead of the chain.
+ * @param  portion_within_data_transfer_size  Keep each portion within DataTransferSize.
+ * @param  state                              The state of the exchange.
+ **/
+libspdm_return_t libspdm_start_get_certificate(libspdm_context_t *spdm_context,
+                                               const uint32_t *session_id,
+                                               uint8_t slot_id,
+                                               uint32_t length,
+                                               size_t cert_chain_capacity,
+                                               bool slot_storage_size_requested,
+                                               bool portion_within_data_transfer_size,
+                                               libspdm_get_certificate_state_t *state);
+
+/**
+ * Build the GET_CERTIFICATE request for the next portion of the certificate chain.
+ *
+ * @param  spdm_context       A pointer to the SPDM context.
+ * @param  state              The state of the exchange.
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  spdm_request       The request buffer.
+ **/
+void libspdm_build_get_certificate_request(libspdm_context_t *spdm_context,
+                                           libspdm_get_certificate_state_t *state,
+                                           size_t *spdm_request_size,
+                                           spdm_get_certificate_large_request_t *spdm_request);
+
+/**
+ * Validate and process a CERTIFICATE response, and append its portion to the certificate chain.
+ * The response must not be an ERROR response. The exchange is complete once
+ * state->remainder_length is 0.
+ *
+ * @param  spdm_context        A pointer to the SPDM context.
+ * @param  session_id          Indicates if it is a secured message protected via SPDM session.
+ * @param  state               The state of the exchange.
+ * @param  cert_chain          The certificate chain buffer.
+ * @param  slot_storage_size   See libspdm_get_slot_storage_size.
+ * @param  spdm_request        The GET_CERTIFICATE request that was sent.
+ * @param  spdm_request_size   The size in bytes of the request.
+ * @param  response            The response.
+ * @param  spdm_response_size  The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_certificate_response(
+    libspdm_context_t *spdm_context, const uint32_t *session_id,
+    libspdm_get_certificate_state_t *state, void *cert_chain, uint32_t *slot_storage_size,
+    const spdm_get_certificate_large_request_t *spdm_request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size);
+
+/**
+ * Verify the received certificate chain and record it, or its hash and leaf public key, for the
+ * slot.
+ *
+ * The other parameters are the same as libspdm_get_certificate_ex.
+ *
+ * @param  state  The state of the completed exchange.
+ *
+ * @retval LIBSPDM_STATUS_VERIF_NO_AUTHORITY  The chain is recorded but its root is not trusted.
+ **/
+libspdm_return_t libspdm_verify_certificate_chain(libspdm_context_t *spdm_context,
+                                                  const libspdm_get_certificate_state_t *state,
+                                                  void *cert_chain,
+                                                  const void **trust_anchor,
+                                                  size_t *trust_anchor_size);
+#endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+/**
+ * Check the Requester state and build a CHALLENGE request.
+ *
+ * The other parameters are the same as libspdm_challenge_ex2.
+ *
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  spdm_request       The request buffer.
+ **/
+libspdm_return_t libspdm_build_challenge_request(libspdm_context_t *spdm_context,
+                                                 uint8_t slot_id,
+                                                 const void *requester_context,
+                                                 uint8_t measurement_hash_type,
+                                                 const void *requester_nonce_in,
+                                                 void *requester_nonce,
+                                                 size_t *spdm_request_size,
+                                                 spdm_challenge_request_t *spdm_request);
+
+/**
+ * Validate and process a CHALLENGE_AUTH response and verify its signature. The response must not
+ * be an ERROR response. The basic mutual authentication that the response may request is left to
+ * the caller.
+ *
+ * The other parameters are the same as libspdm_challenge_ex2.
+ *
+ * @param  spdm_request        The CHALLENGE request that was sent.
+ * @param  spdm_request_size   The size in bytes of the request.
+ * @param  response            The response.
+ * @param  spdm_response_size  The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_challenge_auth_response(
+    libspdm_context_t *spdm_context, uint8_t slot_id, uint8_t measurement_hash_type,
+    void *measurement_hash, uint8_t *slot_mask, void *responder_nonce,
+    void *opaque_data, size_t *opaque_data_size,
+    const spdm_challenge_request_t *spdm_request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size);
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+/**
+ * Check the Requester state and build a GET_MEASUREMENTS request.
+ *
+ * The other parameters are the same as libspdm_get_measurement_ex2.
+ *
+ * @param  spdm_request_size  On input, the size in bytes of the request buffer.
+ *                            On output, the size in bytes of the request.
+ * @param  spdm_request       The request buffer.
+ **/
+libspdm_return_t libspdm_build_get_measurement_request(libspdm_context_t *spdm_context,
+                                                       const uint32_t *session_id,
+                                                       uint8_t request_attribute,
+                                                       uint8_t measurement_operation,
+                                                       uint8_t slot_id_param,
+                                                       const void *requester_context,
+                                                       const void *requester_nonce_in,
+                                                       void *requester_nonce,
+                                                       size_t *spdm_request_size,
+                                                       spdm_get_measurements_request_t *spdm_request);
+
+/**
+ * Validate and process a MEASUREMENTS response, and verify its signature if one was requested.
+ * The response must not be an ERROR response. On failure the caller resets the L1/L2 transcript.
+ *
+ * The other parameters are the same as libspdm_get_measurement_ex2.
+ *
+ * @param  spdm_request        The GET_MEASUREMENTS request that was sent.
+ * @param  spdm_request_size   The size in bytes of the request.
+ * @param  spdm_response       The response.
+ * @param  spdm_response_size  The size in bytes of the response.
+ **/
+libspdm_return_t libspdm_process_measurements_response(
+    libspdm_context_t *spdm_context, const uint32_t *session_id,
+    uint8_t request_attribute, uint8_t measurement_operation, uint8_t slot_id_param,
+    uint8_t *content_changed, uint8_t *number_of_blocks,
+    uint32_t *measurement_record_length, void *measurement_record,
+    void *responder_nonce, void *opaque_data, size_t *opaque_data_size,
+    const spdm_get_measurements_request_t *spdm_request, size_t spdm_request_size,
+    spdm_measurements_response_t *spdm_response, size_t spdm_response_size);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
 /**
  * This function allocates half of session ID for a requester.
  *
@@ -671,4 +1158,24 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
                                           size_t sign_data_size);
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
 
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/**
+ * This function forgets the cached measurement records that were verified with the key of a slot,
+ * because the certificate chain of the slot was read again.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  slot_id       The slot, or 0xF for the provisioned public key.
+ **/
+void libspdm_invalidate_measurement_cache_slot(libspdm_context_t *spdm_context, uint8_t slot_id);
+
+/**
+ * This function forgets the cached measurement records if the size of the measurement extension
+ * log differs from the size of the last log that was read.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  mel_size      The size in bytes of the measurement extension log.
+ **/
+void libspdm_update_measurement_cache_mel(libspdm_context_t *spdm_context, size_t mel_size);
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
 #endif /* SPDM_REQUESTER_LIB_INTERNAL_H */
@@ -33,9 +33,17 @@ typedef struct {
     uint8_t request_handshake_encryption_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
     uint8_t request_handshake_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
     uint64_t request_handshake_sequence_number;
+    uint64_t request_handshake_replay_bitmap;
     uint8_t response_handshake_encryption_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
     uint8_t response_handshake_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
     uint64_t response_handshake_sequence_number;
+    uint64_t response_handshake_replay_bitmap;
+    /* Keyed AEAD contexts for the encryption keys above. NULL if not prepared. */
+    void *request_handshake_aead_context;
+    void *response_handshake_aead_context;
+    /* HMAC contexts keyed with the finished keys above. NULL if not prepared. */
+    void *request_finished_key_hmac_context;
+    void *response_finished_key_hmac_context;
 } libspdm_session_info_struct_handshake_secret_t;
 
 typedef struct {
@@ -44,9 +52,14 @@ typedef struct {
     uint8_t request_data_encryption_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
     uint8_t request_data_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
     uint64_t request_data_sequence_number;
+    uint64_t request_data_replay_bitmap;
     uint8_t response_data_encryption_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
     uint8_t response_data_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
     uint64_t response_data_sequence_number;
+    uint64_t response_data_replay_bitmap;
+    /* Keyed AEAD contexts for the encryption keys above. NULL if not prepared. */
+    void *request_data_aead_context;
+    void *response_data_aead_context;
 } libspdm_session_info_struct_application_secret_t;
 
 typedef struct {
@@ -78,6 +91,10 @@ typedef struct {
     #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_CAP */
     uint8_t export_master_secret[LIBSPDM_MAX_HASH_SIZE];
     uint8_t sequence_number_endian;
+    /* Number of sequence numbers below the next expected one that may still be accepted once,
+     * out of order, by libspdm_decode_secured_message. 0 means in-order only.
+     * Each *_replay_bitmap tracks the received ones, bit N for (next expected - 1 - N). */
+    uint8_t replay_window_size;
 
     /* Cache the error in libspdm_decode_secured_message.
      * It is handled in libspdm_build_response. */
@@ -95,6 +112,35 @@ typedef struct {
  */
 void libspdm_secured_message_init_context(void *spdm_secured_message_context);
 
+/**
+ * Allocate an AEAD context if needed and set the encryption key into it.
+ *
+ * The keyed AEAD context is used by libspdm_encode_secured_message and
+ * libspdm_decode_secured_message, so that the cipher key schedule is not expanded per record.
+ * If the context cannot be prepared, it is left as NULL and the raw encryption key is used.
+ *
+ * @param  spdm_secured_message_context  A pointer to the SPDM secured message context.
+ * @param  aead_context                  A pointer to the AEAD context slot to be prepared.
+ * @param  key                           The encryption key to be set.
+ */
+void libspdm_secured_message_prepare_aead_context(void *spdm_secured_message_context,
+                                                  void **aead_context,
+                                                  const uint8_t *key);
+
+/**
+ * Free all AEAD contexts held by an SPDM secured message context.
+ *
+ * @param  spdm_secured_message_context  A pointer to the SPDM secured message context.
+ */
+void libspdm_secured_message_free_aead_contexts(void *spdm_secured_message_context);
+
+/**
+ * Free all HMAC contexts held by an SPDM secured message context.
+ *
+ * @param  spdm_secured_message_context  A pointer to the SPDM secured message context.
+ */
+void libspdm_secured_message_free_hmac_contexts(void *spdm_secured_message_context);
+
 /**
  * Set use_psk to an SPDM secured message context.
  *
@@ -175,6 +221,18 @@ void libspdm_secured_message_set_sequence_number_endian(
     void *spdm_secured_message_context,
     uint8_t endian_value);
 
+/**
+ * Set the sequence number replay window size to an SPDM secured message context.
+ *
+ * @param spdm_secured_message_context A pointer to the SPDM secured message context.
+ * @param replay_window_size           The replay window size, 0 to
+ *                                     LIBSPDM_MAX_SEQUENCE_NUMBER_REPLAY_WINDOW.
+ *
+ */
+void libspdm_secured_message_set_replay_window_size(
+    void *spdm_secured_message_context,
+    uint8_t replay_window_size);
+
 /**
  * Allocates and Initializes one Diffie-Hellman Ephemeral (DHE) context for subsequent use,
  * based upon negotiated DHE algorithm.
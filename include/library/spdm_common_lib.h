@@ -137,10 +137,12 @@ typedef enum {
 
     /* Below two entries are used to limit the number of DHE session and PSK session separately.
      * When set a new value, below rule is applied:
-     *     new MaxDheSessionCount <= LIBSPDM_MAX_SESSION_COUNT - current MaxPskSessionCount
-     *     new MaxPskSessionCount <= LIBSPDM_MAX_SESSION_COUNT - current MaxDheSessionCount
+     *     new MaxDheSessionCount <= session table size - current MaxPskSessionCount
+     *     new MaxPskSessionCount <= session table size - current MaxDheSessionCount
      * 0 means no limitation for the specific DHE or PSK session, as long as
-     *     PskSessionCount + DheSessionCount <= LIBSPDM_MAX_SESSION_COUNT.
+     *     PskSessionCount + DheSessionCount <= session table size.
+     * The session table size is the number of secured message contexts the SPDM context was
+     * initialized with, LIBSPDM_MAX_SESSION_COUNT by default.
      * If these values are modified while there are active sessions then the active sessions
      * aren't terminated.
      **/
@@ -164,6 +166,19 @@ typedef enum {
      * if both PQC and traditional are supported by both requester and responder. */
     LIBSPDM_DATA_ALGO_PRIORITY_PQC_FIRST,
 
+    /* Size of the sequence number replay window for received secured messages.
+     * 0 (the default) only accepts the next expected sequence number.
+     * A non-zero value, up to LIBSPDM_MAX_SEQUENCE_NUMBER_REPLAY_WINDOW, also accepts
+     * out-of-order sequence numbers within the window, each at most once.
+     * It takes effect for sessions that are started after it is set. */
+    LIBSPDM_DATA_SEQUENCE_NUMBER_REPLAY_WINDOW,
+
+    /* Limit the default portion length of requester GET_CERTIFICATE and
+     * GET_MEASUREMENT_EXTENSION_LOG so that each response fits in the local DataTransferSize.
+     * Each portion is then received in one message, consumed into the caller buffer and the
+     * transcript, and never reassembled through CHUNK_GET. The default is false. */
+    LIBSPDM_DATA_PORTION_WITHIN_DATA_TRANSFER_SIZE,
+
     /* MAX */
     LIBSPDM_DATA_MAX
 } libspdm_data_type_t;
@@ -180,6 +195,10 @@ typedef enum {
 
 #define LIBSPDM_INVALID_SESSION_ID 0
 
+/* Maximum number of sessions in a session table provided to
+ * libspdm_init_context_with_session_table. */
+#define LIBSPDM_MAX_SESSION_TABLE_COUNT 65535
+
 typedef enum {
     LIBSPDM_DATA_LOCATION_LOCAL,
     LIBSPDM_DATA_LOCATION_CONNECTION,
@@ -260,6 +279,9 @@ typedef enum {
 #define LIBSPDM_DATA_SESSION_SEQ_NUM_ENC_BIG_DEC_BIG 2
 #define LIBSPDM_DATA_SESSION_SEQ_NUM_ENC_BIG_DEC_BOTH 3
 
+/* Maximum value of LIBSPDM_DATA_SEQUENCE_NUMBER_REPLAY_WINDOW. */
+#define LIBSPDM_MAX_SEQUENCE_NUMBER_REPLAY_WINDOW 64
+
 /*
  * +--------------------------+------------------------------------------+---------+
  * | GET_VERSION              | 4                                        | 1       |
@@ -354,13 +376,49 @@ void libspdm_set_last_spdm_error_struct(void *spdm_context,
  * @param  secured_contexts      An array of pointers, with each entry containing
  *                               the location of a secured message context.
  * @param  num_secured_contexts  Number of secured message contexts to initialize.
- *                               Currently, only LIBSPDM_MAX_SESSION_COUNT is supported.
- *                               In future releases, lesser values may be supported.
+ *                               This is the maximum number of sessions, from 1 to
+ *                               LIBSPDM_MAX_SESSION_COUNT.
  */
 libspdm_return_t libspdm_init_context_with_secured_context(void *spdm_context,
                                                            void **secured_contexts,
                                                            size_t num_secured_contexts);
 
+/**
+ * Return the size in bytes of a session table for the specified number of sessions.
+ *
+ * @param  max_session_count  The maximum number of sessions.
+ *
+ * @return the size in bytes of the session table.
+ **/
+size_t libspdm_get_session_table_size(size_t max_session_count);
+
+/**
+ * Initialize an SPDM context with a session table and secured message contexts
+ * in the specified locations.
+ *
+ * This allows the maximum number of sessions to be chosen at runtime, including values above
+ * LIBSPDM_MAX_SESSION_COUNT. The session table that is embedded in the SPDM context is not used.
+ *
+ * The size in bytes of the spdm_context can be returned by
+ * libspdm_get_context_size_without_secured_context.
+ *
+ * @param  spdm_context          A pointer to the SPDM context.
+ * @param  session_table         A pointer to the session table. It must stay valid for the
+ *                               lifetime of the SPDM context and be aligned for any object type.
+ * @param  session_table_size    The size in bytes of the session table. It must be at least
+ *                               libspdm_get_session_table_size(num_secured_contexts).
+ * @param  secured_contexts      An array of pointers, with each entry containing
+ *                               the location of a secured message context.
+ * @param  num_secured_contexts  Number of secured message contexts to initialize.
+ *                               This is the maximum number of sessions, from 1 to
+ *                               LIBSPDM_MAX_SESSION_TABLE_COUNT.
+ */
+libspdm_return_t libspdm_init_context_with_session_table(void *spdm_context,
+                                                         void *session_table,
+                                                         size_t session_table_size,
+                                                         void **secured_contexts,
+                                                         size_t num_secured_contexts);
+
 #if LIBSPDM_FIPS_MODE
 /**
  * Initialize an libspdm_fips_selftest_context.
@@ -634,6 +692,50 @@ void libspdm_register_device_buffer_func(
     libspdm_device_acquire_receiver_buffer_func acquire_receiver_buffer,
     libspdm_device_release_receiver_buffer_func release_receiver_buffer);
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+/**
+ * Acquire a buffer to store a peer certificate chain.
+ *
+ * The buffer may come from a heap, a fixed pool, or storage that already holds the chain. It must
+ * stay valid until it is released.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  slot_id       The slot ID of the certificate chain.
+ * @param  buffer_size   Size in bytes of the certificate chain, including spdm_cert_chain_t header.
+ * @param  buffer        On success, a pointer to a buffer of at least buffer_size bytes.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS       The buffer has been acquired.
+ * @retval LIBSPDM_STATUS_ACQUIRE_FAIL  Unable to acquire the buffer.
+ **/
+typedef libspdm_return_t (*libspdm_acquire_peer_cert_chain_buffer_func)(
+    void *spdm_context, uint8_t slot_id, size_t buffer_size, void **buffer);
+
+/**
+ * Release a buffer that holds a peer certificate chain.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  slot_id       The slot ID of the certificate chain.
+ * @param  buffer        The buffer returned by libspdm_acquire_peer_cert_chain_buffer_func.
+ **/
+typedef void (*libspdm_release_peer_cert_chain_buffer_func)(
+    void *spdm_context, uint8_t slot_id, const void *buffer);
+
+/**
+ * Register the functions that manage the storage of peer certificate chains.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ * The buffers that are still acquired are released by libspdm_deinit_context.
+ *
+ * @param  spdm_context                    A pointer to the SPDM context.
+ * @param  acquire_peer_cert_chain_buffer  The function to acquire a certificate chain buffer.
+ * @param  release_peer_cert_chain_buffer  The function to release a certificate chain buffer.
+ **/
+void libspdm_register_peer_cert_chain_buffer_func(
+    void *spdm_context,
+    libspdm_acquire_peer_cert_chain_buffer_func acquire_peer_cert_chain_buffer,
+    libspdm_release_peer_cert_chain_buffer_func release_peer_cert_chain_buffer);
+#endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL */
+
 /**
  * Encode an SPDM or APP message to a transport layer message.
  *
@@ -1050,6 +1152,29 @@ typedef void (*libspdm_meas_log_reset_callback_func)(
     const uint32_t *session_id);
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
 
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/**
+ * Acquire a DHE context whose ephemeral key pair was generated ahead of time.
+ *
+ * The Responder calls it for KEY_EXCHANGE instead of generating its key pair on the request path.
+ * The key pair must not be handed out again. libspdm owns the returned context and frees it with
+ * libspdm_dhe_free once the shared secret is computed.
+ *
+ * @param spdm_context       A pointer to the SPDM context.
+ * @param dhe_named_group    The negotiated DHE named group.
+ * @param public_key         A pointer to the buffer to receive the public key.
+ * @param public_key_size    On input, the size in bytes of public_key.
+ *                           On output, the size in bytes of the public key.
+ *
+ * @return The DHE context, or NULL if no key pair is available. libspdm then generates one.
+ **/
+typedef void *(*libspdm_acquire_dhe_key_pair_func)(
+    void *spdm_context,
+    uint16_t dhe_named_group,
+    uint8_t *public_key,
+    size_t *public_key_size);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
 #ifdef __cplusplus
 }
 #endif
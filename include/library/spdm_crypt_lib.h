@@ -295,6 +295,9 @@ bool libspdm_hmac_init(uint32_t base_hash_algo,
 /**
  * Makes a copy of an existing HMAC context.
  *
+ * hmac_ctx may be a context that is keyed but not yet updated. Copying it is cheaper than setting
+ * the same key again. Any previous state of new_hmac_ctx is replaced.
+ *
  * If hmac_ctx is NULL, then return false.
  * If new_hmac_ctx is NULL, then return false.
  *
@@ -393,6 +396,25 @@ bool libspdm_hmac_all(uint32_t base_hash_algo, const void *data,
                       size_t data_size, const uint8_t *key,
                       size_t key_size, uint8_t *hmac_value);
 
+/**
+ * Computes the HMAC of a input data buffer, with an HMAC context that is already keyed.
+ *
+ * The keyed context is copied and is not modified, so it can be reused for further HMACs with the
+ * same key.
+ *
+ * @param  base_hash_algo  SPDM base_hash_algo
+ * @param  key_hmac_ctx    HMAC context keyed by libspdm_hmac_init() and not yet updated.
+ * @param  data            Pointer to the buffer containing the data to be HMACed.
+ * @param  data_size       Size of data buffer in bytes.
+ * @param  hash_value      Pointer to a buffer that receives the HMAC value.
+ *
+ * @retval true   HMAC computation succeeded.
+ * @retval false  HMAC computation failed.
+ **/
+bool libspdm_hmac_all_with_hmac_context(uint32_t base_hash_algo, const void *key_hmac_ctx,
+                                        const void *data, size_t data_size,
+                                        uint8_t *hmac_value);
+
 /**
  * Derive HMAC-based Extract key Derivation Function (HKDF) Extract, based upon the negotiated HKDF
  * algorithm.
@@ -430,6 +452,28 @@ bool libspdm_hkdf_expand(uint32_t base_hash_algo, const uint8_t *prk,
                          size_t prk_size, const uint8_t *info,
                          size_t info_size, uint8_t *out, size_t out_size);
 
+/**
+ * Derive HMAC-based Expand key Derivation Function (HKDF) Expand, based upon the negotiated HKDF
+ * algorithm, with an HMAC context that is already keyed with the pseudorandom key.
+ *
+ * The output is the same as libspdm_hkdf_expand() with that key. Each output block copies the
+ * keyed context instead of setting the key again, so one keyed context can serve several labels.
+ *
+ * @param  base_hash_algo  SPDM base_hash_algo
+ * @param  prk_hmac_ctx    HMAC context keyed with the pseudorandom key by libspdm_hmac_init().
+ *                         It is not modified.
+ * @param  info            Pointer to the application specific info.
+ * @param  info_size       Info size in bytes.
+ * @param  out             Pointer to buffer to receive hkdf value.
+ * @param  out_size        Size of hkdf bytes to generate.
+ *
+ * @retval true   Hkdf generated successfully.
+ * @retval false  Hkdf generation failed.
+ **/
+bool libspdm_hkdf_expand_with_hmac_context(uint32_t base_hash_algo, const void *prk_hmac_ctx,
+                                           const uint8_t *info, size_t info_size,
+                                           uint8_t *out, size_t out_size);
+
 /**
  * This function returns the SPDM asymmetric algorithm size.
  *
@@ -946,6 +990,98 @@ bool libspdm_aead_decryption(const spdm_version_number_t secured_message_version
                              size_t tag_size, uint8_t *data_out,
                              size_t *data_out_size);
 
+/**
+ * Allocates and initializes one AEAD context for subsequent use, based upon negotiated AEAD
+ * algorithm.
+ *
+ * A keyed AEAD context can be reused for many records, so that the cipher key schedule is
+ * only expanded once per key.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ *
+ * @return  Pointer to the AEAD context that has been initialized.
+ *          If the allocation fails, NULL is returned.
+ **/
+void *libspdm_aead_new(uint16_t aead_cipher_suite);
+
+/**
+ * Release the specified AEAD context, based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_context       Pointer to the AEAD context to be released.
+ **/
+void libspdm_aead_free(uint16_t aead_cipher_suite, void *aead_context);
+
+/**
+ * Sets the key of an AEAD context, based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_context       Pointer to the AEAD context.
+ * @param  key                Pointer to the encryption key.
+ * @param  key_size           Size of the encryption key in bytes.
+ *
+ * @retval true   The key was set successfully.
+ * @retval false  The key was not set.
+ **/
+bool libspdm_aead_set_key(uint16_t aead_cipher_suite, void *aead_context,
+                          const uint8_t *key, size_t key_size);
+
+/**
+ * Performs AEAD authenticated encryption on a data buffer and additional authenticated data (AAD)
+ * with a keyed AEAD context, based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_context       Pointer to the AEAD context that has been keyed.
+ * @param  iv                 Pointer to the IV value.
+ * @param  iv_size            Size of the IV value in bytes.
+ * @param  a_data             Pointer to the additional authenticated data (AAD).
+ * @param  a_data_size        Size of the additional authenticated data (AAD) in bytes.
+ * @param  data_in            Pointer to the input data buffer to be encrypted.
+ * @param  data_in_size       Size of the input data buffer in bytes.
+ * @param  tag_out            Pointer to a buffer that receives the authentication tag output.
+ * @param  tag_size           Size of the authentication tag in bytes.
+ * @param  data_out           Pointer to a buffer that receives the encryption output.
+ * @param  data_out_size      Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD authenticated encryption succeeded.
+ * @retval false  AEAD authenticated encryption failed.
+ **/
+bool libspdm_aead_encryption_with_context(const spdm_version_number_t secured_message_version,
+                                          uint16_t aead_cipher_suite, void *aead_context,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          uint8_t *tag_out, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Performs AEAD authenticated decryption on a data buffer and additional authenticated data (AAD)
+ * with a keyed AEAD context, based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_context       Pointer to the AEAD context that has been keyed.
+ * @param  iv                 Pointer to the IV value.
+ * @param  iv_size            Size of the IV value in bytes.
+ * @param  a_data             Pointer to the additional authenticated data (AAD).
+ * @param  a_data_size        Size of the additional authenticated data (AAD) in bytes.
+ * @param  data_in            Pointer to the input data buffer to be decrypted.
+ * @param  data_in_size       Size of the input data buffer in bytes.
+ * @param  tag                Pointer to a buffer that contains the authentication tag.
+ * @param  tag_size           Size of the authentication tag in bytes.
+ * @param  data_out           Pointer to a buffer that receives the decryption output.
+ * @param  data_out_size      Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD authenticated decryption succeeded.
+ * @retval false  AEAD authenticated decryption failed.
+ **/
+bool libspdm_aead_decryption_with_context(const spdm_version_number_t secured_message_version,
+                                          uint16_t aead_cipher_suite, void *aead_context,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          const uint8_t *tag, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size);
+
 /**
  * Generates a random byte stream of the specified size.
  *
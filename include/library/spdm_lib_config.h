@@ -142,6 +142,36 @@
 #define LIBSPDM_RESPOND_IF_READY_SUPPORT 1
 #endif
 
+/* If 1 then a Requester can also run GET_DIGESTS and GET_MEASUREMENTS without blocking, through
+ * libspdm_get_digest_async and libspdm_get_measurement_async. The Integrator moves the transport
+ * messages and keeps the time, so that one thread can drive the conversations with many
+ * Responders. See libspdm_async_get_event.
+ */
+#ifndef LIBSPDM_ASYNC_REQUESTER_SUPPORT
+#define LIBSPDM_ASYNC_REQUESTER_SUPPORT 1
+#endif
+
+/* If 1 then application messages of different sessions can be exchanged concurrently with
+ * libspdm_send_receive_data, from one thread per session. Each session gets its own area in the
+ * scratch buffer, which grows by two transport messages per entry of the session table.
+ */
+#ifndef LIBSPDM_CONCURRENT_SESSION_SUPPORT
+#define LIBSPDM_CONCURRENT_SESSION_SUPPORT 0
+#endif
+
+/* If 1 then a Requester can poll measurements with libspdm_get_measurement_cached. The context
+ * keeps the digest of the last verified measurement record of up to
+ * LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT measurement operations. Inside a session an unchanged
+ * record is then accepted without a signed MEASUREMENTS response. Requires MEAS_CAP.
+ */
+#ifndef LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+#define LIBSPDM_MEASUREMENT_CACHE_SUPPORT 0
+#endif
+
+#ifndef LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT
+#define LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT 8
+#endif
+
 /* Enables FIPS 140-3 mode. */
 #ifndef LIBSPDM_FIPS_MODE
 #define LIBSPDM_FIPS_MODE 0
@@ -192,7 +222,8 @@
 #endif
 
 /* If the Responder supports it a Requester is allowed to establish multiple secure sessions with
- * the Responder. This value specifies the maximum number of sessions libspdm can support.
+ * the Responder. This value specifies the maximum number of sessions held in the SPDM context.
+ * A larger session table can be provided at runtime via libspdm_init_context_with_session_table.
  */
 #ifndef LIBSPDM_MAX_SESSION_COUNT
 #define LIBSPDM_MAX_SESSION_COUNT 4
@@ -241,6 +272,16 @@
 #endif
 #endif /* LIBSPDM_MAX_CERT_CHAIN_SIZE */
 
+/* If 1 then the peer certificate chains are not stored in the libspdm context. Instead each chain
+ * is stored in a buffer of its exact size that the Integrator provides through
+ * libspdm_register_peer_cert_chain_buffer_func, and LIBSPDM_MAX_CERT_CHAIN_SIZE only bounds the
+ * size of a chain. This saves SPDM_MAX_SLOT_COUNT * LIBSPDM_MAX_CERT_CHAIN_SIZE bytes per context,
+ * which is significant when post-quantum algorithms are enabled.
+ * If 0 then each slot embeds a buffer of LIBSPDM_MAX_CERT_CHAIN_SIZE bytes in the context. */
+#ifndef LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+#define LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL 0
+#endif
+
 /* This value specifies the maximum size, in bytes, of the MEASUREMENTS.MeasurementRecord field. */
 #ifndef LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE
 #define LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE 0x1000
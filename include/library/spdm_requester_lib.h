@@ -352,6 +352,52 @@ libspdm_return_t libspdm_get_measurement_ex2(void *spdm_context, const uint32_t
                                              void *responder_nonce,
                                              void *opaque_data,
                                              size_t *opaque_data_size);
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/**
+ * This function gets a verified measurement record from the device, and skips the signature when
+ * the record is known to be unchanged.
+ *
+ * The SPDM context keeps the digest of the last verified record of each measurement operation and
+ * slot. If session_id is a session that the Responder authenticated with the certificate chain of
+ * slot_id, the record is first read without a signature. The session keys authenticate that
+ * response, so a record that matches the cached digest is returned at once. Otherwise the record
+ * is read with a signature, which is verified, and the record is cached unless content_changed
+ * reports that the measurements changed during the request.
+ *
+ * The cache is cleared when the connection is reset and when the size of the measurement
+ * extension log changes. The records of a slot are forgotten when its certificate chain is read.
+ * The Integrator clears the cache with libspdm_reset_measurement_cache, for example on a
+ * MeasurementChanged event.
+ *
+ * @param  spdm_context               A pointer to the SPDM context.
+ * @param  session_id                 Indicates if it is a secured message protected via SPDM session.
+ *                                    If session_id is NULL, it is a normal message.
+ *                                    If session_id is NOT NULL, it is a secured message.
+ * @param  measurement_operation      The measurement operation of the request message. It must not
+ *                                    be the total number of measurements.
+ * @param  slot_id                    The number of slot for the certificate chain.
+ * @param  unchanged                  On output, true if the record is the last verified record.
+ * @param  number_of_blocks           The number of blocks of the measurement record.
+ * @param  measurement_record_length  On input, indicate the size in bytes of the destination buffer to store the measurement record.
+ *                                    On output, indicate the size in bytes of the measurement record.
+ * @param  measurement_record         A pointer to a destination buffer to store the measurement record.
+ **/
+libspdm_return_t libspdm_get_measurement_cached(void *spdm_context, const uint32_t *session_id,
+                                                uint8_t measurement_operation,
+                                                uint8_t slot_id,
+                                                bool *unchanged,
+                                                uint8_t *number_of_blocks,
+                                                uint32_t *measurement_record_length,
+                                                void *measurement_record);
+
+/**
+ * This function clears the measurement records cached by libspdm_get_measurement_cached.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ **/
+void libspdm_reset_measurement_cache(void *spdm_context);
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
 
 #if LIBSPDM_SEND_GET_ENDPOINT_INFO_SUPPORT
@@ -584,6 +630,9 @@ libspdm_return_t libspdm_start_session_ex(void *spdm_context, bool use_psk,
 /**
  * This function sends END_SESSION to stop an SPDM Session.
  *
+ * If LIBSPDM_CONCURRENT_SESSION_SUPPORT is 1 and an APP message already ended the session, the
+ * session is freed without sending END_SESSION.
+ *
  * @param  spdm_context            A pointer to the SPDM context.
  * @param  session_id              The session ID of the session.
  * @param  end_session_attributes  The end session attribute for the session.
@@ -650,6 +699,16 @@ libspdm_return_t libspdm_receive_data(void *spdm_context, const uint32_t *sessio
  * This API does not handle APP message chunking.
  * Take MCTP as example: APP message == MCTP header (MCTP_MESSAGE_TYPE_SPDM) + SPDM message
  *
+ * If LIBSPDM_CONCURRENT_SESSION_SUPPORT is 1, APP messages of different sessions may be sent from
+ * different threads at the same time. The APP message of a session is encoded and decoded in the
+ * area of that session in the scratch buffer, and the sender and receiver buffers are not used.
+ * send_message and receive_message are then called concurrently, and receive_message must return
+ * the response to the request that the calling thread sent. No other request may be in progress
+ * on the context, and each session must be used by one thread at a time. If the APP message of a
+ * session fails to decrypt, or its sequence number overflows, the session is not freed but ended:
+ * this function returns LIBSPDM_STATUS_INVALID_STATE_LOCAL for it until libspdm_stop_session frees
+ * it, after all threads have returned.
+ *
  * @param  spdm_context    A pointer to the SPDM context.
  * @param  session_id      Indicates if it is a secured message protected via SPDM session.
  *                         If session_id is NULL, it is a normal message.
@@ -1080,6 +1139,231 @@ libspdm_return_t libspdm_vendor_send_request_receive_response(
 
 #endif /* LIBSPDM_ENABLE_VENDOR_DEFINED_MESSAGES */
 
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+/*
+ * Non-blocking Requester API.
+ *
+ * An asynchronous request does not call the send_message, receive_message or libspdm_sleep
+ * functions. The Integrator starts it with one of the libspdm_*_async functions and then moves it
+ * forward from an event loop:
+ *   - LIBSPDM_ASYNC_STATE_NEED_SEND: after event.timeout microseconds, send event.message and call
+ *     libspdm_async_message_sent.
+ *   - LIBSPDM_ASYNC_STATE_NEED_RECEIVE: pass the next transport message from the device to
+ *     libspdm_async_receive_message. If none arrives within event.timeout microseconds, call
+ *     libspdm_async_cancel.
+ *   - LIBSPDM_ASYNC_STATE_DONE: event.status is the result that the blocking function returns.
+ *
+ * BUSY retries and RESPOND_IF_READY are handled as in the blocking functions, and appear as more
+ * NEED_SEND states with a delay. A flow of several requests, such as the VCA requests of
+ * libspdm_init_connection_async or the portions of a certificate chain, appears as more NEED_SEND
+ * states without a delay. A context runs one flow at a time. Its sender buffer stays acquired
+ * while the state is NEED_SEND. Responses that the Responder sends in chunks are not supported,
+ * and such a request is done with LIBSPDM_STATUS_ERROR_PEER. The encapsulated requests of mutual
+ * authentication are not supported either.
+ */
+typedef enum {
+    LIBSPDM_ASYNC_STATE_IDLE,
+    LIBSPDM_ASYNC_STATE_NEED_SEND,
+    LIBSPDM_ASYNC_STATE_NEED_RECEIVE,
+    LIBSPDM_ASYNC_STATE_DONE,
+} libspdm_async_state_t;
+
+typedef struct {
+    libspdm_async_state_t state;
+    /* LIBSPDM_ASYNC_STATE_NEED_SEND: the transport message to send. */
+    const void *message;
+    size_t message_size;
+    /* LIBSPDM_ASYNC_STATE_NEED_SEND: the delay before sending, in microseconds.
+     * LIBSPDM_ASYNC_STATE_NEED_RECEIVE: the time to wait for the response, in microseconds. */
+    uint64_t timeout;
+    /* LIBSPDM_ASYNC_STATE_DONE: the result of the request. */
+    libspdm_return_t status;
+} libspdm_async_event_t;
+
+/**
+ * Start GET_VERSION, GET_CAPABILITIES and NEGOTIATE_ALGORITHMS without blocking.
+ *
+ * The parameters and the final status are the same as libspdm_init_connection.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         The request is started and its state is LIBSPDM_ASYNC_STATE_NEED_SEND.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Another asynchronous request is in progress.
+ **/
+libspdm_return_t libspdm_init_connection_async(void *spdm_context, bool get_version_only);
+
+#if LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+/**
+ * Start GET_DIGESTS without blocking.
+ *
+ * The parameters and the final status are the same as libspdm_get_digest. slot_mask and
+ * total_digest_buffer must stay valid until the request is done.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         The request is started and its state is LIBSPDM_ASYNC_STATE_NEED_SEND.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Another asynchronous request is in progress, or the Requester's state does not allow
+ *         GET_DIGESTS.
+ * Any other error is returned as by libspdm_get_digest before the request is sent.
+ **/
+libspdm_return_t libspdm_get_digest_async(void *spdm_context, const uint32_t *session_id,
+                                          uint8_t *slot_mask, void *total_digest_buffer);
+
+/**
+ * Start GET_CERTIFICATE without blocking. A GET_CERTIFICATE request is sent for each portion of
+ * the certificate chain, and each portion is kept within the DataTransferSize of the Requester.
+ *
+ * The parameters and the final status are the same as libspdm_get_certificate_ex. The buffers
+ * must stay valid until the request is done.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         The request is started and its state is LIBSPDM_ASYNC_STATE_NEED_SEND.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Another asynchronous request is in progress, or the Requester's state does not allow
+ *         GET_CERTIFICATE.
+ * Any other error is returned as by libspdm_get_certificate_ex before the request is sent.
+ **/
+libspdm_return_t libspdm_get_certificate_async(void *spdm_context, const uint32_t *session_id,
+                                               uint8_t slot_id,
+                                               uint32_t length,
+                                               size_t *cert_chain_size,
+                                               void *cert_chain,
+                                               const void **trust_anchor,
+                                               size_t *trust_anchor_size);
+#endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+/**
+ * Start CHALLENGE without blocking.
+ *
+ * The parameters and the final status are the same as libspdm_challenge_ex2. The buffers must
+ * stay valid until the request is done. If the Responder requests basic mutual authentication,
+ * the request is done with LIBSPDM_STATUS_UNSUPPORTED_CAP, and libspdm_challenge_ex2 must be
+ * used instead.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         The request is started and its state is LIBSPDM_ASYNC_STATE_NEED_SEND.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Another asynchronous request is in progress, or the Requester's state does not allow
+ *         CHALLENGE.
+ * Any other error is returned as by libspdm_challenge_ex2 before the request is sent.
+ **/
+libspdm_return_t libspdm_challenge_async(void *spdm_context,
+                                         uint8_t slot_id,
+                                         const void *requester_context,
+                                         uint8_t measurement_hash_type,
+                                         void *measurement_hash,
+                                         uint8_t *slot_mask,
+                                         const void *requester_nonce_in,
+                                         void *requester_nonce,
+                                         void *responder_nonce,
+                                         void *opaque_data,
+                                         size_t *opaque_data_size);
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+/**
+ * Start GET_MEASUREMENTS without blocking.
+ *
+ * The parameters and the final status are the same as libspdm_get_measurement_ex2. The buffers
+ * must stay valid until the request is done.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         The request is started and its state is LIBSPDM_ASYNC_STATE_NEED_SEND.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Another asynchronous request is in progress, or the Requester's state does not allow
+ *         GET_MEASUREMENTS.
+ * Any other error is returned as by libspdm_get_measurement_ex2 before the request is sent.
+ **/
+libspdm_return_t libspdm_get_measurement_async(void *spdm_context, const uint32_t *session_id,
+                                               uint8_t request_attribute,
+                                               uint8_t measurement_operation,
+                                               uint8_t slot_id,
+                                               const void *requester_context,
+                                               uint8_t *content_changed,
+                                               uint8_t *number_of_blocks,
+                                               uint32_t *measurement_record_length,
+                                               void *measurement_record,
+                                               const void *requester_nonce_in,
+                                               void *requester_nonce,
+                                               void *responder_nonce,
+                                               void *opaque_data,
+                                               size_t *opaque_data_size);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/**
+ * Start a session with KEY_EXCHANGE and FINISH without blocking.
+ *
+ * The parameters and the final status are the same as libspdm_start_session with use_psk false.
+ * session_id, heartbeat_period and measurement_hash must stay valid until the request is done.
+ * If the Responder requests mutual authentication with encapsulated requests, the session is
+ * freed and the request is done with LIBSPDM_STATUS_UNSUPPORTED_CAP. Sessions with a pre-shared
+ * key are only started by libspdm_start_session.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         The request is started and its state is LIBSPDM_ASYNC_STATE_NEED_SEND.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Another asynchronous request is in progress, or the Requester's state does not allow
+ *         KEY_EXCHANGE.
+ * Any other error is returned as by libspdm_start_session before the request is sent.
+ **/
+libspdm_return_t libspdm_start_session_async(void *spdm_context,
+                                             uint8_t measurement_hash_type,
+                                             uint8_t slot_id,
+                                             uint8_t session_policy,
+                                             uint32_t *session_id,
+                                             uint8_t *heartbeat_period,
+                                             void *measurement_hash);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+/**
+ * Return what the asynchronous request of a context waits for.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  event         On output, the state of the request.
+ **/
+void libspdm_async_get_event(void *spdm_context, libspdm_async_event_t *event);
+
+/**
+ * Report that the message of a LIBSPDM_ASYNC_STATE_NEED_SEND state was sent. The state becomes
+ * LIBSPDM_ASYNC_STATE_NEED_RECEIVE.
+ *
+ * If the message could not be sent, call libspdm_async_cancel instead.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS             The state is LIBSPDM_ASYNC_STATE_NEED_RECEIVE.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL The state was not LIBSPDM_ASYNC_STATE_NEED_SEND.
+ **/
+libspdm_return_t libspdm_async_message_sent(void *spdm_context);
+
+/**
+ * Pass a transport message that was received from the device to the asynchronous request.
+ * The state becomes LIBSPDM_ASYNC_STATE_NEED_SEND for a retry or RESPOND_IF_READY, or
+ * LIBSPDM_ASYNC_STATE_DONE.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  message_size  The size in bytes of the transport message.
+ * @param  message       The transport message. It is only used during the call.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS             The message is processed. The result of the request
+ *                                            is in the event.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL The state was not LIBSPDM_ASYNC_STATE_NEED_RECEIVE.
+ **/
+libspdm_return_t libspdm_async_receive_message(void *spdm_context, size_t message_size,
+                                               void *message);
+
+/**
+ * Abandon the asynchronous request of a context, for example when the response did not arrive
+ * in time. The state becomes LIBSPDM_ASYNC_STATE_IDLE. It does nothing if no request is in
+ * progress.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ **/
+void libspdm_async_cancel(void *spdm_context);
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
 #ifdef __cplusplus
 }
 #endif
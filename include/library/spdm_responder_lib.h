@@ -315,6 +315,23 @@ libspdm_return_t libspdm_register_get_endpoint_info_callback_func(
     void *spdm_context, libspdm_get_endpoint_info_callback_func get_endpoint_info_callback);
 #endif /* LIBSPDM_ENABLE_CAPABILITY_ENCAP_CAP && LIBSPDM_SEND_GET_ENDPOINT_INFO_SUPPORT */
 
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/**
+ * This function registers the callback function that provides the Responder's ephemeral DHE key
+ * pair for KEY_EXCHANGE, such as from a pool of key pairs generated in the background.
+ * ML-KEM key exchange is not affected, because the Responder has no key pair of its own to
+ * generate.
+ *
+ * @param  spdm_context                 A pointer to the SPDM context.
+ * @param  acquire_dhe_key_pair         The callback function, or NULL to generate every key pair
+ *                                      on the request path.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS Success
+ **/
+libspdm_return_t libspdm_register_dhe_key_pair_func(
+    void *spdm_context, libspdm_acquire_dhe_key_pair_func acquire_dhe_key_pair);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
 #if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
 /**
  * This function registers the callback function for notify
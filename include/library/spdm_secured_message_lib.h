@@ -259,6 +259,49 @@ libspdm_return_t libspdm_encode_secured_message(
     void *secured_message,
     const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks);
 
+/* A piece of an application message. */
+typedef struct {
+    const void *data;
+    size_t size;
+} libspdm_secured_message_fragment_t;
+
+/**
+ * Encode an application message, given as a list of fragments, to a secured message.
+ *
+ * The fragments are gathered into the secured message, where the plain text is encrypted in place,
+ * so the application message needs no room around it. A fragment that already sits at its place
+ * in the secured message is not copied: the first one is at
+ * secured_message + libspdm_secured_message_get_app_message_offset(). Any other fragment shall
+ * not overlap the secured message.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  session_id                      The session ID of the SPDM session.
+ * @param  is_request_message              Indicates if it is a request message.
+ * @param  fragment_count                  The number of fragments.
+ * @param  fragments                       The fragments of the application message, in order.
+ *                                         Their total size shall be at most 0xFFFF.
+ * @param  secured_message_size            size in bytes of the secured message data buffer.
+ * @param  secured_message                 A pointer to a destination buffer to store the secured message.
+ *                                         It may follow room that the caller keeps for the transport header.
+ * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ **/
+libspdm_return_t libspdm_encode_secured_message_fragments(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_request_message, size_t fragment_count,
+    const libspdm_secured_message_fragment_t *fragments,
+    size_t *secured_message_size, void *secured_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks);
+
+/**
+ * Return the offset of the application message within a secured message of the session.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ **/
+size_t libspdm_secured_message_get_app_message_offset(
+    void *spdm_secured_message_context,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks);
+
 /**
  * Decode an application message from a secured message.
  *
@@ -282,6 +325,36 @@ libspdm_return_t libspdm_decode_secured_message(
     void **app_message,
     const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks);
 
+/**
+ * Decode an application message from a secured message, decrypting it where it is.
+ *
+ * Unlike libspdm_decode_secured_message, no other buffer is written, and the secured message is
+ * overwritten by the plain text. If the message fails to authenticate then the bytes that were
+ * decrypted are zeroed.
+ *
+ * A message that might have to be decrypted twice is not decoded in place, and
+ * LIBSPDM_STATUS_UNSUPPORTED_CAP is returned before any state changes. That is the message which
+ * determines a LIBSPDM_DATA_SESSION_SEQ_NUM_*_DEC_BOTH sequence number endianness, and any message
+ * received while the backup keys of a key update are valid. The caller decodes it with
+ * libspdm_decode_secured_message.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  session_id                      The session ID of the SPDM session.
+ * @param  is_request_message              Indicates if it is a request message.
+ * @param  secured_message_size            size in bytes of the secured message data buffer.
+ * @param  secured_message                 A pointer to the secured message. It is overwritten.
+ * @param  app_message_size                On output, size in bytes of the application message.
+ * @param  app_message                     On output, a pointer to the application message inside of
+ *                                         the secured message.
+ * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ **/
+libspdm_return_t libspdm_decode_secured_message_in_place(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_request_message, size_t secured_message_size,
+    void *secured_message, size_t *app_message_size,
+    void **app_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks);
+
 /**
  * Get the last SPDM error struct of an SPDM secured message context.
  *
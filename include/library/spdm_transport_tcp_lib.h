@@ -8,6 +8,8 @@
 #define SPDM_TCP_TRANSPORT_LIB_H
 
 #include "library/spdm_common_lib.h"
+#include "library/spdm_crypt_lib.h"
+#include "industry_standard/spdm_tcp_binding.h"
 
 /* Required sender/receive buffer in device io.
  * +-------+--------+---------------------------+------+--+------+---+--------+-----+
@@ -18,6 +20,11 @@
  * +-------+--------+---------------------------+------+--+------+---+--------+-----+
  *
  */
+#define LIBSPDM_TCP_TRANSPORT_HEADER_SIZE  (4 + 8 + \
+                                            SPDM_TCP_SEQUENCE_NUMBER_COUNT)
+
+#define LIBSPDM_TCP_TRANSPORT_TAIL_SIZE    (SPDM_TCP_MAX_RANDOM_NUMBER_COUNT + \
+                                            LIBSPDM_MAX_AEAD_TAG_SIZE + 3)
 
 /*
  * Encode an SPDM or APP message to a transport layer message.
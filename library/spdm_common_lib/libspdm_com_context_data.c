@@ -101,6 +101,35 @@ uint32_t libspdm_get_scratch_buffer_cache_spdm_request_capacity(libspdm_context_
 }
 #endif
 
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+/* seventh section, one area per entry of the session table */
+uint32_t libspdm_get_scratch_buffer_session_message_offset(libspdm_context_t *spdm_context,
+                                                          size_t session_index) {
+    LIBSPDM_ASSERT(session_index < spdm_context->max_session_count);
+    return 0 +
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+           libspdm_get_scratch_buffer_secure_message_capacity(spdm_context) +
+           libspdm_get_scratch_buffer_large_message_capacity(spdm_context) +
+#endif
+           libspdm_get_scratch_buffer_sender_receiver_capacity(spdm_context) +
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+           libspdm_get_scratch_buffer_large_sender_receiver_capacity(spdm_context) +
+#endif
+           libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context) +
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+           libspdm_get_scratch_buffer_cache_spdm_request_capacity(spdm_context) +
+#endif
+           (uint32_t)session_index *
+           libspdm_get_scratch_buffer_session_message_capacity(spdm_context);
+}
+
+uint32_t libspdm_get_scratch_buffer_session_message_capacity(libspdm_context_t *spdm_context) {
+    return 2 * (spdm_context->local_context.capability.max_spdm_msg_size +
+                spdm_context->local_context.capability.transport_header_size +
+                spdm_context->local_context.capability.transport_tail_size);
+}
+#endif
+
 /* combination */
 uint32_t libspdm_get_scratch_buffer_capacity(libspdm_context_t *spdm_context) {
     return 0 +
@@ -115,10 +144,30 @@ uint32_t libspdm_get_scratch_buffer_capacity(libspdm_context_t *spdm_context) {
            libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context) +
 #if LIBSPDM_RESPOND_IF_READY_SUPPORT
            libspdm_get_scratch_buffer_cache_spdm_request_capacity(spdm_context) +
+#endif
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+           spdm_context->max_session_count *
+           libspdm_get_scratch_buffer_session_message_capacity(spdm_context) +
 #endif
            0;
 }
 
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+ * Free the VCA digest checkpoint in SPDM context.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ **/
+static void libspdm_reset_digest_context_vca(libspdm_context_t *spdm_context)
+{
+    if (spdm_context->transcript.digest_context_vca != NULL) {
+        libspdm_hash_free (spdm_context->transcript.digest_context_vca_hash_algo,
+                           spdm_context->transcript.digest_context_vca);
+        spdm_context->transcript.digest_context_vca = NULL;
+    }
+}
+#endif /* !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
+
 /**
  * Returns if an SPDM data_type requires session info.
  *
@@ -584,13 +633,7 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
             return LIBSPDM_STATUS_INVALID_PARAMETER;
         }
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        if (data_size > LIBSPDM_MAX_CERT_CHAIN_SIZE) {
-            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-        }
-        context->connection_info.peer_used_cert_chain[slot_id].buffer_size = data_size;
-        libspdm_copy_mem(context->connection_info.peer_used_cert_chain[slot_id].buffer,
-                         sizeof(context->connection_info.peer_used_cert_chain[slot_id].buffer),
-                         data, data_size);
+        return libspdm_set_peer_cert_chain_buffer(context, slot_id, data, data_size);
 #else
 #if LIBSPDM_CERT_PARSE_SUPPORT
         status = libspdm_hash_all(
@@ -722,6 +765,9 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
         libspdm_copy_mem(context->transcript.message_a.buffer,
                          sizeof(context->transcript.message_a.buffer),
                          data, data_size);
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+        libspdm_reset_digest_context_vca(context);
+#endif
         break;
     case LIBSPDM_DATA_IS_REQUESTER:
         if (data_size != sizeof(bool)) {
@@ -748,7 +794,7 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
         if (data_size != sizeof(uint32_t)) {
             return LIBSPDM_STATUS_INVALID_PARAMETER;
         }
-        if (*(const uint32_t *)data > LIBSPDM_MAX_SESSION_COUNT - context->max_psk_session_count) {
+        if (*(const uint32_t *)data > context->max_session_count - context->max_psk_session_count) {
             return LIBSPDM_STATUS_INVALID_PARAMETER;
         }
         context->max_dhe_session_count = *(const uint32_t *)data;
@@ -757,7 +803,7 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
         if (data_size != sizeof(uint32_t)) {
             return LIBSPDM_STATUS_INVALID_PARAMETER;
         }
-        if (*(const uint32_t *)data > LIBSPDM_MAX_SESSION_COUNT - context->max_dhe_session_count) {
+        if (*(const uint32_t *)data > context->max_session_count - context->max_dhe_session_count) {
             return LIBSPDM_STATUS_INVALID_PARAMETER;
         }
         context->max_psk_session_count = *(const uint32_t *)data;
@@ -788,6 +834,24 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
         }
         context->sequence_number_endian = *(const uint8_t *)data;
         break;
+    case LIBSPDM_DATA_SEQUENCE_NUMBER_REPLAY_WINDOW:
+        if (data_size != sizeof(uint8_t)) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        if (*(const uint8_t *)data > LIBSPDM_MAX_SEQUENCE_NUMBER_REPLAY_WINDOW) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        context->replay_window_size = *(const uint8_t *)data;
+        break;
+    case LIBSPDM_DATA_PORTION_WITHIN_DATA_TRANSFER_SIZE:
+        if (parameter->location != LIBSPDM_DATA_LOCATION_LOCAL) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        if (data_size != sizeof(bool)) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        context->local_context.portion_within_data_transfer_size = *(const bool *)data;
+        break;
     case LIBSPDM_DATA_MULTI_KEY_CONN_REQ:
         if (parameter->location != LIBSPDM_DATA_LOCATION_CONNECTION) {
             return LIBSPDM_STATUS_INVALID_PARAMETER;
@@ -1140,6 +1204,17 @@ libspdm_return_t libspdm_get_data(void *spdm_context, libspdm_data_type_t data_t
         target_data_size = sizeof(uint8_t);
         target_data = &context->sequence_number_endian;
         break;
+    case LIBSPDM_DATA_SEQUENCE_NUMBER_REPLAY_WINDOW:
+        target_data_size = sizeof(uint8_t);
+        target_data = &context->replay_window_size;
+        break;
+    case LIBSPDM_DATA_PORTION_WITHIN_DATA_TRANSFER_SIZE:
+        if (parameter->location != LIBSPDM_DATA_LOCATION_LOCAL) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        target_data_size = sizeof(bool);
+        target_data = &context->local_context.portion_within_data_transfer_size;
+        break;
     case LIBSPDM_DATA_SESSION_SEQUENCE_NUMBER_ENDIAN:
         target_data_size = sizeof(uint8_t);
         target_data = &secured_context->sequence_number_endian;
@@ -1240,6 +1315,76 @@ bool libspdm_check_context (void *spdm_context)
 }
 #endif /* LIBSPDM_CHECK_CONTEXT */
 
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+ * Create a new transcript digest context.
+ *
+ * When include_message_a is true, the new context starts from a duplicate of the VCA checkpoint.
+ * The checkpoint is hashed once and rebuilt only if the hash algorithm or message_a length changes.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  include_message_a             Indicate whether the transcript starts with message_a.
+ *
+ * @return the new digest context, or NULL on failure.
+ **/
+static void *libspdm_new_transcript_digest_context(libspdm_context_t *spdm_context,
+                                                   bool include_message_a)
+{
+    uint32_t base_hash_algo;
+    size_t message_a_size;
+    void *digest_context;
+    bool result;
+
+    base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+    message_a_size = libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a);
+
+    if (include_message_a) {
+        if ((spdm_context->transcript.digest_context_vca != NULL) &&
+            ((spdm_context->transcript.digest_context_vca_hash_algo != base_hash_algo) ||
+             (spdm_context->transcript.digest_context_vca_size != message_a_size))) {
+            libspdm_reset_digest_context_vca(spdm_context);
+        }
+        if (spdm_context->transcript.digest_context_vca == NULL) {
+            digest_context = libspdm_hash_new (base_hash_algo);
+            if (digest_context == NULL) {
+                return NULL;
+            }
+            result = libspdm_hash_init (base_hash_algo, digest_context);
+            if (result) {
+                result = libspdm_hash_update (
+                    base_hash_algo, digest_context,
+                    libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
+                    message_a_size);
+            }
+            if (!result) {
+                libspdm_hash_free (base_hash_algo, digest_context);
+                return NULL;
+            }
+            spdm_context->transcript.digest_context_vca = digest_context;
+            spdm_context->transcript.digest_context_vca_hash_algo = base_hash_algo;
+            spdm_context->transcript.digest_context_vca_size = message_a_size;
+        }
+    }
+
+    digest_context = libspdm_hash_new (base_hash_algo);
+    if (digest_context == NULL) {
+        return NULL;
+    }
+    if (include_message_a) {
+        result = libspdm_hash_duplicate (base_hash_algo,
+                                         spdm_context->transcript.digest_context_vca,
+                                         digest_context);
+    } else {
+        result = libspdm_hash_init (base_hash_algo, digest_context);
+    }
+    if (!result) {
+        libspdm_hash_free (base_hash_algo, digest_context);
+        return NULL;
+    }
+    return digest_context;
+}
+#endif /* !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
+
 /**
  * Reset message A cache in SPDM context.
  *
@@ -1248,6 +1393,9 @@ bool libspdm_check_context (void *spdm_context)
 void libspdm_reset_message_a(libspdm_context_t *spdm_context)
 {
     libspdm_reset_managed_buffer(&spdm_context->transcript.message_a);
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    libspdm_reset_digest_context_vca(spdm_context);
+#endif
 }
 
 /**
@@ -1608,31 +1756,11 @@ libspdm_return_t libspdm_append_message_b(libspdm_context_t *spdm_context, const
         bool result;
 
         if (spdm_context->transcript.digest_context_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
+            spdm_context->transcript.digest_context_m1m2 =
+                libspdm_new_transcript_digest_context(spdm_context, true);
             if (spdm_context->transcript.digest_context_m1m2 == NULL) {
                 return LIBSPDM_STATUS_CRYPTO_ERROR;
             }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_m1m2);
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
-            result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                          spdm_context->transcript.digest_context_m1m2,
-                                          libspdm_get_managed_buffer(&spdm_context->transcript.
-                                                                     message_a),
-                                          libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                                          message_a));
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
         }
 
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
@@ -1661,31 +1789,11 @@ libspdm_return_t libspdm_append_message_c(libspdm_context_t *spdm_context, const
         bool result;
 
         if (spdm_context->transcript.digest_context_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
+            spdm_context->transcript.digest_context_m1m2 =
+                libspdm_new_transcript_digest_context(spdm_context, true);
             if (spdm_context->transcript.digest_context_m1m2 == NULL) {
                 return LIBSPDM_STATUS_CRYPTO_ERROR;
             }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_m1m2);
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
-            result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                          spdm_context->transcript.digest_context_m1m2,
-                                          libspdm_get_managed_buffer(&spdm_context->transcript.
-                                                                     message_a),
-                                          libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                                          message_a));
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
         }
 
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
@@ -1714,36 +1822,14 @@ libspdm_return_t libspdm_append_message_mut_b(libspdm_context_t *spdm_context, c
         bool result;
 
         if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_mut_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
+            /* Need append VCA since 1.2 script */
+            spdm_context->transcript.digest_context_mut_m1m2 =
+                libspdm_new_transcript_digest_context(
+                    spdm_context, (spdm_context->connection_info.version >>
+                                   SPDM_VERSION_NUMBER_SHIFT_BIT) > SPDM_MESSAGE_VERSION_11);
             if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
                 return LIBSPDM_STATUS_CRYPTO_ERROR;
             }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_mut_m1m2);
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_mut_m1m2);
-                spdm_context->transcript.digest_context_mut_m1m2 = NULL;
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
-            if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
-                SPDM_MESSAGE_VERSION_11) {
-
-                /* Need append VCA since 1.2 script */
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_context->transcript.digest_context_mut_m1m2,
-                    libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                    message_a));
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_mut_m1m2);
-                    spdm_context->transcript.digest_context_mut_m1m2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-            }
         }
 
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
@@ -1772,36 +1858,14 @@ libspdm_return_t libspdm_append_message_mut_c(libspdm_context_t *spdm_context, c
         bool result;
 
         if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_mut_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
+            /* Need append VCA since 1.2 script */
+            spdm_context->transcript.digest_context_mut_m1m2 =
+                libspdm_new_transcript_digest_context(
+                    spdm_context, (spdm_context->connection_info.version >>
+                                   SPDM_VERSION_NUMBER_SHIFT_BIT) > SPDM_MESSAGE_VERSION_11);
             if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
                 return LIBSPDM_STATUS_CRYPTO_ERROR;
             }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_mut_m1m2);
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_mut_m1m2);
-                spdm_context->transcript.digest_context_mut_m1m2 = NULL;
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
-            if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
-                SPDM_MESSAGE_VERSION_11) {
-
-                /* Need append VCA since 1.2 script */
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_context->transcript.digest_context_mut_m1m2,
-                    libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                    message_a));
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_mut_m1m2);
-                    spdm_context->transcript.digest_context_mut_m1m2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-            }
         }
 
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
@@ -1839,37 +1903,14 @@ libspdm_return_t libspdm_append_message_m(libspdm_context_t *spdm_context, void
 
         if (spdm_session_info == NULL) {
             if (spdm_context->transcript.digest_context_l1l2 == NULL) {
-                spdm_context->transcript.digest_context_l1l2 = libspdm_hash_new (
-                    spdm_context->connection_info.algorithm.base_hash_algo);
+                /* Need append VCA since 1.2 script */
+                spdm_context->transcript.digest_context_l1l2 =
+                    libspdm_new_transcript_digest_context(
+                        spdm_context, (spdm_context->connection_info.version >>
+                                       SPDM_VERSION_NUMBER_SHIFT_BIT) > SPDM_MESSAGE_VERSION_11);
                 if (spdm_context->transcript.digest_context_l1l2 == NULL) {
                     return LIBSPDM_STATUS_CRYPTO_ERROR;
                 }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_context->transcript.digest_context_l1l2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_l1l2);
-                    spdm_context->transcript.digest_context_l1l2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-                if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
-                    SPDM_MESSAGE_VERSION_11) {
-
-                    /* Need append VCA since 1.2 script */
-                    result = libspdm_hash_update (
-                        spdm_context->connection_info.algorithm.base_hash_algo,
-                        spdm_context->transcript.digest_context_l1l2,
-                        libspdm_get_managed_buffer(
-                            &spdm_context->transcript.message_a),
-                        libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                        message_a));
-                    if (!result) {
-                        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                           spdm_context->transcript.digest_context_l1l2);
-                        spdm_context->transcript.digest_context_l1l2 = NULL;
-                        return LIBSPDM_STATUS_CRYPTO_ERROR;
-                    }
-                }
             }
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_context->transcript.digest_context_l1l2, message,
@@ -1882,38 +1923,14 @@ libspdm_return_t libspdm_append_message_m(libspdm_context_t *spdm_context, void
             }
         } else {
             if (spdm_session_info->session_transcript.digest_context_l1l2 == NULL) {
-                spdm_session_info->session_transcript.digest_context_l1l2 = libspdm_hash_new (
-                    spdm_context->connection_info.algorithm.base_hash_algo);
+                /* Need append VCA since 1.2 script */
+                spdm_session_info->session_transcript.digest_context_l1l2 =
+                    libspdm_new_transcript_digest_context(
+                        spdm_context, (spdm_context->connection_info.version >>
+                                       SPDM_VERSION_NUMBER_SHIFT_BIT) > SPDM_MESSAGE_VERSION_11);
                 if (spdm_session_info->session_transcript.digest_context_l1l2 == NULL) {
                     return LIBSPDM_STATUS_CRYPTO_ERROR;
                 }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_session_info->session_transcript.digest_context_l1l2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_session_info->session_transcript.digest_context_l1l2);
-                    spdm_session_info->session_transcript.digest_context_l1l2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-                if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
-                    SPDM_MESSAGE_VERSION_11) {
-
-                    /* Need append VCA since 1.2 script*/
-
-                    result = libspdm_hash_update (
-                        spdm_context->connection_info.algorithm.base_hash_algo,
-                        spdm_session_info->session_transcript.digest_context_l1l2,
-                        libspdm_get_managed_buffer(
-                            &spdm_context->transcript.message_a),
-                        libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                        message_a));
-                    if (!result) {
-                        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                           spdm_session_info->session_transcript.digest_context_l1l2);
-                        spdm_session_info->session_transcript.digest_context_l1l2 = NULL;
-                        return LIBSPDM_STATUS_CRYPTO_ERROR;
-                    }
-                }
             }
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_session_info->session_transcript.digest_context_l1l2,
@@ -2017,29 +2034,11 @@ libspdm_return_t libspdm_append_message_k(libspdm_context_t *spdm_context,
         /* prepare digest_context_th*/
 
         if (spdm_session_info->session_transcript.digest_context_th == NULL) {
-            spdm_session_info->session_transcript.digest_context_th = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
+            spdm_session_info->session_transcript.digest_context_th =
+                libspdm_new_transcript_digest_context(spdm_context, true);
             if (spdm_session_info->session_transcript.digest_context_th == NULL) {
                 return LIBSPDM_STATUS_CRYPTO_ERROR;
             }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_session_info->session_transcript.digest_context_th);
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_session_info->session_transcript.digest_context_th);
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
-            result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                          spdm_session_info->session_transcript.digest_context_th,
-                                          libspdm_get_managed_buffer(&spdm_context->transcript.
-                                                                     message_a),
-                                          libspdm_get_managed_buffer_size(
-                                              &spdm_context->transcript.message_a));
-            if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_session_info->session_transcript.digest_context_th);
-                return LIBSPDM_STATUS_CRYPTO_ERROR;
-            }
             if (!spdm_session_info->use_psk) {
                 if (spdm_context->connection_info.multi_key_conn_rsp) {
                     result = libspdm_hash_update (
@@ -2283,32 +2282,11 @@ libspdm_return_t libspdm_append_message_e(libspdm_context_t *spdm_context, void
 
         if (spdm_session_info == NULL) {
             if (spdm_context->transcript.digest_context_il1il2 == NULL) {
-                spdm_context->transcript.digest_context_il1il2 = libspdm_hash_new (
-                    spdm_context->connection_info.algorithm.base_hash_algo);
+                spdm_context->transcript.digest_context_il1il2 =
+                    libspdm_new_transcript_digest_context(spdm_context, true);
                 if (spdm_context->transcript.digest_context_il1il2 == NULL) {
                     return LIBSPDM_STATUS_CRYPTO_ERROR;
                 }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_context->transcript.digest_context_il1il2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_il1il2);
-                    spdm_context->transcript.digest_context_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_context->transcript.digest_context_il1il2,
-                    libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_il1il2);
-                    spdm_context->transcript.digest_context_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
             }
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_context->transcript.digest_context_il1il2, message,
@@ -2321,32 +2299,11 @@ libspdm_return_t libspdm_append_message_e(libspdm_context_t *spdm_context, void
             }
         } else {
             if (spdm_session_info->session_transcript.digest_context_il1il2 == NULL) {
-                spdm_session_info->session_transcript.digest_context_il1il2 = libspdm_hash_new (
-                    spdm_context->connection_info.algorithm.base_hash_algo);
+                spdm_session_info->session_transcript.digest_context_il1il2 =
+                    libspdm_new_transcript_digest_context(spdm_context, true);
                 if (spdm_session_info->session_transcript.digest_context_il1il2 == NULL) {
                     return LIBSPDM_STATUS_CRYPTO_ERROR;
                 }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_session_info->session_transcript.digest_context_il1il2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_session_info->session_transcript.digest_context_il1il2);
-                    spdm_session_info->session_transcript.digest_context_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_session_info->session_transcript.digest_context_il1il2,
-                    libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_session_info->session_transcript.digest_context_il1il2);
-                    spdm_session_info->session_transcript.digest_context_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
             }
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_session_info->session_transcript.digest_context_il1il2,
@@ -2384,32 +2341,11 @@ libspdm_return_t libspdm_append_message_encap_e(libspdm_context_t *spdm_context,
 
         if (spdm_session_info == NULL) {
             if (spdm_context->transcript.digest_context_encap_il1il2 == NULL) {
-                spdm_context->transcript.digest_context_encap_il1il2 = libspdm_hash_new (
-                    spdm_context->connection_info.algorithm.base_hash_algo);
+                spdm_context->transcript.digest_context_encap_il1il2 =
+                    libspdm_new_transcript_digest_context(spdm_context, true);
                 if (spdm_context->transcript.digest_context_encap_il1il2 == NULL) {
                     return LIBSPDM_STATUS_CRYPTO_ERROR;
                 }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_context->transcript.digest_context_encap_il1il2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_encap_il1il2);
-                    spdm_context->transcript.digest_context_encap_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_context->transcript.digest_context_encap_il1il2,
-                    libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_encap_il1il2);
-                    spdm_context->transcript.digest_context_encap_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
             }
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_context->transcript.digest_context_encap_il1il2,
@@ -2424,31 +2360,10 @@ libspdm_return_t libspdm_append_message_encap_e(libspdm_context_t *spdm_context,
         } else {
             if (spdm_session_info->session_transcript.digest_context_encap_il1il2 == NULL) {
                 spdm_session_info->session_transcript.digest_context_encap_il1il2 =
-                    libspdm_hash_new (spdm_context->connection_info.algorithm.base_hash_algo);
+                    libspdm_new_transcript_digest_context(spdm_context, true);
                 if (spdm_session_info->session_transcript.digest_context_encap_il1il2 == NULL) {
                     return LIBSPDM_STATUS_CRYPTO_ERROR;
                 }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_session_info->session_transcript.digest_context_encap_il1il2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_session_info->session_transcript.digest_context_encap_il1il2);
-                    spdm_session_info->session_transcript.digest_context_encap_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
-
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_session_info->session_transcript.digest_context_encap_il1il2,
-                    libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_session_info->session_transcript.digest_context_encap_il1il2);
-                    spdm_session_info->session_transcript.digest_context_encap_il1il2 = NULL;
-                    return LIBSPDM_STATUS_CRYPTO_ERROR;
-                }
             }
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_session_info->session_transcript.digest_context_encap_il1il2,
@@ -2705,6 +2620,29 @@ void libspdm_register_device_buffer_func(
     context->local_context.capability.data_transfer_size = receiver_buffer_size;
 }
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+/**
+ * Register the functions that manage the storage of peer certificate chains.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context                    A pointer to the SPDM context.
+ * @param  acquire_peer_cert_chain_buffer  The function to acquire a certificate chain buffer.
+ * @param  release_peer_cert_chain_buffer  The function to release a certificate chain buffer.
+ **/
+void libspdm_register_peer_cert_chain_buffer_func(
+    void *spdm_context,
+    libspdm_acquire_peer_cert_chain_buffer_func acquire_peer_cert_chain_buffer,
+    libspdm_release_peer_cert_chain_buffer_func release_peer_cert_chain_buffer)
+{
+    libspdm_context_t *context;
+
+    context = spdm_context;
+    context->acquire_peer_cert_chain_buffer = acquire_peer_cert_chain_buffer;
+    context->release_peer_cert_chain_buffer = release_peer_cert_chain_buffer;
+}
+#endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL */
+
 /**
  * Register SPDM transport layer encode/decode functions for SPDM or APP messages.
  *
@@ -3096,19 +3034,19 @@ bool libspdm_export_fips_selftest_context_from_spdm_context(void *spdm_context,
 
 #endif /* LIBSPDM_FIPS_MODE */
 
-libspdm_return_t libspdm_init_context_with_secured_context(void *spdm_context,
-                                                           void **secured_contexts,
-                                                           size_t num_secured_contexts)
+static libspdm_return_t libspdm_init_context_with_session_storage(
+    libspdm_context_t *context, libspdm_session_info_t *session_info,
+    uint16_t *session_index, void **secured_contexts, size_t num_secured_contexts)
 {
-    libspdm_context_t *context;
     size_t index;
 
-    LIBSPDM_ASSERT(spdm_context != NULL);
-    LIBSPDM_ASSERT(secured_contexts != NULL);
-    LIBSPDM_ASSERT(num_secured_contexts == LIBSPDM_MAX_SESSION_COUNT);
-
-    context = spdm_context;
     libspdm_zero_mem(context, sizeof(libspdm_context_t));
+    context->session_info = session_info;
+    context->max_session_count = (uint32_t)num_secured_contexts;
+    context->session_index = session_index;
+    context->session_index_count = libspdm_get_session_index_count(num_secured_contexts);
+    libspdm_zero_mem(session_info, sizeof(libspdm_session_info_t) * num_secured_contexts);
+    libspdm_zero_mem(session_index, sizeof(uint16_t) * context->session_index_count);
     context->version = LIBSPDM_CONTEXT_STRUCT_VERSION;
     context->transcript.message_a.max_buffer_size =
         sizeof(context->transcript.message_a.buffer);
@@ -3179,6 +3117,59 @@ libspdm_return_t libspdm_init_context_with_secured_context(void *spdm_context,
     return LIBSPDM_STATUS_SUCCESS;
 }
 
+libspdm_return_t libspdm_init_context_with_secured_context(void *spdm_context,
+                                                           void **secured_contexts,
+                                                           size_t num_secured_contexts)
+{
+    libspdm_context_t *context;
+
+    LIBSPDM_ASSERT(spdm_context != NULL);
+    LIBSPDM_ASSERT(secured_contexts != NULL);
+
+    if ((num_secured_contexts == 0) || (num_secured_contexts > LIBSPDM_MAX_SESSION_COUNT)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    context = spdm_context;
+    return libspdm_init_context_with_session_storage(context, context->session_info_default,
+                                                     context->session_index_default,
+                                                     secured_contexts, num_secured_contexts);
+}
+
+size_t libspdm_get_session_table_size(size_t max_session_count)
+{
+    return sizeof(libspdm_session_info_t) * max_session_count +
+           sizeof(uint16_t) * libspdm_get_session_index_count(max_session_count);
+}
+
+libspdm_return_t libspdm_init_context_with_session_table(void *spdm_context,
+                                                         void *session_table,
+                                                         size_t session_table_size,
+                                                         void **secured_contexts,
+                                                         size_t num_secured_contexts)
+{
+    libspdm_session_info_t *session_info;
+    uint16_t *session_index;
+
+    LIBSPDM_ASSERT(spdm_context != NULL);
+    LIBSPDM_ASSERT(session_table != NULL);
+    LIBSPDM_ASSERT(secured_contexts != NULL);
+
+    if ((num_secured_contexts == 0) || (num_secured_contexts > LIBSPDM_MAX_SESSION_TABLE_COUNT)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+    if (session_table_size < libspdm_get_session_table_size(num_secured_contexts)) {
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    /* The session index follows the session info entries. */
+    session_info = session_table;
+    session_index = (uint16_t *)(session_info + num_secured_contexts);
+
+    return libspdm_init_context_with_session_storage(spdm_context, session_info, session_index,
+                                                     secured_contexts, num_secured_contexts);
+}
+
 libspdm_return_t libspdm_init_context(void *spdm_context)
 {
     libspdm_context_t *context;
@@ -3216,7 +3207,7 @@ void libspdm_reset_context(void *spdm_context)
 
     /* Need to clear session information and message transcripts before negotiated algorithm
      * information is cleared. */
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++)
+    for (index = 0; index < context->max_session_count; index++)
     {
         libspdm_session_info_init(context,
                                   &context->session_info[index],
@@ -3256,6 +3247,9 @@ void libspdm_reset_context(void *spdm_context)
     context->mut_auth_cert_chain_buffer_size = 0;
     context->current_dhe_session_count = 0;
     context->current_psk_session_count = 0;
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    libspdm_zero_mem(&context->measurement_cache, sizeof(context->measurement_cache));
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
 }
 
 /**
@@ -3275,10 +3269,23 @@ void libspdm_deinit_context(void *spdm_context)
     void *pubkey_context;
     bool is_requester;
     uint8_t slot_index;
+#elif LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+    uint8_t slot_index;
 #endif
 
     context = spdm_context;
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+    for (slot_index = 0; slot_index < SPDM_MAX_SLOT_COUNT; slot_index++) {
+        if (context->connection_info.peer_used_cert_chain[slot_index].buffer != NULL) {
+            context->release_peer_cert_chain_buffer(
+                context, slot_index, context->connection_info.peer_used_cert_chain[slot_index].buffer);
+            context->connection_info.peer_used_cert_chain[slot_index].buffer = NULL;
+            context->connection_info.peer_used_cert_chain[slot_index].buffer_size = 0;
+        }
+    }
+#endif
+
 #if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
     is_requester = context->local_context.is_requester;
 
@@ -3319,7 +3326,7 @@ void libspdm_deinit_context(void *spdm_context)
     libspdm_reset_message_m(spdm_context, NULL);
     libspdm_reset_message_e(spdm_context, NULL);
     libspdm_reset_message_encap_e(spdm_context, NULL);
-    for (session_id = 0; session_id < LIBSPDM_MAX_SESSION_COUNT; session_id++) {
+    for (session_id = 0; session_id < context->max_session_count; session_id++) {
         session_info = &context->session_info[session_id];
         libspdm_reset_message_m(context, session_info);
         libspdm_reset_message_e(context, session_info);
@@ -3327,6 +3334,8 @@ void libspdm_deinit_context(void *spdm_context)
         libspdm_reset_message_encap_d(context, session_info);
         libspdm_reset_message_k(context, session_info);
         libspdm_reset_message_f(context, session_info);
+        libspdm_secured_message_free_aead_contexts(session_info->secured_message_context);
+        libspdm_secured_message_free_hmac_contexts(session_info->secured_message_context);
     }
 }
 
@@ -6,6 +6,97 @@
 
 #include "internal/libspdm_secured_message_lib.h"
 
+uint32_t libspdm_get_session_index_count(size_t max_session_count)
+{
+    uint32_t session_index_count;
+
+    session_index_count = 1;
+    while (session_index_count < max_session_count * 2) {
+        session_index_count <<= 1;
+    }
+    return session_index_count;
+}
+
+static uint32_t libspdm_session_index_hash(const libspdm_context_t *spdm_context,
+                                           uint32_t session_id)
+{
+    uint32_t hash;
+
+    /* Both halves of the session ID are chosen by a peer, so mix them before masking. */
+    hash = session_id * 0x9E3779B1u;
+    hash ^= hash >> 16;
+    return hash & (spdm_context->session_index_count - 1);
+}
+
+static void libspdm_session_index_insert(libspdm_context_t *spdm_context,
+                                         const libspdm_session_info_t *session_info)
+{
+    uint32_t position;
+
+    position = libspdm_session_index_hash(spdm_context, session_info->session_id);
+    while (spdm_context->session_index[position] != 0) {
+        position = (position + 1) & (spdm_context->session_index_count - 1);
+    }
+    spdm_context->session_index[position] =
+        (uint16_t)(session_info - spdm_context->session_info + 1);
+}
+
+static void libspdm_session_index_remove(libspdm_context_t *spdm_context,
+                                         const libspdm_session_info_t *session_info)
+{
+    uint32_t mask;
+    uint32_t position;
+    uint32_t next;
+    uint32_t home;
+    uint16_t entry;
+
+    mask = spdm_context->session_index_count - 1;
+    entry = (uint16_t)(session_info - spdm_context->session_info + 1);
+
+    position = libspdm_session_index_hash(spdm_context, session_info->session_id);
+    while (spdm_context->session_index[position] != entry) {
+        if (spdm_context->session_index[position] == 0) {
+            return;
+        }
+        position = (position + 1) & mask;
+    }
+
+    /* Shift back the entries that follow so that no probe sequence is broken by the hole. */
+    next = position;
+    while (true) {
+        spdm_context->session_index[position] = 0;
+        do {
+            next = (next + 1) & mask;
+            entry = spdm_context->session_index[next];
+            if (entry == 0) {
+                return;
+            }
+            home = libspdm_session_index_hash(
+                spdm_context, spdm_context->session_info[entry - 1].session_id);
+        } while (((next - home) & mask) < ((next - position) & mask));
+        spdm_context->session_index[position] = entry;
+        position = next;
+    }
+}
+
+static libspdm_session_info_t *libspdm_session_index_find(libspdm_context_t *spdm_context,
+                                                          uint32_t session_id)
+{
+    libspdm_session_info_t *session_info;
+    uint32_t position;
+    uint16_t entry;
+
+    position = libspdm_session_index_hash(spdm_context, session_id);
+    while ((entry = spdm_context->session_index[position]) != 0) {
+        session_info = &spdm_context->session_info[entry - 1];
+        if (session_info->session_id == session_id) {
+            return session_info;
+        }
+        position = (position + 1) & (spdm_context->session_index_count - 1);
+    }
+    return NULL;
+}
+
 /**
  * This function initializes the session info.
  *
@@ -20,6 +111,13 @@ void libspdm_session_info_init(libspdm_context_t *spdm_context,
     libspdm_session_type_t session_type;
     uint32_t capabilities_flag;
 
+    LIBSPDM_ASSERT((session_info >= spdm_context->session_info) &&
+                   (session_info < spdm_context->session_info + spdm_context->max_session_count));
+
+    if (session_info->session_id != INVALID_SESSION_ID) {
+        libspdm_session_index_remove(spdm_context, session_info);
+    }
+
     if (session_id != INVALID_SESSION_ID) {
         if (use_psk) {
             LIBSPDM_ASSERT((spdm_context->max_psk_session_count == 0) ||
@@ -80,8 +178,13 @@ void libspdm_session_info_init(libspdm_context_t *spdm_context,
 
     libspdm_zero_mem (&(session_info->last_key_update_request), sizeof(spdm_key_update_request_t));
     libspdm_zero_mem(session_info, offsetof(libspdm_session_info_t, secured_message_context));
+    libspdm_secured_message_free_aead_contexts(session_info->secured_message_context);
+    libspdm_secured_message_free_hmac_contexts(session_info->secured_message_context);
     libspdm_secured_message_init_context(session_info->secured_message_context);
     session_info->session_id = session_id;
+    if (session_id != INVALID_SESSION_ID) {
+        libspdm_session_index_insert(spdm_context, session_info);
+    }
     session_info->use_psk = use_psk;
     libspdm_secured_message_set_use_psk(session_info->secured_message_context, use_psk);
     libspdm_secured_message_set_session_type(session_info->secured_message_context, session_type);
@@ -99,6 +202,8 @@ void libspdm_session_info_init(libspdm_context_t *spdm_context,
 
     libspdm_secured_message_set_max_spdm_session_sequence_number(
         session_info->secured_message_context, spdm_context->max_spdm_session_sequence_number);
+    libspdm_secured_message_set_replay_window_size(session_info->secured_message_context,
+                                                   spdm_context->replay_window_size);
     libspdm_secured_message_set_algorithms(
         session_info->secured_message_context,
         spdm_context->connection_info.version,
@@ -146,9 +251,7 @@ void libspdm_session_info_set_psk_hint(libspdm_session_info_t *session_info,
  **/
 void *libspdm_get_session_info_via_session_id(void *spdm_context, uint32_t session_id)
 {
-    libspdm_context_t *context;
     libspdm_session_info_t *session_info;
-    size_t index;
 
     if (session_id == INVALID_SESSION_ID) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR,
@@ -157,13 +260,9 @@ void *libspdm_get_session_info_via_session_id(void *spdm_context, uint32_t sessi
         return NULL;
     }
 
-    context = spdm_context;
-
-    session_info = (libspdm_session_info_t *)context->session_info;
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
-        if (session_info[index].session_id == session_id) {
-            return &session_info[index];
-        }
+    session_info = libspdm_session_index_find(spdm_context, session_id);
+    if (session_info != NULL) {
+        return session_info;
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR,
@@ -239,18 +338,16 @@ libspdm_session_info_t *libspdm_assign_session_id(libspdm_context_t *spdm_contex
         return NULL;
     }
 
-    session_info = spdm_context->session_info;
-
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
-        if (session_info[index].session_id == session_id) {
-            LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR,
-                           "libspdm_assign_session_id - Duplicated session_id\n"));
-            LIBSPDM_ASSERT(false);
-            return NULL;
-        }
+    if (libspdm_session_index_find(spdm_context, session_id) != NULL) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR,
+                       "libspdm_assign_session_id - Duplicated session_id\n"));
+        LIBSPDM_ASSERT(false);
+        return NULL;
     }
 
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
+    session_info = spdm_context->session_info;
+
+    for (index = 0; index < spdm_context->max_session_count; index++) {
         if (session_info[index].session_id == INVALID_SESSION_ID) {
             libspdm_session_info_init(spdm_context,
                                       &session_info[index], session_id, secured_message_version,
@@ -273,7 +370,6 @@ libspdm_session_info_t *libspdm_assign_session_id(libspdm_context_t *spdm_contex
 void libspdm_free_session_id(libspdm_context_t *spdm_context, uint32_t session_id)
 {
     libspdm_session_info_t *session_info;
-    size_t index;
 
     if (session_id == INVALID_SESSION_ID) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR, "libspdm_free_session_id - Invalid session_id\n"));
@@ -285,15 +381,11 @@ void libspdm_free_session_id(libspdm_context_t *spdm_context, uint32_t session_i
         spdm_context->latest_session_id = INVALID_SESSION_ID;
     }
 
-    session_info = spdm_context->session_info;
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
-        if (session_info[index].session_id == session_id) {
-            libspdm_session_info_init(spdm_context,
-                                      &session_info[index],
-                                      INVALID_SESSION_ID, 0,
-                                      session_info[index].use_psk);
-            return;
-        }
+    session_info = libspdm_session_index_find(spdm_context, session_id);
+    if (session_info != NULL) {
+        libspdm_session_info_init(spdm_context, session_info, INVALID_SESSION_ID, 0,
+                                  session_info->use_psk);
+        return;
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR, "libspdm_free_session_id - MAX session_id\n"));
@@ -71,6 +71,52 @@ void libspdm_get_peer_cert_chain_data(void *spdm_context,
     *cert_chain_data = (const uint8_t *)*cert_chain_data + sizeof(spdm_cert_chain_t) + hash_size;
     *cert_chain_data_size = *cert_chain_data_size - (sizeof(spdm_cert_chain_t) + hash_size);
 }
+
+libspdm_return_t libspdm_set_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
+                                                    uint8_t slot_id,
+                                                    const void *cert_chain_buffer,
+                                                    size_t cert_chain_buffer_size)
+{
+    libspdm_peer_used_cert_chain_t *peer_cert_chain;
+#if LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+    libspdm_return_t status;
+#endif
+
+    LIBSPDM_ASSERT(slot_id < SPDM_MAX_SLOT_COUNT);
+
+    if (cert_chain_buffer_size > LIBSPDM_MAX_CERT_CHAIN_SIZE) {
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    peer_cert_chain = &spdm_context->connection_info.peer_used_cert_chain[slot_id];
+
+#if LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+    LIBSPDM_ASSERT(spdm_context->acquire_peer_cert_chain_buffer != NULL);
+
+    if (peer_cert_chain->buffer != NULL) {
+        spdm_context->release_peer_cert_chain_buffer(spdm_context, slot_id,
+                                                     peer_cert_chain->buffer);
+        peer_cert_chain->buffer = NULL;
+        peer_cert_chain->buffer_size = 0;
+    }
+
+    status = spdm_context->acquire_peer_cert_chain_buffer(spdm_context, slot_id,
+                                                          cert_chain_buffer_size,
+                                                          &peer_cert_chain->buffer);
+    if (status != LIBSPDM_STATUS_SUCCESS) {
+        peer_cert_chain->buffer = NULL;
+        return LIBSPDM_STATUS_ACQUIRE_FAIL;
+    }
+    libspdm_copy_mem(peer_cert_chain->buffer, cert_chain_buffer_size,
+                     cert_chain_buffer, cert_chain_buffer_size);
+#else
+    libspdm_copy_mem(peer_cert_chain->buffer, sizeof(peer_cert_chain->buffer),
+                     cert_chain_buffer, cert_chain_buffer_size);
+#endif
+    peer_cert_chain->buffer_size = cert_chain_buffer_size;
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
 #endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
 
 /**
@@ -201,3 +201,216 @@ bool libspdm_aead_decryption(const spdm_version_number_t secured_message_version
         return false;
     }
 }
+
+void *libspdm_aead_new(uint16_t aead_cipher_suite)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_new();
+#else
+        LIBSPDM_ASSERT(false);
+        return NULL;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_new();
+#else
+        LIBSPDM_ASSERT(false);
+        return NULL;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM:
+#if LIBSPDM_AEAD_SM4_SUPPORT
+        return libspdm_aead_sm4_gcm_new();
+#else
+        LIBSPDM_ASSERT(false);
+        return NULL;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        return NULL;
+    }
+}
+
+void libspdm_aead_free(uint16_t aead_cipher_suite, void *aead_context)
+{
+    if (aead_context == NULL) {
+        return;
+    }
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        libspdm_aead_aes_gcm_free(aead_context);
+#else
+        LIBSPDM_ASSERT(false);
+#endif
+        break;
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        libspdm_aead_chacha20_poly1305_free(aead_context);
+#else
+        LIBSPDM_ASSERT(false);
+#endif
+        break;
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM:
+#if LIBSPDM_AEAD_SM4_SUPPORT
+        libspdm_aead_sm4_gcm_free(aead_context);
+#else
+        LIBSPDM_ASSERT(false);
+#endif
+        break;
+    default:
+        LIBSPDM_ASSERT(false);
+        break;
+    }
+}
+
+bool libspdm_aead_set_key(uint16_t aead_cipher_suite, void *aead_context,
+                          const uint8_t *key, size_t key_size)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_set_key(aead_context, key, key_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_set_key(aead_context, key, key_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM:
+#if LIBSPDM_AEAD_SM4_SUPPORT
+        return libspdm_aead_sm4_gcm_set_key(aead_context, key, key_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        return false;
+    }
+}
+
+bool libspdm_aead_encryption_with_context(const spdm_version_number_t secured_message_version,
+                                          uint16_t aead_cipher_suite, void *aead_context,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          uint8_t *tag_out, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_encrypt_with_context(aead_context, iv, iv_size, a_data, a_data_size,
+                                                         data_in, data_in_size, tag_out, tag_size,
+                                                         data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_encrypt_with_context(aead_context, iv, iv_size, a_data, a_data_size,
+                                                                   data_in, data_in_size, tag_out, tag_size,
+                                                                   data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM:
+#if LIBSPDM_AEAD_SM4_SUPPORT
+        return libspdm_aead_sm4_gcm_encrypt_with_context(aead_context, iv, iv_size, a_data, a_data_size,
+                                                         data_in, data_in_size, tag_out, tag_size,
+                                                         data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        return false;
+    }
+}
+
+bool libspdm_aead_decryption_with_context(const spdm_version_number_t secured_message_version,
+                                          uint16_t aead_cipher_suite, void *aead_context,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          const uint8_t *tag, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_decrypt_with_context(aead_context, iv, iv_size, a_data, a_data_size,
+                                                         data_in, data_in_size, tag, tag_size,
+                                                         data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_decrypt_with_context(aead_context, iv, iv_size, a_data, a_data_size,
+                                                                   data_in, data_in_size, tag, tag_size,
+                                                                   data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM:
+#if LIBSPDM_AEAD_SM4_SUPPORT
+        return libspdm_aead_sm4_gcm_decrypt_with_context(aead_context, iv, iv_size, a_data, a_data_size,
+                                                         data_in, data_in_size, tag, tag_size,
+                                                         data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        return false;
+    }
+}
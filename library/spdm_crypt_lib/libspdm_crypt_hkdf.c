@@ -125,3 +125,57 @@ bool libspdm_hkdf_expand(uint32_t base_hash_algo, const uint8_t *prk,
         return false;
     }
 }
+
+bool libspdm_hkdf_expand_with_hmac_context(uint32_t base_hash_algo, const void *prk_hmac_ctx,
+                                           const uint8_t *info, size_t info_size,
+                                           uint8_t *out, size_t out_size)
+{
+    void *hmac_ctx;
+    uint8_t block[LIBSPDM_MAX_HASH_SIZE];
+    size_t hash_size;
+    size_t offset;
+    size_t block_size;
+    uint8_t counter;
+    bool result;
+
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+    if ((prk_hmac_ctx == NULL) || (out == NULL) || (hash_size == 0) ||
+        (out_size > 255 * hash_size)) {
+        return false;
+    }
+
+    hmac_ctx = libspdm_hmac_new(base_hash_algo);
+    if (hmac_ctx == NULL) {
+        return false;
+    }
+
+    /* T(n) = HMAC(PRK, T(n - 1) | info | n), with T(0) empty. */
+    result = true;
+    offset = 0;
+    counter = 1;
+    while (result && (offset < out_size)) {
+        result = libspdm_hmac_duplicate(base_hash_algo, prk_hmac_ctx, hmac_ctx);
+        if (result && (offset != 0)) {
+            result = libspdm_hmac_update(base_hash_algo, hmac_ctx, block, hash_size);
+        }
+        if (result && (info_size != 0)) {
+            result = libspdm_hmac_update(base_hash_algo, hmac_ctx, info, info_size);
+        }
+        if (result) {
+            result = libspdm_hmac_update(base_hash_algo, hmac_ctx, &counter, sizeof(counter));
+        }
+        if (result) {
+            result = libspdm_hmac_final(base_hash_algo, hmac_ctx, block);
+        }
+        if (result) {
+            block_size = LIBSPDM_MIN(hash_size, out_size - offset);
+            libspdm_copy_mem(out + offset, out_size - offset, block, block_size);
+            offset += block_size;
+            counter++;
+        }
+    }
+
+    libspdm_zero_mem(block, sizeof(block));
+    libspdm_hmac_free(base_hash_algo, hmac_ctx);
+    return result;
+}
@@ -420,3 +420,31 @@ bool libspdm_hmac_all(uint32_t base_hash_algo, const void *data,
         return false;
     }
 }
+
+bool libspdm_hmac_all_with_hmac_context(uint32_t base_hash_algo, const void *key_hmac_ctx,
+                                        const void *data, size_t data_size,
+                                        uint8_t *hmac_value)
+{
+    void *hmac_ctx;
+    bool result;
+
+    if (key_hmac_ctx == NULL) {
+        return false;
+    }
+
+    hmac_ctx = libspdm_hmac_new(base_hash_algo);
+    if (hmac_ctx == NULL) {
+        return false;
+    }
+
+    result = libspdm_hmac_duplicate(base_hash_algo, key_hmac_ctx, hmac_ctx);
+    if (result) {
+        result = libspdm_hmac_update(base_hash_algo, hmac_ctx, data, data_size);
+    }
+    if (result) {
+        result = libspdm_hmac_final(base_hash_algo, hmac_ctx, hmac_value);
+    }
+
+    libspdm_hmac_free(base_hash_algo, hmac_ctx);
+    return result;
+}
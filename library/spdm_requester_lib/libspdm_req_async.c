@@ -0,0 +1,750 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_requester_lib.h"
+
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+
+/* A request that can run asynchronously. The functions are the halves of the blocking request
+ * before and after the message exchange. */
+typedef struct {
+    uint8_t request_code;
+    uint8_t response_code;
+    /* The crypto_request of the blocking request, which selects the response timeout. */
+    bool crypto_request;
+    /* True if process_response also handles ERROR responses, as the VCA requests do. */
+    bool process_error;
+    /* Check the Requester state and build the request. */
+    libspdm_return_t (*build_request)(libspdm_context_t *spdm_context,
+                                      const uint32_t *session_id,
+                                      size_t *request_size, void *request);
+    /* Validate and process the response. Set next_request_code of the async context to continue
+     * with another request. */
+    libspdm_return_t (*process_response)(libspdm_context_t *spdm_context,
+                                         const uint32_t *session_id,
+                                         size_t response_size, void *response);
+    /* Undo the request before it is sent again after a BUSY response (LIBSPDM_STATUS_BUSY_PEER),
+     * after it failed, or when it is cancelled (LIBSPDM_STATUS_SEND_FAIL or
+     * LIBSPDM_STATUS_RECEIVE_FAIL). It may be NULL. */
+    void (*reset)(libspdm_context_t *spdm_context, const uint32_t *session_id,
+                  libspdm_return_t status);
+} libspdm_async_operation_t;
+
+static libspdm_return_t libspdm_async_build_get_version(libspdm_context_t *spdm_context,
+                                                        const uint32_t *session_id,
+                                                        size_t *request_size, void *request)
+{
+    libspdm_build_get_version_request(spdm_context, request_size, request);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t libspdm_async_process_version(libspdm_context_t *spdm_context,
+                                                      const uint32_t *session_id,
+                                                      size_t response_size, void *response)
+{
+    libspdm_return_t status;
+
+    status = libspdm_process_version_response(spdm_context, NULL, NULL,
+                                              spdm_context->last_spdm_request,
+                                              spdm_context->last_spdm_request_size,
+                                              response, response_size);
+    if (LIBSPDM_STATUS_IS_SUCCESS(status) &&
+        !spdm_context->async_context.param.init_connection.get_version_only) {
+        spdm_context->async_context.next_request_code = SPDM_GET_CAPABILITIES;
+    }
+    return status;
+}
+
+static libspdm_return_t libspdm_async_build_get_capabilities(libspdm_context_t *spdm_context,
+                                                             const uint32_t *session_id,
+                                                             size_t *request_size, void *request)
+{
+    return libspdm_build_get_capabilities_request(spdm_context, false, request_size, request);
+}
+
+static libspdm_return_t libspdm_async_process_capabilities(libspdm_context_t *spdm_context,
+                                                           const uint32_t *session_id,
+                                                           size_t response_size, void *response)
+{
+    libspdm_return_t status;
+
+    status = libspdm_process_capabilities_response(spdm_context, NULL, NULL,
+                                                   spdm_context->last_spdm_request,
+                                                   spdm_context->last_spdm_request_size,
+                                                   response, response_size);
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        spdm_context->async_context.next_request_code = SPDM_NEGOTIATE_ALGORITHMS;
+    }
+    return status;
+}
+
+static libspdm_return_t libspdm_async_build_negotiate_algorithms(
+    libspdm_context_t *spdm_context, const uint32_t *session_id,
+    size_t *request_size, void *request)
+{
+    return libspdm_build_negotiate_algorithms_request(spdm_context, request_size, request);
+}
+
+static libspdm_return_t libspdm_async_process_algorithms(libspdm_context_t *spdm_context,
+                                                         const uint32_t *session_id,
+                                                         size_t response_size, void *response)
+{
+    return libspdm_process_algorithms_response(spdm_context,
+                                               spdm_context->last_spdm_request,
+                                               spdm_context->last_spdm_request_size,
+                                               response, response_size);
+}
+
+#if LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+static libspdm_return_t libspdm_async_build_get_digest(libspdm_context_t *spdm_context,
+                                                       const uint32_t *session_id,
+                                                       size_t *request_size, void *request)
+{
+    return libspdm_build_get_digest_request(spdm_context, session_id, request_size, request);
+}
+
+static libspdm_return_t libspdm_async_process_digests(libspdm_context_t *spdm_context,
+                                                      const uint32_t *session_id,
+                                                      size_t response_size, void *response)
+{
+    libspdm_async_get_digest_param_t *param;
+
+    param = &spdm_context->async_context.param.get_digest;
+    return libspdm_process_digests_response(spdm_context, session_id,
+                                            param->slot_mask, param->total_digest_buffer,
+                                            spdm_context->last_spdm_request,
+                                            spdm_context->last_spdm_request_size,
+                                            response, response_size);
+}
+
+static libspdm_return_t libspdm_async_build_get_certificate(libspdm_context_t *spdm_context,
+                                                            const uint32_t *session_id,
+                                                            size_t *request_size, void *request)
+{
+    libspdm_async_get_certificate_param_t *param;
+    libspdm_return_t status;
+
+    param = &spdm_context->async_context.param.get_certificate;
+    if (!param->started) {
+        /* Chunked responses are not supported, so each portion must fit in one message. */
+        status = libspdm_start_get_certificate(spdm_context, session_id, param->slot_id,
+                                               param->length, *param->cert_chain_size, false,
+                                               true, &param->state);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            return status;
+        }
+        param->started = true;
+    }
+    libspdm_build_get_certificate_request(spdm_context, &param->state, request_size, request);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t libspdm_async_process_certificate(libspdm_context_t *spdm_context,
+                                                          const uint32_t *session_id,
+                                                          size_t response_size, void *response)
+{
+    libspdm_async_get_certificate_param_t *param;
+    libspdm_return_t status;
+
+    param = &spdm_context->async_context.param.get_certificate;
+    status = libspdm_process_certificate_response(spdm_context, session_id, &param->state,
+                                                  param->cert_chain, NULL,
+                                                  spdm_context->last_spdm_request,
+                                                  spdm_context->last_spdm_request_size,
+                                                  response, response_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    if (param->state.remainder_length != 0) {
+        spdm_context->async_context.next_request_code = SPDM_GET_CERTIFICATE;
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+
+    *param->cert_chain_size = param->state.cert_chain_size;
+    return libspdm_verify_certificate_chain(spdm_context, &param->state, param->cert_chain,
+                                            param->trust_anchor, param->trust_anchor_size);
+}
+
+static void libspdm_async_reset_get_certificate(libspdm_context_t *spdm_context,
+                                                const uint32_t *session_id,
+                                                libspdm_return_t status)
+{
+    /* Like the blocking request, start over from the first portion after a BUSY response. */
+    if (status == LIBSPDM_STATUS_BUSY_PEER) {
+        spdm_context->async_context.param.get_certificate.started = false;
+    }
+}
+#endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+static libspdm_return_t libspdm_async_build_challenge(libspdm_context_t *spdm_context,
+                                                      const uint32_t *session_id,
+                                                      size_t *request_size, void *request)
+{
+    libspdm_async_challenge_param_t *param;
+
+    param = &spdm_context->async_context.param.challenge;
+    return libspdm_build_challenge_request(spdm_context, param->slot_id,
+                                           param->requester_context,
+                                           param->measurement_hash_type,
+                                           param->requester_nonce_in, param->requester_nonce,
+                                           request_size, request);
+}
+
+static libspdm_return_t libspdm_async_process_challenge_auth(libspdm_context_t *spdm_context,
+                                                             const uint32_t *session_id,
+                                                             size_t response_size,
+                                                             void *response)
+{
+    libspdm_async_challenge_param_t *param;
+    libspdm_return_t status;
+
+    param = &spdm_context->async_context.param.challenge;
+    status = libspdm_process_challenge_auth_response(
+        spdm_context, param->slot_id, param->measurement_hash_type, param->measurement_hash,
+        param->slot_mask, param->responder_nonce, param->opaque_data, param->opaque_data_size,
+        spdm_context->last_spdm_request, spdm_context->last_spdm_request_size,
+        response, response_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+#if (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) && (LIBSPDM_ENABLE_CAPABILITY_ENCAP_CAP)
+    /* The encapsulated requests of basic mutual authentication are only run by the blocking
+     * libspdm_challenge functions. */
+    if ((((spdm_message_header_t *)response)->param1 &
+         SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_BASIC_MUT_AUTH_REQ) != 0) {
+        libspdm_reset_message_c(spdm_context);
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+#endif /* (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) && (LIBSPDM_ENABLE_CAPABILITY_ENCAP_CAP) */
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+static libspdm_return_t libspdm_async_build_get_measurement(libspdm_context_t *spdm_context,
+                                                            const uint32_t *session_id,
+                                                            size_t *request_size, void *request)
+{
+    libspdm_async_get_measurement_param_t *param;
+
+    param = &spdm_context->async_context.param.get_measurement;
+    return libspdm_build_get_measurement_request(
+        spdm_context, session_id, param->request_attribute, param->measurement_operation,
+        param->slot_id_param, param->requester_context, param->requester_nonce_in,
+        param->requester_nonce, request_size, request);
+}
+
+static libspdm_return_t libspdm_async_process_measurements(libspdm_context_t *spdm_context,
+                                                           const uint32_t *session_id,
+                                                           size_t response_size, void *response)
+{
+    libspdm_async_get_measurement_param_t *param;
+
+    param = &spdm_context->async_context.param.get_measurement;
+    return libspdm_process_measurements_response(
+        spdm_context, session_id, param->request_attribute, param->measurement_operation,
+        param->slot_id_param, param->content_changed, param->number_of_blocks,
+        param->measurement_record_length, param->measurement_record,
+        param->responder_nonce, param->opaque_data, param->opaque_data_size,
+        spdm_context->last_spdm_request, spdm_context->last_spdm_request_size,
+        response, response_size);
+}
+
+static void libspdm_async_reset_message_m(libspdm_context_t *spdm_context,
+                                          const uint32_t *session_id,
+                                          libspdm_return_t status)
+{
+    libspdm_session_info_t *session_info;
+
+    /* Like the blocking request, keep the transcript after ResponseNotReady. */
+    if (status == LIBSPDM_STATUS_NOT_READY_PEER) {
+        return;
+    }
+
+    session_info = NULL;
+    if (session_id != NULL) {
+        session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
+    }
+    libspdm_reset_message_m(spdm_context, session_info);
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+static libspdm_return_t libspdm_async_build_key_exchange(libspdm_context_t *spdm_context,
+                                                         const uint32_t *session_id,
+                                                         size_t *request_size, void *request)
+{
+    libspdm_async_start_session_param_t *param;
+
+    param = &spdm_context->async_context.param.start_session;
+    return libspdm_build_key_exchange_request(spdm_context, param->measurement_hash_type,
+                                              param->slot_id, param->session_policy,
+                                              NULL, NULL, NULL, 0, &param->state,
+                                              request_size, request);
+}
+
+static libspdm_return_t libspdm_async_process_key_exchange(libspdm_context_t *spdm_context,
+                                                           const uint32_t *session_id,
+                                                           size_t response_size, void *response)
+{
+    libspdm_async_context_t *async_context;
+    libspdm_async_start_session_param_t *param;
+    libspdm_session_info_t *session_info;
+    libspdm_return_t status;
+
+    async_context = &spdm_context->async_context;
+    param = &async_context->param.start_session;
+    status = libspdm_process_key_exchange_response(
+        spdm_context, param->measurement_hash_type, param->slot_id, param->session_policy,
+        param->session_id, param->heartbeat_period, &param->req_slot_id_param,
+        param->measurement_hash, NULL, NULL, NULL, &param->state,
+        spdm_context->last_spdm_request, spdm_context->last_spdm_request_size,
+        response, response_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, *param->session_id);
+    if (session_info == NULL) {
+        LIBSPDM_ASSERT(false);
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    }
+
+    /* The same checks as libspdm_start_session. */
+    switch (session_info->mut_auth_requested) {
+    case 0:
+        break;
+    case SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED:
+#if !(LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP)
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+#endif
+        break;
+    case SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED_WITH_ENCAP_REQUEST:
+    case SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED_WITH_GET_DIGESTS:
+#if (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) && (LIBSPDM_ENABLE_CAPABILITY_ENCAP_CAP)
+        /* The encapsulated requests before FINISH are only run by the blocking
+         * libspdm_start_session, so the session cannot be finished. */
+        libspdm_free_session_id(spdm_context, *param->session_id);
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+#else
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+#endif /* (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) && (LIBSPDM_ENABLE_CAPABILITY_ENCAP_CAP) */
+    default:
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+
+    if (param->req_slot_id_param == 0xF) {
+        param->req_slot_id_param = 0xFF;
+    }
+
+    /* FINISH is sent in the new session. */
+    async_context->session_id_valid = true;
+    async_context->session_id = *param->session_id;
+    async_context->next_request_code = SPDM_FINISH;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_async_reset_key_exchange(libspdm_context_t *spdm_context,
+                                             const uint32_t *session_id,
+                                             libspdm_return_t status)
+{
+    libspdm_free_key_exchange_state(spdm_context,
+                                    &spdm_context->async_context.param.start_session.state);
+}
+
+static libspdm_return_t libspdm_async_build_finish(libspdm_context_t *spdm_context,
+                                                   const uint32_t *session_id,
+                                                   size_t *request_size, void *request)
+{
+    libspdm_session_info_t *session_info;
+    libspdm_return_t status;
+
+    LIBSPDM_ASSERT(session_id != NULL);
+    status = libspdm_build_finish_request(
+        spdm_context, *session_id,
+        spdm_context->async_context.param.start_session.req_slot_id_param,
+        NULL, 0, request_size, request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
+    libspdm_reset_message_buffer_via_request_code(spdm_context, session_info, SPDM_FINISH);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t libspdm_async_process_finish(libspdm_context_t *spdm_context,
+                                                     const uint32_t *session_id,
+                                                     size_t response_size, void *response)
+{
+    return libspdm_process_finish_response(spdm_context, *session_id, NULL, NULL,
+                                           spdm_context->last_spdm_request,
+                                           spdm_context->last_spdm_request_size,
+                                           response, response_size);
+}
+
+static void libspdm_async_reset_finish(libspdm_context_t *spdm_context,
+                                       const uint32_t *session_id,
+                                       libspdm_return_t status)
+{
+    libspdm_session_info_t *session_info;
+
+    /* A DecryptError response already freed the session. */
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
+    if (session_info == NULL) {
+        return;
+    }
+
+    /* Like the blocking request, a failed FINISH ends the session. */
+    if (status == LIBSPDM_STATUS_BUSY_PEER) {
+        libspdm_reset_message_f(spdm_context, session_info);
+    } else {
+        libspdm_free_session_id(spdm_context, *session_id);
+    }
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+static const libspdm_async_operation_t m_libspdm_async_operation[] = {
+    { SPDM_GET_VERSION, SPDM_VERSION, false, true,
+      libspdm_async_build_get_version, libspdm_async_process_version, NULL },
+    { SPDM_GET_CAPABILITIES, SPDM_CAPABILITIES, false, true,
+      libspdm_async_build_get_capabilities, libspdm_async_process_capabilities, NULL },
+    { SPDM_NEGOTIATE_ALGORITHMS, SPDM_ALGORITHMS, false, true,
+      libspdm_async_build_negotiate_algorithms, libspdm_async_process_algorithms, NULL },
+#if LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+    { SPDM_GET_DIGESTS, SPDM_DIGESTS, true, false,
+      libspdm_async_build_get_digest, libspdm_async_process_digests, NULL },
+    { SPDM_GET_CERTIFICATE, SPDM_CERTIFICATE, true, false,
+      libspdm_async_build_get_certificate, libspdm_async_process_certificate,
+      libspdm_async_reset_get_certificate },
+#endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+    { SPDM_CHALLENGE, SPDM_CHALLENGE_AUTH, true, false,
+      libspdm_async_build_challenge, libspdm_async_process_challenge_auth, NULL },
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+    { SPDM_GET_MEASUREMENTS, SPDM_MEASUREMENTS, true, false,
+      libspdm_async_build_get_measurement, libspdm_async_process_measurements,
+      libspdm_async_reset_message_m },
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+    { SPDM_KEY_EXCHANGE, SPDM_KEY_EXCHANGE_RSP, true, false,
+      libspdm_async_build_key_exchange, libspdm_async_process_key_exchange,
+      libspdm_async_reset_key_exchange },
+    { SPDM_FINISH, SPDM_FINISH_RSP, true, false,
+      libspdm_async_build_finish, libspdm_async_process_finish, libspdm_async_reset_finish },
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+    /* Terminator. */
+    { 0, 0, false, false, NULL, NULL, NULL },
+};
+
+static const libspdm_async_operation_t *libspdm_async_get_operation(uint8_t request_code)
+{
+    size_t index;
+
+    for (index = 0; m_libspdm_async_operation[index].build_request != NULL; index++) {
+        if (m_libspdm_async_operation[index].request_code == request_code) {
+            return &m_libspdm_async_operation[index];
+        }
+    }
+    return NULL;
+}
+
+static const uint32_t *libspdm_async_get_session_id(const libspdm_async_context_t *async_context)
+{
+    return async_context->session_id_valid ? &async_context->session_id : NULL;
+}
+
+static bool libspdm_async_is_in_progress(const libspdm_async_context_t *async_context)
+{
+    return (async_context->state == LIBSPDM_ASYNC_STATE_NEED_SEND) ||
+           (async_context->state == LIBSPDM_ASYNC_STATE_NEED_RECEIVE);
+}
+
+/**
+ * End the request with a status. Like the blocking requests, a failure undoes the request.
+ **/
+static void libspdm_async_done(libspdm_context_t *spdm_context, libspdm_return_t status)
+{
+    libspdm_async_context_t *async_context;
+    const libspdm_async_operation_t *operation;
+
+    async_context = &spdm_context->async_context;
+    operation = libspdm_async_get_operation(async_context->request_code);
+    LIBSPDM_ASSERT(operation != NULL);
+
+    if ((status != LIBSPDM_STATUS_SUCCESS) && (operation->reset != NULL)) {
+        operation->reset(spdm_context, libspdm_async_get_session_id(async_context), status);
+    }
+
+    async_context->state = LIBSPDM_ASYNC_STATE_DONE;
+    async_context->status = status;
+    async_context->message = NULL;
+    async_context->message_size = 0;
+    async_context->timeout = 0;
+}
+
+/**
+ * Build the next request, the request of the operation or RESPOND_IF_READY, and encode it into
+ * the sender buffer. On success the state is LIBSPDM_ASYNC_STATE_NEED_SEND.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  delay         The time to wait before sending, in microseconds.
+ **/
+static libspdm_return_t libspdm_async_prepare_request(libspdm_context_t *spdm_context,
+                                                      uint64_t delay)
+{
+    libspdm_async_context_t *async_context;
+    const libspdm_async_operation_t *operation;
+    const uint32_t *session_id;
+    libspdm_return_t status;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+    void *request;
+    size_t request_size;
+
+    async_context = &spdm_context->async_context;
+    operation = libspdm_async_get_operation(async_context->request_code);
+    LIBSPDM_ASSERT(operation != NULL);
+    session_id = libspdm_async_get_session_id(async_context);
+    spdm_context->crypto_request = operation->crypto_request;
+
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    request = message + transport_header_size;
+    request_size = message_size - transport_header_size -
+                   spdm_context->local_context.capability.transport_tail_size;
+
+    if (async_context->respond_if_ready) {
+        #if LIBSPDM_RESPOND_IF_READY_SUPPORT
+        LIBSPDM_ASSERT (request_size >= sizeof(spdm_response_if_ready_request_t));
+        libspdm_build_respond_if_ready_request(spdm_context, request);
+        request_size = sizeof(spdm_response_if_ready_request_t);
+        #endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+    } else {
+        status = operation->build_request(spdm_context, session_id, &request_size, request);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            libspdm_release_sender_buffer (spdm_context);
+            return status;
+        }
+    }
+
+    status = libspdm_encode_spdm_request(spdm_context, session_id, request_size, request,
+                                         &async_context->message_size,
+                                         &async_context->message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+
+    async_context->state = LIBSPDM_ASYNC_STATE_NEED_SEND;
+    async_context->timeout = delay;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+libspdm_return_t libspdm_async_start(libspdm_context_t *spdm_context,
+                                     const uint32_t *session_id,
+                                     uint8_t request_code,
+                                     const void *param, size_t param_size)
+{
+    libspdm_async_context_t *async_context;
+    libspdm_return_t status;
+
+    async_context = &spdm_context->async_context;
+    if (libspdm_async_is_in_progress(async_context)) {
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    }
+    LIBSPDM_ASSERT(libspdm_async_get_operation(request_code) != NULL);
+
+    libspdm_zero_mem(async_context, sizeof(*async_context));
+    async_context->request_code = request_code;
+    async_context->retry = spdm_context->retry_times;
+    if (session_id != NULL) {
+        async_context->session_id_valid = true;
+        async_context->session_id = *session_id;
+    }
+    libspdm_copy_mem(&async_context->param, sizeof(async_context->param), param, param_size);
+
+    status = libspdm_async_prepare_request(spdm_context, 0);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        async_context->state = LIBSPDM_ASYNC_STATE_IDLE;
+        return status;
+    }
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+void libspdm_async_get_event(void *spdm_context, libspdm_async_event_t *event)
+{
+    libspdm_context_t *context;
+    libspdm_async_context_t *async_context;
+
+    context = spdm_context;
+    async_context = &context->async_context;
+
+    event->state = (libspdm_async_state_t)async_context->state;
+    event->message = async_context->message;
+    event->message_size = async_context->message_size;
+    event->timeout = async_context->timeout;
+    event->status = async_context->status;
+}
+
+libspdm_return_t libspdm_async_message_sent(void *spdm_context)
+{
+    libspdm_context_t *context;
+    libspdm_async_context_t *async_context;
+
+    context = spdm_context;
+    async_context = &context->async_context;
+    if (async_context->state != LIBSPDM_ASYNC_STATE_NEED_SEND) {
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    }
+
+    libspdm_release_sender_buffer (context);
+    async_context->state = LIBSPDM_ASYNC_STATE_NEED_RECEIVE;
+    async_context->message = NULL;
+    async_context->message_size = 0;
+    async_context->timeout = libspdm_get_response_timeout(context);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+libspdm_return_t libspdm_async_receive_message(void *spdm_context, size_t message_size,
+                                               void *message)
+{
+    libspdm_context_t *context;
+    libspdm_async_context_t *async_context;
+    const libspdm_async_operation_t *operation;
+    const uint32_t *session_id;
+    libspdm_return_t status;
+    spdm_message_header_t *spdm_response;
+    size_t spdm_response_size;
+    const spdm_message_header_t *spdm_request;
+
+    context = spdm_context;
+    async_context = &context->async_context;
+    if (async_context->state != LIBSPDM_ASYNC_STATE_NEED_RECEIVE) {
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    }
+    operation = libspdm_async_get_operation(async_context->request_code);
+    LIBSPDM_ASSERT(operation != NULL);
+    session_id = libspdm_async_get_session_id(async_context);
+
+    status = libspdm_decode_spdm_response(context, session_id, message_size, message,
+                                          &spdm_response_size, (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_async_done(context, status);
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+    if (spdm_response_size < sizeof(spdm_message_header_t)) {
+        libspdm_async_done(context, LIBSPDM_STATUS_INVALID_MSG_SIZE);
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+
+    if (async_context->respond_if_ready) {
+        /* The same checks as after a blocking RESPOND_IF_READY. */
+        spdm_request = context->last_spdm_request;
+        if (spdm_response->spdm_version != spdm_request->spdm_version) {
+            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        } else if (spdm_response->request_response_code == SPDM_ERROR) {
+            status = libspdm_handle_simple_error_response(context, spdm_response->param1);
+        } else if (spdm_response->request_response_code != operation->response_code) {
+            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        }
+    } else if ((spdm_response->request_response_code == SPDM_ERROR) &&
+               !operation->process_error) {
+        if ((spdm_response->param1 == SPDM_ERROR_CODE_DECRYPT_ERROR) && (session_id != NULL)) {
+            libspdm_free_session_id(context, *session_id);
+            status = LIBSPDM_STATUS_SESSION_MSG_ERROR;
+        } else if (spdm_response->param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
+            #if LIBSPDM_RESPOND_IF_READY_SUPPORT
+            status = libspdm_check_response_not_ready(context, spdm_response_size, spdm_response,
+                                                      operation->request_code);
+            if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+                async_context->respond_if_ready = true;
+                status = libspdm_async_prepare_request(
+                    context, (uint64_t)1 << context->error_data.rd_exponent);
+                if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+                    return LIBSPDM_STATUS_SUCCESS;
+                }
+            }
+            #else
+            status = LIBSPDM_STATUS_NOT_READY_PEER;
+            #endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+        } else {
+            status = libspdm_handle_simple_error_response(context, spdm_response->param1);
+        }
+    }
+
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        async_context->next_request_code = 0;
+        status = operation->process_response(context, session_id,
+                                             spdm_response_size, spdm_response);
+    }
+
+    if ((status == LIBSPDM_STATUS_BUSY_PEER) && (async_context->retry != 0)) {
+        /* Like the blocking requests, send the request again after retry_delay_time. */
+        async_context->retry--;
+        async_context->respond_if_ready = false;
+        if (operation->reset != NULL) {
+            operation->reset(context, session_id, status);
+        }
+        status = libspdm_async_prepare_request(context, context->retry_delay_time);
+        if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+            return LIBSPDM_STATUS_SUCCESS;
+        }
+    }
+
+    if (LIBSPDM_STATUS_IS_SUCCESS(status) && (async_context->next_request_code != 0)) {
+        /* Continue with the next request of the flow. Like the blocking functions, each request
+         * has its own BUSY retries, while the portions of a certificate chain share them. */
+        if (async_context->next_request_code != async_context->request_code) {
+            async_context->request_code = async_context->next_request_code;
+            async_context->retry = context->retry_times;
+        }
+        async_context->respond_if_ready = false;
+        status = libspdm_async_prepare_request(context, 0);
+        if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+            return LIBSPDM_STATUS_SUCCESS;
+        }
+    }
+
+    libspdm_async_done(context, status);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+void libspdm_async_cancel(void *spdm_context)
+{
+    libspdm_context_t *context;
+    libspdm_async_context_t *async_context;
+    const libspdm_async_operation_t *operation;
+
+    context = spdm_context;
+    async_context = &context->async_context;
+    if (async_context->state == LIBSPDM_ASYNC_STATE_NEED_SEND) {
+        libspdm_release_sender_buffer (context);
+    }
+    if (libspdm_async_is_in_progress(async_context)) {
+        operation = libspdm_async_get_operation(async_context->request_code);
+        LIBSPDM_ASSERT(operation != NULL);
+        if (operation->reset != NULL) {
+            operation->reset(context, libspdm_async_get_session_id(async_context),
+                             (async_context->state == LIBSPDM_ASYNC_STATE_NEED_SEND) ?
+                             LIBSPDM_STATUS_SEND_FAIL : LIBSPDM_STATUS_RECEIVE_FAIL);
+        }
+    }
+    libspdm_zero_mem(async_context, sizeof(*async_context));
+}
+
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
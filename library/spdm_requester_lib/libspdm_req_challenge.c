@@ -21,57 +21,15 @@ typedef struct {
 } libspdm_challenge_auth_response_max_t;
 #pragma pack()
 
-/**
- * This function sends CHALLENGE to authenticate the device based upon the key in one slot.
- *
- * This function verifies the signature in the challenge auth.
- *
- * If basic mutual authentication is requested from the responder,
- * this function also perform the basic mutual authentication.
- *
- * @param  spdm_context           A pointer to the SPDM context.
- * @param  slot_id                The number of slot for the challenge.
- * @param  requester_context      If not NULL, a buffer to hold the requester context (8 bytes).
- *                                It is used only if the negotiated version >= 1.3.
- * @param  measurement_hash_type  The type of the measurement hash.
- * @param  measurement_hash       A pointer to a destination buffer to store the measurement hash.
- * @param  slot_mask              A pointer to a destination to store the slot mask.
- * @param  requester_nonce_in     If not NULL, a buffer that holds the requester nonce (32 bytes)
- * @param  requester_nonce        If not NULL, a buffer to hold the requester nonce (32 bytes).
- * @param  responder_nonce        If not NULL, a buffer to hold the responder nonce (32 bytes).
- **/
-static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
-                                              uint8_t slot_id,
-                                              const void *requester_context,
-                                              uint8_t measurement_hash_type,
-                                              void *measurement_hash,
-                                              uint8_t *slot_mask,
-                                              const void *requester_nonce_in,
-                                              void *requester_nonce,
-                                              void *responder_nonce,
-                                              void *opaque_data,
-                                              size_t *opaque_data_size)
+libspdm_return_t libspdm_build_challenge_request(libspdm_context_t *spdm_context,
+                                                 uint8_t slot_id,
+                                                 const void *requester_context,
+                                                 uint8_t measurement_hash_type,
+                                                 const void *requester_nonce_in,
+                                                 void *requester_nonce,
+                                                 size_t *spdm_request_size,
+                                                 spdm_challenge_request_t *spdm_request)
 {
-    libspdm_return_t status;
-    bool result;
-    spdm_challenge_request_t *spdm_request;
-    size_t spdm_request_size;
-    libspdm_challenge_auth_response_max_t *spdm_response;
-    size_t spdm_response_size;
-    uint8_t *ptr;
-    void *cert_chain_hash;
-    size_t hash_size;
-    uint32_t measurement_summary_hash_size;
-    void *nonce;
-    void *measurement_summary_hash;
-    uint16_t opaque_length;
-    void *signature;
-    size_t signature_size;
-    uint8_t auth_attribute;
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
-
     /* -=[Check Parameters Phase]=- */
     LIBSPDM_ASSERT((slot_id < SPDM_MAX_SLOT_COUNT) || (slot_id == 0xff));
     LIBSPDM_ASSERT((slot_id != 0xff) ||
@@ -93,32 +51,20 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
     libspdm_reset_message_buffer_via_request_code(spdm_context, NULL, SPDM_CHALLENGE);
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_challenge_request_t));
+    LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_challenge_request_t));
     spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
     spdm_request->header.request_response_code = SPDM_CHALLENGE;
     spdm_request->header.param1 = slot_id;
     spdm_request->header.param2 = measurement_hash_type;
     if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_13) {
-        LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_challenge_request_t) +
+        LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_challenge_request_t) +
                         SPDM_REQ_CONTEXT_SIZE);
-        spdm_request_size = sizeof(spdm_challenge_request_t) + SPDM_REQ_CONTEXT_SIZE;
+        *spdm_request_size = sizeof(spdm_challenge_request_t) + SPDM_REQ_CONTEXT_SIZE;
     } else {
-        spdm_request_size = sizeof(spdm_challenge_request_t);
+        *spdm_request_size = sizeof(spdm_challenge_request_t);
     }
     if (requester_nonce_in == NULL) {
         if (!libspdm_get_random_number(SPDM_NONCE_SIZE, spdm_request->nonce)) {
-            libspdm_release_sender_buffer (spdm_context);
             return LIBSPDM_STATUS_LOW_ENTROPY;
         }
     } else {
@@ -143,72 +89,56 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
     }
 
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        return status;
-    }
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
+libspdm_return_t libspdm_process_challenge_auth_response(
+    libspdm_context_t *spdm_context, uint8_t slot_id, uint8_t measurement_hash_type,
+    void *measurement_hash, uint8_t *slot_mask, void *responder_nonce,
+    void *opaque_data, size_t *opaque_data_size,
+    const spdm_challenge_request_t *spdm_request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size)
+{
+    libspdm_return_t status;
+    bool result;
+    libspdm_challenge_auth_response_max_t *spdm_response;
+    uint8_t *ptr;
+    void *cert_chain_hash;
+    size_t hash_size;
+    uint32_t measurement_summary_hash_size;
+    void *nonce;
+    void *measurement_summary_hash;
+    uint16_t opaque_length;
+    void *signature;
+    size_t signature_size;
+    uint8_t auth_attribute;
 
-    status = libspdm_receive_spdm_response(
-        spdm_context, NULL, &spdm_response_size, (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
-    }
+    spdm_response = response;
 
     /* -=[Validate Response Phase]=- */
-    if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
-    }
-    if (spdm_response->header.request_response_code == SPDM_ERROR) {
-        status = libspdm_handle_error_response_main(
-            spdm_context, NULL,
-            &spdm_response_size,
-            (void **)&spdm_response, SPDM_CHALLENGE, SPDM_CHALLENGE_AUTH);
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
-        }
-    } else if (spdm_response->header.request_response_code != SPDM_CHALLENGE_AUTH) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+    if (spdm_response->header.request_response_code != SPDM_CHALLENGE_AUTH) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size < sizeof(spdm_challenge_auth_response_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     auth_attribute = spdm_response->header.param1;
     if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_11 && slot_id == 0xFF) {
         if ((auth_attribute & SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_SLOT_ID_MASK) != 0xF) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     } else {
         if ((spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_11 &&
              (auth_attribute & SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_SLOT_ID_MASK) != slot_id) ||
             (spdm_response->header.spdm_version == SPDM_MESSAGE_VERSION_10 &&
              auth_attribute != slot_id)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         if ((spdm_response->header.param2 & (1 << slot_id)) == 0) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
     if ((auth_attribute & SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_BASIC_MUT_AUTH_REQ) != 0) {
@@ -216,8 +146,7 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
                 spdm_context, true,
                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP,
                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
 
@@ -235,8 +164,7 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
 
     if (spdm_response_size <= sizeof(spdm_challenge_auth_response_t) +
         hash_size + SPDM_NONCE_SIZE + measurement_summary_hash_size + sizeof(uint16_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
 
     ptr = spdm_response->cert_chain_hash;
@@ -253,8 +181,7 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
                                                        hash_size);
     }
     if (!result) {
-        status = LIBSPDM_STATUS_VERIF_FAIL;
-        goto receive_done;
+        return LIBSPDM_STATUS_VERIF_FAIL;
     }
 
     nonce = ptr;
@@ -275,24 +202,21 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
 
     opaque_length = libspdm_read_uint16((const uint8_t *)ptr);
     if (opaque_length > SPDM_MAX_OPAQUE_DATA_SIZE) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
         if (((spdm_context->connection_info.algorithm.other_params_support &
               SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_MASK) ==
              SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_NONE) &&
             (opaque_length != 0)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
     ptr += sizeof(uint16_t);
     if (opaque_length != 0) {
         result = libspdm_process_general_opaque_data_check(spdm_context, opaque_length, ptr);
         if (!result) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
 
@@ -302,8 +226,7 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
             SPDM_NONCE_SIZE + measurement_summary_hash_size +
             sizeof(uint16_t) + opaque_length + SPDM_REQ_CONTEXT_SIZE +
             signature_size) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         spdm_response_size = sizeof(spdm_challenge_auth_response_t) +
                              hash_size + SPDM_NONCE_SIZE +
@@ -314,8 +237,7 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
             sizeof(spdm_challenge_auth_response_t) + hash_size +
             SPDM_NONCE_SIZE + measurement_summary_hash_size +
             sizeof(uint16_t) + opaque_length + signature_size) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         spdm_response_size = sizeof(spdm_challenge_auth_response_t) +
                              hash_size + SPDM_NONCE_SIZE +
@@ -325,8 +247,7 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
 
     if ((opaque_data != NULL) && (opaque_data_size != NULL)) {
         if (opaque_length >= *opaque_data_size) {
-            status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            goto receive_done;
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
         libspdm_copy_mem(opaque_data, *opaque_data_size, ptr, opaque_length);
         *opaque_data_size = opaque_length;
@@ -339,21 +260,20 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
         if (!libspdm_consttime_is_mem_equal(spdm_request + 1, ptr, SPDM_REQ_CONTEXT_SIZE)) {
             libspdm_reset_message_c(spdm_context);
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         ptr += SPDM_REQ_CONTEXT_SIZE;
     }
 
     status = libspdm_append_message_c(spdm_context, spdm_request, spdm_request_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+        return status;
     }
     status = libspdm_append_message_c(spdm_context, spdm_response,
                                       spdm_response_size - signature_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         libspdm_reset_message_c(spdm_context);
-        goto receive_done;
+        return status;
     }
 
     signature = ptr;
@@ -363,8 +283,7 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
                                                      signature, signature_size);
     if (!result) {
         libspdm_reset_message_c(spdm_context);
-        status = LIBSPDM_STATUS_VERIF_FAIL;
-        goto receive_done;
+        return LIBSPDM_STATUS_VERIF_FAIL;
     }
 
     if (measurement_hash != NULL) {
@@ -379,9 +298,124 @@ static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
      * the Responder intends to authenticate the Requester. */
     spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
 
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * This function sends CHALLENGE to authenticate the device based upon the key in one slot.
+ *
+ * This function verifies the signature in the challenge auth.
+ *
+ * If basic mutual authentication is requested from the responder,
+ * this function also perform the basic mutual authentication.
+ *
+ * @param  spdm_context           A pointer to the SPDM context.
+ * @param  slot_id                The number of slot for the challenge.
+ * @param  requester_context      If not NULL, a buffer to hold the requester context (8 bytes).
+ *                                It is used only if the negotiated version >= 1.3.
+ * @param  measurement_hash_type  The type of the measurement hash.
+ * @param  measurement_hash       A pointer to a destination buffer to store the measurement hash.
+ * @param  slot_mask              A pointer to a destination to store the slot mask.
+ * @param  requester_nonce_in     If not NULL, a buffer that holds the requester nonce (32 bytes)
+ * @param  requester_nonce        If not NULL, a buffer to hold the requester nonce (32 bytes).
+ * @param  responder_nonce        If not NULL, a buffer to hold the responder nonce (32 bytes).
+ **/
+static libspdm_return_t libspdm_try_challenge(libspdm_context_t *spdm_context,
+                                              uint8_t slot_id,
+                                              const void *requester_context,
+                                              uint8_t measurement_hash_type,
+                                              void *measurement_hash,
+                                              uint8_t *slot_mask,
+                                              const void *requester_nonce_in,
+                                              void *requester_nonce,
+                                              void *responder_nonce,
+                                              void *opaque_data,
+                                              size_t *opaque_data_size)
+{
+    libspdm_return_t status;
+    spdm_challenge_request_t *spdm_request;
+    size_t spdm_request_size;
+    libspdm_challenge_auth_response_max_t *spdm_response;
+    size_t spdm_response_size;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    status = libspdm_build_challenge_request(spdm_context, slot_id, requester_context,
+                                             measurement_hash_type, requester_nonce_in,
+                                             requester_nonce, &spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(
+        spdm_context, NULL, &spdm_response_size, (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    /* -=[Validate Response Phase]=- */
+    if (spdm_response_size < sizeof(spdm_message_header_t)) {
+        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
+        goto receive_done;
+    }
+    if (spdm_response->header.request_response_code == SPDM_ERROR) {
+        status = libspdm_handle_error_response_main(
+            spdm_context, NULL,
+            &spdm_response_size,
+            (void **)&spdm_response, SPDM_CHALLENGE, SPDM_CHALLENGE_AUTH);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            goto receive_done;
+        }
+    } else if (spdm_response->header.request_response_code != SPDM_CHALLENGE_AUTH) {
+        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        goto receive_done;
+    }
+
+    status = libspdm_process_challenge_auth_response(spdm_context, slot_id, measurement_hash_type,
+                                                     measurement_hash, slot_mask, responder_nonce,
+                                                     opaque_data, opaque_data_size,
+                                                     spdm_request, spdm_request_size,
+                                                     spdm_response, spdm_response_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
     /* -=[Update State Phase]=- */
 #if (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) && (LIBSPDM_ENABLE_CAPABILITY_ENCAP_CAP)
-    if ((auth_attribute & SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_BASIC_MUT_AUTH_REQ) != 0) {
+    if ((spdm_response->header.param1 &
+         SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_BASIC_MUT_AUTH_REQ) != 0) {
         /* we must release it here, because libspdm_encapsulated_request() will acquire again. */
         libspdm_release_receiver_buffer (spdm_context);
 
@@ -513,4 +547,33 @@ libspdm_return_t libspdm_challenge_ex2(void *spdm_context, void *reserved,
     return status;
 }
 
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+libspdm_return_t libspdm_challenge_async(void *spdm_context,
+                                         uint8_t slot_id,
+                                         const void *requester_context,
+                                         uint8_t measurement_hash_type,
+                                         void *measurement_hash,
+                                         uint8_t *slot_mask,
+                                         const void *requester_nonce_in,
+                                         void *requester_nonce,
+                                         void *responder_nonce,
+                                         void *opaque_data,
+                                         size_t *opaque_data_size)
+{
+    libspdm_async_challenge_param_t param;
+
+    param.slot_id = slot_id;
+    param.requester_context = requester_context;
+    param.measurement_hash_type = measurement_hash_type;
+    param.measurement_hash = measurement_hash;
+    param.slot_mask = slot_mask;
+    param.requester_nonce_in = requester_nonce_in;
+    param.requester_nonce = requester_nonce;
+    param.responder_nonce = responder_nonce;
+    param.opaque_data = opaque_data;
+    param.opaque_data_size = opaque_data_size;
+    return libspdm_async_start(spdm_context, NULL, SPDM_CHALLENGE, &param, sizeof(param));
+}
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
 #endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
@@ -29,7 +29,7 @@ uint16_t libspdm_allocate_req_session_id(libspdm_context_t *spdm_context, bool u
     }
 
     session_info = spdm_context->session_info;
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
+    for (index = 0; index < spdm_context->max_session_count; index++) {
         if ((session_info[index].session_id & 0xFFFF) == (INVALID_SESSION_ID & 0xFFFF)) {
             req_session_id = (uint16_t)(0xFFFF - index);
             return req_session_id;
@@ -31,6 +31,16 @@ libspdm_return_t libspdm_init_connection(void *spdm_context, bool get_version_on
     return LIBSPDM_STATUS_SUCCESS;
 }
 
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+libspdm_return_t libspdm_init_connection_async(void *spdm_context, bool get_version_only)
+{
+    libspdm_async_init_connection_param_t param;
+
+    param.get_version_only = get_version_only;
+    return libspdm_async_start(spdm_context, NULL, SPDM_GET_VERSION, &param, sizeof(param));
+}
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
 libspdm_return_t libspdm_get_supported_algorithms(void *spdm_context,
                                                   size_t *responder_supported_algorithms_length,
                                                   void *responder_supported_algorithms_buffer,
@@ -340,14 +350,49 @@ libspdm_return_t libspdm_start_session_ex(void *spdm_context, bool use_psk,
     return status;
 }
 
+#if (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) && (LIBSPDM_ASYNC_REQUESTER_SUPPORT)
+libspdm_return_t libspdm_start_session_async(void *spdm_context,
+                                             uint8_t measurement_hash_type,
+                                             uint8_t slot_id,
+                                             uint8_t session_policy,
+                                             uint32_t *session_id,
+                                             uint8_t *heartbeat_period,
+                                             void *measurement_hash)
+{
+    libspdm_async_start_session_param_t param;
+
+    libspdm_zero_mem(&param, sizeof(param));
+    param.measurement_hash_type = measurement_hash_type;
+    param.slot_id = slot_id;
+    param.session_policy = session_policy;
+    param.session_id = session_id;
+    param.heartbeat_period = heartbeat_period;
+    param.measurement_hash = measurement_hash;
+    return libspdm_async_start(spdm_context, NULL, SPDM_KEY_EXCHANGE, &param, sizeof(param));
+}
+#endif /* (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) && (LIBSPDM_ASYNC_REQUESTER_SUPPORT) */
+
 libspdm_return_t libspdm_stop_session(void *spdm_context, uint32_t session_id,
                                       uint8_t end_session_attributes)
 {
     libspdm_return_t status;
     libspdm_context_t *context;
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+    libspdm_session_info_t *session_info;
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
 
     context = spdm_context;
 
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+    /* The session already ended during a concurrent APP message exchange, so it is only freed. */
+    session_info = libspdm_get_session_info_via_session_id(context, session_id);
+    if ((session_info != NULL) && session_info->free_pending) {
+        libspdm_free_session_id(context, session_id);
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_stop_session - freed ended session\n"));
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
+
     status = libspdm_send_receive_end_session(context, session_id, end_session_attributes);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_stop_session - %xu\n", status));
 
@@ -450,6 +495,14 @@ libspdm_return_t libspdm_send_receive_data(void *spdm_context, const uint32_t *s
 {
     libspdm_return_t status;
 
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+    if (is_app_message && (session_id != NULL)) {
+        return libspdm_send_receive_session_app_data(spdm_context, *session_id,
+                                                     request, request_size,
+                                                     response, response_size);
+    }
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
+
     if (!is_app_message) {
         return libspdm_send_receive_spdm_data(spdm_context, session_id,
                                               request, request_size,
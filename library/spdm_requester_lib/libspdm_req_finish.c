@@ -341,40 +341,27 @@ bool libspdm_generate_finish_req_signature(libspdm_context_t *spdm_context,
 }
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP */
 
-/**
- * This function sends FINISH and receives FINISH_RSP for SPDM finish.
- *
- * @param  spdm_context       A pointer to the SPDM context.
- * @param  session_id         session_id to the FINISH request.
- * @param  req_slot_id_param  req_slot_id_param to the FINISH request.
- **/
-static libspdm_return_t libspdm_try_send_receive_finish(
-    libspdm_context_t *spdm_context,
-    uint32_t session_id,
-    uint8_t req_slot_id_param,
-    const void *requester_opaque_data,
-    size_t requester_opaque_data_size,
-    void *responder_opaque_data,
-    size_t *responder_opaque_data_size)
+libspdm_return_t libspdm_build_finish_request(libspdm_context_t *spdm_context,
+                                              uint32_t session_id,
+                                              uint8_t req_slot_id_param,
+                                              const void *requester_opaque_data,
+                                              size_t requester_opaque_data_size,
+                                              size_t *spdm_request_size,
+                                              void *request)
 {
     libspdm_return_t status;
     libspdm_finish_request_mine_t *spdm_request;
-    size_t spdm_request_size;
     size_t signature_size;
     size_t hmac_size;
-    libspdm_finish_response_mine_t *spdm_response;
-    size_t spdm_response_size;
     libspdm_session_info_t *session_info;
     uint8_t *ptr;
     bool result;
-    uint8_t th2_hash_data[LIBSPDM_MAX_HASH_SIZE];
     libspdm_session_state_t session_state;
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
     size_t opaque_data_entry_size;
     size_t opaque_data_size;
 
+    spdm_request = request;
+
     /* -=[Check Parameters Phase]=- */
     if (libspdm_get_connection_version(spdm_context) < SPDM_MESSAGE_VERSION_11) {
         return LIBSPDM_STATUS_UNSUPPORTED_CAP;
@@ -382,8 +369,7 @@ static libspdm_return_t libspdm_try_send_receive_finish(
 
     session_info = libspdm_get_session_info_via_session_id(spdm_context, session_id);
     if (session_info == NULL) {
-        status = LIBSPDM_STATUS_INVALID_PARAMETER;
-        goto error;
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
     }
 
     /* -=[Verify State Phase]=- */
@@ -391,46 +377,30 @@ static libspdm_return_t libspdm_try_send_receive_finish(
             spdm_context, true,
             SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP,
             SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP)) {
-        status = LIBSPDM_STATUS_UNSUPPORTED_CAP;
-        goto error;
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
     }
 
     if (spdm_context->connection_info.connection_state < LIBSPDM_CONNECTION_STATE_NEGOTIATED) {
-        status = LIBSPDM_STATUS_INVALID_STATE_LOCAL;
-        goto error;
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
     }
 
     session_state = libspdm_secured_message_get_session_state(
         session_info->secured_message_context);
     if (session_state != LIBSPDM_SESSION_STATE_HANDSHAKING) {
-        status = LIBSPDM_STATUS_INVALID_STATE_LOCAL;
-        goto error;
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
     }
     if (session_info->mut_auth_requested != 0) {
         if ((req_slot_id_param >= SPDM_MAX_SLOT_COUNT) && (req_slot_id_param != 0xFF)) {
-            status = LIBSPDM_STATUS_INVALID_PARAMETER;
-            goto error;
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
         }
     } else {
         if (req_slot_id_param != 0) {
-            status = LIBSPDM_STATUS_INVALID_PARAMETER;
-            goto error;
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
         }
     }
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto error;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT(spdm_request_size >= sizeof(spdm_request->header));
+    LIBSPDM_ASSERT(*spdm_request_size >= sizeof(spdm_request->header));
     spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
     spdm_request->header.request_response_code = SPDM_FINISH;
     spdm_request->header.param1 = 0;
@@ -440,20 +410,20 @@ static libspdm_return_t libspdm_try_send_receive_finish(
     if (libspdm_get_connection_version(spdm_context) >= SPDM_MESSAGE_VERSION_14) {
         if (requester_opaque_data != NULL) {
             LIBSPDM_ASSERT(requester_opaque_data_size <= SPDM_MAX_OPAQUE_DATA_SIZE);
-            LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_finish_request_t) +
+            LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_finish_request_t) +
                             sizeof(uint16_t) + requester_opaque_data_size);
 
             libspdm_write_uint16(ptr, (uint16_t)requester_opaque_data_size);
             ptr += sizeof(uint16_t);
 
             libspdm_copy_mem(ptr,
-                             (spdm_request_size - (sizeof(spdm_finish_request_t) +
-                                                   sizeof(uint16_t))),
+                             (*spdm_request_size - (sizeof(spdm_finish_request_t) +
+                                                    sizeof(uint16_t))),
                              requester_opaque_data, requester_opaque_data_size);
             opaque_data_size = requester_opaque_data_size;
         } else {
             opaque_data_size = 0;
-            LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_finish_request_t) +
+            LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_finish_request_t) +
                             sizeof(uint16_t) + opaque_data_size);
 
             libspdm_write_uint16(ptr, (uint16_t)opaque_data_size);
@@ -483,30 +453,26 @@ static libspdm_return_t libspdm_try_send_receive_finish(
     session_info->local_used_cert_chain_slot_id = req_slot_id_param;
 
     hmac_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
-    LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_finish_request_t) + opaque_data_entry_size +
+    LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_finish_request_t) + opaque_data_entry_size +
                     signature_size + hmac_size);
-    spdm_request_size = sizeof(spdm_finish_request_t) + opaque_data_entry_size +
-                        signature_size + hmac_size;
+    *spdm_request_size = sizeof(spdm_finish_request_t) + opaque_data_entry_size +
+                         signature_size + hmac_size;
 
     status = libspdm_append_message_f(spdm_context, session_info, true, (uint8_t *)spdm_request,
-                                      spdm_request_size - signature_size - hmac_size);
+                                      *spdm_request_size - signature_size - hmac_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        goto error;
+        return status;
     }
 #if LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP
     if (session_info->mut_auth_requested != 0) {
         result = libspdm_generate_finish_req_signature(
             spdm_context, session_info, req_slot_id_param, ptr);
         if (!result) {
-            libspdm_release_sender_buffer (spdm_context);
-            status = LIBSPDM_STATUS_CRYPTO_ERROR;
-            goto error;
+            return LIBSPDM_STATUS_CRYPTO_ERROR;
         }
         status = libspdm_append_message_f(spdm_context, session_info, true, ptr, signature_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            libspdm_release_sender_buffer (spdm_context);
-            goto error;
+            return status;
         }
         ptr += signature_size;
     }
@@ -514,71 +480,56 @@ static libspdm_return_t libspdm_try_send_receive_finish(
 
     result = libspdm_generate_finish_req_hmac(spdm_context, session_info, ptr);
     if (!result) {
-        libspdm_release_sender_buffer (spdm_context);
-        status = LIBSPDM_STATUS_CRYPTO_ERROR;
-        goto error;
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
     }
 
     status = libspdm_append_message_f(spdm_context, session_info, true, ptr, hmac_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        goto error;
+        return status;
     }
 
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, &session_id, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        goto error;
-    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-    libspdm_reset_message_buffer_via_request_code(spdm_context, session_info, SPDM_FINISH);
+libspdm_return_t libspdm_process_finish_response(libspdm_context_t *spdm_context,
+                                                 uint32_t session_id,
+                                                 void *responder_opaque_data,
+                                                 size_t *responder_opaque_data_size,
+                                                 const void *request,
+                                                 size_t spdm_request_size,
+                                                 void *response,
+                                                 size_t spdm_response_size)
+{
+    libspdm_return_t status;
+    const libspdm_finish_request_mine_t *spdm_request;
+    libspdm_finish_response_mine_t *spdm_response;
+    libspdm_session_info_t *session_info;
+    size_t hmac_size;
+    uint8_t *ptr;
+    bool result;
+    uint8_t th2_hash_data[LIBSPDM_MAX_HASH_SIZE];
+    size_t opaque_data_entry_size;
+    size_t opaque_data_size;
 
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
+    spdm_request = request;
+    spdm_response = response;
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto error;
+    if (spdm_response_size < sizeof(spdm_message_header_t)) {
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
-
-    status = libspdm_receive_spdm_response(
-        spdm_context, &session_id, &spdm_response_size, (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+    if (spdm_response->header.request_response_code != SPDM_FINISH_RSP) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
 
-    /* -=[Validate Response Phase]=- */
-    if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
-    }
-    if (spdm_response->header.request_response_code == SPDM_ERROR) {
-        if (spdm_response->header.param1 == SPDM_ERROR_CODE_DECRYPT_ERROR) {
-            status = LIBSPDM_STATUS_SESSION_MSG_ERROR;
-            goto receive_done;
-        }
-        if (spdm_response->header.param1 != SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
-            libspdm_reset_message_f (spdm_context, session_info);
-        }
-        status = libspdm_handle_error_response_main(
-            spdm_context, &session_id,
-            &spdm_response_size, (void **)&spdm_response,
-            SPDM_FINISH, SPDM_FINISH_RSP);
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
-        }
-    } else if (spdm_response->header.request_response_code != SPDM_FINISH_RSP) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, session_id);
+    if (session_info == NULL) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
     }
+
+    hmac_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+
     if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
 
     if (!libspdm_is_capabilities_flag_supported(
@@ -592,25 +543,21 @@ static libspdm_return_t libspdm_try_send_receive_finish(
 
     if (libspdm_get_connection_version(spdm_context) >= SPDM_MESSAGE_VERSION_14) {
         if (spdm_response_size < sizeof(spdm_finish_response_t) + sizeof(uint16_t) + hmac_size) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         opaque_data_size = libspdm_read_uint16((const uint8_t *)ptr);
         ptr += sizeof(uint16_t);
         if (opaque_data_size > SPDM_MAX_OPAQUE_DATA_SIZE) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         if (spdm_response_size < sizeof(spdm_finish_response_t) + sizeof(uint16_t) +
             opaque_data_size + hmac_size) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
 
         if ((responder_opaque_data != NULL) && (responder_opaque_data_size != NULL)) {
             if (opaque_data_size >= *responder_opaque_data_size) {
-                status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-                goto receive_done;
+                return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
             }
             libspdm_copy_mem(responder_opaque_data, *responder_opaque_data_size,
                              ptr, opaque_data_size);
@@ -621,8 +568,7 @@ static libspdm_return_t libspdm_try_send_receive_finish(
         opaque_data_entry_size = sizeof(uint16_t) + opaque_data_size;
     } else {
         if (spdm_response_size < sizeof(spdm_finish_response_t) + hmac_size) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         if ((responder_opaque_data != NULL) && (responder_opaque_data_size != NULL)) {
             *responder_opaque_data_size = 0;
@@ -634,7 +580,7 @@ static libspdm_return_t libspdm_try_send_receive_finish(
     status = libspdm_append_message_f(spdm_context, session_info, true, spdm_response,
                                       spdm_response_size - hmac_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+        return status;
     }
 
     if (libspdm_is_capabilities_flag_supported(
@@ -646,15 +592,14 @@ static libspdm_return_t libspdm_try_send_receive_finish(
         result = libspdm_verify_finish_rsp_hmac(spdm_context, session_info,
                                                 ptr, hmac_size);
         if (!result) {
-            status = LIBSPDM_STATUS_VERIF_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_VERIF_FAIL;
         }
 
         status = libspdm_append_message_f(
             spdm_context, session_info, true,
             ptr, hmac_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
     }
 
@@ -662,14 +607,12 @@ static libspdm_return_t libspdm_try_send_receive_finish(
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_data_key[%x]\n", session_id));
     result = libspdm_calculate_th2_hash(spdm_context, session_info, true, th2_hash_data);
     if (!result) {
-        status = LIBSPDM_STATUS_CRYPTO_ERROR;
-        goto receive_done;
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
     }
     result = libspdm_generate_session_data_key(
         session_info->secured_message_context, th2_hash_data);
     if (!result) {
-        status = LIBSPDM_STATUS_CRYPTO_ERROR;
-        goto receive_done;
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
     }
 
     /* -=[Update State Phase]=- */
@@ -681,6 +624,119 @@ static libspdm_return_t libspdm_try_send_receive_finish(
     libspdm_append_msg_log(spdm_context, spdm_response, spdm_response_size);
     #endif /* LIBSPDM_ENABLE_MSG_LOG */
 
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * This function sends FINISH and receives FINISH_RSP for SPDM finish.
+ *
+ * @param  spdm_context       A pointer to the SPDM context.
+ * @param  session_id         session_id to the FINISH request.
+ * @param  req_slot_id_param  req_slot_id_param to the FINISH request.
+ **/
+static libspdm_return_t libspdm_try_send_receive_finish(
+    libspdm_context_t *spdm_context,
+    uint32_t session_id,
+    uint8_t req_slot_id_param,
+    const void *requester_opaque_data,
+    size_t requester_opaque_data_size,
+    void *responder_opaque_data,
+    size_t *responder_opaque_data_size)
+{
+    libspdm_return_t status;
+    libspdm_finish_request_mine_t *spdm_request;
+    size_t spdm_request_size;
+    libspdm_finish_response_mine_t *spdm_response;
+    size_t spdm_response_size;
+    libspdm_session_info_t *session_info;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+
+    /* -=[Check Parameters Phase]=- */
+    if (libspdm_get_connection_version(spdm_context) < SPDM_MESSAGE_VERSION_11) {
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto error;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    status = libspdm_build_finish_request(spdm_context, session_id, req_slot_id_param,
+                                          requester_opaque_data, requester_opaque_data_size,
+                                          &spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        goto error;
+    }
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, session_id);
+    LIBSPDM_ASSERT(session_info != NULL);
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, &session_id, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        goto error;
+    }
+
+    libspdm_reset_message_buffer_via_request_code(spdm_context, session_info, SPDM_FINISH);
+
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto error;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(
+        spdm_context, &session_id, &spdm_response_size, (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    /* -=[Validate Response Phase]=- */
+    if (spdm_response_size < sizeof(spdm_message_header_t)) {
+        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
+        goto receive_done;
+    }
+    if (spdm_response->header.request_response_code == SPDM_ERROR) {
+        if (spdm_response->header.param1 == SPDM_ERROR_CODE_DECRYPT_ERROR) {
+            status = LIBSPDM_STATUS_SESSION_MSG_ERROR;
+            goto receive_done;
+        }
+        if (spdm_response->header.param1 != SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
+            libspdm_reset_message_f (spdm_context, session_info);
+        }
+        status = libspdm_handle_error_response_main(
+            spdm_context, &session_id,
+            &spdm_response_size, (void **)&spdm_response,
+            SPDM_FINISH, SPDM_FINISH_RSP);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            goto receive_done;
+        }
+    }
+
+    status = libspdm_process_finish_response(spdm_context, session_id,
+                                             responder_opaque_data, responder_opaque_data_size,
+                                             spdm_request, spdm_request_size,
+                                             spdm_response, spdm_response_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
     libspdm_release_receiver_buffer (spdm_context);
 
     return LIBSPDM_STATUS_SUCCESS;
@@ -197,41 +197,10 @@ static bool validate_responder_capability(uint32_t capabilities_flag, uint8_t ve
     return true;
 }
 
-/**
- * This function sends GET_CAPABILITIES and receives CAPABILITIES.
- *
- * @param  spdm_context A pointer to the SPDM context.
- *
- * @retval LIBSPDM_STATUS_SUCCESS
- *         GET_CAPABILITIES was sent and CAPABILITIES was received.
- * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
- *         Cannot send GET_CAPABILITIES due to Requester's state. Send GET_VERSION first.
- * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
- *         The size of the CAPABILITIES response is invalid.
- * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
- *         The CAPABILITIES response contains one or more invalid fields.
- * @retval LIBSPDM_STATUS_ERROR_PEER
- *         The Responder returned an unexpected error.
- * @retval LIBSPDM_STATUS_BUSY_PEER
- *         The Responder continually returned Busy error messages.
- * @retval LIBSPDM_STATUS_RESYNCH_PEER
- *         The Responder returned a RequestResynch error message.
- * @retval LIBSPDM_STATUS_BUFFER_FULL
- *         The buffer used to store transcripts is exhausted.
- **/
-static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_context,
-                                                     size_t *supported_algs_length,
-                                                     void *supported_algs)
+libspdm_return_t libspdm_build_get_capabilities_request(
+    libspdm_context_t *spdm_context, bool supported_algs_requested,
+    size_t *spdm_request_size, spdm_get_capabilities_request_t *spdm_request)
 {
-    libspdm_return_t status;
-    spdm_get_capabilities_request_t *spdm_request;
-    size_t spdm_request_size;
-    spdm_capabilities_response_t *spdm_response;
-    size_t spdm_response_size;
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
-
     /* -=[Verify State Phase]=- */
     if (spdm_context->connection_info.connection_state != LIBSPDM_CONNECTION_STATE_AFTER_VERSION) {
         return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
@@ -239,33 +208,22 @@ static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_con
     libspdm_reset_message_buffer_via_request_code(spdm_context, NULL, SPDM_GET_CAPABILITIES);
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_request->header));
+    LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_request->header));
 
-    libspdm_zero_mem(spdm_request, spdm_request_size);
+    libspdm_zero_mem(spdm_request, *spdm_request_size);
     spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
     if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
-        LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_get_capabilities_request_t));
-        spdm_request_size = sizeof(spdm_get_capabilities_request_t);
+        LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_get_capabilities_request_t));
+        *spdm_request_size = sizeof(spdm_get_capabilities_request_t);
     } else if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_11) {
-        LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_get_capabilities_request_t) -
+        LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_get_capabilities_request_t) -
                         sizeof(spdm_request->data_transfer_size) -
                         sizeof(spdm_request->max_spdm_msg_size));
-        spdm_request_size = sizeof(spdm_get_capabilities_request_t) -
-                            sizeof(spdm_request->data_transfer_size) -
-                            sizeof(spdm_request->max_spdm_msg_size);
+        *spdm_request_size = sizeof(spdm_get_capabilities_request_t) -
+                             sizeof(spdm_request->data_transfer_size) -
+                             sizeof(spdm_request->max_spdm_msg_size);
     } else {
-        spdm_request_size = sizeof(spdm_request->header);
+        *spdm_request_size = sizeof(spdm_request->header);
     }
     spdm_request->header.request_response_code = SPDM_GET_CAPABILITIES;
     spdm_request->header.param1 = 0;
@@ -277,7 +235,7 @@ static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_con
                                           spdm_context->local_context.capability.flags);
     }
 
-    if (supported_algs != NULL) {
+    if (supported_algs_requested) {
         LIBSPDM_ASSERT((spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_13) &&
                        ((spdm_request->flags & SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHUNK_CAP) != 0));
 
@@ -298,59 +256,43 @@ static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_con
         spdm_request->ext_flags = 0;
     }
 
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        return status;
-    }
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
+libspdm_return_t libspdm_process_capabilities_response(
+    libspdm_context_t *spdm_context, size_t *supported_algs_length, void *supported_algs,
+    const spdm_get_capabilities_request_t *spdm_request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size)
+{
+    libspdm_return_t status;
+    spdm_capabilities_response_t *spdm_response;
 
-    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
-                                           (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
-    }
+    spdm_response = response;
 
     /* -=[Validate Response Phase]=- */
     if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     if (spdm_response->header.request_response_code == SPDM_ERROR) {
         status = libspdm_handle_simple_error_response(
             spdm_context, spdm_response->header.param1);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
     } else if (spdm_response->header.request_response_code != SPDM_CAPABILITIES) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
         if (spdm_response_size < sizeof(spdm_capabilities_response_t)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
     } else {
         if (spdm_response_size < sizeof(spdm_capabilities_response_t) -
             sizeof(spdm_response->data_transfer_size) - sizeof(spdm_response->max_spdm_msg_size)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
     }
 
@@ -371,37 +313,33 @@ static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_con
     }
 
     if (!validate_responder_capability(spdm_response->flags, spdm_response->header.spdm_version)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
         if ((spdm_response->data_transfer_size < SPDM_MIN_DATA_TRANSFER_SIZE_VERSION_12) ||
             (spdm_response->data_transfer_size > spdm_response->max_spdm_msg_size)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
 
         if (((spdm_response->flags & SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHUNK_CAP) == 0) &&
             (spdm_response->data_transfer_size != spdm_response->max_spdm_msg_size)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
 
     if (spdm_response->ct_exponent > LIBSPDM_MAX_CT_EXPONENT) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
 
     /* -=[Process Response Phase]=- */
     status = libspdm_append_message_a(spdm_context, spdm_request, spdm_request_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+        return status;
     }
 
     status = libspdm_append_message_a(spdm_context, spdm_response, spdm_response_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+        return status;
     }
 
     spdm_context->connection_info.capability.ct_exponent = spdm_response->ct_exponent;
@@ -443,8 +381,7 @@ static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_con
             *supported_algs_length = algorithm_data_size;
         } else {
             *supported_algs_length = algorithm_data_size;
-            status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            goto receive_done;
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
     } else if (supported_algs_length != NULL) {
         *supported_algs_length = 0;
@@ -452,13 +389,98 @@ static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_con
 
     /* -=[Update State Phase]=- */
     spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-    status = LIBSPDM_STATUS_SUCCESS;
 
     /* -=[Log Message Phase]=- */
     #if LIBSPDM_ENABLE_MSG_LOG
     libspdm_append_msg_log(spdm_context, spdm_response, spdm_response_size);
     #endif /* LIBSPDM_ENABLE_MSG_LOG */
 
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * This function sends GET_CAPABILITIES and receives CAPABILITIES.
+ *
+ * @param  spdm_context A pointer to the SPDM context.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         GET_CAPABILITIES was sent and CAPABILITIES was received.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Cannot send GET_CAPABILITIES due to Requester's state. Send GET_VERSION first.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
+ *         The size of the CAPABILITIES response is invalid.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
+ *         The CAPABILITIES response contains one or more invalid fields.
+ * @retval LIBSPDM_STATUS_ERROR_PEER
+ *         The Responder returned an unexpected error.
+ * @retval LIBSPDM_STATUS_BUSY_PEER
+ *         The Responder continually returned Busy error messages.
+ * @retval LIBSPDM_STATUS_RESYNCH_PEER
+ *         The Responder returned a RequestResynch error message.
+ * @retval LIBSPDM_STATUS_BUFFER_FULL
+ *         The buffer used to store transcripts is exhausted.
+ **/
+static libspdm_return_t libspdm_try_get_capabilities(libspdm_context_t *spdm_context,
+                                                     size_t *supported_algs_length,
+                                                     void *supported_algs)
+{
+    libspdm_return_t status;
+    spdm_get_capabilities_request_t *spdm_request;
+    size_t spdm_request_size;
+    spdm_capabilities_response_t *spdm_response;
+    size_t spdm_response_size;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    status = libspdm_build_get_capabilities_request(spdm_context, supported_algs != NULL,
+                                                    &spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
+                                           (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    status = libspdm_process_capabilities_response(spdm_context,
+                                                   supported_algs_length, supported_algs,
+                                                   spdm_request, spdm_request_size,
+                                                   spdm_response, spdm_response_size);
+
 receive_done:
     libspdm_release_receiver_buffer (spdm_context);
     return status;
@@ -18,57 +18,13 @@ typedef struct {
 } libspdm_digests_response_max_t;
 #pragma pack()
 
-/**
- * This function sends GET_DIGESTS and receives DIGESTS *
- *
- * @param  context             A pointer to the SPDM context.
- * @param  slot_mask           Bitmask of the slots that contain certificates.
- * @param  total_digest_buffer A pointer to a destination buffer to store the digests.
- *
- * @retval LIBSPDM_STATUS_SUCCESS
- *         GET_DIGESTS was sent and DIGESTS was received.
- * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
- *         Cannot send GET_DIGESTS due to Requester's state.
- * @retval LIBSPDM_STATUS_UNSUPPORTED_CAP
- *         Cannot send GET_DIGESTS because the Requester's and/or Responder's CERT_CAP = 0.
- * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
- *         The size of the DIGESTS response is invalid.
- * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
- *         The DIGESTS response contains one or more invalid fields.
- * @retval LIBSPDM_STATUS_ERROR_PEER
- *         The Responder returned an unexpected error.
- * @retval LIBSPDM_STATUS_BUSY_PEER
- *         The Responder continually returned Busy error messages.
- * @retval LIBSPDM_STATUS_RESYNCH_PEER
- *         The Responder returned a RequestResynch error message.
- * @retval LIBSPDM_STATUS_BUFFER_FULL
- *         The buffer used to store transcripts is exhausted.
- **/
-static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
-                                               const uint32_t *session_id,
-                                               uint8_t *slot_mask,
-                                               void *total_digest_buffer)
+libspdm_return_t libspdm_build_get_digest_request(libspdm_context_t *spdm_context,
+                                                  const uint32_t *session_id,
+                                                  size_t *spdm_request_size,
+                                                  spdm_get_digest_request_t *spdm_request)
 {
-    libspdm_return_t status;
-    spdm_get_digest_request_t *spdm_request;
-    size_t spdm_request_size;
-    libspdm_digests_response_max_t *spdm_response;
-    size_t spdm_response_size;
-    size_t digest_size;
-    size_t digest_count;
-    size_t index;
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
     libspdm_session_info_t *session_info;
     libspdm_session_state_t session_state;
-    size_t additional_size;
-    spdm_key_pair_id_t *key_pair_id;
-    spdm_certificate_info_t *cert_info;
-    spdm_key_usage_bit_mask_t *key_usage_bit_mask;
-    size_t slot_index;
-    uint8_t cert_model;
-    uint8_t zero_digest[LIBSPDM_MAX_HASH_SIZE] = {0};
 
     /* -=[Verify State Phase]=- */
     if (!libspdm_is_capabilities_flag_supported(
@@ -96,72 +52,49 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
     libspdm_reset_message_buffer_via_request_code(spdm_context, session_info, SPDM_GET_DIGESTS);
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_get_digest_request_t));
+    LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_get_digest_request_t));
     spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
     spdm_request->header.request_response_code = SPDM_GET_DIGESTS;
     spdm_request->header.param1 = 0;
     spdm_request->header.param2 = 0;
-    spdm_request_size = sizeof(spdm_get_digest_request_t);
+    *spdm_request_size = sizeof(spdm_get_digest_request_t);
 
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, session_id, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        return status;
-    }
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
+libspdm_return_t libspdm_process_digests_response(libspdm_context_t *spdm_context,
+                                                  const uint32_t *session_id,
+                                                  uint8_t *slot_mask,
+                                                  void *total_digest_buffer,
+                                                  const spdm_get_digest_request_t *spdm_request,
+                                                  size_t spdm_request_size,
+                                                  void *response,
+                                                  size_t spdm_response_size)
+{
+    libspdm_return_t status;
+    libspdm_digests_response_max_t *spdm_response;
+    size_t digest_size;
+    size_t digest_count;
+    size_t index;
+    size_t additional_size;
+    spdm_key_pair_id_t *key_pair_id;
+    spdm_certificate_info_t *cert_info;
+    spdm_key_usage_bit_mask_t *key_usage_bit_mask;
+    size_t slot_index;
+    uint8_t cert_model;
+    uint8_t zero_digest[LIBSPDM_MAX_HASH_SIZE] = {0};
 
-    status = libspdm_receive_spdm_response(
-        spdm_context, session_id, &spdm_response_size, (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
-    }
+    spdm_response = response;
 
     /* -=[Validate Response Phase]=- */
-    if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
-    }
-    if (spdm_response->header.request_response_code == SPDM_ERROR) {
-        status = libspdm_handle_error_response_main(
-            spdm_context, session_id,
-            &spdm_response_size,
-            (void **)&spdm_response, SPDM_GET_DIGESTS, SPDM_DIGESTS);
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
-        }
-    } else if (spdm_response->header.request_response_code != SPDM_DIGESTS) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+    if (spdm_response->header.request_response_code != SPDM_DIGESTS) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size < sizeof(spdm_digest_response_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
 
     digest_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
@@ -177,8 +110,7 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
         /* If bit is set in ProvisionedSlotMask then it must also be set in SupportedSlotMask. */
         if ((spdm_response->header.param1 & spdm_response->header.param2) !=
             spdm_response->header.param2) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
 
@@ -189,8 +121,7 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
         }
     }
     if (digest_count == 0) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
 
     additional_size = 0;
@@ -201,8 +132,7 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
     }
     if (spdm_response_size <
         sizeof(spdm_digest_response_t) + digest_count * (digest_size + additional_size)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     spdm_response_size =
         sizeof(spdm_digest_response_t) + digest_count * (digest_size + additional_size);
@@ -211,18 +141,18 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
     if (session_id == NULL) {
         status = libspdm_append_message_b(spdm_context, spdm_request, spdm_request_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
 
         status = libspdm_append_message_b(spdm_context, spdm_response, spdm_response_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
 
         if (spdm_context->connection_info.multi_key_conn_rsp) {
             status = libspdm_append_message_d(spdm_context, spdm_response, spdm_response_size);
             if (LIBSPDM_STATUS_IS_ERROR(status)) {
-                goto receive_done;
+                return status;
             }
         }
     }
@@ -283,21 +213,18 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
                 spdm_context->connection_info.peer_key_pair_id[index] = key_pair_id[slot_index];
                 cert_model = cert_info[slot_index] & SPDM_CERTIFICATE_INFO_CERT_MODEL_MASK;
                 if (cert_model > SPDM_CERTIFICATE_INFO_CERT_MODEL_GENERIC_CERT) {
-                    status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                    goto receive_done;
+                    return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                 }
                 if (index == 0) {
                     if (cert_model == SPDM_CERTIFICATE_INFO_CERT_MODEL_GENERIC_CERT) {
-                        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                        goto receive_done;
+                        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                     }
                     if ((key_usage_bit_mask[slot_index] &
                          (SPDM_KEY_USAGE_BIT_MASK_KEY_EX_USE |
                           SPDM_KEY_USAGE_BIT_MASK_CHALLENGE_USE |
                           SPDM_KEY_USAGE_BIT_MASK_MEASUREMENT_USE |
                           SPDM_KEY_USAGE_BIT_MASK_ENDPOINT_INFO_USE)) == 0) {
-                        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                        goto receive_done;
+                        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                     }
                 }
                 if ((cert_model == SPDM_CERTIFICATE_INFO_CERT_MODEL_NONE) &&
@@ -305,8 +232,7 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
                          spdm_response->digest + digest_size * slot_index,
                          zero_digest,
                          digest_size))) {
-                    status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                    goto receive_done;
+                    return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                 }
                 spdm_context->connection_info.peer_cert_info[index] = cert_model;
                 spdm_context->connection_info.peer_key_usage_bit_mask[index] =
@@ -320,13 +246,121 @@ static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
     if (spdm_context->connection_info.connection_state < LIBSPDM_CONNECTION_STATE_AFTER_DIGESTS) {
         spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AFTER_DIGESTS;
     }
-    status = LIBSPDM_STATUS_SUCCESS;
 
     /* -=[Log Message Phase]=- */
     #if LIBSPDM_ENABLE_MSG_LOG
     libspdm_append_msg_log(spdm_context, spdm_response, spdm_response_size);
     #endif /* LIBSPDM_ENABLE_MSG_LOG */
 
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * This function sends GET_DIGESTS and receives DIGESTS *
+ *
+ * @param  context             A pointer to the SPDM context.
+ * @param  slot_mask           Bitmask of the slots that contain certificates.
+ * @param  total_digest_buffer A pointer to a destination buffer to store the digests.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         GET_DIGESTS was sent and DIGESTS was received.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Cannot send GET_DIGESTS due to Requester's state.
+ * @retval LIBSPDM_STATUS_UNSUPPORTED_CAP
+ *         Cannot send GET_DIGESTS because the Requester's and/or Responder's CERT_CAP = 0.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
+ *         The size of the DIGESTS response is invalid.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
+ *         The DIGESTS response contains one or more invalid fields.
+ * @retval LIBSPDM_STATUS_ERROR_PEER
+ *         The Responder returned an unexpected error.
+ * @retval LIBSPDM_STATUS_BUSY_PEER
+ *         The Responder continually returned Busy error messages.
+ * @retval LIBSPDM_STATUS_RESYNCH_PEER
+ *         The Responder returned a RequestResynch error message.
+ * @retval LIBSPDM_STATUS_BUFFER_FULL
+ *         The buffer used to store transcripts is exhausted.
+ **/
+static libspdm_return_t libspdm_try_get_digest(libspdm_context_t *spdm_context,
+                                               const uint32_t *session_id,
+                                               uint8_t *slot_mask,
+                                               void *total_digest_buffer)
+{
+    libspdm_return_t status;
+    spdm_get_digest_request_t *spdm_request;
+    size_t spdm_request_size;
+    libspdm_digests_response_max_t *spdm_response;
+    size_t spdm_response_size;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    status = libspdm_build_get_digest_request(spdm_context, session_id,
+                                              &spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, session_id, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(
+        spdm_context, session_id, &spdm_response_size, (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    /* -=[Validate Response Phase]=- */
+    if (spdm_response_size < sizeof(spdm_message_header_t)) {
+        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
+        goto receive_done;
+    }
+    if (spdm_response->header.request_response_code == SPDM_ERROR) {
+        status = libspdm_handle_error_response_main(
+            spdm_context, session_id,
+            &spdm_response_size,
+            (void **)&spdm_response, SPDM_GET_DIGESTS, SPDM_DIGESTS);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            goto receive_done;
+        }
+    } else if (spdm_response->header.request_response_code != SPDM_DIGESTS) {
+        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        goto receive_done;
+    }
+
+    status = libspdm_process_digests_response(spdm_context, session_id,
+                                              slot_mask, total_digest_buffer,
+                                              spdm_request, spdm_request_size,
+                                              spdm_response, spdm_response_size);
+
 receive_done:
     libspdm_release_receiver_buffer (spdm_context);
     return status;
@@ -356,4 +390,17 @@ libspdm_return_t libspdm_get_digest(void *spdm_context, const uint32_t *session_
     return status;
 }
 
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+libspdm_return_t libspdm_get_digest_async(void *spdm_context, const uint32_t *session_id,
+                                          uint8_t *slot_mask, void *total_digest_buffer)
+{
+    libspdm_async_get_digest_param_t param;
+
+    param.slot_mask = slot_mask;
+    param.total_digest_buffer = total_digest_buffer;
+    return libspdm_async_start(spdm_context, session_id, SPDM_GET_DIGESTS,
+                               &param, sizeof(param));
+}
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
 #endif /* LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
@@ -87,6 +87,12 @@ static libspdm_return_t libspdm_try_get_measurement_extension_log(libspdm_contex
     length = LIBSPDM_MIN(SPDM_MAX_MEASUREMENT_EXTENSION_LOG_SIZE,
                          spdm_context->local_context.capability.max_spdm_msg_size -
                          sizeof(spdm_measurement_extension_log_response_t));
+    /* keep each portion within one message so that it is never chunked */
+    if (spdm_context->local_context.portion_within_data_transfer_size) {
+        length = LIBSPDM_MIN(length,
+                             spdm_context->local_context.capability.data_transfer_size -
+                             sizeof(spdm_measurement_extension_log_response_t));
+    }
 
     transport_header_size = spdm_context->local_context.capability.transport_header_size;
 
@@ -245,6 +251,11 @@ static libspdm_return_t libspdm_try_get_measurement_extension_log(libspdm_contex
     *mel_size = mel_size_internal;
     LIBSPDM_ASSERT(*mel_size <= SPDM_MAX_MEASUREMENT_EXTENSION_LOG_SIZE);
 
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    /* A log that grew means that measurements were extended since they were cached. */
+    libspdm_update_measurement_cache_mel(spdm_context, mel_size_internal);
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
     status = LIBSPDM_STATUS_SUCCESS;
 
 done:
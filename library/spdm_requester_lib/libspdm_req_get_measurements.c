@@ -141,67 +141,19 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
     return true;
 }
 
-/**
- * This function sends GET_MEASUREMENT to get measurement from the device.
- * If the signature is requested this function verifies the signature of the measurement.
- *
- * @param  context                    A pointer to the SPDM context.
- * @param  session_id                 Indicates if it is a secured message protected via SPDM session.
- *                                    If session_id is NULL, it is a normal message.
- *                                    If session_id is not NULL, it is a secured message.
- * @param  request_attribute          The request attribute of the request message.
- * @param  measurement_operation      The measurement operation of the request message.
- * @param  slot_id                    The number of slot for the certificate chain.
- * @param  requester_context          If not NULL, a buffer to hold the requester context (8 bytes).
- *                                    It is used only if the negotiated version >= 1.3.
- * @param  content_changed            The measurement content changed output param.
- * @param  number_of_blocks           The number of blocks of the measurement record.
- * @param  measurement_record_length  On input, indicate the size in bytes of the destination buffer
- *                                    to store the measurement record.
- *                                    On output, indicate the size in bytes of the measurement record.
- * @param  measurement_record         A pointer to a destination buffer to store the measurement record.
- * @param  requester_nonce_in         If not NULL, a buffer that holds the requester nonce (32 bytes)
- * @param  requester_nonce            If not NULL, a buffer to hold the requester nonce (32 bytes).
- * @param  responder_nonce            If not NULL, a buffer to hold the responder nonce (32 bytes).
- *
- **/
-static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_context,
-                                                    const uint32_t *session_id,
-                                                    uint8_t request_attribute,
-                                                    uint8_t measurement_operation,
-                                                    uint8_t slot_id_param,
-                                                    const void *requester_context,
-                                                    uint8_t *content_changed,
-                                                    uint8_t *number_of_blocks,
-                                                    uint32_t *measurement_record_length,
-                                                    void *measurement_record,
-                                                    const void *requester_nonce_in,
-                                                    void *requester_nonce,
-                                                    void *responder_nonce,
-                                                    void *opaque_data,
-                                                    size_t *opaque_data_size)
+libspdm_return_t libspdm_build_get_measurement_request(libspdm_context_t *spdm_context,
+                                                       const uint32_t *session_id,
+                                                       uint8_t request_attribute,
+                                                       uint8_t measurement_operation,
+                                                       uint8_t slot_id_param,
+                                                       const void *requester_context,
+                                                       const void *requester_nonce_in,
+                                                       void *requester_nonce,
+                                                       size_t *spdm_request_size,
+                                                       spdm_get_measurements_request_t *spdm_request)
 {
-    bool result;
-    libspdm_return_t status;
-    spdm_get_measurements_request_t *spdm_request;
-    size_t spdm_request_size;
-    spdm_measurements_response_t *spdm_response;
-    size_t spdm_response_size;
-    uint32_t measurement_record_data_length;
-    uint8_t *measurement_record_data;
-    spdm_measurement_block_common_header_t *measurement_block_header;
-    uint32_t measurement_block_size;
-    uint8_t measurement_block_count;
-    uint8_t *ptr;
-    void *nonce;
-    uint16_t opaque_length;
-    void *signature;
-    size_t signature_size;
     libspdm_session_info_t *session_info;
     libspdm_session_state_t session_state;
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
 
     /* -=[Check Parameters Phase]=- */
     LIBSPDM_ASSERT((slot_id_param < SPDM_MAX_SLOT_COUNT) || (slot_id_param == 0xF));
@@ -242,55 +194,31 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         return LIBSPDM_STATUS_INVALID_PARAMETER;
     }
 
-    if ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0) {
-        if (spdm_context->connection_info.algorithm.pqc_asym_algo != 0) {
-            signature_size = libspdm_get_pqc_asym_signature_size(
-                spdm_context->connection_info.algorithm.pqc_asym_algo);
-        } else {
-            signature_size = libspdm_get_asym_signature_size(
-                spdm_context->connection_info.algorithm.base_asym_algo);
-        }
-    } else {
-        signature_size = 0;
-    }
-
     libspdm_reset_message_buffer_via_request_code(spdm_context, NULL, SPDM_GET_MEASUREMENTS);
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_request->header));
+    LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_request->header));
     spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
     spdm_request->header.request_response_code = SPDM_GET_MEASUREMENTS;
     spdm_request->header.param1 = request_attribute;
     spdm_request->header.param2 = measurement_operation;
     if ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0) {
         if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_13) {
-            LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_get_measurements_request_t) +
+            LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_get_measurements_request_t) +
                             SPDM_REQ_CONTEXT_SIZE);
-            spdm_request_size = sizeof(spdm_get_measurements_request_t) + SPDM_REQ_CONTEXT_SIZE;
+            *spdm_request_size = sizeof(spdm_get_measurements_request_t) + SPDM_REQ_CONTEXT_SIZE;
         } else if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_11) {
-            LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_get_measurements_request_t));
-            spdm_request_size = sizeof(spdm_get_measurements_request_t);
+            LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_get_measurements_request_t));
+            *spdm_request_size = sizeof(spdm_get_measurements_request_t);
         } else {
-            LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_get_measurements_request_t) -
+            LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_get_measurements_request_t) -
                             sizeof(spdm_request->slot_id_param));
-            spdm_request_size = sizeof(spdm_get_measurements_request_t) -
-                                sizeof(spdm_request->slot_id_param);
+            *spdm_request_size = sizeof(spdm_get_measurements_request_t) -
+                                 sizeof(spdm_request->slot_id_param);
         }
 
         if (requester_nonce_in == NULL) {
             if (!libspdm_get_random_number(SPDM_NONCE_SIZE, spdm_request->nonce)) {
-                libspdm_release_sender_buffer (spdm_context);
                 return LIBSPDM_STATUS_LOW_ENTROPY;
             }
         } else {
@@ -308,11 +236,11 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         }
     } else {
         if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_13) {
-            LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_request->header) +
+            LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_request->header) +
                             SPDM_REQ_CONTEXT_SIZE);
-            spdm_request_size = sizeof(spdm_request->header) + SPDM_REQ_CONTEXT_SIZE;
+            *spdm_request_size = sizeof(spdm_request->header) + SPDM_REQ_CONTEXT_SIZE;
         } else {
-            spdm_request_size = sizeof(spdm_request->header);
+            *spdm_request_size = sizeof(spdm_request->header);
         }
 
         if (requester_nonce != NULL) {
@@ -321,85 +249,90 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
     }
     if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_13) {
         if (requester_context == NULL) {
-            libspdm_zero_mem((uint8_t *)spdm_request + spdm_request_size - SPDM_REQ_CONTEXT_SIZE,
+            libspdm_zero_mem((uint8_t *)spdm_request + *spdm_request_size - SPDM_REQ_CONTEXT_SIZE,
                              SPDM_REQ_CONTEXT_SIZE);
         } else {
-            libspdm_copy_mem((uint8_t *)spdm_request + spdm_request_size - SPDM_REQ_CONTEXT_SIZE,
+            libspdm_copy_mem((uint8_t *)spdm_request + *spdm_request_size - SPDM_REQ_CONTEXT_SIZE,
                              SPDM_REQ_CONTEXT_SIZE,
                              requester_context, SPDM_REQ_CONTEXT_SIZE);
         }
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "RequesterContext - "));
-        LIBSPDM_INTERNAL_DUMP_DATA((uint8_t *)spdm_request + spdm_request_size -
+        LIBSPDM_INTERNAL_DUMP_DATA((uint8_t *)spdm_request + *spdm_request_size -
                                    SPDM_REQ_CONTEXT_SIZE,
                                    SPDM_REQ_CONTEXT_SIZE);
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
     }
 
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, session_id, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        return status;
-    }
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
+libspdm_return_t libspdm_process_measurements_response(
+    libspdm_context_t *spdm_context, const uint32_t *session_id,
+    uint8_t request_attribute, uint8_t measurement_operation, uint8_t slot_id_param,
+    uint8_t *content_changed, uint8_t *number_of_blocks,
+    uint32_t *measurement_record_length, void *measurement_record,
+    void *responder_nonce, void *opaque_data, size_t *opaque_data_size,
+    const spdm_get_measurements_request_t *spdm_request, size_t spdm_request_size,
+    spdm_measurements_response_t *spdm_response, size_t spdm_response_size)
+{
+    bool result;
+    libspdm_return_t status;
+    uint32_t measurement_record_data_length;
+    uint8_t *measurement_record_data;
+    spdm_measurement_block_common_header_t *measurement_block_header;
+    uint32_t measurement_block_size;
+    uint8_t measurement_block_count;
+    uint8_t *ptr;
+    void *nonce;
+    uint16_t opaque_length;
+    void *signature;
+    size_t signature_size;
+    libspdm_session_info_t *session_info;
+
+    if (session_id == NULL) {
+        session_info = NULL;
+    } else {
+        session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
+        if (session_info == NULL) {
+            return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+        }
     }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
 
-    status = libspdm_receive_spdm_response(
-        spdm_context, session_id, &spdm_response_size, (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+    if ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0) {
+        if (spdm_context->connection_info.algorithm.pqc_asym_algo != 0) {
+            signature_size = libspdm_get_pqc_asym_signature_size(
+                spdm_context->connection_info.algorithm.pqc_asym_algo);
+        } else {
+            signature_size = libspdm_get_asym_signature_size(
+                spdm_context->connection_info.algorithm.base_asym_algo);
+        }
+    } else {
+        signature_size = 0;
     }
 
     /* -=[Validate Response Phase]=- */
-    if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
-    }
-    if (spdm_response->header.request_response_code == SPDM_ERROR) {
-        status = libspdm_handle_error_response_main(
-            spdm_context, session_id,
-            &spdm_response_size, (void **)&spdm_response,
-            SPDM_GET_MEASUREMENTS, SPDM_MEASUREMENTS);
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
-        }
-    } else if (spdm_response->header.request_response_code != SPDM_MEASUREMENTS) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+    if (spdm_response->header.request_response_code != SPDM_MEASUREMENTS) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size < sizeof(spdm_measurements_response_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     if (measurement_operation ==
         SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
         if (spdm_response->number_of_blocks != 0) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     } else if (measurement_operation ==
                SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
         if ((spdm_response->number_of_blocks == 0) || (spdm_response->number_of_blocks == 0xff)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     } else {
         if (spdm_response->number_of_blocks != 1) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
 
@@ -407,15 +340,13 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
     if (measurement_operation ==
         SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
         if (measurement_record_data_length != 0) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     } else {
         if (spdm_response_size <
             sizeof(spdm_measurements_response_t) +
             measurement_record_data_length) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "measurement_record_length - 0x%06x\n",
                        measurement_record_data_length));
@@ -427,14 +358,12 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         if (spdm_response_size <
             sizeof(spdm_measurements_response_t) +
             measurement_record_data_length + SPDM_NONCE_SIZE + sizeof(uint16_t)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         if ((spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_11) &&
             ((spdm_response->header.param2 & SPDM_MEASUREMENTS_RESPONSE_SLOT_ID_MASK)
              != slot_id_param)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         ptr = measurement_record_data + measurement_record_data_length;
         nonce = ptr;
@@ -448,24 +377,21 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
 
         opaque_length = libspdm_read_uint16((const uint8_t *)ptr);
         if (opaque_length > SPDM_MAX_OPAQUE_DATA_SIZE) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
             if (((spdm_context->connection_info.algorithm.other_params_support &
                   SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_MASK) ==
                  SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_NONE)
                 && (opaque_length != 0)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
         }
         ptr += sizeof(uint16_t);
         if (opaque_length != 0) {
             result = libspdm_process_general_opaque_data_check(spdm_context, opaque_length, ptr);
             if (!result) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
         }
 
@@ -474,8 +400,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
                 sizeof(spdm_measurements_response_t) +
                 measurement_record_data_length + SPDM_NONCE_SIZE +
                 sizeof(uint16_t) + opaque_length + SPDM_REQ_CONTEXT_SIZE + signature_size) {
-                status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_SIZE;
             }
             spdm_response_size = sizeof(spdm_measurements_response_t) +
                                  measurement_record_data_length +
@@ -486,8 +411,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
                 sizeof(spdm_measurements_response_t) +
                 measurement_record_data_length + SPDM_NONCE_SIZE +
                 sizeof(uint16_t) + opaque_length + signature_size) {
-                status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_SIZE;
             }
             spdm_response_size = sizeof(spdm_measurements_response_t) +
                                  measurement_record_data_length +
@@ -497,8 +421,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
 
         if ((opaque_data != NULL) && (opaque_data_size != NULL)) {
             if (opaque_length >= *opaque_data_size) {
-                status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-                goto receive_done;
+                return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
             }
             libspdm_copy_mem(opaque_data, *opaque_data_size, ptr, opaque_length);
             *opaque_data_size = opaque_length;
@@ -508,11 +431,10 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
             LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "RequesterContext - "));
             LIBSPDM_INTERNAL_DUMP_DATA(ptr, SPDM_REQ_CONTEXT_SIZE);
             LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-            if (!libspdm_consttime_is_mem_equal((uint8_t *)spdm_request +
+            if (!libspdm_consttime_is_mem_equal((const uint8_t *)spdm_request +
                                                 spdm_request_size - SPDM_REQ_CONTEXT_SIZE,
                                                 ptr, SPDM_REQ_CONTEXT_SIZE)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             ptr += SPDM_REQ_CONTEXT_SIZE;
         }
@@ -521,13 +443,13 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         status = libspdm_append_message_m(spdm_context, session_info, spdm_request,
                                           spdm_request_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
 
         status = libspdm_append_message_m(spdm_context, session_info, spdm_response,
                                           spdm_response_size - signature_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
 
         signature = ptr;
@@ -537,8 +459,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         result = libspdm_verify_measurement_signature(
             spdm_context, session_info, slot_id_param, signature, signature_size);
         if (!result) {
-            status = LIBSPDM_STATUS_VERIF_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_VERIF_FAIL;
         }
 
         libspdm_reset_message_m(spdm_context, session_info);
@@ -546,8 +467,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         if (spdm_response_size <
             sizeof(spdm_measurements_response_t) +
             measurement_record_data_length + sizeof(uint16_t)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         ptr = measurement_record_data + measurement_record_data_length;
 
@@ -562,15 +482,13 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
 
         opaque_length = libspdm_read_uint16((const uint8_t *)ptr);
         if (opaque_length > SPDM_MAX_OPAQUE_DATA_SIZE) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         ptr += sizeof(uint16_t);
         if (opaque_length != 0) {
             result = libspdm_process_general_opaque_data_check(spdm_context, opaque_length, ptr);
             if (!result) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
         }
 
@@ -579,8 +497,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
                 sizeof(spdm_measurements_response_t) +
                 measurement_record_data_length + SPDM_NONCE_SIZE +
                 sizeof(uint16_t) + opaque_length + SPDM_REQ_CONTEXT_SIZE) {
-                status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_SIZE;
             }
             spdm_response_size = sizeof(spdm_measurements_response_t) +
                                  measurement_record_data_length +
@@ -591,8 +508,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
                 sizeof(spdm_measurements_response_t) +
                 measurement_record_data_length + SPDM_NONCE_SIZE +
                 sizeof(uint16_t) + opaque_length) {
-                status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_SIZE;
             }
             spdm_response_size = sizeof(spdm_measurements_response_t) +
                                  measurement_record_data_length +
@@ -602,8 +518,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
 
         if ((opaque_data != NULL) && (opaque_data_size != NULL)) {
             if (opaque_length >= *opaque_data_size) {
-                status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-                goto receive_done;
+                return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
             }
             libspdm_copy_mem(opaque_data, *opaque_data_size, ptr, opaque_length);
             *opaque_data_size = opaque_length;
@@ -613,11 +528,10 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
             LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "RequesterContext - "));
             LIBSPDM_INTERNAL_DUMP_DATA(ptr, SPDM_REQ_CONTEXT_SIZE);
             LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-            if (!libspdm_consttime_is_mem_equal((uint8_t *)spdm_request +
+            if (!libspdm_consttime_is_mem_equal((const uint8_t *)spdm_request +
                                                 spdm_request_size - SPDM_REQ_CONTEXT_SIZE,
                                                 ptr, SPDM_REQ_CONTEXT_SIZE)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             ptr += SPDM_REQ_CONTEXT_SIZE;
         }
@@ -626,21 +540,20 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
             if ((spdm_response->header.param2 & SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK)
                 != 0) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
         }
 
         status = libspdm_append_message_m(spdm_context, session_info, spdm_request,
                                           spdm_request_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
 
         status = libspdm_append_message_m(spdm_context, session_info, spdm_response,
                                           spdm_response_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
     }
 
@@ -658,23 +571,19 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         *number_of_blocks = spdm_response->header.param1;
         if (*number_of_blocks == 0xFF) {
             /* the number of block cannot be 0xFF, because index 0xFF will brings confusing.*/
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         if (*number_of_blocks == 0x0) {
             /* the number of block cannot be 0x0, because a responder without measurement should clear capability flags.*/
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     } else {
         *number_of_blocks = spdm_response->number_of_blocks;
         if (*measurement_record_length < measurement_record_data_length) {
-            status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            goto receive_done;
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
         if (measurement_record_data_length < sizeof(spdm_measurement_block_common_header_t)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
 
         measurement_block_size = 0;
@@ -687,34 +596,28 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
                 measurement_record_data_length -
                 ((uint8_t *)measurement_block_header -
                  (uint8_t *)measurement_record_data)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if (measurement_block_header->measurement_specification == 0 ||
                 (measurement_block_header->measurement_specification &
                  (measurement_block_header->measurement_specification - 1))) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if (measurement_block_header->measurement_specification !=
                 spdm_context->connection_info.algorithm.measurement_spec) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if (measurement_block_header->index == 0 || measurement_block_header->index == 0xFF) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if (measurement_operation !=
                 SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
                 if (measurement_block_header->index != measurement_operation) {
-                    status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                    goto receive_done;
+                    return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                 }
             }
             if (measurement_block_count > *number_of_blocks) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             measurement_block_count++;
             measurement_block_size = (uint32_t)(
@@ -724,8 +627,7 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
         }
 
         if (measurement_block_size != measurement_record_data_length) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
 
         *measurement_record_length = measurement_record_data_length;
@@ -735,16 +637,140 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
                          measurement_record_data_length);
     }
 
-    status = LIBSPDM_STATUS_SUCCESS;
-
     /* -=[Log Message Phase]=- */
     #if LIBSPDM_ENABLE_MSG_LOG
     libspdm_append_msg_log(spdm_context, spdm_response, spdm_response_size);
     #endif /* LIBSPDM_ENABLE_MSG_LOG */
 
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * This function sends GET_MEASUREMENT to get measurement from the device.
+ * If the signature is requested this function verifies the signature of the measurement.
+ *
+ * @param  context                    A pointer to the SPDM context.
+ * @param  session_id                 Indicates if it is a secured message protected via SPDM session.
+ *                                    If session_id is NULL, it is a normal message.
+ *                                    If session_id is not NULL, it is a secured message.
+ * @param  request_attribute          The request attribute of the request message.
+ * @param  measurement_operation      The measurement operation of the request message.
+ * @param  slot_id                    The number of slot for the certificate chain.
+ * @param  requester_context          If not NULL, a buffer to hold the requester context (8 bytes).
+ *                                    It is used only if the negotiated version >= 1.3.
+ * @param  content_changed            The measurement content changed output param.
+ * @param  number_of_blocks           The number of blocks of the measurement record.
+ * @param  measurement_record_length  On input, indicate the size in bytes of the destination buffer
+ *                                    to store the measurement record.
+ *                                    On output, indicate the size in bytes of the measurement record.
+ * @param  measurement_record         A pointer to a destination buffer to store the measurement record.
+ * @param  requester_nonce_in         If not NULL, a buffer that holds the requester nonce (32 bytes)
+ * @param  requester_nonce            If not NULL, a buffer to hold the requester nonce (32 bytes).
+ * @param  responder_nonce            If not NULL, a buffer to hold the responder nonce (32 bytes).
+ *
+ **/
+static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_context,
+                                                    const uint32_t *session_id,
+                                                    uint8_t request_attribute,
+                                                    uint8_t measurement_operation,
+                                                    uint8_t slot_id_param,
+                                                    const void *requester_context,
+                                                    uint8_t *content_changed,
+                                                    uint8_t *number_of_blocks,
+                                                    uint32_t *measurement_record_length,
+                                                    void *measurement_record,
+                                                    const void *requester_nonce_in,
+                                                    void *requester_nonce,
+                                                    void *responder_nonce,
+                                                    void *opaque_data,
+                                                    size_t *opaque_data_size)
+{
+    libspdm_return_t status;
+    spdm_get_measurements_request_t *spdm_request;
+    size_t spdm_request_size;
+    spdm_measurements_response_t *spdm_response;
+    size_t spdm_response_size;
+    libspdm_session_info_t *session_info;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    status = libspdm_build_get_measurement_request(
+        spdm_context, session_id, request_attribute, measurement_operation, slot_id_param,
+        requester_context, requester_nonce_in, requester_nonce,
+        &spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, session_id, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(
+        spdm_context, session_id, &spdm_response_size, (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    /* -=[Validate Response Phase]=- */
+    if (spdm_response_size < sizeof(spdm_message_header_t)) {
+        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
+        goto receive_done;
+    }
+    if (spdm_response->header.request_response_code == SPDM_ERROR) {
+        status = libspdm_handle_error_response_main(
+            spdm_context, session_id,
+            &spdm_response_size, (void **)&spdm_response,
+            SPDM_GET_MEASUREMENTS, SPDM_MEASUREMENTS);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            goto receive_done;
+        }
+    } else if (spdm_response->header.request_response_code != SPDM_MEASUREMENTS) {
+        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        goto receive_done;
+    }
+
+    status = libspdm_process_measurements_response(
+        spdm_context, session_id, request_attribute, measurement_operation, slot_id_param,
+        content_changed, number_of_blocks, measurement_record_length, measurement_record,
+        responder_nonce, opaque_data, opaque_data_size,
+        spdm_request, spdm_request_size, spdm_response, spdm_response_size);
+
 receive_done:
     if ((status != LIBSPDM_STATUS_SUCCESS) &&
         (status != LIBSPDM_STATUS_NOT_READY_PEER)) {
+        session_info = NULL;
+        if (session_id != NULL) {
+            session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
+        }
         libspdm_reset_message_m(spdm_context, session_info);
     }
     libspdm_release_receiver_buffer (spdm_context);
@@ -869,4 +895,213 @@ libspdm_return_t libspdm_get_measurement_ex2(void *spdm_context, const uint32_t
     return status;
 }
 
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+static libspdm_measurement_cache_entry_t *libspdm_find_measurement_cache_entry(
+    libspdm_context_t *spdm_context, uint8_t measurement_operation, uint8_t slot_id)
+{
+    libspdm_measurement_cache_entry_t *entry;
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT; index++) {
+        entry = &spdm_context->measurement_cache.entry[index];
+        if (entry->valid && (entry->measurement_operation == measurement_operation) &&
+            (entry->slot_id == slot_id)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static bool libspdm_is_measurement_record_cached(libspdm_context_t *spdm_context,
+                                                 const libspdm_measurement_cache_entry_t *entry,
+                                                 uint8_t number_of_blocks,
+                                                 uint32_t measurement_record_length,
+                                                 const void *measurement_record)
+{
+    uint8_t digest[LIBSPDM_MAX_HASH_SIZE];
+
+    if ((entry->number_of_blocks != number_of_blocks) ||
+        (entry->measurement_record_length != measurement_record_length)) {
+        return false;
+    }
+    if (!libspdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+                          measurement_record, measurement_record_length, digest)) {
+        return false;
+    }
+    return libspdm_consttime_is_mem_equal(
+        entry->measurement_record_digest, digest,
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo));
+}
+
+static void libspdm_cache_measurement_record(libspdm_context_t *spdm_context,
+                                             uint8_t measurement_operation, uint8_t slot_id,
+                                             uint8_t number_of_blocks,
+                                             uint32_t measurement_record_length,
+                                             const void *measurement_record)
+{
+    libspdm_measurement_cache_t *cache;
+    libspdm_measurement_cache_entry_t *entry;
+
+    cache = &spdm_context->measurement_cache;
+    entry = libspdm_find_measurement_cache_entry(spdm_context, measurement_operation, slot_id);
+    if (entry == NULL) {
+        entry = &cache->entry[cache->next_entry];
+        cache->next_entry = (uint8_t)((cache->next_entry + 1) %
+                                      LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT);
+    }
+
+    entry->valid = libspdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+                                    measurement_record, measurement_record_length,
+                                    entry->measurement_record_digest);
+    entry->slot_id = slot_id;
+    entry->measurement_operation = measurement_operation;
+    entry->number_of_blocks = number_of_blocks;
+    entry->measurement_record_length = measurement_record_length;
+}
+
+void libspdm_invalidate_measurement_cache_slot(libspdm_context_t *spdm_context, uint8_t slot_id)
+{
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_MEASUREMENT_CACHE_ENTRY_COUNT; index++) {
+        if (spdm_context->measurement_cache.entry[index].slot_id == slot_id) {
+            libspdm_zero_mem(&spdm_context->measurement_cache.entry[index],
+                             sizeof(libspdm_measurement_cache_entry_t));
+        }
+    }
+}
+
+void libspdm_update_measurement_cache_mel(libspdm_context_t *spdm_context, size_t mel_size)
+{
+    if (spdm_context->measurement_cache.mel_size != mel_size) {
+        libspdm_reset_measurement_cache(spdm_context);
+        spdm_context->measurement_cache.mel_size = mel_size;
+    }
+}
+
+void libspdm_reset_measurement_cache(void *spdm_context)
+{
+    libspdm_context_t *context;
+
+    context = spdm_context;
+    libspdm_zero_mem(&context->measurement_cache, sizeof(context->measurement_cache));
+}
+
+libspdm_return_t libspdm_get_measurement_cached(void *spdm_context, const uint32_t *session_id,
+                                                uint8_t measurement_operation,
+                                                uint8_t slot_id_param,
+                                                bool *unchanged,
+                                                uint8_t *number_of_blocks,
+                                                uint32_t *measurement_record_length,
+                                                void *measurement_record)
+{
+    libspdm_context_t *context;
+    libspdm_session_info_t *session_info;
+    libspdm_measurement_cache_entry_t *entry;
+    uint32_t measurement_record_capacity;
+    uint8_t session_slot_id;
+    uint8_t content_changed;
+    libspdm_return_t status;
+
+    context = spdm_context;
+    *unchanged = false;
+    if (measurement_operation ==
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    session_info = NULL;
+    if (session_id != NULL) {
+        session_info = libspdm_get_session_info_via_session_id(context, *session_id);
+    }
+    entry = libspdm_find_measurement_cache_entry(context, measurement_operation, slot_id_param);
+    measurement_record_capacity = *measurement_record_length;
+
+    /* The keys of a session that the Responder authenticated with the same key that signed the
+     * cached record vouch for an unsigned response, so an unchanged record needs no signature. */
+    if ((entry != NULL) && (session_info != NULL) && !session_info->use_psk) {
+        session_slot_id = session_info->peer_used_cert_chain_slot_id;
+        if (session_slot_id == 0xFF) {
+            session_slot_id = 0xF;
+        }
+        if (session_slot_id == slot_id_param) {
+            status = libspdm_get_measurement(context, session_id, 0, measurement_operation,
+                                             slot_id_param, NULL, number_of_blocks,
+                                             measurement_record_length, measurement_record);
+            if (LIBSPDM_STATUS_IS_ERROR(status)) {
+                return status;
+            }
+            if (libspdm_is_measurement_record_cached(context, entry, *number_of_blocks,
+                                                     *measurement_record_length,
+                                                     measurement_record)) {
+                *unchanged = true;
+                return LIBSPDM_STATUS_SUCCESS;
+            }
+            *measurement_record_length = measurement_record_capacity;
+        }
+    }
+
+    status = libspdm_get_measurement(context, session_id,
+                                     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+                                     measurement_operation, slot_id_param, &content_changed,
+                                     number_of_blocks, measurement_record_length,
+                                     measurement_record);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    if (content_changed == SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED) {
+        /* The measurements changed while the signed transcript was built. */
+        libspdm_reset_measurement_cache(context);
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+    if (entry != NULL) {
+        *unchanged = libspdm_is_measurement_record_cached(context, entry, *number_of_blocks,
+                                                          *measurement_record_length,
+                                                          measurement_record);
+    }
+    libspdm_cache_measurement_record(context, measurement_operation, slot_id_param,
+                                     *number_of_blocks, *measurement_record_length,
+                                     measurement_record);
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+libspdm_return_t libspdm_get_measurement_async(void *spdm_context, const uint32_t *session_id,
+                                               uint8_t request_attribute,
+                                               uint8_t measurement_operation,
+                                               uint8_t slot_id,
+                                               const void *requester_context,
+                                               uint8_t *content_changed,
+                                               uint8_t *number_of_blocks,
+                                               uint32_t *measurement_record_length,
+                                               void *measurement_record,
+                                               const void *requester_nonce_in,
+                                               void *requester_nonce,
+                                               void *responder_nonce,
+                                               void *opaque_data,
+                                               size_t *opaque_data_size)
+{
+    libspdm_async_get_measurement_param_t param;
+
+    param.request_attribute = request_attribute;
+    param.measurement_operation = measurement_operation;
+    param.slot_id_param = slot_id;
+    param.requester_context = requester_context;
+    param.content_changed = content_changed;
+    param.number_of_blocks = number_of_blocks;
+    param.measurement_record_length = measurement_record_length;
+    param.measurement_record = measurement_record;
+    param.requester_nonce_in = requester_nonce_in;
+    param.requester_nonce = requester_nonce;
+    param.responder_nonce = responder_nonce;
+    param.opaque_data = opaque_data;
+    param.opaque_data_size = opaque_data_size;
+    return libspdm_async_start(spdm_context, session_id, SPDM_GET_MEASUREMENTS,
+                               &param, sizeof(param));
+}
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
+
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
@@ -15,129 +15,69 @@ typedef struct {
 } libspdm_version_response_max_t;
 #pragma pack()
 
-/**
- * This function sends GET_VERSION and receives VERSION.
- *
- * @param  spdm_context         A pointer to the SPDM context.
- * @param  version_count        The number of SPDM versions that the Responder supports.
- * @param  VersionNumberEntries The list of SPDM versions that the Responder supports.
- *
- * @retval LIBSPDM_STATUS_SUCCESS
- *         GET_VERSION was sent and VERSION was received.
- * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
- *         The size of the VERSION response is invalid.
- * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
- *         The VERSION response contains one or more invalid fields.
- * @retval LIBSPDM_STATUS_ERROR_PEER
- *         The Responder returned an unexpected error.
- * @retval LIBSPDM_STATUS_BUSY_PEER
- *         The Responder continually returned Busy error messages.
- * @retval LIBSPDM_STATUS_RESYNCH_PEER
- *         The Responder returned a RequestResynch error message.
- * @retval LIBSPDM_STATUS_NEGOTIATION_FAIL
- *         The Requester and Responder do not support a common SPDM version.
- **/
-static libspdm_return_t libspdm_try_get_version(libspdm_context_t *spdm_context,
-                                                uint8_t *version_number_entry_count,
-                                                spdm_version_number_t *version_number_entry)
+void libspdm_build_get_version_request(libspdm_context_t *spdm_context,
+                                       size_t *spdm_request_size,
+                                       spdm_get_version_request_t *spdm_request)
 {
-    libspdm_return_t status;
-    bool result;
-    spdm_get_version_request_t *spdm_request;
-    size_t spdm_request_size;
-    libspdm_version_response_max_t *spdm_response;
-    size_t spdm_response_size;
-    spdm_version_number_t common_version;
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
-
     /* -=[Set State Phase]=- */
     libspdm_reset_context(spdm_context);
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_get_version_request_t));
+    LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_get_version_request_t));
     spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
     spdm_request->header.request_response_code = SPDM_GET_VERSION;
     spdm_request->header.param1 = 0;
     spdm_request->header.param2 = 0;
-    spdm_request_size = sizeof(spdm_get_version_request_t);
-
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        return status;
-    }
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
+    *spdm_request_size = sizeof(spdm_get_version_request_t);
+}
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
+libspdm_return_t libspdm_process_version_response(libspdm_context_t *spdm_context,
+                                                  uint8_t *version_number_entry_count,
+                                                  spdm_version_number_t *version_number_entry,
+                                                  const spdm_get_version_request_t *spdm_request,
+                                                  size_t spdm_request_size,
+                                                  void *response,
+                                                  size_t spdm_response_size)
+{
+    libspdm_return_t status;
+    bool result;
+    libspdm_version_response_max_t *spdm_response;
+    spdm_version_number_t common_version;
 
-    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
-                                           (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
-    }
+    spdm_response = response;
 
     /* -=[Validate Response Phase]=- */
     if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     if (spdm_response->header.spdm_version != SPDM_MESSAGE_VERSION_10) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.request_response_code == SPDM_ERROR) {
         /* Responder shall not respond to the GET_VERSION request message with ErrorCode=ResponseNotReady.*/
         if (spdm_response->header.param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
             /* Received an unexpected error message. */
-            status = LIBSPDM_STATUS_ERROR_PEER;
-            goto receive_done;
+            return LIBSPDM_STATUS_ERROR_PEER;
         }
         status = libspdm_handle_simple_error_response(spdm_context, spdm_response->header.param1);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
     } else if (spdm_response->header.request_response_code != SPDM_VERSION) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size < sizeof(spdm_version_response_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     if (spdm_response->version_number_entry_count > LIBSPDM_MAX_VERSION_COUNT) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->version_number_entry_count == 0) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size < sizeof(spdm_version_response_t) +
         spdm_response->version_number_entry_count * sizeof(spdm_version_number_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     spdm_response_size = sizeof(spdm_version_response_t) +
                          spdm_response->version_number_entry_count * sizeof(spdm_version_number_t);
@@ -145,13 +85,13 @@ static libspdm_return_t libspdm_try_get_version(libspdm_context_t *spdm_context,
     /* -=[Process Response Phase]=- */
     status = libspdm_append_message_a(spdm_context, spdm_request, spdm_request_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+        return status;
     }
 
     status = libspdm_append_message_a(spdm_context, spdm_response, spdm_response_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         libspdm_reset_message_a(spdm_context);
-        goto receive_done;
+        return status;
     }
 
     result = libspdm_negotiate_connection_version (
@@ -162,8 +102,7 @@ static libspdm_return_t libspdm_try_get_version(libspdm_context_t *spdm_context,
         spdm_response->version_number_entry_count);
     if (result == false) {
         libspdm_reset_message_a(spdm_context);
-        status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-        goto receive_done;
+        return LIBSPDM_STATUS_NEGOTIATION_FAIL;
     }
 
     libspdm_copy_mem(&(spdm_context->connection_info.version),
@@ -174,8 +113,7 @@ static libspdm_return_t libspdm_try_get_version(libspdm_context_t *spdm_context,
         if (*version_number_entry_count < spdm_response->version_number_entry_count) {
             *version_number_entry_count = spdm_response->version_number_entry_count;
             libspdm_reset_message_a(spdm_context);
-            status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            goto receive_done;
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         } else {
             *version_number_entry_count = spdm_response->version_number_entry_count;
             libspdm_copy_mem(version_number_entry,
@@ -190,7 +128,6 @@ static libspdm_return_t libspdm_try_get_version(libspdm_context_t *spdm_context,
 
     /* -=[Update State Phase]=- */
     spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AFTER_VERSION;
-    status = LIBSPDM_STATUS_SUCCESS;
 
     /* -=[Log Message Phase]=- */
     #if LIBSPDM_ENABLE_MSG_LOG
@@ -200,6 +137,87 @@ static libspdm_return_t libspdm_try_get_version(libspdm_context_t *spdm_context,
     /*Set the role of device*/
     spdm_context->local_context.is_requester = true;
 
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * This function sends GET_VERSION and receives VERSION.
+ *
+ * @param  spdm_context         A pointer to the SPDM context.
+ * @param  version_count        The number of SPDM versions that the Responder supports.
+ * @param  VersionNumberEntries The list of SPDM versions that the Responder supports.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         GET_VERSION was sent and VERSION was received.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
+ *         The size of the VERSION response is invalid.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
+ *         The VERSION response contains one or more invalid fields.
+ * @retval LIBSPDM_STATUS_ERROR_PEER
+ *         The Responder returned an unexpected error.
+ * @retval LIBSPDM_STATUS_BUSY_PEER
+ *         The Responder continually returned Busy error messages.
+ * @retval LIBSPDM_STATUS_RESYNCH_PEER
+ *         The Responder returned a RequestResynch error message.
+ * @retval LIBSPDM_STATUS_NEGOTIATION_FAIL
+ *         The Requester and Responder do not support a common SPDM version.
+ **/
+static libspdm_return_t libspdm_try_get_version(libspdm_context_t *spdm_context,
+                                                uint8_t *version_number_entry_count,
+                                                spdm_version_number_t *version_number_entry)
+{
+    libspdm_return_t status;
+    spdm_get_version_request_t *spdm_request;
+    size_t spdm_request_size;
+    libspdm_version_response_max_t *spdm_response;
+    size_t spdm_response_size;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    libspdm_build_get_version_request(spdm_context, &spdm_request_size, spdm_request);
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
+                                           (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    status = libspdm_process_version_response(spdm_context,
+                                              version_number_entry_count, version_number_entry,
+                                              spdm_request, spdm_request_size,
+                                              spdm_response, spdm_response_size);
+
 receive_done:
     libspdm_release_receiver_buffer (spdm_context);
     return status;
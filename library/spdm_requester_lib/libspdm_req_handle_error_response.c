@@ -7,6 +7,52 @@
 #include "internal/libspdm_requester_lib.h"
 
 #if LIBSPDM_RESPOND_IF_READY_SUPPORT
+void libspdm_build_respond_if_ready_request(libspdm_context_t *spdm_context,
+                                            spdm_response_if_ready_request_t *spdm_request)
+{
+    spdm_context->crypto_request = true;
+    spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
+    spdm_request->header.request_response_code = SPDM_RESPOND_IF_READY;
+    spdm_request->header.param1 = spdm_context->error_data.request_code;
+    spdm_request->header.param2 = spdm_context->error_data.token;
+}
+
+libspdm_return_t libspdm_check_response_not_ready(libspdm_context_t *spdm_context,
+                                                  size_t response_size,
+                                                  const void *response,
+                                                  uint8_t original_request_code)
+{
+    const spdm_error_response_t *spdm_response;
+    const spdm_error_data_response_not_ready_t *extend_error_data;
+
+    if (response_size < sizeof(spdm_error_response_t) +
+        sizeof(spdm_error_data_response_not_ready_t)) {
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
+    }
+
+    spdm_response = response;
+    extend_error_data = (const spdm_error_data_response_not_ready_t *)(spdm_response + 1);
+    LIBSPDM_ASSERT(spdm_response->header.request_response_code == SPDM_ERROR);
+    LIBSPDM_ASSERT(spdm_response->header.param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+
+    if (extend_error_data->request_code != original_request_code) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+    if (extend_error_data->rd_tm <= 1) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+    if (extend_error_data->rd_exponent > LIBSPDM_MAX_RDT_EXPONENT) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+
+    spdm_context->error_data.rd_exponent = extend_error_data->rd_exponent;
+    spdm_context->error_data.request_code = extend_error_data->request_code;
+    spdm_context->error_data.token = extend_error_data->token;
+    spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
 /**
  * This function sends RESPOND_IF_READY and receives an expected SPDM response.
  *
@@ -50,11 +96,7 @@ static libspdm_return_t libspdm_requester_respond_if_ready(libspdm_context_t *sp
                         spdm_context->local_context.capability.transport_tail_size;
 
     LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_response_if_ready_request_t));
-    spdm_context->crypto_request = true;
-    spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
-    spdm_request->header.request_response_code = SPDM_RESPOND_IF_READY;
-    spdm_request->header.param1 = spdm_context->error_data.request_code;
-    spdm_request->header.param2 = spdm_context->error_data.token;
+    libspdm_build_respond_if_ready_request(spdm_context, spdm_request);
     spdm_request_size = sizeof(spdm_response_if_ready_request_t);
     status = libspdm_send_spdm_request(spdm_context, session_id, spdm_request_size, spdm_request);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
@@ -169,35 +211,15 @@ static libspdm_return_t libspdm_handle_response_not_ready(libspdm_context_t *spd
                                                           uint8_t original_request_code,
                                                           uint8_t expected_response_code)
 {
-    spdm_error_response_t *spdm_response;
-    spdm_error_data_response_not_ready_t *extend_error_data;
-
-    if (*response_size < sizeof(spdm_error_response_t) +
-        sizeof(spdm_error_data_response_not_ready_t)) {
-        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
-    }
-
-    spdm_response = *response;
-    extend_error_data = (spdm_error_data_response_not_ready_t *)(spdm_response + 1);
-    LIBSPDM_ASSERT(spdm_response->header.request_response_code == SPDM_ERROR);
-    LIBSPDM_ASSERT(spdm_response->header.param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+    libspdm_return_t status;
 
-    if (extend_error_data->request_code != original_request_code) {
-        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
-    }
-    if (extend_error_data->rd_tm <= 1) {
-        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
-    }
-    if (extend_error_data->rd_exponent > LIBSPDM_MAX_RDT_EXPONENT) {
-        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    status = libspdm_check_response_not_ready(spdm_context, *response_size, *response,
+                                              original_request_code);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
     }
 
-    spdm_context->error_data.rd_exponent = extend_error_data->rd_exponent;
-    spdm_context->error_data.request_code = extend_error_data->request_code;
-    spdm_context->error_data.token = extend_error_data->token;
-    spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
-
-    libspdm_sleep((uint64_t)1 << extend_error_data->rd_exponent);
+    libspdm_sleep((uint64_t)1 << spdm_context->error_data.rd_exponent);
 
     return libspdm_requester_respond_if_ready(spdm_context, session_id,
                                               response_size, response,
@@ -232,7 +254,6 @@ libspdm_return_t libspdm_handle_error_large_response(
     uint32_t chunk_seq_no;
     uint8_t* chunk_ptr;
     uint8_t* large_response;
-    size_t large_response_capacity;
     size_t large_response_size;
     size_t large_response_size_so_far;
     uint64_t max_chunk_data_transfer_size;
@@ -267,7 +288,6 @@ libspdm_return_t libspdm_handle_error_large_response(
     /* The first section of the scratch
      * buffer may be used for other purposes. Use only after that section. */
     large_response = scratch_buffer + libspdm_get_scratch_buffer_large_message_offset(spdm_context);
-    large_response_capacity = libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
 
     /* Temporary send/receive buffers for chunking are in the scratch space */
     message = scratch_buffer + libspdm_get_scratch_buffer_sender_receiver_offset(spdm_context);
@@ -280,7 +300,6 @@ libspdm_return_t libspdm_handle_error_large_response(
              - sizeof(spdm_chunk_response_response_t)) * 65536 - sizeof(uint32_t);
     }
 
-    libspdm_zero_mem(large_response, large_response_capacity);
     large_response_size = 0;
     large_response_size_so_far = 0;
     chunk_seq_no = 0;
@@ -326,7 +345,6 @@ libspdm_return_t libspdm_handle_error_large_response(
             break;
         }
 
-        libspdm_zero_mem(message, message_size);
         void* response = message;
         size_t response_size = message_size;
 
@@ -453,9 +471,10 @@ libspdm_return_t libspdm_handle_error_large_response(
             *inout_response_size = large_response_size;
 
             LIBSPDM_INTERNAL_DUMP_HEX(large_response, large_response_size);
-            libspdm_zero_mem(large_response, large_response_size);
         }
     }
+    /* Only the received chunks were written to the large response buffer. */
+    libspdm_zero_mem(large_response, large_response_size_so_far);
 
     return status;
 }
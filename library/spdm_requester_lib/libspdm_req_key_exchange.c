@@ -279,62 +279,25 @@ bool libspdm_verify_key_exchange_rsp_signature(
     return true;
 }
 
-/**
- * This function sends KEY_EXCHANGE and receives KEY_EXCHANGE_RSP for SPDM key exchange.
- *
- * @param  spdm_context           A pointer to the SPDM context.
- * @param  measurement_hash_type  Measurement_hash_type to the KEY_EXCHANGE request.
- * @param  slot_id                slot_id to the KEY_EXCHANGE request.
- * @param  session_policy         The policy for the session.
- * @param  session_id             session_id from the KEY_EXCHANGE_RSP response.
- * @param  heartbeat_period       Heartbeat_period from the KEY_EXCHANGE_RSP response.
- * @param  req_slot_id_param      req_slot_id_param from the KEY_EXCHANGE_RSP response.
- * @param  measurement_hash       Measurement_hash from the KEY_EXCHANGE_RSP response.
- * @param  requester_nonce_in     If not NULL, a buffer that holds the requester nonce (32 bytes)
- * @param  requester_nonce        If not NULL, a buffer to hold the requester nonce (32 bytes).
- * @param  responder_nonce        If not NULL, a buffer to hold the responder nonce (32 bytes).
- **/
-static libspdm_return_t libspdm_try_send_receive_key_exchange(
+libspdm_return_t libspdm_build_key_exchange_request(
     libspdm_context_t *spdm_context, uint8_t measurement_hash_type,
-    uint8_t slot_id, uint8_t session_policy, uint32_t *session_id,
-    uint8_t *heartbeat_period,
-    uint8_t *req_slot_id_param, void *measurement_hash,
-    const void *requester_random_in,
-    void *requester_random, void *responder_random,
+    uint8_t slot_id, uint8_t session_policy,
+    const void *requester_random_in, void *requester_random,
     const void *requester_opaque_data, size_t requester_opaque_data_size,
-    void *responder_opaque_data, size_t *responder_opaque_data_size)
+    libspdm_key_exchange_state_t *state, size_t *spdm_request_size, void *request)
 {
     bool result;
-    libspdm_return_t status;
     libspdm_key_exchange_request_mine_t *spdm_request;
-    size_t spdm_request_size;
-    libspdm_key_exchange_response_max_t *spdm_response;
-    size_t spdm_response_size;
     size_t dhe_key_size;
     size_t kem_encap_key_size;
-    size_t kem_cipher_text_size;
     size_t req_key_exchange_size;
-    size_t rsp_key_exchange_size;
-    uint32_t measurement_summary_hash_size;
-    uint32_t signature_size;
-    uint32_t hmac_size;
     uint8_t *ptr;
-    void *measurement_summary_hash;
-    uint16_t opaque_length;
-    uint8_t *signature;
-    uint8_t *verify_data;
     void *dhe_context;
     void *kem_context;
     uint16_t req_session_id;
-    uint16_t rsp_session_id;
-    libspdm_session_info_t *session_info;
     size_t opaque_key_exchange_req_size;
-    uint8_t th1_hash_data[LIBSPDM_MAX_HASH_SIZE];
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
-    uint8_t mut_auth_requested;
-    spdm_version_number_t secured_message_version;
+
+    spdm_request = request;
 
     /* -=[Check Parameters Phase]=- */
     LIBSPDM_ASSERT((slot_id < SPDM_MAX_SLOT_COUNT) || (slot_id == 0xff));
@@ -390,25 +353,13 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     libspdm_reset_message_buffer_via_request_code(spdm_context, NULL, SPDM_KEY_EXCHANGE);
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_key_exchange_request_t));
+    LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_key_exchange_request_t));
     spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
     spdm_request->header.request_response_code = SPDM_KEY_EXCHANGE;
     spdm_request->header.param1 = measurement_hash_type;
     spdm_request->header.param2 = slot_id;
     if (requester_random_in == NULL) {
         if (!libspdm_get_random_number(SPDM_RANDOM_DATA_SIZE, spdm_request->random_data)) {
-            libspdm_release_sender_buffer (spdm_context);
             return LIBSPDM_STATUS_LOW_ENTROPY;
         }
     } else {
@@ -438,31 +389,27 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     if (spdm_context->connection_info.algorithm.kem_alg != 0) {
         kem_encap_key_size = libspdm_get_kem_encap_key_size(
             spdm_context->connection_info.algorithm.kem_alg);
-        kem_cipher_text_size = libspdm_get_kem_cipher_text_size(
-            spdm_context->connection_info.algorithm.kem_alg);
         kem_context = libspdm_secured_message_kem_new(
             spdm_context->connection_info.version,
             spdm_context->connection_info.algorithm.kem_alg, true);
         if (kem_context == NULL) {
-            libspdm_release_sender_buffer (spdm_context);
             return LIBSPDM_STATUS_CRYPTO_ERROR;
         }
 
-        LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_key_exchange_request_t) + kem_encap_key_size);
+        LIBSPDM_ASSERT (*spdm_request_size >=
+                        sizeof(spdm_key_exchange_request_t) + kem_encap_key_size);
         result = libspdm_secured_message_kem_generate_key(
             spdm_context->connection_info.algorithm.kem_alg,
             kem_context, ptr, &kem_encap_key_size);
         if (!result) {
             libspdm_secured_message_kem_free(
                 spdm_context->connection_info.algorithm.kem_alg, kem_context);
-            libspdm_release_sender_buffer (spdm_context);
             return LIBSPDM_STATUS_CRYPTO_ERROR;
         }
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "RequesterKey (0x%zx):\n", kem_encap_key_size));
         LIBSPDM_INTERNAL_DUMP_HEX(ptr, kem_encap_key_size);
         ptr += kem_encap_key_size;
         req_key_exchange_size = kem_encap_key_size;
-        rsp_key_exchange_size = kem_cipher_text_size;
     } else {
         dhe_key_size = libspdm_get_dhe_pub_key_size(
             spdm_context->connection_info.algorithm.dhe_named_group);
@@ -470,31 +417,29 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
             spdm_context->connection_info.version,
             spdm_context->connection_info.algorithm.dhe_named_group, true);
         if (dhe_context == NULL) {
-            libspdm_release_sender_buffer (spdm_context);
             return LIBSPDM_STATUS_CRYPTO_ERROR;
         }
 
-        LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_key_exchange_request_t) + dhe_key_size);
+        LIBSPDM_ASSERT (*spdm_request_size >=
+                        sizeof(spdm_key_exchange_request_t) + dhe_key_size);
         result = libspdm_secured_message_dhe_generate_key(
             spdm_context->connection_info.algorithm.dhe_named_group,
             dhe_context, ptr, &dhe_key_size);
         if (!result) {
             libspdm_secured_message_dhe_free(
                 spdm_context->connection_info.algorithm.dhe_named_group, dhe_context);
-            libspdm_release_sender_buffer (spdm_context);
             return LIBSPDM_STATUS_CRYPTO_ERROR;
         }
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "RequesterKey (0x%zx):\n", dhe_key_size));
         LIBSPDM_INTERNAL_DUMP_HEX(ptr, dhe_key_size);
         ptr += dhe_key_size;
         req_key_exchange_size = dhe_key_size;
-        rsp_key_exchange_size = dhe_key_size;
     }
 
     if (requester_opaque_data != NULL) {
         LIBSPDM_ASSERT(requester_opaque_data_size <= SPDM_MAX_OPAQUE_DATA_SIZE);
 
-        LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_key_exchange_request_t) +
+        LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_key_exchange_request_t) +
                         req_key_exchange_size +
                         sizeof(uint16_t) + requester_opaque_data_size);
 
@@ -502,14 +447,14 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
         ptr += sizeof(uint16_t);
 
         libspdm_copy_mem(ptr,
-                         (spdm_request_size - (sizeof(spdm_key_exchange_request_t) +
-                                               req_key_exchange_size)),
+                         (*spdm_request_size - (sizeof(spdm_key_exchange_request_t) +
+                                                req_key_exchange_size)),
                          requester_opaque_data, requester_opaque_data_size);
         opaque_key_exchange_req_size = requester_opaque_data_size;
     } else {
         opaque_key_exchange_req_size =
             libspdm_get_opaque_data_supported_version_data_size(spdm_context);
-        LIBSPDM_ASSERT (spdm_request_size >= sizeof(spdm_key_exchange_request_t) +
+        LIBSPDM_ASSERT (*spdm_request_size >= sizeof(spdm_key_exchange_request_t) +
                         req_key_exchange_size +
                         sizeof(uint16_t) + opaque_key_exchange_req_size);
 
@@ -521,56 +466,53 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     }
     ptr += opaque_key_exchange_req_size;
 
-    spdm_request_size = (size_t)ptr - (size_t)spdm_request;
+    *spdm_request_size = (size_t)ptr - (size_t)spdm_request;
 
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        goto free_exchange;
-    }
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
+    state->dhe_context = dhe_context;
+    state->kem_context = kem_context;
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto free_exchange;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-    status = libspdm_receive_spdm_response(
-        spdm_context, NULL, &spdm_response_size, (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
-    }
+libspdm_return_t libspdm_process_key_exchange_response(
+    libspdm_context_t *spdm_context, uint8_t measurement_hash_type,
+    uint8_t slot_id, uint8_t session_policy, uint32_t *session_id,
+    uint8_t *heartbeat_period, uint8_t *req_slot_id_param, void *measurement_hash,
+    void *responder_random, void *responder_opaque_data, size_t *responder_opaque_data_size,
+    libspdm_key_exchange_state_t *state, const void *request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size)
+{
+    bool result;
+    libspdm_return_t status;
+    const libspdm_key_exchange_request_mine_t *spdm_request;
+    libspdm_key_exchange_response_max_t *spdm_response;
+    size_t rsp_key_exchange_size;
+    uint32_t measurement_summary_hash_size;
+    uint32_t signature_size;
+    uint32_t hmac_size;
+    uint8_t *ptr;
+    void *measurement_summary_hash;
+    uint16_t opaque_length;
+    uint8_t *signature;
+    uint8_t *verify_data;
+    uint16_t rsp_session_id;
+    libspdm_session_info_t *session_info;
+    uint8_t th1_hash_data[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t mut_auth_requested;
+    spdm_version_number_t secured_message_version;
+
+    spdm_request = request;
+    spdm_response = response;
 
     /* -=[Validate Response Phase]=- */
-    if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
-    }
-    if (spdm_response->header.request_response_code == SPDM_ERROR) {
-        status = libspdm_handle_error_response_main(
-            spdm_context, NULL, &spdm_response_size,
-            (void **)&spdm_response, SPDM_KEY_EXCHANGE,
-            SPDM_KEY_EXCHANGE_RSP);
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
-        }
-    } else if (spdm_response->header.request_response_code != SPDM_KEY_EXCHANGE_RSP) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+    if (spdm_response->header.request_response_code != SPDM_KEY_EXCHANGE_RSP) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size < sizeof(spdm_key_exchange_response_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
 
     if (!libspdm_is_capabilities_flag_supported(
@@ -578,8 +520,7 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
             SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP,
             SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP)) {
         if (spdm_response->header.param1 != 0) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
     if (heartbeat_period != NULL) {
@@ -604,16 +545,14 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
             0);
 
         if (!mut_auth_cap_both) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         if ((mut_auth_requested != SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED) &&
             (mut_auth_requested !=
              SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED_WITH_ENCAP_REQUEST) &&
             (mut_auth_requested !=
              SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED_WITH_GET_DIGESTS)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
 
         if (mut_auth_requested == SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED) {
@@ -622,16 +561,14 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
 
             if ((cert_cap && (*req_slot_id_param >= SPDM_MAX_SLOT_COUNT)) ||
                 (pub_key_id_cap && (*req_slot_id_param != 0xf))) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if ((spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_13) &&
                 spdm_context->connection_info.multi_key_conn_req &&
                 (*req_slot_id_param != 0xf)) {
                 if ((spdm_context->local_context.local_key_usage_bit_mask[*req_slot_id_param] &
                      SPDM_KEY_USAGE_BIT_MASK_KEY_EX_USE) == 0) {
-                    status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                    goto receive_done;
+                    return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                 }
             }
         } else {
@@ -639,17 +576,22 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
 
             /* If Responder has Requester's public key then it cannot use the encapsulated flow. */
             if (pub_key_id_cap) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             /* Encapsulated flow requires support for encapsulated messages by both endpoints. */
             if (!libspdm_is_encap_supported(spdm_context)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
         }
     }
 
+    if (spdm_context->connection_info.algorithm.kem_alg != 0) {
+        rsp_key_exchange_size = libspdm_get_kem_cipher_text_size(
+            spdm_context->connection_info.algorithm.kem_alg);
+    } else {
+        rsp_key_exchange_size = libspdm_get_dhe_pub_key_size(
+            spdm_context->connection_info.algorithm.dhe_named_group);
+    }
     if (spdm_context->connection_info.algorithm.pqc_asym_algo != 0) {
         signature_size = libspdm_get_pqc_asym_signature_size(
             spdm_context->connection_info.algorithm.pqc_asym_algo);
@@ -671,8 +613,7 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     if (spdm_response_size <
         sizeof(spdm_key_exchange_response_t) + rsp_key_exchange_size +
         measurement_summary_hash_size + sizeof(uint16_t) + signature_size + hmac_size) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "ResponderRandomData (0x%x) - ", SPDM_RANDOM_DATA_SIZE));
@@ -699,35 +640,30 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
 
     opaque_length = libspdm_read_uint16((const uint8_t *)ptr);
     if (opaque_length > SPDM_MAX_OPAQUE_DATA_SIZE) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     ptr += sizeof(uint16_t);
     if (spdm_response_size <
         sizeof(spdm_key_exchange_response_t) + rsp_key_exchange_size +
         measurement_summary_hash_size + sizeof(uint16_t) +
         opaque_length + signature_size + hmac_size) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     if (opaque_length != 0) {
         result = libspdm_process_general_opaque_data_check(spdm_context, opaque_length, ptr);
         if (!result) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         status = libspdm_process_opaque_data_version_selection_data(
             spdm_context, opaque_length, ptr, &secured_message_version);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
 
     if ((responder_opaque_data != NULL) && (responder_opaque_data_size != NULL)) {
         if (opaque_length >= *responder_opaque_data_size) {
-            status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            goto receive_done;
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
         libspdm_copy_mem(responder_opaque_data, *responder_opaque_data_size, ptr, opaque_length);
         *responder_opaque_data_size = opaque_length;
@@ -740,12 +676,11 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
                          sizeof(uint16_t) + opaque_length + signature_size + hmac_size;
 
     rsp_session_id = spdm_response->rsp_session_id;
-    *session_id = libspdm_generate_session_id(req_session_id, rsp_session_id);
+    *session_id = libspdm_generate_session_id(spdm_request->req_session_id, rsp_session_id);
     session_info = libspdm_assign_session_id(spdm_context, *session_id, secured_message_version,
                                              false);
     if (session_info == NULL) {
-        status = LIBSPDM_STATUS_SESSION_NUMBER_EXCEED;
-        goto receive_done;
+        return LIBSPDM_STATUS_SESSION_NUMBER_EXCEED;
     }
     session_info->peer_used_cert_chain_slot_id = slot_id;
 
@@ -754,14 +689,14 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
                                       spdm_request_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         libspdm_free_session_id(spdm_context, *session_id);
-        goto receive_done;
+        return status;
     }
 
     status = libspdm_append_message_k(spdm_context, session_info, true, spdm_response,
                                       spdm_response_size - signature_size - hmac_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         libspdm_free_session_id(spdm_context, *session_id);
-        goto receive_done;
+        return status;
     }
 
     signature = ptr;
@@ -772,37 +707,35 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
         spdm_context, session_info, signature, signature_size);
     if (!result) {
         libspdm_free_session_id(spdm_context, *session_id);
-        status = LIBSPDM_STATUS_VERIF_FAIL;
-        goto receive_done;
+        return LIBSPDM_STATUS_VERIF_FAIL;
     }
 
     status = libspdm_append_message_k(spdm_context, session_info, true, signature, signature_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         libspdm_free_session_id(spdm_context, *session_id);
-        goto receive_done;
+        return status;
     }
 
     if (spdm_context->connection_info.algorithm.kem_alg != 0) {
         result = libspdm_secured_message_kem_decapsulate(
             spdm_context->connection_info.algorithm.kem_alg,
-            kem_context, spdm_response->exchange_data, kem_cipher_text_size,
+            state->kem_context, spdm_response->exchange_data, rsp_key_exchange_size,
             session_info->secured_message_context);
         libspdm_secured_message_kem_free(
-            spdm_context->connection_info.algorithm.kem_alg, kem_context);
-        kem_context = NULL;
+            spdm_context->connection_info.algorithm.kem_alg, state->kem_context);
+        state->kem_context = NULL;
     } else {
         result = libspdm_secured_message_dhe_compute_key(
             spdm_context->connection_info.algorithm.dhe_named_group,
-            dhe_context, spdm_response->exchange_data, dhe_key_size,
+            state->dhe_context, spdm_response->exchange_data, rsp_key_exchange_size,
             session_info->secured_message_context);
         libspdm_secured_message_dhe_free(
-            spdm_context->connection_info.algorithm.dhe_named_group, dhe_context);
-        dhe_context = NULL;
+            spdm_context->connection_info.algorithm.dhe_named_group, state->dhe_context);
+        state->dhe_context = NULL;
     }
     if (!result) {
         libspdm_free_session_id(spdm_context, *session_id);
-        status = LIBSPDM_STATUS_CRYPTO_ERROR;
-        goto receive_done;
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_handshake_key[%x]\n",
@@ -810,15 +743,13 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     result = libspdm_calculate_th1_hash(spdm_context, session_info, true, th1_hash_data);
     if (!result) {
         libspdm_free_session_id(spdm_context, *session_id);
-        status = LIBSPDM_STATUS_CRYPTO_ERROR;
-        goto receive_done;
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
     }
     result = libspdm_generate_session_handshake_key(
         session_info->secured_message_context, th1_hash_data);
     if (!result) {
         libspdm_free_session_id(spdm_context, *session_id);
-        status = LIBSPDM_STATUS_CRYPTO_ERROR;
-        goto receive_done;
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
     }
 
     if (!libspdm_is_capabilities_flag_supported(
@@ -832,15 +763,14 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
             spdm_context, session_info, verify_data, hmac_size);
         if (!result) {
             libspdm_free_session_id(spdm_context, *session_id);
-            status = LIBSPDM_STATUS_VERIF_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_VERIF_FAIL;
         }
         ptr += hmac_size;
 
         status = libspdm_append_message_k(spdm_context, session_info, true, verify_data, hmac_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
             libspdm_free_session_id(spdm_context, *session_id);
-            goto receive_done;
+            return status;
         }
     }
 
@@ -861,19 +791,133 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     libspdm_append_msg_log(spdm_context, spdm_response, spdm_response_size);
     #endif /* LIBSPDM_ENABLE_MSG_LOG */
 
-    status = LIBSPDM_STATUS_SUCCESS;
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-receive_done:
-    libspdm_release_receiver_buffer (spdm_context);
-free_exchange:
-    if (dhe_context != NULL) {
+void libspdm_free_key_exchange_state(libspdm_context_t *spdm_context,
+                                     libspdm_key_exchange_state_t *state)
+{
+    if (state->dhe_context != NULL) {
         libspdm_secured_message_dhe_free(
-            spdm_context->connection_info.algorithm.dhe_named_group, dhe_context);
+            spdm_context->connection_info.algorithm.dhe_named_group, state->dhe_context);
+        state->dhe_context = NULL;
     }
-    if (kem_context != NULL) {
+    if (state->kem_context != NULL) {
         libspdm_secured_message_kem_free(
-            spdm_context->connection_info.algorithm.kem_alg, kem_context);
+            spdm_context->connection_info.algorithm.kem_alg, state->kem_context);
+        state->kem_context = NULL;
+    }
+}
+
+/**
+ * This function sends KEY_EXCHANGE and receives KEY_EXCHANGE_RSP for SPDM key exchange.
+ *
+ * @param  spdm_context           A pointer to the SPDM context.
+ * @param  measurement_hash_type  Measurement_hash_type to the KEY_EXCHANGE request.
+ * @param  slot_id                slot_id to the KEY_EXCHANGE request.
+ * @param  session_policy         The policy for the session.
+ * @param  session_id             session_id from the KEY_EXCHANGE_RSP response.
+ * @param  heartbeat_period       Heartbeat_period from the KEY_EXCHANGE_RSP response.
+ * @param  req_slot_id_param      req_slot_id_param from the KEY_EXCHANGE_RSP response.
+ * @param  measurement_hash       Measurement_hash from the KEY_EXCHANGE_RSP response.
+ * @param  requester_nonce_in     If not NULL, a buffer that holds the requester nonce (32 bytes)
+ * @param  requester_nonce        If not NULL, a buffer to hold the requester nonce (32 bytes).
+ * @param  responder_nonce        If not NULL, a buffer to hold the responder nonce (32 bytes).
+ **/
+static libspdm_return_t libspdm_try_send_receive_key_exchange(
+    libspdm_context_t *spdm_context, uint8_t measurement_hash_type,
+    uint8_t slot_id, uint8_t session_policy, uint32_t *session_id,
+    uint8_t *heartbeat_period,
+    uint8_t *req_slot_id_param, void *measurement_hash,
+    const void *requester_random_in,
+    void *requester_random, void *responder_random,
+    const void *requester_opaque_data, size_t requester_opaque_data_size,
+    void *responder_opaque_data, size_t *responder_opaque_data_size)
+{
+    libspdm_return_t status;
+    libspdm_key_exchange_request_mine_t *spdm_request;
+    size_t spdm_request_size;
+    libspdm_key_exchange_response_max_t *spdm_response;
+    size_t spdm_response_size;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+    libspdm_key_exchange_state_t state;
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    status = libspdm_build_key_exchange_request(spdm_context, measurement_hash_type, slot_id,
+                                                session_policy, requester_random_in,
+                                                requester_random, requester_opaque_data,
+                                                requester_opaque_data_size, &state,
+                                                &spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
     }
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        goto free_exchange;
+    }
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto free_exchange;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(
+        spdm_context, NULL, &spdm_response_size, (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    /* -=[Validate Response Phase]=- */
+    if (spdm_response_size < sizeof(spdm_message_header_t)) {
+        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
+        goto receive_done;
+    }
+    if (spdm_response->header.request_response_code == SPDM_ERROR) {
+        status = libspdm_handle_error_response_main(
+            spdm_context, NULL, &spdm_response_size,
+            (void **)&spdm_response, SPDM_KEY_EXCHANGE,
+            SPDM_KEY_EXCHANGE_RSP);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            goto receive_done;
+        }
+    } else if (spdm_response->header.request_response_code != SPDM_KEY_EXCHANGE_RSP) {
+        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        goto receive_done;
+    }
+
+    status = libspdm_process_key_exchange_response(
+        spdm_context, measurement_hash_type, slot_id, session_policy, session_id,
+        heartbeat_period, req_slot_id_param, measurement_hash, responder_random,
+        responder_opaque_data, responder_opaque_data_size, &state,
+        spdm_request, spdm_request_size, spdm_response, spdm_response_size);
+
+receive_done:
+    libspdm_release_receiver_buffer (spdm_context);
+free_exchange:
+    libspdm_free_key_exchange_state(spdm_context, &state);
     return status;
 }
 
@@ -45,50 +45,15 @@ typedef struct {
 } libspdm_algorithms_response_max_t;
 #pragma pack()
 
-/**
- * This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
- *
- * @param  spdm_context A pointer to the SPDM context.
- *
- * @retval LIBSPDM_STATUS_SUCCESS
- *         NEGOTIATE_ALGORITHMS was sent and ALGORITHMS was received.
- * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
- *         Cannot send NEGOTIATE_ALGORITHMS due to Requester's state.
- * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
- *         The size of the ALGORITHMS response is invalid.
- * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
- *         The ALGORITHMS response contains one or more invalid fields.
- * @retval LIBSPDM_STATUS_ERROR_PEER
- *         The Responder returned an unexpected error.
- * @retval LIBSPDM_STATUS_BUSY_PEER
- *         The Responder continually returned Busy error messages.
- * @retval LIBSPDM_STATUS_RESYNCH_PEER
- *         The Responder returned a RequestResynch error message.
- * @retval LIBSPDM_STATUS_BUFFER_FULL
- *         The buffer used to store transcripts is exhausted.
- * @retval LIBSPDM_STATUS_NEGOTIATION_FAIL
- *         The Requester and Responder could not agree on mutual algorithms.
- *         Note: This return value may be removed in the future.
- **/
-static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm_context)
+libspdm_return_t libspdm_build_negotiate_algorithms_request(
+    libspdm_context_t *spdm_context, size_t *spdm_request_size, void *request)
 {
-    libspdm_return_t status;
     libspdm_negotiate_algorithms_request_mine_t *spdm_request;
-    size_t spdm_request_size;
-    libspdm_algorithms_response_max_t *spdm_response;
-    size_t spdm_response_size;
-    uint32_t algo_size;
-    uint32_t pqc_algo_size;
     size_t index = 0;
-    spdm_negotiate_algorithms_common_struct_table_t *struct_table;
-    uint8_t fixed_alg_size;
-    uint8_t ext_alg_count;
-    uint8_t *message;
-    size_t message_size;
-    size_t transport_header_size;
-    uint8_t alg_type_pre;
     uint8_t req_param1 = 0;
 
+    spdm_request = request;
+
     /* -=[Verify State Phase]=- */
     if (spdm_context->connection_info.connection_state !=
         LIBSPDM_CONNECTION_STATE_AFTER_CAPABILITIES) {
@@ -98,19 +63,8 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
     libspdm_reset_message_buffer_via_request_code(spdm_context, NULL, SPDM_NEGOTIATE_ALGORITHMS);
 
     /* -=[Construct Request Phase]=- */
-    transport_header_size = spdm_context->local_context.capability.transport_header_size;
-    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size +
-                    spdm_context->local_context.capability.transport_tail_size);
-    spdm_request = (void *)(message + transport_header_size);
-    spdm_request_size = message_size - transport_header_size -
-                        spdm_context->local_context.capability.transport_tail_size;
-
-    LIBSPDM_ASSERT(spdm_request_size >= sizeof(spdm_negotiate_algorithms_request_t));
-    libspdm_zero_mem(spdm_request, spdm_request_size);
+    LIBSPDM_ASSERT(*spdm_request_size >= sizeof(spdm_negotiate_algorithms_request_t));
+    libspdm_zero_mem(spdm_request, *spdm_request_size);
     spdm_request->header.spdm_version = libspdm_get_connection_version (spdm_context);
     if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_11) {
         /* Number of Algorithms Structure Tables based on supported algorithms */
@@ -147,7 +101,7 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
         spdm_request->header.param1 = 0;
     }
 
-    LIBSPDM_ASSERT(spdm_request_size >= spdm_request->length);
+    LIBSPDM_ASSERT(*spdm_request_size >= spdm_request->length);
     spdm_request->header.request_response_code = SPDM_NEGOTIATE_ALGORITHMS;
     spdm_request->header.param2 = 0;
     spdm_request->measurement_specification =
@@ -256,98 +210,83 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
         }
         LIBSPDM_ASSERT(index == spdm_request->header.param1);
     }
-    spdm_request_size = spdm_request->length;
+    *spdm_request_size = spdm_request->length;
 
-    /* -=[Send Request Phase]=- */
-    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_release_sender_buffer (spdm_context);
-        return status;
-    }
-    libspdm_release_sender_buffer (spdm_context);
-    spdm_request = (void *)spdm_context->last_spdm_request;
 
-    /* -=[Receive Response Phase]=- */
-    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return status;
-    }
-    LIBSPDM_ASSERT (message_size >= transport_header_size);
-    spdm_response = (void *)(message);
-    spdm_response_size = message_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
 
-    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
-                                           (void **)&spdm_response);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
-    }
+libspdm_return_t libspdm_process_algorithms_response(
+    libspdm_context_t *spdm_context, const void *request, size_t spdm_request_size,
+    void *response, size_t spdm_response_size)
+{
+    libspdm_return_t status;
+    const libspdm_negotiate_algorithms_request_mine_t *spdm_request;
+    libspdm_algorithms_response_max_t *spdm_response;
+    uint32_t algo_size;
+    uint32_t pqc_algo_size;
+    size_t index;
+    spdm_negotiate_algorithms_common_struct_table_t *struct_table;
+    uint8_t fixed_alg_size;
+    uint8_t ext_alg_count;
+    uint8_t alg_type_pre;
+
+    spdm_request = request;
+    spdm_response = response;
 
     /* -=[Validate Response Phase]=- */
     if (spdm_response_size < sizeof(spdm_message_header_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     if (spdm_response->header.request_response_code == SPDM_ERROR) {
         status = libspdm_handle_simple_error_response(spdm_context, spdm_response->header.param1);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            goto receive_done;
+            return status;
         }
     } else if (spdm_response->header.request_response_code != SPDM_ALGORITHMS) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size < sizeof(spdm_algorithms_response_t)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     if (!libspdm_onehot0(spdm_response->measurement_specification_sel)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
         if (!libspdm_onehot0(spdm_response->other_params_selection &
                              SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_MASK)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
     if (!libspdm_onehot0(spdm_response->measurement_hash_algo)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (!libspdm_onehot0(spdm_response->base_asym_sel)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (!libspdm_onehot0(spdm_response->base_hash_sel)) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_14) {
         if (!libspdm_onehot0(spdm_response->pqc_asym_sel)) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
     if (spdm_response->ext_asym_sel_count > 0) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response->ext_hash_sel_count > 0) {
-        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
     }
     if (spdm_response_size <
         sizeof(spdm_algorithms_response_t) +
         sizeof(uint32_t) * spdm_response->ext_asym_sel_count +
         sizeof(uint32_t) * spdm_response->ext_hash_sel_count +
         sizeof(spdm_negotiate_algorithms_common_struct_table_t) * spdm_response->header.param1) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
     struct_table =
         (void *)((size_t)spdm_response +
@@ -359,51 +298,42 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
         /* header.param1 is implicitly checked through spdm_response_size. */
         for (index = 0; index < spdm_response->header.param1; index++) {
             if ((size_t)spdm_response + spdm_response_size < (size_t)struct_table) {
-                status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_SIZE;
             }
             if ((size_t)spdm_response + spdm_response_size - (size_t)struct_table <
                 sizeof(spdm_negotiate_algorithms_common_struct_table_t)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_SIZE;
             }
             if ((struct_table->alg_type < SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_DHE) ||
                 (struct_table->alg_type >
                  SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_KEM_ALG)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if ((spdm_response->header.spdm_version < SPDM_MESSAGE_VERSION_14) &&
                 (struct_table->alg_type >
                  SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_KEY_SCHEDULE)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             /* AlgType shall monotonically increase for subsequent entries. */
             if ((index != 0) && (struct_table->alg_type <= alg_type_pre)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             alg_type_pre = struct_table->alg_type;
             fixed_alg_size = (struct_table->alg_count >> 4) & 0xF;
             ext_alg_count = struct_table->alg_count & 0xF;
             if (fixed_alg_size != 2) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if (ext_alg_count > 0) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if (!libspdm_onehot0(struct_table->alg_supported)) {
-                status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_FIELD;
             }
             if ((size_t)spdm_response + spdm_response_size -
                 (size_t)struct_table - sizeof(spdm_negotiate_algorithms_common_struct_table_t) <
                 sizeof(uint32_t) * ext_alg_count) {
-                status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-                goto receive_done;
+                return LIBSPDM_STATUS_INVALID_MSG_SIZE;
             }
             struct_table =
                 (void *)((size_t)struct_table +
@@ -414,19 +344,18 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
 
     spdm_response_size = (size_t)struct_table - (size_t)spdm_response;
     if (spdm_response_size != spdm_response->length) {
-        status = LIBSPDM_STATUS_INVALID_MSG_SIZE;
-        goto receive_done;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
     }
 
     /* -=[Process Response Phase]=- */
     status = libspdm_append_message_a(spdm_context, spdm_request, spdm_request_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+        return status;
     }
 
     status = libspdm_append_message_a(spdm_context, spdm_response, spdm_response_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        goto receive_done;
+        return status;
     }
 
     spdm_context->connection_info.algorithm.measurement_spec =
@@ -455,19 +384,16 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
         (spdm_request->measurement_specification != 0)) {
         if (spdm_context->connection_info.algorithm.measurement_spec !=
             SPDM_MEASUREMENT_SPECIFICATION_DMTF) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
         algo_size = libspdm_get_measurement_hash_size(
             spdm_context->connection_info.algorithm.measurement_hash_algo);
         if (algo_size == 0) {
-            status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_NEGOTIATION_FAIL;
         }
     } else {
         if (spdm_context->connection_info.algorithm.measurement_spec != 0) {
-            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-            goto receive_done;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
         }
     }
 
@@ -490,13 +416,11 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
             SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP)) {
         algo_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
         if (algo_size == 0) {
-            status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_NEGOTIATION_FAIL;
         }
         if ((spdm_context->connection_info.algorithm.base_hash_algo &
              spdm_context->local_context.algorithm.base_hash_algo) == 0) {
-            status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_NEGOTIATION_FAIL;
         }
     }
 
@@ -523,20 +447,17 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
         }
         if (((algo_size == 0) && (pqc_algo_size == 0)) ||
             ((algo_size != 0) && (pqc_algo_size != 0))) {
-            status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_NEGOTIATION_FAIL;
         }
         if ((algo_size != 0) &&
             ((spdm_context->connection_info.algorithm.base_asym_algo &
               spdm_context->local_context.algorithm.base_asym_algo) == 0)) {
-            status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_NEGOTIATION_FAIL;
         }
         if ((pqc_algo_size != 0) &&
             ((spdm_context->connection_info.algorithm.pqc_asym_algo &
               spdm_context->local_context.algorithm.pqc_asym_algo) == 0)) {
-            status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-            goto receive_done;
+            return LIBSPDM_STATUS_NEGOTIATION_FAIL;
         }
     }
 
@@ -594,20 +515,17 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
             }
             if (((algo_size == 0) && (pqc_algo_size == 0)) ||
                 ((algo_size != 0) && (pqc_algo_size != 0))) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
             if ((algo_size != 0) &&
                 ((spdm_context->connection_info.algorithm.dhe_named_group &
                   spdm_context->local_context.algorithm.dhe_named_group) == 0)) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
             if ((pqc_algo_size != 0) &&
                 ((spdm_context->connection_info.algorithm.kem_alg &
                   spdm_context->local_context.algorithm.kem_alg) == 0)) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
         }
         if (libspdm_is_capabilities_flag_supported(
@@ -621,13 +539,11 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
             algo_size = libspdm_get_aead_key_size(
                 spdm_context->connection_info.algorithm.aead_cipher_suite);
             if (algo_size == 0) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
             if ((spdm_context->connection_info.algorithm.aead_cipher_suite &
                  spdm_context->local_context.algorithm.aead_cipher_suite) == 0) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
         }
         if (libspdm_is_capabilities_flag_supported(
@@ -644,20 +560,17 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
             }
             if (((algo_size == 0) && (pqc_algo_size == 0)) ||
                 ((algo_size != 0) && (pqc_algo_size != 0))) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
             if ((algo_size != 0) &&
                 ((spdm_context->connection_info.algorithm.req_base_asym_alg &
                   spdm_context->local_context.algorithm.req_base_asym_alg) == 0)) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
             if ((pqc_algo_size != 0) &&
                 ((spdm_context->connection_info.algorithm.req_pqc_asym_alg &
                   spdm_context->local_context.algorithm.req_pqc_asym_alg) == 0)) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
         }
         if (libspdm_is_capabilities_flag_supported(
@@ -670,13 +583,11 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP)) {
             if (spdm_context->connection_info.algorithm.key_schedule !=
                 SPDM_ALGORITHMS_KEY_SCHEDULE_SPDM) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
             if ((spdm_context->connection_info.algorithm.key_schedule &
                  spdm_context->local_context.algorithm.key_schedule) == 0) {
-                status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                goto receive_done;
+                return LIBSPDM_STATUS_NEGOTIATION_FAIL;
             }
             if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_13) {
                 if (libspdm_is_capabilities_flag_supported(
@@ -685,13 +596,11 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
                     (spdm_request->mel_specification != 0)) {
                     if (spdm_context->connection_info.algorithm.mel_spec !=
                         SPDM_MEL_SPECIFICATION_DMTF) {
-                        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                        goto receive_done;
+                        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                     }
                 } else {
                     if (spdm_context->connection_info.algorithm.mel_spec != 0) {
-                        status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
-                        goto receive_done;
+                        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
                     }
                 }
             }
@@ -703,15 +612,13 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
                 if ((spdm_context->local_context.capability.flags &
                      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MULTI_KEY_CAP) ==
                     SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MULTI_KEY_CAP_ONLY) {
-                    status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                    goto receive_done;
+                    return LIBSPDM_STATUS_NEGOTIATION_FAIL;
                 }
                 spdm_context->connection_info.multi_key_conn_req = false;
             } else {
                 if ((spdm_context->local_context.capability.flags &
                      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MULTI_KEY_CAP) == 0) {
-                    status = LIBSPDM_STATUS_NEGOTIATION_FAIL;
-                    goto receive_done;
+                    return LIBSPDM_STATUS_NEGOTIATION_FAIL;
                 }
                 spdm_context->connection_info.multi_key_conn_req = true;
             }
@@ -751,7 +658,90 @@ static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm
     libspdm_append_msg_log(spdm_context, spdm_response, spdm_response_size);
     #endif /* LIBSPDM_ENABLE_MSG_LOG */
 
-    status = LIBSPDM_STATUS_SUCCESS;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
+ *
+ * @param  spdm_context A pointer to the SPDM context.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS
+ *         NEGOTIATE_ALGORITHMS was sent and ALGORITHMS was received.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL
+ *         Cannot send NEGOTIATE_ALGORITHMS due to Requester's state.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE
+ *         The size of the ALGORITHMS response is invalid.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD
+ *         The ALGORITHMS response contains one or more invalid fields.
+ * @retval LIBSPDM_STATUS_ERROR_PEER
+ *         The Responder returned an unexpected error.
+ * @retval LIBSPDM_STATUS_BUSY_PEER
+ *         The Responder continually returned Busy error messages.
+ * @retval LIBSPDM_STATUS_RESYNCH_PEER
+ *         The Responder returned a RequestResynch error message.
+ * @retval LIBSPDM_STATUS_BUFFER_FULL
+ *         The buffer used to store transcripts is exhausted.
+ * @retval LIBSPDM_STATUS_NEGOTIATION_FAIL
+ *         The Requester and Responder could not agree on mutual algorithms.
+ *         Note: This return value may be removed in the future.
+ **/
+static libspdm_return_t libspdm_try_negotiate_algorithms(libspdm_context_t *spdm_context)
+{
+    libspdm_return_t status;
+    libspdm_negotiate_algorithms_request_mine_t *spdm_request;
+    size_t spdm_request_size;
+    libspdm_algorithms_response_max_t *spdm_response;
+    size_t spdm_response_size;
+    uint8_t *message;
+    size_t message_size;
+    size_t transport_header_size;
+
+    /* -=[Construct Request Phase]=- */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    status = libspdm_acquire_sender_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size +
+                    spdm_context->local_context.capability.transport_tail_size);
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = message_size - transport_header_size -
+                        spdm_context->local_context.capability.transport_tail_size;
+
+    status = libspdm_build_negotiate_algorithms_request(spdm_context, &spdm_request_size,
+                                                        spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+
+    /* -=[Send Request Phase]=- */
+    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_release_sender_buffer (spdm_context);
+        return status;
+    }
+    libspdm_release_sender_buffer (spdm_context);
+    spdm_request = (void *)spdm_context->last_spdm_request;
+
+    /* -=[Receive Response Phase]=- */
+    status = libspdm_acquire_receiver_buffer (spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT (message_size >= transport_header_size);
+    spdm_response = (void *)(message);
+    spdm_response_size = message_size;
+
+    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
+                                           (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        goto receive_done;
+    }
+
+    status = libspdm_process_algorithms_response(spdm_context, spdm_request, spdm_request_size,
+                                                 spdm_response, spdm_response_size);
 
 receive_done:
     libspdm_release_receiver_buffer (spdm_context);
@@ -7,15 +7,15 @@
 #include "internal/libspdm_requester_lib.h"
 #include "internal/libspdm_secured_message_lib.h"
 
-libspdm_return_t libspdm_send_request(void *spdm_context, const uint32_t *session_id,
-                                      bool is_app_message,
-                                      size_t request_size, void *request)
+libspdm_return_t libspdm_encode_request(void *spdm_context, const uint32_t *session_id,
+                                        bool is_app_message,
+                                        size_t request_size, void *request,
+                                        size_t *transport_message_size, void **transport_message)
 {
     libspdm_context_t *context;
     libspdm_return_t status;
     uint8_t *message;
     size_t message_size;
-    uint64_t timeout;
     uint8_t *scratch_buffer;
     size_t scratch_buffer_size;
     size_t transport_header_size;
@@ -109,6 +109,29 @@ libspdm_return_t libspdm_send_request(void *spdm_context, const uint32_t *sessio
         return status;
     }
 
+    *transport_message_size = message_size;
+    *transport_message = message;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+libspdm_return_t libspdm_send_request(void *spdm_context, const uint32_t *session_id,
+                                      bool is_app_message,
+                                      size_t request_size, void *request)
+{
+    libspdm_context_t *context;
+    libspdm_return_t status;
+    uint8_t *message;
+    size_t message_size;
+    uint64_t timeout;
+
+    context = spdm_context;
+
+    status = libspdm_encode_request(context, session_id, is_app_message, request_size, request,
+                                    &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
     timeout = context->local_context.capability.rtt;
     status = context->send_message(context, message_size, message, timeout);
 
@@ -120,12 +143,46 @@ libspdm_return_t libspdm_send_request(void *spdm_context, const uint32_t *sessio
     return status;
 }
 
-libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *session_id,
-                                          bool is_app_message,
-                                          size_t *response_size,
-                                          void **response)
+uint64_t libspdm_get_response_timeout(const libspdm_context_t *spdm_context)
+{
+    if (spdm_context->crypto_request) {
+        return spdm_context->local_context.capability.rtt +
+               ((uint64_t)1 << spdm_context->connection_info.capability.ct_exponent);
+    } else {
+        return spdm_context->local_context.capability.rtt +
+               spdm_context->local_context.capability.st1;
+    }
+}
+
+/* Check whether the last decode failed to decrypt. The error is read from the secured message
+ * context of the session if it is not NULL, else from the SPDM context. */
+static bool libspdm_is_decrypt_error(const libspdm_context_t *context,
+                                     void *secured_message_context)
+{
+    libspdm_error_struct_t spdm_error;
+
+    if (secured_message_context == NULL) {
+        return context->last_spdm_error.error_code == SPDM_ERROR_CODE_DECRYPT_ERROR;
+    }
+    libspdm_secured_message_get_last_spdm_error_struct(secured_message_context, &spdm_error);
+    return spdm_error.error_code == SPDM_ERROR_CODE_DECRYPT_ERROR;
+}
+
+/* Decode a transport message into decode_buffer, which must not be the transport message.
+ * The decode error is read as in libspdm_is_decrypt_error. The session is not freed here.
+ * Instead session_error is set if it must end. */
+static libspdm_return_t libspdm_decode_response_to_buffer(libspdm_context_t *context,
+                                                          const uint32_t *session_id,
+                                                          bool is_app_message,
+                                                          size_t transport_message_size,
+                                                          void *transport_message,
+                                                          void *secured_message_context,
+                                                          uint8_t *decode_buffer,
+                                                          size_t decode_buffer_size,
+                                                          size_t *response_size,
+                                                          void **response,
+                                                          bool *session_error)
 {
-    libspdm_context_t *context;
     void *temp_session_context;
     libspdm_return_t status;
     uint8_t *message;
@@ -133,33 +190,15 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
     uint32_t *message_session_id;
     uint32_t message_id;
     bool is_message_app_message;
-    uint64_t timeout;
     size_t transport_header_size;
-    uint8_t *scratch_buffer;
-    size_t scratch_buffer_size;
     void *backup_response;
     size_t backup_response_size;
     bool reset_key_update;
     bool result;
 
-    context = spdm_context;
-
-    if (context->crypto_request) {
-        timeout = context->local_context.capability.rtt +
-                  ((uint64_t)1 << context->connection_info.capability.ct_exponent);
-    } else {
-        timeout = context->local_context.capability.rtt + context->local_context.capability.st1;
-    }
-
-    message = *response;
-    message_size = *response_size;
-    status = context->receive_message(context, &message_size, (void **)&message, timeout);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
-                       "libspdm_receive_spdm_response[%x] status - %xu\n",
-                       (session_id != NULL) ? *session_id : 0x0, status));
-        return status;
-    }
+    *session_error = false;
+    message = transport_message;
+    message_size = transport_message_size;
 
     /*
      * The storage transport encoding, defined by DSP0286, does not indicate
@@ -179,20 +218,11 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
     }
     is_message_app_message = false;
 
-    /* always use scratch buffer to response.
-     * if it is secured message, this scratch buffer will be used.
+    /* if it is secured message, the decode buffer will be used.
      * if it is normal message, the response ptr will point to receiver buffer. */
     transport_header_size = context->local_context.capability.transport_header_size;
-    libspdm_get_scratch_buffer (context, (void **)&scratch_buffer, &scratch_buffer_size);
-    #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
-    *response = scratch_buffer + libspdm_get_scratch_buffer_secure_message_offset(context) +
-                transport_header_size;
-    *response_size = libspdm_get_scratch_buffer_secure_message_capacity(context) -
-                     transport_header_size;
-    #else
-    *response = scratch_buffer + transport_header_size;
-    *response_size = scratch_buffer_size - transport_header_size;
-    #endif
+    *response = decode_buffer + transport_header_size;
+    *response_size = decode_buffer_size - transport_header_size;
 
     backup_response = *response;
     backup_response_size = *response_size;
@@ -277,8 +307,8 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
 
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         if ((session_id != NULL) &&
-            (context->last_spdm_error.error_code == SPDM_ERROR_CODE_DECRYPT_ERROR)) {
-            libspdm_free_session_id(context, *session_id);
+            libspdm_is_decrypt_error(context, secured_message_context)) {
+            *session_error = true;
         }
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                        "libspdm_receive_spdm_response[%x] status - %xu\n",
@@ -315,13 +345,208 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
     return status;
 
 error:
-    if (context->last_spdm_error.error_code == SPDM_ERROR_CODE_DECRYPT_ERROR) {
+    if (libspdm_is_decrypt_error(context, secured_message_context)) {
         return LIBSPDM_STATUS_SESSION_MSG_ERROR;
     } else {
         return LIBSPDM_STATUS_RECEIVE_FAIL;
     }
 }
 
+libspdm_return_t libspdm_decode_response(void *spdm_context, const uint32_t *session_id,
+                                         bool is_app_message,
+                                         size_t transport_message_size, void *transport_message,
+                                         size_t *response_size,
+                                         void **response)
+{
+    libspdm_context_t *context;
+    libspdm_return_t status;
+    uint8_t *scratch_buffer;
+    size_t scratch_buffer_size;
+    bool session_error;
+
+    context = spdm_context;
+
+    /* always use scratch buffer to response. */
+    libspdm_get_scratch_buffer (context, (void **)&scratch_buffer, &scratch_buffer_size);
+    #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+    status = libspdm_decode_response_to_buffer(
+        context, session_id, is_app_message, transport_message_size, transport_message, NULL,
+        scratch_buffer + libspdm_get_scratch_buffer_secure_message_offset(context),
+        libspdm_get_scratch_buffer_secure_message_capacity(context), response_size, response,
+        &session_error);
+    #else
+    status = libspdm_decode_response_to_buffer(
+        context, session_id, is_app_message, transport_message_size, transport_message, NULL,
+        scratch_buffer, scratch_buffer_size, response_size, response, &session_error);
+    #endif
+    if (session_error) {
+        libspdm_free_session_id(context, *session_id);
+    }
+    return status;
+}
+
+libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *session_id,
+                                          bool is_app_message,
+                                          size_t *response_size,
+                                          void **response)
+{
+    libspdm_context_t *context;
+    libspdm_return_t status;
+    uint8_t *message;
+    size_t message_size;
+    uint64_t timeout;
+
+    context = spdm_context;
+
+    timeout = libspdm_get_response_timeout(context);
+
+    message = *response;
+    message_size = *response_size;
+    status = context->receive_message(context, &message_size, (void **)&message, timeout);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                       "libspdm_receive_spdm_response[%x] status - %xu\n",
+                       (session_id != NULL) ? *session_id : 0x0, status));
+        return status;
+    }
+
+    return libspdm_decode_response(context, session_id, is_app_message, message_size, message,
+                                   response_size, response);
+}
+
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+libspdm_return_t libspdm_send_receive_session_app_data(libspdm_context_t *spdm_context,
+                                                       uint32_t session_id,
+                                                       const void *request, size_t request_size,
+                                                       void *response, size_t *response_size)
+{
+    libspdm_session_info_t *session_info;
+    libspdm_return_t status;
+    uint8_t *scratch_buffer;
+    size_t scratch_buffer_size;
+    uint8_t *session_buffer;
+    size_t session_buffer_size;
+    size_t transport_header_size;
+    uint8_t *message;
+    size_t message_size;
+    uint8_t *app_message;
+    size_t app_message_size;
+    const spdm_message_header_t *spdm_response;
+    size_t session_index;
+    uint32_t session_offset;
+    bool session_error;
+
+    /* Sessions are only freed by calls that do not run concurrently, so the lookup is safe. */
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, session_id);
+    if (session_info == NULL) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+    if (session_info->free_pending) {
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    }
+    session_index = (size_t)(session_info - spdm_context->session_info);
+    if (session_index >= spdm_context->max_session_count) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    /* The area of the session holds the transport message, followed by the APP message. Apart
+     * from the last error that the transport decode records, and that is not read here, nothing
+     * else in the context is written. A session that must end is only marked, so other sessions
+     * may run at the same time. */
+    transport_header_size = spdm_context->local_context.capability.transport_header_size;
+    scratch_buffer = spdm_context->scratch_buffer;
+    scratch_buffer_size = spdm_context->scratch_buffer_size;
+    session_offset = libspdm_get_scratch_buffer_session_message_offset(spdm_context,
+                                                                      session_index);
+    session_buffer_size = libspdm_get_scratch_buffer_session_message_capacity(spdm_context);
+    if ((scratch_buffer_size < session_offset) ||
+        (scratch_buffer_size - session_offset < session_buffer_size)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+    session_buffer = scratch_buffer + session_offset;
+    session_buffer_size /= 2;
+
+    if (request_size > session_buffer_size - transport_header_size -
+        spdm_context->local_context.capability.transport_tail_size) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                   "libspdm_send_spdm_request[%x] app msg, size (0x%zx): \n",
+                   session_id, request_size));
+    LIBSPDM_INTERNAL_DUMP_HEX(request, request_size);
+
+    app_message = session_buffer + session_buffer_size + transport_header_size;
+    libspdm_copy_mem(app_message, session_buffer_size - transport_header_size,
+                     request, request_size);
+    message = session_buffer;
+    message_size = session_buffer_size;
+    status = spdm_context->transport_encode_message(
+        spdm_context, &session_id, true, true, request_size, app_message,
+        &message_size, (void **)&message);
+    libspdm_zero_mem(app_message, request_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "transport_encode_message status - %xu\n", status));
+        if ((status == LIBSPDM_STATUS_SEQUENCE_NUMBER_OVERFLOW) ||
+            (status == LIBSPDM_STATUS_CRYPTO_ERROR)) {
+            session_info->free_pending = true;
+        }
+        return status;
+    }
+
+    status = spdm_context->send_message(spdm_context, message_size, message,
+                                        spdm_context->local_context.capability.rtt);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_send_spdm_request[%x] status - %xu\n",
+                       session_id, status));
+        return status;
+    }
+
+    message = session_buffer;
+    message_size = session_buffer_size;
+    status = spdm_context->receive_message(spdm_context, &message_size, (void **)&message,
+                                           libspdm_get_response_timeout(spdm_context));
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                       "libspdm_receive_spdm_response[%x] status - %xu\n",
+                       session_id, status));
+        return status;
+    }
+
+    /* The transport may record the decode error in the SPDM context, which all sessions share, so
+     * the error is read from the secured message context of this session. */
+    status = libspdm_decode_response_to_buffer(
+        spdm_context, &session_id, true, message_size, message,
+        session_info->secured_message_context,
+        session_buffer + session_buffer_size, session_buffer_size,
+        &app_message_size, (void **)&app_message, &session_error);
+    if (session_error || (status == LIBSPDM_STATUS_SESSION_MSG_ERROR)) {
+        /* The response could not be decrypted, so the session cannot continue. */
+        session_info->free_pending = true;
+    }
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    spdm_response = (const spdm_message_header_t *)app_message;
+    if ((app_message_size >= sizeof(spdm_message_header_t)) &&
+        (spdm_response->request_response_code == SPDM_ERROR) &&
+        (spdm_response->param1 == SPDM_ERROR_CODE_DECRYPT_ERROR)) {
+        session_info->free_pending = true;
+        status = LIBSPDM_STATUS_SESSION_MSG_ERROR;
+    } else if (*response_size >= app_message_size) {
+        libspdm_copy_mem(response, *response_size, app_message, app_message_size);
+        *response_size = app_message_size;
+    } else {
+        *response_size = app_message_size;
+        status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+    libspdm_zero_mem(app_message, app_message_size);
+
+    return status;
+}
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
+
 #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
 static libspdm_return_t libspdm_handle_large_request(
     libspdm_context_t *spdm_context,
@@ -348,6 +573,8 @@ static libspdm_return_t libspdm_handle_large_request(
     uint8_t *chunk_ptr;
     size_t copy_size;
     libspdm_chunk_info_t *send_info;
+    const uint8_t *large_request;
+    size_t staged_size;
     uint32_t min_data_transfer_size;
     uint64_t max_chunk_data_transfer_size;
     spdm_error_response_t *spdm_error;
@@ -400,9 +627,19 @@ static libspdm_return_t libspdm_handle_large_request(
     send_info->large_message_capacity =
         libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
 
-    libspdm_zero_mem(send_info->large_message, send_info->large_message_capacity);
-    libspdm_copy_mem(send_info->large_message, send_info->large_message_capacity,
-                     request, request_size);
+    /* The chunks are read from the request in place. Only a request in a section of the scratch
+     * buffer that is overwritten while the chunks are sent is copied first. */
+    if (((uint8_t *)request + request_size <= scratch_buffer) ||
+        ((uint8_t *)request >= scratch_buffer +
+         libspdm_get_scratch_buffer_large_sender_receiver_offset(spdm_context))) {
+        large_request = request;
+        staged_size = 0;
+    } else {
+        libspdm_copy_mem(send_info->large_message, send_info->large_message_capacity,
+                         request, request_size);
+        large_request = send_info->large_message;
+        staged_size = request_size;
+    }
 
     send_info->large_message_size = request_size;
     send_info->chunk_bytes_transferred = 0;
@@ -448,7 +685,7 @@ static libspdm_return_t libspdm_handle_large_request(
 
         libspdm_copy_mem(
             chunk_ptr, spdm_request_size - ((uint8_t *)spdm_request - (uint8_t *)message),
-            (uint8_t *)send_info->large_message + send_info->chunk_bytes_transferred, copy_size);
+            large_request + send_info->chunk_bytes_transferred, copy_size);
 
         send_info->chunk_bytes_transferred += copy_size;
         if (send_info->chunk_bytes_transferred >= send_info->large_message_size) {
@@ -467,8 +704,6 @@ static libspdm_return_t libspdm_handle_large_request(
         response = message;
         response_size = message_size;
 
-        libspdm_zero_mem(response, response_size);
-
         status = libspdm_receive_response(
             spdm_context, session_id, false,
             &response_size, &response);
@@ -601,33 +836,39 @@ static libspdm_return_t libspdm_handle_large_request(
              && send_info->chunk_bytes_transferred < send_info->large_message_size);
 
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_zero_mem(send_info->large_message, send_info->large_message_capacity);
+        libspdm_zero_mem(send_info->large_message, staged_size);
         send_info->chunk_in_use = false;
         send_info->chunk_handle++; /* Implicit wrap-around*/
         send_info->chunk_seq_no = 0;
         send_info->chunk_bytes_transferred = 0;
         send_info->large_message = NULL;
         send_info->large_message_size = 0;
+    } else if (staged_size > send_info->large_message_size) {
+        /* Wipe what is left of the copied request after the response. */
+        libspdm_zero_mem((uint8_t *)send_info->large_message + send_info->large_message_size,
+                         staged_size - send_info->large_message_size);
     }
 
     return status;
 }
 #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
-libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
-                                           const uint32_t *session_id,
-                                           size_t request_size, void *request)
+/**
+ * Check that a request fits the Responder's and the Requester's message size limits.
+ *
+ * @param  spdm_context     A pointer to the SPDM context.
+ * @param  request_size     Size in bytes of the request.
+ * @param  allow_chunking   If true, a request that exceeds a DataTransferSize but not a
+ *                          MaxSPDMmsgSize is accepted when both endpoints support chunking.
+ **/
+static libspdm_return_t libspdm_check_spdm_request_size(libspdm_context_t *spdm_context,
+                                                        size_t request_size,
+                                                        bool allow_chunking)
 {
-    libspdm_session_info_t *session_info;
-    libspdm_session_state_t session_state;
-    libspdm_return_t status;
-    #if LIBSPDM_ENABLE_MSG_LOG
-    size_t msg_log_size;
-    #endif /* LIBSPDM_ENABLE_MSG_LOG */
-
     /* If chunking is not supported then message must fit in both the send buffer and the receive
      * buffer. */
-    if (!libspdm_is_capabilities_flag_supported(
+    if (!allow_chunking ||
+        !libspdm_is_capabilities_flag_supported(
             spdm_context, true,
             SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHUNK_CAP,
             SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHUNK_CAP)) {
@@ -641,12 +882,34 @@ libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
         }
     }
 
-    if ((session_id != NULL) &&
+    if ((spdm_context->connection_info.capability.max_spdm_msg_size != 0) &&
+        (request_size > spdm_context->connection_info.capability.max_spdm_msg_size)) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR, "request_size > rsp max_spdm_msg_size\n"));
+        return LIBSPDM_STATUS_PEER_BUFFER_TOO_SMALL;
+    }
+    LIBSPDM_ASSERT (request_size <= spdm_context->local_context.capability.max_spdm_msg_size);
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * Return the session ID that the transport layer uses for a message of a session.
+ *
+ * While a session with HANDSHAKE_IN_THE_CLEAR_CAP is handshaking, its messages are sent in the
+ * clear, and this function clears *session_id.
+ **/
+static libspdm_return_t libspdm_get_transport_session_id(libspdm_context_t *spdm_context,
+                                                         const uint32_t **session_id)
+{
+    libspdm_session_info_t *session_info;
+    libspdm_session_state_t session_state;
+
+    if ((*session_id != NULL) &&
         libspdm_is_capabilities_flag_supported(
             spdm_context, true,
             SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP,
             SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
-        session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
+        session_info = libspdm_get_session_info_via_session_id(spdm_context, **session_id);
         LIBSPDM_ASSERT(session_info != NULL);
         if (session_info == NULL) {
             return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
@@ -654,16 +917,31 @@ libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
         session_state = libspdm_secured_message_get_session_state(
             session_info->secured_message_context);
         if ((session_state == LIBSPDM_SESSION_STATE_HANDSHAKING) && !session_info->use_psk) {
-            session_id = NULL;
+            *session_id = NULL;
         }
     }
 
-    if ((spdm_context->connection_info.capability.max_spdm_msg_size != 0) &&
-        (request_size > spdm_context->connection_info.capability.max_spdm_msg_size)) {
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR, "request_size > rsp max_spdm_msg_size\n"));
-        return LIBSPDM_STATUS_PEER_BUFFER_TOO_SMALL;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
+                                           const uint32_t *session_id,
+                                           size_t request_size, void *request)
+{
+    libspdm_return_t status;
+    #if LIBSPDM_ENABLE_MSG_LOG
+    size_t msg_log_size;
+    #endif /* LIBSPDM_ENABLE_MSG_LOG */
+
+    status = libspdm_check_spdm_request_size(spdm_context, request_size, true);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    status = libspdm_get_transport_session_id(spdm_context, &session_id);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
     }
-    LIBSPDM_ASSERT (request_size <= spdm_context->local_context.capability.max_spdm_msg_size);
 
     #if LIBSPDM_ENABLE_MSG_LOG
     /* First save the size of the message log buffer. If there is an error it will be reverted. */
@@ -722,8 +1000,6 @@ libspdm_return_t libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
                                                void **response)
 {
     libspdm_return_t status;
-    libspdm_session_info_t *session_info;
-    libspdm_session_state_t session_state;
 
     #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
     spdm_message_header_t *spdm_response;
@@ -731,21 +1007,9 @@ libspdm_return_t libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
     libspdm_chunk_info_t *send_info;
     #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
-    if ((session_id != NULL) &&
-        libspdm_is_capabilities_flag_supported(
-            spdm_context, true,
-            SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP,
-            SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
-        session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
-        LIBSPDM_ASSERT(session_info != NULL);
-        if (session_info == NULL) {
-            return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
-        }
-        session_state = libspdm_secured_message_get_session_state(
-            session_info->secured_message_context);
-        if ((session_state == LIBSPDM_SESSION_STATE_HANDSHAKING) && !session_info->use_psk) {
-            session_id = NULL;
-        }
+    status = libspdm_get_transport_session_id(spdm_context, &session_id);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
     }
 
     #if !(LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP)
@@ -760,7 +1024,7 @@ libspdm_return_t libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
 
         /* This response may either be an actual response or ERROR_LARGE_RESPONSE,
          * the latter which should be handled in the large response handler. */
-        libspdm_zero_mem(send_info->large_message, send_info->large_message_capacity);
+        libspdm_zero_mem(send_info->large_message, send_info->large_message_size);
         send_info->chunk_in_use = false;
         send_info->chunk_handle++; /* Implicit wrap-around*/
         send_info->chunk_seq_no = 0;
@@ -813,3 +1077,62 @@ receive_done:
 
     return status;
 }
+
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT
+libspdm_return_t libspdm_encode_spdm_request(libspdm_context_t *spdm_context,
+                                             const uint32_t *session_id,
+                                             size_t request_size, void *request,
+                                             size_t *transport_message_size,
+                                             void **transport_message)
+{
+    libspdm_return_t status;
+    #if LIBSPDM_ENABLE_MSG_LOG
+    size_t msg_log_size;
+    #endif /* LIBSPDM_ENABLE_MSG_LOG */
+
+    status = libspdm_check_spdm_request_size(spdm_context, request_size, false);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    status = libspdm_get_transport_session_id(spdm_context, &session_id);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    #if LIBSPDM_ENABLE_MSG_LOG
+    msg_log_size = libspdm_get_msg_log_size(spdm_context);
+    libspdm_append_msg_log(spdm_context, request, request_size);
+    #endif /* LIBSPDM_ENABLE_MSG_LOG */
+
+    status = libspdm_encode_request(spdm_context, session_id, false, request_size, request,
+                                    transport_message_size, transport_message);
+
+    #if LIBSPDM_ENABLE_MSG_LOG
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        spdm_context->msg_log.buffer_size = msg_log_size;
+    }
+    #endif /* LIBSPDM_ENABLE_MSG_LOG */
+
+    return status;
+}
+
+libspdm_return_t libspdm_decode_spdm_response(libspdm_context_t *spdm_context,
+                                              const uint32_t *session_id,
+                                              size_t transport_message_size,
+                                              void *transport_message,
+                                              size_t *response_size,
+                                              void **response)
+{
+    libspdm_return_t status;
+
+    status = libspdm_get_transport_session_id(spdm_context, &session_id);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    return libspdm_decode_response(spdm_context, session_id, false,
+                                   transport_message_size, transport_message,
+                                   response_size, response);
+}
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT */
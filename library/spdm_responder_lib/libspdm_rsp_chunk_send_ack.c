@@ -242,6 +242,9 @@ libspdm_return_t libspdm_get_response_chunk_send(libspdm_context_t *spdm_context
 
         *response_size = response_header_size + chunk_response_size;
 
+        if (send_info->large_message != NULL) {
+            libspdm_zero_mem(send_info->large_message, send_info->chunk_bytes_transferred);
+        }
         send_info->chunk_in_use = false;
         send_info->chunk_handle = 0;
         send_info->chunk_seq_no = 0;
@@ -268,6 +271,8 @@ libspdm_return_t libspdm_get_response_chunk_send(libspdm_context_t *spdm_context
                 &chunk_response_size, chunk_response);
         }
 
+        /* The large request is not needed any more. */
+        libspdm_zero_mem(send_info->large_message, send_info->large_message_size);
         send_info->chunk_in_use = false;
         send_info->chunk_handle = 0;
         send_info->chunk_seq_no = 0;
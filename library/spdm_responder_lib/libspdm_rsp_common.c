@@ -29,7 +29,7 @@ uint16_t libspdm_allocate_rsp_session_id(const libspdm_context_t *spdm_context,
     }
 
     session_info = spdm_context->session_info;
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
+    for (index = 0; index < spdm_context->max_session_count; index++) {
         if ((session_info[index].session_id & 0xFFFF0000) == (INVALID_SESSION_ID & 0xFFFF0000)) {
             rsp_session_id = (uint16_t)(0xFFFF - index);
             return rsp_session_id;
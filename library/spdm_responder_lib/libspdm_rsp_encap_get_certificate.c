@@ -118,6 +118,9 @@ libspdm_return_t libspdm_process_encap_response_certificate(
     uint32_t rsp_msg_header_size;
     uint32_t max_cert_chain_size;
     uint32_t req_msg_length;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    libspdm_return_t store_status;
+#endif
 
     spdm_response = encap_response;
     spdm_response_size = encap_response_size;
@@ -299,12 +302,11 @@ libspdm_return_t libspdm_process_encap_response_certificate(
     LIBSPDM_ASSERT(slot_id < SPDM_MAX_SLOT_COUNT);
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    spdm_context->connection_info.peer_used_cert_chain[slot_id].buffer_size =
-        cert_chain_buffer_size;
-
-    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain[slot_id].buffer,
-                     sizeof(spdm_context->connection_info.peer_used_cert_chain[slot_id].buffer),
-                     cert_chain_buffer, cert_chain_buffer_size);
+    store_status = libspdm_set_peer_cert_chain_buffer(spdm_context, slot_id,
+                                                      cert_chain_buffer, cert_chain_buffer_size);
+    if (LIBSPDM_STATUS_IS_ERROR(store_status)) {
+        return store_status;
+    }
 #else
     result = libspdm_hash_all(
         spdm_context->connection_info.algorithm.base_hash_algo,
@@ -9,6 +9,14 @@
 
 #if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
 
+libspdm_return_t libspdm_register_dhe_key_pair_func(
+    void *spdm_context, libspdm_acquire_dhe_key_pair_func acquire_dhe_key_pair)
+{
+    libspdm_context_t *context = (libspdm_context_t *)spdm_context;
+    context->acquire_dhe_key_pair = acquire_dhe_key_pair;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
 bool libspdm_generate_key_exchange_rsp_hmac(libspdm_context_t *spdm_context,
                                             libspdm_session_info_t *session_info,
                                             uint8_t *hmac)
@@ -186,6 +194,7 @@ libspdm_return_t libspdm_get_response_key_exchange(libspdm_context_t *spdm_conte
     const spdm_key_exchange_request_t *spdm_request;
     spdm_key_exchange_response_t *spdm_response;
     size_t dhe_key_size;
+    size_t pool_dhe_key_size;
     size_t kem_encap_key_size;
     size_t kem_cipher_text_size;
     size_t req_key_exchange_size;
@@ -573,27 +582,43 @@ libspdm_return_t libspdm_get_response_key_exchange(libspdm_context_t *spdm_conte
 
         ptr += kem_cipher_text_size;
     } else {
-        dhe_context = libspdm_secured_message_dhe_new(
-            spdm_context->connection_info.version,
-            spdm_context->connection_info.algorithm.dhe_named_group, false);
-        if (dhe_context == NULL) {
-            libspdm_free_session_id(spdm_context, session_id);
-            return libspdm_generate_error_response(spdm_context,
-                                                   SPDM_ERROR_CODE_UNSPECIFIED, 0,
-                                                   response_size, response);
+        dhe_context = NULL;
+        if (spdm_context->acquire_dhe_key_pair != NULL) {
+            pool_dhe_key_size = dhe_key_size;
+            dhe_context = spdm_context->acquire_dhe_key_pair(
+                spdm_context, spdm_context->connection_info.algorithm.dhe_named_group,
+                ptr, &pool_dhe_key_size);
+            if ((dhe_context != NULL) && (pool_dhe_key_size != dhe_key_size)) {
+                libspdm_secured_message_dhe_free(
+                    spdm_context->connection_info.algorithm.dhe_named_group,
+                    dhe_context);
+                dhe_context = NULL;
+            }
         }
 
-        result = libspdm_secured_message_dhe_generate_key(
-            spdm_context->connection_info.algorithm.dhe_named_group,
-            dhe_context, ptr, &dhe_key_size);
-        if (!result) {
-            libspdm_secured_message_dhe_free(
+        if (dhe_context == NULL) {
+            dhe_context = libspdm_secured_message_dhe_new(
+                spdm_context->connection_info.version,
+                spdm_context->connection_info.algorithm.dhe_named_group, false);
+            if (dhe_context == NULL) {
+                libspdm_free_session_id(spdm_context, session_id);
+                return libspdm_generate_error_response(spdm_context,
+                                                       SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                                       response_size, response);
+            }
+
+            result = libspdm_secured_message_dhe_generate_key(
                 spdm_context->connection_info.algorithm.dhe_named_group,
-                dhe_context);
-            libspdm_free_session_id(spdm_context, session_id);
-            return libspdm_generate_error_response(spdm_context,
-                                                   SPDM_ERROR_CODE_UNSPECIFIED, 0,
-                                                   response_size, response);
+                dhe_context, ptr, &dhe_key_size);
+            if (!result) {
+                libspdm_secured_message_dhe_free(
+                    spdm_context->connection_info.algorithm.dhe_named_group,
+                    dhe_context);
+                libspdm_free_session_id(spdm_context, session_id);
+                return libspdm_generate_error_response(spdm_context,
+                                                       SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                                       response_size, response);
+            }
         }
 
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "Calc SelfKey (0x%zx):\n", dhe_key_size));
@@ -605,6 +605,8 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
             context->chunk_context.get.chunk_handle++; /* implicit wrap - around to 0. */
             context->chunk_context.get.chunk_seq_no = 0;
 
+            libspdm_zero_mem(context->chunk_context.get.large_message,
+                             context->chunk_context.get.large_message_size);
             context->chunk_context.get.large_message = NULL;
             context->chunk_context.get.large_message_size = 0;
             context->chunk_context.get.chunk_bytes_transferred = 0;
@@ -616,6 +618,8 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
             context->chunk_context.send.chunk_handle = 0;
             context->chunk_context.send.chunk_seq_no = 0;
 
+            libspdm_zero_mem(context->chunk_context.send.large_message,
+                             context->chunk_context.send.chunk_bytes_transferred);
             context->chunk_context.send.large_message = NULL;
             context->chunk_context.send.large_message_size = 0;
             context->chunk_context.send.chunk_bytes_transferred = 0;
@@ -682,6 +686,7 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
             if (get_info->chunk_in_use) {
                 LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR,
                                "Warning: Overwriting previous unrequested chunk_get info.\n"));
+                libspdm_zero_mem(get_info->large_message, get_info->large_message_size);
             }
 
             libspdm_get_scratch_buffer(context, (void **)&scratch_buffer, &scratch_buffer_size);
@@ -699,8 +704,6 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
             get_info->chunk_seq_no = 0;
             get_info->chunk_bytes_transferred = 0;
 
-            libspdm_zero_mem(large_buffer, large_buffer_size);
-
             /* It's possible that the large response that was to be sent to the requester was
              * a CHUNK_SEND_ACK + non-chunk response. In this case, to prevent chunking within
              * chunking, only send back the actual response, by saving only non-chunk portion
@@ -188,6 +188,18 @@ void libspdm_secured_message_set_sequence_number_endian (
     secured_message_context->sequence_number_endian = endian_value;
 }
 
+void libspdm_secured_message_set_replay_window_size(
+    void *spdm_secured_message_context,
+    uint8_t replay_window_size)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+
+    LIBSPDM_ASSERT(replay_window_size <= LIBSPDM_MAX_SEQUENCE_NUMBER_REPLAY_WINDOW);
+
+    secured_message_context = spdm_secured_message_context;
+    secured_message_context->replay_window_size = replay_window_size;
+}
+
 bool libspdm_secured_message_import_shared_secret(void *spdm_secured_message_context,
                                                   const void *shared_secret,
                                                   size_t shared_secret_size)
@@ -353,6 +365,17 @@ bool libspdm_secured_message_import_session_keys(void *spdm_secured_message_cont
                             .response_data_sequence_number),
                      ptr, sizeof(uint64_t));
     ptr += sizeof(uint64_t);
+    secured_message_context->application_secret.request_data_replay_bitmap = 0;
+    secured_message_context->application_secret.response_data_replay_bitmap = 0;
+
+    libspdm_secured_message_prepare_aead_context(
+        secured_message_context,
+        &secured_message_context->application_secret.request_data_aead_context,
+        secured_message_context->application_secret.request_data_encryption_key);
+    libspdm_secured_message_prepare_aead_context(
+        secured_message_context,
+        &secured_message_context->application_secret.response_data_aead_context,
+        secured_message_context->application_secret.response_data_encryption_key);
     return true;
 }
 
@@ -60,43 +60,59 @@ static bool is_sequence_number_endian_determined(uint8_t endian)
             (endian == LIBSPDM_DATA_SESSION_SEQ_NUM_ENC_LITTLE_DEC_LITTLE)) ? true : false;
 }
 
-libspdm_return_t libspdm_encode_secured_message(
-    void *spdm_secured_message_context, uint32_t session_id,
-    bool is_request_message, size_t app_message_size,
-    void *app_message, size_t *secured_message_size,
-    void *secured_message,
-    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+/* Use the keyed AEAD context when it has been prepared, otherwise fall back to the raw key. */
+static bool libspdm_secmes_aead_encryption(
+    const spdm_version_number_t secured_message_version, uint16_t aead_cipher_suite,
+    void *aead_context, const uint8_t *key, size_t key_size,
+    const uint8_t *iv, size_t iv_size, const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, uint8_t *tag_out, size_t tag_size,
+    uint8_t *data_out, size_t *data_out_size)
+{
+    if (aead_context != NULL) {
+        return libspdm_aead_encryption_with_context(
+            secured_message_version, aead_cipher_suite, aead_context, iv, iv_size,
+            a_data, a_data_size, data_in, data_in_size, tag_out, tag_size,
+            data_out, data_out_size);
+    }
+    return libspdm_aead_encryption(
+        secured_message_version, aead_cipher_suite, key, key_size, iv, iv_size,
+        a_data, a_data_size, data_in, data_in_size, tag_out, tag_size,
+        data_out, data_out_size);
+}
+
+static bool libspdm_secmes_aead_decryption(
+    const spdm_version_number_t secured_message_version, uint16_t aead_cipher_suite,
+    void *aead_context, const uint8_t *key, size_t key_size,
+    const uint8_t *iv, size_t iv_size, const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, const uint8_t *tag, size_t tag_size,
+    uint8_t *data_out, size_t *data_out_size)
+{
+    if (aead_context != NULL) {
+        return libspdm_aead_decryption_with_context(
+            secured_message_version, aead_cipher_suite, aead_context, iv, iv_size,
+            a_data, a_data_size, data_in, data_in_size, tag, tag_size,
+            data_out, data_out_size);
+    }
+    return libspdm_aead_decryption(
+        secured_message_version, aead_cipher_suite, key, key_size, iv, iv_size,
+        a_data, a_data_size, data_in, data_in_size, tag, tag_size,
+        data_out, data_out_size);
+}
+
+/* Select the key of the sending direction and consume its sequence number. */
+static libspdm_return_t libspdm_secmes_prepare_encode(
+    libspdm_secured_message_context_t *secured_message_context, bool is_request_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks,
+    void **aead_context, const uint8_t **key, uint8_t *iv,
+    uint64_t *sequence_num_in_header, uint8_t *sequence_num_in_header_size)
 {
-    libspdm_secured_message_context_t *secured_message_context;
-    size_t total_secured_message_size;
-    size_t plain_text_size;
-    size_t cipher_text_size;
-    size_t aead_tag_size;
-    size_t aead_key_size;
-    size_t aead_iv_size;
-    uint8_t *a_data;
-    uint8_t *enc_msg;
-    uint8_t *dec_msg;
-    uint8_t *tag;
-    spdm_secured_message_a_data_header1_t *record_header1;
-    spdm_secured_message_a_data_header2_t *record_header2;
-    size_t record_header_size;
-    spdm_secured_message_cipher_header_t *enc_msg_header;
-    bool result;
-    const uint8_t *key;
     uint8_t *salt;
-    uint8_t iv[LIBSPDM_MAX_AEAD_IV_SIZE];
     uint64_t sequence_number;
-    uint64_t sequence_num_in_header;
-    uint8_t sequence_num_in_header_size;
     libspdm_session_type_t session_type;
-    uint32_t rand_count;
-    uint32_t max_rand_count;
     libspdm_session_state_t session_state;
     spdm_version_number_t secured_spdm_version;
     uint8_t version;
 
-    secured_message_context = spdm_secured_message_context;
     secured_spdm_version = spdm_secured_message_callbacks->get_secured_spdm_version(
         secured_message_context->secured_message_version);
     version = (uint8_t)(secured_spdm_version >> SPDM_VERSION_NUMBER_SHIFT_BIT);
@@ -111,22 +127,20 @@ libspdm_return_t libspdm_encode_secured_message(
     LIBSPDM_ASSERT((session_state == LIBSPDM_SESSION_STATE_HANDSHAKING) ||
                    (session_state == LIBSPDM_SESSION_STATE_ESTABLISHED));
 
-    aead_tag_size = secured_message_context->aead_tag_size;
-    aead_key_size = secured_message_context->aead_key_size;
-    aead_iv_size = secured_message_context->aead_iv_size;
-
     switch (session_state) {
     case LIBSPDM_SESSION_STATE_HANDSHAKING:
         if (is_request_message) {
-            key = (const uint8_t *)secured_message_context->handshake_secret.
-                  request_handshake_encryption_key;
+            *key = (const uint8_t *)secured_message_context->handshake_secret.
+                   request_handshake_encryption_key;
+            *aead_context = secured_message_context->handshake_secret.request_handshake_aead_context;
             salt = (uint8_t *)secured_message_context->handshake_secret.
                    request_handshake_salt;
             sequence_number = secured_message_context->handshake_secret
                               .request_handshake_sequence_number;
         } else {
-            key = (const uint8_t *)secured_message_context->handshake_secret.
-                  response_handshake_encryption_key;
+            *key = (const uint8_t *)secured_message_context->handshake_secret.
+                   response_handshake_encryption_key;
+            *aead_context = secured_message_context->handshake_secret.response_handshake_aead_context;
             salt = (uint8_t *)secured_message_context->handshake_secret.
                    response_handshake_salt;
             sequence_number = secured_message_context->handshake_secret
@@ -135,15 +149,17 @@ libspdm_return_t libspdm_encode_secured_message(
         break;
     case LIBSPDM_SESSION_STATE_ESTABLISHED:
         if (is_request_message) {
-            key = (const uint8_t *)secured_message_context->application_secret.
-                  request_data_encryption_key;
+            *key = (const uint8_t *)secured_message_context->application_secret.
+                   request_data_encryption_key;
+            *aead_context = secured_message_context->application_secret.request_data_aead_context;
             salt = (uint8_t *)secured_message_context->application_secret.
                    request_data_salt;
             sequence_number = secured_message_context->application_secret
                               .request_data_sequence_number;
         } else {
-            key = (const uint8_t *)secured_message_context->application_secret.
-                  response_data_encryption_key;
+            *key = (const uint8_t *)secured_message_context->application_secret.
+                   response_data_encryption_key;
+            *aead_context = secured_message_context->application_secret.response_data_aead_context;
             salt = (uint8_t *)secured_message_context->application_secret.
                    response_data_salt;
             sequence_number = secured_message_context->application_secret
@@ -160,13 +176,13 @@ libspdm_return_t libspdm_encode_secured_message(
         return LIBSPDM_STATUS_SEQUENCE_NUMBER_OVERFLOW;
     }
 
-    generate_iv(sequence_number, iv, salt, aead_iv_size,
+    generate_iv(sequence_number, iv, salt, secured_message_context->aead_iv_size,
                 secured_message_context->sequence_number_endian);
 
-    sequence_num_in_header = 0;
-    sequence_num_in_header_size = spdm_secured_message_callbacks->get_sequence_number(
-        sequence_number, (uint8_t *)&sequence_num_in_header);
-    LIBSPDM_ASSERT(sequence_num_in_header_size <= sizeof(sequence_num_in_header));
+    *sequence_num_in_header = 0;
+    *sequence_num_in_header_size = spdm_secured_message_callbacks->get_sequence_number(
+        sequence_number, (uint8_t *)sequence_num_in_header);
+    LIBSPDM_ASSERT(*sequence_num_in_header_size <= sizeof(*sequence_num_in_header));
 
     if (session_state == LIBSPDM_SESSION_STATE_HANDSHAKING) {
         if (is_request_message) {
@@ -182,22 +198,102 @@ libspdm_return_t libspdm_encode_secured_message(
         }
     }
 
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Pick the number of random bytes that pad the plain text of an ENC_MAC record. */
+static bool libspdm_secmes_get_rand_count(
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks,
+    uint32_t *rand_count)
+{
+    uint32_t max_rand_count;
+
+    max_rand_count = spdm_secured_message_callbacks->get_max_random_number_count();
+    if (max_rand_count == 0) {
+        *rand_count = 0;
+        return true;
+    }
+    *rand_count = 0;
+    if (!libspdm_get_random_number(sizeof(*rand_count), (uint8_t *)rand_count)) {
+        return false;
+    }
+    *rand_count = (uint8_t)((*rand_count % max_rand_count) + 1);
+    return true;
+}
+
+/* Write the record header and return the application data or cipher text that follows it. */
+static uint8_t *libspdm_secmes_write_record_header(
+    void *secured_message, size_t secured_message_size, uint32_t session_id,
+    const uint64_t *sequence_num_in_header, uint8_t sequence_num_in_header_size,
+    size_t length)
+{
+    spdm_secured_message_a_data_header1_t *record_header1;
+    spdm_secured_message_a_data_header2_t *record_header2;
+
+    record_header1 = (void *)secured_message;
+    record_header2 = (void *)((uint8_t *)record_header1 +
+                              sizeof(spdm_secured_message_a_data_header1_t) +
+                              sequence_num_in_header_size);
+    record_header1->session_id = session_id;
+    libspdm_copy_mem(record_header1 + 1,
+                     secured_message_size
+                     - ((uint8_t*)(record_header1 + 1) - (uint8_t*)secured_message),
+                     sequence_num_in_header,
+                     sequence_num_in_header_size);
+    record_header2->length = (uint16_t)length;
+    return (uint8_t *)(record_header2 + 1);
+}
+
+libspdm_return_t libspdm_encode_secured_message(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_request_message, size_t app_message_size,
+    void *app_message, size_t *secured_message_size,
+    void *secured_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    libspdm_return_t status;
+    size_t total_secured_message_size;
+    size_t plain_text_size;
+    size_t cipher_text_size;
+    size_t aead_tag_size;
+    size_t aead_key_size;
+    size_t aead_iv_size;
+    uint8_t *a_data;
+    uint8_t *enc_msg;
+    uint8_t *dec_msg;
+    uint8_t *tag;
+    uint8_t *record_data;
+    size_t record_header_size;
+    spdm_secured_message_cipher_header_t *enc_msg_header;
+    bool result;
+    void *aead_context;
+    const uint8_t *key;
+    uint8_t iv[LIBSPDM_MAX_AEAD_IV_SIZE];
+    uint64_t sequence_num_in_header;
+    uint8_t sequence_num_in_header_size;
+    uint32_t rand_count;
+
+    secured_message_context = spdm_secured_message_context;
+    status = libspdm_secmes_prepare_encode(
+        secured_message_context, is_request_message, spdm_secured_message_callbacks,
+        &aead_context, &key, iv, &sequence_num_in_header, &sequence_num_in_header_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    aead_tag_size = secured_message_context->aead_tag_size;
+    aead_key_size = secured_message_context->aead_key_size;
+    aead_iv_size = secured_message_context->aead_iv_size;
+
     record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
                          sequence_num_in_header_size +
                          sizeof(spdm_secured_message_a_data_header2_t);
 
-    switch (session_type) {
+    switch (secured_message_context->session_type) {
     case LIBSPDM_SESSION_TYPE_ENC_MAC:
-        max_rand_count = spdm_secured_message_callbacks->get_max_random_number_count();
-        if (max_rand_count != 0) {
-            rand_count = 0;
-            result = libspdm_get_random_number(sizeof(rand_count), (uint8_t *)&rand_count);
-            if (!result) {
-                return LIBSPDM_STATUS_LOW_ENTROPY;
-            }
-            rand_count = (uint8_t)((rand_count % max_rand_count) + 1);
-        } else {
-            rand_count = 0;
+        if (!libspdm_secmes_get_rand_count(spdm_secured_message_callbacks, &rand_count)) {
+            return LIBSPDM_STATUS_LOW_ENTROPY;
         }
 
         plain_text_size = sizeof(spdm_secured_message_cipher_header_t) + app_message_size +
@@ -211,17 +307,9 @@ libspdm_return_t libspdm_encode_secured_message(
             return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
         *secured_message_size = total_secured_message_size;
-        record_header1 = (void *)secured_message;
-        record_header2 = (void *)((uint8_t *)record_header1 +
-                                  sizeof(spdm_secured_message_a_data_header1_t) +
-                                  sequence_num_in_header_size);
-        record_header1->session_id = session_id;
-        libspdm_copy_mem(record_header1 + 1,
-                         *secured_message_size
-                         - ((uint8_t*)(record_header1 + 1) - (uint8_t*)secured_message),
-                         &sequence_num_in_header,
-                         sequence_num_in_header_size);
-        record_header2->length = (uint16_t)(cipher_text_size + aead_tag_size);
+        enc_msg = libspdm_secmes_write_record_header(
+            secured_message, *secured_message_size, session_id, &sequence_num_in_header,
+            sequence_num_in_header_size, cipher_text_size + aead_tag_size);
 
         enc_msg_header =
             (void *)((uint8_t *)app_message - sizeof(spdm_secured_message_cipher_header_t));
@@ -234,15 +322,13 @@ libspdm_return_t libspdm_encode_secured_message(
             return LIBSPDM_STATUS_LOW_ENTROPY;
         }
 
-        a_data = (uint8_t *)record_header1;
-        enc_msg = (uint8_t *)(record_header2 + 1);
+        a_data = (uint8_t *)secured_message;
         dec_msg = (uint8_t *)enc_msg_header;
-        tag = (uint8_t *)record_header1 + record_header_size +
-              cipher_text_size;
+        tag = enc_msg + cipher_text_size;
 
-        result = libspdm_aead_encryption(
+        result = libspdm_secmes_aead_encryption(
             secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
+            secured_message_context->aead_cipher_suite, aead_context, key,
             aead_key_size, iv, aead_iv_size, (uint8_t *)a_data,
             record_header_size, dec_msg, cipher_text_size, tag,
             aead_tag_size, enc_msg, &cipher_text_size);
@@ -258,29 +344,18 @@ libspdm_return_t libspdm_encode_secured_message(
             return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
         *secured_message_size = total_secured_message_size;
-        record_header1 = (void *)secured_message;
-        record_header2 =
-            (void *)((uint8_t *)record_header1 +
-                     sizeof(spdm_secured_message_a_data_header1_t) +
-                     sequence_num_in_header_size);
-        record_header1->session_id = session_id;
-        libspdm_copy_mem(record_header1 + 1,
-                         *secured_message_size
-                         - ((uint8_t*)(record_header1 + 1) - (uint8_t*)secured_message),
-                         &sequence_num_in_header,
-                         sequence_num_in_header_size);
-        record_header2->length =
-            (uint16_t)(app_message_size + aead_tag_size);
-        libspdm_copy_mem(record_header2 + 1,
-                         *secured_message_size
-                         - ((uint8_t*)(record_header2 + 1) - (uint8_t*)secured_message),
+        record_data = libspdm_secmes_write_record_header(
+            secured_message, *secured_message_size, session_id, &sequence_num_in_header,
+            sequence_num_in_header_size, app_message_size + aead_tag_size);
+        libspdm_copy_mem(record_data,
+                         *secured_message_size - record_header_size,
                          app_message, app_message_size);
-        a_data = (uint8_t *)record_header1;
-        tag = (uint8_t *)record_header1 + record_header_size + app_message_size;
+        a_data = (uint8_t *)secured_message;
+        tag = record_data + app_message_size;
 
-        result = libspdm_aead_encryption(
+        result = libspdm_secmes_aead_encryption(
             secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
+            secured_message_context->aead_cipher_suite, aead_context, key,
             aead_key_size, iv, aead_iv_size, (uint8_t *)a_data,
             record_header_size + app_message_size, NULL, 0, tag,
             aead_tag_size, NULL, NULL);
@@ -296,12 +371,253 @@ libspdm_return_t libspdm_encode_secured_message(
     return LIBSPDM_STATUS_SUCCESS;
 }
 
-libspdm_return_t libspdm_decode_secured_message(
+/* Gather the fragments into the record. A fragment that already sits at its place is not copied. */
+static void libspdm_secmes_gather_fragments(
+    uint8_t *record_data, size_t record_data_size,
+    const libspdm_secured_message_fragment_t *fragments, size_t fragment_count)
+{
+    size_t index;
+
+    for (index = 0; index < fragment_count; index++) {
+        if (fragments[index].size == 0) {
+            continue;
+        }
+        if (fragments[index].data != record_data) {
+            libspdm_copy_mem(record_data, record_data_size,
+                             fragments[index].data, fragments[index].size);
+        }
+        record_data += fragments[index].size;
+        record_data_size -= fragments[index].size;
+    }
+}
+
+libspdm_return_t libspdm_encode_secured_message_fragments(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_request_message, size_t fragment_count,
+    const libspdm_secured_message_fragment_t *fragments,
+    size_t *secured_message_size, void *secured_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    libspdm_return_t status;
+    size_t app_message_size;
+    size_t total_secured_message_size;
+    size_t cipher_text_size;
+    size_t aead_tag_size;
+    size_t record_header_size;
+    size_t index;
+    uint8_t *record_data;
+    uint8_t *tag;
+    spdm_secured_message_cipher_header_t *enc_msg_header;
+    bool result;
+    void *aead_context;
+    const uint8_t *key;
+    uint8_t iv[LIBSPDM_MAX_AEAD_IV_SIZE];
+    uint64_t sequence_num_in_header;
+    uint8_t sequence_num_in_header_size;
+    uint32_t rand_count;
+
+    /* The application data length and the record length are 16-bit fields. */
+    app_message_size = 0;
+    for (index = 0; index < fragment_count; index++) {
+        if (fragments[index].size > UINT16_MAX - app_message_size) {
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
+        }
+        app_message_size += fragments[index].size;
+    }
+
+    secured_message_context = spdm_secured_message_context;
+    status = libspdm_secmes_prepare_encode(
+        secured_message_context, is_request_message, spdm_secured_message_callbacks,
+        &aead_context, &key, iv, &sequence_num_in_header, &sequence_num_in_header_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    aead_tag_size = secured_message_context->aead_tag_size;
+
+    record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
+                         sequence_num_in_header_size +
+                         sizeof(spdm_secured_message_a_data_header2_t);
+
+    switch (secured_message_context->session_type) {
+    case LIBSPDM_SESSION_TYPE_ENC_MAC:
+        if (!libspdm_secmes_get_rand_count(spdm_secured_message_callbacks, &rand_count)) {
+            return LIBSPDM_STATUS_LOW_ENTROPY;
+        }
+
+        cipher_text_size = sizeof(spdm_secured_message_cipher_header_t) + app_message_size +
+                           rand_count;
+        total_secured_message_size = record_header_size + cipher_text_size + aead_tag_size;
+
+        LIBSPDM_ASSERT(*secured_message_size >= total_secured_message_size);
+        if (*secured_message_size < total_secured_message_size) {
+            *secured_message_size = total_secured_message_size;
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+        }
+        *secured_message_size = total_secured_message_size;
+        record_data = libspdm_secmes_write_record_header(
+            secured_message, *secured_message_size, session_id, &sequence_num_in_header,
+            sequence_num_in_header_size, cipher_text_size + aead_tag_size);
+
+        /* Assemble the plain text where the cipher text goes, then encrypt it in place. */
+        enc_msg_header = (void *)record_data;
+        libspdm_secmes_gather_fragments(
+            (uint8_t *)(enc_msg_header + 1),
+            cipher_text_size - sizeof(spdm_secured_message_cipher_header_t),
+            fragments, fragment_count);
+        enc_msg_header->application_data_length = (uint16_t)app_message_size;
+        result = libspdm_get_random_number(rand_count,
+                                           (uint8_t *)(enc_msg_header + 1) + app_message_size);
+        if (!result) {
+            return LIBSPDM_STATUS_LOW_ENTROPY;
+        }
+        tag = record_data + cipher_text_size;
+
+        result = libspdm_secmes_aead_encryption(
+            secured_message_context->secured_message_version,
+            secured_message_context->aead_cipher_suite, aead_context, key,
+            secured_message_context->aead_key_size, iv, secured_message_context->aead_iv_size,
+            (uint8_t *)secured_message, record_header_size, record_data, cipher_text_size, tag,
+            aead_tag_size, record_data, &cipher_text_size);
+        break;
+
+    case LIBSPDM_SESSION_TYPE_MAC_ONLY:
+        total_secured_message_size = record_header_size + app_message_size + aead_tag_size;
+
+        LIBSPDM_ASSERT(*secured_message_size >= total_secured_message_size);
+        if (*secured_message_size < total_secured_message_size) {
+            *secured_message_size = total_secured_message_size;
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+        }
+        *secured_message_size = total_secured_message_size;
+        record_data = libspdm_secmes_write_record_header(
+            secured_message, *secured_message_size, session_id, &sequence_num_in_header,
+            sequence_num_in_header_size, app_message_size + aead_tag_size);
+        libspdm_secmes_gather_fragments(record_data, app_message_size, fragments, fragment_count);
+        tag = record_data + app_message_size;
+
+        result = libspdm_secmes_aead_encryption(
+            secured_message_context->secured_message_version,
+            secured_message_context->aead_cipher_suite, aead_context, key,
+            secured_message_context->aead_key_size, iv, secured_message_context->aead_iv_size,
+            (uint8_t *)secured_message, record_header_size + app_message_size, NULL, 0, tag,
+            aead_tag_size, NULL, NULL);
+        break;
+
+    default:
+        LIBSPDM_ASSERT(false);
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+    if (!result) {
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
+    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+size_t libspdm_secured_message_get_app_message_offset(
+    void *spdm_secured_message_context,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    uint64_t sequence_num_in_header;
+    size_t offset;
+
+    secured_message_context = spdm_secured_message_context;
+    sequence_num_in_header = 0;
+    offset = sizeof(spdm_secured_message_a_data_header1_t) +
+             spdm_secured_message_callbacks->get_sequence_number(
+                 0, (uint8_t *)&sequence_num_in_header) +
+             sizeof(spdm_secured_message_a_data_header2_t);
+    if (secured_message_context->session_type == LIBSPDM_SESSION_TYPE_ENC_MAC) {
+        offset += sizeof(spdm_secured_message_cipher_header_t);
+    }
+    return offset;
+}
+
+/* Find the sequence number, within the replay window around next_sequence_number, whose transport
+ * encoding matches the one in the received record header. Older sequence numbers that have
+ * already been received are rejected. */
+static bool libspdm_secmes_find_sequence_number_in_window(
+    const libspdm_secured_message_context_t *secured_message_context,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks,
+    uint64_t next_sequence_number, uint64_t replay_bitmap,
+    const uint8_t *sequence_num_in_record, uint8_t sequence_num_in_header_size,
+    uint64_t *sequence_number)
+{
+    uint64_t candidate;
+    uint64_t sequence_num_in_header;
+    uint8_t index;
+
+    /* Most messages arrive in order, so check the next expected one and then move forward. */
+    for (index = 0; index < secured_message_context->replay_window_size; index++) {
+        candidate = next_sequence_number + index;
+        if (candidate >= secured_message_context->max_spdm_session_sequence_number) {
+            break;
+        }
+        sequence_num_in_header = 0;
+        spdm_secured_message_callbacks->get_sequence_number(
+            candidate, (uint8_t *)&sequence_num_in_header);
+        if (libspdm_consttime_is_mem_equal(sequence_num_in_record, &sequence_num_in_header,
+                                           sequence_num_in_header_size)) {
+            *sequence_number = candidate;
+            return true;
+        }
+    }
+
+    for (index = 0; index < secured_message_context->replay_window_size; index++) {
+        if (next_sequence_number <= index) {
+            break;
+        }
+        candidate = next_sequence_number - 1 - index;
+        sequence_num_in_header = 0;
+        spdm_secured_message_callbacks->get_sequence_number(
+            candidate, (uint8_t *)&sequence_num_in_header);
+        if (libspdm_consttime_is_mem_equal(sequence_num_in_record, &sequence_num_in_header,
+                                           sequence_num_in_header_size)) {
+            if ((replay_bitmap & ((uint64_t)1 << index)) != 0) {
+                LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                               "Replayed sequence number 0x%llx is rejected.\n",
+                               (unsigned long long)candidate));
+                return false;
+            }
+            *sequence_number = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Record an authenticated sequence number in the replay window. */
+static void libspdm_secmes_update_replay_window(uint64_t *next_sequence_number,
+                                                uint64_t *replay_bitmap,
+                                                uint64_t sequence_number)
+{
+    uint64_t shift;
+
+    if (sequence_number >= *next_sequence_number) {
+        shift = sequence_number - *next_sequence_number + 1;
+        if (shift >= 64) {
+            *replay_bitmap = 1;
+        } else {
+            *replay_bitmap = (*replay_bitmap << shift) | 1;
+        }
+        *next_sequence_number = sequence_number + 1;
+    } else {
+        *replay_bitmap |= (uint64_t)1 << (*next_sequence_number - 1 - sequence_number);
+    }
+}
+
+/* Decode a secured message. If in_place is true then the cipher text is decrypted where it is,
+ * otherwise it is decrypted to *app_message. */
+static libspdm_return_t libspdm_secmes_decode(
     void *spdm_secured_message_context, uint32_t session_id,
     bool is_request_message, size_t secured_message_size,
     void *secured_message, size_t *app_message_size,
     void **app_message,
-    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks,
+    bool in_place)
 {
     libspdm_secured_message_context_t *secured_message_context;
     size_t plain_text_size;
@@ -318,12 +634,16 @@ libspdm_return_t libspdm_decode_secured_message(
     size_t record_header_size;
     spdm_secured_message_cipher_header_t *enc_msg_header;
     bool result;
+    void *aead_context;
     const uint8_t *key;
     uint8_t *salt;
     uint8_t iv[LIBSPDM_MAX_AEAD_IV_SIZE];
     uint64_t sequence_number;
     uint64_t sequence_num_in_header;
     uint8_t sequence_num_in_header_size;
+    uint64_t *next_sequence_number;
+    uint64_t *replay_bitmap;
+    bool use_replay_window;
     libspdm_session_type_t session_type;
     libspdm_session_state_t session_state;
     libspdm_error_struct_t spdm_error;
@@ -361,34 +681,50 @@ libspdm_return_t libspdm_decode_secured_message(
         if (is_request_message) {
             key = (const uint8_t *)secured_message_context->handshake_secret.
                   request_handshake_encryption_key;
+            aead_context = secured_message_context->handshake_secret.request_handshake_aead_context;
             salt = (uint8_t *)secured_message_context->handshake_secret.
                    request_handshake_salt;
             sequence_number =
                 secured_message_context->handshake_secret.request_handshake_sequence_number;
+            next_sequence_number =
+                &secured_message_context->handshake_secret.request_handshake_sequence_number;
+            replay_bitmap = &secured_message_context->handshake_secret.request_handshake_replay_bitmap;
         } else {
             key = (const uint8_t *)secured_message_context->handshake_secret.
                   response_handshake_encryption_key;
+            aead_context = secured_message_context->handshake_secret.response_handshake_aead_context;
             salt = (uint8_t *)secured_message_context->handshake_secret.
                    response_handshake_salt;
             sequence_number =
                 secured_message_context->handshake_secret.response_handshake_sequence_number;
+            next_sequence_number =
+                &secured_message_context->handshake_secret.response_handshake_sequence_number;
+            replay_bitmap = &secured_message_context->handshake_secret.response_handshake_replay_bitmap;
         }
         break;
     case LIBSPDM_SESSION_STATE_ESTABLISHED:
         if (is_request_message) {
             key = (const uint8_t *)secured_message_context->application_secret.
                   request_data_encryption_key;
+            aead_context = secured_message_context->application_secret.request_data_aead_context;
             salt = (uint8_t *)secured_message_context->application_secret.
                    request_data_salt;
             sequence_number =
                 secured_message_context->application_secret.request_data_sequence_number;
+            next_sequence_number =
+                &secured_message_context->application_secret.request_data_sequence_number;
+            replay_bitmap = &secured_message_context->application_secret.request_data_replay_bitmap;
         } else {
             key = (const uint8_t *)secured_message_context->application_secret.
                   response_data_encryption_key;
+            aead_context = secured_message_context->application_secret.response_data_aead_context;
             salt = (uint8_t *)secured_message_context->application_secret.
                    response_data_salt;
             sequence_number =
                 secured_message_context->application_secret.response_data_sequence_number;
+            next_sequence_number =
+                &secured_message_context->application_secret.response_data_sequence_number;
+            replay_bitmap = &secured_message_context->application_secret.response_data_replay_bitmap;
         }
         break;
     default:
@@ -402,29 +738,71 @@ libspdm_return_t libspdm_decode_secured_message(
         return LIBSPDM_STATUS_SEQUENCE_NUMBER_OVERFLOW;
     }
 
-    generate_iv(sequence_number, iv, salt, aead_iv_size,
-                secured_message_context->sequence_number_endian);
-
     sequence_num_in_header = 0;
     sequence_num_in_header_size =
         spdm_secured_message_callbacks->get_sequence_number(
             sequence_number, (uint8_t *)&sequence_num_in_header);
     LIBSPDM_ASSERT(sequence_num_in_header_size <= sizeof(sequence_num_in_header));
 
-    if (session_state == LIBSPDM_SESSION_STATE_HANDSHAKING) {
-        if (is_request_message) {
-            secured_message_context->handshake_secret.request_handshake_sequence_number++;
-        } else {
-            secured_message_context->handshake_secret.response_handshake_sequence_number++;
+    /* The replay window needs the sequence number in the record header to tell which message
+     * was received, so it does not apply to transports that do not carry one. */
+    use_replay_window = (secured_message_context->replay_window_size != 0) &&
+                        (sequence_num_in_header_size != 0);
+
+    if (use_replay_window) {
+        /* The window only advances once the message has been authenticated. */
+        if (secured_message_size <
+            sizeof(spdm_secured_message_a_data_header1_t) + sequence_num_in_header_size) {
+            libspdm_secured_message_set_last_spdm_error_struct(
+                spdm_secured_message_context, &spdm_error);
+            return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
-    } else {
-        if (is_request_message) {
-            secured_message_context->application_secret.request_data_sequence_number++;
+        if (!libspdm_secmes_find_sequence_number_in_window(
+                secured_message_context, spdm_secured_message_callbacks,
+                *next_sequence_number, *replay_bitmap,
+                (const uint8_t *)secured_message + sizeof(spdm_secured_message_a_data_header1_t),
+                sequence_num_in_header_size, &sequence_number)) {
+            libspdm_secured_message_set_last_spdm_error_struct(
+                spdm_secured_message_context, &spdm_error);
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        }
+        sequence_num_in_header = 0;
+        spdm_secured_message_callbacks->get_sequence_number(
+            sequence_number, (uint8_t *)&sequence_num_in_header);
+    }
+
+    /* The record that determines the sequence number endianness may be decrypted twice, and a
+     * record that fails while backup keys are valid is decoded again with them, so their cipher
+     * text must outlive the first attempt. */
+    if (in_place && (session_type == LIBSPDM_SESSION_TYPE_ENC_MAC)) {
+        if (((sequence_number == 1) &&
+             !is_sequence_number_endian_determined(
+                 secured_message_context->sequence_number_endian)) ||
+            (is_request_message && secured_message_context->requester_backup_valid) ||
+            ((!is_request_message) && secured_message_context->responder_backup_valid)) {
+            return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+        }
+    }
+
+    if (!use_replay_window) {
+        if (session_state == LIBSPDM_SESSION_STATE_HANDSHAKING) {
+            if (is_request_message) {
+                secured_message_context->handshake_secret.request_handshake_sequence_number++;
+            } else {
+                secured_message_context->handshake_secret.response_handshake_sequence_number++;
+            }
         } else {
-            secured_message_context->application_secret.response_data_sequence_number++;
+            if (is_request_message) {
+                secured_message_context->application_secret.request_data_sequence_number++;
+            } else {
+                secured_message_context->application_secret.response_data_sequence_number++;
+            }
         }
     }
 
+    generate_iv(sequence_number, iv, salt, aead_iv_size,
+                secured_message_context->sequence_number_endian);
+
     record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
                          sequence_num_in_header_size +
                          sizeof(spdm_secured_message_a_data_header2_t);
@@ -463,20 +841,23 @@ libspdm_return_t libspdm_decode_secured_message(
             return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
         cipher_text_size = (record_header2->length - aead_tag_size);
-        if (cipher_text_size > *app_message_size) {
+        if (!in_place && (cipher_text_size > *app_message_size)) {
             return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
-        libspdm_zero_mem(*app_message, *app_message_size);
         enc_msg_header = (void *)(record_header2 + 1);
         a_data = (const uint8_t *)record_header1;
         enc_msg = (const uint8_t *)enc_msg_header;
-        dec_msg = (uint8_t *)*app_message;
+        if (in_place) {
+            dec_msg = (uint8_t *)enc_msg_header;
+        } else {
+            dec_msg = (uint8_t *)*app_message;
+        }
         enc_msg_header = (void *)dec_msg;
         tag = (const uint8_t *)record_header1 + record_header_size + cipher_text_size;
 
-        result = libspdm_aead_decryption(
+        result = libspdm_secmes_aead_decryption(
             secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
+            secured_message_context->aead_cipher_suite, aead_context, key,
             aead_key_size, iv, aead_iv_size, a_data,
             record_header_size, enc_msg, cipher_text_size, tag,
             aead_tag_size, dec_msg, &cipher_text_size);
@@ -505,9 +886,9 @@ libspdm_return_t libspdm_decode_secured_message(
                 generate_iv(sequence_number, iv, salt, aead_iv_size,
                             swap_endian(secured_message_context->sequence_number_endian));
 
-                result = libspdm_aead_decryption(
+                result = libspdm_secmes_aead_decryption(
                     secured_message_context->secured_message_version,
-                    secured_message_context->aead_cipher_suite, key,
+                    secured_message_context->aead_cipher_suite, aead_context, key,
                     aead_key_size, iv, aead_iv_size, a_data,
                     record_header_size, enc_msg, cipher_text_size, tag,
                     aead_tag_size, dec_msg, &cipher_text_size);
@@ -521,6 +902,9 @@ libspdm_return_t libspdm_decode_secured_message(
         }
 
         if (!result) {
+            /* Do not leave unauthenticated plain text behind. */
+            libspdm_zero_mem(dec_msg, cipher_text_size);
+
             /* Backup keys are valid, fail and alert rollback and retry is possible. */
             if ((is_request_message && secured_message_context->requester_backup_valid) ||
                 ((!is_request_message) && secured_message_context->responder_backup_valid)) {
@@ -538,7 +922,7 @@ libspdm_return_t libspdm_decode_secured_message(
             return LIBSPDM_STATUS_INVALID_MSG_SIZE;
         }
 
-        LIBSPDM_ASSERT(*app_message_size >= plain_text_size);
+        LIBSPDM_ASSERT(in_place || (*app_message_size >= plain_text_size));
         *app_message = enc_msg_header + 1;
         *app_message_size = plain_text_size;
         break;
@@ -580,9 +964,9 @@ libspdm_return_t libspdm_decode_secured_message(
         tag = (uint8_t *)record_header1 + record_header_size +
               record_header2->length - aead_tag_size;
 
-        result = libspdm_aead_decryption(
+        result = libspdm_secmes_aead_decryption(
             secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
+            secured_message_context->aead_cipher_suite, aead_context, key,
             aead_key_size, iv, aead_iv_size, a_data,
             record_header_size + record_header2->length - aead_tag_size,
             NULL, 0, tag, aead_tag_size, NULL, NULL);
@@ -607,9 +991,9 @@ libspdm_return_t libspdm_decode_secured_message(
                 generate_iv(sequence_number, iv, salt, aead_iv_size,
                             swap_endian(secured_message_context->sequence_number_endian));
 
-                result = libspdm_aead_decryption(
+                result = libspdm_secmes_aead_decryption(
                     secured_message_context->secured_message_version,
-                    secured_message_context->aead_cipher_suite, key,
+                    secured_message_context->aead_cipher_suite, aead_context, key,
                     aead_key_size, iv, aead_iv_size, a_data,
                     record_header_size + record_header2->length - aead_tag_size,
                     NULL, 0, tag, aead_tag_size, NULL, NULL);
@@ -635,7 +1019,7 @@ libspdm_return_t libspdm_decode_secured_message(
         }
 
         plain_text_size = record_header2->length - aead_tag_size;
-        LIBSPDM_ASSERT(*app_message_size >= plain_text_size);
+        LIBSPDM_ASSERT(in_place || (*app_message_size >= plain_text_size));
         *app_message = record_header2 + 1;
         *app_message_size = plain_text_size;
         break;
@@ -645,5 +1029,33 @@ libspdm_return_t libspdm_decode_secured_message(
         return LIBSPDM_STATUS_UNSUPPORTED_CAP;
     }
 
+    if (use_replay_window) {
+        libspdm_secmes_update_replay_window(next_sequence_number, replay_bitmap, sequence_number);
+    }
+
     return LIBSPDM_STATUS_SUCCESS;
 }
+
+libspdm_return_t libspdm_decode_secured_message(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_request_message, size_t secured_message_size,
+    void *secured_message, size_t *app_message_size,
+    void **app_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+    return libspdm_secmes_decode(spdm_secured_message_context, session_id, is_request_message,
+                                 secured_message_size, secured_message, app_message_size,
+                                 app_message, spdm_secured_message_callbacks, false);
+}
+
+libspdm_return_t libspdm_decode_secured_message_in_place(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_request_message, size_t secured_message_size,
+    void *secured_message, size_t *app_message_size,
+    void **app_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+    return libspdm_secmes_decode(spdm_secured_message_context, session_id, is_request_message,
+                                 secured_message_size, secured_message, app_message_size,
+                                 app_message, spdm_secured_message_callbacks, true);
+}
@@ -58,105 +58,303 @@ void libspdm_bin_concat(spdm_version_number_t spdm_version,
     #undef LIBSPDM_BIN_CONCAT_LABEL
 }
 
-static bool libspdm_generate_aead_key_and_iv(
-    libspdm_secured_message_context_t *secured_message_context,
-    const uint8_t *major_secret, uint8_t *key, uint8_t *iv)
+/* The secret that a key schedule stage is expanded from. */
+typedef enum {
+    /* A secret of hash_size bytes held in the secured message context. */
+    LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER,
+    /* The PSK handshake secret, held by the device secret library. */
+    LIBSPDM_KEY_SCHEDULE_SECRET_PSK_HANDSHAKE,
+    /* The PSK master secret, held by the device secret library. */
+    LIBSPDM_KEY_SCHEDULE_SECRET_PSK_MASTER,
+} libspdm_key_schedule_secret_t;
+
+/* One HKDF-Expand label of a key schedule stage. */
+typedef struct {
+    const char *bin_str_name;
+    const char *label;
+    size_t label_size;
+    const char *name;
+    uint8_t *out;
+    size_t out_size;
+} libspdm_key_schedule_entry_t;
+
+#define LIBSPDM_KEY_SCHEDULE_LABEL(index) \
+    "bin_str" #index, SPDM_BIN_STR_ ## index ## _LABEL, sizeof(SPDM_BIN_STR_ ## index ## _LABEL) - 1
+
+/**
+ * Derive all labels of one key schedule stage from the same secret with HKDF-Expand.
+ *
+ * The length and version prefix of the info is built once for the stage and only the label and
+ * transcript hash are written per entry. A secret held in the context is keyed into one HMAC
+ * context that serves every entry. Each output is written to its destination in the secured
+ * message context. An output may overlap the secret only if it is the last entry.
+ *
+ * @param  secured_message_context  A pointer to the SPDM secured message context.
+ * @param  secret_type              The source of the secret.
+ * @param  secret                   The secret for LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER.
+ * @param  transcript_hash          The transcript hash appended to every label, or NULL.
+ * @param  entries                  The labels to derive, in order.
+ * @param  entry_count              The number of entries.
+ *
+ * @retval true   All labels are derived.
+ * @retval false  A derivation failed.
+ **/
+static bool libspdm_key_schedule_derive(
+    const libspdm_secured_message_context_t *secured_message_context,
+    libspdm_key_schedule_secret_t secret_type, const uint8_t *secret,
+    const uint8_t *transcript_hash,
+    const libspdm_key_schedule_entry_t *entries, size_t entry_count)
 {
-    bool status;
+    uint8_t info[128];
+    size_t prefix_size;
+    size_t info_size;
     size_t hash_size;
-    size_t key_length;
-    size_t iv_length;
-    uint8_t bin_str5[128];
-    size_t bin_str5_size;
-    uint8_t bin_str6[128];
-    size_t bin_str6_size;
+    uint32_t base_hash_algo;
+    uint16_t length;
+    void *secret_hmac_ctx;
+    size_t index;
+    bool status;
 
     hash_size = secured_message_context->hash_size;
-    key_length = secured_message_context->aead_key_size;
-    iv_length = secured_message_context->aead_iv_size;
-
-    bin_str5_size = sizeof(bin_str5);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_5_LABEL, sizeof(SPDM_BIN_STR_5_LABEL) - 1,
-                       NULL, (uint16_t)key_length, hash_size, bin_str5,
-                       &bin_str5_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str5 (0x%zx):\n", bin_str5_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str5, bin_str5_size);
-    status = libspdm_hkdf_expand(secured_message_context->base_hash_algo,
-                                 major_secret, hash_size, bin_str5,
-                                 bin_str5_size, key, key_length);
-    if (!status) {
-        return false;
+    base_hash_algo = secured_message_context->base_hash_algo;
+
+    /* The length field is patched per entry. */
+    prefix_size = sizeof(info);
+    libspdm_bin_concat(secured_message_context->version, "", 0, NULL, 0, hash_size,
+                       info, &prefix_size);
+
+    secret_hmac_ctx = NULL;
+    if (secret_type == LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER) {
+        secret_hmac_ctx = libspdm_hmac_new(base_hash_algo);
+        if ((secret_hmac_ctx != NULL) &&
+            !libspdm_hmac_init(base_hash_algo, secret_hmac_ctx, secret, hash_size)) {
+            libspdm_hmac_free(base_hash_algo, secret_hmac_ctx);
+            secret_hmac_ctx = NULL;
+        }
     }
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "key (0x%zx) - ", key_length));
-    LIBSPDM_INTERNAL_DUMP_DATA(key, key_length);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-
-    bin_str6_size = sizeof(bin_str6);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_6_LABEL, sizeof(SPDM_BIN_STR_6_LABEL) - 1,
-                       NULL, (uint16_t)iv_length, hash_size, bin_str6,
-                       &bin_str6_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str6 (0x%zx):\n", bin_str6_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str6, bin_str6_size);
-    status = libspdm_hkdf_expand(secured_message_context->base_hash_algo,
-                                 major_secret, hash_size, bin_str6,
-                                 bin_str6_size, iv, iv_length);
-    if (!status) {
-        return false;
+
+    status = true;
+    for (index = 0; status && (index < entry_count); index++) {
+        LIBSPDM_ASSERT(prefix_size + entries[index].label_size + hash_size <= sizeof(info));
+
+        length = (uint16_t)entries[index].out_size;
+        libspdm_copy_mem(info, sizeof(info), &length, sizeof(length));
+        libspdm_copy_mem(info + prefix_size, sizeof(info) - prefix_size,
+                         entries[index].label, entries[index].label_size);
+        info_size = prefix_size + entries[index].label_size;
+        if (transcript_hash != NULL) {
+            libspdm_copy_mem(info + info_size, sizeof(info) - info_size,
+                             transcript_hash, hash_size);
+            info_size += hash_size;
+        }
+
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "%s (0x%zx):\n", entries[index].bin_str_name,
+                       info_size));
+        LIBSPDM_INTERNAL_DUMP_HEX(info, info_size);
+
+        switch (secret_type) {
+        case LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER:
+            if (secret_hmac_ctx != NULL) {
+                status = libspdm_hkdf_expand_with_hmac_context(
+                    base_hash_algo, secret_hmac_ctx, info, info_size,
+                    entries[index].out, entries[index].out_size);
+            } else {
+                status = libspdm_hkdf_expand(base_hash_algo, secret, hash_size, info, info_size,
+                                             entries[index].out, entries[index].out_size);
+            }
+            break;
+        #if LIBSPDM_ENABLE_CAPABILITY_PSK_CAP
+        case LIBSPDM_KEY_SCHEDULE_SECRET_PSK_HANDSHAKE:
+            status = libspdm_psk_handshake_secret_hkdf_expand(
+                secured_message_context->version, base_hash_algo,
+                secured_message_context->psk_hint, secured_message_context->psk_hint_size,
+                info, info_size, entries[index].out, entries[index].out_size);
+            break;
+        case LIBSPDM_KEY_SCHEDULE_SECRET_PSK_MASTER:
+            status = libspdm_psk_master_secret_hkdf_expand(
+                secured_message_context->version, base_hash_algo,
+                secured_message_context->psk_hint, secured_message_context->psk_hint_size,
+                info, info_size, entries[index].out, entries[index].out_size);
+            break;
+        #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_CAP */
+        default:
+            status = false;
+            break;
+        }
+        if (!status) {
+            break;
+        }
+
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "%s (0x%zx) - ", entries[index].name,
+                       entries[index].out_size));
+        LIBSPDM_INTERNAL_DUMP_DATA(entries[index].out, entries[index].out_size);
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
     }
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "iv (0x%zx) - ", iv_length));
-    LIBSPDM_INTERNAL_DUMP_DATA(iv, iv_length);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
-    return true;
+    libspdm_hmac_free(base_hash_algo, secret_hmac_ctx);
+    return status;
 }
 
-static bool libspdm_generate_finished_key(
+void libspdm_secured_message_prepare_aead_context(void *spdm_secured_message_context,
+                                                  void **aead_context,
+                                                  const uint8_t *key)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+
+    secured_message_context = spdm_secured_message_context;
+
+    if (secured_message_context->aead_key_size == 0) {
+        return;
+    }
+
+    if (*aead_context == NULL) {
+        *aead_context = libspdm_aead_new(secured_message_context->aead_cipher_suite);
+        if (*aead_context == NULL) {
+            return;
+        }
+    }
+
+    if (!libspdm_aead_set_key(secured_message_context->aead_cipher_suite, *aead_context,
+                              key, secured_message_context->aead_key_size)) {
+        libspdm_aead_free(secured_message_context->aead_cipher_suite, *aead_context);
+        *aead_context = NULL;
+    }
+}
+
+void libspdm_secured_message_free_aead_contexts(void *spdm_secured_message_context)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    uint16_t aead_cipher_suite;
+
+    secured_message_context = spdm_secured_message_context;
+    aead_cipher_suite = secured_message_context->aead_cipher_suite;
+
+    libspdm_aead_free(aead_cipher_suite,
+                      secured_message_context->handshake_secret.request_handshake_aead_context);
+    secured_message_context->handshake_secret.request_handshake_aead_context = NULL;
+    libspdm_aead_free(aead_cipher_suite,
+                      secured_message_context->handshake_secret.response_handshake_aead_context);
+    secured_message_context->handshake_secret.response_handshake_aead_context = NULL;
+    libspdm_aead_free(aead_cipher_suite,
+                      secured_message_context->application_secret.request_data_aead_context);
+    secured_message_context->application_secret.request_data_aead_context = NULL;
+    libspdm_aead_free(aead_cipher_suite,
+                      secured_message_context->application_secret.response_data_aead_context);
+    secured_message_context->application_secret.response_data_aead_context = NULL;
+    libspdm_aead_free(aead_cipher_suite,
+                      secured_message_context->application_secret_backup.request_data_aead_context);
+    secured_message_context->application_secret_backup.request_data_aead_context = NULL;
+    libspdm_aead_free(aead_cipher_suite,
+                      secured_message_context->application_secret_backup.response_data_aead_context);
+    secured_message_context->application_secret_backup.response_data_aead_context = NULL;
+}
+
+/**
+ * Allocate an HMAC context if needed and set a finished key into it.
+ *
+ * The keyed HMAC context is copied for each HMAC with the finished key, so that the HMAC key is
+ * not set per message. If the context cannot be prepared, it is left as NULL and the raw finished
+ * key is used.
+ **/
+static void libspdm_secured_message_prepare_hmac_context(
     libspdm_secured_message_context_t *secured_message_context,
-    const uint8_t *handshake_secret, uint8_t *finished_key)
+    void **hmac_context, const uint8_t *key)
 {
-    bool status;
-    size_t hash_size;
-    uint8_t bin_str7[128];
-    size_t bin_str7_size;
+    if (*hmac_context == NULL) {
+        *hmac_context = libspdm_hmac_new(secured_message_context->base_hash_algo);
+        if (*hmac_context == NULL) {
+            return;
+        }
+    }
 
-    hash_size = secured_message_context->hash_size;
+    if (!libspdm_hmac_init(secured_message_context->base_hash_algo, *hmac_context,
+                           key, secured_message_context->hash_size)) {
+        libspdm_hmac_free(secured_message_context->base_hash_algo, *hmac_context);
+        *hmac_context = NULL;
+    }
+}
 
-    bin_str7_size = sizeof(bin_str7);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_7_LABEL, sizeof(SPDM_BIN_STR_7_LABEL) - 1,
-                       NULL, (uint16_t)hash_size, hash_size, bin_str7,
-                       &bin_str7_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str7 (0x%zx):\n", bin_str7_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str7, bin_str7_size);
-    status = libspdm_hkdf_expand(secured_message_context->base_hash_algo,
-                                 handshake_secret, hash_size, bin_str7,
-                                 bin_str7_size, finished_key, hash_size);
-    if (!status) {
+void libspdm_secured_message_free_hmac_contexts(void *spdm_secured_message_context)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    uint32_t base_hash_algo;
+
+    secured_message_context = spdm_secured_message_context;
+    base_hash_algo = secured_message_context->base_hash_algo;
+
+    libspdm_hmac_free(base_hash_algo,
+                      secured_message_context->handshake_secret.request_finished_key_hmac_context);
+    secured_message_context->handshake_secret.request_finished_key_hmac_context = NULL;
+    libspdm_hmac_free(base_hash_algo,
+                      secured_message_context->handshake_secret.response_finished_key_hmac_context);
+    secured_message_context->handshake_secret.response_finished_key_hmac_context = NULL;
+}
+
+/**
+ * Derive the finished key and the AEAD key and IV of one direction from its handshake secret.
+ **/
+static bool libspdm_generate_handshake_direction_keys(
+    libspdm_secured_message_context_t *secured_message_context,
+    const uint8_t *handshake_secret, uint8_t *finished_key, void **finished_key_hmac_context,
+    uint8_t *key, uint8_t *iv)
+{
+    const libspdm_key_schedule_entry_t entries[] = {
+        { LIBSPDM_KEY_SCHEDULE_LABEL(7), "finished_key",
+          finished_key, secured_message_context->hash_size },
+        { LIBSPDM_KEY_SCHEDULE_LABEL(5), "key", key, secured_message_context->aead_key_size },
+        { LIBSPDM_KEY_SCHEDULE_LABEL(6), "iv", iv, secured_message_context->aead_iv_size },
+    };
+
+    if (!libspdm_key_schedule_derive(secured_message_context, LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER,
+                                     handshake_secret, NULL,
+                                     entries, LIBSPDM_ARRAY_SIZE(entries))) {
         return false;
     }
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "finished_key (0x%zx) - ", hash_size));
-    LIBSPDM_INTERNAL_DUMP_DATA(finished_key, hash_size);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
+    libspdm_secured_message_prepare_hmac_context(secured_message_context,
+                                                 finished_key_hmac_context, finished_key);
     return true;
 }
 
+/**
+ * Derive the AEAD key and IV of one direction from its data secret.
+ **/
+static bool libspdm_generate_data_key_and_iv(
+    libspdm_secured_message_context_t *secured_message_context,
+    const uint8_t *data_secret, uint8_t *key, uint8_t *iv)
+{
+    const libspdm_key_schedule_entry_t entries[] = {
+        { LIBSPDM_KEY_SCHEDULE_LABEL(5), "key", key, secured_message_context->aead_key_size },
+        { LIBSPDM_KEY_SCHEDULE_LABEL(6), "iv", iv, secured_message_context->aead_iv_size },
+    };
+
+    return libspdm_key_schedule_derive(secured_message_context, LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER,
+                                       data_secret, NULL, entries, LIBSPDM_ARRAY_SIZE(entries));
+}
+
+/**
+ * Derive the next data secret of one direction in place, for KEY_UPDATE.
+ **/
+static bool libspdm_update_data_secret(
+    libspdm_secured_message_context_t *secured_message_context,
+    uint8_t *data_secret, const char *name)
+{
+    const libspdm_key_schedule_entry_t entries[] = {
+        { LIBSPDM_KEY_SCHEDULE_LABEL(9), name, data_secret, secured_message_context->hash_size },
+    };
+
+    return libspdm_key_schedule_derive(secured_message_context, LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER,
+                                       data_secret, NULL, entries, LIBSPDM_ARRAY_SIZE(entries));
+}
+
 bool libspdm_generate_session_handshake_key(void *spdm_secured_message_context,
                                             const uint8_t *th1_hash_data)
 {
     bool status;
     size_t hash_size;
-    uint8_t bin_str1[128];
-    size_t bin_str1_size;
-    uint8_t bin_str2[128];
-    size_t bin_str2_size;
     libspdm_secured_message_context_t *secured_message_context;
     uint8_t salt0[LIBSPDM_MAX_HASH_SIZE];
+    libspdm_key_schedule_secret_t secret_type;
 
     secured_message_context = spdm_secured_message_context;
 
@@ -187,133 +385,62 @@ bool libspdm_generate_session_handshake_key(void *spdm_secured_message_context,
             secured_message_context->master_secret.handshake_secret,
             hash_size);
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+        secret_type = LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER;
+    } else {
+        secret_type = LIBSPDM_KEY_SCHEDULE_SECRET_PSK_HANDSHAKE;
     }
 
-    bin_str1_size = sizeof(bin_str1);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_1_LABEL, sizeof(SPDM_BIN_STR_1_LABEL) - 1,
-                       th1_hash_data, (uint16_t)hash_size, hash_size,
-                       bin_str1, &bin_str1_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str1 (0x%zx):\n", bin_str1_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str1, bin_str1_size);
-
-    #if LIBSPDM_ENABLE_CAPABILITY_PSK_CAP
-    if (secured_message_context->use_psk) {
-        status = libspdm_psk_handshake_secret_hkdf_expand(
-            secured_message_context->version,
-            secured_message_context->base_hash_algo,
-            secured_message_context->psk_hint,
-            secured_message_context->psk_hint_size, bin_str1,
-            bin_str1_size,
-            secured_message_context->handshake_secret.request_handshake_secret,
-            hash_size);
-
-        if (!status) {
-            return false;
-        }
-    }
-    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_CAP */
-    if (!(secured_message_context->use_psk)) {
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.handshake_secret,
-            hash_size, bin_str1, bin_str1_size,
-            secured_message_context->handshake_secret.request_handshake_secret,
-            hash_size);
-
-        if (!status) {
-            return false;
-        }
-    }
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "request_handshake_secret (0x%zx) - ", hash_size));
-    LIBSPDM_INTERNAL_DUMP_DATA(secured_message_context->handshake_secret
-                               .request_handshake_secret,
-                               hash_size);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-    bin_str2_size = sizeof(bin_str2);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_2_LABEL, sizeof(SPDM_BIN_STR_2_LABEL) - 1,
-                       th1_hash_data, (uint16_t)hash_size, hash_size,
-                       bin_str2, &bin_str2_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str2 (0x%zx):\n", bin_str2_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str2, bin_str2_size);
-
-    #if LIBSPDM_ENABLE_CAPABILITY_PSK_CAP
-    if (secured_message_context->use_psk) {
-        status = libspdm_psk_handshake_secret_hkdf_expand(
-            secured_message_context->version,
-            secured_message_context->base_hash_algo,
-            secured_message_context->psk_hint,
-            secured_message_context->psk_hint_size, bin_str2,
-            bin_str2_size,
-            secured_message_context->handshake_secret.response_handshake_secret,
-            hash_size);
-
+    {
+        const libspdm_key_schedule_entry_t entries[] = {
+            { LIBSPDM_KEY_SCHEDULE_LABEL(1), "request_handshake_secret",
+              secured_message_context->handshake_secret.request_handshake_secret, hash_size },
+            { LIBSPDM_KEY_SCHEDULE_LABEL(2), "response_handshake_secret",
+              secured_message_context->handshake_secret.response_handshake_secret, hash_size },
+        };
+
+        status = libspdm_key_schedule_derive(
+            secured_message_context, secret_type,
+            secured_message_context->master_secret.handshake_secret, th1_hash_data,
+            entries, LIBSPDM_ARRAY_SIZE(entries));
         if (!status) {
             return false;
         }
     }
-    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_CAP */
-    if (!(secured_message_context->use_psk)) {
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.handshake_secret,
-            hash_size, bin_str2, bin_str2_size,
-            secured_message_context->handshake_secret.response_handshake_secret,
-            hash_size);
 
-        if (!status) {
-            return false;
-        }
-    }
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "response_handshake_secret (0x%zx) - ", hash_size));
-    LIBSPDM_INTERNAL_DUMP_DATA(secured_message_context->handshake_secret.response_handshake_secret,
-                               hash_size);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-
-    status = libspdm_generate_finished_key(
+    status = libspdm_generate_handshake_direction_keys(
         secured_message_context,
-        secured_message_context->handshake_secret
-        .request_handshake_secret,
-        secured_message_context->handshake_secret.request_finished_key);
+        secured_message_context->handshake_secret.request_handshake_secret,
+        secured_message_context->handshake_secret.request_finished_key,
+        &secured_message_context->handshake_secret.request_finished_key_hmac_context,
+        secured_message_context->handshake_secret.request_handshake_encryption_key,
+        secured_message_context->handshake_secret.request_handshake_salt);
     if (!status) {
-        return status;
+        return false;
     }
-
-    status = libspdm_generate_finished_key(
+    libspdm_secured_message_prepare_aead_context(
         secured_message_context,
-        secured_message_context->handshake_secret.response_handshake_secret,
-        secured_message_context->handshake_secret.response_finished_key);
-    if (!status) {
-        return status;
-    }
-
-    status = libspdm_generate_aead_key_and_iv(secured_message_context,
-                                              secured_message_context->handshake_secret
-                                              .request_handshake_secret,
-                                              secured_message_context->handshake_secret
-                                              .request_handshake_encryption_key,
-                                              secured_message_context->handshake_secret
-                                              .request_handshake_salt);
-    if (!status) {
-        return status;
-    }
+        &secured_message_context->handshake_secret.request_handshake_aead_context,
+        secured_message_context->handshake_secret.request_handshake_encryption_key);
     secured_message_context->handshake_secret.request_handshake_sequence_number = 0;
+    secured_message_context->handshake_secret.request_handshake_replay_bitmap = 0;
 
-    status = libspdm_generate_aead_key_and_iv(
+    status = libspdm_generate_handshake_direction_keys(
         secured_message_context,
         secured_message_context->handshake_secret.response_handshake_secret,
+        secured_message_context->handshake_secret.response_finished_key,
+        &secured_message_context->handshake_secret.response_finished_key_hmac_context,
         secured_message_context->handshake_secret.response_handshake_encryption_key,
         secured_message_context->handshake_secret.response_handshake_salt);
     if (!status) {
-        return status;
+        return false;
     }
+    libspdm_secured_message_prepare_aead_context(
+        secured_message_context,
+        &secured_message_context->handshake_secret.response_handshake_aead_context,
+        secured_message_context->handshake_secret.response_handshake_encryption_key);
 
     secured_message_context->handshake_secret.response_handshake_sequence_number = 0;
+    secured_message_context->handshake_secret.response_handshake_replay_bitmap = 0;
     libspdm_zero_mem(secured_message_context->master_secret.shared_secret, LIBSPDM_MAX_SHARED_KEY_SIZE);
 
     return true;
@@ -325,42 +452,26 @@ bool libspdm_generate_session_data_key(void *spdm_secured_message_context,
     bool status;
     size_t hash_size;
     uint8_t salt1[LIBSPDM_MAX_HASH_SIZE];
-    uint8_t bin_str0[128];
-    size_t bin_str0_size;
-    uint8_t bin_str3[128];
-    size_t bin_str3_size;
-    uint8_t bin_str4[128];
-    size_t bin_str4_size;
-    uint8_t bin_str8[128];
-    size_t bin_str8_size;
     libspdm_secured_message_context_t *secured_message_context;
     uint8_t zero_filled_buffer[LIBSPDM_MAX_HASH_SIZE];
+    libspdm_key_schedule_secret_t secret_type;
 
     secured_message_context = spdm_secured_message_context;
 
     hash_size = secured_message_context->hash_size;
 
     if (!(secured_message_context->use_psk)) {
-        bin_str0_size = sizeof(bin_str0);
-        libspdm_bin_concat(secured_message_context->version,
-                           SPDM_BIN_STR_0_LABEL,
-                           sizeof(SPDM_BIN_STR_0_LABEL) - 1, NULL,
-                           (uint16_t)hash_size, hash_size, bin_str0,
-                           &bin_str0_size);
-
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str0 (0x%zx):\n", bin_str0_size));
-        LIBSPDM_INTERNAL_DUMP_HEX(bin_str0, bin_str0_size);
-
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.handshake_secret,
-            hash_size, bin_str0, bin_str0_size, salt1, hash_size);
+        const libspdm_key_schedule_entry_t salt_entries[] = {
+            { LIBSPDM_KEY_SCHEDULE_LABEL(0), "salt1", salt1, hash_size },
+        };
+
+        status = libspdm_key_schedule_derive(
+            secured_message_context, LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER,
+            secured_message_context->master_secret.handshake_secret, NULL,
+            salt_entries, LIBSPDM_ARRAY_SIZE(salt_entries));
         if (!status) {
-            return false;
+            goto cleanup;
         }
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "salt1 (0x%zx) - ", hash_size));
-        LIBSPDM_INTERNAL_DUMP_DATA(salt1, hash_size);
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
         libspdm_zero_mem(zero_filled_buffer, sizeof(zero_filled_buffer));
         status = libspdm_hkdf_extract(
@@ -375,139 +486,31 @@ bool libspdm_generate_session_data_key(void *spdm_secured_message_context,
             secured_message_context->master_secret.master_secret,
             hash_size);
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+        secret_type = LIBSPDM_KEY_SCHEDULE_SECRET_BUFFER;
+    } else {
+        secret_type = LIBSPDM_KEY_SCHEDULE_SECRET_PSK_MASTER;
     }
 
-    bin_str3_size = sizeof(bin_str3);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_3_LABEL, sizeof(SPDM_BIN_STR_3_LABEL) - 1,
-                       th2_hash_data, (uint16_t)hash_size, hash_size,
-                       bin_str3, &bin_str3_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str3 (0x%zx):\n", bin_str3_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str3, bin_str3_size);
-
-    #if LIBSPDM_ENABLE_CAPABILITY_PSK_CAP
-    if (secured_message_context->use_psk) {
-        status = libspdm_psk_master_secret_hkdf_expand(
-            secured_message_context->version,
-            secured_message_context->base_hash_algo,
-            secured_message_context->psk_hint,
-            secured_message_context->psk_hint_size, bin_str3,
-            bin_str3_size,
-            secured_message_context->application_secret.request_data_secret,
-            hash_size);
-
-        if (!status) {
-            goto cleanup;
-        }
-    }
-    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_CAP */
-    if (!(secured_message_context->use_psk)) {
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.master_secret,
-            hash_size, bin_str3, bin_str3_size,
-            secured_message_context->application_secret.request_data_secret,
-            hash_size);
-
-        if (!status) {
-            goto cleanup;
-        }
-    }
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "request_data_secret (0x%zx) - ", hash_size));
-    LIBSPDM_INTERNAL_DUMP_DATA(
-        secured_message_context->application_secret.request_data_secret,
-        hash_size);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-    bin_str4_size = sizeof(bin_str4);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_4_LABEL, sizeof(SPDM_BIN_STR_4_LABEL) - 1,
-                       th2_hash_data, (uint16_t)hash_size, hash_size,
-                       bin_str4, &bin_str4_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str4 (0x%zx):\n", bin_str4_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str4, bin_str4_size);
-
-    #if LIBSPDM_ENABLE_CAPABILITY_PSK_CAP
-    if (secured_message_context->use_psk) {
-        status = libspdm_psk_master_secret_hkdf_expand(
-            secured_message_context->version,
-            secured_message_context->base_hash_algo,
-            secured_message_context->psk_hint,
-            secured_message_context->psk_hint_size, bin_str4,
-            bin_str4_size,
-            secured_message_context->application_secret.response_data_secret,
-            hash_size);
-
-        if (!status) {
-            goto cleanup;
-        }
-    }
-    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_CAP */
-    if (!(secured_message_context->use_psk)) {
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.master_secret,
-            hash_size, bin_str4, bin_str4_size,
-            secured_message_context->application_secret.response_data_secret,
-            hash_size);
-
-        if (!status) {
-            goto cleanup;
-        }
-    }
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "response_data_secret (0x%zx) - ", hash_size));
-    LIBSPDM_INTERNAL_DUMP_DATA(
-        secured_message_context->application_secret.response_data_secret,
-        hash_size);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-
-    bin_str8_size = sizeof(bin_str8);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_8_LABEL, sizeof(SPDM_BIN_STR_8_LABEL) - 1,
-                       th2_hash_data, (uint16_t)hash_size, hash_size,
-                       bin_str8, &bin_str8_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str8 (0x%zx):\n", bin_str8_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str8, bin_str8_size);
-
-    #if LIBSPDM_ENABLE_CAPABILITY_PSK_CAP
-    if (secured_message_context->use_psk) {
-        status = libspdm_psk_master_secret_hkdf_expand(
-            secured_message_context->version,
-            secured_message_context->base_hash_algo,
-            secured_message_context->psk_hint,
-            secured_message_context->psk_hint_size, bin_str8,
-            bin_str8_size,
-            secured_message_context->export_master_secret,
-            hash_size);
-
-        if (!status) {
-            goto cleanup;
-        }
-    }
-    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_CAP */
-    if (!(secured_message_context->use_psk)) {
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.master_secret,
-            hash_size, bin_str8, bin_str8_size,
-            secured_message_context->export_master_secret,
-            hash_size);
-
+    {
+        const libspdm_key_schedule_entry_t entries[] = {
+            { LIBSPDM_KEY_SCHEDULE_LABEL(3), "request_data_secret",
+              secured_message_context->application_secret.request_data_secret, hash_size },
+            { LIBSPDM_KEY_SCHEDULE_LABEL(4), "response_data_secret",
+              secured_message_context->application_secret.response_data_secret, hash_size },
+            { LIBSPDM_KEY_SCHEDULE_LABEL(8), "export_master_secret",
+              secured_message_context->export_master_secret, hash_size },
+        };
+
+        status = libspdm_key_schedule_derive(
+            secured_message_context, secret_type,
+            secured_message_context->master_secret.master_secret, th2_hash_data,
+            entries, LIBSPDM_ARRAY_SIZE(entries));
         if (!status) {
             goto cleanup;
         }
     }
 
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "export_master_secret (0x%zx) - ", hash_size));
-    LIBSPDM_INTERNAL_DUMP_DATA(
-        secured_message_context->export_master_secret, hash_size);
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-
-    status = libspdm_generate_aead_key_and_iv(
+    status = libspdm_generate_data_key_and_iv(
         secured_message_context,
         secured_message_context->application_secret.request_data_secret,
         secured_message_context->application_secret.request_data_encryption_key,
@@ -515,9 +518,14 @@ bool libspdm_generate_session_data_key(void *spdm_secured_message_context,
     if (!status) {
         goto cleanup;
     }
+    libspdm_secured_message_prepare_aead_context(
+        secured_message_context,
+        &secured_message_context->application_secret.request_data_aead_context,
+        secured_message_context->application_secret.request_data_encryption_key);
     secured_message_context->application_secret.request_data_sequence_number = 0;
+    secured_message_context->application_secret.request_data_replay_bitmap = 0;
 
-    status = libspdm_generate_aead_key_and_iv(
+    status = libspdm_generate_data_key_and_iv(
         secured_message_context,
         secured_message_context->application_secret.response_data_secret,
         secured_message_context->application_secret.response_data_encryption_key,
@@ -525,7 +533,12 @@ bool libspdm_generate_session_data_key(void *spdm_secured_message_context,
     if (!status) {
         goto cleanup;
     }
+    libspdm_secured_message_prepare_aead_context(
+        secured_message_context,
+        &secured_message_context->application_secret.response_data_aead_context,
+        secured_message_context->application_secret.response_data_encryption_key);
     secured_message_context->application_secret.response_data_sequence_number = 0;
+    secured_message_context->application_secret.response_data_replay_bitmap = 0;
 
 cleanup:
     /*zero salt1 for security*/
@@ -537,24 +550,10 @@ bool libspdm_create_update_session_data_key(void *spdm_secured_message_context,
                                             libspdm_key_update_action_t action)
 {
     bool status;
-    size_t hash_size;
-    uint8_t bin_str9[128];
-    size_t bin_str9_size;
     libspdm_secured_message_context_t *secured_message_context;
 
     secured_message_context = spdm_secured_message_context;
 
-    hash_size = secured_message_context->hash_size;
-
-    bin_str9_size = sizeof(bin_str9);
-    libspdm_bin_concat(secured_message_context->version,
-                       SPDM_BIN_STR_9_LABEL, sizeof(SPDM_BIN_STR_9_LABEL) - 1,
-                       NULL, (uint16_t)hash_size, hash_size, bin_str9,
-                       &bin_str9_size);
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str9 (0x%zx):\n", bin_str9_size));
-    LIBSPDM_INTERNAL_DUMP_HEX(bin_str9, bin_str9_size);
-
     if (action == LIBSPDM_KEY_UPDATE_ACTION_REQUESTER) {
         libspdm_copy_mem(&secured_message_context->application_secret_backup
                          .request_data_secret,
@@ -580,22 +579,23 @@ bool libspdm_create_update_session_data_key(void *spdm_secured_message_context,
         secured_message_context->application_secret_backup
         .request_data_sequence_number =
             secured_message_context->application_secret.request_data_sequence_number;
-
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->application_secret.request_data_secret,
-            hash_size, bin_str9, bin_str9_size,
-            secured_message_context->application_secret.request_data_secret,
-            hash_size);
+        secured_message_context->application_secret_backup.request_data_replay_bitmap =
+            secured_message_context->application_secret.request_data_replay_bitmap;
+        libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                          secured_message_context->application_secret_backup
+                          .request_data_aead_context);
+        secured_message_context->application_secret_backup.request_data_aead_context =
+            secured_message_context->application_secret.request_data_aead_context;
+        secured_message_context->application_secret.request_data_aead_context = NULL;
+
+        status = libspdm_update_data_secret(
+            secured_message_context,
+            secured_message_context->application_secret.request_data_secret, "RequestDataSecretUpdate");
         if (!status) {
             return false;
         }
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "RequestDataSecretUpdate (0x%zx) - ", hash_size));
-        LIBSPDM_INTERNAL_DUMP_DATA(secured_message_context->application_secret.request_data_secret,
-                                   hash_size);
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
-        status = libspdm_generate_aead_key_and_iv(
+        status = libspdm_generate_data_key_and_iv(
             secured_message_context,
             secured_message_context->application_secret.request_data_secret,
             secured_message_context->application_secret.request_data_encryption_key,
@@ -603,7 +603,12 @@ bool libspdm_create_update_session_data_key(void *spdm_secured_message_context,
         if (!status) {
             return status;
         }
+        libspdm_secured_message_prepare_aead_context(
+            secured_message_context,
+            &secured_message_context->application_secret.request_data_aead_context,
+            secured_message_context->application_secret.request_data_encryption_key);
         secured_message_context->application_secret.request_data_sequence_number = 0;
+        secured_message_context->application_secret.request_data_replay_bitmap = 0;
 
         secured_message_context->requester_backup_valid = true;
     } else if (action == LIBSPDM_KEY_UPDATE_ACTION_RESPONDER) {
@@ -631,23 +636,23 @@ bool libspdm_create_update_session_data_key(void *spdm_secured_message_context,
         secured_message_context->application_secret_backup
         .response_data_sequence_number =
             secured_message_context->application_secret.response_data_sequence_number;
-
-        status = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->application_secret.response_data_secret,
-            hash_size, bin_str9, bin_str9_size,
-            secured_message_context->application_secret.response_data_secret,
-            hash_size);
+        secured_message_context->application_secret_backup.response_data_replay_bitmap =
+            secured_message_context->application_secret.response_data_replay_bitmap;
+        libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                          secured_message_context->application_secret_backup
+                          .response_data_aead_context);
+        secured_message_context->application_secret_backup.response_data_aead_context =
+            secured_message_context->application_secret.response_data_aead_context;
+        secured_message_context->application_secret.response_data_aead_context = NULL;
+
+        status = libspdm_update_data_secret(
+            secured_message_context,
+            secured_message_context->application_secret.response_data_secret, "ResponseDataSecretUpdate");
         if (!status) {
             return false;
         }
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "ResponseDataSecretUpdate (0x%zx) - ",
-                       hash_size));
-        LIBSPDM_INTERNAL_DUMP_DATA(secured_message_context->application_secret.response_data_secret,
-                                   hash_size);
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
-        status = libspdm_generate_aead_key_and_iv(
+        status = libspdm_generate_data_key_and_iv(
             secured_message_context,
             secured_message_context->application_secret.response_data_secret,
             secured_message_context->application_secret.response_data_encryption_key,
@@ -655,7 +660,12 @@ bool libspdm_create_update_session_data_key(void *spdm_secured_message_context,
         if (!status) {
             return status;
         }
+        libspdm_secured_message_prepare_aead_context(
+            secured_message_context,
+            &secured_message_context->application_secret.response_data_aead_context,
+            secured_message_context->application_secret.response_data_encryption_key);
         secured_message_context->application_secret.response_data_sequence_number = 0;
+        secured_message_context->application_secret.response_data_replay_bitmap = 0;
 
         secured_message_context->responder_backup_valid = true;
     } else {
@@ -673,6 +683,11 @@ void libspdm_clear_handshake_secret(void *spdm_secured_message_context)
 
     libspdm_zero_mem(secured_message_context->master_secret.handshake_secret,
                      LIBSPDM_MAX_HASH_SIZE);
+    libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                      secured_message_context->handshake_secret.request_handshake_aead_context);
+    libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                      secured_message_context->handshake_secret.response_handshake_aead_context);
+    libspdm_secured_message_free_hmac_contexts(secured_message_context);
     libspdm_zero_mem(&(secured_message_context->handshake_secret),
                      sizeof(libspdm_session_info_struct_handshake_secret_t));
 
@@ -727,6 +742,14 @@ bool libspdm_activate_update_session_data_key(void *spdm_secured_message_context
             secured_message_context->application_secret
             .request_data_sequence_number =
                 secured_message_context->application_secret_backup.request_data_sequence_number;
+            secured_message_context->application_secret.request_data_replay_bitmap =
+                secured_message_context->application_secret_backup.request_data_replay_bitmap;
+            libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                              secured_message_context->application_secret
+                              .request_data_aead_context);
+            secured_message_context->application_secret.request_data_aead_context =
+                secured_message_context->application_secret_backup.request_data_aead_context;
+            secured_message_context->application_secret_backup.request_data_aead_context = NULL;
         } else if ((action == LIBSPDM_KEY_UPDATE_ACTION_RESPONDER) &&
                    secured_message_context->responder_backup_valid) {
             libspdm_copy_mem(&secured_message_context->application_secret
@@ -755,6 +778,14 @@ bool libspdm_activate_update_session_data_key(void *spdm_secured_message_context
                              LIBSPDM_MAX_AEAD_IV_SIZE);
             secured_message_context->application_secret.response_data_sequence_number =
                 secured_message_context->application_secret_backup.response_data_sequence_number;
+            secured_message_context->application_secret.response_data_replay_bitmap =
+                secured_message_context->application_secret_backup.response_data_replay_bitmap;
+            libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                              secured_message_context->application_secret
+                              .response_data_aead_context);
+            secured_message_context->application_secret.response_data_aead_context =
+                secured_message_context->application_secret_backup.response_data_aead_context;
+            secured_message_context->application_secret_backup.response_data_aead_context = NULL;
         }
     }
 
@@ -767,6 +798,11 @@ bool libspdm_activate_update_session_data_key(void *spdm_secured_message_context
         libspdm_zero_mem(&secured_message_context->application_secret_backup.request_data_salt,
                          LIBSPDM_MAX_AEAD_IV_SIZE);
         secured_message_context->application_secret_backup.request_data_sequence_number = 0;
+        secured_message_context->application_secret_backup.request_data_replay_bitmap = 0;
+        libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                          secured_message_context->application_secret_backup
+                          .request_data_aead_context);
+        secured_message_context->application_secret_backup.request_data_aead_context = NULL;
         secured_message_context->requester_backup_valid = false;
     } else if (action == LIBSPDM_KEY_UPDATE_ACTION_RESPONDER) {
         libspdm_zero_mem(&secured_message_context->application_secret_backup.response_data_secret,
@@ -777,6 +813,11 @@ bool libspdm_activate_update_session_data_key(void *spdm_secured_message_context
         libspdm_zero_mem(&secured_message_context->application_secret_backup.response_data_salt,
                          LIBSPDM_MAX_AEAD_IV_SIZE);
         secured_message_context->application_secret_backup.response_data_sequence_number = 0;
+        secured_message_context->application_secret_backup.response_data_replay_bitmap = 0;
+        libspdm_aead_free(secured_message_context->aead_cipher_suite,
+                          secured_message_context->application_secret_backup
+                          .response_data_aead_context);
+        secured_message_context->application_secret_backup.response_data_aead_context = NULL;
         secured_message_context->responder_backup_valid = false;
     }
 
@@ -829,6 +870,11 @@ bool libspdm_hmac_init_with_request_finished_key(
     libspdm_secured_message_context_t *secured_message_context;
 
     secured_message_context = spdm_secured_message_context;
+    if (secured_message_context->handshake_secret.request_finished_key_hmac_context != NULL) {
+        return libspdm_hmac_duplicate(
+            secured_message_context->base_hash_algo,
+            secured_message_context->handshake_secret.request_finished_key_hmac_context, hmac_ctx);
+    }
     return libspdm_hmac_init(
         secured_message_context->base_hash_algo, hmac_ctx,
         secured_message_context->handshake_secret.request_finished_key,
@@ -915,6 +961,12 @@ bool libspdm_hmac_all_with_request_finished_key(void *spdm_secured_message_conte
     libspdm_secured_message_context_t *secured_message_context;
 
     secured_message_context = spdm_secured_message_context;
+    if (secured_message_context->handshake_secret.request_finished_key_hmac_context != NULL) {
+        return libspdm_hmac_all_with_hmac_context(
+            secured_message_context->base_hash_algo,
+            secured_message_context->handshake_secret.request_finished_key_hmac_context,
+            data, data_size, hmac_value);
+    }
     return libspdm_hmac_all(
         secured_message_context->base_hash_algo, data, data_size,
         secured_message_context->handshake_secret.request_finished_key,
@@ -967,6 +1019,11 @@ bool libspdm_hmac_init_with_response_finished_key(
     libspdm_secured_message_context_t *secured_message_context;
 
     secured_message_context = spdm_secured_message_context;
+    if (secured_message_context->handshake_secret.response_finished_key_hmac_context != NULL) {
+        return libspdm_hmac_duplicate(
+            secured_message_context->base_hash_algo,
+            secured_message_context->handshake_secret.response_finished_key_hmac_context, hmac_ctx);
+    }
     return libspdm_hmac_init(
         secured_message_context->base_hash_algo, hmac_ctx,
         secured_message_context->handshake_secret.response_finished_key,
@@ -1053,6 +1110,12 @@ bool libspdm_hmac_all_with_response_finished_key(
     libspdm_secured_message_context_t *secured_message_context;
 
     secured_message_context = spdm_secured_message_context;
+    if (secured_message_context->handshake_secret.response_finished_key_hmac_context != NULL) {
+        return libspdm_hmac_all_with_hmac_context(
+            secured_message_context->base_hash_algo,
+            secured_message_context->handshake_secret.response_finished_key_hmac_context,
+            data, data_size, hmac_value);
+    }
     return libspdm_hmac_all(
         secured_message_context->base_hash_algo, data, data_size,
         secured_message_context->handshake_secret.response_finished_key,
@@ -67,7 +67,8 @@ bool hmac_md_set_key(const mbedtls_md_type_t md_type, void *hmac_md_ctx,
         return false;
     }
 
-    libspdm_zero_mem(hmac_md_ctx, sizeof(mbedtls_md_context_t));
+    /* The context may hold the state of a previous use. */
+    mbedtls_md_free(hmac_md_ctx);
     mbedtls_md_init(hmac_md_ctx);
 
     md_info = mbedtls_md_info_from_type(md_type);
@@ -133,7 +134,8 @@ bool hmac_md_duplicate(const mbedtls_md_type_t md_type, const void *hmac_md_ctx,
         return false;
     }
 
-    libspdm_zero_mem(new_hmac_md_ctx, sizeof(mbedtls_md_context_t));
+    /* The context may hold the state of a previous use. */
+    mbedtls_md_free(new_hmac_md_ctx);
     mbedtls_md_init(new_hmac_md_ctx);
 
     md_info = mbedtls_md_info_from_type(md_type);
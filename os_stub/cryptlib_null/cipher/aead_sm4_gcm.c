@@ -78,3 +78,108 @@ bool libspdm_aead_sm4_gcm_decrypt(const uint8_t *key, size_t key_size,
 {
     return false;
 }
+
+/**
+ * Allocates and initializes one SM4-GCM context for subsequent use.
+ *
+ * @return  Pointer to the SM4-GCM context that has been initialized.
+ *          If the allocation fails, NULL is returned.
+ *
+ **/
+void *libspdm_aead_sm4_gcm_new(void)
+{
+    return NULL;
+}
+
+/**
+ * Release the specified SM4-GCM context.
+ *
+ * @param[in]  aead_ctx  Pointer to the SM4-GCM context to be released.
+ *
+ **/
+void libspdm_aead_sm4_gcm_free(void *aead_ctx)
+{
+}
+
+/**
+ * Sets the key of a SM4-GCM context for subsequent encryption and decryption.
+ *
+ * key_size must be 16, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the SM4-GCM context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  size of the encryption key in bytes.
+ *
+ * @retval true   The key was set successfully.
+ * @retval false  The key was not set.
+ *
+ **/
+bool libspdm_aead_sm4_gcm_set_key(void *aead_ctx, const uint8_t *key, size_t key_size)
+{
+    return false;
+}
+
+/**
+ * Performs AEAD SM4-GCM authenticated encryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * @param[in]   aead_ctx     Pointer to the SM4-GCM context that has been keyed.
+ * @param[in]   iv          Pointer to the IV value.
+ * @param[in]   iv_size      size of the IV value in bytes.
+ * @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+ * @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+ * @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+ * @param[in]   data_in_size  size of the input data buffer in bytes.
+ * @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+ * @param[in]   tag_size     size of the authentication tag in bytes.
+ * @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+ * @param[out]  data_out_size size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD SM4-GCM authenticated encryption succeeded.
+ * @retval false  AEAD SM4-GCM authenticated encryption failed.
+ *
+ **/
+bool libspdm_aead_sm4_gcm_encrypt_with_context(void *aead_ctx,
+                                               const uint8_t *iv, size_t iv_size,
+                                               const uint8_t *a_data, size_t a_data_size,
+                                               const uint8_t *data_in, size_t data_in_size,
+                                               uint8_t *tag_out, size_t tag_size,
+                                               uint8_t *data_out, size_t *data_out_size)
+{
+    return false;
+}
+
+/**
+ * Performs AEAD SM4-GCM authenticated decryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ * If additional authenticated data verification fails, false is returned.
+ *
+ * @param[in]   aead_ctx     Pointer to the SM4-GCM context that has been keyed.
+ * @param[in]   iv          Pointer to the IV value.
+ * @param[in]   iv_size      size of the IV value in bytes.
+ * @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+ * @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+ * @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+ * @param[in]   data_in_size  size of the input data buffer in bytes.
+ * @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+ * @param[in]   tag_size     size of the authentication tag in bytes.
+ * @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+ * @param[out]  data_out_size size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD SM4-GCM authenticated decryption succeeded.
+ * @retval false  AEAD SM4-GCM authenticated decryption failed.
+ *
+ **/
+bool libspdm_aead_sm4_gcm_decrypt_with_context(void *aead_ctx,
+                                               const uint8_t *iv, size_t iv_size,
+                                               const uint8_t *a_data, size_t a_data_size,
+                                               const uint8_t *data_in, size_t data_in_size,
+                                               const uint8_t *tag, size_t tag_size,
+                                               uint8_t *data_out, size_t *data_out_size)
+{
+    return false;
+}
@@ -0,0 +1,32 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Crypto library initialization.
+ **/
+
+#include "internal_crypt_lib.h"
+
+/**
+ * Initialize the crypto library.
+ *
+ * This backend keeps no process-wide state.
+ *
+ * @retval true   The crypto library is ready.
+ **/
+bool libspdm_cryptlib_init(void)
+{
+    return true;
+}
+
+/**
+ * Release the resources held by the crypto library.
+ *
+ * This backend keeps no process-wide state.
+ **/
+void libspdm_cryptlib_deinit(void)
+{
+}
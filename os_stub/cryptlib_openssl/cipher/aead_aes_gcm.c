@@ -15,19 +15,19 @@
 #include <openssl/evp.h>
 
 /**
- * Get AES-GCM cipher name by key size
+ * Get the cached AES-GCM cipher for a key size.
  * @param key_size Key size in bytes (16, 24, or 32)
- * @return Cipher name string or NULL if invalid key size
+ * @return Cipher that the caller frees, or NULL if invalid key size
  */
-static const char *get_aes_gcm_cipher_name(size_t key_size)
+static EVP_CIPHER *fetch_aes_gcm_cipher(size_t key_size)
 {
     switch (key_size) {
     case 16:
-        return "AES-128-GCM";
+        return libspdm_evp_cipher_fetch(LIBSPDM_EVP_CIPHER_AES_128_GCM);
     case 24:
-        return "AES-192-GCM";
+        return libspdm_evp_cipher_fetch(LIBSPDM_EVP_CIPHER_AES_192_GCM);
     case 32:
-        return "AES-256-GCM";
+        return libspdm_evp_cipher_fetch(LIBSPDM_EVP_CIPHER_AES_256_GCM);
     default:
         return NULL;
     }
@@ -68,7 +68,6 @@ bool libspdm_aead_aes_gcm_encrypt(const uint8_t *key, size_t key_size,
     EVP_CIPHER *cipher;
     size_t temp_out_size;
     bool ret_value;
-    const char *cipher_name;
 
     if (data_in_size > INT_MAX) {
         return false;
@@ -80,12 +79,7 @@ bool libspdm_aead_aes_gcm_encrypt(const uint8_t *key, size_t key_size,
         return false;
     }
 
-    cipher_name = get_aes_gcm_cipher_name(key_size);
-    if (cipher_name == NULL) {
-        return false;
-    }
-
-    cipher = EVP_CIPHER_fetch(NULL, cipher_name, NULL);
+    cipher = fetch_aes_gcm_cipher(key_size);
     if (cipher == NULL) {
         return false;
     }
@@ -197,7 +191,6 @@ bool libspdm_aead_aes_gcm_decrypt(const uint8_t *key, size_t key_size,
     EVP_CIPHER *cipher;
     size_t temp_out_size;
     bool ret_value;
-    const char *cipher_name;
 
     if (data_in_size > INT_MAX) {
         return false;
@@ -209,12 +202,7 @@ bool libspdm_aead_aes_gcm_decrypt(const uint8_t *key, size_t key_size,
         return false;
     }
 
-    cipher_name = get_aes_gcm_cipher_name(key_size);
-    if (cipher_name == NULL) {
-        return false;
-    }
-
-    cipher = EVP_CIPHER_fetch(NULL, cipher_name, NULL);
+    cipher = fetch_aes_gcm_cipher(key_size);
     if (cipher == NULL) {
         return false;
     }
@@ -289,3 +277,268 @@ done:
 
     return ret_value;
 }
+
+/**
+ * Allocates and initializes one AES-GCM context for subsequent use.
+ *
+ * @return  Pointer to the AES-GCM context that has been initialized.
+ *          If the allocation fails, NULL is returned.
+ *
+ **/
+void *libspdm_aead_aes_gcm_new(void)
+{
+    return (void *)EVP_CIPHER_CTX_new();
+}
+
+/**
+ * Release the specified AES-GCM context.
+ *
+ * @param[in]  aead_ctx  Pointer to the AES-GCM context to be released.
+ *
+ **/
+void libspdm_aead_aes_gcm_free(void *aead_ctx)
+{
+    if (aead_ctx == NULL) {
+        return;
+    }
+    EVP_CIPHER_CTX_free((EVP_CIPHER_CTX *)aead_ctx);
+}
+
+/**
+ * Sets the key of an AES-GCM context for subsequent encryption and decryption.
+ *
+ * key_size must be 16, 24 or 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the AES-GCM context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  size of the encryption key in bytes.
+ *
+ * @retval true   The key was set successfully.
+ * @retval false  The key was not set.
+ *
+ **/
+bool libspdm_aead_aes_gcm_set_key(void *aead_ctx, const uint8_t *key, size_t key_size)
+{
+    EVP_CIPHER_CTX *ctx;
+    EVP_CIPHER *cipher;
+    bool ret_value;
+
+    if ((aead_ctx == NULL) || (key == NULL)) {
+        return false;
+    }
+    ctx = (EVP_CIPHER_CTX *)aead_ctx;
+
+    cipher = fetch_aes_gcm_cipher(key_size);
+    if (cipher == NULL) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_CipherInit_ex(ctx, cipher, NULL, NULL, NULL, 1);
+    if (!ret_value) {
+        goto done;
+    }
+
+    ret_value = (bool)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+    if (!ret_value) {
+        goto done;
+    }
+
+    ret_value = (bool)EVP_CipherInit_ex(ctx, NULL, NULL, key, NULL, -1);
+
+done:
+    EVP_CIPHER_free(cipher);
+    return ret_value;
+}
+
+/**
+ * Performs AEAD AES-GCM authenticated encryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ *
+ * @param[in]   aead_ctx     Pointer to the AES-GCM context that has been keyed.
+ * @param[in]   iv          Pointer to the IV value.
+ * @param[in]   iv_size      size of the IV value in bytes.
+ * @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+ * @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+ * @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+ * @param[in]   data_in_size  size of the input data buffer in bytes.
+ * @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+ * @param[in]   tag_size     size of the authentication tag in bytes.
+ * @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+ * @param[out]  data_out_size size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated encryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated encryption failed.
+ *
+ **/
+bool libspdm_aead_aes_gcm_encrypt_with_context(void *aead_ctx,
+                                               const uint8_t *iv, size_t iv_size,
+                                               const uint8_t *a_data, size_t a_data_size,
+                                               const uint8_t *data_in, size_t data_in_size,
+                                               uint8_t *tag_out, size_t tag_size,
+                                               uint8_t *data_out, size_t *data_out_size)
+{
+    EVP_CIPHER_CTX *ctx;
+    size_t temp_out_size;
+    bool ret_value;
+
+    if (aead_ctx == NULL) {
+        return false;
+    }
+    if (data_in_size > INT_MAX) {
+        return false;
+    }
+    if (a_data_size > INT_MAX) {
+        return false;
+    }
+    if (iv_size != 12) {
+        return false;
+    }
+    if ((tag_size != 12) && (tag_size != 13) && (tag_size != 14) &&
+        (tag_size != 15) && (tag_size != 16)) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        if ((*data_out_size > INT_MAX) ||
+            (*data_out_size < data_in_size)) {
+            return false;
+        }
+    }
+
+    ctx = (EVP_CIPHER_CTX *)aead_ctx;
+
+    /* Only the IV is reloaded, the expanded key is kept in the context. */
+    ret_value = (bool)EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_EncryptUpdate(
+        ctx, NULL, (int32_t *)&temp_out_size, a_data, (int32_t)a_data_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_EncryptUpdate(ctx, data_out,
+                                        (int32_t *)&temp_out_size, data_in,
+                                        (int32_t)data_in_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_EncryptFinal_ex(ctx, data_out,
+                                          (int32_t *)&temp_out_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_CIPHER_CTX_ctrl(
+        ctx, EVP_CTRL_GCM_GET_TAG, (int32_t)tag_size, (void *)tag_out);
+    if (!ret_value) {
+        return false;
+    }
+
+    if (data_out_size != NULL) {
+        *data_out_size = data_in_size;
+    }
+
+    return true;
+}
+
+/**
+ * Performs AEAD AES-GCM authenticated decryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ * If additional authenticated data verification fails, false is returned.
+ *
+ * @param[in]   aead_ctx     Pointer to the AES-GCM context that has been keyed.
+ * @param[in]   iv          Pointer to the IV value.
+ * @param[in]   iv_size      size of the IV value in bytes.
+ * @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+ * @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+ * @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+ * @param[in]   data_in_size  size of the input data buffer in bytes.
+ * @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+ * @param[in]   tag_size     size of the authentication tag in bytes.
+ * @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+ * @param[out]  data_out_size size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated decryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated decryption failed.
+ *
+ **/
+bool libspdm_aead_aes_gcm_decrypt_with_context(void *aead_ctx,
+                                               const uint8_t *iv, size_t iv_size,
+                                               const uint8_t *a_data, size_t a_data_size,
+                                               const uint8_t *data_in, size_t data_in_size,
+                                               const uint8_t *tag, size_t tag_size,
+                                               uint8_t *data_out, size_t *data_out_size)
+{
+    EVP_CIPHER_CTX *ctx;
+    size_t temp_out_size;
+    bool ret_value;
+
+    if (aead_ctx == NULL) {
+        return false;
+    }
+    if (data_in_size > INT_MAX) {
+        return false;
+    }
+    if (a_data_size > INT_MAX) {
+        return false;
+    }
+    if (iv_size != 12) {
+        return false;
+    }
+    if ((tag_size != 12) && (tag_size != 13) && (tag_size != 14) &&
+        (tag_size != 15) && (tag_size != 16)) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        if ((*data_out_size > INT_MAX) ||
+            (*data_out_size < data_in_size)) {
+            return false;
+        }
+    }
+
+    ctx = (EVP_CIPHER_CTX *)aead_ctx;
+
+    /* Only the IV is reloaded, the expanded key is kept in the context. */
+    ret_value = (bool)EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_DecryptUpdate(
+        ctx, NULL, (int32_t *)&temp_out_size, a_data, (int32_t)a_data_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_DecryptUpdate(ctx, data_out,
+                                        (int32_t *)&temp_out_size, data_in,
+                                        (int32_t)data_in_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG,
+                                          (int32_t)tag_size, (void *)tag);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_DecryptFinal_ex(ctx, data_out,
+                                          (int32_t *)&temp_out_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    if (data_out_size != NULL) {
+        *data_out_size = data_in_size;
+    }
+
+    return true;
+}
@@ -247,3 +247,257 @@ done:
 
     return ret_value;
 }
+
+/**
+ * Allocates and initializes one ChaCha20Poly1305 context for subsequent use.
+ *
+ * @return  Pointer to the ChaCha20Poly1305 context that has been initialized.
+ *          If the allocation fails, NULL is returned.
+ *
+ **/
+void *libspdm_aead_chacha20_poly1305_new(void)
+{
+    return (void *)EVP_CIPHER_CTX_new();
+}
+
+/**
+ * Release the specified ChaCha20Poly1305 context.
+ *
+ * @param[in]  aead_ctx  Pointer to the ChaCha20Poly1305 context to be released.
+ *
+ **/
+void libspdm_aead_chacha20_poly1305_free(void *aead_ctx)
+{
+    if (aead_ctx == NULL) {
+        return;
+    }
+    EVP_CIPHER_CTX_free((EVP_CIPHER_CTX *)aead_ctx);
+}
+
+/**
+ * Sets the key of a ChaCha20Poly1305 context for subsequent encryption and decryption.
+ *
+ * key_size must be 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the ChaCha20Poly1305 context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  size of the encryption key in bytes.
+ *
+ * @retval true   The key was set successfully.
+ * @retval false  The key was not set.
+ *
+ **/
+bool libspdm_aead_chacha20_poly1305_set_key(void *aead_ctx, const uint8_t *key, size_t key_size)
+{
+    EVP_CIPHER_CTX *ctx;
+    bool ret_value;
+
+    if ((aead_ctx == NULL) || (key == NULL)) {
+        return false;
+    }
+    if (key_size != 32) {
+        return false;
+    }
+    ctx = (EVP_CIPHER_CTX *)aead_ctx;
+
+    ret_value = (bool)EVP_CipherInit_ex(ctx, EVP_chacha20_poly1305(), NULL, NULL, NULL, 1);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, 12, NULL);
+    if (!ret_value) {
+        return false;
+    }
+
+    return (bool)EVP_CipherInit_ex(ctx, NULL, NULL, key, NULL, -1);
+}
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated encryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * @param[in]   aead_ctx     Pointer to the ChaCha20Poly1305 context that has been keyed.
+ * @param[in]   iv          Pointer to the IV value.
+ * @param[in]   iv_size      size of the IV value in bytes.
+ * @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+ * @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+ * @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+ * @param[in]   data_in_size  size of the input data buffer in bytes.
+ * @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+ * @param[in]   tag_size     size of the authentication tag in bytes.
+ * @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+ * @param[out]  data_out_size size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated encryption failed.
+ *
+ **/
+bool libspdm_aead_chacha20_poly1305_encrypt_with_context(
+    void *aead_ctx, const uint8_t *iv,
+    size_t iv_size, const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, uint8_t *tag_out,
+    size_t tag_size, uint8_t *data_out, size_t *data_out_size)
+{
+    EVP_CIPHER_CTX *ctx;
+    size_t temp_out_size;
+    bool ret_value;
+
+    if (aead_ctx == NULL) {
+        return false;
+    }
+    if (data_in_size > INT_MAX) {
+        return false;
+    }
+    if (a_data_size > INT_MAX) {
+        return false;
+    }
+    if (iv_size != 12) {
+        return false;
+    }
+    if (tag_size != 16) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        if ((*data_out_size > INT_MAX) ||
+            (*data_out_size < data_in_size)) {
+            return false;
+        }
+    }
+
+    ctx = (EVP_CIPHER_CTX *)aead_ctx;
+
+    /* Only the IV is reloaded, the key is kept in the context. */
+    ret_value = (bool)EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_EncryptUpdate(
+        ctx, NULL, (int32_t *)&temp_out_size, a_data, (int32_t)a_data_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_EncryptUpdate(ctx, data_out,
+                                        (int32_t *)&temp_out_size, data_in,
+                                        (int32_t)data_in_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_EncryptFinal_ex(ctx, data_out,
+                                          (int32_t *)&temp_out_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_CIPHER_CTX_ctrl(
+        ctx, EVP_CTRL_AEAD_GET_TAG, (int32_t)tag_size, (void *)tag_out);
+    if (!ret_value) {
+        return false;
+    }
+
+    if (data_out_size != NULL) {
+        *data_out_size = data_in_size;
+    }
+
+    return true;
+}
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated decryption with a keyed context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ * If additional authenticated data verification fails, false is returned.
+ *
+ * @param[in]   aead_ctx     Pointer to the ChaCha20Poly1305 context that has been keyed.
+ * @param[in]   iv          Pointer to the IV value.
+ * @param[in]   iv_size      size of the IV value in bytes.
+ * @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+ * @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+ * @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+ * @param[in]   data_in_size  size of the input data buffer in bytes.
+ * @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+ * @param[in]   tag_size     size of the authentication tag in bytes.
+ * @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+ * @param[out]  data_out_size size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated decryption failed.
+ *
+ **/
+bool libspdm_aead_chacha20_poly1305_decrypt_with_context(
+    void *aead_ctx, const uint8_t *iv,
+    size_t iv_size, const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, const uint8_t *tag,
+    size_t tag_size, uint8_t *data_out, size_t *data_out_size)
+{
+    EVP_CIPHER_CTX *ctx;
+    size_t temp_out_size;
+    bool ret_value;
+
+    if (aead_ctx == NULL) {
+        return false;
+    }
+    if (data_in_size > INT_MAX) {
+        return false;
+    }
+    if (a_data_size > INT_MAX) {
+        return false;
+    }
+    if (iv_size != 12) {
+        return false;
+    }
+    if (tag_size != 16) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        if ((*data_out_size > INT_MAX) ||
+            (*data_out_size < data_in_size)) {
+            return false;
+        }
+    }
+
+    ctx = (EVP_CIPHER_CTX *)aead_ctx;
+
+    /* Only the IV is reloaded, the key is kept in the context. */
+    ret_value = (bool)EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_DecryptUpdate(
+        ctx, NULL, (int32_t *)&temp_out_size, a_data, (int32_t)a_data_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_DecryptUpdate(ctx, data_out,
+                                        (int32_t *)&temp_out_size, data_in,
+                                        (int32_t)data_in_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG,
+                                          (int32_t)tag_size, (void *)tag);
+    if (!ret_value) {
+        return false;
+    }
+
+    ret_value = (bool)EVP_DecryptFinal_ex(ctx, data_out,
+                                          (int32_t *)&temp_out_size);
+    if (!ret_value) {
+        return false;
+    }
+
+    if (data_out_size != NULL) {
+        *data_out_size = data_in_size;
+    }
+
+    return true;
+}
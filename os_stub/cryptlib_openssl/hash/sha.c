@@ -218,7 +218,7 @@ void libspdm_sha256_free(void *sha256_ctx)
  **/
 bool libspdm_sha256_init(void *sha256_context)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
     if (md == NULL) {
         return false;
     }
@@ -316,7 +316,7 @@ bool libspdm_sha256_final(void *sha256_context, uint8_t *hash_value)
 bool libspdm_sha256_hash_all(const void *data, size_t data_size,
                              uint8_t *hash_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
     if (md == NULL) {
         return false;
     }
@@ -362,7 +362,7 @@ void libspdm_sha384_free(void *sha384_ctx)
  **/
 bool libspdm_sha384_init(void *sha384_context)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
     if (md == NULL) {
         return false;
     }
@@ -462,7 +462,7 @@ bool libspdm_sha384_final(void *sha384_context, uint8_t *hash_value)
 bool libspdm_sha384_hash_all(const void *data, size_t data_size,
                              uint8_t *hash_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
     if (md == NULL) {
         return false;
     }
@@ -508,7 +508,7 @@ void libspdm_sha512_free(void *sha512_ctx)
  **/
 bool libspdm_sha512_init(void *sha512_context)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
     if (md == NULL) {
         return false;
     }
@@ -608,7 +608,7 @@ bool libspdm_sha512_final(void *sha512_context, uint8_t *hash_value)
 bool libspdm_sha512_hash_all(const void *data, size_t data_size,
                              uint8_t *hash_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
     if (md == NULL) {
         return false;
     }
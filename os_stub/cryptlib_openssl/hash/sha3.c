@@ -57,7 +57,7 @@ void libspdm_sha3_256_free(void *sha3_256_ctx)
  **/
 bool libspdm_sha3_256_init(void *sha3_256_context)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
     if (md == NULL) {
         return false;
     }
@@ -157,7 +157,7 @@ bool libspdm_sha3_256_final(void *sha3_256_context, uint8_t *hash_value)
 bool libspdm_sha3_256_hash_all(const void *data, size_t data_size,
                                uint8_t *hash_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
     if (md == NULL) {
         return false;
     }
@@ -203,7 +203,7 @@ void libspdm_sha3_384_free(void *sha3_384_ctx)
  **/
 bool libspdm_sha3_384_init(void *sha3_384_context)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
     if (md == NULL) {
         return false;
     }
@@ -303,7 +303,7 @@ bool libspdm_sha3_384_final(void *sha3_384_context, uint8_t *hash_value)
 bool libspdm_sha3_384_hash_all(const void *data, size_t data_size,
                                uint8_t *hash_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
     if (md == NULL) {
         return false;
     }
@@ -349,7 +349,7 @@ void libspdm_sha3_512_free(void *sha3_512_ctx)
  **/
 bool libspdm_sha3_512_init(void *sha3_512_context)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
     if (md == NULL) {
         return false;
     }
@@ -449,7 +449,7 @@ bool libspdm_sha3_512_final(void *sha3_512_context, uint8_t *hash_value)
 bool libspdm_sha3_512_hash_all(const void *data, size_t data_size,
                                uint8_t *hash_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
     if (md == NULL) {
         return false;
     }
@@ -57,7 +57,7 @@ void libspdm_sm3_256_free(void *sm3_256_ctx)
  **/
 bool libspdm_sm3_256_init(void *sm3_context)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SM3", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
     if (md == NULL) {
         return false;
     }
@@ -156,7 +156,7 @@ bool libspdm_sm3_256_final(void *sm3_context, uint8_t *hash_value)
 bool libspdm_sm3_256_hash_all(const void *data, size_t data_size,
                               uint8_t *hash_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SM3", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
     if (md == NULL) {
         return false;
     }
@@ -33,7 +33,7 @@ void *hmac_md_new(void)
     memset(mac_ctx, 0, sizeof(libspdm_mac_context));
 
     /* Create EVP_MAC context for HMAC using new API */
-    EVP_MAC *mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+    EVP_MAC *mac = libspdm_evp_mac_fetch(LIBSPDM_EVP_MAC_HMAC);
     if (mac == NULL) {
         free(mac_ctx);
         return NULL;
@@ -289,7 +289,7 @@ bool hmac_md_all(const EVP_MD *md, const void *data,
     }
 
     /* Create MAC object and context */
-    mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+    mac = libspdm_evp_mac_fetch(LIBSPDM_EVP_MAC_HMAC);
     if (mac == NULL) {
         goto done;
     }
@@ -375,7 +375,7 @@ void libspdm_hmac_sha256_free(void *hmac_sha256_ctx)
 bool libspdm_hmac_sha256_set_key(void *hmac_sha256_ctx, const uint8_t *key,
                                  size_t key_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
     if (md == NULL) {
         return false;
     }
@@ -476,7 +476,7 @@ bool libspdm_hmac_sha256_all(const void *data, size_t data_size,
                              const uint8_t *key, size_t key_size,
                              uint8_t *hmac_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
     if (md == NULL) {
         return false;
     }
@@ -527,7 +527,7 @@ void libspdm_hmac_sha384_free(void *hmac_sha384_ctx)
 bool libspdm_hmac_sha384_set_key(void *hmac_sha384_ctx, const uint8_t *key,
                                  size_t key_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
     if (md == NULL) {
         return false;
     }
@@ -634,7 +634,7 @@ bool libspdm_hmac_sha384_all(const void *data, size_t data_size,
                              const uint8_t *key, size_t key_size,
                              uint8_t *hmac_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
     if (md == NULL) {
         return false;
     }
@@ -685,7 +685,7 @@ void libspdm_hmac_sha512_free(void *hmac_sha512_ctx)
 bool libspdm_hmac_sha512_set_key(void *hmac_sha512_ctx, const uint8_t *key,
                                  size_t key_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
     if (md == NULL) {
         return false;
     }
@@ -792,7 +792,7 @@ bool libspdm_hmac_sha512_all(const void *data, size_t data_size,
                              const uint8_t *key, size_t key_size,
                              uint8_t *hmac_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
     if (md == NULL) {
         return false;
     }
@@ -63,7 +63,7 @@ void libspdm_hmac_sha3_256_free(void *hmac_sha3_256_ctx)
 bool libspdm_hmac_sha3_256_set_key(void *hmac_sha3_256_ctx, const uint8_t *key,
                                    size_t key_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
     if (md == NULL) {
         return false;
     }
@@ -164,7 +164,7 @@ bool libspdm_hmac_sha3_256_all(const void *data, size_t data_size,
                                const uint8_t *key, size_t key_size,
                                uint8_t *hmac_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
     if (md == NULL) {
         return false;
     }
@@ -215,7 +215,7 @@ void libspdm_hmac_sha3_384_free(void *hmac_sha3_384_ctx)
 bool libspdm_hmac_sha3_384_set_key(void *hmac_sha3_384_ctx, const uint8_t *key,
                                    size_t key_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
     if (md == NULL) {
         return false;
     }
@@ -322,7 +322,7 @@ bool libspdm_hmac_sha3_384_all(const void *data, size_t data_size,
                                const uint8_t *key, size_t key_size,
                                uint8_t *hmac_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
     if (md == NULL) {
         return false;
     }
@@ -373,7 +373,7 @@ void libspdm_hmac_sha3_512_free(void *hmac_sha3_512_ctx)
 bool libspdm_hmac_sha3_512_set_key(void *hmac_sha3_512_ctx, const uint8_t *key,
                                    size_t key_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
     if (md == NULL) {
         return false;
     }
@@ -480,7 +480,7 @@ bool libspdm_hmac_sha3_512_all(const void *data, size_t data_size,
                                const uint8_t *key, size_t key_size,
                                uint8_t *hmac_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
     if (md == NULL) {
         return false;
     }
@@ -63,7 +63,7 @@ void libspdm_hmac_sm3_256_free(void *hmac_sm3_256_ctx)
 bool libspdm_hmac_sm3_256_set_key(void *hmac_sm3_256_ctx, const uint8_t *key,
                                   size_t key_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SM3", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
     if (md == NULL) {
         return false;
     }
@@ -164,7 +164,7 @@ bool libspdm_hmac_sm3_256_all(const void *data, size_t data_size,
                               const uint8_t *key, size_t key_size,
                               uint8_t *hmac_value)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SM3", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
     if (md == NULL) {
         return false;
     }
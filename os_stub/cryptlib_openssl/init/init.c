@@ -0,0 +1,187 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Crypto library initialization and the cache of fetched algorithm objects.
+ *
+ * Fetching an algorithm from the providers takes a lock and a hash table lookup in the library
+ * context. The objects are fetched once and every later use only takes a reference, which is an
+ * atomic increment.
+ **/
+
+#include "internal_crypt_lib.h"
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+#include <openssl/kdf.h>
+
+static const char *const m_libspdm_evp_md_name[LIBSPDM_EVP_MD_COUNT] = {
+    "SHA256",
+    "SHA384",
+    "SHA512",
+    "SHA3-256",
+    "SHA3-384",
+    "SHA3-512",
+    "SM3",
+};
+
+static const char *const m_libspdm_evp_cipher_name[LIBSPDM_EVP_CIPHER_COUNT] = {
+    "AES-128-GCM",
+    "AES-192-GCM",
+    "AES-256-GCM",
+};
+
+static const char *const m_libspdm_evp_mac_name[LIBSPDM_EVP_MAC_COUNT] = {
+    "HMAC",
+};
+
+static const char *const m_libspdm_evp_kdf_name[LIBSPDM_EVP_KDF_COUNT] = {
+    "HKDF",
+};
+
+static EVP_MD *m_libspdm_evp_md[LIBSPDM_EVP_MD_COUNT];
+static EVP_CIPHER *m_libspdm_evp_cipher[LIBSPDM_EVP_CIPHER_COUNT];
+static EVP_MAC *m_libspdm_evp_mac[LIBSPDM_EVP_MAC_COUNT];
+static EVP_KDF *m_libspdm_evp_kdf[LIBSPDM_EVP_KDF_COUNT];
+
+static CRYPTO_ONCE m_libspdm_evp_fetch_once = CRYPTO_ONCE_STATIC_INIT;
+/* Set by libspdm_cryptlib_deinit(). Later calls fetch from the providers directly. */
+static bool m_libspdm_evp_fetch_released;
+
+static void libspdm_evp_fetch_all(void)
+{
+    size_t index;
+
+    /* An algorithm that is not available is left NULL. Its fetch error must not stay on the
+     * error queue of the thread that happened to run the initialization. */
+    ERR_set_mark();
+    for (index = 0; index < LIBSPDM_EVP_MD_COUNT; index++) {
+        m_libspdm_evp_md[index] = EVP_MD_fetch(NULL, m_libspdm_evp_md_name[index], NULL);
+    }
+    for (index = 0; index < LIBSPDM_EVP_CIPHER_COUNT; index++) {
+        m_libspdm_evp_cipher[index] =
+            EVP_CIPHER_fetch(NULL, m_libspdm_evp_cipher_name[index], NULL);
+    }
+    for (index = 0; index < LIBSPDM_EVP_MAC_COUNT; index++) {
+        m_libspdm_evp_mac[index] = EVP_MAC_fetch(NULL, m_libspdm_evp_mac_name[index], NULL);
+    }
+    for (index = 0; index < LIBSPDM_EVP_KDF_COUNT; index++) {
+        m_libspdm_evp_kdf[index] = EVP_KDF_fetch(NULL, m_libspdm_evp_kdf_name[index], NULL);
+    }
+    ERR_pop_to_mark();
+}
+
+static bool libspdm_evp_fetch_is_ready(void)
+{
+    if (m_libspdm_evp_fetch_released) {
+        return false;
+    }
+    return CRYPTO_THREAD_run_once(&m_libspdm_evp_fetch_once, libspdm_evp_fetch_all) == 1;
+}
+
+EVP_MD *libspdm_evp_md_fetch(libspdm_evp_md_id_t md_id)
+{
+    EVP_MD *md;
+
+    if (md_id >= LIBSPDM_EVP_MD_COUNT) {
+        return NULL;
+    }
+    if (libspdm_evp_fetch_is_ready()) {
+        md = m_libspdm_evp_md[md_id];
+        if ((md != NULL) && (EVP_MD_up_ref(md) == 1)) {
+            return md;
+        }
+    }
+    return EVP_MD_fetch(NULL, m_libspdm_evp_md_name[md_id], NULL);
+}
+
+EVP_CIPHER *libspdm_evp_cipher_fetch(libspdm_evp_cipher_id_t cipher_id)
+{
+    EVP_CIPHER *cipher;
+
+    if (cipher_id >= LIBSPDM_EVP_CIPHER_COUNT) {
+        return NULL;
+    }
+    if (libspdm_evp_fetch_is_ready()) {
+        cipher = m_libspdm_evp_cipher[cipher_id];
+        if ((cipher != NULL) && (EVP_CIPHER_up_ref(cipher) == 1)) {
+            return cipher;
+        }
+    }
+    return EVP_CIPHER_fetch(NULL, m_libspdm_evp_cipher_name[cipher_id], NULL);
+}
+
+EVP_MAC *libspdm_evp_mac_fetch(libspdm_evp_mac_id_t mac_id)
+{
+    EVP_MAC *mac;
+
+    if (mac_id >= LIBSPDM_EVP_MAC_COUNT) {
+        return NULL;
+    }
+    if (libspdm_evp_fetch_is_ready()) {
+        mac = m_libspdm_evp_mac[mac_id];
+        if ((mac != NULL) && (EVP_MAC_up_ref(mac) == 1)) {
+            return mac;
+        }
+    }
+    return EVP_MAC_fetch(NULL, m_libspdm_evp_mac_name[mac_id], NULL);
+}
+
+EVP_KDF *libspdm_evp_kdf_fetch(libspdm_evp_kdf_id_t kdf_id)
+{
+    EVP_KDF *kdf;
+
+    if (kdf_id >= LIBSPDM_EVP_KDF_COUNT) {
+        return NULL;
+    }
+    if (libspdm_evp_fetch_is_ready()) {
+        kdf = m_libspdm_evp_kdf[kdf_id];
+        if ((kdf != NULL) && (EVP_KDF_up_ref(kdf) == 1)) {
+            return kdf;
+        }
+    }
+    return EVP_KDF_fetch(NULL, m_libspdm_evp_kdf_name[kdf_id], NULL);
+}
+
+/**
+ * Initialize the crypto library.
+ *
+ * @retval true   The crypto library is ready.
+ * @retval false  The crypto library could not be initialized.
+ **/
+bool libspdm_cryptlib_init(void)
+{
+    return libspdm_evp_fetch_is_ready();
+}
+
+/**
+ * Release the resources held by the crypto library.
+ **/
+void libspdm_cryptlib_deinit(void)
+{
+    size_t index;
+
+    if (!libspdm_evp_fetch_is_ready()) {
+        return;
+    }
+    m_libspdm_evp_fetch_released = true;
+
+    for (index = 0; index < LIBSPDM_EVP_MD_COUNT; index++) {
+        EVP_MD_free(m_libspdm_evp_md[index]);
+        m_libspdm_evp_md[index] = NULL;
+    }
+    for (index = 0; index < LIBSPDM_EVP_CIPHER_COUNT; index++) {
+        EVP_CIPHER_free(m_libspdm_evp_cipher[index]);
+        m_libspdm_evp_cipher[index] = NULL;
+    }
+    for (index = 0; index < LIBSPDM_EVP_MAC_COUNT; index++) {
+        EVP_MAC_free(m_libspdm_evp_mac[index]);
+        m_libspdm_evp_mac[index] = NULL;
+    }
+    for (index = 0; index < LIBSPDM_EVP_KDF_COUNT; index++) {
+        EVP_KDF_free(m_libspdm_evp_kdf[index]);
+        m_libspdm_evp_kdf[index] = NULL;
+    }
+}
@@ -23,6 +23,74 @@
 #include <openssl/opensslv.h>
 #include <openssl/evp.h>
 
+/* Algorithm objects that are fetched once from the default library context and then shared. */
+typedef enum {
+    LIBSPDM_EVP_MD_SHA256,
+    LIBSPDM_EVP_MD_SHA384,
+    LIBSPDM_EVP_MD_SHA512,
+    LIBSPDM_EVP_MD_SHA3_256,
+    LIBSPDM_EVP_MD_SHA3_384,
+    LIBSPDM_EVP_MD_SHA3_512,
+    LIBSPDM_EVP_MD_SM3,
+    LIBSPDM_EVP_MD_COUNT
+} libspdm_evp_md_id_t;
+
+typedef enum {
+    LIBSPDM_EVP_CIPHER_AES_128_GCM,
+    LIBSPDM_EVP_CIPHER_AES_192_GCM,
+    LIBSPDM_EVP_CIPHER_AES_256_GCM,
+    LIBSPDM_EVP_CIPHER_COUNT
+} libspdm_evp_cipher_id_t;
+
+typedef enum {
+    LIBSPDM_EVP_MAC_HMAC,
+    LIBSPDM_EVP_MAC_COUNT
+} libspdm_evp_mac_id_t;
+
+typedef enum {
+    LIBSPDM_EVP_KDF_HKDF,
+    LIBSPDM_EVP_KDF_COUNT
+} libspdm_evp_kdf_id_t;
+
+/**
+ * Get a message digest from the fetch cache.
+ *
+ * It is a drop-in replacement for EVP_MD_fetch(NULL, name, NULL): the caller owns a reference
+ * and releases it with EVP_MD_free().
+ *
+ * @param[in]  md_id  The message digest.
+ *
+ * @return  The message digest, or NULL if no provider implements it.
+ **/
+EVP_MD *libspdm_evp_md_fetch(libspdm_evp_md_id_t md_id);
+
+/**
+ * Get a cipher from the fetch cache. The caller releases it with EVP_CIPHER_free().
+ *
+ * @param[in]  cipher_id  The cipher.
+ *
+ * @return  The cipher, or NULL if no provider implements it.
+ **/
+EVP_CIPHER *libspdm_evp_cipher_fetch(libspdm_evp_cipher_id_t cipher_id);
+
+/**
+ * Get a MAC from the fetch cache. The caller releases it with EVP_MAC_free().
+ *
+ * @param[in]  mac_id  The MAC.
+ *
+ * @return  The MAC, or NULL if no provider implements it.
+ **/
+EVP_MAC *libspdm_evp_mac_fetch(libspdm_evp_mac_id_t mac_id);
+
+/**
+ * Get a KDF from the fetch cache. The caller releases it with EVP_KDF_free().
+ *
+ * @param[in]  kdf_id  The KDF.
+ *
+ * @return  The KDF, or NULL if no provider implements it.
+ **/
+EVP_KDF *libspdm_evp_kdf_fetch(libspdm_evp_kdf_id_t kdf_id);
+
 #if OPENSSL_VERSION_NUMBER < 0x30200000L
 
 #ifndef EVP_PKEY_PRIVATE_KEY
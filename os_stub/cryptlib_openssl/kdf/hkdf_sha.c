@@ -13,6 +13,73 @@
 #include "internal_crypt_lib.h"
 #include <openssl/evp.h>
 #include <openssl/kdf.h>
+#include <openssl/core_names.h>
+
+/**
+ * Run the HKDF provider in one of its modes.
+ *
+ * @param[in]   md         message digest.
+ * @param[in]   mode       EVP_KDF_HKDF_MODE_* value.
+ * @param[in]   key        Pointer to the input keying material, or the PRK in expand mode.
+ * @param[in]   key_size   key size in bytes.
+ * @param[in]   salt       Pointer to the salt(non-secret) value, or NULL in expand mode.
+ * @param[in]   salt_size  salt size in bytes.
+ * @param[in]   info       Pointer to the application specific info, or NULL in extract mode.
+ * @param[in]   info_size  info size in bytes.
+ * @param[out]  out        Pointer to buffer to receive hkdf value.
+ * @param[in]   out_size   size of hkdf bytes to generate.
+ *
+ * @retval true   Hkdf generated successfully.
+ * @retval false  Hkdf generation failed.
+ *
+ **/
+static bool hkdf_md_derive(const EVP_MD *md, int mode,
+                           const uint8_t *key, size_t key_size,
+                           const uint8_t *salt, size_t salt_size,
+                           const uint8_t *info, size_t info_size,
+                           uint8_t *out, size_t out_size)
+{
+    EVP_KDF *kdf;
+    EVP_KDF_CTX *kdf_ctx;
+    OSSL_PARAM params[6];
+    OSSL_PARAM *param;
+    const char *digest_name;
+    bool result;
+
+    digest_name = EVP_MD_get0_name(md);
+    if (digest_name == NULL) {
+        return false;
+    }
+
+    kdf = libspdm_evp_kdf_fetch(LIBSPDM_EVP_KDF_HKDF);
+    if (kdf == NULL) {
+        return false;
+    }
+    kdf_ctx = EVP_KDF_CTX_new(kdf);
+    EVP_KDF_free(kdf);
+    if (kdf_ctx == NULL) {
+        return false;
+    }
+
+    param = params;
+    *param++ = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, (char *)digest_name, 0);
+    *param++ = OSSL_PARAM_construct_int(OSSL_KDF_PARAM_MODE, &mode);
+    *param++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_KEY, (void *)key, key_size);
+    if (salt != NULL) {
+        *param++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT, (void *)salt,
+                                                     salt_size);
+    }
+    if (info != NULL) {
+        *param++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_INFO, (void *)info,
+                                                     info_size);
+    }
+    *param = OSSL_PARAM_construct_end();
+
+    result = EVP_KDF_derive(kdf_ctx, out, out_size, params) > 0;
+
+    EVP_KDF_CTX_free(kdf_ctx);
+    return result;
+}
 
 /**
  * Derive HMAC-based Extract-and-Expand key Derivation Function (HKDF).
@@ -37,43 +104,14 @@ bool hkdf_md_extract_and_expand(const EVP_MD *md, const uint8_t *key,
                                 size_t info_size, uint8_t *out,
                                 size_t out_size)
 {
-    EVP_PKEY_CTX *pkey_ctx;
-    bool result;
-
     if (key == NULL || salt == NULL || info == NULL || out == NULL ||
         key_size > INT_MAX || salt_size > INT_MAX || info_size > INT_MAX ||
         out_size > INT_MAX) {
         return false;
     }
 
-    pkey_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, NULL);
-    if (pkey_ctx == NULL) {
-        return false;
-    }
-
-    result = EVP_PKEY_derive_init(pkey_ctx) > 0;
-    if (result) {
-        result = EVP_PKEY_CTX_set_hkdf_md(pkey_ctx, md) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_set1_hkdf_salt(pkey_ctx, salt,
-                                             (uint32_t)salt_size) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_set1_hkdf_key(pkey_ctx, key,
-                                            (uint32_t)key_size) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_add1_hkdf_info(pkey_ctx, info,
-                                             (uint32_t)info_size) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_derive(pkey_ctx, out, &out_size) > 0;
-    }
-
-    EVP_PKEY_CTX_free(pkey_ctx);
-    pkey_ctx = NULL;
-    return result;
+    return hkdf_md_derive(md, EVP_KDF_HKDF_MODE_EXTRACT_AND_EXPAND, key, key_size,
+                          salt, salt_size, info, info_size, out, out_size);
 }
 
 /**
@@ -96,44 +134,14 @@ bool hkdf_md_extract(const EVP_MD *md, const uint8_t *key,
                      size_t salt_size, uint8_t *prk_out,
                      size_t prk_out_size)
 {
-    EVP_PKEY_CTX *pkey_ctx;
-    bool result;
-
     if (key == NULL || salt == NULL || prk_out == NULL ||
         key_size > INT_MAX || salt_size > INT_MAX ||
         prk_out_size > INT_MAX) {
         return false;
     }
 
-    pkey_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, NULL);
-    if (pkey_ctx == NULL) {
-        return false;
-    }
-
-    result = EVP_PKEY_derive_init(pkey_ctx) > 0;
-    if (result) {
-        result = EVP_PKEY_CTX_set_hkdf_md(pkey_ctx, md) > 0;
-    }
-    if (result) {
-        result =
-            EVP_PKEY_CTX_hkdf_mode(
-                pkey_ctx, EVP_PKEY_HKDEF_MODE_EXTRACT_ONLY) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_set1_hkdf_salt(pkey_ctx, salt,
-                                             (uint32_t)salt_size) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_set1_hkdf_key(pkey_ctx, key,
-                                            (uint32_t)key_size) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_derive(pkey_ctx, prk_out, &prk_out_size) > 0;
-    }
-
-    EVP_PKEY_CTX_free(pkey_ctx);
-    pkey_ctx = NULL;
-    return result;
+    return hkdf_md_derive(md, EVP_KDF_HKDF_MODE_EXTRACT_ONLY, key, key_size,
+                          salt, salt_size, NULL, 0, prk_out, prk_out_size);
 }
 
 /**
@@ -155,42 +163,13 @@ bool hkdf_md_expand(const EVP_MD *md, const uint8_t *prk,
                     size_t prk_size, const uint8_t *info,
                     size_t info_size, uint8_t *out, size_t out_size)
 {
-    EVP_PKEY_CTX *pkey_ctx;
-    bool result;
-
     if (prk == NULL || info == NULL || out == NULL || prk_size > INT_MAX ||
         info_size > INT_MAX || out_size > INT_MAX) {
         return false;
     }
 
-    pkey_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, NULL);
-    if (pkey_ctx == NULL) {
-        return false;
-    }
-
-    result = EVP_PKEY_derive_init(pkey_ctx) > 0;
-    if (result) {
-        result = EVP_PKEY_CTX_set_hkdf_md(pkey_ctx, md) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_hkdf_mode(
-            pkey_ctx, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_set1_hkdf_key(pkey_ctx, prk,
-                                            (uint32_t)prk_size) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_CTX_add1_hkdf_info(pkey_ctx, info,
-                                             (uint32_t)info_size) > 0;
-    }
-    if (result) {
-        result = EVP_PKEY_derive(pkey_ctx, out, &out_size) > 0;
-    }
-
-    EVP_PKEY_CTX_free(pkey_ctx);
-    pkey_ctx = NULL;
-    return result;
+    return hkdf_md_derive(md, EVP_KDF_HKDF_MODE_EXPAND_ONLY, prk, prk_size,
+                          NULL, 0, info, info_size, out, out_size);
 }
 
 /**
@@ -214,7 +193,7 @@ bool libspdm_hkdf_sha256_extract_and_expand(const uint8_t *key, size_t key_size,
                                             const uint8_t *info, size_t info_size,
                                             uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
     if (md == NULL) {
         return false;
     }
@@ -243,7 +222,7 @@ bool libspdm_hkdf_sha256_extract(const uint8_t *key, size_t key_size,
                                  const uint8_t *salt, size_t salt_size,
                                  uint8_t *prk_out, size_t prk_out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
     if (md == NULL) {
         return false;
     }
@@ -271,7 +250,7 @@ bool libspdm_hkdf_sha256_expand(const uint8_t *prk, size_t prk_size,
                                 const uint8_t *info, size_t info_size,
                                 uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
     if (md == NULL) {
         return false;
     }
@@ -302,7 +281,7 @@ bool libspdm_hkdf_sha384_extract_and_expand(const uint8_t *key, size_t key_size,
                                             const uint8_t *info, size_t info_size,
                                             uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
     if (md == NULL) {
         return false;
     }
@@ -331,7 +310,7 @@ bool libspdm_hkdf_sha384_extract(const uint8_t *key, size_t key_size,
                                  const uint8_t *salt, size_t salt_size,
                                  uint8_t *prk_out, size_t prk_out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
     if (md == NULL) {
         return false;
     }
@@ -359,7 +338,7 @@ bool libspdm_hkdf_sha384_expand(const uint8_t *prk, size_t prk_size,
                                 const uint8_t *info, size_t info_size,
                                 uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
     if (md == NULL) {
         return false;
     }
@@ -390,7 +369,7 @@ bool libspdm_hkdf_sha512_extract_and_expand(const uint8_t *key, size_t key_size,
                                             const uint8_t *info, size_t info_size,
                                             uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
     if (md == NULL) {
         return false;
     }
@@ -419,7 +398,7 @@ bool libspdm_hkdf_sha512_extract(const uint8_t *key, size_t key_size,
                                  const uint8_t *salt, size_t salt_size,
                                  uint8_t *prk_out, size_t prk_out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
     if (md == NULL) {
         return false;
     }
@@ -447,7 +426,7 @@ bool libspdm_hkdf_sha512_expand(const uint8_t *prk, size_t prk_size,
                                 const uint8_t *info, size_t info_size,
                                 uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
     if (md == NULL) {
         return false;
     }
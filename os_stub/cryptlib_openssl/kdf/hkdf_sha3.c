@@ -48,7 +48,7 @@ bool libspdm_hkdf_sha3_256_extract_and_expand(const uint8_t *key, size_t key_siz
                                               const uint8_t *info, size_t info_size,
                                               uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
     if (md == NULL) {
         return false;
     }
@@ -77,7 +77,7 @@ bool libspdm_hkdf_sha3_256_extract(const uint8_t *key, size_t key_size,
                                    const uint8_t *salt, size_t salt_size,
                                    uint8_t *prk_out, size_t prk_out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
     if (md == NULL) {
         return false;
     }
@@ -105,7 +105,7 @@ bool libspdm_hkdf_sha3_256_expand(const uint8_t *prk, size_t prk_size,
                                   const uint8_t *info, size_t info_size,
                                   uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
     if (md == NULL) {
         return false;
     }
@@ -136,7 +136,7 @@ bool libspdm_hkdf_sha3_384_extract_and_expand(const uint8_t *key, size_t key_siz
                                               const uint8_t *info, size_t info_size,
                                               uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
     if (md == NULL) {
         return false;
     }
@@ -165,7 +165,7 @@ bool libspdm_hkdf_sha3_384_extract(const uint8_t *key, size_t key_size,
                                    const uint8_t *salt, size_t salt_size,
                                    uint8_t *prk_out, size_t prk_out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
     if (md == NULL) {
         return false;
     }
@@ -193,7 +193,7 @@ bool libspdm_hkdf_sha3_384_expand(const uint8_t *prk, size_t prk_size,
                                   const uint8_t *info, size_t info_size,
                                   uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
     if (md == NULL) {
         return false;
     }
@@ -224,7 +224,7 @@ bool libspdm_hkdf_sha3_512_extract_and_expand(const uint8_t *key, size_t key_siz
                                               const uint8_t *info, size_t info_size,
                                               uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
     if (md == NULL) {
         return false;
     }
@@ -253,7 +253,7 @@ bool libspdm_hkdf_sha3_512_extract(const uint8_t *key, size_t key_size,
                                    const uint8_t *salt, size_t salt_size,
                                    uint8_t *prk_out, size_t prk_out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
     if (md == NULL) {
         return false;
     }
@@ -281,7 +281,7 @@ bool libspdm_hkdf_sha3_512_expand(const uint8_t *prk, size_t prk_size,
                                   const uint8_t *info, size_t info_size,
                                   uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
     if (md == NULL) {
         return false;
     }
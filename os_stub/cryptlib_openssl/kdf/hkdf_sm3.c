@@ -48,7 +48,7 @@ bool libspdm_hkdf_sm3_256_extract_and_expand(const uint8_t *key, size_t key_size
                                              const uint8_t *info, size_t info_size,
                                              uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SM3", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
     if (md == NULL) {
         return false;
     }
@@ -77,7 +77,7 @@ bool libspdm_hkdf_sm3_256_extract(const uint8_t *key, size_t key_size,
                                   const uint8_t *salt, size_t salt_size,
                                   uint8_t *prk_out, size_t prk_out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SM3", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
     if (md == NULL) {
         return false;
     }
@@ -105,7 +105,7 @@ bool libspdm_hkdf_sm3_256_expand(const uint8_t *prk, size_t prk_size,
                                  const uint8_t *info, size_t info_size,
                                  uint8_t *out, size_t out_size)
 {
-    EVP_MD *md = EVP_MD_fetch(NULL, "SM3", NULL);
+    EVP_MD *md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
     if (md == NULL) {
         return false;
     }
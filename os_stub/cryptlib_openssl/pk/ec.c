@@ -694,42 +694,42 @@ bool libspdm_ecdsa_sign(void *ec_context, size_t hash_nid,
         if (hash_size != LIBSPDM_SHA256_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA256", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA384:
         if (hash_size != LIBSPDM_SHA384_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA384", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA512:
         if (hash_size != LIBSPDM_SHA512_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA512", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA3_256:
         if (hash_size != LIBSPDM_SHA3_256_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA3_384:
         if (hash_size != LIBSPDM_SHA3_384_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA3_512:
         if (hash_size != LIBSPDM_SHA3_512_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
         break;
 
     default:
@@ -838,42 +838,42 @@ bool libspdm_ecdsa_verify(void *ec_context, size_t hash_nid,
         if (hash_size != LIBSPDM_SHA256_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA256", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA384:
         if (hash_size != LIBSPDM_SHA384_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA384", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA512:
         if (hash_size != LIBSPDM_SHA512_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA512", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA3_256:
         if (hash_size != LIBSPDM_SHA3_256_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA3_384:
         if (hash_size != LIBSPDM_SHA3_384_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
         break;
 
     case LIBSPDM_CRYPTO_NID_SHA3_512:
         if (hash_size != LIBSPDM_SHA3_512_DIGEST_SIZE) {
             return false;
         }
-        md_type = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+        md_type = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
         break;
 
     default:
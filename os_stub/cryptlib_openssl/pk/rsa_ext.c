@@ -420,37 +420,37 @@ bool libspdm_rsa_pkcs1_sign_with_nid(void *rsa_context, size_t hash_nid,
         if (hash_size != LIBSPDM_SHA256_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA256", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA384:
         if (hash_size != LIBSPDM_SHA384_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA384", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA512:
         if (hash_size != LIBSPDM_SHA512_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA512", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_256:
         if (hash_size != LIBSPDM_SHA3_256_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_384:
         if (hash_size != LIBSPDM_SHA3_384_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_512:
         if (hash_size != LIBSPDM_SHA3_512_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
         break;
     default:
         return false;
@@ -527,37 +527,37 @@ bool libspdm_rsa_pss_sign(void *rsa_context, size_t hash_nid,
         if (hash_size != LIBSPDM_SHA256_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA256", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA384:
         if (hash_size != LIBSPDM_SHA384_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA384", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA512:
         if (hash_size != LIBSPDM_SHA512_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA512", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_256:
         if (hash_size != LIBSPDM_SHA3_256_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_384:
         if (hash_size != LIBSPDM_SHA3_384_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_512:
         if (hash_size != LIBSPDM_SHA3_512_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
         break;
     default:
         return false;
@@ -633,37 +633,37 @@ bool libspdm_rsa_pss_sign_fips(void *rsa_context, size_t hash_nid,
         if (hash_size != LIBSPDM_SHA256_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA256", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA384:
         if (hash_size != LIBSPDM_SHA384_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA384", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA512:
         if (hash_size != LIBSPDM_SHA512_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA512", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_256:
         if (hash_size != LIBSPDM_SHA3_256_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_384:
         if (hash_size != LIBSPDM_SHA3_384_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_512:
         if (hash_size != LIBSPDM_SHA3_512_DIGEST_SIZE) {
             return false;
         }
-        evp_md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+        evp_md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
         break;
     default:
         return false;
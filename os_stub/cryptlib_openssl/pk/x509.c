@@ -2663,25 +2663,25 @@ bool libspdm_gen_x509_csr_with_pqc(
         md = NULL;
         break;
     case LIBSPDM_CRYPTO_NID_SHA256:
-        md = EVP_MD_fetch(NULL, "SHA256", NULL);
+        md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA384:
-        md = EVP_MD_fetch(NULL, "SHA384", NULL);
+        md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA512:
-        md = EVP_MD_fetch(NULL, "SHA512", NULL);
+        md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA512);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_256:
-        md = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+        md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_256);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_384:
-        md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+        md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_384);
         break;
     case LIBSPDM_CRYPTO_NID_SHA3_512:
-        md = EVP_MD_fetch(NULL, "SHA3-512", NULL);
+        md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SHA3_512);
         break;
     case LIBSPDM_CRYPTO_NID_SM3_256:
-        md = EVP_MD_fetch(NULL, "SM3", NULL);
+        md = libspdm_evp_md_fetch(LIBSPDM_EVP_MD_SM3);
         break;
     default:
         ret = 0;
@@ -11,6 +11,15 @@
 #ifndef __RNG_LIB_H__
 #define __RNG_LIB_H__
 
+typedef enum {
+    /* The random number source is working normally. */
+    LIBSPDM_RNG_HEALTH_OK,
+    /* The preferred source is unavailable and random numbers come from a fallback source. */
+    LIBSPDM_RNG_HEALTH_FALLBACK,
+    /* The last request for a random number failed. */
+    LIBSPDM_RNG_HEALTH_FAILED,
+} libspdm_rng_health_t;
+
 /**
  * Generates a 64-bit random number.
  *
@@ -24,4 +33,13 @@
  **/
 bool libspdm_get_random_number_64(uint64_t *rand_data);
 
+/**
+ * Return the health state of the random number source.
+ *
+ * The state reflects the most recent call to libspdm_get_random_number_64() from any thread.
+ *
+ * @return The health state of the random number source.
+ **/
+libspdm_rng_health_t libspdm_get_random_number_health(void);
+
 #endif /* __RNG_LIB_H__*/
@@ -0,0 +1,75 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "library/debuglib.h"
+#include "hal/library/memlib.h"
+#include "memlib_optimized.h"
+
+void libspdm_copy_mem(void *dst_buf, size_t dst_len,
+                      const void *src_buf, size_t src_len)
+{
+    volatile uint8_t* dst;
+    const volatile uint8_t* src;
+
+    dst = (volatile uint8_t*) dst_buf;
+    src = (const volatile uint8_t*) src_buf;
+
+    if ((dst == NULL) || (src == NULL)) {
+        LIBSPDM_ASSERT(0);
+    }
+    if (((src < dst) && ((src + src_len) > dst)) || ((dst < src) && ((dst + src_len) > src))) {
+        LIBSPDM_ASSERT(0);
+    }
+    if (src_len > dst_len) {
+        LIBSPDM_ASSERT(0);
+    }
+
+#if defined(LIBSPDM_MEMLIB_AVX2)
+    while (src_len >= sizeof(__m256i)) {
+        _mm256_storeu_si256((__m256i *)(uintptr_t)dst,
+                            _mm256_loadu_si256((const __m256i *)(uintptr_t)src));
+        dst += sizeof(__m256i);
+        src += sizeof(__m256i);
+        src_len -= sizeof(__m256i);
+    }
+#endif
+
+#if defined(LIBSPDM_MEMLIB_SSE2)
+    while (src_len >= sizeof(__m128i)) {
+        _mm_storeu_si128((__m128i *)(uintptr_t)dst,
+                         _mm_loadu_si128((const __m128i *)(uintptr_t)src));
+        dst += sizeof(__m128i);
+        src += sizeof(__m128i);
+        src_len -= sizeof(__m128i);
+    }
+#elif defined(LIBSPDM_MEMLIB_NEON)
+    while (src_len >= sizeof(uint8x16_t)) {
+        vst1q_u8((uint8_t *)(uintptr_t)dst, vld1q_u8((const uint8_t *)(uintptr_t)src));
+        dst += sizeof(uint8x16_t);
+        src += sizeof(uint8x16_t);
+        src_len -= sizeof(uint8x16_t);
+    }
+#else
+    /* Word copies are only possible when both buffers share the same misalignment. */
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & (LIBSPDM_MEM_WORD_SIZE - 1)) == 0) {
+        while (!LIBSPDM_MEM_IS_WORD_ALIGNED(dst) && (src_len != 0)) {
+            *(dst++) = *(src++);
+            src_len--;
+        }
+        while (src_len >= LIBSPDM_MEM_WORD_SIZE) {
+            *(volatile libspdm_mem_word_t *)(uintptr_t)dst =
+                *(const volatile libspdm_mem_word_t *)(uintptr_t)src;
+            dst += LIBSPDM_MEM_WORD_SIZE;
+            src += LIBSPDM_MEM_WORD_SIZE;
+            src_len -= LIBSPDM_MEM_WORD_SIZE;
+        }
+    }
+#endif
+
+    while (src_len-- != 0) {
+        *(dst++) = *(src++);
+    }
+}
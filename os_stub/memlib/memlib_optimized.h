@@ -0,0 +1,43 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Vector and word definitions shared by the optimized memlib variant.
+ *
+ * Loops that move whole words go through volatile pointers so that the compiler cannot turn them
+ * back into calls to the C library, which may not exist in the target environment.
+ **/
+
+#ifndef MEMLIB_OPTIMIZED_H
+#define MEMLIB_OPTIMIZED_H
+
+#include "hal/base.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LIBSPDM_MEMLIB_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define LIBSPDM_MEMLIB_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LIBSPDM_MEMLIB_NEON 1
+#endif
+
+#if defined(__GNUC__)
+typedef size_t __attribute__((__may_alias__)) libspdm_mem_word_t;
+#else
+typedef size_t libspdm_mem_word_t;
+#endif
+
+#define LIBSPDM_MEM_WORD_SIZE sizeof(libspdm_mem_word_t)
+
+#define LIBSPDM_MEM_IS_WORD_ALIGNED(pointer) \
+    ((((uintptr_t)(pointer)) & (LIBSPDM_MEM_WORD_SIZE - 1)) == 0)
+
+#endif /* MEMLIB_OPTIMIZED_H */
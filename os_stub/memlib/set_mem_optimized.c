@@ -0,0 +1,72 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "hal/library/memlib.h"
+#include "memlib_optimized.h"
+
+void libspdm_set_mem(void *buffer, size_t length, uint8_t value)
+{
+    volatile uint8_t *pointer;
+
+    pointer = (uint8_t *)buffer;
+
+#if defined(LIBSPDM_MEMLIB_AVX2)
+    if (length >= sizeof(__m256i)) {
+        __m256i fill;
+
+        fill = _mm256_set1_epi8((char)value);
+        while (length >= sizeof(__m256i)) {
+            _mm256_storeu_si256((__m256i *)(uintptr_t)pointer, fill);
+            pointer += sizeof(__m256i);
+            length -= sizeof(__m256i);
+        }
+    }
+#endif
+
+#if defined(LIBSPDM_MEMLIB_SSE2)
+    if (length >= sizeof(__m128i)) {
+        __m128i fill;
+
+        fill = _mm_set1_epi8((char)value);
+        while (length >= sizeof(__m128i)) {
+            _mm_storeu_si128((__m128i *)(uintptr_t)pointer, fill);
+            pointer += sizeof(__m128i);
+            length -= sizeof(__m128i);
+        }
+    }
+#elif defined(LIBSPDM_MEMLIB_NEON)
+    if (length >= sizeof(uint8x16_t)) {
+        uint8x16_t fill;
+
+        fill = vdupq_n_u8(value);
+        while (length >= sizeof(uint8x16_t)) {
+            vst1q_u8((uint8_t *)(uintptr_t)pointer, fill);
+            pointer += sizeof(uint8x16_t);
+            length -= sizeof(uint8x16_t);
+        }
+    }
+#else
+    if (length >= LIBSPDM_MEM_WORD_SIZE) {
+        libspdm_mem_word_t fill;
+
+        /* Replicate the byte into every byte of the word. */
+        fill = ((libspdm_mem_word_t)-1 / 0xFF) * value;
+        while (!LIBSPDM_MEM_IS_WORD_ALIGNED(pointer)) {
+            *(pointer++) = value;
+            length--;
+        }
+        while (length >= LIBSPDM_MEM_WORD_SIZE) {
+            *(volatile libspdm_mem_word_t *)(uintptr_t)pointer = fill;
+            pointer += LIBSPDM_MEM_WORD_SIZE;
+            length -= LIBSPDM_MEM_WORD_SIZE;
+        }
+    }
+#endif
+
+    while (length-- != 0) {
+        *(pointer++) = value;
+    }
+}
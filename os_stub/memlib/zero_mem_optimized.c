@@ -0,0 +1,44 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "hal/library/memlib.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(_GNU_SOURCE) || defined(_BSD_SOURCE)
+#include <strings.h>
+#include <string.h>
+#endif
+
+void libspdm_zero_mem(void *buffer, size_t length)
+{
+
+#if defined(__STDC_LIB_EXT1__)
+    memset_s(buffer, length, 0, length);
+#elif defined(_WIN32)
+    SecureZeroMemory(buffer, length);
+#elif defined(_GNU_SOURCE) || defined(_BSD_SOURCE)
+    explicit_bzero(buffer, length);
+#elif defined(__GNUC__)
+    libspdm_set_mem(buffer, length, 0);
+
+    /* The buffer is an input to the barrier, which may read it, so the stores above cannot be
+     * removed as dead even if libspdm_set_mem is inlined by link-time optimization. */
+    __asm__ __volatile__ ("" : : "r" (buffer) : "memory");
+#else
+    volatile uint8_t *pointer;
+
+    pointer = (uint8_t *)buffer;
+    while (length-- != 0) {
+        *(pointer++) = 0;
+    }
+
+#if defined(_MSC_VER) && (_MSC_VER > 1200) && !defined(__clang__)
+    _ReadWriteBarrier();
+#endif
+
+#endif
+}
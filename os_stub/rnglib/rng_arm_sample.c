@@ -7,6 +7,7 @@
 #include <base.h>
 #include <stdlib.h>
 #include <assert.h>
+#include "library/rnglib.h"
 
 /**
  * Generates a 64-bit random number.
@@ -24,3 +25,13 @@ bool libspdm_get_random_number_64(uint64_t *rand_data)
     /*the feature for armclang build is TBD*/
     return true;
 }
+
+/**
+ * Return the health state of the random number source.
+ *
+ * @retval LIBSPDM_RNG_HEALTH_OK        This source does not report failures.
+ **/
+libspdm_rng_health_t libspdm_get_random_number_health(void)
+{
+    return LIBSPDM_RNG_HEALTH_OK;
+}
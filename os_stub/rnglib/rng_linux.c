@@ -4,12 +4,174 @@
  *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
  **/
 
+/* O_CLOEXEC is only exposed by the C library when POSIX.1-2008 interfaces are requested. */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
 #include <base.h>
 #include <stdlib.h>
 #include "stdio.h"
+#include <string.h>
+#include <errno.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <assert.h>
+#include "library/rnglib.h"
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 25)))
+#include <sys/random.h>
+#define LIBSPDM_RNG_HAS_GETRANDOM 1
+#else
+#define LIBSPDM_RNG_HAS_GETRANDOM 0
+#endif
+
+/* Size in bytes of the per-thread block that is refilled from the kernel in one request.
+ * Each 64-bit value handed out is wiped from the block, and the block is discarded in a forked child.
+ * Set to 0 to request every value from the kernel directly. */
+#ifndef LIBSPDM_RNG_BUFFER_SIZE
+#define LIBSPDM_RNG_BUFFER_SIZE 256
+#endif
+
+#if (LIBSPDM_RNG_BUFFER_SIZE % 8) != 0
+#error LIBSPDM_RNG_BUFFER_SIZE must be a multiple of 8.
+#endif
+
+/* Set once getrandom(2) has been found missing; /dev/urandom is used from then on. */
+static volatile int m_libspdm_rng_use_fallback = !LIBSPDM_RNG_HAS_GETRANDOM;
+/* /dev/urandom descriptor, opened on first use and kept open for the life of the process. */
+static volatile int m_libspdm_rng_fallback_fd = -1;
+static volatile libspdm_rng_health_t m_libspdm_rng_health = LIBSPDM_RNG_HEALTH_OK;
+
+/* The previous value returned on this thread, for the repetition test. */
+static __thread uint64_t m_libspdm_rng_last_value;
+static __thread bool m_libspdm_rng_has_last_value;
+
+#if LIBSPDM_RNG_BUFFER_SIZE > 0
+static __thread uint8_t m_libspdm_rng_buffer[LIBSPDM_RNG_BUFFER_SIZE];
+static __thread size_t m_libspdm_rng_buffer_offset = LIBSPDM_RNG_BUFFER_SIZE;
+static volatile int m_libspdm_rng_atfork_registered;
+
+/* Runs in the child on the thread that called fork(), which is the only thread whose buffer survives. */
+static void libspdm_rng_atfork_child(void)
+{
+    memset(m_libspdm_rng_buffer, 0, sizeof(m_libspdm_rng_buffer));
+    m_libspdm_rng_buffer_offset = LIBSPDM_RNG_BUFFER_SIZE;
+    m_libspdm_rng_has_last_value = false;
+}
+#endif
+
+static int libspdm_rng_get_fallback_fd(void)
+{
+    int fd;
+
+    fd = m_libspdm_rng_fallback_fd;
+    if (fd >= 0) {
+        return fd;
+    }
+
+    do {
+        fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    } while ((fd < 0) && (errno == EINTR));
+    if (fd < 0) {
+        printf("cannot open /dev/urandom\n");
+        return -1;
+    }
+
+    /* Another thread may have raced to open the device. Keep whichever descriptor was stored first. */
+    if (!__sync_bool_compare_and_swap(&m_libspdm_rng_fallback_fd, -1, fd)) {
+        close(fd);
+        fd = m_libspdm_rng_fallback_fd;
+    }
+
+    return fd;
+}
+
+/**
+ * Fill a buffer from the kernel random number generator.
+ *
+ * getrandom(2) is preferred. If the kernel does not provide it then /dev/urandom is read through a
+ * descriptor that stays open across calls.
+ **/
+static bool libspdm_rng_read_kernel(uint8_t *buffer, size_t size)
+{
+    ssize_t result;
+    int fd;
+
+#if LIBSPDM_RNG_HAS_GETRANDOM
+    while ((size != 0) && !m_libspdm_rng_use_fallback) {
+        result = getrandom(buffer, size, 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOSYS) {
+                m_libspdm_rng_use_fallback = 1;
+                break;
+            }
+            printf("getrandom failed (errno %d)\n", errno);
+            return false;
+        }
+        buffer += result;
+        size -= (size_t)result;
+    }
+#endif
+
+    if (size == 0) {
+        return true;
+    }
+
+    fd = libspdm_rng_get_fallback_fd();
+    if (fd < 0) {
+        return false;
+    }
+    while (size != 0) {
+        result = read(fd, buffer, size);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("Cannot read /dev/urandom\n");
+            return false;
+        }
+        if (result == 0) {
+            printf("Cannot read /dev/urandom\n");
+            return false;
+        }
+        buffer += result;
+        size -= (size_t)result;
+    }
+
+    return true;
+}
+
+static bool libspdm_rng_get_value(uint64_t *rand_data)
+{
+#if LIBSPDM_RNG_BUFFER_SIZE > 0
+    if (m_libspdm_rng_buffer_offset >= LIBSPDM_RNG_BUFFER_SIZE) {
+        if (!m_libspdm_rng_atfork_registered) {
+            /* Registering twice from racing threads is harmless since the handler is idempotent. */
+            if (pthread_atfork(NULL, NULL, libspdm_rng_atfork_child) != 0) {
+                return false;
+            }
+            m_libspdm_rng_atfork_registered = 1;
+        }
+        if (!libspdm_rng_read_kernel(m_libspdm_rng_buffer, sizeof(m_libspdm_rng_buffer))) {
+            return false;
+        }
+        m_libspdm_rng_buffer_offset = 0;
+    }
+
+    memcpy(rand_data, m_libspdm_rng_buffer + m_libspdm_rng_buffer_offset, sizeof(*rand_data));
+    memset(m_libspdm_rng_buffer + m_libspdm_rng_buffer_offset, 0, sizeof(*rand_data));
+    m_libspdm_rng_buffer_offset += sizeof(*rand_data);
+
+    return true;
+#else
+    return libspdm_rng_read_kernel((uint8_t *)rand_data, sizeof(*rand_data));
+#endif
+}
 
 /**
  * Generates a 64-bit random number.
@@ -24,21 +186,36 @@
  **/
 bool libspdm_get_random_number_64(uint64_t *rand_data)
 {
-    int fd;
-
     assert(rand_data != NULL);
 
-    fd = open("/dev/urandom", O_RDONLY);
-    if (fd < 0) {
-        printf("cannot open /dev/urandom\n");
+    if (!libspdm_rng_get_value(rand_data)) {
+        m_libspdm_rng_health = LIBSPDM_RNG_HEALTH_FAILED;
         return false;
     }
-    if (read(fd, rand_data, sizeof(*rand_data)) != sizeof(*rand_data)) {
-        printf("Cannot read /dev/urandom\n");
-        close(fd);
+
+    /* A 64-bit repetition has probability 2^-64 from a working source, so treat it as a stuck source. */
+    if (m_libspdm_rng_has_last_value && (*rand_data == m_libspdm_rng_last_value)) {
+        printf("random number source repeated its output\n");
+        m_libspdm_rng_health = LIBSPDM_RNG_HEALTH_FAILED;
         return false;
     }
-    close(fd);
+    m_libspdm_rng_last_value = *rand_data;
+    m_libspdm_rng_has_last_value = true;
+
+    m_libspdm_rng_health = m_libspdm_rng_use_fallback ? LIBSPDM_RNG_HEALTH_FALLBACK :
+                           LIBSPDM_RNG_HEALTH_OK;
 
     return true;
 }
+
+/**
+ * Return the health state of the random number source.
+ *
+ * @retval LIBSPDM_RNG_HEALTH_OK        The last request was served by getrandom(2).
+ * @retval LIBSPDM_RNG_HEALTH_FALLBACK  The last request was served by /dev/urandom.
+ * @retval LIBSPDM_RNG_HEALTH_FAILED    The last request failed.
+ **/
+libspdm_rng_health_t libspdm_get_random_number_health(void)
+{
+    return m_libspdm_rng_health;
+}
@@ -10,9 +10,12 @@
 #include <bcrypt.h>
 #include <stdio.h>
 #include <assert.h>
+#include "library/rnglib.h"
 
 #pragma comment(lib, "Bcrypt")
 
+static volatile libspdm_rng_health_t m_libspdm_rng_health = LIBSPDM_RNG_HEALTH_OK;
+
 /**
  * Generates a 64-bit random number.
  *
@@ -32,14 +35,28 @@ bool libspdm_get_random_number_64(uint64_t *rand_data)
 
     if(!BCRYPT_SUCCESS(BCryptOpenAlgorithmProvider(&Prov, BCRYPT_RNG_ALGORITHM,
                                                    NULL, 0))) {
+        m_libspdm_rng_health = LIBSPDM_RNG_HEALTH_FAILED;
         return false;
     }
     if(!BCRYPT_SUCCESS(BCryptGenRandom(Prov, (PUCHAR)rand_data,
                                        sizeof(*rand_data), 0))) {
         BCryptCloseAlgorithmProvider(Prov, 0);
+        m_libspdm_rng_health = LIBSPDM_RNG_HEALTH_FAILED;
         return false;
     }
     BCryptCloseAlgorithmProvider(Prov, 0);
+    m_libspdm_rng_health = LIBSPDM_RNG_HEALTH_OK;
 
     return true;
 }
+
+/**
+ * Return the health state of the random number source.
+ *
+ * @retval LIBSPDM_RNG_HEALTH_OK        The last request succeeded.
+ * @retval LIBSPDM_RNG_HEALTH_FAILED    The last request failed.
+ **/
+libspdm_rng_health_t libspdm_get_random_number_health(void)
+{
+    return m_libspdm_rng_health;
+}
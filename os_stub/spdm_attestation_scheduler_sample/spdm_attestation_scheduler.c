@@ -0,0 +1,443 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/* clock_gettime is only exposed by the C library when POSIX.1b interfaces are requested. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+
+#include <base.h>
+#include "hal/library/debuglib.h"
+#include "hal/library/memlib.h"
+#include "hal/library/requester/timelib.h"
+#include "spdm_attestation_scheduler.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define LIBSPDM_ATTESTATION_SCHEDULER_THREADS 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <time.h>
+#define LIBSPDM_ATTESTATION_SCHEDULER_THREADS 1
+#define LIBSPDM_ATTESTATION_SCHEDULER_POSIX 1
+#endif
+
+struct libspdm_attestation_scheduler {
+#if defined(_WIN32)
+    SRWLOCK lock;
+    CONDITION_VARIABLE work_available;
+    CONDITION_VARIABLE all_done;
+    HANDLE *worker;
+#elif LIBSPDM_ATTESTATION_SCHEDULER_POSIX
+    pthread_mutex_t lock;
+    pthread_cond_t work_available;
+    pthread_cond_t all_done;
+    pthread_t *worker;
+#endif
+    size_t worker_count;
+    /* Jobs that are queued, in submission order. */
+    libspdm_attestation_job_t *head;
+    libspdm_attestation_job_t *tail;
+    /* Jobs that are queued or running. */
+    size_t pending_count;
+    bool stopping;
+};
+
+/* The steps in the order they run. */
+static const uint32_t m_libspdm_attestation_step[] = {
+    LIBSPDM_ATTESTATION_STEP_INIT_CONNECTION,
+    LIBSPDM_ATTESTATION_STEP_GET_DIGEST,
+    LIBSPDM_ATTESTATION_STEP_GET_CERTIFICATE,
+    LIBSPDM_ATTESTATION_STEP_CHALLENGE,
+    LIBSPDM_ATTESTATION_STEP_GET_MEASUREMENT,
+    LIBSPDM_ATTESTATION_STEP_START_SESSION,
+};
+
+/* Monotonic time in microseconds, or 0 if the target has no clock. */
+static uint64_t libspdm_attestation_get_time(void)
+{
+#if defined(_WIN32)
+    return GetTickCount64() * 1000;
+#elif LIBSPDM_ATTESTATION_SCHEDULER_POSIX
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return 0;
+    }
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+#else
+    return 0;
+#endif
+}
+
+/* Time in microseconds until the deadline of a job, or UINT64_MAX if it has none. */
+static uint64_t libspdm_attestation_get_time_left(const libspdm_attestation_job_t *job)
+{
+    uint64_t elapsed;
+
+    if (job->deadline == 0) {
+        return UINT64_MAX;
+    }
+    elapsed = libspdm_attestation_get_time() - job->submit_time;
+    return (elapsed >= job->deadline) ? 0 : job->deadline - elapsed;
+}
+
+/* A failure of the link or a transient state of the device. Any other failure, such as a failed
+ * signature verification, ends the job. */
+static bool libspdm_attestation_is_retryable(libspdm_return_t status)
+{
+    return (status == LIBSPDM_STATUS_SEND_FAIL) ||
+           (status == LIBSPDM_STATUS_RECEIVE_FAIL) ||
+           (status == LIBSPDM_STATUS_BUSY_PEER) ||
+           (status == LIBSPDM_STATUS_NOT_READY_PEER) ||
+           (status == LIBSPDM_STATUS_RESYNCH_PEER);
+}
+
+static libspdm_return_t libspdm_attestation_run_step(libspdm_attestation_job_t *job,
+                                                     uint32_t step, size_t cert_chain_capacity,
+                                                     uint32_t measurement_record_capacity)
+{
+    switch (step) {
+    case LIBSPDM_ATTESTATION_STEP_INIT_CONNECTION:
+        return libspdm_init_connection(job->spdm_context, false);
+    case LIBSPDM_ATTESTATION_STEP_GET_DIGEST:
+        return libspdm_get_digest(job->spdm_context, NULL, &job->slot_mask, NULL);
+    case LIBSPDM_ATTESTATION_STEP_GET_CERTIFICATE:
+        job->cert_chain_size = cert_chain_capacity;
+        return libspdm_get_certificate(job->spdm_context, NULL, job->slot_id,
+                                       &job->cert_chain_size, job->cert_chain);
+    case LIBSPDM_ATTESTATION_STEP_CHALLENGE:
+        return libspdm_challenge(job->spdm_context, NULL, job->slot_id,
+                                 job->measurement_hash_type, job->measurement_hash, NULL);
+    case LIBSPDM_ATTESTATION_STEP_GET_MEASUREMENT:
+        job->measurement_record_length = measurement_record_capacity;
+        return libspdm_get_measurement(job->spdm_context, NULL, job->measurement_attribute,
+                                       job->measurement_operation, job->slot_id, NULL,
+                                       &job->number_of_blocks, &job->measurement_record_length,
+                                       job->measurement_record);
+    case LIBSPDM_ATTESTATION_STEP_START_SESSION:
+        return libspdm_start_session(job->spdm_context, false, NULL, 0,
+                                     job->measurement_hash_type, job->slot_id,
+                                     job->session_policy, &job->session_id,
+                                     &job->heartbeat_period, job->measurement_hash);
+    default:
+        LIBSPDM_ASSERT(false);
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+}
+
+/* Run the steps of a job on the calling thread and set its results. */
+static void libspdm_attestation_run_job(libspdm_attestation_job_t *job)
+{
+    size_t cert_chain_capacity;
+    uint32_t measurement_record_capacity;
+    libspdm_data_parameter_t parameter;
+    libspdm_connection_state_t connection_state;
+    size_t data_size;
+    libspdm_return_t status;
+    uint8_t retry;
+    uint64_t time_left;
+    size_t index;
+    uint32_t step;
+
+    cert_chain_capacity = job->cert_chain_size;
+    measurement_record_capacity = job->measurement_record_length;
+    retry = job->retry_times;
+    status = LIBSPDM_STATUS_SUCCESS;
+
+    index = 0;
+    while (index < LIBSPDM_ARRAY_SIZE(m_libspdm_attestation_step)) {
+        step = m_libspdm_attestation_step[index];
+        if ((job->steps & step) == 0) {
+            index++;
+            continue;
+        }
+        if (libspdm_attestation_get_time_left(job) == 0) {
+            job->deadline_expired = true;
+            job->failed_step = step;
+            if (!LIBSPDM_STATUS_IS_ERROR(status)) {
+                status = LIBSPDM_STATUS_RECEIVE_FAIL;
+            }
+            break;
+        }
+
+        status = libspdm_attestation_run_step(job, step, cert_chain_capacity,
+                                              measurement_record_capacity);
+        if (!LIBSPDM_STATUS_IS_ERROR(status)) {
+            index++;
+            continue;
+        }
+        if ((retry == 0) || !libspdm_attestation_is_retryable(status)) {
+            job->failed_step = step;
+            break;
+        }
+        retry--;
+
+        time_left = libspdm_attestation_get_time_left(job);
+        libspdm_sleep((job->retry_delay_time < time_left) ? job->retry_delay_time : time_left);
+
+        /* A step that lost the connection, such as after RequestResynch, is tried again on a new
+         * connection. */
+        if ((step != LIBSPDM_ATTESTATION_STEP_INIT_CONNECTION) &&
+            ((job->steps & LIBSPDM_ATTESTATION_STEP_INIT_CONNECTION) != 0)) {
+            libspdm_zero_mem(&parameter, sizeof(parameter));
+            parameter.location = LIBSPDM_DATA_LOCATION_CONNECTION;
+            data_size = sizeof(connection_state);
+            if (LIBSPDM_STATUS_IS_ERROR(libspdm_get_data(
+                                            job->spdm_context, LIBSPDM_DATA_CONNECTION_STATE,
+                                            &parameter, &connection_state, &data_size)) ||
+                (connection_state < LIBSPDM_CONNECTION_STATE_NEGOTIATED)) {
+                index = 0;
+            }
+        }
+    }
+
+    job->status = (job->failed_step == 0) ? LIBSPDM_STATUS_SUCCESS : status;
+    job->elapsed_time = libspdm_attestation_get_time() - job->submit_time;
+}
+
+static void libspdm_attestation_complete_job(libspdm_attestation_job_t *job)
+{
+    if (job->complete != NULL) {
+        job->complete(job);
+    }
+}
+
+#if LIBSPDM_ATTESTATION_SCHEDULER_THREADS
+static void libspdm_attestation_lock(libspdm_attestation_scheduler_t *scheduler)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&scheduler->lock);
+#else
+    pthread_mutex_lock(&scheduler->lock);
+#endif
+}
+
+static void libspdm_attestation_unlock(libspdm_attestation_scheduler_t *scheduler)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&scheduler->lock);
+#else
+    pthread_mutex_unlock(&scheduler->lock);
+#endif
+}
+
+static void libspdm_attestation_wait_work(libspdm_attestation_scheduler_t *scheduler)
+{
+#if defined(_WIN32)
+    SleepConditionVariableSRW(&scheduler->work_available, &scheduler->lock, INFINITE, 0);
+#else
+    pthread_cond_wait(&scheduler->work_available, &scheduler->lock);
+#endif
+}
+
+static void libspdm_attestation_wait_all_done(libspdm_attestation_scheduler_t *scheduler)
+{
+#if defined(_WIN32)
+    SleepConditionVariableSRW(&scheduler->all_done, &scheduler->lock, INFINITE, 0);
+#else
+    pthread_cond_wait(&scheduler->all_done, &scheduler->lock);
+#endif
+}
+
+static void libspdm_attestation_signal_work(libspdm_attestation_scheduler_t *scheduler)
+{
+#if defined(_WIN32)
+    WakeConditionVariable(&scheduler->work_available);
+#else
+    pthread_cond_signal(&scheduler->work_available);
+#endif
+}
+
+static void libspdm_attestation_broadcast(libspdm_attestation_scheduler_t *scheduler)
+{
+#if defined(_WIN32)
+    WakeAllConditionVariable(&scheduler->work_available);
+    WakeAllConditionVariable(&scheduler->all_done);
+#else
+    pthread_cond_broadcast(&scheduler->work_available);
+    pthread_cond_broadcast(&scheduler->all_done);
+#endif
+}
+
+static void libspdm_attestation_worker(libspdm_attestation_scheduler_t *scheduler)
+{
+    libspdm_attestation_job_t *job;
+
+    libspdm_attestation_lock(scheduler);
+    for (;;) {
+        while ((scheduler->head == NULL) && !scheduler->stopping) {
+            libspdm_attestation_wait_work(scheduler);
+        }
+        /* Queued jobs run before the worker stops. */
+        job = scheduler->head;
+        if (job == NULL) {
+            break;
+        }
+        scheduler->head = job->next;
+        if (scheduler->head == NULL) {
+            scheduler->tail = NULL;
+        }
+        libspdm_attestation_unlock(scheduler);
+
+        libspdm_attestation_run_job(job);
+        libspdm_attestation_complete_job(job);
+
+        libspdm_attestation_lock(scheduler);
+        scheduler->pending_count--;
+        if (scheduler->pending_count == 0) {
+            libspdm_attestation_broadcast(scheduler);
+        }
+    }
+    libspdm_attestation_unlock(scheduler);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI libspdm_attestation_worker_entry(LPVOID scheduler)
+{
+    libspdm_attestation_worker(scheduler);
+    return 0;
+}
+#else
+static void *libspdm_attestation_worker_entry(void *scheduler)
+{
+    libspdm_attestation_worker(scheduler);
+    return NULL;
+}
+#endif
+#endif /* LIBSPDM_ATTESTATION_SCHEDULER_THREADS */
+
+libspdm_attestation_scheduler_t *libspdm_attestation_scheduler_new(size_t worker_count)
+{
+    libspdm_attestation_scheduler_t *scheduler;
+
+    if (worker_count == 0) {
+        return NULL;
+    }
+    scheduler = calloc(1, sizeof(*scheduler));
+    if (scheduler == NULL) {
+        return NULL;
+    }
+
+#if LIBSPDM_ATTESTATION_SCHEDULER_THREADS
+    scheduler->worker = calloc(worker_count, sizeof(*scheduler->worker));
+    if (scheduler->worker == NULL) {
+        free(scheduler);
+        return NULL;
+    }
+#if defined(_WIN32)
+    InitializeSRWLock(&scheduler->lock);
+    InitializeConditionVariable(&scheduler->work_available);
+    InitializeConditionVariable(&scheduler->all_done);
+#else
+    pthread_mutex_init(&scheduler->lock, NULL);
+    pthread_cond_init(&scheduler->work_available, NULL);
+    pthread_cond_init(&scheduler->all_done, NULL);
+#endif
+
+    for (scheduler->worker_count = 0; scheduler->worker_count < worker_count;
+         scheduler->worker_count++) {
+#if defined(_WIN32)
+        scheduler->worker[scheduler->worker_count] =
+            CreateThread(NULL, 0, libspdm_attestation_worker_entry, scheduler, 0, NULL);
+        if (scheduler->worker[scheduler->worker_count] == NULL) {
+            break;
+        }
+#else
+        if (pthread_create(&scheduler->worker[scheduler->worker_count], NULL,
+                           libspdm_attestation_worker_entry, scheduler) != 0) {
+            break;
+        }
+#endif
+    }
+    if (scheduler->worker_count < worker_count) {
+        libspdm_attestation_scheduler_free(scheduler);
+        return NULL;
+    }
+#endif /* LIBSPDM_ATTESTATION_SCHEDULER_THREADS */
+
+    return scheduler;
+}
+
+bool libspdm_attestation_scheduler_submit(libspdm_attestation_scheduler_t *scheduler,
+                                          libspdm_attestation_job_t *job)
+{
+    if ((job->spdm_context == NULL) || (job->steps == 0)) {
+        return false;
+    }
+
+    job->status = LIBSPDM_STATUS_SUCCESS;
+    job->failed_step = 0;
+    job->deadline_expired = false;
+    job->slot_mask = 0;
+    job->number_of_blocks = 0;
+    libspdm_zero_mem(job->measurement_hash, sizeof(job->measurement_hash));
+    job->session_id = 0;
+    job->heartbeat_period = 0;
+    job->elapsed_time = 0;
+    job->next = NULL;
+    job->submit_time = libspdm_attestation_get_time();
+
+#if LIBSPDM_ATTESTATION_SCHEDULER_THREADS
+    libspdm_attestation_lock(scheduler);
+    if (scheduler->tail == NULL) {
+        scheduler->head = job;
+    } else {
+        scheduler->tail->next = job;
+    }
+    scheduler->tail = job;
+    scheduler->pending_count++;
+    libspdm_attestation_signal_work(scheduler);
+    libspdm_attestation_unlock(scheduler);
+#else
+    libspdm_attestation_run_job(job);
+    libspdm_attestation_complete_job(job);
+#endif /* LIBSPDM_ATTESTATION_SCHEDULER_THREADS */
+
+    return true;
+}
+
+void libspdm_attestation_scheduler_wait(libspdm_attestation_scheduler_t *scheduler)
+{
+#if LIBSPDM_ATTESTATION_SCHEDULER_THREADS
+    libspdm_attestation_lock(scheduler);
+    while (scheduler->pending_count != 0) {
+        libspdm_attestation_wait_all_done(scheduler);
+    }
+    libspdm_attestation_unlock(scheduler);
+#endif /* LIBSPDM_ATTESTATION_SCHEDULER_THREADS */
+}
+
+void libspdm_attestation_scheduler_free(libspdm_attestation_scheduler_t *scheduler)
+{
+#if LIBSPDM_ATTESTATION_SCHEDULER_THREADS
+    size_t index;
+
+    libspdm_attestation_lock(scheduler);
+    scheduler->stopping = true;
+    libspdm_attestation_broadcast(scheduler);
+    libspdm_attestation_unlock(scheduler);
+
+    for (index = 0; index < scheduler->worker_count; index++) {
+#if defined(_WIN32)
+        WaitForSingleObject(scheduler->worker[index], INFINITE);
+        CloseHandle(scheduler->worker[index]);
+#else
+        pthread_join(scheduler->worker[index], NULL);
+#endif
+    }
+
+#if !defined(_WIN32)
+    pthread_cond_destroy(&scheduler->all_done);
+    pthread_cond_destroy(&scheduler->work_available);
+    pthread_mutex_destroy(&scheduler->lock);
+#endif
+    free(scheduler->worker);
+#endif /* LIBSPDM_ATTESTATION_SCHEDULER_THREADS */
+    free(scheduler);
+}
@@ -0,0 +1,133 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef SPDM_ATTESTATION_SCHEDULER_H
+#define SPDM_ATTESTATION_SCHEDULER_H
+
+#include "library/spdm_requester_lib.h"
+#include "library/spdm_crypt_lib.h"
+
+/* The steps of an attestation job. They run in this order. */
+#define LIBSPDM_ATTESTATION_STEP_INIT_CONNECTION 0x00000001
+#define LIBSPDM_ATTESTATION_STEP_GET_DIGEST 0x00000002
+#define LIBSPDM_ATTESTATION_STEP_GET_CERTIFICATE 0x00000004
+#define LIBSPDM_ATTESTATION_STEP_CHALLENGE 0x00000008
+#define LIBSPDM_ATTESTATION_STEP_GET_MEASUREMENT 0x00000010
+#define LIBSPDM_ATTESTATION_STEP_START_SESSION 0x00000020
+
+typedef struct libspdm_attestation_scheduler libspdm_attestation_scheduler_t;
+typedef struct libspdm_attestation_job libspdm_attestation_job_t;
+
+/**
+ * Called on a worker thread when a job is complete. The job may be submitted again from the
+ * callback.
+ *
+ * @param  job  The completed job. Its result fields are set.
+ **/
+typedef void (*libspdm_attestation_complete_func)(libspdm_attestation_job_t *job);
+
+/* The attestation of one device. The job and its buffers belong to the Integrator and must stay
+ * valid until the complete callback returns. */
+struct libspdm_attestation_job {
+    /* The SPDM context of the device, with its device I/O, transport and buffer functions
+     * registered. A context must be in at most one submitted job at a time. */
+    void *spdm_context;
+    /* A bitmask of LIBSPDM_ATTESTATION_STEP_*. */
+    uint32_t steps;
+    /* The certificate slot for GET_CERTIFICATE, CHALLENGE, GET_MEASUREMENTS and KEY_EXCHANGE. */
+    uint8_t slot_id;
+    /* The measurement summary hash type for CHALLENGE and KEY_EXCHANGE. */
+    uint8_t measurement_hash_type;
+    /* The request attributes and operation of GET_MEASUREMENTS. */
+    uint8_t measurement_attribute;
+    uint8_t measurement_operation;
+    /* The session policy of KEY_EXCHANGE. */
+    uint8_t session_policy;
+    /* Time in microseconds, from the submission, within which the job must complete. No step is
+     * started after the deadline. A step in progress is bounded by the timeouts of the device
+     * I/O functions. 0 means no deadline. */
+    uint64_t deadline;
+    /* The number of times a failed step is tried again, over the whole job. */
+    uint8_t retry_times;
+    /* Time in microseconds to wait before a retry. */
+    uint64_t retry_delay_time;
+    /* For GET_CERTIFICATE, the buffer for the certificate chain. On input its size, on output
+     * the size of the chain. */
+    void *cert_chain;
+    size_t cert_chain_size;
+    /* For GET_MEASUREMENTS, the buffer for the measurement record. On input its size, on output
+     * the size of the record. */
+    void *measurement_record;
+    uint32_t measurement_record_length;
+    libspdm_attestation_complete_func complete;
+    void *user_data;
+
+    /* Results, set before complete is called. */
+    libspdm_return_t status;
+    /* The step that failed, or 0 if the job succeeded. */
+    uint32_t failed_step;
+    /* True if the job stopped because the deadline passed. status is then the error of the last
+     * attempt, or LIBSPDM_STATUS_RECEIVE_FAIL if no attempt failed. */
+    bool deadline_expired;
+    uint8_t slot_mask;
+    uint8_t number_of_blocks;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t session_id;
+    uint8_t heartbeat_period;
+    /* Time in microseconds from the submission to the completion, including the time in queue. */
+    uint64_t elapsed_time;
+
+    /* Private to the scheduler. */
+    libspdm_attestation_job_t *next;
+    uint64_t submit_time;
+};
+
+/**
+ * Create a scheduler that runs attestation jobs on a pool of worker threads.
+ *
+ * The jobs of different devices run concurrently. Each job runs the blocking requester functions
+ * on one worker, so the device I/O functions registered with libspdm_register_device_io_func may
+ * block on their own link without holding up other devices.
+ *
+ * On targets without threads no worker is created, and libspdm_attestation_scheduler_submit
+ * runs the job before it returns.
+ *
+ * @param  worker_count  The number of worker threads. It bounds the number of devices that are
+ *                       attested at the same time.
+ *
+ * @return The scheduler, or NULL if it could not be created.
+ **/
+libspdm_attestation_scheduler_t *libspdm_attestation_scheduler_new(size_t worker_count);
+
+/**
+ * Queue an attestation job. Jobs are started in submission order.
+ *
+ * @param  scheduler  The scheduler.
+ * @param  job        The job. Its result fields are overwritten.
+ *
+ * @retval true   The job is queued.
+ * @retval false  The job has no SPDM context or no step.
+ **/
+bool libspdm_attestation_scheduler_submit(libspdm_attestation_scheduler_t *scheduler,
+                                          libspdm_attestation_job_t *job);
+
+/**
+ * Wait until every submitted job, including jobs submitted by complete callbacks, is complete.
+ * It must not be called from a complete callback.
+ *
+ * @param  scheduler  The scheduler.
+ **/
+void libspdm_attestation_scheduler_wait(libspdm_attestation_scheduler_t *scheduler);
+
+/**
+ * Run the jobs that are still queued, stop the workers and free the scheduler.
+ * It must not be called from a complete callback.
+ *
+ * @param  scheduler  The scheduler.
+ **/
+void libspdm_attestation_scheduler_free(libspdm_attestation_scheduler_t *scheduler);
+
+#endif
@@ -0,0 +1,398 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/* clock_gettime is only exposed by the C library when POSIX.1b interfaces are requested. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+
+#include <base.h>
+#include "spdm_cert_verify_callback_internal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <time.h>
+#define LIBSPDM_CERT_CHAIN_CACHE_POSIX 1
+#endif
+
+/* Number of verified certificate chains that are kept. The least recently used one is evicted. */
+#ifndef LIBSPDM_CERT_CHAIN_CACHE_ENTRY_COUNT
+#define LIBSPDM_CERT_CHAIN_CACHE_ENTRY_COUNT 16
+#endif
+
+/* Number of seconds a verification result is trusted before the chain is verified again.
+ * On targets without a monotonic clock the results are kept until evicted or flushed. */
+#ifndef LIBSPDM_CERT_CHAIN_CACHE_LIFETIME
+#define LIBSPDM_CERT_CHAIN_CACHE_LIFETIME 3600
+#endif
+
+/* Everything that the verification result of a certificate chain depends on. */
+typedef struct {
+    uint8_t spdm_version;
+    bool is_requester;
+    bool alias_cert_cap;
+    uint32_t base_hash_algo;
+    uint32_t base_asym_algo;
+    uint32_t pqc_asym_algo;
+    /* The hash of the SPDM certificate chain, as reported in DIGESTS. */
+    uint8_t cert_chain_hash[LIBSPDM_MAX_HASH_SIZE];
+    /* The hash of the provisioned root certificates, in order. */
+    uint8_t root_cert_set_hash[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_cert_chain_cache_key_t;
+
+typedef struct {
+    bool valid;
+    libspdm_cert_chain_cache_key_t key;
+    uint64_t expiry;
+    uint64_t last_use;
+    /* Index of the trust anchor in peer_root_cert_provision, or LIBSPDM_MAX_ROOT_CERT_SUPPORT
+     * if no root certificate is provisioned. */
+    uint8_t root_cert_index;
+    void *cert_chain;
+    size_t cert_chain_size;
+} libspdm_cert_chain_cache_entry_t;
+
+static libspdm_cert_chain_cache_entry_t
+    m_libspdm_cert_chain_cache[LIBSPDM_CERT_CHAIN_CACHE_ENTRY_COUNT];
+static uint64_t m_libspdm_cert_chain_cache_use_count;
+static libspdm_verify_spdm_cert_chain_func m_libspdm_cert_chain_cache_verify_func;
+
+#if defined(_WIN32)
+static SRWLOCK m_libspdm_cert_chain_cache_lock = SRWLOCK_INIT;
+#elif LIBSPDM_CERT_CHAIN_CACHE_POSIX
+static pthread_mutex_t m_libspdm_cert_chain_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void libspdm_cert_chain_cache_lock(void)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&m_libspdm_cert_chain_cache_lock);
+#elif LIBSPDM_CERT_CHAIN_CACHE_POSIX
+    pthread_mutex_lock(&m_libspdm_cert_chain_cache_lock);
+#endif
+}
+
+static void libspdm_cert_chain_cache_unlock(void)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&m_libspdm_cert_chain_cache_lock);
+#elif LIBSPDM_CERT_CHAIN_CACHE_POSIX
+    pthread_mutex_unlock(&m_libspdm_cert_chain_cache_lock);
+#endif
+}
+
+/* Monotonic time in seconds, or 0 if the target has no clock. */
+static uint64_t libspdm_cert_chain_cache_get_time(void)
+{
+#if defined(_WIN32)
+    return GetTickCount64() / 1000;
+#elif LIBSPDM_CERT_CHAIN_CACHE_POSIX
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return 0;
+    }
+    return (uint64_t)now.tv_sec;
+#else
+    return 0;
+#endif
+}
+
+static bool libspdm_cert_chain_cache_is_expired(const libspdm_cert_chain_cache_entry_t *entry,
+                                                uint64_t now)
+{
+    if (now == 0) {
+        return false;
+    }
+    return now >= entry->expiry;
+}
+
+static void libspdm_cert_chain_cache_free_entry(libspdm_cert_chain_cache_entry_t *entry)
+{
+    free(entry->cert_chain);
+    libspdm_zero_mem(entry, sizeof(*entry));
+}
+
+/**
+ * Build the cache key of a certificate chain for the negotiated algorithms and the trust anchors
+ * of a context.
+ *
+ * @param  context          A pointer to the SPDM context.
+ * @param  cert_chain_hash  The hash of the certificate chain, or NULL to hash cert_chain.
+ * @param  cert_chain       The certificate chain, if cert_chain_hash is NULL.
+ * @param  cert_chain_size  Size in bytes of the certificate chain.
+ * @param  key              The cache key.
+ **/
+static bool libspdm_cert_chain_cache_build_key(const libspdm_context_t *context,
+                                               const void *cert_chain_hash,
+                                               const void *cert_chain, size_t cert_chain_size,
+                                               libspdm_cert_chain_cache_key_t *key)
+{
+    uint32_t base_hash_algo;
+    size_t hash_size;
+    void *hash_context;
+    size_t index;
+    bool result;
+
+    libspdm_zero_mem(key, sizeof(*key));
+
+    base_hash_algo = context->connection_info.algorithm.base_hash_algo;
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+    if (hash_size == 0) {
+        return false;
+    }
+
+    key->spdm_version = libspdm_get_connection_version(context);
+    key->is_requester = context->local_context.is_requester;
+    key->base_hash_algo = base_hash_algo;
+    if (key->is_requester) {
+        key->alias_cert_cap = (context->connection_info.capability.flags &
+                               SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ALIAS_CERT_CAP) != 0;
+        key->base_asym_algo = context->connection_info.algorithm.base_asym_algo;
+        key->pqc_asym_algo = context->connection_info.algorithm.pqc_asym_algo;
+    } else {
+        key->base_asym_algo = context->connection_info.algorithm.req_base_asym_alg;
+        key->pqc_asym_algo = context->connection_info.algorithm.req_pqc_asym_alg;
+    }
+
+    if (cert_chain_hash != NULL) {
+        libspdm_copy_mem(key->cert_chain_hash, sizeof(key->cert_chain_hash),
+                         cert_chain_hash, hash_size);
+    } else if (!libspdm_hash_all(base_hash_algo, cert_chain, cert_chain_size,
+                                 key->cert_chain_hash)) {
+        return false;
+    }
+
+    hash_context = libspdm_hash_new(base_hash_algo);
+    if (hash_context == NULL) {
+        return false;
+    }
+    result = libspdm_hash_init(base_hash_algo, hash_context);
+    for (index = 0; result && (index < LIBSPDM_MAX_ROOT_CERT_SUPPORT); index++) {
+        if (context->local_context.peer_root_cert_provision[index] == NULL) {
+            break;
+        }
+        result = libspdm_hash_update(base_hash_algo, hash_context,
+                                     context->local_context.peer_root_cert_provision[index],
+                                     context->local_context.peer_root_cert_provision_size[index]);
+    }
+    if (result) {
+        result = libspdm_hash_final(base_hash_algo, hash_context, key->root_cert_set_hash);
+    }
+    libspdm_hash_free(base_hash_algo, hash_context);
+
+    return result;
+}
+
+/* Find a live entry for a key. The lock must be held. Expired entries are dropped. */
+static libspdm_cert_chain_cache_entry_t *libspdm_cert_chain_cache_find(
+    const libspdm_cert_chain_cache_key_t *key)
+{
+    libspdm_cert_chain_cache_entry_t *entry;
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_CERT_CHAIN_CACHE_ENTRY_COUNT; index++) {
+        entry = &m_libspdm_cert_chain_cache[index];
+        if (!entry->valid ||
+            !libspdm_consttime_is_mem_equal(&entry->key, key, sizeof(*key))) {
+            continue;
+        }
+        if (libspdm_cert_chain_cache_is_expired(entry, libspdm_cert_chain_cache_get_time())) {
+            libspdm_cert_chain_cache_free_entry(entry);
+            return NULL;
+        }
+        entry->last_use = ++m_libspdm_cert_chain_cache_use_count;
+        return entry;
+    }
+
+    return NULL;
+}
+
+/* Add a verified chain, replacing the least recently used entry. The lock must be held. */
+static void libspdm_cert_chain_cache_insert(const libspdm_cert_chain_cache_key_t *key,
+                                            uint8_t root_cert_index,
+                                            void *cert_chain, size_t cert_chain_size)
+{
+    libspdm_cert_chain_cache_entry_t *entry;
+    libspdm_cert_chain_cache_entry_t *victim;
+    size_t index;
+
+    victim = NULL;
+    for (index = 0; index < LIBSPDM_CERT_CHAIN_CACHE_ENTRY_COUNT; index++) {
+        entry = &m_libspdm_cert_chain_cache[index];
+        if (entry->valid && libspdm_consttime_is_mem_equal(&entry->key, key, sizeof(*key))) {
+            victim = entry;
+            break;
+        }
+        if ((victim == NULL) ||
+            (victim->valid && (!entry->valid || (entry->last_use < victim->last_use)))) {
+            victim = entry;
+        }
+    }
+
+    if (victim->valid) {
+        libspdm_cert_chain_cache_free_entry(victim);
+    }
+    libspdm_copy_mem(&victim->key, sizeof(victim->key), key, sizeof(*key));
+    victim->expiry = libspdm_cert_chain_cache_get_time() + LIBSPDM_CERT_CHAIN_CACHE_LIFETIME;
+    victim->last_use = ++m_libspdm_cert_chain_cache_use_count;
+    victim->root_cert_index = root_cert_index;
+    victim->cert_chain = cert_chain;
+    victim->cert_chain_size = cert_chain_size;
+    victim->valid = true;
+}
+
+void libspdm_cert_chain_cache_set_verify_func(
+    libspdm_verify_spdm_cert_chain_func verify_spdm_cert_chain)
+{
+    libspdm_cert_chain_cache_lock();
+    m_libspdm_cert_chain_cache_verify_func = verify_spdm_cert_chain;
+    libspdm_cert_chain_cache_unlock();
+}
+
+bool libspdm_verify_spdm_cert_chain_with_cache(void *spdm_context, uint8_t slot_id,
+                                               size_t cert_chain_size, const void *cert_chain,
+                                               const void **trust_anchor,
+                                               size_t *trust_anchor_size)
+{
+    libspdm_context_t *context;
+    libspdm_cert_chain_cache_key_t key;
+    libspdm_cert_chain_cache_entry_t *entry;
+    libspdm_verify_spdm_cert_chain_func verify_func;
+    const void *root_cert;
+    size_t root_cert_size;
+    uint8_t root_cert_index;
+    void *cert_chain_copy;
+    bool has_key;
+    bool result;
+
+    context = spdm_context;
+
+    has_key = libspdm_cert_chain_cache_build_key(context, NULL, cert_chain, cert_chain_size,
+                                                 &key);
+
+    libspdm_cert_chain_cache_lock();
+    verify_func = m_libspdm_cert_chain_cache_verify_func;
+    if (has_key) {
+        entry = libspdm_cert_chain_cache_find(&key);
+        if (entry != NULL) {
+            root_cert_index = entry->root_cert_index;
+            libspdm_cert_chain_cache_unlock();
+            if (root_cert_index < LIBSPDM_MAX_ROOT_CERT_SUPPORT) {
+                if (trust_anchor != NULL) {
+                    *trust_anchor = context->local_context.peer_root_cert_provision[root_cert_index];
+                }
+                if (trust_anchor_size != NULL) {
+                    *trust_anchor_size =
+                        context->local_context.peer_root_cert_provision_size[root_cert_index];
+                }
+            }
+            return true;
+        }
+    }
+    libspdm_cert_chain_cache_unlock();
+
+    root_cert = NULL;
+    root_cert_size = 0;
+    if (verify_func != NULL) {
+        result = verify_func(spdm_context, slot_id, cert_chain_size, cert_chain,
+                             &root_cert, &root_cert_size);
+    } else {
+        result = libspdm_verify_peer_cert_chain_buffer_integrity(context, cert_chain,
+                                                                 cert_chain_size) &&
+                 libspdm_verify_peer_cert_chain_buffer_authority(context, cert_chain,
+                                                                 cert_chain_size,
+                                                                 &root_cert, &root_cert_size);
+    }
+    /* Only successful results are kept, so a peer cannot evict good chains with bad ones. */
+    if (!result) {
+        return false;
+    }
+    if (trust_anchor != NULL) {
+        *trust_anchor = root_cert;
+    }
+    if (trust_anchor_size != NULL) {
+        *trust_anchor_size = root_cert_size;
+    }
+    if (!has_key) {
+        return true;
+    }
+
+    root_cert_index = LIBSPDM_MAX_ROOT_CERT_SUPPORT;
+    if (root_cert != NULL) {
+        for (root_cert_index = 0; root_cert_index < LIBSPDM_MAX_ROOT_CERT_SUPPORT;
+             root_cert_index++) {
+            if (context->local_context.peer_root_cert_provision[root_cert_index] == root_cert) {
+                break;
+            }
+        }
+    }
+
+    cert_chain_copy = malloc(cert_chain_size);
+    if (cert_chain_copy == NULL) {
+        return true;
+    }
+    libspdm_copy_mem(cert_chain_copy, cert_chain_size, cert_chain, cert_chain_size);
+
+    libspdm_cert_chain_cache_lock();
+    libspdm_cert_chain_cache_insert(&key, root_cert_index, cert_chain_copy, cert_chain_size);
+    libspdm_cert_chain_cache_unlock();
+
+    return true;
+}
+
+bool libspdm_cert_chain_cache_set_peer_cert_chain(void *spdm_context, uint8_t slot_id,
+                                                  const void *cert_chain_hash)
+{
+    libspdm_context_t *context;
+    libspdm_cert_chain_cache_key_t key;
+    libspdm_cert_chain_cache_entry_t *entry;
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+
+    context = spdm_context;
+
+    if (slot_id >= SPDM_MAX_SLOT_COUNT) {
+        return false;
+    }
+    if (!libspdm_cert_chain_cache_build_key(context, cert_chain_hash, NULL, 0, &key)) {
+        return false;
+    }
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_CONNECTION;
+    parameter.additional_data[0] = slot_id;
+
+    /* The chain is installed under the lock so that it cannot be evicted while it is copied. */
+    libspdm_cert_chain_cache_lock();
+    entry = libspdm_cert_chain_cache_find(&key);
+    if (entry == NULL) {
+        libspdm_cert_chain_cache_unlock();
+        return false;
+    }
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, entry->cert_chain, entry->cert_chain_size);
+    libspdm_cert_chain_cache_unlock();
+
+    return status == LIBSPDM_STATUS_SUCCESS;
+}
+
+void libspdm_cert_chain_cache_flush(void)
+{
+    size_t index;
+
+    libspdm_cert_chain_cache_lock();
+    for (index = 0; index < LIBSPDM_CERT_CHAIN_CACHE_ENTRY_COUNT; index++) {
+        if (m_libspdm_cert_chain_cache[index].valid) {
+            libspdm_cert_chain_cache_free_entry(&m_libspdm_cert_chain_cache[index]);
+        }
+    }
+    libspdm_cert_chain_cache_unlock();
+}
@@ -45,4 +45,59 @@ bool libspdm_verify_spdm_cert_chain_with_dice(void *spdm_context, uint8_t slot_i
 bool libspdm_verify_cert_dicetcbinfo(const void *cert, size_t cert_size,
                                      size_t *spdm_get_dice_tcb_info_size);
 
+/**
+ * The callback function for verifying a cert_chain through the process-wide verified chain cache.
+ *
+ * A chain that was verified for the same negotiated algorithms and the same provisioned root
+ * certificates, by any context, is accepted without being verified again until it expires.
+ * Otherwise the chain is verified by the function set with
+ * libspdm_cert_chain_cache_set_verify_func, or by the default integrity and authority checks, and
+ * is added to the cache if the verification passes.
+ *
+ * @param  spdm_context            A pointer to the SPDM context.
+ * @param  slot_id                 The number of slot for the certificate chain.
+ * @param  cert_chain_size         size in bytes of the certificate chain buffer.
+ * @param  cert_chain              Certificate chain buffer including spdm_cert_chain_t header.
+ * @param  trust_anchor            A buffer to hold the trust_anchor which is used to validate the peer certificate, if not NULL.
+ * @param  trust_anchor_size       A buffer to hold the trust_anchor_size, if not NULL.
+ *
+ * @retval true  The certificate chain buffer verification passed.
+ * @retval false The certificate chain buffer verification failed.
+ **/
+bool libspdm_verify_spdm_cert_chain_with_cache(void *spdm_context, uint8_t slot_id,
+                                               size_t cert_chain_size, const void *cert_chain,
+                                               const void **trust_anchor,
+                                               size_t *trust_anchor_size);
+
+/**
+ * Set the function that verifies a cert_chain on a cache miss, such as
+ * libspdm_verify_spdm_cert_chain_with_dice. If it is NULL, the default verification is used.
+ *
+ * @param  verify_spdm_cert_chain  The function to verify an SPDM certificate chain.
+ **/
+void libspdm_cert_chain_cache_set_verify_func(
+    libspdm_verify_spdm_cert_chain_func verify_spdm_cert_chain);
+
+/**
+ * Install a cached, verified cert_chain as the peer certificate chain of a slot, so that
+ * GET_CERTIFICATE can be skipped.
+ *
+ * This is called after GET_DIGESTS with the digest that the peer reports for the slot.
+ *
+ * @param  spdm_context     A pointer to the SPDM context.
+ * @param  slot_id          The number of slot for the certificate chain.
+ * @param  cert_chain_hash  The digest of the certificate chain from DIGESTS.
+ *
+ * @retval true  The certificate chain is installed in the slot.
+ * @retval false The certificate chain is not in the cache, or has expired.
+ **/
+bool libspdm_cert_chain_cache_set_peer_cert_chain(void *spdm_context, uint8_t slot_id,
+                                                  const void *cert_chain_hash);
+
+/**
+ * Remove all certificate chains from the verified chain cache, such as after the root
+ * certificates or the revocation status of a certificate changed.
+ **/
+void libspdm_cert_chain_cache_flush(void);
+
 #endif
@@ -475,6 +475,8 @@ bool libspdm_write_key_pair_info(
                 return false;
             }
 
+            libspdm_clear_signing_key_cache();
+
             /*device don't need reset this time*/
             *need_reset = false;
             free(cached_key_pair_info);
@@ -528,6 +530,8 @@ bool libspdm_write_key_pair_info(
             return false;
         }
 
+        libspdm_clear_signing_key_cache();
+
         return true;
     }
 }
@@ -0,0 +1,47 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include <base.h>
+#include "spdm_device_secret_lib_internal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define LIBSPDM_DEVICE_SECRET_LIB_LOCK_POSIX 1
+#endif
+
+#if defined(_WIN32)
+static SRWLOCK m_libspdm_device_secret_lib_lock[LIBSPDM_DEVICE_SECRET_LIB_LOCK_COUNT] = {
+    SRWLOCK_INIT,
+    SRWLOCK_INIT,
+    SRWLOCK_INIT
+};
+#elif LIBSPDM_DEVICE_SECRET_LIB_LOCK_POSIX
+static pthread_mutex_t m_libspdm_device_secret_lib_lock[LIBSPDM_DEVICE_SECRET_LIB_LOCK_COUNT] = {
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER
+};
+#endif
+
+void libspdm_device_secret_lib_lock(libspdm_device_secret_lib_lock_t lock)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&m_libspdm_device_secret_lib_lock[lock]);
+#elif LIBSPDM_DEVICE_SECRET_LIB_LOCK_POSIX
+    pthread_mutex_lock(&m_libspdm_device_secret_lib_lock[lock]);
+#endif
+}
+
+void libspdm_device_secret_lib_unlock(libspdm_device_secret_lib_lock_t lock)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&m_libspdm_device_secret_lib_lock[lock]);
+#elif LIBSPDM_DEVICE_SECRET_LIB_LOCK_POSIX
+    pthread_mutex_unlock(&m_libspdm_device_secret_lib_lock[lock]);
+#endif
+}
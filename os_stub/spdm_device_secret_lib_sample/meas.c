@@ -23,68 +23,222 @@
 #define LIBSPDM_MAX_MEASUREMENT_EXTENSION_LOG_SIZE 0x1000
 uint8_t m_libspdm_mel[LIBSPDM_MAX_MEASUREMENT_EXTENSION_LOG_SIZE];
 
+/* One slot per measurement hash algorithm bit. */
+#define LIBSPDM_MEL_HEM_ALGO_COUNT 8
+
+/* Running HEM over the MEL entries folded so far, for one measurement hash algorithm. */
+typedef struct {
+    uint32_t measurement_hash_algo;
+    uint32_t folded_entries;
+    uint32_t folded_entries_len;
+    uint8_t hem[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_mel_hem_t;
+
+static libspdm_mel_hem_t m_libspdm_mel_hem[LIBSPDM_MEL_HEM_ALGO_COUNT];
+
 #endif /* (LIBSPDM_ENABLE_CAPABILITY_MEL_CAP) || (LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP) */
 
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+
+#define LIBSPDM_MEASUREMENT_RECORD_CACHE_COUNT 4
+#define LIBSPDM_MEASUREMENT_RECORD_CACHE_SIZE 0x400
+
+/* All measurement blocks, serialized for one measurement hash algorithm and form. */
+typedef struct {
+    bool valid;
+    uint32_t measurement_hash_algo;
+    bool use_bit_stream;
+    size_t record_size;
+    uint8_t record[LIBSPDM_MEASUREMENT_RECORD_CACHE_SIZE];
+} libspdm_measurement_record_cache_t;
+
+#define LIBSPDM_MEASUREMENT_CHANGE_REPORT_COUNT 16
+
+/* The change generation that was last reported to an SPDM context. */
+typedef struct {
+    const void *spdm_context;
+    uint32_t reported_generation;
+} libspdm_measurement_change_report_t;
+
+/* The record cache, the change generation and the reports are protected by
+ * LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT. */
+static libspdm_measurement_record_cache_t
+    m_libspdm_measurement_record_cache[LIBSPDM_MEASUREMENT_RECORD_CACHE_COUNT];
+static size_t m_libspdm_measurement_record_cache_next;
+
+/* Incremented by libspdm_measurement_changed. */
+static uint32_t m_libspdm_measurement_generation;
+static libspdm_measurement_change_report_t
+    m_libspdm_measurement_change_report[LIBSPDM_MEASUREMENT_CHANGE_REPORT_COUNT];
+static size_t m_libspdm_measurement_change_report_next;
+
+/* The caller holds LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT. */
+static void libspdm_clear_measurement_records(void)
+{
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_MEASUREMENT_RECORD_CACHE_COUNT; index++) {
+        m_libspdm_measurement_record_cache[index].valid = false;
+    }
+}
+
+static void libspdm_invalidate_measurement_records(void)
+{
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+    libspdm_clear_measurement_records();
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+}
+
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
 #if (LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP) || (LIBSPDM_ENABLE_CAPABILITY_MEL_CAP)
+/**
+ * Extend the running HEM of one measurement hash algorithm with the MEL entries that were
+ * appended since it was last extended. HEM = hash(HEM || entry), starting from zero.
+ * The caller holds LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL.
+ **/
+static bool libspdm_extend_mel_hem(libspdm_mel_hem_t *mel_hem)
+{
+    spdm_measurement_extension_log_dmtf_t *measurement_extension_log;
+    spdm_mel_entry_dmtf_t *mel_entry;
+    size_t hash_size;
+    size_t mel_entry_size;
+    uint8_t *verify_hem;
+
+    measurement_extension_log = (spdm_measurement_extension_log_dmtf_t *)m_libspdm_mel;
+    if (mel_hem->folded_entries == measurement_extension_log->number_of_entries) {
+        return true;
+    }
+
+    hash_size = libspdm_get_measurement_hash_size(mel_hem->measurement_hash_algo);
+    verify_hem = malloc(hash_size + measurement_extension_log->mel_entries_len -
+                        mel_hem->folded_entries_len);
+    if (verify_hem == NULL) {
+        return false;
+    }
+
+    mel_entry = (spdm_mel_entry_dmtf_t *)(m_libspdm_mel +
+                                          sizeof(spdm_measurement_extension_log_dmtf_t) +
+                                          mel_hem->folded_entries_len);
+    while (mel_hem->folded_entries < measurement_extension_log->number_of_entries) {
+        mel_entry_size = sizeof(spdm_mel_entry_dmtf_t) +
+                         mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_size;
+        libspdm_copy_mem(verify_hem, hash_size, mel_hem->hem, hash_size);
+        libspdm_copy_mem(verify_hem + hash_size, mel_entry_size, mel_entry, mel_entry_size);
+        if (!libspdm_measurement_hash_all(mel_hem->measurement_hash_algo, verify_hem,
+                                          hash_size + mel_entry_size, mel_hem->hem)) {
+            free(verify_hem);
+            return false;
+        }
+        mel_hem->folded_entries++;
+        mel_hem->folded_entries_len += (uint32_t)mel_entry_size;
+        mel_entry = (spdm_mel_entry_dmtf_t *)((uint8_t *)mel_entry + mel_entry_size);
+    }
+
+    free(verify_hem);
+    return true;
+}
+
+/* The caller holds LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL. */
+static bool libspdm_add_mel_entry(uint8_t meas_index, uint8_t value_type,
+                                  const void *value, uint16_t value_size)
+{
+    spdm_measurement_extension_log_dmtf_t *measurement_extension_log;
+    spdm_mel_entry_dmtf_t *mel_entry;
+    size_t mel_size;
+    size_t index;
+
+    measurement_extension_log = (spdm_measurement_extension_log_dmtf_t *)m_libspdm_mel;
+    mel_size = sizeof(spdm_measurement_extension_log_dmtf_t) +
+               measurement_extension_log->mel_entries_len;
+    if (sizeof(spdm_mel_entry_dmtf_t) + value_size > sizeof(m_libspdm_mel) - mel_size) {
+        return false;
+    }
+
+    mel_entry = (spdm_mel_entry_dmtf_t *)(m_libspdm_mel + mel_size);
+    mel_entry->mel_index = measurement_extension_log->number_of_entries + 1;
+    mel_entry->meas_index = meas_index;
+    libspdm_write_uint24(mel_entry->reserved, 0);
+    mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_type = value_type;
+    mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_size = value_size;
+    libspdm_copy_mem((void *)(mel_entry + 1), value_size, value, value_size);
+
+    measurement_extension_log->number_of_entries++;
+    measurement_extension_log->mel_entries_len += sizeof(spdm_mel_entry_dmtf_t) + value_size;
+
+    /* keep every HEM that has been read up to date */
+    for (index = 0; index < LIBSPDM_MEL_HEM_ALGO_COUNT; index++) {
+        if (m_libspdm_mel_hem[index].measurement_hash_algo != 0) {
+            libspdm_extend_mel_hem(&m_libspdm_mel_hem[index]);
+        }
+    }
+    return true;
+}
+
+bool libspdm_append_mel_entry(uint8_t meas_index, uint8_t value_type,
+                              const void *value, uint16_t value_size)
+{
+    bool result;
+
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+    result = libspdm_add_mel_entry(meas_index, value_type, value, value_size);
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+    if (!result) {
+        return false;
+    }
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+    libspdm_measurement_changed(LIBSPDM_MEASUREMENT_INDEX_HEM);
+#endif
+    return true;
+}
+
+void libspdm_reset_mel(void)
+{
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+    libspdm_zero_mem(m_libspdm_mel, sizeof(spdm_measurement_extension_log_dmtf_t));
+    libspdm_zero_mem(m_libspdm_mel_hem, sizeof(m_libspdm_mel_hem));
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+    libspdm_invalidate_measurement_records();
+#endif
+}
+
 void libspdm_generate_mel(uint32_t measurement_hash_algo)
 {
     spdm_measurement_extension_log_dmtf_t *measurement_extension_log;
-    spdm_mel_entry_dmtf_t *mel_entry1;
-    spdm_mel_entry_dmtf_t *mel_entry2;
-    spdm_mel_entry_dmtf_t *mel_entry3;
 
     uint8_t rom_informational[] = "ROM";
     uint8_t bootfv_informational[] = "Boot FW";
     uint32_t version = 0x0100030A;
 
-    /*generate MEL*/
+    /*generate MEL once, it is extended by libspdm_append_mel_entry afterwards.
+     * The check and the generation are done under the lock, so that the first reads of
+     * concurrent requests do not both add the boot entries.*/
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
     measurement_extension_log = (spdm_measurement_extension_log_dmtf_t *)m_libspdm_mel;
-
-    measurement_extension_log->number_of_entries = 3;
-    measurement_extension_log->mel_entries_len =
-        measurement_extension_log->number_of_entries * sizeof(spdm_mel_entry_dmtf_t) +
-        sizeof(rom_informational) - 1 + sizeof(bootfv_informational) - 1 + sizeof(version);
-    measurement_extension_log->reserved = 0;
+    if (measurement_extension_log->number_of_entries != 0) {
+        libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+        return;
+    }
 
     /*MEL Entry 1: informational ROM */
-    mel_entry1 = (spdm_mel_entry_dmtf_t *)((uint8_t *)measurement_extension_log +
-                                           sizeof(spdm_measurement_extension_log_dmtf_t));
-    mel_entry1->mel_index = 1;
-    mel_entry1->meas_index = LIBSPDM_MEASUREMENT_INDEX_HEM;
-    libspdm_write_uint24(mel_entry1->reserved, 0);
-    mel_entry1->measurement_block_dmtf_header.dmtf_spec_measurement_value_type =
-        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_INFORMATIONAL |
-        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
-    mel_entry1->measurement_block_dmtf_header.dmtf_spec_measurement_value_size =
-        sizeof(rom_informational) - 1;
-    libspdm_copy_mem((void *)(mel_entry1 + 1), sizeof(rom_informational) - 1,
-                     rom_informational, sizeof(rom_informational) - 1);
+    libspdm_add_mel_entry(LIBSPDM_MEASUREMENT_INDEX_HEM,
+                          SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_INFORMATIONAL |
+                          SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM,
+                          rom_informational, sizeof(rom_informational) - 1);
 
     /*MEL Entry 2: informational Boot FW */
-    mel_entry2 = (spdm_mel_entry_dmtf_t *)((uint8_t *)(mel_entry1 + 1) +
-                                           sizeof(rom_informational) - 1);
-    mel_entry2->mel_index = 2;
-    mel_entry2->meas_index = LIBSPDM_MEASUREMENT_INDEX_HEM;
-    libspdm_write_uint24(mel_entry2->reserved, 0);
-    mel_entry2->measurement_block_dmtf_header.dmtf_spec_measurement_value_type =
-        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_INFORMATIONAL |
-        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
-    mel_entry2->measurement_block_dmtf_header.dmtf_spec_measurement_value_size =
-        sizeof(bootfv_informational) - 1;
-    libspdm_copy_mem((void *)(mel_entry2 + 1), sizeof(bootfv_informational) - 1,
-                     bootfv_informational, sizeof(bootfv_informational) - 1);
+    libspdm_add_mel_entry(LIBSPDM_MEASUREMENT_INDEX_HEM,
+                          SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_INFORMATIONAL |
+                          SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM,
+                          bootfv_informational, sizeof(bootfv_informational) - 1);
 
     /*MEL Entry 3: version 0x0100030A */
-    mel_entry3 = (spdm_mel_entry_dmtf_t *)((uint8_t *)(mel_entry2 + 1) +
-                                           sizeof(bootfv_informational) - 1);
-    mel_entry3->mel_index = 3;
-    mel_entry3->meas_index = LIBSPDM_MEASUREMENT_INDEX_HEM;
-    libspdm_write_uint24(mel_entry3->reserved, 0);
-    mel_entry3->measurement_block_dmtf_header.dmtf_spec_measurement_value_type =
-        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_VERSION |
-        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
-    mel_entry3->measurement_block_dmtf_header.dmtf_spec_measurement_value_size = sizeof(version);
-    libspdm_copy_mem((void *)(mel_entry3 + 1), sizeof(version), &version, sizeof(version));
+    libspdm_add_mel_entry(LIBSPDM_MEASUREMENT_INDEX_HEM,
+                          SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_VERSION |
+                          SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM,
+                          &version, sizeof(version));
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
 }
 #endif /*(LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP) || (LIBSPDM_ENABLE_CAPABILITY_MEL_CAP)*/
 
@@ -195,6 +349,48 @@ size_t libspdm_fill_measurement_svn_block (
     return sizeof(spdm_measurement_block_dmtf_t) + sizeof(svn);
 }
 
+/**
+ * Copy the running HEM of the MEL for the measurement hash algorithm.
+ * Only the entries appended since the previous call are hashed.
+ *
+ * @return false if the algorithm is not supported.
+ **/
+static bool libspdm_get_mel_hem(uint32_t measurement_hash_algo, uint8_t *hem)
+{
+    libspdm_mel_hem_t *mel_hem;
+    size_t index;
+    size_t hash_size;
+    bool result;
+
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+    mel_hem = NULL;
+    for (index = 0; index < LIBSPDM_MEL_HEM_ALGO_COUNT; index++) {
+        if (m_libspdm_mel_hem[index].measurement_hash_algo == measurement_hash_algo) {
+            mel_hem = &m_libspdm_mel_hem[index];
+            break;
+        }
+        if ((mel_hem == NULL) && (m_libspdm_mel_hem[index].measurement_hash_algo == 0)) {
+            mel_hem = &m_libspdm_mel_hem[index];
+        }
+    }
+    if (mel_hem == NULL) {
+        libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+        return false;
+    }
+    if (mel_hem->measurement_hash_algo != measurement_hash_algo) {
+        libspdm_zero_mem(mel_hem, sizeof(*mel_hem));
+        mel_hem->measurement_hash_algo = measurement_hash_algo;
+    }
+
+    result = libspdm_extend_mel_hem(mel_hem);
+    if (result) {
+        hash_size = libspdm_get_measurement_hash_size(measurement_hash_algo);
+        libspdm_copy_mem(hem, hash_size, mel_hem->hem, hash_size);
+    }
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
+    return result;
+}
+
 /**
  * Fill HEM measurement block.
  *
@@ -210,10 +406,6 @@ size_t libspdm_fill_measurement_hem_block (
     )
 {
     size_t hash_size;
-    spdm_measurement_extension_log_dmtf_t *measurement_extension_log;
-    spdm_mel_entry_dmtf_t *mel_entry;
-    uint32_t index;
-    uint8_t *verify_hem;
 
     if (measurement_hash_algo == SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) {
         return 0;
@@ -226,9 +418,6 @@ size_t libspdm_fill_measurement_hem_block (
         return sizeof(spdm_measurement_block_dmtf_t) + hash_size;
     }
 
-    /*MEL*/
-    measurement_extension_log = (spdm_measurement_extension_log_dmtf_t *)m_libspdm_mel;
-
     /*generate measurement block*/
     measurement_block->measurement_block_common_header
     .index = LIBSPDM_MEASUREMENT_INDEX_HEM;
@@ -248,39 +437,11 @@ size_t libspdm_fill_measurement_hem_block (
         (uint16_t)(sizeof(spdm_measurement_block_dmtf_header_t) +
                    (uint16_t)hash_size);
 
-    verify_hem = malloc(measurement_extension_log->mel_entries_len + hash_size);
-    if (verify_hem == NULL) {
+    /*the running HEM only hashes the MEL entries appended since the last read*/
+    if (!libspdm_get_mel_hem(measurement_hash_algo, (uint8_t *)(measurement_block + 1))) {
         return 0;
     }
 
-    libspdm_zero_mem(verify_hem, measurement_extension_log->mel_entries_len + hash_size);
-    mel_entry = (spdm_mel_entry_dmtf_t *)((uint8_t *)measurement_extension_log +
-                                          sizeof(spdm_measurement_extension_log_dmtf_t));
-    for (index = 0; index < measurement_extension_log->number_of_entries; index++) {
-        libspdm_copy_mem(
-            verify_hem + hash_size,
-            measurement_extension_log->mel_entries_len,
-            mel_entry,
-            sizeof(spdm_mel_entry_dmtf_t) +
-            mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_size);
-
-        if (!libspdm_measurement_hash_all(
-                measurement_hash_algo,
-                verify_hem,
-                hash_size + sizeof(spdm_mel_entry_dmtf_t) +
-                mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_size,
-                verify_hem
-                )) {
-            free(verify_hem);
-            return 0;
-        }
-        mel_entry = (spdm_mel_entry_dmtf_t *)
-                    ((uint8_t *)mel_entry + sizeof(spdm_mel_entry_dmtf_t)+
-                     mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_size);
-    }
-
-    libspdm_copy_mem((void *)(measurement_block + 1), hash_size, verify_hem, hash_size);
-    free(verify_hem);
     return sizeof(spdm_measurement_block_dmtf_t) + hash_size;
 }
 
@@ -377,6 +538,239 @@ size_t libspdm_fill_measurement_device_mode_block (
     return sizeof(spdm_measurement_block_dmtf_t) + sizeof(device_mode);
 }
 
+/**
+ * Return the size of the record that holds all measurement blocks.
+ **/
+static size_t libspdm_get_measurement_record_size(bool use_bit_stream, size_t hash_size)
+{
+    size_t total_size_needed;
+
+    /* Calculate total_size_needed based on hash algo selected.
+     * If we have an hash algo, then the first HASH_NUMBER elements will be
+     * hash values, otherwise HASH_NUMBER raw bitstream values.*/
+    if (!use_bit_stream) {
+        total_size_needed =
+            LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
+            (sizeof(spdm_measurement_block_dmtf_t) + hash_size);
+    } else {
+        total_size_needed =
+            LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
+            (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_RAW_DATA_SIZE);
+    }
+    /* Next one - SVN is always raw bitstream data.*/
+    total_size_needed +=
+        (sizeof(spdm_measurement_block_dmtf_t) +
+         sizeof(spdm_measurements_secure_version_number_t));
+    /* Next one - HEM is always digest data.*/
+    total_size_needed +=
+        (sizeof(spdm_measurement_block_dmtf_t) + hash_size);
+    /* Next one - manifest is always raw bitstream data.*/
+    total_size_needed +=
+        (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_MANIFEST_SIZE);
+    /* Next one - device_mode is always raw bitstream data.*/
+    total_size_needed +=
+        (sizeof(spdm_measurement_block_dmtf_t) + sizeof(spdm_measurements_device_mode_t));
+
+    return total_size_needed;
+}
+
+/**
+ * Fill all measurement blocks.
+ *
+ * @retval true  the measurement blocks are filled.
+ * @retval false an image hash block cannot be generated.
+ **/
+static bool libspdm_fill_measurement_record(bool use_bit_stream, uint32_t measurement_hash_algo,
+                                            void *measurements)
+{
+    spdm_measurement_block_dmtf_t *measurement_block;
+    size_t measurement_block_size;
+    uint8_t index;
+
+    measurement_block = measurements;
+
+    /* The first HASH_NUMBER blocks may be hash values or raw bitstream*/
+    for (index = 1; index <= LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
+        measurement_block_size = libspdm_fill_measurement_image_hash_block (use_bit_stream,
+                                                                            measurement_hash_algo,
+                                                                            index,
+                                                                            measurement_block);
+        if (measurement_block_size == 0) {
+            return false;
+        }
+        measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
+    }
+    /* Next one - SVN is always raw bitstream data.*/
+    {
+        measurement_block_size = libspdm_fill_measurement_svn_block (measurement_block);
+        measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
+    }
+    /* Next one - HEM is always digest data.*/
+    {
+        measurement_block_size = libspdm_fill_measurement_hem_block (measurement_block,
+                                                                     measurement_hash_algo);
+        measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
+    }
+    /* Next one - manifest is always raw bitstream data.*/
+    {
+        measurement_block_size = libspdm_fill_measurement_manifest_block (measurement_block);
+        measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
+    }
+    /* Next one - device_mode is always raw bitstream data.*/
+    libspdm_fill_measurement_device_mode_block (measurement_block);
+    return true;
+}
+
+/**
+ * Return the cached record of all measurement blocks for the hash algorithm and form.
+ * The record is built on first use and kept until libspdm_measurement_changed() is called.
+ * The caller holds LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT while it reads the record, since
+ * another thread may replace it afterwards.
+ *
+ * @return the cached record, or NULL if it cannot be built.
+ **/
+static const libspdm_measurement_record_cache_t *libspdm_get_measurement_record(
+    bool use_bit_stream, uint32_t measurement_hash_algo)
+{
+    libspdm_measurement_record_cache_t *record_cache;
+    size_t record_size;
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_MEASUREMENT_RECORD_CACHE_COUNT; index++) {
+        record_cache = &m_libspdm_measurement_record_cache[index];
+        if (record_cache->valid &&
+            (record_cache->measurement_hash_algo == measurement_hash_algo) &&
+            (record_cache->use_bit_stream == use_bit_stream)) {
+            return record_cache;
+        }
+    }
+
+    record_size = libspdm_get_measurement_record_size(
+        use_bit_stream, libspdm_get_measurement_hash_size(measurement_hash_algo));
+    if (record_size > LIBSPDM_MEASUREMENT_RECORD_CACHE_SIZE) {
+        LIBSPDM_ASSERT(false);
+        return NULL;
+    }
+
+    /* reuse an invalid entry, otherwise replace the entries in turn */
+    record_cache = NULL;
+    for (index = 0; index < LIBSPDM_MEASUREMENT_RECORD_CACHE_COUNT; index++) {
+        if (!m_libspdm_measurement_record_cache[index].valid) {
+            record_cache = &m_libspdm_measurement_record_cache[index];
+            break;
+        }
+    }
+    if (record_cache == NULL) {
+        record_cache = &m_libspdm_measurement_record_cache[m_libspdm_measurement_record_cache_next];
+        m_libspdm_measurement_record_cache_next =
+            (m_libspdm_measurement_record_cache_next + 1) % LIBSPDM_MEASUREMENT_RECORD_CACHE_COUNT;
+    }
+
+    record_cache->valid = false;
+    libspdm_zero_mem(record_cache->record, sizeof(record_cache->record));
+    if (!libspdm_fill_measurement_record(use_bit_stream, measurement_hash_algo,
+                                         record_cache->record)) {
+        return NULL;
+    }
+    record_cache->measurement_hash_algo = measurement_hash_algo;
+    record_cache->use_bit_stream = use_bit_stream;
+    record_cache->record_size = record_size;
+    record_cache->valid = true;
+    return record_cache;
+}
+
+/**
+ * Copy one measurement block from the cached record.
+ *
+ * @return measurement block size, or 0 if the block is not found.
+ **/
+static size_t libspdm_read_cached_measurement_block(
+    bool use_bit_stream, uint32_t measurement_hash_algo, uint8_t measurements_index,
+    spdm_measurement_block_dmtf_t *measurement_block, size_t measurement_block_size)
+{
+    const libspdm_measurement_record_cache_t *record_cache;
+    const spdm_measurement_block_dmtf_t *cached_measurement_block;
+    size_t cached_measurement_block_size;
+    size_t offset;
+    size_t result;
+
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+    record_cache = libspdm_get_measurement_record(use_bit_stream, measurement_hash_algo);
+    if (record_cache == NULL) {
+        libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+        return 0;
+    }
+
+    result = 0;
+    offset = 0;
+    while (offset + sizeof(spdm_measurement_block_dmtf_t) <= record_cache->record_size) {
+        cached_measurement_block = (const void *)(record_cache->record + offset);
+        cached_measurement_block_size =
+            sizeof(spdm_measurement_block_common_header_t) +
+            cached_measurement_block->measurement_block_common_header.measurement_size;
+        if (cached_measurement_block_size <= sizeof(spdm_measurement_block_common_header_t)) {
+            break;
+        }
+        if (cached_measurement_block->measurement_block_common_header.index ==
+            measurements_index) {
+            if (cached_measurement_block_size == measurement_block_size) {
+                libspdm_copy_mem(measurement_block, measurement_block_size,
+                                 cached_measurement_block, cached_measurement_block_size);
+                result = cached_measurement_block_size;
+            }
+            break;
+        }
+        offset += cached_measurement_block_size;
+    }
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+    return result;
+}
+
+/**
+ * Report whether the measurements changed since the last signed MEASUREMENTS of the SPDM context,
+ * and record that the current generation was reported to it. The table only holds the most recent
+ * contexts, so a context that is not in it, either new or evicted, is told that the measurements
+ * changed. A context at the address of a freed one inherits its entry, whose generation is not
+ * newer than the start of the new connection, so a change during that connection is still seen.
+ * The caller holds LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT.
+ **/
+static bool libspdm_report_measurement_change(const void *spdm_context)
+{
+    libspdm_measurement_change_report_t *report;
+    size_t index;
+    bool changed;
+
+    report = NULL;
+    for (index = 0; index < LIBSPDM_MEASUREMENT_CHANGE_REPORT_COUNT; index++) {
+        if (m_libspdm_measurement_change_report[index].spdm_context == spdm_context) {
+            report = &m_libspdm_measurement_change_report[index];
+            break;
+        }
+    }
+    if (report == NULL) {
+        report = &m_libspdm_measurement_change_report[m_libspdm_measurement_change_report_next];
+        m_libspdm_measurement_change_report_next =
+            (m_libspdm_measurement_change_report_next + 1) %
+            LIBSPDM_MEASUREMENT_CHANGE_REPORT_COUNT;
+        report->spdm_context = spdm_context;
+        report->reported_generation = m_libspdm_measurement_generation;
+        changed = true;
+    } else {
+        changed = (report->reported_generation != m_libspdm_measurement_generation);
+    }
+    report->reported_generation = m_libspdm_measurement_generation;
+    return changed;
+}
+
+void libspdm_measurement_changed(uint8_t measurement_index)
+{
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+    /* every cached record holds all measurement blocks */
+    libspdm_clear_measurement_records();
+    m_libspdm_measurement_generation++;
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+}
+
 bool g_check_measurement_request_context = false;
 uint64_t g_measurement_request_context;
 
@@ -396,10 +790,10 @@ libspdm_return_t libspdm_measurement_collection(
 {
     spdm_measurement_block_dmtf_t *measurement_block;
     size_t hash_size;
-    uint8_t index;
     size_t total_size_needed;
     bool use_bit_stream;
     size_t measurement_block_size;
+    const libspdm_measurement_record_cache_t *record_cache;
 
     if ((measurement_specification != SPDM_MEASUREMENT_SPECIFICATION_DMTF) ||
         (measurement_hash_algo == 0)) {
@@ -433,73 +827,26 @@ libspdm_return_t libspdm_measurement_collection(
     } else if (measurements_index ==
                SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
 
-        /* Calculate total_size_needed based on hash algo selected.
-         * If we have an hash algo, then the first HASH_NUMBER elements will be
-         * hash values, otherwise HASH_NUMBER raw bitstream values.*/
-        if (!use_bit_stream) {
-            total_size_needed =
-                LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
-                (sizeof(spdm_measurement_block_dmtf_t) + hash_size);
-        } else {
-            total_size_needed =
-                LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
-                (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_RAW_DATA_SIZE);
-        }
-        /* Next one - SVN is always raw bitstream data.*/
-        total_size_needed +=
-            (sizeof(spdm_measurement_block_dmtf_t) +
-             sizeof(spdm_measurements_secure_version_number_t));
-        /* Next one - HEM is always digest data.*/
-        total_size_needed +=
-            (sizeof(spdm_measurement_block_dmtf_t) + hash_size);
-        /* Next one - manifest is always raw bitstream data.*/
-        total_size_needed +=
-            (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_MANIFEST_SIZE);
-        /* Next one - device_mode is always raw bitstream data.*/
-        total_size_needed +=
-            (sizeof(spdm_measurement_block_dmtf_t) + sizeof(spdm_measurements_device_mode_t));
+        total_size_needed = libspdm_get_measurement_record_size(use_bit_stream, hash_size);
 
         LIBSPDM_ASSERT(total_size_needed <= *measurements_size);
         if (total_size_needed > *measurements_size) {
             return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
 
+        /* the blocks are only regenerated after libspdm_measurement_changed */
+        libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+        record_cache = libspdm_get_measurement_record(use_bit_stream, measurement_hash_algo);
+        if (record_cache == NULL) {
+            libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+            return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
+        }
+
         *measurements_size = total_size_needed;
         *measurements_count = LIBSPDM_MEASUREMENT_BLOCK_NUMBER;
-        measurement_block = measurements;
-
-        /* The first HASH_NUMBER blocks may be hash values or raw bitstream*/
-        for (index = 1; index <= LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
-            measurement_block_size = libspdm_fill_measurement_image_hash_block (use_bit_stream,
-                                                                                measurement_hash_algo,
-                                                                                index,
-                                                                                measurement_block);
-            if (measurement_block_size == 0) {
-                return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
-            }
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
-        /* Next one - SVN is always raw bitstream data.*/
-        {
-            measurement_block_size = libspdm_fill_measurement_svn_block (measurement_block);
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
-        /* Next one - HEM is always digest data.*/
-        {
-            measurement_block_size = libspdm_fill_measurement_hem_block (measurement_block,
-                                                                         measurement_hash_algo);
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
-        /* Next one - manifest is always raw bitstream data.*/
-        {
-            measurement_block_size = libspdm_fill_measurement_manifest_block (measurement_block);
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
-        /* Next one - device_mode is always raw bitstream data.*/
-        {
-            measurement_block_size = libspdm_fill_measurement_device_mode_block (measurement_block);
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
+        libspdm_copy_mem(measurements, total_size_needed,
+                         record_cache->record, record_cache->record_size);
+        libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
 
         goto successful_return;
     } else {
@@ -523,10 +870,9 @@ libspdm_return_t libspdm_measurement_collection(
             *measurements_size = total_size_needed;
 
             measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_image_hash_block (use_bit_stream,
-                                                                                measurement_hash_algo,
-                                                                                measurements_index,
-                                                                                measurement_block);
+            measurement_block_size = libspdm_read_cached_measurement_block(
+                use_bit_stream, measurement_hash_algo, measurements_index,
+                measurement_block, total_size_needed);
             if (measurement_block_size == 0) {
                 return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
             }
@@ -543,7 +889,9 @@ libspdm_return_t libspdm_measurement_collection(
             *measurements_size = total_size_needed;
 
             measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_svn_block (measurement_block);
+            measurement_block_size = libspdm_read_cached_measurement_block(
+                use_bit_stream, measurement_hash_algo, measurements_index,
+                measurement_block, total_size_needed);
             if (measurement_block_size == 0) {
                 return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
             }
@@ -559,8 +907,9 @@ libspdm_return_t libspdm_measurement_collection(
             *measurements_size = total_size_needed;
 
             measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_hem_block (measurement_block,
-                                                                         measurement_hash_algo);
+            measurement_block_size = libspdm_read_cached_measurement_block(
+                use_bit_stream, measurement_hash_algo, measurements_index,
+                measurement_block, total_size_needed);
             if (measurement_block_size == 0) {
                 return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
             }
@@ -578,7 +927,9 @@ libspdm_return_t libspdm_measurement_collection(
             *measurements_size = total_size_needed;
 
             measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_manifest_block (measurement_block);
+            measurement_block_size = libspdm_read_cached_measurement_block(
+                use_bit_stream, measurement_hash_algo, measurements_index,
+                measurement_block, total_size_needed);
             if (measurement_block_size == 0) {
                 return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
             }
@@ -595,7 +946,9 @@ libspdm_return_t libspdm_measurement_collection(
             *measurements_size = total_size_needed;
 
             measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_device_mode_block (measurement_block);
+            measurement_block_size = libspdm_read_cached_measurement_block(
+                use_bit_stream, measurement_hash_algo, measurements_index,
+                measurement_block, total_size_needed);
             if (measurement_block_size == 0) {
                 return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
             }
@@ -611,7 +964,13 @@ successful_return:
         /* return content change*/
         if ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) !=
             0) {
-            *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+            libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
+            if (libspdm_report_measurement_change(spdm_context)) {
+                *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED;
+            } else {
+                *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+            }
+            libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT);
         } else {
             *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_NO_DETECTION;
         }
@@ -807,10 +1166,14 @@ bool libspdm_measurement_extension_log_collection(
 
     libspdm_generate_mel(measurement_hash_algo);
 
+    /* The log is returned in place. Entries are only appended, so the returned bytes do not
+     * change until libspdm_reset_mel, except for the entry count and length in the header. */
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
     measurement_extension_log = (spdm_measurement_extension_log_dmtf_t *)m_libspdm_mel;
     *spdm_mel = (spdm_measurement_extension_log_dmtf_t *)m_libspdm_mel;
     *spdm_mel_size = (size_t)(measurement_extension_log->mel_entries_len) +
                      sizeof(spdm_measurement_extension_log_dmtf_t);
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL);
     return true;
 }
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEL_CAP */
@@ -100,6 +100,9 @@ bool libspdm_write_certificate_to_nvm(
         close(fp_out);
     #endif
 
+        /* The key that signs for this slot may have changed along with its certificate. */
+        libspdm_clear_signing_key_cache();
+
         return true;
     }
 }
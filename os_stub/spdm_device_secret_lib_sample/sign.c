@@ -18,35 +18,166 @@
 #include "spdm_device_secret_lib_internal.h"
 #include "internal/libspdm_common_lib.h"
 
-#if (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) || (LIBSPDM_ENABLE_CAPABILITY_ENDPOINT_INFO_CAP)
-bool libspdm_requester_data_sign(
-    void *spdm_context,
-    spdm_version_number_t spdm_version,
-    uint8_t key_pair_id, uint8_t op_code,
-    uint16_t req_base_asym_alg, uint32_t req_pqc_asym_alg,
-    uint32_t base_hash_algo, bool is_data_hash,
-    const uint8_t *message, size_t message_size,
-    uint8_t *signature, size_t *sig_size)
-{
+/* Parsed private keys are kept across signatures, since reading and parsing a key costs far more
+ * than the signature itself. The cache is shared by every thread of the process. A signature may
+ * change the key context (for example RSA blinding), so an entry serves one signature at a time,
+ * and concurrent signatures with the same key use entries of their own. */
+#define LIBSPDM_SIGNING_KEY_CACHE_COUNT 8
+
+typedef struct {
+    bool is_requester;
+    bool is_pem;
+    uint8_t key_pair_id;
+    uint32_t base_asym_algo;
+    uint32_t pqc_asym_algo;
     void *context;
+    /* A signature is using the key. An entry in use is neither shared nor evicted. */
+    bool in_use;
+    /* The entry was cleared while in use. It is freed when the signature completes. */
+    bool is_stale;
+} libspdm_signing_key_cache_entry_t;
+
+/* Protected by LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY. */
+static libspdm_signing_key_cache_entry_t m_signing_key_cache[LIBSPDM_SIGNING_KEY_CACHE_COUNT];
+static size_t m_signing_key_cache_next;
+/* Incremented by every clear, so that a key read before the clear is not cached after it. */
+static uint64_t m_signing_key_cache_generation;
+
+static void libspdm_free_signing_key(const libspdm_signing_key_cache_entry_t *entry)
+{
+    if (entry->is_requester) {
+        if (entry->pqc_asym_algo != 0) {
+            libspdm_req_pqc_asym_free(entry->pqc_asym_algo, entry->context);
+        } else {
+            libspdm_req_asym_free((uint16_t)entry->base_asym_algo, entry->context);
+        }
+    } else {
+        if (entry->pqc_asym_algo != 0) {
+            libspdm_pqc_asym_free(entry->pqc_asym_algo, entry->context);
+        } else {
+            libspdm_asym_free(entry->base_asym_algo, entry->context);
+        }
+    }
+}
+
+/* Find a live entry for a key, only among those not in use if idle_only is set.
+ * The lock must be held. */
+static libspdm_signing_key_cache_entry_t *libspdm_find_signing_key(
+    bool is_requester, bool is_pem, uint8_t key_pair_id,
+    uint32_t base_asym_algo, uint32_t pqc_asym_algo, bool idle_only)
+{
+    libspdm_signing_key_cache_entry_t *entry;
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_SIGNING_KEY_CACHE_COUNT; index++) {
+        entry = &m_signing_key_cache[index];
+        if ((entry->context != NULL) &&
+            !entry->is_stale &&
+            (!idle_only || !entry->in_use) &&
+            (entry->is_requester == is_requester) &&
+            (entry->is_pem == is_pem) &&
+            (entry->key_pair_id == key_pair_id) &&
+            (entry->base_asym_algo == base_asym_algo) &&
+            (entry->pqc_asym_algo == pqc_asym_algo)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+void libspdm_clear_signing_key_cache(void)
+{
+    libspdm_signing_key_cache_entry_t *entry;
+    size_t index;
+
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+    for (index = 0; index < LIBSPDM_SIGNING_KEY_CACHE_COUNT; index++) {
+        entry = &m_signing_key_cache[index];
+        if (entry->context == NULL) {
+            continue;
+        }
+        if (entry->in_use) {
+            entry->is_stale = true;
+            continue;
+        }
+        libspdm_free_signing_key(entry);
+        libspdm_zero_mem(entry, sizeof(*entry));
+    }
+    m_signing_key_cache_next = 0;
+    m_signing_key_cache_generation++;
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+}
+
+bool libspdm_is_signing_key_cached(bool is_requester, uint8_t key_pair_id,
+                                   uint32_t base_asym_algo, uint32_t pqc_asym_algo)
+{
+    bool is_pem;
     bool result;
 
-    const uint8_t version = spdm_version >> SPDM_VERSION_NUMBER_SHIFT_BIT;
-    const bool multi_key_conn_rsp =
-        ((libspdm_context_t *)spdm_context)->connection_info.multi_key_conn_req;
+#if !LIBSPDM_PRIVATE_KEY_MODE_RAW_KEY_ONLY
+    is_pem = g_private_key_mode;
+#else
+    is_pem = false;
+#endif
 
-    if (version < SPDM_MESSAGE_VERSION_13) {
-        LIBSPDM_ASSERT(key_pair_id == 0);
-    } else if (version >= SPDM_MESSAGE_VERSION_13) {
-        if (multi_key_conn_rsp) {
-            LIBSPDM_ASSERT(key_pair_id > 0);
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+    result = (libspdm_find_signing_key(is_requester, is_pem, key_pair_id,
+                                       base_asym_algo, pqc_asym_algo, false) != NULL);
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+
+    return result;
+}
+
+static bool libspdm_read_responder_signing_key(bool is_pem, uint32_t base_asym_algo,
+                                               uint32_t pqc_asym_algo, void **context)
+{
+    bool result;
+
+#if !LIBSPDM_PRIVATE_KEY_MODE_RAW_KEY_ONLY
+    if (is_pem) {
+        void *private_pem;
+        size_t private_pem_size;
+
+        if (pqc_asym_algo != 0) {
+            result = libspdm_read_responder_pqc_private_key(
+                pqc_asym_algo, &private_pem, &private_pem_size);
         } else {
-            LIBSPDM_ASSERT(key_pair_id == 0);
+            result = libspdm_read_responder_private_key(
+                base_asym_algo, &private_pem, &private_pem_size);
+        }
+        if (!result) {
+            return false;
+        }
+
+        if (pqc_asym_algo != 0) {
+            result = libspdm_pqc_asym_get_private_key_from_pem(
+                pqc_asym_algo, private_pem, private_pem_size, NULL, context);
+        } else {
+            result = libspdm_asym_get_private_key_from_pem(
+                base_asym_algo, private_pem, private_pem_size, NULL, context);
         }
+        libspdm_zero_mem(private_pem, private_pem_size);
+        free(private_pem);
+        return result;
+    }
+#endif
+
+    if (pqc_asym_algo != 0) {
+        result = libspdm_get_responder_pqc_private_key_from_raw_data(pqc_asym_algo, context);
+    } else {
+        result = libspdm_get_responder_private_key_from_raw_data(base_asym_algo, context);
     }
+    return result;
+}
+
+#if (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) || (LIBSPDM_ENABLE_CAPABILITY_ENDPOINT_INFO_CAP)
+static bool libspdm_read_requester_signing_key(bool is_pem, uint16_t req_base_asym_alg,
+                                               uint32_t req_pqc_asym_alg, void **context)
+{
+    bool result;
 
 #if !LIBSPDM_PRIVATE_KEY_MODE_RAW_KEY_ONLY
-    if (g_private_key_mode) {
+    if (is_pem) {
         void *private_pem;
         size_t private_pem_size;
 
@@ -65,56 +196,177 @@ bool libspdm_requester_data_sign(
             result = libspdm_req_pqc_asym_get_private_key_from_pem(req_pqc_asym_alg,
                                                                    private_pem,
                                                                    private_pem_size, NULL,
-                                                                   &context);
+                                                                   context);
         } else {
             result = libspdm_req_asym_get_private_key_from_pem(req_base_asym_alg,
                                                                private_pem,
                                                                private_pem_size, NULL,
-                                                               &context);
-        }
-        if (!result) {
-            libspdm_zero_mem(private_pem, private_pem_size);
-            free(private_pem);
-            return false;
-        }
-
-        if (req_pqc_asym_alg != 0) {
-            if (is_data_hash) {
-                result = libspdm_req_pqc_asym_sign_hash(spdm_version, op_code, req_pqc_asym_alg,
-                                                        base_hash_algo, context,
-                                                        message, message_size, signature, sig_size);
-            } else {
-                result = libspdm_req_pqc_asym_sign(spdm_version, op_code, req_pqc_asym_alg,
-                                                   base_hash_algo, context,
-                                                   message, message_size,
-                                                   signature, sig_size);
-            }
-            libspdm_req_pqc_asym_free(req_pqc_asym_alg, context);
-        } else {
-            if (is_data_hash) {
-                result = libspdm_req_asym_sign_hash(spdm_version, op_code, req_base_asym_alg,
-                                                    base_hash_algo, context,
-                                                    message, message_size, signature, sig_size);
-            } else {
-                result = libspdm_req_asym_sign(spdm_version, op_code, req_base_asym_alg,
-                                               base_hash_algo, context,
-                                               message, message_size,
-                                               signature, sig_size);
-            }
-            libspdm_req_asym_free(req_base_asym_alg, context);
+                                                               context);
         }
         libspdm_zero_mem(private_pem, private_pem_size);
         free(private_pem);
-    } else {
+        return result;
+    }
 #endif
+
     if (req_pqc_asym_alg != 0) {
-        result = libspdm_get_requester_pqc_private_key_from_raw_data(req_pqc_asym_alg, &context);
+        result = libspdm_get_requester_pqc_private_key_from_raw_data(req_pqc_asym_alg, context);
     } else {
-        result = libspdm_get_requester_private_key_from_raw_data(req_base_asym_alg, &context);
+        result = libspdm_get_requester_private_key_from_raw_data(req_base_asym_alg, context);
+    }
+    return result;
+}
+#endif /* (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) || (...) */
+
+/* Return a parsed private key for (role, asym algo, key_pair_id) that no other signature is using,
+ * reading it if every cached copy is in use. The returned entry must be passed to
+ * libspdm_release_signing_key once the signature is done.
+ * If the key cannot be cached, uncached_entry is filled in and returned instead. */
+static libspdm_signing_key_cache_entry_t *libspdm_acquire_signing_key(
+    bool is_requester, uint8_t key_pair_id, uint32_t base_asym_algo, uint32_t pqc_asym_algo,
+    libspdm_signing_key_cache_entry_t *uncached_entry)
+{
+    libspdm_signing_key_cache_entry_t *entry;
+    size_t index;
+    bool is_pem;
+    void *context;
+    bool result;
+    uint64_t generation;
+
+#if !LIBSPDM_PRIVATE_KEY_MODE_RAW_KEY_ONLY
+    is_pem = g_private_key_mode;
+#else
+    is_pem = false;
+#endif
+
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+    entry = libspdm_find_signing_key(is_requester, is_pem, key_pair_id,
+                                     base_asym_algo, pqc_asym_algo, true);
+    if (entry != NULL) {
+        entry->in_use = true;
+        libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+        return entry;
+    }
+    generation = m_signing_key_cache_generation;
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+
+    /* The key is read without the lock, so that other keys can be used meanwhile. */
+    if (is_requester) {
+#if (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) || (LIBSPDM_ENABLE_CAPABILITY_ENDPOINT_INFO_CAP)
+        result = libspdm_read_requester_signing_key(is_pem, (uint16_t)base_asym_algo,
+                                                    pqc_asym_algo, &context);
+#else
+        result = false;
+#endif
+    } else {
+        result = libspdm_read_responder_signing_key(is_pem, base_asym_algo, pqc_asym_algo,
+                                                    &context);
     }
     if (!result) {
+        return NULL;
+    }
+
+    libspdm_zero_mem(uncached_entry, sizeof(*uncached_entry));
+    uncached_entry->is_requester = is_requester;
+    uncached_entry->is_pem = is_pem;
+    uncached_entry->key_pair_id = key_pair_id;
+    uncached_entry->base_asym_algo = base_asym_algo;
+    uncached_entry->pqc_asym_algo = pqc_asym_algo;
+    uncached_entry->context = context;
+    uncached_entry->in_use = true;
+
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+    /* A key read before the cache was cleared may be outdated, so it is used only once. */
+    if (generation != m_signing_key_cache_generation) {
+        libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+        return uncached_entry;
+    }
+
+    /* Another thread may have released a copy of the same key meanwhile. */
+    entry = libspdm_find_signing_key(is_requester, is_pem, key_pair_id,
+                                     base_asym_algo, pqc_asym_algo, true);
+    if (entry != NULL) {
+        entry->in_use = true;
+        libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+        libspdm_free_signing_key(uncached_entry);
+        return entry;
+    }
+
+    /* Replace the entries in turn once the cache is full, skipping those in use. */
+    for (index = 0; index < LIBSPDM_SIGNING_KEY_CACHE_COUNT; index++) {
+        entry = &m_signing_key_cache[m_signing_key_cache_next];
+        m_signing_key_cache_next = (m_signing_key_cache_next + 1) %
+                                   LIBSPDM_SIGNING_KEY_CACHE_COUNT;
+        if (!entry->in_use) {
+            if (entry->context != NULL) {
+                libspdm_free_signing_key(entry);
+            }
+            libspdm_copy_mem(entry, sizeof(*entry), uncached_entry, sizeof(*uncached_entry));
+            libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+            return entry;
+        }
+    }
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+
+    /* Every entry is in use. */
+    return uncached_entry;
+}
+
+/* Release a key returned by libspdm_acquire_signing_key. */
+static void libspdm_release_signing_key(libspdm_signing_key_cache_entry_t *entry)
+{
+    if ((entry < m_signing_key_cache) ||
+        (entry >= m_signing_key_cache + LIBSPDM_SIGNING_KEY_CACHE_COUNT)) {
+        libspdm_free_signing_key(entry);
+        libspdm_zero_mem(entry, sizeof(*entry));
+        return;
+    }
+
+    libspdm_device_secret_lib_lock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+    LIBSPDM_ASSERT(entry->in_use);
+    entry->in_use = false;
+    if (entry->is_stale) {
+        libspdm_free_signing_key(entry);
+        libspdm_zero_mem(entry, sizeof(*entry));
+    }
+    libspdm_device_secret_lib_unlock(LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY);
+}
+
+#if (LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP) || (LIBSPDM_ENABLE_CAPABILITY_ENDPOINT_INFO_CAP)
+bool libspdm_requester_data_sign(
+    void *spdm_context,
+    spdm_version_number_t spdm_version,
+    uint8_t key_pair_id, uint8_t op_code,
+    uint16_t req_base_asym_alg, uint32_t req_pqc_asym_alg,
+    uint32_t base_hash_algo, bool is_data_hash,
+    const uint8_t *message, size_t message_size,
+    uint8_t *signature, size_t *sig_size)
+{
+    libspdm_signing_key_cache_entry_t *key;
+    libspdm_signing_key_cache_entry_t uncached_key;
+    void *context;
+    bool result;
+
+    const uint8_t version = spdm_version >> SPDM_VERSION_NUMBER_SHIFT_BIT;
+    const bool multi_key_conn_rsp =
+        ((libspdm_context_t *)spdm_context)->connection_info.multi_key_conn_req;
+
+    if (version < SPDM_MESSAGE_VERSION_13) {
+        LIBSPDM_ASSERT(key_pair_id == 0);
+    } else if (version >= SPDM_MESSAGE_VERSION_13) {
+        if (multi_key_conn_rsp) {
+            LIBSPDM_ASSERT(key_pair_id > 0);
+        } else {
+            LIBSPDM_ASSERT(key_pair_id == 0);
+        }
+    }
+
+    key = libspdm_acquire_signing_key(true, key_pair_id, req_base_asym_alg, req_pqc_asym_alg,
+                                      &uncached_key);
+    if (key == NULL) {
         return false;
     }
+    context = key->context;
 
     if (req_pqc_asym_alg != 0) {
         if (is_data_hash) {
@@ -127,7 +379,6 @@ bool libspdm_requester_data_sign(
                                                message, message_size,
                                                signature, sig_size);
         }
-        libspdm_req_pqc_asym_free(req_pqc_asym_alg, context);
     } else {
         if (is_data_hash) {
             result = libspdm_req_asym_sign_hash(spdm_version, op_code, req_base_asym_alg,
@@ -139,11 +390,9 @@ bool libspdm_requester_data_sign(
                                            message, message_size,
                                            signature, sig_size);
         }
-        libspdm_req_asym_free(req_base_asym_alg, context);
     }
-#if !LIBSPDM_PRIVATE_KEY_MODE_RAW_KEY_ONLY
-}
-#endif
+
+    libspdm_release_signing_key(key);
 
 #if LIBSPDM_SECRET_LIB_SIGN_LITTLE_ENDIAN
     if ((req_pqc_asym_alg == 0) &&
@@ -168,6 +417,8 @@ bool libspdm_responder_data_sign(
     const uint8_t *message, size_t message_size,
     uint8_t *signature, size_t *sig_size)
 {
+    libspdm_signing_key_cache_entry_t *key;
+    libspdm_signing_key_cache_entry_t uncached_key;
     void *context;
     bool result;
 
@@ -185,72 +436,12 @@ bool libspdm_responder_data_sign(
         }
     }
 
-#if !LIBSPDM_PRIVATE_KEY_MODE_RAW_KEY_ONLY
-    if (g_private_key_mode) {
-        void *private_pem;
-        size_t private_pem_size;
-
-        if (pqc_asym_algo != 0) {
-            result = libspdm_read_responder_pqc_private_key(
-                pqc_asym_algo, &private_pem, &private_pem_size);
-        } else {
-            result = libspdm_read_responder_private_key(
-                base_asym_algo, &private_pem, &private_pem_size);
-        }
-        if (!result) {
-            return false;
-        }
-
-        if (pqc_asym_algo != 0) {
-            result = libspdm_pqc_asym_get_private_key_from_pem(
-                pqc_asym_algo, private_pem, private_pem_size, NULL, &context);
-        } else {
-            result = libspdm_asym_get_private_key_from_pem(
-                base_asym_algo, private_pem, private_pem_size, NULL, &context);
-        }
-        if (!result) {
-            libspdm_zero_mem(private_pem, private_pem_size);
-            free(private_pem);
-            return false;
-        }
-
-        if (pqc_asym_algo != 0) {
-            if (is_data_hash) {
-                result = libspdm_pqc_asym_sign_hash(spdm_version, op_code, pqc_asym_algo, base_hash_algo,
-                                                    context,
-                                                    message, message_size, signature, sig_size);
-            } else {
-                result = libspdm_pqc_asym_sign(spdm_version, op_code, pqc_asym_algo,
-                                               base_hash_algo, context,
-                                               message, message_size,
-                                               signature, sig_size);
-            }
-            libspdm_pqc_asym_free(pqc_asym_algo, context);
-        } else {
-            if (is_data_hash) {
-                result = libspdm_asym_sign_hash(spdm_version, op_code, base_asym_algo, base_hash_algo,
-                                                context,
-                                                message, message_size, signature, sig_size);
-            } else {
-                result = libspdm_asym_sign(spdm_version, op_code, base_asym_algo,
-                                           base_hash_algo, context,
-                                           message, message_size,
-                                           signature, sig_size);
-            }
-            libspdm_asym_free(base_asym_algo, context);
-        }
-        libspdm_zero_mem(private_pem, private_pem_size);
-        free(private_pem);
-    } else {
-#endif
-    if (pqc_asym_algo != 0) {
-        result = libspdm_get_responder_pqc_private_key_from_raw_data(pqc_asym_algo, &context);
-    } else {
-        result = libspdm_get_responder_private_key_from_raw_data(base_asym_algo, &context);
-    }
-    if (!result) {
+    key = libspdm_acquire_signing_key(false, key_pair_id, base_asym_algo, pqc_asym_algo,
+                                      &uncached_key);
+    if (key == NULL) {
         return false;
     }
+    context = key->context;
 
     if (pqc_asym_algo != 0) {
         if (is_data_hash) {
@@ -263,7 +454,6 @@ bool libspdm_responder_data_sign(
                                            message, message_size,
                                            signature, sig_size);
         }
-        libspdm_pqc_asym_free(pqc_asym_algo, context);
     } else {
         if (is_data_hash) {
             result = libspdm_asym_sign_hash(spdm_version, op_code, base_asym_algo, base_hash_algo,
@@ -275,11 +465,9 @@ bool libspdm_responder_data_sign(
                                        message, message_size,
                                        signature, sig_size);
         }
-        libspdm_asym_free(base_asym_algo, context);
     }
-#if !LIBSPDM_PRIVATE_KEY_MODE_RAW_KEY_ONLY
-}
-#endif
+
+    libspdm_release_signing_key(key);
 
 #if LIBSPDM_SECRET_LIB_SIGN_LITTLE_ENDIAN
     if ((pqc_asym_algo == 0) &&
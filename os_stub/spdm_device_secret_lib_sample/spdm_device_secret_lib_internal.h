@@ -213,11 +213,55 @@ bool libspdm_get_responder_pqc_private_key_from_raw_data(uint32_t pqc_asym_algo,
 
 bool libspdm_get_requester_pqc_private_key_from_raw_data(uint32_t req_pqc_asym_algo, void **context);
 
+/* lock */
+
+/* Locks for the state that this library shares between the threads of a process. On targets
+ * without threads they do nothing. */
+typedef enum {
+    LIBSPDM_DEVICE_SECRET_LIB_LOCK_SIGNING_KEY,
+    LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEL,
+    LIBSPDM_DEVICE_SECRET_LIB_LOCK_MEASUREMENT,
+    LIBSPDM_DEVICE_SECRET_LIB_LOCK_COUNT
+} libspdm_device_secret_lib_lock_t;
+
+void libspdm_device_secret_lib_lock(libspdm_device_secret_lib_lock_t lock);
+
+void libspdm_device_secret_lib_unlock(libspdm_device_secret_lib_lock_t lock);
+
+/* sign */
+
+/* Free the private keys cached for signing. This must be called when the keys change.
+ * A key that is still in use by a signature is freed when that signature completes. */
+void libspdm_clear_signing_key_cache(void);
+
+/* Return true if the private key for (role, key_pair_id, asym algo) is cached. */
+bool libspdm_is_signing_key_cached(bool is_requester, uint8_t key_pair_id,
+                                   uint32_t base_asym_algo, uint32_t pqc_asym_algo);
+
 /* key pairs */
 #if LIBSPDM_ENABLE_CAPABILITY_GET_KEY_PAIR_INFO_CAP
 uint8_t libspdm_read_total_key_pairs(void *spdm_context);
 #endif
 
+/* measurements */
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+/* Called by the Integrator when a measured component changes. The cached measurement blocks are
+ * rebuilt, and the next signed MEASUREMENTS of every SPDM context reports
+ * SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED once. */
+void libspdm_measurement_changed(uint8_t measurement_index);
+#endif
+
+/* measurement extension log */
+#if (LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP) || (LIBSPDM_ENABLE_CAPABILITY_MEL_CAP)
+/* Append an entry to the MEL. Every HEM that has been read is extended with the entry, so that
+ * later HEM reads do not replay the log. Returns false if the log is full. */
+bool libspdm_append_mel_entry(uint8_t meas_index, uint8_t value_type,
+                              const void *value, uint16_t value_size);
+
+/* Clear the MEL and the running HEMs. The boot entries are generated again on the next use. */
+void libspdm_reset_mel(void);
+#endif
+
 /* External*/
 
 bool libspdm_read_input_file(const char *file_name, void **file_data,
@@ -0,0 +1,409 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include <stdlib.h>
+
+#include <base.h>
+#include "hal/library/memlib.h"
+#include "spdm_dhe_key_pool.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define LIBSPDM_DHE_KEY_POOL_THREADS 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define LIBSPDM_DHE_KEY_POOL_THREADS 1
+#define LIBSPDM_DHE_KEY_POOL_POSIX 1
+#endif
+
+typedef struct {
+    void *dhe_context;
+    size_t public_key_size;
+    uint8_t public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+} libspdm_dhe_key_pool_entry_t;
+
+typedef struct {
+    uint16_t dhe_named_group;
+    /* Key pairs ready for use. Only the first count entries are set. */
+    libspdm_dhe_key_pool_entry_t *entry;
+    size_t count;
+} libspdm_dhe_key_pool_group_t;
+
+/* The named groups whose key pair does not depend on the SPDM version or the role. */
+static const uint16_t m_libspdm_dhe_key_pool_named_group[] = {
+    SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048,
+    SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072,
+    SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_4096,
+    SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1,
+    SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1,
+    SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1,
+};
+
+#define LIBSPDM_DHE_KEY_POOL_GROUP_COUNT LIBSPDM_ARRAY_SIZE(m_libspdm_dhe_key_pool_named_group)
+
+static libspdm_dhe_key_pool_group_t m_libspdm_dhe_key_pool_group[LIBSPDM_DHE_KEY_POOL_GROUP_COUNT];
+static size_t m_libspdm_dhe_key_pool_group_count;
+static size_t m_libspdm_dhe_key_pool_depth;
+static bool m_libspdm_dhe_key_pool_started;
+static bool m_libspdm_dhe_key_pool_stopping;
+static libspdm_dhe_key_pool_stats_t m_libspdm_dhe_key_pool_stats;
+
+#if defined(_WIN32)
+static SRWLOCK m_libspdm_dhe_key_pool_lock = SRWLOCK_INIT;
+static CONDITION_VARIABLE m_libspdm_dhe_key_pool_refill_needed = CONDITION_VARIABLE_INIT;
+static HANDLE m_libspdm_dhe_key_pool_thread;
+#elif LIBSPDM_DHE_KEY_POOL_POSIX
+static pthread_mutex_t m_libspdm_dhe_key_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t m_libspdm_dhe_key_pool_refill_needed = PTHREAD_COND_INITIALIZER;
+static pthread_t m_libspdm_dhe_key_pool_thread;
+#endif
+static bool m_libspdm_dhe_key_pool_has_thread;
+
+static void libspdm_dhe_key_pool_lock(void)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&m_libspdm_dhe_key_pool_lock);
+#elif LIBSPDM_DHE_KEY_POOL_POSIX
+    pthread_mutex_lock(&m_libspdm_dhe_key_pool_lock);
+#endif
+}
+
+static void libspdm_dhe_key_pool_unlock(void)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&m_libspdm_dhe_key_pool_lock);
+#elif LIBSPDM_DHE_KEY_POOL_POSIX
+    pthread_mutex_unlock(&m_libspdm_dhe_key_pool_lock);
+#endif
+}
+
+static void libspdm_dhe_key_pool_signal(void)
+{
+#if defined(_WIN32)
+    WakeAllConditionVariable(&m_libspdm_dhe_key_pool_refill_needed);
+#elif LIBSPDM_DHE_KEY_POOL_POSIX
+    pthread_cond_broadcast(&m_libspdm_dhe_key_pool_refill_needed);
+#endif
+}
+
+/* Find the pool of a named group. The lock must be held. */
+static libspdm_dhe_key_pool_group_t *libspdm_dhe_key_pool_find(uint16_t dhe_named_group)
+{
+    size_t index;
+
+    for (index = 0; index < m_libspdm_dhe_key_pool_group_count; index++) {
+        if (m_libspdm_dhe_key_pool_group[index].dhe_named_group == dhe_named_group) {
+            return &m_libspdm_dhe_key_pool_group[index];
+        }
+    }
+    return NULL;
+}
+
+/* Find the emptiest pool that is not full. The lock must be held. */
+static libspdm_dhe_key_pool_group_t *libspdm_dhe_key_pool_find_refill(void)
+{
+    libspdm_dhe_key_pool_group_t *group;
+    size_t index;
+
+    if (!m_libspdm_dhe_key_pool_started || m_libspdm_dhe_key_pool_stopping) {
+        return NULL;
+    }
+    group = NULL;
+    for (index = 0; index < m_libspdm_dhe_key_pool_group_count; index++) {
+        if ((m_libspdm_dhe_key_pool_group[index].count < m_libspdm_dhe_key_pool_depth) &&
+            ((group == NULL) || (m_libspdm_dhe_key_pool_group[index].count < group->count))) {
+            group = &m_libspdm_dhe_key_pool_group[index];
+        }
+    }
+    return group;
+}
+
+static void libspdm_dhe_key_pool_wipe_entry(uint16_t dhe_named_group,
+                                            libspdm_dhe_key_pool_entry_t *entry)
+{
+    if (entry->dhe_context != NULL) {
+        libspdm_dhe_free(dhe_named_group, entry->dhe_context);
+    }
+    libspdm_zero_mem(entry, sizeof(*entry));
+}
+
+/**
+ * Generate one key pair for the emptiest pool. The key pair is generated without the lock held,
+ * so KEY_EXCHANGE requests are not held up.
+ *
+ * @retval 1   A key pair was added.
+ * @retval 0   The pool is full or stopping.
+ * @retval -1  The key pair could not be generated.
+ **/
+static int libspdm_dhe_key_pool_fill_one(void)
+{
+    libspdm_dhe_key_pool_group_t *group;
+    libspdm_dhe_key_pool_entry_t entry;
+    uint16_t dhe_named_group;
+
+    libspdm_dhe_key_pool_lock();
+    group = libspdm_dhe_key_pool_find_refill();
+    if (group == NULL) {
+        libspdm_dhe_key_pool_unlock();
+        return 0;
+    }
+    dhe_named_group = group->dhe_named_group;
+    libspdm_dhe_key_pool_unlock();
+
+    libspdm_zero_mem(&entry, sizeof(entry));
+    /* The SPDM version and the role only matter to SM2, which is not pooled. */
+    entry.dhe_context = libspdm_dhe_new(0, dhe_named_group, false);
+    entry.public_key_size = sizeof(entry.public_key);
+    if ((entry.dhe_context == NULL) ||
+        !libspdm_dhe_generate_key(dhe_named_group, entry.dhe_context,
+                                  entry.public_key, &entry.public_key_size)) {
+        libspdm_dhe_key_pool_wipe_entry(dhe_named_group, &entry);
+        libspdm_dhe_key_pool_lock();
+        m_libspdm_dhe_key_pool_stats.failed++;
+        libspdm_dhe_key_pool_unlock();
+        return -1;
+    }
+
+    libspdm_dhe_key_pool_lock();
+    /* The pool may have been stopped, or filled by another thread, in the meantime. */
+    group = libspdm_dhe_key_pool_find(dhe_named_group);
+    if (m_libspdm_dhe_key_pool_stopping || (group == NULL) ||
+        (group->count >= m_libspdm_dhe_key_pool_depth)) {
+        libspdm_dhe_key_pool_unlock();
+        libspdm_dhe_key_pool_wipe_entry(dhe_named_group, &entry);
+        return 0;
+    }
+    libspdm_copy_mem(&group->entry[group->count], sizeof(group->entry[group->count]),
+                     &entry, sizeof(entry));
+    group->count++;
+    m_libspdm_dhe_key_pool_stats.generated++;
+    libspdm_dhe_key_pool_unlock();
+
+    libspdm_zero_mem(&entry, sizeof(entry));
+    return 1;
+}
+
+#if LIBSPDM_DHE_KEY_POOL_THREADS
+static void libspdm_dhe_key_pool_refill_thread(void)
+{
+    int result;
+
+    for (;;) {
+        result = libspdm_dhe_key_pool_fill_one();
+        if (result > 0) {
+            continue;
+        }
+
+        /* Sleep until a key pair is taken. After a failed generation, that is also the next
+         * time a key pair is tried again. */
+        libspdm_dhe_key_pool_lock();
+        if (m_libspdm_dhe_key_pool_stopping) {
+            libspdm_dhe_key_pool_unlock();
+            break;
+        }
+        if ((result < 0) || (libspdm_dhe_key_pool_find_refill() == NULL)) {
+#if defined(_WIN32)
+            SleepConditionVariableSRW(&m_libspdm_dhe_key_pool_refill_needed,
+                                      &m_libspdm_dhe_key_pool_lock, INFINITE, 0);
+#else
+            pthread_cond_wait(&m_libspdm_dhe_key_pool_refill_needed,
+                              &m_libspdm_dhe_key_pool_lock);
+#endif
+        }
+        libspdm_dhe_key_pool_unlock();
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI libspdm_dhe_key_pool_thread_entry(LPVOID parameter)
+{
+    libspdm_dhe_key_pool_refill_thread();
+    return 0;
+}
+#else
+static void *libspdm_dhe_key_pool_thread_entry(void *parameter)
+{
+    libspdm_dhe_key_pool_refill_thread();
+    return NULL;
+}
+#endif
+#endif /* LIBSPDM_DHE_KEY_POOL_THREADS */
+
+bool libspdm_dhe_key_pool_start(uint16_t dhe_named_groups, size_t depth, bool background_refill)
+{
+    libspdm_dhe_key_pool_group_t *group;
+    size_t index;
+
+    if (depth == 0) {
+        return false;
+    }
+
+    libspdm_dhe_key_pool_lock();
+    if (m_libspdm_dhe_key_pool_started) {
+        libspdm_dhe_key_pool_unlock();
+        return false;
+    }
+    m_libspdm_dhe_key_pool_group_count = 0;
+    for (index = 0; index < LIBSPDM_DHE_KEY_POOL_GROUP_COUNT; index++) {
+        if ((dhe_named_groups & m_libspdm_dhe_key_pool_named_group[index]) == 0) {
+            continue;
+        }
+        if (libspdm_get_dhe_pub_key_size(m_libspdm_dhe_key_pool_named_group[index]) == 0) {
+            continue;
+        }
+        group = &m_libspdm_dhe_key_pool_group[m_libspdm_dhe_key_pool_group_count];
+        group->dhe_named_group = m_libspdm_dhe_key_pool_named_group[index];
+        group->count = 0;
+        group->entry = calloc(depth, sizeof(*group->entry));
+        if (group->entry == NULL) {
+            break;
+        }
+        m_libspdm_dhe_key_pool_group_count++;
+    }
+    if ((m_libspdm_dhe_key_pool_group_count == 0) ||
+        (index < LIBSPDM_DHE_KEY_POOL_GROUP_COUNT)) {
+        for (index = 0; index < m_libspdm_dhe_key_pool_group_count; index++) {
+            free(m_libspdm_dhe_key_pool_group[index].entry);
+        }
+        libspdm_zero_mem(m_libspdm_dhe_key_pool_group, sizeof(m_libspdm_dhe_key_pool_group));
+        m_libspdm_dhe_key_pool_group_count = 0;
+        libspdm_dhe_key_pool_unlock();
+        return false;
+    }
+    m_libspdm_dhe_key_pool_depth = depth;
+    m_libspdm_dhe_key_pool_stopping = false;
+    m_libspdm_dhe_key_pool_started = true;
+    libspdm_zero_mem(&m_libspdm_dhe_key_pool_stats, sizeof(m_libspdm_dhe_key_pool_stats));
+    libspdm_dhe_key_pool_unlock();
+
+    m_libspdm_dhe_key_pool_has_thread = false;
+#if LIBSPDM_DHE_KEY_POOL_THREADS
+    if (background_refill) {
+#if defined(_WIN32)
+        m_libspdm_dhe_key_pool_thread =
+            CreateThread(NULL, 0, libspdm_dhe_key_pool_thread_entry, NULL, 0, NULL);
+        m_libspdm_dhe_key_pool_has_thread = (m_libspdm_dhe_key_pool_thread != NULL);
+#else
+        m_libspdm_dhe_key_pool_has_thread =
+            (pthread_create(&m_libspdm_dhe_key_pool_thread, NULL,
+                            libspdm_dhe_key_pool_thread_entry, NULL) == 0);
+#endif
+        if (!m_libspdm_dhe_key_pool_has_thread) {
+            libspdm_dhe_key_pool_stop();
+            return false;
+        }
+    }
+#endif /* LIBSPDM_DHE_KEY_POOL_THREADS */
+
+    return true;
+}
+
+void *libspdm_dhe_key_pool_acquire_key_pair(void *spdm_context, uint16_t dhe_named_group,
+                                            uint8_t *public_key, size_t *public_key_size)
+{
+    libspdm_dhe_key_pool_group_t *group;
+    libspdm_dhe_key_pool_entry_t *entry;
+    void *dhe_context;
+
+    dhe_context = NULL;
+
+    libspdm_dhe_key_pool_lock();
+    group = NULL;
+    if (m_libspdm_dhe_key_pool_started && !m_libspdm_dhe_key_pool_stopping) {
+        group = libspdm_dhe_key_pool_find(dhe_named_group);
+    }
+    if (group == NULL) {
+        libspdm_dhe_key_pool_unlock();
+        return NULL;
+    }
+    if (group->count == 0) {
+        m_libspdm_dhe_key_pool_stats.misses++;
+    } else {
+        entry = &group->entry[group->count - 1];
+        if (*public_key_size >= entry->public_key_size) {
+            group->count--;
+            libspdm_copy_mem(public_key, *public_key_size,
+                             entry->public_key, entry->public_key_size);
+            *public_key_size = entry->public_key_size;
+            dhe_context = entry->dhe_context;
+            /* The key pair belongs to the caller now. Nothing of it is left in the pool. */
+            libspdm_zero_mem(entry, sizeof(*entry));
+            m_libspdm_dhe_key_pool_stats.hits++;
+        }
+    }
+    libspdm_dhe_key_pool_signal();
+    libspdm_dhe_key_pool_unlock();
+
+    return dhe_context;
+}
+
+size_t libspdm_dhe_key_pool_refill(void)
+{
+    size_t count;
+
+    count = 0;
+    while (libspdm_dhe_key_pool_fill_one() > 0) {
+        count++;
+    }
+    return count;
+}
+
+void libspdm_dhe_key_pool_get_stats(libspdm_dhe_key_pool_stats_t *stats)
+{
+    size_t index;
+
+    libspdm_dhe_key_pool_lock();
+    libspdm_copy_mem(stats, sizeof(*stats),
+                     &m_libspdm_dhe_key_pool_stats, sizeof(m_libspdm_dhe_key_pool_stats));
+    stats->available = 0;
+    for (index = 0; index < m_libspdm_dhe_key_pool_group_count; index++) {
+        stats->available += m_libspdm_dhe_key_pool_group[index].count;
+    }
+    libspdm_dhe_key_pool_unlock();
+}
+
+void libspdm_dhe_key_pool_stop(void)
+{
+    libspdm_dhe_key_pool_group_t *group;
+    size_t index;
+    size_t entry_index;
+
+    libspdm_dhe_key_pool_lock();
+    if (!m_libspdm_dhe_key_pool_started) {
+        libspdm_dhe_key_pool_unlock();
+        return;
+    }
+    m_libspdm_dhe_key_pool_stopping = true;
+    libspdm_dhe_key_pool_signal();
+    libspdm_dhe_key_pool_unlock();
+
+#if LIBSPDM_DHE_KEY_POOL_THREADS
+    if (m_libspdm_dhe_key_pool_has_thread) {
+#if defined(_WIN32)
+        WaitForSingleObject(m_libspdm_dhe_key_pool_thread, INFINITE);
+        CloseHandle(m_libspdm_dhe_key_pool_thread);
+#else
+        pthread_join(m_libspdm_dhe_key_pool_thread, NULL);
+#endif
+        m_libspdm_dhe_key_pool_has_thread = false;
+    }
+#endif /* LIBSPDM_DHE_KEY_POOL_THREADS */
+
+    libspdm_dhe_key_pool_lock();
+    for (index = 0; index < m_libspdm_dhe_key_pool_group_count; index++) {
+        group = &m_libspdm_dhe_key_pool_group[index];
+        for (entry_index = 0; entry_index < group->count; entry_index++) {
+            libspdm_dhe_key_pool_wipe_entry(group->dhe_named_group, &group->entry[entry_index]);
+        }
+        free(group->entry);
+    }
+    libspdm_zero_mem(m_libspdm_dhe_key_pool_group, sizeof(m_libspdm_dhe_key_pool_group));
+    m_libspdm_dhe_key_pool_group_count = 0;
+    libspdm_zero_mem(&m_libspdm_dhe_key_pool_stats, sizeof(m_libspdm_dhe_key_pool_stats));
+    m_libspdm_dhe_key_pool_started = false;
+    m_libspdm_dhe_key_pool_stopping = false;
+    libspdm_dhe_key_pool_unlock();
+}
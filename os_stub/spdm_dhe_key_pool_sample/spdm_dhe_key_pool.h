@@ -0,0 +1,83 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef SPDM_DHE_KEY_POOL_H
+#define SPDM_DHE_KEY_POOL_H
+
+#include "library/spdm_responder_lib.h"
+#include "library/spdm_crypt_lib.h"
+
+typedef struct {
+    /* Key pairs handed out to KEY_EXCHANGE, and requests that found the pool of their group
+     * empty. */
+    uint64_t hits;
+    uint64_t misses;
+    /* Key pairs generated for the pool, and generations that failed. */
+    uint64_t generated;
+    uint64_t failed;
+    /* Key pairs in the pool, over all groups. */
+    size_t available;
+} libspdm_dhe_key_pool_stats_t;
+
+/**
+ * Start the process-wide pool of ephemeral DHE key pairs.
+ *
+ * The pool keeps up to depth key pairs for each FFDHE and SECP named group in dhe_named_groups.
+ * SM2 key exchange binds its key pair to the SPDM version and role, so it is not pooled.
+ *
+ * @param  dhe_named_groups   A bitmask of SPDM_ALGORITHMS_DHE_NAMED_GROUP_*.
+ * @param  depth              The number of key pairs kept for each group.
+ * @param  background_refill  If true, a thread refills the pool whenever a key pair is taken.
+ *                            It is ignored on targets without threads.
+ *                            Otherwise the Integrator calls libspdm_dhe_key_pool_refill, such as
+ *                            when the Responder is idle.
+ *
+ * @retval true   The pool is started. It is empty until it is refilled.
+ * @retval false  The pool is already started, no group can be pooled, or it could not be
+ *                allocated.
+ **/
+bool libspdm_dhe_key_pool_start(uint16_t dhe_named_groups, size_t depth, bool background_refill);
+
+/**
+ * The callback function that takes a key pair from the pool. It is registered with
+ * libspdm_register_dhe_key_pair_func by every Responder context that uses the pool.
+ *
+ * The key pair is removed from the pool and its copy of the public key is wiped, so it is used
+ * by one KEY_EXCHANGE only. If the pool of the group is empty, NULL is returned and libspdm
+ * generates the key pair on the request path.
+ *
+ * @param  spdm_context     A pointer to the SPDM context.
+ * @param  dhe_named_group  The negotiated DHE named group.
+ * @param  public_key       A pointer to the buffer to receive the public key.
+ * @param  public_key_size  On input, the size in bytes of public_key.
+ *                          On output, the size in bytes of the public key.
+ *
+ * @return The DHE context, or NULL.
+ **/
+void *libspdm_dhe_key_pool_acquire_key_pair(void *spdm_context, uint16_t dhe_named_group,
+                                            uint8_t *public_key, size_t *public_key_size);
+
+/**
+ * Fill the pool on the calling thread.
+ *
+ * @return The number of key pairs generated.
+ **/
+size_t libspdm_dhe_key_pool_refill(void);
+
+/**
+ * Read the counters of the pool.
+ *
+ * @param  stats  On output, the counters.
+ **/
+void libspdm_dhe_key_pool_get_stats(libspdm_dhe_key_pool_stats_t *stats);
+
+/**
+ * Stop the refill thread, and wipe and free the key pairs in the pool. The counters are reset.
+ * Contexts that take a key pair while the pool is stopped generate it on the request path.
+ **/
+void libspdm_dhe_key_pool_stop(void);
+
+#endif
@@ -0,0 +1,898 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/* accept4, epoll and eventfd are Linux interfaces. */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#include <base.h>
+#include "hal/library/debuglib.h"
+#include "hal/library/memlib.h"
+#include "spdm_tcp_responder_host.h"
+
+#define LIBSPDM_TCP_RESPONDER_HOST_MAX_EVENTS 64
+
+typedef enum {
+    LIBSPDM_TCP_CONNECTION_FREE,
+    /* Reading a request. */
+    LIBSPDM_TCP_CONNECTION_READING,
+    /* A complete request that waits for room in the work queue. */
+    LIBSPDM_TCP_CONNECTION_WAITING,
+    /* A complete request in the work queue or on a worker. */
+    LIBSPDM_TCP_CONNECTION_DISPATCHING,
+    /* Writing a response. */
+    LIBSPDM_TCP_CONNECTION_WRITING,
+} libspdm_tcp_connection_state_t;
+
+typedef struct libspdm_tcp_connection libspdm_tcp_connection_t;
+
+struct libspdm_tcp_connection {
+    libspdm_tcp_responder_host_t *host;
+    int fd;
+    libspdm_tcp_connection_state_t state;
+    /* The peer closed or failed while a worker owned the connection. It is released once the
+     * event loop gets it back. */
+    bool closing;
+    /* Close the connection once the response is written. */
+    bool close_after_write;
+    void *spdm_context;
+    void *scratch_buffer;
+    /* The device buffers of the context. A request is read directly into receiver_buffer. */
+    uint8_t *sender_buffer;
+    uint8_t *receiver_buffer;
+    /* The bytes of the request that are read, and the size of its transport message once the
+     * TCP binding header is read. */
+    size_t request_size;
+    size_t frame_size;
+    /* The response in sender_buffer, or in control_message for a TCP binding error message. */
+    const uint8_t *response;
+    size_t response_size;
+    size_t response_offset;
+    uint8_t control_message[sizeof(spdm_tcp_binding_header_t)];
+    libspdm_return_t status;
+    /* Link in the free list, the work queue, the completed list or the waiting list. */
+    libspdm_tcp_connection_t *next;
+};
+
+struct libspdm_tcp_responder_host {
+    libspdm_tcp_responder_host_config_t config;
+    size_t buffer_size;
+    int listen_fd;
+    int epoll_fd;
+    int event_fd;
+    uint16_t port;
+    volatile sig_atomic_t stop_requested;
+
+    libspdm_tcp_connection_t *connection;
+    pthread_t *worker;
+    size_t worker_count;
+
+    /* Protected by lock. */
+    pthread_mutex_t lock;
+    pthread_cond_t work_available;
+    libspdm_tcp_connection_t *queue_head;
+    libspdm_tcp_connection_t *queue_tail;
+    size_t queued_count;
+    libspdm_tcp_connection_t *completed;
+    bool stopping;
+    libspdm_tcp_responder_host_stats_t stats;
+
+    /* Owned by the event loop. */
+    libspdm_tcp_connection_t *free_list;
+    libspdm_tcp_connection_t *waiting_head;
+    libspdm_tcp_connection_t *waiting_tail;
+    size_t waiting_count;
+    bool listen_paused;
+};
+
+static libspdm_tcp_connection_t *libspdm_tcp_get_connection(void *spdm_context)
+{
+    libspdm_data_parameter_t parameter;
+    void *connection;
+    size_t data_size;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(connection);
+    connection = NULL;
+    libspdm_get_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter, &connection,
+                     &data_size);
+    LIBSPDM_ASSERT(connection != NULL);
+    return connection;
+}
+
+static libspdm_return_t libspdm_tcp_acquire_sender_buffer(void *spdm_context,
+                                                          void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_tcp_get_connection(spdm_context)->sender_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_tcp_release_sender_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+    LIBSPDM_ASSERT(msg_buf_ptr == libspdm_tcp_get_connection(spdm_context)->sender_buffer);
+}
+
+static libspdm_return_t libspdm_tcp_acquire_receiver_buffer(void *spdm_context,
+                                                            void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_tcp_get_connection(spdm_context)->receiver_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_tcp_release_receiver_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+    LIBSPDM_ASSERT(msg_buf_ptr == libspdm_tcp_get_connection(spdm_context)->receiver_buffer);
+}
+
+/* The event loop has already read the request into the receiver buffer. */
+static libspdm_return_t libspdm_tcp_receive_message(void *spdm_context, size_t *message_size,
+                                                    void **message, uint64_t timeout)
+{
+    libspdm_tcp_connection_t *connection;
+
+    connection = libspdm_tcp_get_connection(spdm_context);
+    if ((*message != connection->receiver_buffer) ||
+        (*message_size < connection->request_size)) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    *message_size = connection->request_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* The response stays in the sender buffer until the event loop has written it. */
+static libspdm_return_t libspdm_tcp_send_message(void *spdm_context, size_t message_size,
+                                                 const void *message, uint64_t timeout)
+{
+    libspdm_tcp_connection_t *connection;
+
+    connection = libspdm_tcp_get_connection(spdm_context);
+    connection->response = message;
+    connection->response_size = message_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static bool libspdm_tcp_connection_init(libspdm_tcp_responder_host_t *host,
+                                        libspdm_tcp_connection_t *connection)
+{
+    libspdm_data_parameter_t parameter;
+    size_t scratch_buffer_size;
+
+    connection->host = host;
+    connection->fd = -1;
+    connection->sender_buffer = malloc(host->buffer_size);
+    connection->receiver_buffer = malloc(host->buffer_size);
+    connection->spdm_context = malloc(libspdm_get_context_size());
+    if ((connection->sender_buffer == NULL) || (connection->receiver_buffer == NULL) ||
+        (connection->spdm_context == NULL)) {
+        /* The context is only deinitialized when it has been initialized. */
+        free(connection->spdm_context);
+        connection->spdm_context = NULL;
+        return false;
+    }
+    libspdm_init_context(connection->spdm_context);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    libspdm_set_data(connection->spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter,
+                     &connection, sizeof(connection));
+
+    libspdm_register_device_io_func(connection->spdm_context, libspdm_tcp_send_message,
+                                    libspdm_tcp_receive_message);
+    libspdm_register_device_buffer_func(connection->spdm_context,
+                                        (uint32_t)host->buffer_size,
+                                        (uint32_t)host->buffer_size,
+                                        libspdm_tcp_acquire_sender_buffer,
+                                        libspdm_tcp_release_sender_buffer,
+                                        libspdm_tcp_acquire_receiver_buffer,
+                                        libspdm_tcp_release_receiver_buffer);
+    libspdm_register_transport_layer_func(connection->spdm_context,
+                                          host->config.max_spdm_msg_size,
+                                          LIBSPDM_TCP_TRANSPORT_HEADER_SIZE,
+                                          LIBSPDM_TCP_TRANSPORT_TAIL_SIZE,
+                                          libspdm_transport_tcp_encode_message,
+                                          libspdm_transport_tcp_decode_message);
+
+    if (!host->config.init_context(connection->spdm_context, host->config.user_data)) {
+        return false;
+    }
+
+    /* The required size depends on the capabilities set by init_context. */
+    scratch_buffer_size = libspdm_get_sizeof_required_scratch_buffer(connection->spdm_context);
+    connection->scratch_buffer = malloc(scratch_buffer_size);
+    if (connection->scratch_buffer == NULL) {
+        return false;
+    }
+    libspdm_set_scratch_buffer(connection->spdm_context, connection->scratch_buffer,
+                               scratch_buffer_size);
+
+    return true;
+}
+
+static void libspdm_tcp_connection_free(libspdm_tcp_connection_t *connection)
+{
+    if (connection->fd >= 0) {
+        close(connection->fd);
+    }
+    if (connection->spdm_context != NULL) {
+        libspdm_deinit_context(connection->spdm_context);
+        free(connection->spdm_context);
+    }
+    free(connection->scratch_buffer);
+    free(connection->sender_buffer);
+    free(connection->receiver_buffer);
+}
+
+static bool libspdm_tcp_watch(libspdm_tcp_responder_host_t *host, int fd, void *ptr,
+                              uint32_t events)
+{
+    struct epoll_event event;
+
+    libspdm_zero_mem(&event, sizeof(event));
+    event.events = events;
+    event.data.ptr = ptr;
+    return epoll_ctl(host->epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+static void libspdm_tcp_wake(libspdm_tcp_responder_host_t *host)
+{
+    uint64_t one;
+    ssize_t written;
+
+    one = 1;
+    written = write(host->event_fd, &one, sizeof(one));
+    (void)written;
+}
+
+static void libspdm_tcp_update_peak(libspdm_tcp_responder_host_t *host)
+{
+    if (host->queued_count + host->waiting_count > host->stats.peak_waiting_requests) {
+        host->stats.peak_waiting_requests = host->queued_count + host->waiting_count;
+    }
+}
+
+/* Close the socket and reset the context for the next connection. */
+static void libspdm_tcp_release(libspdm_tcp_connection_t *connection)
+{
+    libspdm_tcp_responder_host_t *host;
+
+    host = connection->host;
+    close(connection->fd);
+    connection->fd = -1;
+    connection->state = LIBSPDM_TCP_CONNECTION_FREE;
+    connection->closing = false;
+
+    libspdm_deinit_context(connection->spdm_context);
+    libspdm_reset_context(connection->spdm_context);
+
+    connection->next = host->free_list;
+    host->free_list = connection;
+
+    pthread_mutex_lock(&host->lock);
+    host->stats.closed_connections++;
+    host->stats.active_connections--;
+    pthread_mutex_unlock(&host->lock);
+
+    if (host->listen_paused &&
+        libspdm_tcp_watch(host, host->listen_fd, NULL, EPOLLIN)) {
+        host->listen_paused = false;
+    }
+}
+
+/* Close a connection on behalf of the event loop. A connection that a worker owns is released
+ * when the worker is done with it. */
+static void libspdm_tcp_close(libspdm_tcp_connection_t *connection)
+{
+    if ((connection->state == LIBSPDM_TCP_CONNECTION_WAITING) ||
+        (connection->state == LIBSPDM_TCP_CONNECTION_DISPATCHING)) {
+        epoll_ctl(connection->host->epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+        connection->closing = true;
+        return;
+    }
+    libspdm_tcp_release(connection);
+}
+
+static void libspdm_tcp_start_reading(libspdm_tcp_connection_t *connection)
+{
+    connection->state = LIBSPDM_TCP_CONNECTION_READING;
+    connection->request_size = 0;
+    connection->frame_size = 0;
+    if (!libspdm_tcp_watch(connection->host, connection->fd, connection, EPOLLIN)) {
+        libspdm_tcp_release(connection);
+    }
+}
+
+static void libspdm_tcp_write(libspdm_tcp_connection_t *connection)
+{
+    ssize_t written;
+
+    while (connection->response_offset < connection->response_size) {
+        written = send(connection->fd, connection->response + connection->response_offset,
+                       connection->response_size - connection->response_offset, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                if (!libspdm_tcp_watch(connection->host, connection->fd, connection,
+                                       EPOLLOUT)) {
+                    libspdm_tcp_release(connection);
+                }
+                return;
+            }
+            libspdm_tcp_release(connection);
+            return;
+        }
+        connection->response_offset += (size_t)written;
+    }
+
+    if (connection->close_after_write) {
+        libspdm_tcp_release(connection);
+        return;
+    }
+    libspdm_tcp_start_reading(connection);
+}
+
+static void libspdm_tcp_start_writing(libspdm_tcp_connection_t *connection,
+                                      const uint8_t *response, size_t response_size)
+{
+    connection->state = LIBSPDM_TCP_CONNECTION_WRITING;
+    connection->response = response;
+    connection->response_size = response_size;
+    connection->response_offset = 0;
+    libspdm_tcp_write(connection);
+}
+
+/* Answer a transport message that the host does not pass to libspdm with a TCP binding error
+ * message. */
+static void libspdm_tcp_reject(libspdm_tcp_connection_t *connection, uint8_t message_type,
+                               bool close_after_write)
+{
+    libspdm_tcp_responder_host_t *host;
+    size_t message_size;
+    void *message;
+
+    host = connection->host;
+    pthread_mutex_lock(&host->lock);
+    host->stats.rejected_messages++;
+    pthread_mutex_unlock(&host->lock);
+
+    message_size = sizeof(connection->control_message);
+    message = connection->control_message;
+    if (LIBSPDM_STATUS_IS_ERROR(libspdm_tcp_encode_discovery_message(message_type,
+                                                                     &message_size,
+                                                                     &message))) {
+        libspdm_tcp_release(connection);
+        return;
+    }
+    connection->close_after_write = close_after_write;
+    libspdm_tcp_start_writing(connection, connection->control_message, message_size);
+}
+
+/* Append a connection to the work queue. The lock must be held. */
+static void libspdm_tcp_enqueue(libspdm_tcp_responder_host_t *host,
+                                libspdm_tcp_connection_t *connection)
+{
+    connection->state = LIBSPDM_TCP_CONNECTION_DISPATCHING;
+    connection->next = NULL;
+    if (host->queue_tail == NULL) {
+        host->queue_head = connection;
+    } else {
+        host->queue_tail->next = connection;
+    }
+    host->queue_tail = connection;
+    host->queued_count++;
+    pthread_cond_signal(&host->work_available);
+}
+
+/* Hand a complete request to the workers, or hold it until the work queue has room. */
+static void libspdm_tcp_dispatch(libspdm_tcp_connection_t *connection)
+{
+    libspdm_tcp_responder_host_t *host;
+
+    host = connection->host;
+    pthread_mutex_lock(&host->lock);
+    if ((host->waiting_count == 0) && (host->queued_count < host->config.max_queued_requests)) {
+        libspdm_tcp_enqueue(host, connection);
+    } else {
+        connection->state = LIBSPDM_TCP_CONNECTION_WAITING;
+        connection->next = NULL;
+        if (host->waiting_tail == NULL) {
+            host->waiting_head = connection;
+        } else {
+            host->waiting_tail->next = connection;
+        }
+        host->waiting_tail = connection;
+        host->waiting_count++;
+    }
+    libspdm_tcp_update_peak(host);
+    pthread_mutex_unlock(&host->lock);
+}
+
+/* Move held requests to the work queue, in the order they were completed. */
+static void libspdm_tcp_dispatch_waiting(libspdm_tcp_responder_host_t *host)
+{
+    libspdm_tcp_connection_t *connection;
+    libspdm_tcp_connection_t *closed;
+
+    closed = NULL;
+    pthread_mutex_lock(&host->lock);
+    while ((host->waiting_head != NULL) &&
+           (host->queued_count < host->config.max_queued_requests)) {
+        connection = host->waiting_head;
+        host->waiting_head = connection->next;
+        if (host->waiting_head == NULL) {
+            host->waiting_tail = NULL;
+        }
+        host->waiting_count--;
+        if (connection->closing) {
+            connection->next = closed;
+            closed = connection;
+        } else {
+            libspdm_tcp_enqueue(host, connection);
+        }
+    }
+    pthread_mutex_unlock(&host->lock);
+
+    while (closed != NULL) {
+        connection = closed;
+        closed = connection->next;
+        libspdm_tcp_release(connection);
+    }
+}
+
+/* Parse the TCP binding header of a request. */
+static void libspdm_tcp_parse_header(libspdm_tcp_connection_t *connection)
+{
+    const spdm_tcp_binding_header_t *header;
+    uint8_t message_type;
+
+    header = (const spdm_tcp_binding_header_t *)connection->receiver_buffer;
+    if ((header->message_type == SPDM_TCP_MESSAGE_TYPE_OUT_OF_SESSION) ||
+        (header->message_type == SPDM_TCP_MESSAGE_TYPE_IN_SESSION)) {
+        if (header->binding_version != 0x01) {
+            libspdm_tcp_reject(connection, SPDM_TCP_MESSAGE_TYPE_ERROR_NOT_SUPPORTED, true);
+            return;
+        }
+        /* The payload length counts the bytes that follow it. */
+        connection->frame_size = sizeof(header->payload_length) + header->payload_length;
+        if (connection->frame_size <= sizeof(spdm_tcp_binding_header_t)) {
+            libspdm_tcp_release(connection);
+        } else if (connection->frame_size > connection->host->buffer_size) {
+            /* The rest of the message cannot be skipped reliably, so the connection ends. */
+            libspdm_tcp_reject(connection, SPDM_TCP_MESSAGE_TYPE_ERROR_TOO_LARGE, true);
+        }
+        return;
+    }
+
+    if (LIBSPDM_STATUS_IS_ERROR(libspdm_tcp_decode_discovery_message(
+                                    connection->request_size, connection->receiver_buffer,
+                                    &message_type))) {
+        libspdm_tcp_reject(connection, SPDM_TCP_MESSAGE_TYPE_ERROR_NOT_SUPPORTED, true);
+    } else if (message_type == SPDM_TCP_MESSAGE_TYPE_ROLE_INQUIRY) {
+        /* The host only acts as a Responder. */
+        libspdm_tcp_reject(connection,
+                           SPDM_TCP_MESSAGE_TYPE_ERROR_CANNOT_OPERATE_AS_REQUESTER, false);
+    } else {
+        /* An error message from the peer needs no answer. */
+        connection->request_size = 0;
+    }
+}
+
+/* Read the request of a connection. Only the bytes of the current transport message are read, so
+ * a request that follows stays in the socket until the response is written. */
+static void libspdm_tcp_read(libspdm_tcp_connection_t *connection)
+{
+    size_t expected_size;
+    ssize_t received;
+
+    for (;;) {
+        expected_size = (connection->frame_size == 0) ?
+                        sizeof(spdm_tcp_binding_header_t) : connection->frame_size;
+        received = recv(connection->fd, connection->receiver_buffer + connection->request_size,
+                        expected_size - connection->request_size, 0);
+        if (received == 0) {
+            libspdm_tcp_release(connection);
+            return;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                libspdm_tcp_release(connection);
+            }
+            return;
+        }
+        connection->request_size += (size_t)received;
+        if (connection->request_size < expected_size) {
+            continue;
+        }
+
+        if (connection->frame_size == 0) {
+            libspdm_tcp_parse_header(connection);
+            if ((connection->state != LIBSPDM_TCP_CONNECTION_READING) ||
+                (connection->frame_size == 0)) {
+                return;
+            }
+            continue;
+        }
+
+        if (!libspdm_tcp_watch(connection->host, connection->fd, connection, 0)) {
+            libspdm_tcp_release(connection);
+            return;
+        }
+        libspdm_tcp_dispatch(connection);
+        return;
+    }
+}
+
+static void libspdm_tcp_accept(libspdm_tcp_responder_host_t *host)
+{
+    libspdm_tcp_connection_t *connection;
+    struct epoll_event event;
+    int fd;
+    int value;
+
+    while (host->free_list != NULL) {
+        fd = accept4(host->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                return;
+            }
+            if ((errno == EMFILE) || (errno == ENFILE) || (errno == ENOBUFS) ||
+                (errno == ENOMEM)) {
+                /* Wait for a connection to close before accepting again. */
+                break;
+            }
+            /* The peer is gone before it was accepted. */
+            continue;
+        }
+
+        /* Each message is a single request or response that the peer waits for. */
+        value = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+
+        connection = host->free_list;
+        libspdm_zero_mem(&event, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        if (epoll_ctl(host->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        host->free_list = connection->next;
+        connection->fd = fd;
+        connection->close_after_write = false;
+        connection->state = LIBSPDM_TCP_CONNECTION_READING;
+        connection->request_size = 0;
+        connection->frame_size = 0;
+
+        pthread_mutex_lock(&host->lock);
+        host->stats.accepted_connections++;
+        host->stats.active_connections++;
+        pthread_mutex_unlock(&host->lock);
+    }
+
+    /* Further connections wait in the listen backlog. */
+    if (libspdm_tcp_watch(host, host->listen_fd, NULL, 0)) {
+        host->listen_paused = true;
+    }
+}
+
+/* Take the connections back from the workers. */
+static void libspdm_tcp_complete(libspdm_tcp_responder_host_t *host)
+{
+    libspdm_tcp_connection_t *connection;
+    libspdm_tcp_connection_t *next;
+    uint64_t count;
+    ssize_t received;
+
+    received = read(host->event_fd, &count, sizeof(count));
+    (void)received;
+
+    pthread_mutex_lock(&host->lock);
+    connection = host->completed;
+    host->completed = NULL;
+    pthread_mutex_unlock(&host->lock);
+
+    for (; connection != NULL; connection = next) {
+        next = connection->next;
+        if (connection->closing) {
+            libspdm_tcp_release(connection);
+        } else if (LIBSPDM_STATUS_IS_ERROR(connection->status) ||
+                   (connection->response_size == 0)) {
+            /* A request that could not be decoded, such as a secured message that fails
+             * authentication, is dropped without a response. */
+            libspdm_tcp_start_reading(connection);
+        } else {
+            libspdm_tcp_start_writing(connection, connection->response,
+                                      connection->response_size);
+        }
+    }
+
+    libspdm_tcp_dispatch_waiting(host);
+}
+
+static void libspdm_tcp_handle_event(libspdm_tcp_connection_t *connection, uint32_t events)
+{
+    if (connection->state == LIBSPDM_TCP_CONNECTION_FREE) {
+        return;
+    }
+    if ((events & EPOLLERR) != 0) {
+        libspdm_tcp_close(connection);
+        return;
+    }
+    switch (connection->state) {
+    case LIBSPDM_TCP_CONNECTION_READING:
+        /* A hang up is seen as the end of the stream once the received data is read. */
+        if ((events & (EPOLLIN | EPOLLHUP)) != 0) {
+            libspdm_tcp_read(connection);
+        }
+        break;
+    case LIBSPDM_TCP_CONNECTION_WRITING:
+        if ((events & EPOLLHUP) != 0) {
+            libspdm_tcp_release(connection);
+        } else if ((events & EPOLLOUT) != 0) {
+            libspdm_tcp_write(connection);
+        }
+        break;
+    default:
+        if ((events & EPOLLHUP) != 0) {
+            libspdm_tcp_close(connection);
+        }
+        break;
+    }
+}
+
+static void *libspdm_tcp_worker(void *context)
+{
+    libspdm_tcp_responder_host_t *host;
+    libspdm_tcp_connection_t *connection;
+    libspdm_return_t status;
+
+    host = context;
+    pthread_mutex_lock(&host->lock);
+    for (;;) {
+        while ((host->queue_head == NULL) && !host->stopping) {
+            pthread_cond_wait(&host->work_available, &host->lock);
+        }
+        if (host->stopping) {
+            break;
+        }
+        connection = host->queue_head;
+        host->queue_head = connection->next;
+        if (host->queue_head == NULL) {
+            host->queue_tail = NULL;
+        }
+        host->queued_count--;
+        pthread_mutex_unlock(&host->lock);
+
+        connection->response_size = 0;
+        status = libspdm_responder_dispatch_message(connection->spdm_context);
+
+        pthread_mutex_lock(&host->lock);
+        connection->status = status;
+        host->stats.requests++;
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            host->stats.failed_requests++;
+        }
+        connection->next = host->completed;
+        host->completed = connection;
+        libspdm_tcp_wake(host);
+    }
+    pthread_mutex_unlock(&host->lock);
+    return NULL;
+}
+
+static int libspdm_tcp_listen(const libspdm_tcp_responder_host_config_t *config, uint16_t *port)
+{
+    struct sockaddr_in address;
+    socklen_t address_size;
+    int fd;
+    int value;
+
+    libspdm_zero_mem(&address, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config->port);
+    if (inet_pton(AF_INET, (config->address == NULL) ? "127.0.0.1" : config->address,
+                  &address.sin_addr) != 1) {
+        return -1;
+    }
+
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    value = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value));
+    address_size = sizeof(address);
+    if ((bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0) ||
+        (listen(fd, SOMAXCONN) != 0) ||
+        (getsockname(fd, (struct sockaddr *)&address, &address_size) != 0)) {
+        close(fd);
+        return -1;
+    }
+    *port = ntohs(address.sin_port);
+    return fd;
+}
+
+libspdm_tcp_responder_host_t *libspdm_tcp_responder_host_new(
+    const libspdm_tcp_responder_host_config_t *config)
+{
+    libspdm_tcp_responder_host_t *host;
+    struct epoll_event event;
+    size_t index;
+
+    if ((config->max_connections == 0) || (config->worker_count == 0) ||
+        (config->max_queued_requests == 0) || (config->init_context == NULL)) {
+        return NULL;
+    }
+    /* The payload length of the TCP binding header is 16 bits. */
+    if ((config->max_spdm_msg_size == 0) ||
+        ((size_t)config->max_spdm_msg_size + LIBSPDM_TCP_TRANSPORT_HEADER_SIZE +
+         LIBSPDM_TCP_TRANSPORT_TAIL_SIZE > (size_t)UINT16_MAX + sizeof(uint16_t))) {
+        return NULL;
+    }
+
+    host = calloc(1, sizeof(*host));
+    if (host == NULL) {
+        return NULL;
+    }
+    host->config = *config;
+    host->buffer_size = (size_t)config->max_spdm_msg_size + LIBSPDM_TCP_TRANSPORT_HEADER_SIZE +
+                        LIBSPDM_TCP_TRANSPORT_TAIL_SIZE;
+    host->listen_fd = -1;
+    host->epoll_fd = -1;
+    host->event_fd = -1;
+    pthread_mutex_init(&host->lock, NULL);
+    pthread_cond_init(&host->work_available, NULL);
+
+    host->connection = calloc(config->max_connections, sizeof(*host->connection));
+    host->worker = calloc(config->worker_count, sizeof(*host->worker));
+    if ((host->connection == NULL) || (host->worker == NULL)) {
+        libspdm_tcp_responder_host_free(host);
+        return NULL;
+    }
+    /* Connections that are not initialized yet must not close descriptor 0 when freed. */
+    for (index = 0; index < config->max_connections; index++) {
+        host->connection[index].fd = -1;
+    }
+    for (index = config->max_connections; index > 0; index--) {
+        if (!libspdm_tcp_connection_init(host, &host->connection[index - 1])) {
+            libspdm_tcp_responder_host_free(host);
+            return NULL;
+        }
+        host->connection[index - 1].next = host->free_list;
+        host->free_list = &host->connection[index - 1];
+    }
+
+    host->listen_fd = libspdm_tcp_listen(config, &host->port);
+    host->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    host->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((host->listen_fd < 0) || (host->epoll_fd < 0) || (host->event_fd < 0)) {
+        libspdm_tcp_responder_host_free(host);
+        return NULL;
+    }
+    libspdm_zero_mem(&event, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(host->epoll_fd, EPOLL_CTL_ADD, host->listen_fd, &event) != 0) {
+        libspdm_tcp_responder_host_free(host);
+        return NULL;
+    }
+    event.data.ptr = host;
+    if (epoll_ctl(host->epoll_fd, EPOLL_CTL_ADD, host->event_fd, &event) != 0) {
+        libspdm_tcp_responder_host_free(host);
+        return NULL;
+    }
+
+    for (host->worker_count = 0; host->worker_count < config->worker_count;
+         host->worker_count++) {
+        if (pthread_create(&host->worker[host->worker_count], NULL, libspdm_tcp_worker,
+                           host) != 0) {
+            libspdm_tcp_responder_host_free(host);
+            return NULL;
+        }
+    }
+
+    return host;
+}
+
+uint16_t libspdm_tcp_responder_host_get_port(const libspdm_tcp_responder_host_t *host)
+{
+    return host->port;
+}
+
+bool libspdm_tcp_responder_host_run(libspdm_tcp_responder_host_t *host)
+{
+    struct epoll_event event[LIBSPDM_TCP_RESPONDER_HOST_MAX_EVENTS];
+    int count;
+    int index;
+
+    while (!host->stop_requested) {
+        count = epoll_wait(host->epoll_fd, event, LIBSPDM_TCP_RESPONDER_HOST_MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        for (index = 0; index < count; index++) {
+            if (event[index].data.ptr == NULL) {
+                libspdm_tcp_accept(host);
+            } else if (event[index].data.ptr == host) {
+                libspdm_tcp_complete(host);
+            } else {
+                libspdm_tcp_handle_event(event[index].data.ptr, event[index].events);
+            }
+        }
+    }
+    return true;
+}
+
+void libspdm_tcp_responder_host_stop(libspdm_tcp_responder_host_t *host)
+{
+    host->stop_requested = 1;
+    libspdm_tcp_wake(host);
+}
+
+void libspdm_tcp_responder_host_get_stats(libspdm_tcp_responder_host_t *host,
+                                          libspdm_tcp_responder_host_stats_t *stats)
+{
+    pthread_mutex_lock(&host->lock);
+    *stats = host->stats;
+    pthread_mutex_unlock(&host->lock);
+}
+
+void libspdm_tcp_responder_host_free(libspdm_tcp_responder_host_t *host)
+{
+    size_t index;
+
+    pthread_mutex_lock(&host->lock);
+    host->stopping = true;
+    pthread_cond_broadcast(&host->work_available);
+    pthread_mutex_unlock(&host->lock);
+    for (index = 0; index < host->worker_count; index++) {
+        pthread_join(host->worker[index], NULL);
+    }
+
+    if (host->connection != NULL) {
+        for (index = 0; index < host->config.max_connections; index++) {
+            libspdm_tcp_connection_free(&host->connection[index]);
+        }
+    }
+    if (host->event_fd >= 0) {
+        close(host->event_fd);
+    }
+    if (host->epoll_fd >= 0) {
+        close(host->epoll_fd);
+    }
+    if (host->listen_fd >= 0) {
+        close(host->listen_fd);
+    }
+    pthread_cond_destroy(&host->work_available);
+    pthread_mutex_destroy(&host->lock);
+    free(host->worker);
+    free(host->connection);
+    free(host);
+}
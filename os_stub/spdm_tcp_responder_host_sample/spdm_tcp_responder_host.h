@@ -0,0 +1,126 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef SPDM_TCP_RESPONDER_HOST_H
+#define SPDM_TCP_RESPONDER_HOST_H
+
+#include "library/spdm_responder_lib.h"
+#include "library/spdm_transport_tcp_lib.h"
+
+typedef struct libspdm_tcp_responder_host libspdm_tcp_responder_host_t;
+
+/**
+ * Called once for each pooled SPDM context when the host is created. It sets the local
+ * capabilities, algorithms and certificates of the context, as for a single-connection Responder.
+ * It must not register device I/O, buffer or transport functions, because the host owns them.
+ *
+ * @param  spdm_context  The SPDM context.
+ * @param  user_data     The user_data of the configuration.
+ *
+ * @retval true   The context is ready.
+ * @retval false  The context could not be configured. The host is not created.
+ **/
+typedef bool (*libspdm_tcp_responder_host_init_context_func)(void *spdm_context,
+                                                             void *user_data);
+
+typedef struct {
+    /* IPv4 address to listen on, in dotted-decimal form. NULL means 127.0.0.1. */
+    const char *address;
+    /* TCP port to listen on. 0 picks a free port, see libspdm_tcp_responder_host_get_port. */
+    uint16_t port;
+    /* The number of pooled SPDM contexts, which is the number of connections served at the same
+     * time. Further connections wait in the listen backlog until a connection closes. */
+    size_t max_connections;
+    /* The number of worker threads that run libspdm_responder_dispatch_message. */
+    size_t worker_count;
+    /* The number of complete requests that may wait for a worker. Further complete requests are
+     * held by the event loop, and their connections are not read until a worker is free. */
+    size_t max_queued_requests;
+    /* The maximum SPDM message size of each context. */
+    uint32_t max_spdm_msg_size;
+    libspdm_tcp_responder_host_init_context_func init_context;
+    void *user_data;
+} libspdm_tcp_responder_host_config_t;
+
+typedef struct {
+    uint64_t accepted_connections;
+    uint64_t closed_connections;
+    /* Requests passed to libspdm_responder_dispatch_message, and the ones that failed. */
+    uint64_t requests;
+    uint64_t failed_requests;
+    /* Transport messages that were answered with a TCP binding error message. */
+    uint64_t rejected_messages;
+    size_t active_connections;
+    /* The highest number of complete requests that waited for a worker, including the ones held
+     * by the event loop. */
+    size_t peak_waiting_requests;
+} libspdm_tcp_responder_host_stats_t;
+
+/**
+ * Create a Responder host that serves many SPDM-over-TCP connections.
+ *
+ * Each accepted connection is bound to one pooled SPDM context. An event loop reads the sockets
+ * without blocking and frames each transport message with its TCP binding header. A complete
+ * request is handed to a pool of worker threads that run libspdm_responder_dispatch_message on
+ * the context of the connection, and the event loop writes the response. The context is reset
+ * with libspdm_reset_context when its connection closes, and is reused by the next connection.
+ *
+ * Only one request of a connection is processed at a time. The connection is not read while its
+ * request waits for a worker or its response is written, so the TCP flow control holds further
+ * data at the peer.
+ *
+ * The host is only available on Linux.
+ *
+ * @param  config  The configuration. It is copied.
+ *
+ * @return The host, listening but not serving, or NULL if it could not be created.
+ **/
+libspdm_tcp_responder_host_t *libspdm_tcp_responder_host_new(
+    const libspdm_tcp_responder_host_config_t *config);
+
+/**
+ * Return the TCP port the host listens on.
+ *
+ * @param  host  The host.
+ **/
+uint16_t libspdm_tcp_responder_host_get_port(const libspdm_tcp_responder_host_t *host);
+
+/**
+ * Run the event loop on the calling thread until libspdm_tcp_responder_host_stop is called.
+ *
+ * @param  host  The host.
+ *
+ * @retval true   The host was stopped.
+ * @retval false  The event loop failed.
+ **/
+bool libspdm_tcp_responder_host_run(libspdm_tcp_responder_host_t *host);
+
+/**
+ * Ask the event loop to return. It may be called from any thread, including a signal handler.
+ * Open connections are kept until libspdm_tcp_responder_host_free.
+ *
+ * @param  host  The host.
+ **/
+void libspdm_tcp_responder_host_stop(libspdm_tcp_responder_host_t *host);
+
+/**
+ * Read the counters of the host. It may be called from any thread.
+ *
+ * @param  host   The host.
+ * @param  stats  On output, the counters.
+ **/
+void libspdm_tcp_responder_host_get_stats(libspdm_tcp_responder_host_t *host,
+                                          libspdm_tcp_responder_host_stats_t *stats);
+
+/**
+ * Stop the workers, close every connection and free the host and its SPDM contexts.
+ * The event loop must have returned.
+ *
+ * @param  host  The host.
+ **/
+void libspdm_tcp_responder_host_free(libspdm_tcp_responder_host_t *host);
+
+#endif
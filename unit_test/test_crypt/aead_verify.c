@@ -138,6 +138,8 @@ bool libspdm_validate_crypt_aead_cipher(void)
     size_t OutBufferSize;
     uint8_t OutTag[1024];
     size_t OutTagSize;
+    void *aead_ctx;
+    size_t index;
 
     libspdm_my_print("\nCrypto AEAD Testing: ");
 
@@ -188,6 +190,68 @@ bool libspdm_validate_crypt_aead_cipher(void)
         return false;
     }
 
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- AES-GCM Context Encryption: ");
+    aead_ctx = libspdm_aead_aes_gcm_new();
+    if (aead_ctx == NULL) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
+    status = libspdm_aead_aes_gcm_set_key(aead_ctx, m_libspdm_gcm_key, sizeof(m_libspdm_gcm_key));
+    if (!status) {
+        libspdm_my_print("[Fail]");
+        libspdm_aead_aes_gcm_free(aead_ctx);
+        return false;
+    }
+    /* Reuse the keyed context for more than one record. */
+    for (index = 0; index < 2; index++) {
+        OutBufferSize = sizeof(OutBuffer);
+        status = libspdm_aead_aes_gcm_encrypt_with_context(
+            aead_ctx, m_libspdm_gcm_iv, sizeof(m_libspdm_gcm_iv),
+            m_libspdm_gcm_aad, sizeof(m_libspdm_gcm_aad),
+            m_libspdm_gcm_pt, sizeof(m_libspdm_gcm_pt),
+            OutTag, sizeof(m_libspdm_gcm_tag), OutBuffer, &OutBufferSize);
+        if (!status || (OutBufferSize != sizeof(m_libspdm_gcm_ct)) ||
+            (memcmp(OutBuffer, m_libspdm_gcm_ct, sizeof(m_libspdm_gcm_ct)) != 0) ||
+            (memcmp(OutTag, m_libspdm_gcm_tag, sizeof(m_libspdm_gcm_tag)) != 0)) {
+            libspdm_my_print("[Fail]");
+            libspdm_aead_aes_gcm_free(aead_ctx);
+            return false;
+        }
+    }
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- AES-GCM Context Decryption: ");
+    for (index = 0; index < 2; index++) {
+        OutBufferSize = sizeof(OutBuffer);
+        status = libspdm_aead_aes_gcm_decrypt_with_context(
+            aead_ctx, m_libspdm_gcm_iv, sizeof(m_libspdm_gcm_iv),
+            m_libspdm_gcm_aad, sizeof(m_libspdm_gcm_aad),
+            m_libspdm_gcm_ct, sizeof(m_libspdm_gcm_ct),
+            m_libspdm_gcm_tag, sizeof(m_libspdm_gcm_tag), OutBuffer, &OutBufferSize);
+        if (!status || (OutBufferSize != sizeof(m_libspdm_gcm_pt)) ||
+            (memcmp(OutBuffer, m_libspdm_gcm_pt, sizeof(m_libspdm_gcm_pt)) != 0)) {
+            libspdm_my_print("[Fail]");
+            libspdm_aead_aes_gcm_free(aead_ctx);
+            return false;
+        }
+    }
+
+    /* A modified tag must be rejected by the keyed context. */
+    libspdm_copy_mem(OutTag, sizeof(OutTag), m_libspdm_gcm_tag, sizeof(m_libspdm_gcm_tag));
+    OutTag[0] ^= 0x01;
+    OutBufferSize = sizeof(OutBuffer);
+    status = libspdm_aead_aes_gcm_decrypt_with_context(
+        aead_ctx, m_libspdm_gcm_iv, sizeof(m_libspdm_gcm_iv),
+        m_libspdm_gcm_aad, sizeof(m_libspdm_gcm_aad),
+        m_libspdm_gcm_ct, sizeof(m_libspdm_gcm_ct),
+        OutTag, sizeof(m_libspdm_gcm_tag), OutBuffer, &OutBufferSize);
+    libspdm_aead_aes_gcm_free(aead_ctx);
+    if (status) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
     libspdm_my_print("[Pass]");
     #endif /* LIBSPDM_AEAD_GCM_SUPPORT */
 
@@ -244,6 +308,68 @@ bool libspdm_validate_crypt_aead_cipher(void)
         return false;
     }
 
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- ChaCha20Poly1305 Context Encryption: ");
+    aead_ctx = libspdm_aead_chacha20_poly1305_new();
+    if (aead_ctx == NULL) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
+    status = libspdm_aead_chacha20_poly1305_set_key(aead_ctx, m_libspdm_chacha20_poly1305_key, sizeof(m_libspdm_chacha20_poly1305_key));
+    if (!status) {
+        libspdm_my_print("[Fail]");
+        libspdm_aead_chacha20_poly1305_free(aead_ctx);
+        return false;
+    }
+    /* Reuse the keyed context for more than one record. */
+    for (index = 0; index < 2; index++) {
+        OutBufferSize = sizeof(OutBuffer);
+        status = libspdm_aead_chacha20_poly1305_encrypt_with_context(
+            aead_ctx, m_libspdm_chacha20_poly1305_iv, sizeof(m_libspdm_chacha20_poly1305_iv),
+            m_libspdm_chacha20_poly1305_aad, sizeof(m_libspdm_chacha20_poly1305_aad),
+            m_libspdm_chacha20_poly1305_pt, sizeof(m_libspdm_chacha20_poly1305_pt),
+            OutTag, sizeof(m_libspdm_chacha20_poly1305_tag), OutBuffer, &OutBufferSize);
+        if (!status || (OutBufferSize != sizeof(m_libspdm_chacha20_poly1305_ct)) ||
+            (memcmp(OutBuffer, m_libspdm_chacha20_poly1305_ct, sizeof(m_libspdm_chacha20_poly1305_ct)) != 0) ||
+            (memcmp(OutTag, m_libspdm_chacha20_poly1305_tag, sizeof(m_libspdm_chacha20_poly1305_tag)) != 0)) {
+            libspdm_my_print("[Fail]");
+            libspdm_aead_chacha20_poly1305_free(aead_ctx);
+            return false;
+        }
+    }
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- ChaCha20Poly1305 Context Decryption: ");
+    for (index = 0; index < 2; index++) {
+        OutBufferSize = sizeof(OutBuffer);
+        status = libspdm_aead_chacha20_poly1305_decrypt_with_context(
+            aead_ctx, m_libspdm_chacha20_poly1305_iv, sizeof(m_libspdm_chacha20_poly1305_iv),
+            m_libspdm_chacha20_poly1305_aad, sizeof(m_libspdm_chacha20_poly1305_aad),
+            m_libspdm_chacha20_poly1305_ct, sizeof(m_libspdm_chacha20_poly1305_ct),
+            m_libspdm_chacha20_poly1305_tag, sizeof(m_libspdm_chacha20_poly1305_tag), OutBuffer, &OutBufferSize);
+        if (!status || (OutBufferSize != sizeof(m_libspdm_chacha20_poly1305_pt)) ||
+            (memcmp(OutBuffer, m_libspdm_chacha20_poly1305_pt, sizeof(m_libspdm_chacha20_poly1305_pt)) != 0)) {
+            libspdm_my_print("[Fail]");
+            libspdm_aead_chacha20_poly1305_free(aead_ctx);
+            return false;
+        }
+    }
+
+    /* A modified tag must be rejected by the keyed context. */
+    libspdm_copy_mem(OutTag, sizeof(OutTag), m_libspdm_chacha20_poly1305_tag, sizeof(m_libspdm_chacha20_poly1305_tag));
+    OutTag[0] ^= 0x01;
+    OutBufferSize = sizeof(OutBuffer);
+    status = libspdm_aead_chacha20_poly1305_decrypt_with_context(
+        aead_ctx, m_libspdm_chacha20_poly1305_iv, sizeof(m_libspdm_chacha20_poly1305_iv),
+        m_libspdm_chacha20_poly1305_aad, sizeof(m_libspdm_chacha20_poly1305_aad),
+        m_libspdm_chacha20_poly1305_ct, sizeof(m_libspdm_chacha20_poly1305_ct),
+        OutTag, sizeof(m_libspdm_chacha20_poly1305_tag), OutBuffer, &OutBufferSize);
+    libspdm_aead_chacha20_poly1305_free(aead_ctx);
+    if (status) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
     libspdm_my_print("[Pass]");
     #endif /* LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT */
 
@@ -296,6 +422,68 @@ bool libspdm_validate_crypt_aead_cipher(void)
         return false;
     }
 
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- SM4-GCM Context Encryption: ");
+    aead_ctx = libspdm_aead_sm4_gcm_new();
+    if (aead_ctx == NULL) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
+    status = libspdm_aead_sm4_gcm_set_key(aead_ctx, m_libspdm_sm4_gcm_key, sizeof(m_libspdm_sm4_gcm_key));
+    if (!status) {
+        libspdm_my_print("[Fail]");
+        libspdm_aead_sm4_gcm_free(aead_ctx);
+        return false;
+    }
+    /* Reuse the keyed context for more than one record. */
+    for (index = 0; index < 2; index++) {
+        OutBufferSize = sizeof(OutBuffer);
+        status = libspdm_aead_sm4_gcm_encrypt_with_context(
+            aead_ctx, m_libspdm_sm4_gcm_iv, sizeof(m_libspdm_sm4_gcm_iv),
+            m_libspdm_sm4_gcm_aad, sizeof(m_libspdm_sm4_gcm_aad),
+            m_libspdm_sm4_gcm_pt, sizeof(m_libspdm_sm4_gcm_pt),
+            OutTag, sizeof(m_libspdm_sm4_gcm_tag), OutBuffer, &OutBufferSize);
+        if (!status || (OutBufferSize != sizeof(m_libspdm_sm4_gcm_ct)) ||
+            (memcmp(OutBuffer, m_libspdm_sm4_gcm_ct, sizeof(m_libspdm_sm4_gcm_ct)) != 0) ||
+            (memcmp(OutTag, m_libspdm_sm4_gcm_tag, sizeof(m_libspdm_sm4_gcm_tag)) != 0)) {
+            libspdm_my_print("[Fail]");
+            libspdm_aead_sm4_gcm_free(aead_ctx);
+            return false;
+        }
+    }
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- SM4-GCM Context Decryption: ");
+    for (index = 0; index < 2; index++) {
+        OutBufferSize = sizeof(OutBuffer);
+        status = libspdm_aead_sm4_gcm_decrypt_with_context(
+            aead_ctx, m_libspdm_sm4_gcm_iv, sizeof(m_libspdm_sm4_gcm_iv),
+            m_libspdm_sm4_gcm_aad, sizeof(m_libspdm_sm4_gcm_aad),
+            m_libspdm_sm4_gcm_ct, sizeof(m_libspdm_sm4_gcm_ct),
+            m_libspdm_sm4_gcm_tag, sizeof(m_libspdm_sm4_gcm_tag), OutBuffer, &OutBufferSize);
+        if (!status || (OutBufferSize != sizeof(m_libspdm_sm4_gcm_pt)) ||
+            (memcmp(OutBuffer, m_libspdm_sm4_gcm_pt, sizeof(m_libspdm_sm4_gcm_pt)) != 0)) {
+            libspdm_my_print("[Fail]");
+            libspdm_aead_sm4_gcm_free(aead_ctx);
+            return false;
+        }
+    }
+
+    /* A modified tag must be rejected by the keyed context. */
+    libspdm_copy_mem(OutTag, sizeof(OutTag), m_libspdm_sm4_gcm_tag, sizeof(m_libspdm_sm4_gcm_tag));
+    OutTag[0] ^= 0x01;
+    OutBufferSize = sizeof(OutBuffer);
+    status = libspdm_aead_sm4_gcm_decrypt_with_context(
+        aead_ctx, m_libspdm_sm4_gcm_iv, sizeof(m_libspdm_sm4_gcm_iv),
+        m_libspdm_sm4_gcm_aad, sizeof(m_libspdm_sm4_gcm_aad),
+        m_libspdm_sm4_gcm_ct, sizeof(m_libspdm_sm4_gcm_ct),
+        OutTag, sizeof(m_libspdm_sm4_gcm_tag), OutBuffer, &OutBufferSize);
+    libspdm_aead_sm4_gcm_free(aead_ctx);
+    if (status) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
     libspdm_my_print("[Pass]");
     #endif /* LIBSPDM_AEAD_SM4_SUPPORT */
 
@@ -0,0 +1,141 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt_bench.h"
+
+/* Size of the secured message header that is authenticated as AAD. */
+#define LIBSPDM_BENCH_AEAD_AAD_SIZE 16
+
+typedef struct {
+    uint16_t aead_cipher_suite;
+    const char *name;
+} libspdm_bench_aead_algo_t;
+
+static const libspdm_bench_aead_algo_t m_libspdm_bench_aead_algo[] = {
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM, "aes_128_gcm" },
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM, "aes_256_gcm" },
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305, "chacha20_poly1305" },
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM, "sm4_128_gcm" },
+};
+
+typedef struct {
+    uint16_t aead_cipher_suite;
+    void *aead_context;
+    uint8_t key[LIBSPDM_MAX_AEAD_KEY_SIZE];
+    size_t key_size;
+    uint8_t iv[LIBSPDM_MAX_AEAD_IV_SIZE];
+    size_t iv_size;
+    uint8_t aad[LIBSPDM_BENCH_AEAD_AAD_SIZE];
+    uint8_t tag[LIBSPDM_MAX_AEAD_TAG_SIZE];
+    size_t tag_size;
+    size_t data_size;
+} libspdm_bench_aead_context_t;
+
+static uint8_t m_libspdm_bench_aead_plain_text[LIBSPDM_BENCH_MAX_DATA_SIZE];
+static uint8_t m_libspdm_bench_aead_cipher_text[LIBSPDM_BENCH_MAX_DATA_SIZE];
+static uint8_t m_libspdm_bench_aead_output[LIBSPDM_BENCH_MAX_DATA_SIZE];
+
+/* Encryption with a context that was keyed once, as done for each record of a session. */
+static bool libspdm_bench_aead_encrypt(void *context)
+{
+    libspdm_bench_aead_context_t *aead;
+    size_t data_out_size;
+
+    aead = context;
+    data_out_size = sizeof(m_libspdm_bench_aead_cipher_text);
+    return libspdm_aead_encryption_with_context(
+        SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        aead->aead_cipher_suite, aead->aead_context, aead->iv, aead->iv_size,
+        aead->aad, sizeof(aead->aad), m_libspdm_bench_aead_plain_text, aead->data_size,
+        aead->tag, aead->tag_size, m_libspdm_bench_aead_cipher_text, &data_out_size);
+}
+
+static bool libspdm_bench_aead_decrypt(void *context)
+{
+    libspdm_bench_aead_context_t *aead;
+    size_t data_out_size;
+
+    aead = context;
+    data_out_size = sizeof(m_libspdm_bench_aead_output);
+    return libspdm_aead_decryption_with_context(
+        SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        aead->aead_cipher_suite, aead->aead_context, aead->iv, aead->iv_size,
+        aead->aad, sizeof(aead->aad), m_libspdm_bench_aead_cipher_text, aead->data_size,
+        aead->tag, aead->tag_size, m_libspdm_bench_aead_output, &data_out_size);
+}
+
+/* One-shot encryption that expands the key schedule for every record. */
+static bool libspdm_bench_aead_encrypt_oneshot(void *context)
+{
+    libspdm_bench_aead_context_t *aead;
+    size_t data_out_size;
+
+    aead = context;
+    data_out_size = sizeof(m_libspdm_bench_aead_cipher_text);
+    return libspdm_aead_encryption(
+        SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        aead->aead_cipher_suite, aead->key, aead->key_size, aead->iv, aead->iv_size,
+        aead->aad, sizeof(aead->aad), m_libspdm_bench_aead_plain_text, aead->data_size,
+        aead->tag, aead->tag_size, m_libspdm_bench_aead_cipher_text, &data_out_size);
+}
+
+void libspdm_bench_aead(void)
+{
+    libspdm_bench_aead_context_t aead;
+    size_t algo_index;
+    size_t size_index;
+    const char *name;
+
+    libspdm_set_mem(m_libspdm_bench_aead_plain_text, sizeof(m_libspdm_bench_aead_plain_text),
+                    0x5a);
+
+    for (algo_index = 0; algo_index < LIBSPDM_ARRAY_SIZE(m_libspdm_bench_aead_algo);
+         algo_index++) {
+        name = m_libspdm_bench_aead_algo[algo_index].name;
+        if (!libspdm_bench_is_selected("aead", name)) {
+            continue;
+        }
+
+        libspdm_zero_mem(&aead, sizeof(aead));
+        aead.aead_cipher_suite = m_libspdm_bench_aead_algo[algo_index].aead_cipher_suite;
+        aead.key_size = libspdm_get_aead_key_size(aead.aead_cipher_suite);
+        aead.iv_size = libspdm_get_aead_iv_size(aead.aead_cipher_suite);
+        aead.tag_size = libspdm_get_aead_tag_size(aead.aead_cipher_suite);
+        if (aead.key_size == 0) {
+            libspdm_bench_skip("aead", name, "not supported");
+            continue;
+        }
+        libspdm_set_mem(aead.key, aead.key_size, 0xa5);
+        libspdm_set_mem(aead.iv, aead.iv_size, 0x3c);
+        libspdm_set_mem(aead.aad, sizeof(aead.aad), 0xc3);
+
+        aead.aead_context = libspdm_aead_new(aead.aead_cipher_suite);
+        if ((aead.aead_context == NULL) ||
+            !libspdm_aead_set_key(aead.aead_cipher_suite, aead.aead_context,
+                                  aead.key, aead.key_size)) {
+            libspdm_bench_skip("aead", name, "cannot create a keyed context");
+            if (aead.aead_context != NULL) {
+                libspdm_aead_free(aead.aead_cipher_suite, aead.aead_context);
+            }
+            continue;
+        }
+
+        for (size_index = 0; size_index < LIBSPDM_BENCH_DATA_SIZE_COUNT; size_index++) {
+            aead.data_size = m_libspdm_bench_data_size[size_index];
+            /* Decryption needs the cipher text and tag produced by a successful encryption. */
+            if (!libspdm_bench_run("aead", name, "encrypt", aead.data_size,
+                                   libspdm_bench_aead_encrypt, &aead)) {
+                continue;
+            }
+            libspdm_bench_run("aead", name, "decrypt", aead.data_size,
+                              libspdm_bench_aead_decrypt, &aead);
+            libspdm_bench_run("aead", name, "encrypt_oneshot", aead.data_size,
+                              libspdm_bench_aead_encrypt_oneshot, &aead);
+        }
+
+        libspdm_aead_free(aead.aead_cipher_suite, aead.aead_context);
+    }
+}
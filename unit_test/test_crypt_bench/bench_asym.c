@@ -0,0 +1,239 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt_bench.h"
+
+/* Size of the message that is hashed and signed, in the order of a CHALLENGE_AUTH transcript. */
+#define LIBSPDM_BENCH_ASYM_MESSAGE_SIZE 1024
+
+#if LIBSPDM_MAX_PQC_ASYM_SIG_SIZE > LIBSPDM_MAX_ASYM_SIG_SIZE
+#define LIBSPDM_BENCH_MAX_SIG_SIZE LIBSPDM_MAX_PQC_ASYM_SIG_SIZE
+#else
+#define LIBSPDM_BENCH_MAX_SIG_SIZE LIBSPDM_MAX_ASYM_SIG_SIZE
+#endif
+
+typedef struct {
+    bool is_pqc;
+    uint32_t asym_algo;
+    const char *name;
+    /* Directory of the sample keys, relative to the working directory. */
+    const char *key_dir;
+} libspdm_bench_asym_algo_t;
+
+static const libspdm_bench_asym_algo_t m_libspdm_bench_asym_algo[] = {
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048, "rsassa_2048", "rsa2048" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048, "rsapss_2048", "rsa2048" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072, "rsassa_3072", "rsa3072" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072, "rsapss_3072", "rsa3072" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_4096, "rsassa_4096", "rsa4096" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_4096, "rsapss_4096", "rsa4096" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256, "ecdsa_p256", "ecp256" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384, "ecdsa_p384", "ecp384" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521, "ecdsa_p521", "ecp521" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256, "sm2_p256", "sm2" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED25519, "eddsa_ed25519", "ed25519" },
+    { false, SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED448, "eddsa_ed448", "ed448" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_ML_DSA_44, "ml_dsa_44", "mldsa44" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_ML_DSA_65, "ml_dsa_65", "mldsa65" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_ML_DSA_87, "ml_dsa_87", "mldsa87" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHA2_128S, "slh_dsa_sha2_128s",
+      "slh-dsa-sha2-128s" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHAKE_128S, "slh_dsa_shake_128s",
+      "slh-dsa-shake-128s" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHA2_128F, "slh_dsa_sha2_128f",
+      "slh-dsa-sha2-128f" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHAKE_128F, "slh_dsa_shake_128f",
+      "slh-dsa-shake-128f" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHA2_192S, "slh_dsa_sha2_192s",
+      "slh-dsa-sha2-192s" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHAKE_192S, "slh_dsa_shake_192s",
+      "slh-dsa-shake-192s" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHA2_192F, "slh_dsa_sha2_192f",
+      "slh-dsa-sha2-192f" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHAKE_192F, "slh_dsa_shake_192f",
+      "slh-dsa-shake-192f" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHA2_256S, "slh_dsa_sha2_256s",
+      "slh-dsa-sha2-256s" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHAKE_256S, "slh_dsa_shake_256s",
+      "slh-dsa-shake-256s" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHA2_256F, "slh_dsa_sha2_256f",
+      "slh-dsa-sha2-256f" },
+    { true, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHAKE_256F, "slh_dsa_shake_256f",
+      "slh-dsa-shake-256f" },
+};
+
+typedef struct {
+    bool is_pqc;
+    uint32_t asym_algo;
+    uint32_t base_hash_algo;
+    void *private_key;
+    void *public_key;
+    uint8_t message[LIBSPDM_BENCH_ASYM_MESSAGE_SIZE];
+    uint8_t signature[LIBSPDM_BENCH_MAX_SIG_SIZE];
+    size_t sig_size;
+} libspdm_bench_asym_context_t;
+
+/* Static because PQC signatures are too large for the stack of some test environments. */
+static libspdm_bench_asym_context_t m_libspdm_bench_asym_context;
+
+static bool libspdm_bench_asym_sign(void *context)
+{
+    libspdm_bench_asym_context_t *asym;
+
+    asym = context;
+    asym->sig_size = sizeof(asym->signature);
+    if (asym->is_pqc) {
+        return libspdm_pqc_asym_sign(LIBSPDM_BENCH_SPDM_VERSION, SPDM_CHALLENGE_AUTH,
+                                     asym->asym_algo, asym->base_hash_algo, asym->private_key,
+                                     asym->message, sizeof(asym->message),
+                                     asym->signature, &asym->sig_size);
+    } else {
+        return libspdm_asym_sign(LIBSPDM_BENCH_SPDM_VERSION, SPDM_CHALLENGE_AUTH,
+                                 asym->asym_algo, asym->base_hash_algo, asym->private_key,
+                                 asym->message, sizeof(asym->message),
+                                 asym->signature, &asym->sig_size);
+    }
+}
+
+static bool libspdm_bench_asym_verify(void *context)
+{
+    libspdm_bench_asym_context_t *asym;
+
+    asym = context;
+    if (asym->is_pqc) {
+        return libspdm_pqc_asym_verify(LIBSPDM_BENCH_SPDM_VERSION, SPDM_CHALLENGE_AUTH,
+                                       asym->asym_algo, asym->base_hash_algo, asym->public_key,
+                                       asym->message, sizeof(asym->message),
+                                       asym->signature, asym->sig_size);
+    } else {
+        return libspdm_asym_verify(LIBSPDM_BENCH_SPDM_VERSION, SPDM_CHALLENGE_AUTH,
+                                   asym->asym_algo, asym->base_hash_algo, asym->public_key,
+                                   asym->message, sizeof(asym->message),
+                                   asym->signature, asym->sig_size);
+    }
+}
+
+static void libspdm_bench_asym_free(libspdm_bench_asym_context_t *asym)
+{
+    if (asym->is_pqc) {
+        if (asym->private_key != NULL) {
+            libspdm_pqc_asym_free(asym->asym_algo, asym->private_key);
+        }
+        if (asym->public_key != NULL) {
+            libspdm_pqc_asym_free(asym->asym_algo, asym->public_key);
+        }
+    } else {
+        if (asym->private_key != NULL) {
+            libspdm_asym_free(asym->asym_algo, asym->private_key);
+        }
+        if (asym->public_key != NULL) {
+            libspdm_asym_free(asym->asym_algo, asym->public_key);
+        }
+    }
+    asym->private_key = NULL;
+    asym->public_key = NULL;
+}
+
+static bool libspdm_bench_asym_load_keys(const libspdm_bench_asym_algo_t *algo,
+                                         libspdm_bench_asym_context_t *asym)
+{
+    char file_name[128];
+    void *data;
+    size_t size;
+    bool result;
+
+    snprintf(file_name, sizeof(file_name), "%s/end_responder.key", algo->key_dir);
+    if (!libspdm_bench_read_file(file_name, &data, &size)) {
+        return false;
+    }
+    if (algo->is_pqc) {
+        result = libspdm_pqc_asym_get_private_key_from_pem(algo->asym_algo, data, size, NULL,
+                                                           &asym->private_key);
+    } else {
+        result = libspdm_asym_get_private_key_from_pem(algo->asym_algo, data, size, NULL,
+                                                       &asym->private_key);
+    }
+    free(data);
+    if (!result) {
+        return false;
+    }
+
+    snprintf(file_name, sizeof(file_name), "%s/end_responder.key.pub.der", algo->key_dir);
+    if (!libspdm_bench_read_file(file_name, &data, &size)) {
+        return false;
+    }
+    if (algo->is_pqc) {
+        result = libspdm_pqc_asym_get_public_key_from_der(algo->asym_algo, data, size,
+                                                          &asym->public_key);
+    } else {
+        result = libspdm_asym_get_public_key_from_der(algo->asym_algo, data, size,
+                                                      &asym->public_key);
+    }
+    free(data);
+
+    return result;
+}
+
+void libspdm_bench_asym(void)
+{
+    libspdm_bench_asym_context_t *asym;
+    const libspdm_bench_asym_algo_t *algo;
+    const char *category;
+    size_t algo_index;
+    uint32_t sig_size;
+
+    asym = &m_libspdm_bench_asym_context;
+
+    for (algo_index = 0; algo_index < LIBSPDM_ARRAY_SIZE(m_libspdm_bench_asym_algo);
+         algo_index++) {
+        algo = &m_libspdm_bench_asym_algo[algo_index];
+        category = algo->is_pqc ? "pqc_asym" : "asym";
+        if (!libspdm_bench_is_selected(category, algo->name)) {
+            continue;
+        }
+
+        if (algo->is_pqc) {
+            sig_size = libspdm_get_pqc_asym_signature_size(algo->asym_algo);
+        } else {
+            sig_size = libspdm_get_asym_signature_size(algo->asym_algo);
+        }
+        if (sig_size == 0) {
+            libspdm_bench_skip(category, algo->name, "not supported");
+            continue;
+        }
+
+        libspdm_zero_mem(asym, sizeof(*asym));
+        asym->is_pqc = algo->is_pqc;
+        asym->asym_algo = algo->asym_algo;
+        /* SM2 is paired with SM3 in the SM cipher suite. The other algorithms use SHA-384. */
+        if (algo->asym_algo == SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256 &&
+            !algo->is_pqc) {
+            asym->base_hash_algo = SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256;
+        } else {
+            asym->base_hash_algo = SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384;
+        }
+        if (libspdm_get_hash_size(asym->base_hash_algo) == 0) {
+            libspdm_bench_skip(category, algo->name, "hash algorithm not supported");
+            continue;
+        }
+        libspdm_set_mem(asym->message, sizeof(asym->message), 0x5a);
+
+        if (!libspdm_bench_asym_load_keys(algo, asym)) {
+            libspdm_bench_skip(category, algo->name, "cannot load the sample key");
+            libspdm_bench_asym_free(asym);
+            continue;
+        }
+
+        /* Verification needs the signature produced by a successful signing. */
+        if (libspdm_bench_run(category, algo->name, "sign", 0,
+                              libspdm_bench_asym_sign, asym)) {
+            libspdm_bench_run(category, algo->name, "verify", 0,
+                              libspdm_bench_asym_verify, asym);
+        }
+
+        libspdm_bench_asym_free(asym);
+    }
+}
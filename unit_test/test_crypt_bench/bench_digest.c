@@ -0,0 +1,127 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt_bench.h"
+
+typedef struct {
+    uint32_t base_hash_algo;
+    const char *name;
+} libspdm_bench_hash_algo_t;
+
+static const libspdm_bench_hash_algo_t m_libspdm_bench_hash_algo[] = {
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "sha256" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "sha384" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "sha512" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256, "sha3_256" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384, "sha3_384" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512, "sha3_512" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256, "sm3_256" },
+};
+
+typedef struct {
+    uint32_t base_hash_algo;
+    const uint8_t *data;
+    size_t data_size;
+    const uint8_t *key;
+    size_t key_size;
+    uint8_t output[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_bench_digest_context_t;
+
+static uint8_t m_libspdm_bench_digest_data[LIBSPDM_BENCH_MAX_DATA_SIZE];
+
+static bool libspdm_bench_hash_all(void *context)
+{
+    libspdm_bench_digest_context_t *digest;
+
+    digest = context;
+    return libspdm_hash_all(digest->base_hash_algo, digest->data, digest->data_size,
+                            digest->output);
+}
+
+static bool libspdm_bench_hmac_all(void *context)
+{
+    libspdm_bench_digest_context_t *digest;
+
+    digest = context;
+    return libspdm_hmac_all(digest->base_hash_algo, digest->data, digest->data_size,
+                            digest->key, digest->key_size, digest->output);
+}
+
+/* HKDF-Extract of a shared secret, as done once per session for the handshake secret. */
+static bool libspdm_bench_hkdf_extract(void *context)
+{
+    libspdm_bench_digest_context_t *digest;
+
+    digest = context;
+    return libspdm_hkdf_extract(digest->base_hash_algo, digest->data, digest->data_size,
+                                digest->key, digest->key_size,
+                                digest->output, digest->key_size);
+}
+
+/* HKDF-Expand of one hash-sized secret, as done for every derived key, IV and finished key. */
+static bool libspdm_bench_hkdf_expand(void *context)
+{
+    libspdm_bench_digest_context_t *digest;
+
+    digest = context;
+    return libspdm_hkdf_expand(digest->base_hash_algo, digest->key, digest->key_size,
+                               digest->data, digest->data_size,
+                               digest->output, digest->key_size);
+}
+
+void libspdm_bench_digest(void)
+{
+    libspdm_bench_digest_context_t digest;
+    uint8_t key[LIBSPDM_MAX_HASH_SIZE];
+    size_t algo_index;
+    size_t size_index;
+    uint32_t hash_size;
+    const char *name;
+
+    libspdm_set_mem(m_libspdm_bench_digest_data, sizeof(m_libspdm_bench_digest_data), 0x5a);
+    libspdm_set_mem(key, sizeof(key), 0xa5);
+
+    for (algo_index = 0; algo_index < LIBSPDM_ARRAY_SIZE(m_libspdm_bench_hash_algo);
+         algo_index++) {
+        name = m_libspdm_bench_hash_algo[algo_index].name;
+        hash_size = libspdm_get_hash_size(m_libspdm_bench_hash_algo[algo_index].base_hash_algo);
+        if (hash_size == 0) {
+            libspdm_bench_skip("hash", name, "not supported");
+            continue;
+        }
+
+        digest.base_hash_algo = m_libspdm_bench_hash_algo[algo_index].base_hash_algo;
+        digest.data = m_libspdm_bench_digest_data;
+        digest.key = key;
+        digest.key_size = hash_size;
+
+        if (libspdm_bench_is_selected("hash", name)) {
+            for (size_index = 0; size_index < LIBSPDM_BENCH_DATA_SIZE_COUNT; size_index++) {
+                digest.data_size = m_libspdm_bench_data_size[size_index];
+                libspdm_bench_run("hash", name, "digest", digest.data_size,
+                                  libspdm_bench_hash_all, &digest);
+            }
+        }
+
+        if (libspdm_bench_is_selected("hmac", name)) {
+            for (size_index = 0; size_index < LIBSPDM_BENCH_DATA_SIZE_COUNT; size_index++) {
+                digest.data_size = m_libspdm_bench_data_size[size_index];
+                libspdm_bench_run("hmac", name, "mac", digest.data_size,
+                                  libspdm_bench_hmac_all, &digest);
+            }
+        }
+
+        if (libspdm_bench_is_selected("hkdf", name)) {
+            /* The input keying material is a DHE shared secret of at most 512 bytes. */
+            digest.data_size = 256;
+            libspdm_bench_run("hkdf", name, "extract", 0, libspdm_bench_hkdf_extract, &digest);
+
+            /* The info is a bin_str of the key schedule, which is around 100 bytes. */
+            digest.data_size = 100;
+            libspdm_bench_run("hkdf", name, "expand", 0, libspdm_bench_hkdf_expand, &digest);
+        }
+    }
+}
@@ -0,0 +1,250 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt_bench.h"
+
+typedef struct {
+    uint16_t dhe_named_group;
+    const char *name;
+} libspdm_bench_dhe_algo_t;
+
+static const libspdm_bench_dhe_algo_t m_libspdm_bench_dhe_algo[] = {
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048, "ffdhe2048" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072, "ffdhe3072" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_4096, "ffdhe4096" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1, "secp256r1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1, "secp384r1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1, "secp521r1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SM2_P256, "sm2_p256" },
+};
+
+typedef struct {
+    uint32_t kem_alg;
+    const char *name;
+} libspdm_bench_kem_algo_t;
+
+static const libspdm_bench_kem_algo_t m_libspdm_bench_kem_algo[] = {
+    { SPDM_ALGORITHMS_KEM_ALG_ML_KEM_512, "ml_kem_512" },
+    { SPDM_ALGORITHMS_KEM_ALG_ML_KEM_768, "ml_kem_768" },
+    { SPDM_ALGORITHMS_KEM_ALG_ML_KEM_1024, "ml_kem_1024" },
+};
+
+typedef struct {
+    uint16_t dhe_named_group;
+    /* Context of the peer whose public key is used for the shared secret. */
+    void *peer_context;
+    uint8_t peer_public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+    size_t peer_public_key_size;
+    uint8_t shared_secret[LIBSPDM_MAX_DHE_SS_SIZE];
+} libspdm_bench_dhe_context_t;
+
+typedef struct {
+    uint32_t kem_alg;
+    /* Initiator context that holds the decapsulation key. */
+    void *initiator_context;
+    uint8_t encap_key[LIBSPDM_MAX_KEM_ENCAP_KEY_SIZE];
+    size_t encap_key_size;
+    uint8_t cipher_text[LIBSPDM_MAX_KEM_CT_SIZE];
+    size_t cipher_text_size;
+    uint8_t shared_secret[LIBSPDM_MAX_KEM_SS_SIZE];
+} libspdm_bench_kem_context_t;
+
+/* Key pair generation, as done by the requester for KEY_EXCHANGE. */
+static bool libspdm_bench_dhe_generate(void *context)
+{
+    libspdm_bench_dhe_context_t *dhe;
+    void *dhe_context;
+    uint8_t public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+    size_t public_key_size;
+    bool result;
+
+    dhe = context;
+    dhe_context = libspdm_dhe_new(LIBSPDM_BENCH_SPDM_VERSION, dhe->dhe_named_group, true);
+    if (dhe_context == NULL) {
+        return false;
+    }
+    public_key_size = libspdm_get_dhe_pub_key_size(dhe->dhe_named_group);
+    result = libspdm_dhe_generate_key(dhe->dhe_named_group, dhe_context,
+                                      public_key, &public_key_size);
+    libspdm_dhe_free(dhe->dhe_named_group, dhe_context);
+
+    return result;
+}
+
+/* Key pair generation and shared secret computation, as done by the responder for KEY_EXCHANGE. */
+static bool libspdm_bench_dhe_exchange(void *context)
+{
+    libspdm_bench_dhe_context_t *dhe;
+    void *dhe_context;
+    uint8_t public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+    size_t public_key_size;
+    size_t shared_secret_size;
+    bool result;
+
+    dhe = context;
+    dhe_context = libspdm_dhe_new(LIBSPDM_BENCH_SPDM_VERSION, dhe->dhe_named_group, false);
+    if (dhe_context == NULL) {
+        return false;
+    }
+    public_key_size = libspdm_get_dhe_pub_key_size(dhe->dhe_named_group);
+    shared_secret_size = sizeof(dhe->shared_secret);
+    result = libspdm_dhe_generate_key(dhe->dhe_named_group, dhe_context,
+                                      public_key, &public_key_size) &&
+             libspdm_dhe_compute_key(dhe->dhe_named_group, dhe_context,
+                                     dhe->peer_public_key, dhe->peer_public_key_size,
+                                     dhe->shared_secret, &shared_secret_size);
+    libspdm_dhe_free(dhe->dhe_named_group, dhe_context);
+
+    return result;
+}
+
+/* Key pair generation, as done by the requester for KEY_EXCHANGE. */
+static bool libspdm_bench_kem_generate(void *context)
+{
+    libspdm_bench_kem_context_t *kem;
+    void *kem_context;
+    uint8_t encap_key[LIBSPDM_MAX_KEM_ENCAP_KEY_SIZE];
+    size_t encap_key_size;
+    bool result;
+
+    kem = context;
+    kem_context = libspdm_kem_new(LIBSPDM_BENCH_SPDM_VERSION, kem->kem_alg, true);
+    if (kem_context == NULL) {
+        return false;
+    }
+    encap_key_size = sizeof(encap_key);
+    result = libspdm_kem_generate_key(kem->kem_alg, kem_context, encap_key, &encap_key_size);
+    libspdm_kem_free(kem->kem_alg, kem_context);
+
+    return result;
+}
+
+/* Encapsulation to the requester's key, as done by the responder for KEY_EXCHANGE. */
+static bool libspdm_bench_kem_encapsulate(void *context)
+{
+    libspdm_bench_kem_context_t *kem;
+    void *kem_context;
+    size_t shared_secret_size;
+    bool result;
+
+    kem = context;
+    kem_context = libspdm_kem_new(LIBSPDM_BENCH_SPDM_VERSION, kem->kem_alg, false);
+    if (kem_context == NULL) {
+        return false;
+    }
+    kem->cipher_text_size = sizeof(kem->cipher_text);
+    shared_secret_size = sizeof(kem->shared_secret);
+    result = libspdm_kem_encapsulate(kem->kem_alg, kem_context,
+                                     kem->encap_key, kem->encap_key_size,
+                                     kem->cipher_text, &kem->cipher_text_size,
+                                     kem->shared_secret, &shared_secret_size);
+    libspdm_kem_free(kem->kem_alg, kem_context);
+
+    return result;
+}
+
+/* Decapsulation of the responder's cipher text, as done by the requester for KEY_EXCHANGE_RSP. */
+static bool libspdm_bench_kem_decapsulate(void *context)
+{
+    libspdm_bench_kem_context_t *kem;
+    size_t shared_secret_size;
+
+    kem = context;
+    shared_secret_size = sizeof(kem->shared_secret);
+    return libspdm_kem_decapsulate(kem->kem_alg, kem->initiator_context,
+                                   kem->cipher_text, kem->cipher_text_size,
+                                   kem->shared_secret, &shared_secret_size);
+}
+
+static void libspdm_bench_dhe(void)
+{
+    libspdm_bench_dhe_context_t dhe;
+    size_t algo_index;
+    const char *name;
+
+    for (algo_index = 0; algo_index < LIBSPDM_ARRAY_SIZE(m_libspdm_bench_dhe_algo);
+         algo_index++) {
+        name = m_libspdm_bench_dhe_algo[algo_index].name;
+        if (!libspdm_bench_is_selected("dhe", name)) {
+            continue;
+        }
+
+        libspdm_zero_mem(&dhe, sizeof(dhe));
+        dhe.dhe_named_group = m_libspdm_bench_dhe_algo[algo_index].dhe_named_group;
+        dhe.peer_public_key_size = libspdm_get_dhe_pub_key_size(dhe.dhe_named_group);
+        if (dhe.peer_public_key_size == 0) {
+            libspdm_bench_skip("dhe", name, "not supported");
+            continue;
+        }
+
+        dhe.peer_context = libspdm_dhe_new(LIBSPDM_BENCH_SPDM_VERSION, dhe.dhe_named_group,
+                                           true);
+        if ((dhe.peer_context == NULL) ||
+            !libspdm_dhe_generate_key(dhe.dhe_named_group, dhe.peer_context,
+                                      dhe.peer_public_key, &dhe.peer_public_key_size)) {
+            libspdm_bench_skip("dhe", name, "cannot generate the peer key");
+            if (dhe.peer_context != NULL) {
+                libspdm_dhe_free(dhe.dhe_named_group, dhe.peer_context);
+            }
+            continue;
+        }
+
+        libspdm_bench_run("dhe", name, "generate", 0, libspdm_bench_dhe_generate, &dhe);
+        libspdm_bench_run("dhe", name, "exchange", 0, libspdm_bench_dhe_exchange, &dhe);
+
+        libspdm_dhe_free(dhe.dhe_named_group, dhe.peer_context);
+    }
+}
+
+static void libspdm_bench_kem(void)
+{
+    static libspdm_bench_kem_context_t kem;
+    size_t algo_index;
+    const char *name;
+
+    for (algo_index = 0; algo_index < LIBSPDM_ARRAY_SIZE(m_libspdm_bench_kem_algo);
+         algo_index++) {
+        name = m_libspdm_bench_kem_algo[algo_index].name;
+        if (!libspdm_bench_is_selected("kem", name)) {
+            continue;
+        }
+
+        libspdm_zero_mem(&kem, sizeof(kem));
+        kem.kem_alg = m_libspdm_bench_kem_algo[algo_index].kem_alg;
+        kem.encap_key_size = libspdm_get_kem_encap_key_size(kem.kem_alg);
+        if (kem.encap_key_size == 0) {
+            libspdm_bench_skip("kem", name, "not supported");
+            continue;
+        }
+
+        kem.initiator_context = libspdm_kem_new(LIBSPDM_BENCH_SPDM_VERSION, kem.kem_alg, true);
+        if ((kem.initiator_context == NULL) ||
+            !libspdm_kem_generate_key(kem.kem_alg, kem.initiator_context,
+                                      kem.encap_key, &kem.encap_key_size)) {
+            libspdm_bench_skip("kem", name, "cannot generate the initiator key");
+            if (kem.initiator_context != NULL) {
+                libspdm_kem_free(kem.kem_alg, kem.initiator_context);
+            }
+            continue;
+        }
+
+        libspdm_bench_run("kem", name, "generate", 0, libspdm_bench_kem_generate, &kem);
+        /* Decapsulation needs the cipher text produced by a successful encapsulation. */
+        if (libspdm_bench_run("kem", name, "encapsulate", 0,
+                              libspdm_bench_kem_encapsulate, &kem)) {
+            libspdm_bench_run("kem", name, "decapsulate", 0,
+                              libspdm_bench_kem_decapsulate, &kem);
+        }
+
+        libspdm_kem_free(kem.kem_alg, kem.initiator_context);
+    }
+}
+
+void libspdm_bench_key_exchange(void)
+{
+    libspdm_bench_dhe();
+    libspdm_bench_kem();
+}
@@ -0,0 +1,294 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/* clock_gettime() is a POSIX interface that strict C99 does not expose by default. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "test_crypt_bench.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define LIBSPDM_BENCH_HAS_CYCLE_COUNTER 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define LIBSPDM_BENCH_HAS_CYCLE_COUNTER 1
+#else
+#define LIBSPDM_BENCH_HAS_CYCLE_COUNTER 0
+#endif
+
+#ifndef LIBSPDM_CRYPT_BENCH_BACKEND
+#define LIBSPDM_CRYPT_BENCH_BACKEND "unknown"
+#endif
+
+typedef enum {
+    LIBSPDM_BENCH_FORMAT_JSON,
+    LIBSPDM_BENCH_FORMAT_CSV,
+} libspdm_bench_format_t;
+
+const size_t m_libspdm_bench_data_size[LIBSPDM_BENCH_DATA_SIZE_COUNT] = {
+    64, 256, 1024, 4096, 16384, LIBSPDM_BENCH_MAX_DATA_SIZE
+};
+
+static libspdm_bench_format_t m_libspdm_bench_format = LIBSPDM_BENCH_FORMAT_JSON;
+static uint32_t m_libspdm_bench_min_time_ms = 200;
+static const char *m_libspdm_bench_filter = NULL;
+static size_t m_libspdm_bench_result_count = 0;
+static bool m_libspdm_bench_failed = false;
+
+static double libspdm_bench_get_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
+
+/* The time stamp counter runs at a constant reference rate, which may differ from the
+ * current core clock when frequency scaling is active. */
+static uint64_t libspdm_bench_get_cycles(void)
+{
+#if LIBSPDM_BENCH_HAS_CYCLE_COUNTER
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+bool libspdm_bench_is_selected(const char *category, const char *algorithm)
+{
+    char name[128];
+
+    if (m_libspdm_bench_filter == NULL) {
+        return true;
+    }
+    snprintf(name, sizeof(name), "%s/%s", category, algorithm);
+    return strstr(name, m_libspdm_bench_filter) != NULL;
+}
+
+static void libspdm_bench_print_number(double value, bool valid)
+{
+    if (valid) {
+        printf("%.3f", value);
+    } else if (m_libspdm_bench_format == LIBSPDM_BENCH_FORMAT_JSON) {
+        printf("null");
+    }
+}
+
+static void libspdm_bench_print_result(const char *category, const char *algorithm,
+                                       const char *operation, size_t data_size,
+                                       uint64_t iterations, double seconds, uint64_t cycles)
+{
+    double ops_per_sec;
+    double cycles_per_op;
+    double cycles_per_byte;
+
+    ops_per_sec = (double)iterations / seconds;
+    cycles_per_op = (double)cycles / (double)iterations;
+    cycles_per_byte = (data_size != 0) ? cycles_per_op / (double)data_size : 0;
+
+    if (m_libspdm_bench_format == LIBSPDM_BENCH_FORMAT_JSON) {
+        printf("%s\n    {\"category\": \"%s\", \"algorithm\": \"%s\", \"operation\": \"%s\", "
+               "\"size\": %zu, \"iterations\": %llu, \"seconds\": %.6f, \"ops_per_sec\": %.3f, "
+               "\"cycles_per_op\": ",
+               (m_libspdm_bench_result_count == 0) ? "" : ",",
+               category, algorithm, operation, data_size, (unsigned long long)iterations,
+               seconds, ops_per_sec);
+        libspdm_bench_print_number(cycles_per_op, LIBSPDM_BENCH_HAS_CYCLE_COUNTER);
+        printf(", \"cycles_per_byte\": ");
+        libspdm_bench_print_number(cycles_per_byte,
+                                   LIBSPDM_BENCH_HAS_CYCLE_COUNTER && (data_size != 0));
+        printf("}");
+    } else {
+        printf("%s,%s,%s,%s,%zu,%llu,%.6f,%.3f,",
+               LIBSPDM_CRYPT_BENCH_BACKEND, category, algorithm, operation, data_size,
+               (unsigned long long)iterations, seconds, ops_per_sec);
+        libspdm_bench_print_number(cycles_per_op, LIBSPDM_BENCH_HAS_CYCLE_COUNTER);
+        printf(",");
+        libspdm_bench_print_number(cycles_per_byte,
+                                   LIBSPDM_BENCH_HAS_CYCLE_COUNTER && (data_size != 0));
+        printf("\n");
+    }
+    fflush(stdout);
+    m_libspdm_bench_result_count++;
+}
+
+bool libspdm_bench_run(const char *category, const char *algorithm, const char *operation,
+                       size_t data_size, libspdm_bench_func_t func, void *context)
+{
+    double min_time;
+    double start_time;
+    double elapsed;
+    uint64_t start_cycles;
+    uint64_t iterations;
+    uint64_t batch;
+    uint64_t index;
+
+    if (!func(context)) {
+        fprintf(stderr, "%s/%s %s (size %zu) failed\n", category, algorithm, operation, data_size);
+        m_libspdm_bench_failed = true;
+        return false;
+    }
+
+    /* Check the clock once per batch, doubling the batch until one batch is a small fraction of
+     * the measurement, so that reading the clock does not distort fast operations. */
+    min_time = (double)m_libspdm_bench_min_time_ms / 1000.0;
+    iterations = 0;
+    batch = 1;
+    start_time = libspdm_bench_get_seconds();
+    start_cycles = libspdm_bench_get_cycles();
+    for (;;) {
+        for (index = 0; index < batch; index++) {
+            if (!func(context)) {
+                fprintf(stderr, "%s/%s %s (size %zu) failed\n",
+                        category, algorithm, operation, data_size);
+                m_libspdm_bench_failed = true;
+                return false;
+            }
+        }
+        iterations += batch;
+        elapsed = libspdm_bench_get_seconds() - start_time;
+        if (elapsed >= min_time) {
+            break;
+        }
+        if (elapsed * 64 < min_time) {
+            batch *= 2;
+        }
+    }
+
+    libspdm_bench_print_result(category, algorithm, operation, data_size, iterations, elapsed,
+                               libspdm_bench_get_cycles() - start_cycles);
+    return true;
+}
+
+void libspdm_bench_skip(const char *category, const char *algorithm, const char *reason)
+{
+    if (libspdm_bench_is_selected(category, algorithm)) {
+        fprintf(stderr, "%s/%s skipped: %s\n", category, algorithm, reason);
+    }
+}
+
+bool libspdm_bench_read_file(const char *file_name, void **file_data, size_t *file_size)
+{
+    FILE *fp_in;
+    long size;
+
+    fp_in = fopen(file_name, "rb");
+    if (fp_in == NULL) {
+        return false;
+    }
+    if ((fseek(fp_in, 0, SEEK_END) != 0) || ((size = ftell(fp_in)) <= 0) ||
+        (fseek(fp_in, 0, SEEK_SET) != 0)) {
+        fclose(fp_in);
+        return false;
+    }
+    *file_data = malloc((size_t)size);
+    if (*file_data == NULL) {
+        fclose(fp_in);
+        return false;
+    }
+    if (fread(*file_data, 1, (size_t)size, fp_in) != (size_t)size) {
+        free(*file_data);
+        *file_data = NULL;
+        fclose(fp_in);
+        return false;
+    }
+    fclose(fp_in);
+    *file_size = (size_t)size;
+
+    return true;
+}
+
+static void libspdm_bench_print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [--format json|csv] [--time <ms>] [--filter <text>]\n"
+            "  --format  Output format, default json.\n"
+            "  --time    Minimum measurement time per case in milliseconds, default 200.\n"
+            "  --filter  Only run cases whose \"category/algorithm\" contains <text>.\n"
+            "Sample keys are read from the working directory, as for test_crypt.\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    int index;
+    long value;
+    char *end;
+
+    for (index = 1; index < argc; index++) {
+        if ((strcmp(argv[index], "--format") == 0) && (index + 1 < argc)) {
+            index++;
+            if (strcmp(argv[index], "json") == 0) {
+                m_libspdm_bench_format = LIBSPDM_BENCH_FORMAT_JSON;
+            } else if (strcmp(argv[index], "csv") == 0) {
+                m_libspdm_bench_format = LIBSPDM_BENCH_FORMAT_CSV;
+            } else {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+        } else if ((strcmp(argv[index], "--time") == 0) && (index + 1 < argc)) {
+            index++;
+            value = strtol(argv[index], &end, 10);
+            if ((*end != '\0') || (value <= 0) || (value > 3600000)) {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+            m_libspdm_bench_min_time_ms = (uint32_t)value;
+        } else if ((strcmp(argv[index], "--filter") == 0) && (index + 1 < argc)) {
+            index++;
+            m_libspdm_bench_filter = argv[index];
+        } else {
+            libspdm_bench_print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (m_libspdm_bench_format == LIBSPDM_BENCH_FORMAT_JSON) {
+        printf("{\n  \"backend\": \"%s\",\n  \"cycle_counter\": %s,\n  \"min_time_ms\": %u,\n"
+               "  \"results\": [",
+               LIBSPDM_CRYPT_BENCH_BACKEND,
+               LIBSPDM_BENCH_HAS_CYCLE_COUNTER ? "\"tsc\"" : "null",
+               m_libspdm_bench_min_time_ms);
+    } else {
+        printf("backend,category,algorithm,operation,size,iterations,seconds,ops_per_sec,"
+               "cycles_per_op,cycles_per_byte\n");
+    }
+
+    if (!libspdm_cryptlib_init()) {
+        fprintf(stderr, "libspdm_cryptlib_init failed\n");
+        return 1;
+    }
+
+    libspdm_bench_digest();
+    libspdm_bench_aead();
+    libspdm_bench_asym();
+    libspdm_bench_key_exchange();
+
+    if (m_libspdm_bench_format == LIBSPDM_BENCH_FORMAT_JSON) {
+        printf("\n  ]\n}\n");
+    }
+
+    libspdm_cryptlib_deinit();
+
+    return m_libspdm_bench_failed ? 1 : 0;
+}
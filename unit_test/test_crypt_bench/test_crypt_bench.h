@@ -0,0 +1,106 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __CRYPT_BENCH_H__
+#define __CRYPT_BENCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hal/base.h"
+#include "internal/libspdm_lib_config.h"
+#include "industry_standard/spdm.h"
+#include "industry_standard/spdm_secured_message.h"
+#include "hal/library/memlib.h"
+#include "hal/library/cryptlib.h"
+#include "library/spdm_crypt_lib.h"
+#include "spdm_crypt_ext_lib/spdm_crypt_ext_lib.h"
+
+/* Data sizes used for the size-dependent primitives (hash, HMAC and AEAD). */
+#define LIBSPDM_BENCH_DATA_SIZE_COUNT 6
+extern const size_t m_libspdm_bench_data_size[LIBSPDM_BENCH_DATA_SIZE_COUNT];
+
+/* Largest entry of m_libspdm_bench_data_size. */
+#define LIBSPDM_BENCH_MAX_DATA_SIZE 0x10000
+
+/* SPDM version used for the version-dependent wrappers (signing context, DHE and KEM). */
+#define LIBSPDM_BENCH_SPDM_VERSION (SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT)
+
+/**
+ * One iteration of a benchmarked operation.
+ *
+ * @param  context  Operation specific state that has been set up by the caller.
+ *
+ * @retval true   The operation succeeded.
+ * @retval false  The operation failed. The measurement is abandoned.
+ **/
+typedef bool (*libspdm_bench_func_t)(void *context);
+
+/**
+ * Check whether a benchmark has been selected with the --filter command line option.
+ *
+ * Callers use this to skip expensive setup, such as key loading, for benchmarks that do not run.
+ *
+ * @param  category   Primitive family, such as "hash" or "aead".
+ * @param  algorithm  Algorithm name, such as "sha256".
+ *
+ * @retval true   The benchmark should run.
+ * @retval false  The benchmark was filtered out.
+ **/
+bool libspdm_bench_is_selected(const char *category, const char *algorithm);
+
+/**
+ * Run one operation repeatedly for at least the configured time and report its throughput.
+ *
+ * The operation is run once first as a warm-up and to check that it succeeds.
+ *
+ * @param  category   Primitive family, such as "hash" or "aead".
+ * @param  algorithm  Algorithm name, such as "sha256".
+ * @param  operation  Operation name, such as "digest" or "sign".
+ * @param  data_size  Number of bytes processed by one iteration, or 0 if the operation is not
+ *                    size dependent. cycles/byte is only reported when this is not 0.
+ * @param  func       The operation.
+ * @param  context    Operation specific state passed to func.
+ *
+ * @retval true   The operation was measured.
+ * @retval false  The operation failed. The failure is reported and the program exit status is set.
+ **/
+bool libspdm_bench_run(const char *category, const char *algorithm, const char *operation,
+                       size_t data_size, libspdm_bench_func_t func, void *context);
+
+/**
+ * Report that a benchmark could not run, for example because the algorithm is not compiled in.
+ *
+ * @param  category   Primitive family.
+ * @param  algorithm  Algorithm name.
+ * @param  reason     Short human readable reason.
+ **/
+void libspdm_bench_skip(const char *category, const char *algorithm, const char *reason);
+
+/**
+ * Read a file from the sample key directory.
+ *
+ * @param  file_name  Path relative to the working directory.
+ * @param  file_data  On success, a buffer allocated with malloc() that the caller must free().
+ * @param  file_size  On success, the size of the file in bytes.
+ *
+ * @retval true   The file was read.
+ * @retval false  The file could not be read.
+ **/
+bool libspdm_bench_read_file(const char *file_name, void **file_data, size_t *file_size);
+
+void libspdm_bench_digest(void);
+
+void libspdm_bench_aead(void);
+
+void libspdm_bench_asym(void);
+
+void libspdm_bench_key_exchange(void);
+
+#endif
@@ -0,0 +1,490 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_spdm_bench.h"
+#include "hal/library/requester/timelib.h"
+#include "spdm_device_secret_lib_internal.h"
+#include "spdm_dhe_key_pool.h"
+
+/* Each endpoint owns one buffer that it uses for both sending and receiving, as a device with a
+ * single mailbox would. The responder runs inside the requester's send_message(), so the two
+ * endpoints must not share a buffer. */
+typedef struct {
+    uint8_t buffer[LIBSPDM_BENCH_BUFFER_SIZE];
+    bool acquired;
+} libspdm_bench_device_buffer_t;
+
+/* Transport message in flight between the endpoints. */
+typedef struct {
+    uint8_t message[LIBSPDM_BENCH_BUFFER_SIZE];
+    size_t message_size;
+} libspdm_bench_wire_t;
+
+/* The in-memory link of one requester and responder pair. Each pair owns its link and contexts,
+ * but all pairs share the sample device secret library and the DHE key pool. Different pairs may
+ * run on different threads only because the state of those that the bench phases reach (the
+ * signing key cache, the MEL, the measurement records and the key pool) is locked. The key pair
+ * information of the sample library is not locked, and no bench phase reads or sets it. */
+typedef struct {
+    libspdm_bench_device_buffer_t requester_buffer;
+    libspdm_bench_device_buffer_t responder_buffer;
+    libspdm_bench_wire_t request;
+    libspdm_bench_wire_t response;
+    void *responder_context;
+    /* Time in microseconds that each request and response round trip takes. */
+    uint64_t round_trip_time;
+} libspdm_bench_link_t;
+
+static libspdm_bench_link_t *libspdm_bench_get_link(void *spdm_context)
+{
+    libspdm_data_parameter_t parameter;
+    void *link;
+    size_t data_size;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(link);
+    link = NULL;
+    libspdm_get_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter, &link, &data_size);
+    LIBSPDM_ASSERT(link != NULL);
+    return link;
+}
+
+static libspdm_return_t libspdm_bench_acquire_buffer(libspdm_bench_device_buffer_t *device_buffer,
+                                                     void **msg_buf_ptr)
+{
+    LIBSPDM_ASSERT(!device_buffer->acquired);
+    *msg_buf_ptr = device_buffer->buffer;
+    device_buffer->acquired = true;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_release_buffer(libspdm_bench_device_buffer_t *device_buffer,
+                                         const void *msg_buf_ptr)
+{
+    LIBSPDM_ASSERT(device_buffer->acquired);
+    LIBSPDM_ASSERT(msg_buf_ptr == device_buffer->buffer);
+    device_buffer->acquired = false;
+}
+
+static libspdm_return_t libspdm_bench_requester_acquire_buffer(void *context, void **msg_buf_ptr)
+{
+    return libspdm_bench_acquire_buffer(&libspdm_bench_get_link(context)->requester_buffer,
+                                        msg_buf_ptr);
+}
+
+static void libspdm_bench_requester_release_buffer(void *context, const void *msg_buf_ptr)
+{
+    libspdm_bench_release_buffer(&libspdm_bench_get_link(context)->requester_buffer, msg_buf_ptr);
+}
+
+static libspdm_return_t libspdm_bench_responder_acquire_buffer(void *context, void **msg_buf_ptr)
+{
+    return libspdm_bench_acquire_buffer(&libspdm_bench_get_link(context)->responder_buffer,
+                                        msg_buf_ptr);
+}
+
+static void libspdm_bench_responder_release_buffer(void *context, const void *msg_buf_ptr)
+{
+    libspdm_bench_release_buffer(&libspdm_bench_get_link(context)->responder_buffer, msg_buf_ptr);
+}
+
+static libspdm_return_t libspdm_bench_wire_write(libspdm_bench_wire_t *wire, size_t message_size,
+                                                 const void *message)
+{
+    if (message_size > sizeof(wire->message)) {
+        return LIBSPDM_STATUS_SEND_FAIL;
+    }
+    libspdm_copy_mem(wire->message, sizeof(wire->message), message, message_size);
+    wire->message_size = message_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t libspdm_bench_wire_read(libspdm_bench_wire_t *wire, size_t *message_size,
+                                                void **message)
+{
+    if ((wire->message_size == 0) || (wire->message_size > *message_size)) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    libspdm_copy_mem(*message, *message_size, wire->message, wire->message_size);
+    *message_size = wire->message_size;
+    wire->message_size = 0;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Deliver the request and let the responder process it synchronously, so that the response is
+ * ready when the requester calls receive_message(). The round trip time of the link is spent
+ * here, as a blocking device I/O function would. */
+static libspdm_return_t libspdm_bench_requester_send_message(void *spdm_context,
+                                                             size_t message_size,
+                                                             const void *message,
+                                                             uint64_t timeout)
+{
+    libspdm_bench_link_t *link;
+    libspdm_return_t status;
+
+    link = libspdm_bench_get_link(spdm_context);
+    status = libspdm_bench_wire_write(&link->request, message_size, message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    if (link->round_trip_time != 0) {
+        libspdm_sleep(link->round_trip_time);
+    }
+    link->response.message_size = 0;
+    libspdm_responder_dispatch_message(link->responder_context);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t libspdm_bench_requester_receive_message(void *spdm_context,
+                                                                size_t *message_size,
+                                                                void **message,
+                                                                uint64_t timeout)
+{
+    *message_size = LIBSPDM_BENCH_BUFFER_SIZE;
+    return libspdm_bench_wire_read(&libspdm_bench_get_link(spdm_context)->response, message_size,
+                                   message);
+}
+
+static libspdm_return_t libspdm_bench_responder_send_message(void *spdm_context,
+                                                             size_t message_size,
+                                                             const void *message,
+                                                             uint64_t timeout)
+{
+    return libspdm_bench_wire_write(&libspdm_bench_get_link(spdm_context)->response, message_size,
+                                    message);
+}
+
+static libspdm_return_t libspdm_bench_responder_receive_message(void *spdm_context,
+                                                                size_t *message_size,
+                                                                void **message,
+                                                                uint64_t timeout)
+{
+    *message_size = LIBSPDM_BENCH_BUFFER_SIZE;
+    return libspdm_bench_wire_read(&libspdm_bench_get_link(spdm_context)->request, message_size,
+                                   message);
+}
+
+bool libspdm_bench_suite_is_supported(const libspdm_bench_suite_t *suite)
+{
+    if ((libspdm_get_hash_size(suite->base_hash_algo) == 0) ||
+        (libspdm_get_measurement_hash_size(suite->measurement_hash_algo) == 0) ||
+        (libspdm_get_aead_key_size(suite->aead_cipher_suite) == 0)) {
+        return false;
+    }
+    if ((suite->base_asym_algo != 0) &&
+        (libspdm_get_asym_signature_size(suite->base_asym_algo) == 0)) {
+        return false;
+    }
+    if ((suite->pqc_asym_algo != 0) &&
+        (libspdm_get_pqc_asym_signature_size(suite->pqc_asym_algo) == 0)) {
+        return false;
+    }
+    if ((suite->dhe_named_group != 0) &&
+        (libspdm_get_dhe_pub_key_size(suite->dhe_named_group) == 0)) {
+        return false;
+    }
+    if ((suite->kem_alg != 0) && (libspdm_get_kem_encap_key_size(suite->kem_alg) == 0)) {
+        return false;
+    }
+    return true;
+}
+
+static void *libspdm_bench_context_new(const libspdm_bench_suite_t *suite, bool is_requester,
+                                       libspdm_bench_link_t *link, void **scratch_buffer)
+{
+    void *spdm_context;
+    size_t scratch_buffer_size;
+    libspdm_data_parameter_t parameter;
+
+    spdm_context = malloc(libspdm_get_context_size());
+    if (spdm_context == NULL) {
+        return NULL;
+    }
+    libspdm_init_context(spdm_context);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter,
+                     &link, sizeof(link));
+
+    if (is_requester) {
+        libspdm_register_device_io_func(spdm_context, libspdm_bench_requester_send_message,
+                                        libspdm_bench_requester_receive_message);
+        libspdm_register_device_buffer_func(spdm_context,
+                                            LIBSPDM_BENCH_BUFFER_SIZE,
+                                            LIBSPDM_BENCH_BUFFER_SIZE,
+                                            libspdm_bench_requester_acquire_buffer,
+                                            libspdm_bench_requester_release_buffer,
+                                            libspdm_bench_requester_acquire_buffer,
+                                            libspdm_bench_requester_release_buffer);
+    } else {
+        libspdm_register_device_io_func(spdm_context, libspdm_bench_responder_send_message,
+                                        libspdm_bench_responder_receive_message);
+        libspdm_register_device_buffer_func(spdm_context,
+                                            LIBSPDM_BENCH_BUFFER_SIZE,
+                                            LIBSPDM_BENCH_BUFFER_SIZE,
+                                            libspdm_bench_responder_acquire_buffer,
+                                            libspdm_bench_responder_release_buffer,
+                                            libspdm_bench_responder_acquire_buffer,
+                                            libspdm_bench_responder_release_buffer);
+    }
+    libspdm_register_transport_layer_func(spdm_context,
+                                          LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE,
+                                          LIBSPDM_TEST_TRANSPORT_HEADER_SIZE,
+                                          LIBSPDM_TEST_TRANSPORT_TAIL_SIZE,
+                                          libspdm_transport_test_encode_message,
+                                          libspdm_transport_test_decode_message);
+
+    scratch_buffer_size = libspdm_get_sizeof_required_scratch_buffer(spdm_context);
+    *scratch_buffer = malloc(scratch_buffer_size);
+    if (*scratch_buffer == NULL) {
+        free(spdm_context);
+        return NULL;
+    }
+    libspdm_set_scratch_buffer(spdm_context, *scratch_buffer, scratch_buffer_size);
+
+    libspdm_bench_context_configure(spdm_context, suite, is_requester);
+
+    return spdm_context;
+}
+
+void libspdm_bench_context_configure(void *spdm_context, const libspdm_bench_suite_t *suite,
+                                     bool is_requester)
+{
+    libspdm_data_parameter_t parameter;
+    uint8_t data8;
+    uint16_t data16;
+    uint32_t data32;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+
+    data8 = 0;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_CAPABILITY_CT_EXPONENT, &parameter,
+                     &data8, sizeof(data8));
+    if (is_requester) {
+        data32 = SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+    } else {
+        data32 = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+    }
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_CAPABILITY_FLAGS, &parameter,
+                     &data32, sizeof(data32));
+
+    data8 = SPDM_MEASUREMENT_SPECIFICATION_DMTF;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_MEASUREMENT_SPEC, &parameter,
+                     &data8, sizeof(data8));
+    data32 = suite->measurement_hash_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_MEASUREMENT_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = suite->base_asym_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_BASE_ASYM_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = suite->pqc_asym_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_PQC_ASYM_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = suite->base_hash_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_BASE_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data16 = suite->dhe_named_group;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_DHE_NAME_GROUP, &parameter,
+                     &data16, sizeof(data16));
+    data32 = suite->kem_alg;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_KEM_ALG, &parameter,
+                     &data32, sizeof(data32));
+    data16 = suite->aead_cipher_suite;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_AEAD_CIPHER_SUITE, &parameter,
+                     &data16, sizeof(data16));
+    data16 = SPDM_ALGORITHMS_KEY_SCHEDULE_SPDM;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_KEY_SCHEDULE, &parameter,
+                     &data16, sizeof(data16));
+    data8 = SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_1;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_OTHER_PARAMS_SUPPORT, &parameter,
+                     &data8, sizeof(data8));
+
+    /* The pool hands out nothing until --dhe-key-pool starts it, so the responder generates its
+     * DHE key pairs inline by default. */
+    if (!is_requester) {
+        libspdm_register_dhe_key_pair_func(spdm_context, libspdm_dhe_key_pool_acquire_key_pair);
+    }
+}
+
+bool libspdm_bench_read_certificates(const libspdm_bench_suite_t *suite,
+                                     libspdm_bench_endpoints_t *endpoints,
+                                     size_t *cert_chain_size, const uint8_t **root_cert,
+                                     size_t *root_cert_size)
+{
+    size_t root_cert_chain_size;
+    size_t hash_size;
+    bool result;
+
+    if (suite->pqc_asym_algo != 0) {
+        result = libspdm_read_pqc_responder_public_certificate_chain(
+            suite->base_hash_algo, suite->pqc_asym_algo,
+            &endpoints->responder_cert_chain, cert_chain_size, NULL, NULL) &&
+                 libspdm_read_pqc_responder_root_public_certificate(
+            suite->base_hash_algo, suite->pqc_asym_algo,
+            &endpoints->root_cert_chain, &root_cert_chain_size, NULL, NULL);
+    } else {
+        result = libspdm_read_responder_public_certificate_chain(
+            suite->base_hash_algo, suite->base_asym_algo,
+            &endpoints->responder_cert_chain, cert_chain_size, NULL, NULL) &&
+                 libspdm_read_responder_root_public_certificate(
+            suite->base_hash_algo, suite->base_asym_algo,
+            &endpoints->root_cert_chain, &root_cert_chain_size, NULL, NULL);
+    }
+    if (!result) {
+        return false;
+    }
+
+    /* The root certificate follows the spdm_cert_chain_t header and the root hash. */
+    hash_size = libspdm_get_hash_size(suite->base_hash_algo);
+    return libspdm_x509_get_cert_from_cert_chain(
+        (uint8_t *)endpoints->root_cert_chain + sizeof(spdm_cert_chain_t) + hash_size,
+        root_cert_chain_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
+        root_cert, root_cert_size);
+}
+
+bool libspdm_bench_endpoints_init(const libspdm_bench_suite_t *suite,
+                                  libspdm_bench_endpoints_t *endpoints)
+{
+    libspdm_data_parameter_t parameter;
+    size_t cert_chain_size;
+    const uint8_t *root_cert;
+    size_t root_cert_size;
+    uint8_t slot_mask;
+
+    libspdm_zero_mem(endpoints, sizeof(*endpoints));
+
+    if (!libspdm_bench_read_certificates(suite, endpoints, &cert_chain_size,
+                                         &root_cert, &root_cert_size)) {
+        libspdm_bench_endpoints_free(endpoints);
+        return false;
+    }
+
+    endpoints->link = calloc(1, sizeof(libspdm_bench_link_t));
+    if (endpoints->link == NULL) {
+        libspdm_bench_endpoints_free(endpoints);
+        return false;
+    }
+    endpoints->requester_context = libspdm_bench_context_new(
+        suite, true, endpoints->link, &endpoints->requester_scratch_buffer);
+    endpoints->responder_context = libspdm_bench_context_new(
+        suite, false, endpoints->link, &endpoints->responder_scratch_buffer);
+    if ((endpoints->requester_context == NULL) || (endpoints->responder_context == NULL)) {
+        libspdm_bench_endpoints_free(endpoints);
+        return false;
+    }
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    libspdm_set_data(endpoints->requester_context, LIBSPDM_DATA_PEER_PUBLIC_ROOT_CERT,
+                     &parameter, root_cert, root_cert_size);
+
+    parameter.additional_data[0] = 0;
+    libspdm_set_data(endpoints->responder_context, LIBSPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+                     &parameter, endpoints->responder_cert_chain, cert_chain_size);
+    parameter.additional_data[0] = 0;
+    slot_mask = 0x01;
+    libspdm_set_data(endpoints->responder_context, LIBSPDM_DATA_LOCAL_SUPPORTED_SLOT_MASK,
+                     &parameter, &slot_mask, sizeof(slot_mask));
+
+    ((libspdm_bench_link_t *)endpoints->link)->responder_context = endpoints->responder_context;
+
+    return true;
+}
+
+void libspdm_bench_endpoints_set_round_trip_time(libspdm_bench_endpoints_t *endpoints,
+                                                 uint64_t round_trip_time)
+{
+    ((libspdm_bench_link_t *)endpoints->link)->round_trip_time = round_trip_time;
+}
+
+void libspdm_bench_endpoints_free(libspdm_bench_endpoints_t *endpoints)
+{
+    if (endpoints->requester_context != NULL) {
+        libspdm_deinit_context(endpoints->requester_context);
+        free(endpoints->requester_context);
+    }
+    if (endpoints->responder_context != NULL) {
+        libspdm_deinit_context(endpoints->responder_context);
+        free(endpoints->responder_context);
+    }
+    free(endpoints->requester_scratch_buffer);
+    free(endpoints->responder_scratch_buffer);
+    free(endpoints->responder_cert_chain);
+    free(endpoints->root_cert_chain);
+    free(endpoints->link);
+    libspdm_zero_mem(endpoints, sizeof(*endpoints));
+}
+
+bool libspdm_read_input_file(const char *file_name, void **file_data, size_t *file_size)
+{
+    FILE *fp_in;
+    long size;
+
+    *file_data = NULL;
+    *file_size = 0;
+
+    fp_in = fopen(file_name, "rb");
+    if (fp_in == NULL) {
+        return false;
+    }
+    if ((fseek(fp_in, 0, SEEK_END) != 0) || ((size = ftell(fp_in)) <= 0) ||
+        (fseek(fp_in, 0, SEEK_SET) != 0)) {
+        fclose(fp_in);
+        return false;
+    }
+    *file_data = malloc((size_t)size);
+    if (*file_data == NULL) {
+        fclose(fp_in);
+        return false;
+    }
+    if (fread(*file_data, 1, (size_t)size, fp_in) != (size_t)size) {
+        free(*file_data);
+        *file_data = NULL;
+        fclose(fp_in);
+        return false;
+    }
+    fclose(fp_in);
+    *file_size = (size_t)size;
+
+    return true;
+}
+
+bool libspdm_write_output_file(const char *file_name, const void *file_data, size_t file_size)
+{
+    FILE *fp_out;
+
+    fp_out = fopen(file_name, "w+b");
+    if (fp_out == NULL) {
+        return false;
+    }
+    if ((file_size != 0) && (fwrite(file_data, 1, file_size, fp_out) != file_size)) {
+        fclose(fp_out);
+        return false;
+    }
+    fclose(fp_out);
+
+    return true;
+}
+
+/* Only used by the PSK debug output of the sample device secret library. */
+void libspdm_dump_hex_str(const uint8_t *buffer, size_t buffer_size)
+{
+    size_t index;
+
+    for (index = 0; index < buffer_size; index++) {
+        fprintf(stderr, "%02x", buffer[index]);
+    }
+}
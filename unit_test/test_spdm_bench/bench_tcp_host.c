@@ -0,0 +1,374 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/* The socket and thread interfaces are POSIX interfaces that strict C99 does not expose. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "test_spdm_bench.h"
+
+#if LIBSPDM_BENCH_TCP_HOST
+
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "spdm_tcp_responder_host.h"
+
+#define LIBSPDM_BENCH_TCP_BUFFER_SIZE (LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE + \
+                                       LIBSPDM_TCP_TRANSPORT_HEADER_SIZE + \
+                                       LIBSPDM_TCP_TRANSPORT_TAIL_SIZE)
+
+/* The requester end of one connection to the host. */
+typedef struct {
+    int fd;
+    uint8_t sender_buffer[LIBSPDM_BENCH_TCP_BUFFER_SIZE];
+    uint8_t receiver_buffer[LIBSPDM_BENCH_TCP_BUFFER_SIZE];
+} libspdm_bench_tcp_link_t;
+
+/* The host and the certificates that its contexts serve. */
+static libspdm_tcp_responder_host_t *m_libspdm_bench_tcp_host;
+static pthread_t m_libspdm_bench_tcp_host_thread;
+static const libspdm_bench_suite_t *m_libspdm_bench_tcp_host_suite;
+static libspdm_bench_endpoints_t m_libspdm_bench_tcp_host_certificates;
+static size_t m_libspdm_bench_tcp_host_cert_chain_size;
+
+static libspdm_bench_tcp_link_t *libspdm_bench_tcp_get_link(void *spdm_context)
+{
+    libspdm_data_parameter_t parameter;
+    void *link;
+    size_t data_size;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(link);
+    link = NULL;
+    libspdm_get_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter, &link, &data_size);
+    LIBSPDM_ASSERT(link != NULL);
+    return link;
+}
+
+static libspdm_return_t libspdm_bench_tcp_acquire_sender_buffer(void *context,
+                                                                void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_tcp_get_link(context)->sender_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_tcp_release_sender_buffer(void *context, const void *msg_buf_ptr)
+{
+}
+
+static libspdm_return_t libspdm_bench_tcp_acquire_receiver_buffer(void *context,
+                                                                  void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_tcp_get_link(context)->receiver_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_tcp_release_receiver_buffer(void *context, const void *msg_buf_ptr)
+{
+}
+
+static bool libspdm_bench_tcp_read(int fd, uint8_t *buffer, size_t size)
+{
+    ssize_t received;
+
+    while (size != 0) {
+        received = recv(fd, buffer, size, 0);
+        if (received <= 0) {
+            if ((received < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return false;
+        }
+        buffer += received;
+        size -= (size_t)received;
+    }
+    return true;
+}
+
+static libspdm_return_t libspdm_bench_tcp_send_message(void *spdm_context, size_t message_size,
+                                                       const void *message, uint64_t timeout)
+{
+    libspdm_bench_tcp_link_t *link;
+    const uint8_t *data;
+    ssize_t sent;
+
+    link = libspdm_bench_tcp_get_link(spdm_context);
+    data = message;
+    while (message_size != 0) {
+        sent = send(link->fd, data, message_size, 0);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return LIBSPDM_STATUS_SEND_FAIL;
+        }
+        data += sent;
+        message_size -= (size_t)sent;
+    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Read one transport message. Its size is given by the TCP binding header. */
+static libspdm_return_t libspdm_bench_tcp_receive_message(void *spdm_context,
+                                                          size_t *message_size, void **message,
+                                                          uint64_t timeout)
+{
+    libspdm_bench_tcp_link_t *link;
+    spdm_tcp_binding_header_t *header;
+    size_t frame_size;
+
+    link = libspdm_bench_tcp_get_link(spdm_context);
+    header = *message;
+    if ((*message_size < sizeof(*header)) ||
+        !libspdm_bench_tcp_read(link->fd, *message, sizeof(*header))) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    if ((header->message_type != SPDM_TCP_MESSAGE_TYPE_OUT_OF_SESSION) &&
+        (header->message_type != SPDM_TCP_MESSAGE_TYPE_IN_SESSION)) {
+        /* A TCP binding error message from the host. */
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    frame_size = sizeof(header->payload_length) + header->payload_length;
+    if ((frame_size <= sizeof(*header)) || (frame_size > *message_size) ||
+        !libspdm_bench_tcp_read(link->fd, (uint8_t *)*message + sizeof(*header),
+                                frame_size - sizeof(*header))) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    *message_size = frame_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static bool libspdm_bench_tcp_host_init_context(void *spdm_context, void *user_data)
+{
+    libspdm_data_parameter_t parameter;
+    uint8_t slot_mask;
+
+    libspdm_bench_context_configure(spdm_context, m_libspdm_bench_tcp_host_suite, false);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    parameter.additional_data[0] = 0;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN, &parameter,
+                     m_libspdm_bench_tcp_host_certificates.responder_cert_chain,
+                     m_libspdm_bench_tcp_host_cert_chain_size);
+    slot_mask = 0x01;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_LOCAL_SUPPORTED_SLOT_MASK, &parameter,
+                     &slot_mask, sizeof(slot_mask));
+    return true;
+}
+
+static void *libspdm_bench_tcp_host_entry(void *host)
+{
+    if (!libspdm_tcp_responder_host_run(host)) {
+        fprintf(stderr, "tcp host event loop failed\n");
+    }
+    return NULL;
+}
+
+bool libspdm_bench_tcp_host_start(const libspdm_bench_suite_t *suite, size_t max_connections,
+                                  size_t worker_count)
+{
+    libspdm_tcp_responder_host_config_t config;
+    const uint8_t *root_cert;
+    size_t root_cert_size;
+
+    libspdm_zero_mem(&m_libspdm_bench_tcp_host_certificates,
+                     sizeof(m_libspdm_bench_tcp_host_certificates));
+    if (!libspdm_bench_read_certificates(suite, &m_libspdm_bench_tcp_host_certificates,
+                                         &m_libspdm_bench_tcp_host_cert_chain_size,
+                                         &root_cert, &root_cert_size)) {
+        libspdm_bench_endpoints_free(&m_libspdm_bench_tcp_host_certificates);
+        return false;
+    }
+    m_libspdm_bench_tcp_host_suite = suite;
+
+    libspdm_zero_mem(&config, sizeof(config));
+    config.address = "127.0.0.1";
+    config.port = 0;
+    config.max_connections = max_connections;
+    config.worker_count = worker_count;
+    config.max_queued_requests = worker_count;
+    config.max_spdm_msg_size = LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE;
+    config.init_context = libspdm_bench_tcp_host_init_context;
+    m_libspdm_bench_tcp_host = libspdm_tcp_responder_host_new(&config);
+    if (m_libspdm_bench_tcp_host == NULL) {
+        libspdm_bench_endpoints_free(&m_libspdm_bench_tcp_host_certificates);
+        return false;
+    }
+    if (pthread_create(&m_libspdm_bench_tcp_host_thread, NULL, libspdm_bench_tcp_host_entry,
+                       m_libspdm_bench_tcp_host) != 0) {
+        libspdm_tcp_responder_host_free(m_libspdm_bench_tcp_host);
+        m_libspdm_bench_tcp_host = NULL;
+        libspdm_bench_endpoints_free(&m_libspdm_bench_tcp_host_certificates);
+        return false;
+    }
+    return true;
+}
+
+void libspdm_bench_tcp_host_stop(void)
+{
+    libspdm_tcp_responder_host_stats_t stats;
+
+    if (m_libspdm_bench_tcp_host == NULL) {
+        return;
+    }
+    libspdm_tcp_responder_host_stop(m_libspdm_bench_tcp_host);
+    pthread_join(m_libspdm_bench_tcp_host_thread, NULL);
+
+    libspdm_tcp_responder_host_get_stats(m_libspdm_bench_tcp_host, &stats);
+    fprintf(stderr, "%s tcp host: %llu connections, %llu requests, %llu failed, "
+            "%llu rejected, %zu peak waiting\n",
+            m_libspdm_bench_tcp_host_suite->name,
+            (unsigned long long)stats.accepted_connections,
+            (unsigned long long)stats.requests,
+            (unsigned long long)stats.failed_requests,
+            (unsigned long long)stats.rejected_messages,
+            stats.peak_waiting_requests);
+
+    libspdm_tcp_responder_host_free(m_libspdm_bench_tcp_host);
+    m_libspdm_bench_tcp_host = NULL;
+    libspdm_bench_endpoints_free(&m_libspdm_bench_tcp_host_certificates);
+}
+
+static int libspdm_bench_tcp_connect(uint16_t port)
+{
+    struct sockaddr_in address;
+    int fd;
+    int value;
+
+    libspdm_zero_mem(&address, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    value = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool libspdm_bench_tcp_endpoints_init(const libspdm_bench_suite_t *suite,
+                                      libspdm_bench_endpoints_t *endpoints)
+{
+    libspdm_bench_tcp_link_t *link;
+    libspdm_data_parameter_t parameter;
+    size_t cert_chain_size;
+    const uint8_t *root_cert;
+    size_t root_cert_size;
+    size_t scratch_buffer_size;
+    void *spdm_context;
+
+    libspdm_zero_mem(endpoints, sizeof(*endpoints));
+    if ((m_libspdm_bench_tcp_host == NULL) ||
+        !libspdm_bench_read_certificates(suite, endpoints, &cert_chain_size,
+                                         &root_cert, &root_cert_size)) {
+        libspdm_bench_tcp_endpoints_free(endpoints);
+        return false;
+    }
+
+    link = calloc(1, sizeof(*link));
+    if (link == NULL) {
+        libspdm_bench_tcp_endpoints_free(endpoints);
+        return false;
+    }
+    endpoints->link = link;
+    link->fd = libspdm_bench_tcp_connect(
+        libspdm_tcp_responder_host_get_port(m_libspdm_bench_tcp_host));
+    spdm_context = malloc(libspdm_get_context_size());
+    if ((link->fd < 0) || (spdm_context == NULL)) {
+        free(spdm_context);
+        libspdm_bench_tcp_endpoints_free(endpoints);
+        return false;
+    }
+    endpoints->requester_context = spdm_context;
+    libspdm_init_context(spdm_context);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter,
+                     &link, sizeof(link));
+    libspdm_register_device_io_func(spdm_context, libspdm_bench_tcp_send_message,
+                                    libspdm_bench_tcp_receive_message);
+    libspdm_register_device_buffer_func(spdm_context,
+                                        LIBSPDM_BENCH_TCP_BUFFER_SIZE,
+                                        LIBSPDM_BENCH_TCP_BUFFER_SIZE,
+                                        libspdm_bench_tcp_acquire_sender_buffer,
+                                        libspdm_bench_tcp_release_sender_buffer,
+                                        libspdm_bench_tcp_acquire_receiver_buffer,
+                                        libspdm_bench_tcp_release_receiver_buffer);
+    libspdm_register_transport_layer_func(spdm_context,
+                                          LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE,
+                                          LIBSPDM_TCP_TRANSPORT_HEADER_SIZE,
+                                          LIBSPDM_TCP_TRANSPORT_TAIL_SIZE,
+                                          libspdm_transport_tcp_encode_message,
+                                          libspdm_transport_tcp_decode_message);
+
+    scratch_buffer_size = libspdm_get_sizeof_required_scratch_buffer(spdm_context);
+    endpoints->requester_scratch_buffer = malloc(scratch_buffer_size);
+    if (endpoints->requester_scratch_buffer == NULL) {
+        libspdm_bench_tcp_endpoints_free(endpoints);
+        return false;
+    }
+    libspdm_set_scratch_buffer(spdm_context, endpoints->requester_scratch_buffer,
+                               scratch_buffer_size);
+
+    libspdm_bench_context_configure(spdm_context, suite, true);
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_PUBLIC_ROOT_CERT,
+                     &parameter, root_cert, root_cert_size);
+
+    return true;
+}
+
+void libspdm_bench_tcp_endpoints_free(libspdm_bench_endpoints_t *endpoints)
+{
+    libspdm_bench_tcp_link_t *link;
+
+    link = endpoints->link;
+    if ((link != NULL) && (link->fd >= 0)) {
+        close(link->fd);
+    }
+    libspdm_bench_endpoints_free(endpoints);
+}
+
+#else /* LIBSPDM_BENCH_TCP_HOST */
+
+bool libspdm_bench_tcp_host_start(const libspdm_bench_suite_t *suite, size_t max_connections,
+                                  size_t worker_count)
+{
+    return false;
+}
+
+void libspdm_bench_tcp_host_stop(void)
+{
+}
+
+bool libspdm_bench_tcp_endpoints_init(const libspdm_bench_suite_t *suite,
+                                      libspdm_bench_endpoints_t *endpoints)
+{
+    return false;
+}
+
+void libspdm_bench_tcp_endpoints_free(libspdm_bench_endpoints_t *endpoints)
+{
+    libspdm_bench_endpoints_free(endpoints);
+}
+
+#endif /* LIBSPDM_BENCH_TCP_HOST */
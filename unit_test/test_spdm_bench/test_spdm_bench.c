@@ -0,0 +1,660 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/* clock_gettime() is a POSIX interface that strict C99 does not expose by default. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "test_spdm_bench.h"
+#include "spdm_attestation_scheduler.h"
+#include "spdm_dhe_key_pool.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifndef LIBSPDM_SPDM_BENCH_BACKEND
+#define LIBSPDM_SPDM_BENCH_BACKEND "unknown"
+#endif
+
+typedef enum {
+    LIBSPDM_BENCH_FORMAT_JSON,
+    LIBSPDM_BENCH_FORMAT_CSV,
+} libspdm_bench_format_t;
+
+static const libspdm_bench_suite_t m_libspdm_bench_suite[] = {
+    { "rsa3072_sha384", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072, 0,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+      SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072, 0,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+    { "ecp256_sha256", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256, 0,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+      SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1, 0,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+    { "ecp384_sha384", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384, 0,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+      SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1, 0,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+    { "ecp521_sha512", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521, 0,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512,
+      SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1, 0,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+    { "ed25519_sha256", SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED25519, 0,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+      SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1, 0,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305 },
+    { "sm2_sm3", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256, 0,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SM3_256,
+      SPDM_ALGORITHMS_DHE_NAMED_GROUP_SM2_P256, 0,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM },
+    { "mldsa44_mlkem512", 0, SPDM_ALGORITHMS_PQC_ASYM_ALGO_ML_DSA_44,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+      0, SPDM_ALGORITHMS_KEM_ALG_ML_KEM_512,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+    { "mldsa65_mlkem768", 0, SPDM_ALGORITHMS_PQC_ASYM_ALGO_ML_DSA_65,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+      0, SPDM_ALGORITHMS_KEM_ALG_ML_KEM_768,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+    { "mldsa87_mlkem1024", 0, SPDM_ALGORITHMS_PQC_ASYM_ALGO_ML_DSA_87,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512,
+      0, SPDM_ALGORITHMS_KEM_ALG_ML_KEM_1024,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+    { "slhdsa_sha2_128s_mlkem512", 0, SPDM_ALGORITHMS_PQC_ASYM_ALGO_SLH_DSA_SHA2_128S,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+      SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+      0, SPDM_ALGORITHMS_KEM_ALG_ML_KEM_512,
+      SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+};
+
+static const char *m_libspdm_bench_phase_name[LIBSPDM_BENCH_PHASE_COUNT] = {
+    "init_connection",
+    "get_digest",
+    "get_certificate",
+    "challenge",
+    "get_measurement",
+    "start_session",
+    "stop_session",
+};
+
+static libspdm_bench_format_t m_libspdm_bench_format = LIBSPDM_BENCH_FORMAT_JSON;
+static uint32_t m_libspdm_bench_iterations = 100;
+static const char *m_libspdm_bench_filter = NULL;
+static uint64_t m_libspdm_bench_round_trip_time = 0;
+/* In fleet mode, the number of devices that are attested together, or 0. */
+static uint32_t m_libspdm_bench_device_count = 0;
+static uint32_t m_libspdm_bench_worker_count = 1;
+/* In fleet mode, the number of worker threads of the TCP responder host, or 0 for in-memory
+ * devices. */
+static uint32_t m_libspdm_bench_tcp_host_worker_count = 0;
+/* The depth of the DHE key pair pool of the responders, or 0 to generate key pairs inline. */
+static uint32_t m_libspdm_bench_dhe_key_pool_depth = 0;
+static size_t m_libspdm_bench_result_count = 0;
+static bool m_libspdm_bench_failed = false;
+
+/* Latency of every phase of every measured handshake, in microseconds. The last row holds the
+ * latency of the whole handshake. */
+static double *m_libspdm_bench_latency[LIBSPDM_BENCH_PHASE_COUNT + 1];
+
+/* One device of the fleet, with its own link and buffers. */
+typedef struct {
+    libspdm_bench_endpoints_t endpoints;
+    libspdm_attestation_job_t job;
+    uint8_t cert_chain[SPDM_MAX_CERTIFICATE_CHAIN_SIZE];
+    uint8_t measurement_record[LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE];
+} libspdm_bench_device_t;
+
+static double libspdm_bench_get_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
+
+static int libspdm_bench_compare_double(const void *a, const void *b)
+{
+    double x;
+    double y;
+
+    x = *(const double *)a;
+    y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted samples. */
+static double libspdm_bench_percentile(const double *sorted, size_t count, uint32_t percent)
+{
+    size_t rank;
+
+    rank = (count * percent + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+    return sorted[rank - 1];
+}
+
+/* Print the latency distribution of one phase. The samples are sorted in place. */
+static void libspdm_bench_print_result(const char *suite, const char *phase,
+                                       double *samples, size_t count)
+{
+    double total;
+    double mean;
+    size_t index;
+
+    qsort(samples, count, sizeof(double), libspdm_bench_compare_double);
+    total = 0;
+    for (index = 0; index < count; index++) {
+        total += samples[index];
+    }
+    mean = total / (double)count;
+
+    if (m_libspdm_bench_format == LIBSPDM_BENCH_FORMAT_JSON) {
+        printf("%s\n    {\"suite\": \"%s\", \"phase\": \"%s\", \"iterations\": %zu, "
+               "\"mean_us\": %.3f, \"min_us\": %.3f, \"p50_us\": %.3f, \"p90_us\": %.3f, "
+               "\"p99_us\": %.3f, \"max_us\": %.3f, \"ops_per_sec\": %.3f}",
+               (m_libspdm_bench_result_count == 0) ? "" : ",",
+               suite, phase, count, mean, samples[0],
+               libspdm_bench_percentile(samples, count, 50),
+               libspdm_bench_percentile(samples, count, 90),
+               libspdm_bench_percentile(samples, count, 99),
+               samples[count - 1], 1e6 / mean);
+    } else {
+        printf("%s,%s,%s,%zu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+               LIBSPDM_SPDM_BENCH_BACKEND, suite, phase, count, mean, samples[0],
+               libspdm_bench_percentile(samples, count, 50),
+               libspdm_bench_percentile(samples, count, 90),
+               libspdm_bench_percentile(samples, count, 99),
+               samples[count - 1], 1e6 / mean);
+    }
+    fflush(stdout);
+    m_libspdm_bench_result_count++;
+}
+
+/* Run one phase of the handshake. */
+static libspdm_return_t libspdm_bench_run_phase(void *spdm_context, libspdm_bench_phase_t phase,
+                                                uint32_t *session_id)
+{
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    static uint8_t cert_chain[SPDM_MAX_CERTIFICATE_CHAIN_SIZE];
+    size_t cert_chain_size;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t number_of_blocks;
+    static uint8_t measurement_record[LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE];
+    uint32_t measurement_record_length;
+    uint8_t heartbeat_period;
+
+    switch (phase) {
+    case LIBSPDM_BENCH_PHASE_INIT_CONNECTION:
+        return libspdm_init_connection(spdm_context, false);
+    case LIBSPDM_BENCH_PHASE_GET_DIGEST:
+        return libspdm_get_digest(spdm_context, NULL, &slot_mask, total_digest_buffer);
+    case LIBSPDM_BENCH_PHASE_GET_CERTIFICATE:
+        cert_chain_size = sizeof(cert_chain);
+        return libspdm_get_certificate(spdm_context, NULL, 0, &cert_chain_size, cert_chain);
+    case LIBSPDM_BENCH_PHASE_CHALLENGE:
+        return libspdm_challenge(spdm_context, NULL, 0,
+                                 SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                 measurement_hash, NULL);
+    case LIBSPDM_BENCH_PHASE_GET_MEASUREMENT:
+        measurement_record_length = sizeof(measurement_record);
+        return libspdm_get_measurement(
+            spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+            SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS, 0, NULL,
+            &number_of_blocks, &measurement_record_length, measurement_record);
+    case LIBSPDM_BENCH_PHASE_START_SESSION:
+        return libspdm_start_session(spdm_context, false, NULL, 0,
+                                     SPDM_KEY_EXCHANGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                     0, 0, session_id, &heartbeat_period, measurement_hash);
+    case LIBSPDM_BENCH_PHASE_STOP_SESSION:
+        return libspdm_stop_session(spdm_context, *session_id, 0);
+    default:
+        LIBSPDM_ASSERT(false);
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+}
+
+/* Run one handshake. If iteration is not negative, the latencies are recorded at that index. */
+static bool libspdm_bench_run_handshake(const libspdm_bench_suite_t *suite, void *spdm_context,
+                                        int64_t iteration)
+{
+    libspdm_bench_phase_t phase;
+    libspdm_return_t status;
+    uint32_t session_id;
+    double handshake_start;
+    double phase_start;
+    double phase_end;
+
+    session_id = 0;
+    handshake_start = libspdm_bench_get_seconds();
+    phase_start = handshake_start;
+    for (phase = 0; phase < LIBSPDM_BENCH_PHASE_COUNT; phase++) {
+        status = libspdm_bench_run_phase(spdm_context, phase, &session_id);
+        phase_end = libspdm_bench_get_seconds();
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            fprintf(stderr, "%s %s failed with status 0x%08x\n",
+                    suite->name, m_libspdm_bench_phase_name[phase], (uint32_t)status);
+            return false;
+        }
+        if (iteration >= 0) {
+            m_libspdm_bench_latency[phase][iteration] = (phase_end - phase_start) * 1e6;
+        }
+        phase_start = phase_end;
+    }
+    if (iteration >= 0) {
+        m_libspdm_bench_latency[LIBSPDM_BENCH_PHASE_COUNT][iteration] =
+            (phase_start - handshake_start) * 1e6;
+    }
+
+    return true;
+}
+
+static void libspdm_bench_run_suite(const libspdm_bench_suite_t *suite)
+{
+    libspdm_bench_endpoints_t endpoints;
+    uint32_t iteration;
+    size_t phase;
+
+    if (!libspdm_bench_suite_is_supported(suite)) {
+        fprintf(stderr, "%s skipped: not supported\n", suite->name);
+        return;
+    }
+    if (!libspdm_bench_endpoints_init(suite, &endpoints)) {
+        fprintf(stderr, "%s skipped: cannot read the sample certificates\n", suite->name);
+        return;
+    }
+    libspdm_bench_endpoints_set_round_trip_time(&endpoints, m_libspdm_bench_round_trip_time);
+
+    /* The first handshake loads the responder private key and warms up the caches. */
+    if (!libspdm_bench_run_handshake(suite, endpoints.requester_context, -1)) {
+        m_libspdm_bench_failed = true;
+        libspdm_bench_endpoints_free(&endpoints);
+        return;
+    }
+    for (iteration = 0; iteration < m_libspdm_bench_iterations; iteration++) {
+        if (!libspdm_bench_run_handshake(suite, endpoints.requester_context, iteration)) {
+            m_libspdm_bench_failed = true;
+            libspdm_bench_endpoints_free(&endpoints);
+            return;
+        }
+    }
+    libspdm_bench_endpoints_free(&endpoints);
+
+    for (phase = 0; phase < LIBSPDM_BENCH_PHASE_COUNT; phase++) {
+        libspdm_bench_print_result(suite->name, m_libspdm_bench_phase_name[phase],
+                                   m_libspdm_bench_latency[phase], m_libspdm_bench_iterations);
+    }
+    libspdm_bench_print_result(suite->name, "handshake",
+                               m_libspdm_bench_latency[LIBSPDM_BENCH_PHASE_COUNT],
+                               m_libspdm_bench_iterations);
+}
+
+/* Close the session of an attested device on the worker, as a fleet manager would once the
+ * device is trusted. */
+static void libspdm_bench_complete_device(libspdm_attestation_job_t *job)
+{
+    libspdm_return_t status;
+
+    if (!LIBSPDM_STATUS_IS_ERROR(job->status)) {
+        status = libspdm_stop_session(job->spdm_context, job->session_id, 0);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            job->status = status;
+            job->failed_step = LIBSPDM_ATTESTATION_STEP_START_SESSION;
+        }
+    }
+}
+
+/* Attest every device of the fleet once. If round is not negative, the latencies are recorded at
+ * that index. */
+static bool libspdm_bench_run_fleet_round(const libspdm_bench_suite_t *suite,
+                                          libspdm_attestation_scheduler_t *scheduler,
+                                          libspdm_bench_device_t *device, double *device_latency,
+                                          int64_t round)
+{
+    libspdm_attestation_job_t *job;
+    uint32_t index;
+    double start;
+
+    start = libspdm_bench_get_seconds();
+    for (index = 0; index < m_libspdm_bench_device_count; index++) {
+        job = &device[index].job;
+        job->cert_chain_size = sizeof(device[index].cert_chain);
+        job->measurement_record_length = sizeof(device[index].measurement_record);
+        libspdm_attestation_scheduler_submit(scheduler, job);
+    }
+    libspdm_attestation_scheduler_wait(scheduler);
+
+    for (index = 0; index < m_libspdm_bench_device_count; index++) {
+        job = &device[index].job;
+        if (LIBSPDM_STATUS_IS_ERROR(job->status)) {
+            fprintf(stderr, "%s device %u failed at step 0x%x with status 0x%08x\n",
+                    suite->name, index, job->failed_step, (uint32_t)job->status);
+            return false;
+        }
+        if (round >= 0) {
+            device_latency[round * m_libspdm_bench_device_count + index] =
+                (double)job->elapsed_time;
+        }
+    }
+    if (round >= 0) {
+        m_libspdm_bench_latency[0][round] =
+            (libspdm_bench_get_seconds() - start) * 1e6 / m_libspdm_bench_device_count;
+    }
+
+    return true;
+}
+
+static void libspdm_bench_run_fleet(const libspdm_bench_suite_t *suite)
+{
+    libspdm_bench_device_t *device;
+    libspdm_attestation_scheduler_t *scheduler;
+    double *device_latency;
+    uint32_t index;
+    uint32_t round;
+    bool result;
+    bool tcp;
+
+    if (!libspdm_bench_suite_is_supported(suite)) {
+        fprintf(stderr, "%s skipped: not supported\n", suite->name);
+        return;
+    }
+    tcp = (m_libspdm_bench_tcp_host_worker_count != 0);
+
+    /* Every device gets a connection and a pooled responder context of its own. */
+    if (tcp && !libspdm_bench_tcp_host_start(suite, m_libspdm_bench_device_count,
+                                             m_libspdm_bench_tcp_host_worker_count)) {
+        fprintf(stderr, "%s skipped: cannot start the tcp host\n", suite->name);
+        m_libspdm_bench_failed = true;
+        return;
+    }
+
+    device = calloc(m_libspdm_bench_device_count, sizeof(*device));
+    device_latency = malloc((size_t)m_libspdm_bench_iterations * m_libspdm_bench_device_count *
+                            sizeof(double));
+    scheduler = libspdm_attestation_scheduler_new(m_libspdm_bench_worker_count);
+    if ((device == NULL) || (device_latency == NULL) || (scheduler == NULL)) {
+        fprintf(stderr, "%s skipped: cannot create the fleet\n", suite->name);
+        m_libspdm_bench_failed = true;
+        goto done;
+    }
+
+    for (index = 0; index < m_libspdm_bench_device_count; index++) {
+        if (tcp) {
+            if (!libspdm_bench_tcp_endpoints_init(suite, &device[index].endpoints)) {
+                fprintf(stderr, "%s skipped: cannot connect to the tcp host\n", suite->name);
+                m_libspdm_bench_failed = true;
+                goto done;
+            }
+        } else {
+            if (!libspdm_bench_endpoints_init(suite, &device[index].endpoints)) {
+                fprintf(stderr, "%s skipped: cannot read the sample certificates\n",
+                        suite->name);
+                goto done;
+            }
+            libspdm_bench_endpoints_set_round_trip_time(&device[index].endpoints,
+                                                        m_libspdm_bench_round_trip_time);
+        }
+        device[index].job.spdm_context = device[index].endpoints.requester_context;
+        device[index].job.steps = LIBSPDM_ATTESTATION_STEP_INIT_CONNECTION |
+                                  LIBSPDM_ATTESTATION_STEP_GET_DIGEST |
+                                  LIBSPDM_ATTESTATION_STEP_GET_CERTIFICATE |
+                                  LIBSPDM_ATTESTATION_STEP_CHALLENGE |
+                                  LIBSPDM_ATTESTATION_STEP_GET_MEASUREMENT |
+                                  LIBSPDM_ATTESTATION_STEP_START_SESSION;
+        device[index].job.measurement_hash_type =
+            SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH;
+        device[index].job.measurement_attribute =
+            SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE;
+        device[index].job.measurement_operation =
+            SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS;
+        device[index].job.cert_chain = device[index].cert_chain;
+        device[index].job.measurement_record = device[index].measurement_record;
+        device[index].job.complete = libspdm_bench_complete_device;
+    }
+
+    /* The private key is loaded by the first signature, before the responders run
+     * concurrently. */
+    if (!libspdm_bench_run_handshake(suite, device[0].endpoints.requester_context, -1)) {
+        m_libspdm_bench_failed = true;
+        goto done;
+    }
+    result = libspdm_bench_run_fleet_round(suite, scheduler, device, device_latency, -1);
+    for (round = 0; result && (round < m_libspdm_bench_iterations); round++) {
+        result = libspdm_bench_run_fleet_round(suite, scheduler, device, device_latency, round);
+    }
+    if (!result) {
+        m_libspdm_bench_failed = true;
+        goto done;
+    }
+
+    libspdm_bench_print_result(suite->name, tcp ? "tcp_fleet_device" : "fleet_device",
+                               device_latency,
+                               (size_t)m_libspdm_bench_iterations * m_libspdm_bench_device_count);
+    libspdm_bench_print_result(suite->name, tcp ? "tcp_fleet" : "fleet",
+                               m_libspdm_bench_latency[0], m_libspdm_bench_iterations);
+
+done:
+    if (scheduler != NULL) {
+        libspdm_attestation_scheduler_free(scheduler);
+    }
+    if (device != NULL) {
+        for (index = 0; index < m_libspdm_bench_device_count; index++) {
+            if (tcp) {
+                libspdm_bench_tcp_endpoints_free(&device[index].endpoints);
+            } else {
+                libspdm_bench_endpoints_free(&device[index].endpoints);
+            }
+        }
+        free(device);
+    }
+    free(device_latency);
+    if (tcp) {
+        libspdm_bench_tcp_host_stop();
+    }
+}
+
+/* Fill the DHE key pair pool of the responders for a suite, if --dhe-key-pool is given. The pool is
+ * refilled in the background, as a Responder would between requests. */
+static void libspdm_bench_dhe_key_pool_start(const libspdm_bench_suite_t *suite)
+{
+    if ((m_libspdm_bench_dhe_key_pool_depth == 0) || (suite->dhe_named_group == 0)) {
+        return;
+    }
+    if (!libspdm_dhe_key_pool_start(suite->dhe_named_group, m_libspdm_bench_dhe_key_pool_depth,
+                                    true)) {
+        fprintf(stderr, "%s: cannot start the dhe key pool\n", suite->name);
+        return;
+    }
+    /* Measure with a full pool, as a Responder that has been idle would have. */
+    libspdm_dhe_key_pool_refill();
+}
+
+static void libspdm_bench_dhe_key_pool_stop(const libspdm_bench_suite_t *suite)
+{
+    libspdm_dhe_key_pool_stats_t stats;
+
+    if ((m_libspdm_bench_dhe_key_pool_depth == 0) || (suite->dhe_named_group == 0)) {
+        return;
+    }
+    libspdm_dhe_key_pool_get_stats(&stats);
+    fprintf(stderr, "%s dhe key pool: %llu hits, %llu misses, %llu generated, %llu failed\n",
+            suite->name,
+            (unsigned long long)stats.hits,
+            (unsigned long long)stats.misses,
+            (unsigned long long)stats.generated,
+            (unsigned long long)stats.failed);
+    libspdm_dhe_key_pool_stop();
+}
+
+static void libspdm_bench_print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [--format json|csv] [--iterations <count>] [--filter <text>]\n"
+            "          [--round-trip-time <us>] [--devices <count> [--workers <count>]]\n"
+            "          [--dhe-key-pool <depth>]\n"
+#if LIBSPDM_BENCH_TCP_HOST
+            "          [--tcp-host <count>]\n"
+#endif /* LIBSPDM_BENCH_TCP_HOST */
+            "  --format           Output format, default json.\n"
+            "  --iterations       Number of measured handshakes per suite, default 100.\n"
+            "  --filter           Only run suites whose name contains <text>.\n"
+            "  --round-trip-time  Time that each message round trip takes, default 0.\n"
+            "  --devices          Attest <count> devices together on the attestation scheduler.\n"
+            "  --workers          Number of scheduler worker threads, default 1.\n"
+            "  --dhe-key-pool     Hand the responders DHE key pairs from a pool of <depth>\n"
+            "                     pairs per suite that is refilled in the background.\n"
+#if LIBSPDM_BENCH_TCP_HOST
+            "  --tcp-host         Connect the devices over 127.0.0.1 to a responder host with\n"
+            "                     <count> worker threads.\n"
+#endif /* LIBSPDM_BENCH_TCP_HOST */
+            "Sample keys are read from the working directory, as for test_spdm_requester.\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    int index;
+    long value;
+    char *end;
+    size_t suite_index;
+
+    for (index = 1; index < argc; index++) {
+        if ((strcmp(argv[index], "--format") == 0) && (index + 1 < argc)) {
+            index++;
+            if (strcmp(argv[index], "json") == 0) {
+                m_libspdm_bench_format = LIBSPDM_BENCH_FORMAT_JSON;
+            } else if (strcmp(argv[index], "csv") == 0) {
+                m_libspdm_bench_format = LIBSPDM_BENCH_FORMAT_CSV;
+            } else {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+        } else if ((strcmp(argv[index], "--iterations") == 0) && (index + 1 < argc)) {
+            index++;
+            value = strtol(argv[index], &end, 10);
+            if ((*end != '\0') || (value <= 0) || (value > 1000000)) {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+            m_libspdm_bench_iterations = (uint32_t)value;
+        } else if ((strcmp(argv[index], "--filter") == 0) && (index + 1 < argc)) {
+            index++;
+            m_libspdm_bench_filter = argv[index];
+        } else if ((strcmp(argv[index], "--round-trip-time") == 0) && (index + 1 < argc)) {
+            index++;
+            value = strtol(argv[index], &end, 10);
+            if ((*end != '\0') || (value < 0) || (value > 1000000)) {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+            m_libspdm_bench_round_trip_time = (uint64_t)value;
+        } else if ((strcmp(argv[index], "--devices") == 0) && (index + 1 < argc)) {
+            index++;
+            value = strtol(argv[index], &end, 10);
+            if ((*end != '\0') || (value <= 0) || (value > 4096)) {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+            m_libspdm_bench_device_count = (uint32_t)value;
+        } else if ((strcmp(argv[index], "--workers") == 0) && (index + 1 < argc)) {
+            index++;
+            value = strtol(argv[index], &end, 10);
+            if ((*end != '\0') || (value <= 0) || (value > 1024)) {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+            m_libspdm_bench_worker_count = (uint32_t)value;
+        } else if ((strcmp(argv[index], "--dhe-key-pool") == 0) && (index + 1 < argc)) {
+            index++;
+            value = strtol(argv[index], &end, 10);
+            if ((*end != '\0') || (value <= 0) || (value > 65536)) {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+            m_libspdm_bench_dhe_key_pool_depth = (uint32_t)value;
+#if LIBSPDM_BENCH_TCP_HOST
+        } else if ((strcmp(argv[index], "--tcp-host") == 0) && (index + 1 < argc)) {
+            index++;
+            value = strtol(argv[index], &end, 10);
+            if ((*end != '\0') || (value <= 0) || (value > 1024)) {
+                libspdm_bench_print_usage(argv[0]);
+                return 2;
+            }
+            m_libspdm_bench_tcp_host_worker_count = (uint32_t)value;
+#endif /* LIBSPDM_BENCH_TCP_HOST */
+        } else {
+            libspdm_bench_print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if ((m_libspdm_bench_tcp_host_worker_count != 0) && (m_libspdm_bench_device_count == 0)) {
+        libspdm_bench_print_usage(argv[0]);
+        return 2;
+    }
+
+    for (index = 0; index <= LIBSPDM_BENCH_PHASE_COUNT; index++) {
+        m_libspdm_bench_latency[index] = malloc(m_libspdm_bench_iterations * sizeof(double));
+        if (m_libspdm_bench_latency[index] == NULL) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+
+    if (m_libspdm_bench_format == LIBSPDM_BENCH_FORMAT_JSON) {
+        printf("{\n  \"backend\": \"%s\",\n  \"iterations\": %u,\n  \"results\": [",
+               LIBSPDM_SPDM_BENCH_BACKEND, m_libspdm_bench_iterations);
+    } else {
+        printf("backend,suite,phase,iterations,mean_us,min_us,p50_us,p90_us,p99_us,max_us,"
+               "ops_per_sec\n");
+    }
+
+    for (suite_index = 0; suite_index < LIBSPDM_ARRAY_SIZE(m_libspdm_bench_suite);
+         suite_index++) {
+        if ((m_libspdm_bench_filter != NULL) &&
+            (strstr(m_libspdm_bench_suite[suite_index].name, m_libspdm_bench_filter) == NULL)) {
+            continue;
+        }
+        libspdm_bench_dhe_key_pool_start(&m_libspdm_bench_suite[suite_index]);
+        if (m_libspdm_bench_device_count != 0) {
+            libspdm_bench_run_fleet(&m_libspdm_bench_suite[suite_index]);
+        } else {
+            libspdm_bench_run_suite(&m_libspdm_bench_suite[suite_index]);
+        }
+        libspdm_bench_dhe_key_pool_stop(&m_libspdm_bench_suite[suite_index]);
+    }
+
+    if (m_libspdm_bench_format == LIBSPDM_BENCH_FORMAT_JSON) {
+        printf("\n  ]\n}\n");
+    }
+
+    for (index = 0; index <= LIBSPDM_BENCH_PHASE_COUNT; index++) {
+        free(m_libspdm_bench_latency[index]);
+    }
+
+    return m_libspdm_bench_failed ? 1 : 0;
+}
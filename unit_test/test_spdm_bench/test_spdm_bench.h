@@ -0,0 +1,183 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __SPDM_BENCH_H__
+#define __SPDM_BENCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hal/base.h"
+#include "library/spdm_requester_lib.h"
+#include "library/spdm_responder_lib.h"
+#include "library/spdm_transport_test_lib.h"
+
+/* The fleet mode over TCP needs the responder host of os_stub/spdm_tcp_responder_host_sample,
+ * which is only built on Linux. */
+#ifndef LIBSPDM_BENCH_TCP_HOST
+#define LIBSPDM_BENCH_TCP_HOST 0
+#endif
+
+/* Largest SPDM message exchanged by the benchmark. It holds a CHALLENGE_AUTH or MEASUREMENTS
+ * response signed with SLH-DSA-SHA2-128s, so that no suite needs chunking. */
+#define LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE 0x3000
+
+#define LIBSPDM_BENCH_BUFFER_SIZE (LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE + \
+                                   LIBSPDM_TEST_TRANSPORT_HEADER_SIZE + \
+                                   LIBSPDM_TEST_TRANSPORT_TAIL_SIZE)
+
+/* The protocol phases of one attestation handshake, in the order they are run. */
+typedef enum {
+    LIBSPDM_BENCH_PHASE_INIT_CONNECTION,
+    LIBSPDM_BENCH_PHASE_GET_DIGEST,
+    LIBSPDM_BENCH_PHASE_GET_CERTIFICATE,
+    LIBSPDM_BENCH_PHASE_CHALLENGE,
+    LIBSPDM_BENCH_PHASE_GET_MEASUREMENT,
+    LIBSPDM_BENCH_PHASE_START_SESSION,
+    LIBSPDM_BENCH_PHASE_STOP_SESSION,
+    LIBSPDM_BENCH_PHASE_COUNT
+} libspdm_bench_phase_t;
+
+/* Algorithms negotiated by both endpoints. Exactly one of base_asym_algo and pqc_asym_algo,
+ * and one of dhe_named_group and kem_alg, is non-zero. */
+typedef struct {
+    const char *name;
+    uint32_t base_asym_algo;
+    uint32_t pqc_asym_algo;
+    uint32_t base_hash_algo;
+    uint32_t measurement_hash_algo;
+    uint16_t dhe_named_group;
+    uint32_t kem_alg;
+    uint16_t aead_cipher_suite;
+} libspdm_bench_suite_t;
+
+/* A requester context and a responder context that are connected back to back. */
+typedef struct {
+    void *requester_context;
+    void *responder_context;
+    void *requester_scratch_buffer;
+    void *responder_scratch_buffer;
+    void *responder_cert_chain;
+    void *root_cert_chain;
+    /* The link between the contexts, in memory or over TCP. */
+    void *link;
+} libspdm_bench_endpoints_t;
+
+/**
+ * Check whether the crypto backend supports every algorithm of a suite.
+ *
+ * @param  suite  The algorithm suite.
+ *
+ * @retval true   The suite can run.
+ * @retval false  At least one algorithm is not compiled in.
+ **/
+bool libspdm_bench_suite_is_supported(const libspdm_bench_suite_t *suite);
+
+/**
+ * Set the local capabilities and algorithms of a suite on a context.
+ *
+ * @param  spdm_context  The context.
+ * @param  suite         The algorithm suite.
+ * @param  is_requester  Whether the context is a requester or a responder.
+ **/
+void libspdm_bench_context_configure(void *spdm_context, const libspdm_bench_suite_t *suite,
+                                     bool is_requester);
+
+/**
+ * Read the responder certificate chain and the root certificate chain of a suite into
+ * endpoints->responder_cert_chain and endpoints->root_cert_chain.
+ *
+ * @param  suite            The algorithm suite.
+ * @param  endpoints        The contexts that the chains belong to.
+ * @param  cert_chain_size  On success, the size of the responder certificate chain.
+ * @param  root_cert        On success, the root certificate inside the root certificate chain.
+ * @param  root_cert_size   On success, the size of the root certificate.
+ *
+ * @retval true   The certificates are read.
+ * @retval false  The sample key directory has no certificate for the suite.
+ **/
+bool libspdm_bench_read_certificates(const libspdm_bench_suite_t *suite,
+                                     libspdm_bench_endpoints_t *endpoints,
+                                     size_t *cert_chain_size, const uint8_t **root_cert,
+                                     size_t *root_cert_size);
+
+/**
+ * Create a requester and a responder context for a suite and connect them through an
+ * in-memory transport that uses the test transport encoding.
+ *
+ * The responder certificate chain and keys are read from the sample key directory, which must be
+ * the working directory.
+ *
+ * @param  suite      The algorithm suite that both endpoints support.
+ * @param  endpoints  On success, the connected contexts.
+ *
+ * @retval true   The contexts are ready for libspdm_init_connection().
+ * @retval false  The contexts could not be created.
+ **/
+bool libspdm_bench_endpoints_init(const libspdm_bench_suite_t *suite,
+                                  libspdm_bench_endpoints_t *endpoints);
+
+/**
+ * Set the time that each request and response round trip takes on the link, as for a device behind
+ * a slow bus. The requester send_message() function sleeps for this time. The default is 0.
+ *
+ * @param  endpoints        The connected contexts.
+ * @param  round_trip_time  Time in microseconds.
+ **/
+void libspdm_bench_endpoints_set_round_trip_time(libspdm_bench_endpoints_t *endpoints,
+                                                 uint64_t round_trip_time);
+
+/**
+ * Free the contexts and buffers created by libspdm_bench_endpoints_init().
+ *
+ * @param  endpoints  The connected contexts.
+ **/
+void libspdm_bench_endpoints_free(libspdm_bench_endpoints_t *endpoints);
+
+/**
+ * Start a responder host of os_stub/spdm_tcp_responder_host_sample on 127.0.0.1 with a free
+ * port. Its event loop runs on a thread of its own, and its contexts serve the suite.
+ *
+ * @param  suite            The algorithm suite.
+ * @param  max_connections  The number of pooled responder contexts.
+ * @param  worker_count     The number of worker threads of the host.
+ *
+ * @retval true   The host is serving.
+ * @retval false  The host could not be started, or LIBSPDM_BENCH_TCP_HOST is 0.
+ **/
+bool libspdm_bench_tcp_host_start(const libspdm_bench_suite_t *suite, size_t max_connections,
+                                  size_t worker_count);
+
+/**
+ * Stop the host started by libspdm_bench_tcp_host_start(), print its counters on stderr and
+ * free it.
+ **/
+void libspdm_bench_tcp_host_stop(void);
+
+/**
+ * Create a requester context for a suite and connect it to the host over TCP. The
+ * responder_context of the endpoints is NULL.
+ *
+ * @param  suite      The algorithm suite of the host.
+ * @param  endpoints  On success, the connected requester context.
+ *
+ * @retval true   The context is ready for libspdm_init_connection().
+ * @retval false  The context could not be created or connected.
+ **/
+bool libspdm_bench_tcp_endpoints_init(const libspdm_bench_suite_t *suite,
+                                      libspdm_bench_endpoints_t *endpoints);
+
+/**
+ * Close the connection and free the context created by libspdm_bench_tcp_endpoints_init().
+ *
+ * @param  endpoints  The connected requester context.
+ **/
+void libspdm_bench_tcp_endpoints_free(libspdm_bench_endpoints_t *endpoints);
+
+#endif
@@ -1554,6 +1554,92 @@ static void libspdm_test_max_session_count_case21(void **state)
     }
 }
 
+/**
+ * Test 23: A session table provided at runtime can hold more than LIBSPDM_MAX_SESSION_COUNT
+ *          sessions, and each session can be found and freed via its session ID.
+ **/
+static void libspdm_test_session_table_case23(void **state)
+{
+    libspdm_return_t status;
+    libspdm_context_t *spdm_context;
+    void *session_table;
+    size_t session_table_size;
+    void **secured_message_contexts;
+    uint32_t *session_ids;
+    size_t session_count;
+    size_t index;
+    uint16_t req_id;
+    uint16_t rsp_id;
+    libspdm_session_info_t *session_info;
+
+    session_count = LIBSPDM_MAX_SESSION_COUNT * 4 + 1;
+
+    spdm_context = (libspdm_context_t *)malloc(libspdm_get_context_size_without_secured_context());
+    session_table_size = libspdm_get_session_table_size(session_count);
+    session_table = malloc(session_table_size);
+    secured_message_contexts = (void **)malloc(sizeof(void *) * session_count);
+    session_ids = (uint32_t *)malloc(sizeof(uint32_t) * session_count);
+    for (index = 0; index < session_count; index++) {
+        secured_message_contexts[index] =
+            (void *)malloc(libspdm_secured_message_get_context_size());
+    }
+
+    status = libspdm_init_context_with_session_table(spdm_context, session_table,
+                                                     session_table_size - 1,
+                                                     secured_message_contexts, session_count);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+
+    status = libspdm_init_context_with_session_table(spdm_context, session_table,
+                                                     session_table_size,
+                                                     secured_message_contexts, session_count);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_ptr_equal(spdm_context->session_info, session_table);
+    assert_int_equal(spdm_context->max_session_count, session_count);
+
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+    spdm_context->connection_info.algorithm.aead_cipher_suite =
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM;
+
+    for (index = 0; index < session_count; index++) {
+        req_id = libspdm_allocate_req_session_id(spdm_context, false);
+        assert_int_not_equal(req_id, INVALID_SESSION_ID & 0xFFFF);
+        rsp_id = libspdm_allocate_rsp_session_id(spdm_context, false);
+        assert_int_not_equal(rsp_id, (INVALID_SESSION_ID & 0xFFFF0000) >> 16);
+
+        session_ids[index] = libspdm_generate_session_id(req_id, rsp_id);
+        session_info = libspdm_assign_session_id(spdm_context, session_ids[index],
+                                                 SECURED_SPDM_VERSION_11 <<
+                                                 SPDM_VERSION_NUMBER_SHIFT_BIT,
+                                                 false);
+        assert_ptr_equal(session_info, &spdm_context->session_info[index]);
+    }
+    rsp_id = libspdm_allocate_rsp_session_id(spdm_context, false);
+    assert_int_equal(rsp_id, (INVALID_SESSION_ID & 0xFFFF0000) >> 16);
+
+    /* Free every other session, the remaining ones must still be found. */
+    for (index = 0; index < session_count; index += 2) {
+        libspdm_free_session_id(spdm_context, session_ids[index]);
+    }
+    for (index = 0; index < session_count; index++) {
+        session_info = libspdm_get_session_info_via_session_id(spdm_context, session_ids[index]);
+        if (index % 2 == 0) {
+            assert_ptr_equal(session_info, NULL);
+        } else {
+            assert_ptr_equal(session_info, &spdm_context->session_info[index]);
+        }
+    }
+
+    libspdm_deinit_context(spdm_context);
+    free(spdm_context);
+    free(session_table);
+    for (index = 0; index < session_count; index++) {
+        free(secured_message_contexts[index]);
+    }
+    free(secured_message_contexts);
+    free(session_ids);
+}
+
 #pragma pack(1)
 
 typedef struct {
@@ -1711,6 +1797,137 @@ static void libspdm_test_process_opaque_data_case22(void **state)
     assert_int_equal (status, true);
 }
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+static bool m_libspdm_peer_cert_chain_acquire_fail;
+static size_t m_libspdm_peer_cert_chain_acquire_count;
+static size_t m_libspdm_peer_cert_chain_release_count;
+static size_t m_libspdm_peer_cert_chain_acquired_size;
+static const void *m_libspdm_peer_cert_chain_released_buffer;
+static uint8_t m_libspdm_peer_cert_chain_released_slot_id;
+
+static libspdm_return_t libspdm_test_acquire_peer_cert_chain_buffer(
+    void *spdm_context, uint8_t slot_id, size_t buffer_size, void **buffer)
+{
+    if (m_libspdm_peer_cert_chain_acquire_fail) {
+        return LIBSPDM_STATUS_ACQUIRE_FAIL;
+    }
+    *buffer = malloc(buffer_size);
+    if (*buffer == NULL) {
+        return LIBSPDM_STATUS_ACQUIRE_FAIL;
+    }
+    m_libspdm_peer_cert_chain_acquire_count++;
+    m_libspdm_peer_cert_chain_acquired_size = buffer_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_test_release_peer_cert_chain_buffer(
+    void *spdm_context, uint8_t slot_id, const void *buffer)
+{
+    m_libspdm_peer_cert_chain_release_count++;
+    m_libspdm_peer_cert_chain_released_buffer = buffer;
+    m_libspdm_peer_cert_chain_released_slot_id = slot_id;
+    free((void *)(size_t)buffer);
+}
+
+/**
+ * Test 24: The peer certificate chains are stored in buffers from the registered functions.
+ * Expected Behavior: A buffer of the exact chain size is acquired for each chain. The previous
+ * buffer of a slot is released when its chain is replaced, when the acquisition fails, and in
+ * libspdm_deinit_context.
+ **/
+static void libspdm_test_peer_cert_chain_buffer_external_case24(void **state)
+{
+    libspdm_return_t status;
+    void *spdm_context;
+    libspdm_data_parameter_t parameter;
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE + 1];
+    const void *cert_chain_buffer;
+    size_t cert_chain_buffer_size;
+    const void *first_buffer;
+
+    m_libspdm_peer_cert_chain_acquire_fail = false;
+    m_libspdm_peer_cert_chain_acquire_count = 0;
+    m_libspdm_peer_cert_chain_release_count = 0;
+
+    spdm_context = (void *)malloc(libspdm_get_context_size());
+    libspdm_init_context(spdm_context);
+    libspdm_register_peer_cert_chain_buffer_func(spdm_context,
+                                                 libspdm_test_acquire_peer_cert_chain_buffer,
+                                                 libspdm_test_release_peer_cert_chain_buffer);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_CONNECTION;
+    parameter.additional_data[0] = 1;
+
+    /* The first chain of the slot acquires a buffer of its exact size. */
+    libspdm_set_mem(cert_chain, sizeof(cert_chain), 0xA5);
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, cert_chain, 100);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_peer_cert_chain_acquire_count, 1);
+    assert_int_equal(m_libspdm_peer_cert_chain_acquired_size, 100);
+    assert_int_equal(m_libspdm_peer_cert_chain_release_count, 0);
+    libspdm_get_peer_cert_chain_buffer(spdm_context, 1, &cert_chain_buffer,
+                                       &cert_chain_buffer_size);
+    assert_int_equal(cert_chain_buffer_size, 100);
+    assert_memory_equal(cert_chain_buffer, cert_chain, 100);
+    first_buffer = cert_chain_buffer;
+
+    /* Replacing the chain releases the previous buffer of the slot. */
+    libspdm_set_mem(cert_chain, sizeof(cert_chain), 0x5A);
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, cert_chain, 200);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_peer_cert_chain_acquire_count, 2);
+    assert_int_equal(m_libspdm_peer_cert_chain_acquired_size, 200);
+    assert_int_equal(m_libspdm_peer_cert_chain_release_count, 1);
+    assert_ptr_equal(m_libspdm_peer_cert_chain_released_buffer, first_buffer);
+    assert_int_equal(m_libspdm_peer_cert_chain_released_slot_id, 1);
+    libspdm_get_peer_cert_chain_buffer(spdm_context, 1, &cert_chain_buffer,
+                                       &cert_chain_buffer_size);
+    assert_int_equal(cert_chain_buffer_size, 200);
+    assert_memory_equal(cert_chain_buffer, cert_chain, 200);
+
+    /* A chain larger than LIBSPDM_MAX_CERT_CHAIN_SIZE is rejected before any buffer changes. */
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, cert_chain, sizeof(cert_chain));
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+    assert_int_equal(m_libspdm_peer_cert_chain_acquire_count, 2);
+    assert_int_equal(m_libspdm_peer_cert_chain_release_count, 1);
+
+    /* A failed acquisition still releases the previous buffer and leaves the slot empty. */
+    m_libspdm_peer_cert_chain_acquire_fail = true;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, cert_chain, 300);
+    assert_int_equal(status, LIBSPDM_STATUS_ACQUIRE_FAIL);
+    assert_int_equal(m_libspdm_peer_cert_chain_acquire_count, 2);
+    assert_int_equal(m_libspdm_peer_cert_chain_release_count, 2);
+    libspdm_get_peer_cert_chain_buffer(spdm_context, 1, &cert_chain_buffer,
+                                       &cert_chain_buffer_size);
+    assert_ptr_equal(cert_chain_buffer, NULL);
+    assert_int_equal(cert_chain_buffer_size, 0);
+    m_libspdm_peer_cert_chain_acquire_fail = false;
+
+    /* libspdm_deinit_context releases the buffers that are still acquired. */
+    parameter.additional_data[0] = 0;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, cert_chain, 100);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    parameter.additional_data[0] = SPDM_MAX_SLOT_COUNT - 1;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, cert_chain, 100);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_peer_cert_chain_acquire_count, 4);
+    assert_int_equal(m_libspdm_peer_cert_chain_release_count, 2);
+
+    libspdm_deinit_context(spdm_context);
+    assert_int_equal(m_libspdm_peer_cert_chain_release_count, 4);
+    assert_int_equal(m_libspdm_peer_cert_chain_released_slot_id, SPDM_MAX_SLOT_COUNT - 1);
+
+    free(spdm_context);
+}
+#endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL */
+
 static libspdm_test_context_t m_libspdm_common_context_data_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     true,
@@ -1762,6 +1979,14 @@ int libspdm_common_context_data_test_main(void)
 
         /* Successful response V1.2 for multi element */
         cmocka_unit_test(libspdm_test_process_opaque_data_case22),
+
+        /* Session table provided at runtime */
+        cmocka_unit_test(libspdm_test_session_table_case23),
+
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT && LIBSPDM_PEER_CERT_CHAIN_BUFFER_EXTERNAL
+        /* Peer certificate chains stored in buffers from the registered functions */
+        cmocka_unit_test(libspdm_test_peer_cert_chain_buffer_external_case24),
+#endif
     };
 
     libspdm_setup_test_context(&m_libspdm_common_context_data_test_context);
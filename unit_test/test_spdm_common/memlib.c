@@ -0,0 +1,163 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+
+/* Widest store of the optimized memlib (AVX2). Every offset below it reaches every misalignment
+ * of the word, SSE2, NEON and AVX2 loops, and lengths up to four times it cover the lengths just
+ * below, at and just above each of those widths and the byte tails that follow them. */
+#define LIBSPDM_TEST_MEMLIB_MAX_ALIGN 32
+#define LIBSPDM_TEST_MEMLIB_MAX_LENGTH (LIBSPDM_TEST_MEMLIB_MAX_ALIGN * 4)
+#define LIBSPDM_TEST_MEMLIB_BUFFER_SIZE \
+    (LIBSPDM_TEST_MEMLIB_MAX_ALIGN + LIBSPDM_TEST_MEMLIB_MAX_LENGTH + LIBSPDM_TEST_MEMLIB_MAX_ALIGN)
+#define LIBSPDM_TEST_MEMLIB_GUARD 0xCC
+
+static void libspdm_test_memlib_fill_pattern(uint8_t *buffer, size_t length)
+{
+    size_t index;
+
+    for (index = 0; index < length; index++) {
+        buffer[index] = (uint8_t)(index * 7 + 1);
+    }
+}
+
+/**
+ * Test 1: Copy between buffers of every relative misalignment.
+ * Expected Behavior: The destination matches a byte-wise copy, and the bytes around it are
+ * untouched.
+ **/
+static void libspdm_test_memlib_copy_mem_case1(void **state)
+{
+    uint8_t src[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    uint8_t dst[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    uint8_t expected[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    size_t src_offset;
+    size_t dst_offset;
+    size_t length;
+    size_t index;
+
+    libspdm_test_memlib_fill_pattern(src, sizeof(src));
+
+    for (src_offset = 0; src_offset < LIBSPDM_TEST_MEMLIB_MAX_ALIGN; src_offset++) {
+        for (dst_offset = 0; dst_offset < LIBSPDM_TEST_MEMLIB_MAX_ALIGN; dst_offset++) {
+            for (length = 0; length <= LIBSPDM_TEST_MEMLIB_MAX_LENGTH; length++) {
+                memset(dst, LIBSPDM_TEST_MEMLIB_GUARD, sizeof(dst));
+                memset(expected, LIBSPDM_TEST_MEMLIB_GUARD, sizeof(expected));
+                for (index = 0; index < length; index++) {
+                    expected[dst_offset + index] = src[src_offset + index];
+                }
+
+                libspdm_copy_mem(dst + dst_offset, sizeof(dst) - dst_offset,
+                                 src + src_offset, length);
+                assert_memory_equal(dst, expected, sizeof(dst));
+            }
+        }
+    }
+}
+
+/**
+ * Test 2: Fill buffers of every misalignment.
+ * Expected Behavior: The buffer matches a byte-wise fill, and the bytes around it are untouched.
+ **/
+static void libspdm_test_memlib_set_mem_case2(void **state)
+{
+    uint8_t buffer[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    uint8_t expected[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    size_t offset;
+    size_t length;
+    size_t index;
+
+    for (offset = 0; offset < LIBSPDM_TEST_MEMLIB_MAX_ALIGN; offset++) {
+        for (length = 0; length <= LIBSPDM_TEST_MEMLIB_MAX_LENGTH; length++) {
+            memset(buffer, LIBSPDM_TEST_MEMLIB_GUARD, sizeof(buffer));
+            memset(expected, LIBSPDM_TEST_MEMLIB_GUARD, sizeof(expected));
+            for (index = 0; index < length; index++) {
+                expected[offset + index] = 0xA5;
+            }
+
+            libspdm_set_mem(buffer + offset, length, 0xA5);
+            assert_memory_equal(buffer, expected, sizeof(buffer));
+        }
+    }
+}
+
+/**
+ * Test 3: Zero buffers of every misalignment.
+ * Expected Behavior: The buffer matches a byte-wise zeroization, and the bytes around it are
+ * untouched.
+ **/
+static void libspdm_test_memlib_zero_mem_case3(void **state)
+{
+    uint8_t buffer[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    uint8_t expected[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    size_t offset;
+    size_t length;
+    size_t index;
+
+    for (offset = 0; offset < LIBSPDM_TEST_MEMLIB_MAX_ALIGN; offset++) {
+        for (length = 0; length <= LIBSPDM_TEST_MEMLIB_MAX_LENGTH; length++) {
+            memset(buffer, LIBSPDM_TEST_MEMLIB_GUARD, sizeof(buffer));
+            memset(expected, LIBSPDM_TEST_MEMLIB_GUARD, sizeof(expected));
+            for (index = 0; index < length; index++) {
+                expected[offset + index] = 0;
+            }
+
+            libspdm_zero_mem(buffer + offset, length);
+            assert_memory_equal(buffer, expected, sizeof(buffer));
+        }
+    }
+}
+
+/**
+ * Test 4: Compare buffers of every relative misalignment.
+ * Expected Behavior: Equal buffers compare equal, and a difference in the first, middle or last
+ * byte is found.
+ **/
+static void libspdm_test_memlib_consttime_is_mem_equal_case4(void **state)
+{
+    uint8_t buffer1[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    uint8_t buffer2[LIBSPDM_TEST_MEMLIB_BUFFER_SIZE];
+    size_t offset1;
+    size_t offset2;
+    size_t length;
+    size_t position[3];
+    size_t index;
+
+    for (offset1 = 0; offset1 < LIBSPDM_TEST_MEMLIB_MAX_ALIGN; offset1++) {
+        for (offset2 = 0; offset2 < LIBSPDM_TEST_MEMLIB_MAX_ALIGN; offset2++) {
+            for (length = 1; length <= LIBSPDM_TEST_MEMLIB_MAX_LENGTH; length++) {
+                libspdm_test_memlib_fill_pattern(buffer1 + offset1, length);
+                libspdm_test_memlib_fill_pattern(buffer2 + offset2, length);
+                assert_true(libspdm_consttime_is_mem_equal(buffer1 + offset1,
+                                                           buffer2 + offset2, length));
+
+                position[0] = 0;
+                position[1] = length / 2;
+                position[2] = length - 1;
+                for (index = 0; index < LIBSPDM_ARRAY_SIZE(position); index++) {
+                    buffer2[offset2 + position[index]] ^= 0x01;
+                    assert_false(libspdm_consttime_is_mem_equal(buffer1 + offset1,
+                                                                buffer2 + offset2, length));
+                    buffer2[offset2 + position[index]] ^= 0x01;
+                }
+            }
+        }
+    }
+}
+
+int libspdm_common_memlib_test_main(void)
+{
+    const struct CMUnitTest spdm_common_memlib_tests[] = {
+        cmocka_unit_test(libspdm_test_memlib_copy_mem_case1),
+        cmocka_unit_test(libspdm_test_memlib_set_mem_case2),
+        cmocka_unit_test(libspdm_test_memlib_zero_mem_case3),
+        cmocka_unit_test(libspdm_test_memlib_consttime_is_mem_equal_case4),
+    };
+
+    return cmocka_run_group_tests(spdm_common_memlib_tests,
+                                  libspdm_unit_test_group_setup,
+                                  libspdm_unit_test_group_teardown);
+}
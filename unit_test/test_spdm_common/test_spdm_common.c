@@ -7,6 +7,7 @@
 
 extern int libspdm_common_context_data_test_main(void);
 extern int libspdm_common_support_test_main(void);
+extern int libspdm_common_memlib_test_main(void);
 
 int main(void)
 {
@@ -20,5 +21,9 @@ int main(void)
         return_value = 1;
     }
 
+    if (libspdm_common_memlib_test_main() != 0) {
+        return_value = 1;
+    }
+
     return return_value;
 }
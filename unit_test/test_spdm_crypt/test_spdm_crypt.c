@@ -1365,6 +1365,48 @@ void libspdm_test_crypt_ecdsa_palindrome(void **state)
     }
 }
 
+void libspdm_test_crypt_hkdf_expand_with_hmac_context(void **state)
+{
+    const uint32_t base_hash_algo = SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+    const size_t out_size[] = { 12, 32, 48, 100 };
+    uint8_t prk[32];
+    uint8_t info[40];
+    uint8_t expected[100];
+    uint8_t actual[100];
+    void *prk_hmac_ctx;
+    size_t index;
+    bool status;
+
+    libspdm_set_mem(prk, sizeof(prk), 0x5A);
+    libspdm_set_mem(info, sizeof(info), 0xA5);
+
+    prk_hmac_ctx = libspdm_hmac_new(base_hash_algo);
+    assert_non_null(prk_hmac_ctx);
+    status = libspdm_hmac_init(base_hash_algo, prk_hmac_ctx, prk, sizeof(prk));
+    assert_true(status);
+
+    /* The keyed context is not consumed, so every size derives from the same template. */
+    for (index = 0; index < LIBSPDM_ARRAY_SIZE(out_size); index++) {
+        status = libspdm_hkdf_expand(base_hash_algo, prk, sizeof(prk), info, sizeof(info),
+                                     expected, out_size[index]);
+        assert_true(status);
+        status = libspdm_hkdf_expand_with_hmac_context(base_hash_algo, prk_hmac_ctx,
+                                                       info, sizeof(info),
+                                                       actual, out_size[index]);
+        assert_true(status);
+        assert_memory_equal(expected, actual, out_size[index]);
+    }
+
+    status = libspdm_hmac_all(base_hash_algo, info, sizeof(info), prk, sizeof(prk), expected);
+    assert_true(status);
+    status = libspdm_hmac_all_with_hmac_context(base_hash_algo, prk_hmac_ctx,
+                                                info, sizeof(info), actual);
+    assert_true(status);
+    assert_memory_equal(expected, actual, 32);
+
+    libspdm_hmac_free(base_hash_algo, prk_hmac_ctx);
+}
+
 int libspdm_crypt_lib_setup(void **state)
 {
     return 0;
@@ -1400,6 +1442,8 @@ int libspdm_crypt_lib_test_main(void)
         cmocka_unit_test(libspdm_test_crypt_rsa_palindrome),
 
         cmocka_unit_test(libspdm_test_crypt_ecdsa_palindrome),
+
+        cmocka_unit_test(libspdm_test_crypt_hkdf_expand_with_hmac_context),
     };
 
     return cmocka_run_group_tests(spdm_crypt_lib_tests,
@@ -0,0 +1,676 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "internal/libspdm_requester_lib.h"
+
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT && LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+
+static uint8_t m_libspdm_async_response[LIBSPDM_RECEIVER_BUFFER_SIZE];
+
+static libspdm_return_t send_message(
+    void *spdm_context, size_t request_size, const void *request, uint64_t timeout)
+{
+    /* The asynchronous API never calls the transport. */
+    assert_true(false);
+    return LIBSPDM_STATUS_SEND_FAIL;
+}
+
+static libspdm_return_t receive_message(
+    void *spdm_context, size_t *response_size, void **response, uint64_t timeout)
+{
+    assert_true(false);
+    return LIBSPDM_STATUS_RECEIVE_FAIL;
+}
+
+static void libspdm_async_test_init_context(libspdm_context_t *spdm_context)
+{
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_10 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    libspdm_reset_message_b(spdm_context);
+}
+
+/* Build a transport message with a DIGESTS response for slot 0. */
+static size_t libspdm_async_test_digests_response(libspdm_context_t *spdm_context, void **message)
+{
+    spdm_digest_response_t *spdm_response;
+    size_t spdm_response_size;
+    size_t transport_message_size;
+    uint8_t *digest;
+
+    spdm_response_size = sizeof(spdm_digest_response_t) +
+                         libspdm_get_hash_size(m_libspdm_use_hash_algo);
+    spdm_response = (void *)(m_libspdm_async_response + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE);
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    spdm_response->header.request_response_code = SPDM_DIGESTS;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0x01;
+    digest = (void *)(spdm_response + 1);
+    libspdm_set_mem(digest, libspdm_get_hash_size(m_libspdm_use_hash_algo), 0xA5);
+
+    *message = m_libspdm_async_response;
+    transport_message_size = sizeof(m_libspdm_async_response);
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          spdm_response_size, spdm_response,
+                                          &transport_message_size, message);
+    return transport_message_size;
+}
+
+/* Return the SPDM request in the message of a NEED_SEND event. */
+static const spdm_message_header_t *libspdm_async_test_request(const libspdm_async_event_t *event)
+{
+    return (const void *)((const uint8_t *)event->message +
+                          sizeof(libspdm_test_message_header_t));
+}
+
+/* Send the request of the current event and receive a response message. */
+static void libspdm_async_test_exchange(libspdm_context_t *spdm_context, size_t message_size,
+                                        void *message)
+{
+    libspdm_return_t status;
+
+    status = libspdm_async_message_sent(spdm_context);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    status = libspdm_async_receive_message(spdm_context, message_size, message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+}
+
+/* Build a transport message with a VERSION response that only supports SPDM 1.0. */
+static size_t libspdm_async_test_version_response(libspdm_context_t *spdm_context,
+                                                  void **message)
+{
+    spdm_version_response_t *spdm_response;
+    spdm_version_number_t *version_number_entry;
+    size_t spdm_response_size;
+    size_t transport_message_size;
+
+    spdm_response_size = sizeof(spdm_version_response_t) + sizeof(spdm_version_number_t);
+    spdm_response = (void *)(m_libspdm_async_response + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE);
+    libspdm_zero_mem(spdm_response, spdm_response_size);
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    spdm_response->header.request_response_code = SPDM_VERSION;
+    spdm_response->version_number_entry_count = 1;
+    version_number_entry = (void *)(spdm_response + 1);
+    *version_number_entry = SPDM_MESSAGE_VERSION_10 << SPDM_VERSION_NUMBER_SHIFT_BIT;
+
+    *message = m_libspdm_async_response;
+    transport_message_size = sizeof(m_libspdm_async_response);
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          spdm_response_size, spdm_response,
+                                          &transport_message_size, message);
+    return transport_message_size;
+}
+
+/* Build a transport message with a CAPABILITIES response. */
+static size_t libspdm_async_test_capabilities_response(libspdm_context_t *spdm_context,
+                                                       void **message)
+{
+    spdm_capabilities_response_t *spdm_response;
+    size_t spdm_response_size;
+    size_t transport_message_size;
+
+    spdm_response_size = sizeof(spdm_capabilities_response_t);
+    spdm_response = (void *)(m_libspdm_async_response + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE);
+    libspdm_zero_mem(spdm_response, spdm_response_size);
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    spdm_response->header.request_response_code = SPDM_CAPABILITIES;
+    spdm_response->ct_exponent = 0;
+    spdm_response->flags = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+                           SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+
+    *message = m_libspdm_async_response;
+    transport_message_size = sizeof(m_libspdm_async_response);
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          spdm_response_size, spdm_response,
+                                          &transport_message_size, message);
+    return transport_message_size;
+}
+
+/* Build a transport message with an ALGORITHMS response. */
+static size_t libspdm_async_test_algorithms_response(libspdm_context_t *spdm_context,
+                                                     void **message)
+{
+    spdm_algorithms_response_t *spdm_response;
+    size_t spdm_response_size;
+    size_t transport_message_size;
+
+    spdm_response_size = sizeof(spdm_algorithms_response_t);
+    spdm_response = (void *)(m_libspdm_async_response + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE);
+    libspdm_zero_mem(spdm_response, spdm_response_size);
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    spdm_response->header.request_response_code = SPDM_ALGORITHMS;
+    spdm_response->length = sizeof(spdm_algorithms_response_t);
+    spdm_response->base_asym_sel = m_libspdm_use_asym_algo;
+    spdm_response->base_hash_sel = m_libspdm_use_hash_algo;
+
+    *message = m_libspdm_async_response;
+    transport_message_size = sizeof(m_libspdm_async_response);
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          spdm_response_size, spdm_response,
+                                          &transport_message_size, message);
+    return transport_message_size;
+}
+
+/* Build a transport message with a CERTIFICATE response that carries the portion of the
+ * certificate chain at the offset of the request. */
+static size_t libspdm_async_test_certificate_response(libspdm_context_t *spdm_context,
+                                                      const uint8_t *cert_chain,
+                                                      size_t cert_chain_size,
+                                                      const libspdm_async_event_t *event,
+                                                      void **message)
+{
+    const spdm_get_certificate_request_t *spdm_request;
+    spdm_certificate_response_t *spdm_response;
+    size_t spdm_response_size;
+    size_t transport_message_size;
+    uint16_t portion_length;
+
+    spdm_request = (const void *)libspdm_async_test_request(event);
+    assert_int_equal(spdm_request->header.request_response_code, SPDM_GET_CERTIFICATE);
+    assert_true(spdm_request->offset < cert_chain_size);
+    portion_length = spdm_request->length;
+    if (portion_length > cert_chain_size - spdm_request->offset) {
+        portion_length = (uint16_t)(cert_chain_size - spdm_request->offset);
+    }
+
+    spdm_response_size = sizeof(spdm_certificate_response_t) + portion_length;
+    spdm_response = (void *)(m_libspdm_async_response + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE);
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    spdm_response->header.request_response_code = SPDM_CERTIFICATE;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0;
+    spdm_response->portion_length = portion_length;
+    spdm_response->remainder_length =
+        (uint16_t)(cert_chain_size - spdm_request->offset - portion_length);
+    libspdm_copy_mem(spdm_response + 1,
+                     sizeof(m_libspdm_async_response) - LIBSPDM_TEST_TRANSPORT_HEADER_SIZE -
+                     sizeof(spdm_certificate_response_t),
+                     cert_chain + spdm_request->offset, portion_length);
+
+    *message = m_libspdm_async_response;
+    transport_message_size = sizeof(m_libspdm_async_response);
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          spdm_response_size, spdm_response,
+                                          &transport_message_size, message);
+    return transport_message_size;
+}
+
+/* Build a transport message with an ERROR response. */
+static size_t libspdm_async_test_error_response(libspdm_context_t *spdm_context,
+                                                uint8_t error_code, void **message)
+{
+    spdm_error_response_t *spdm_response;
+    size_t transport_message_size;
+
+    spdm_response = (void *)(m_libspdm_async_response + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE);
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    spdm_response->header.request_response_code = SPDM_ERROR;
+    spdm_response->header.param1 = error_code;
+    spdm_response->header.param2 = 0;
+
+    *message = m_libspdm_async_response;
+    transport_message_size = sizeof(m_libspdm_async_response);
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          sizeof(spdm_error_response_t), spdm_response,
+                                          &transport_message_size, message);
+    return transport_message_size;
+}
+
+/**
+ * Test 1: GET_DIGESTS is driven to completion through the asynchronous API.
+ * Expected Behavior: the states are NEED_SEND, NEED_RECEIVE and DONE, the status is
+ * LIBSPDM_STATUS_SUCCESS and the digest is returned.
+ **/
+static void req_async_case1(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    uint8_t expected_digest[LIBSPDM_MAX_HASH_SIZE];
+    void *message;
+    size_t message_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x1;
+    libspdm_async_test_init_context(spdm_context);
+
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_IDLE);
+
+    libspdm_zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
+    status = libspdm_get_digest_async(spdm_context, NULL, &slot_mask, total_digest_buffer);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_non_null(event.message);
+    assert_true(event.message_size > sizeof(spdm_get_digest_request_t));
+    assert_int_equal(event.timeout, 0);
+
+    status = libspdm_async_message_sent(spdm_context);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_RECEIVE);
+    assert_int_equal(event.timeout, libspdm_get_response_timeout(spdm_context));
+
+    message_size = libspdm_async_test_digests_response(spdm_context, &message);
+    status = libspdm_async_receive_message(spdm_context, message_size, message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_DONE);
+    assert_int_equal(event.status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(slot_mask, 0x01);
+    libspdm_set_mem(expected_digest, sizeof(expected_digest), 0xA5);
+    assert_memory_equal(total_digest_buffer, expected_digest,
+                        libspdm_get_hash_size(m_libspdm_use_hash_algo));
+}
+
+/**
+ * Test 2: a second request is started while one is in progress, then the request is canceled.
+ * Expected Behavior: the second start returns LIBSPDM_STATUS_INVALID_STATE_LOCAL, the canceled
+ * context is IDLE and can start a new request.
+ **/
+static void req_async_case2(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x2;
+    libspdm_async_test_init_context(spdm_context);
+
+    status = libspdm_get_digest_async(spdm_context, NULL, &slot_mask, total_digest_buffer);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    status = libspdm_get_digest_async(spdm_context, NULL, &slot_mask, total_digest_buffer);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_STATE_LOCAL);
+
+    libspdm_async_cancel(spdm_context);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_IDLE);
+    status = libspdm_async_message_sent(spdm_context);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_STATE_LOCAL);
+
+    status = libspdm_get_digest_async(spdm_context, NULL, &slot_mask, total_digest_buffer);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_async_cancel(spdm_context);
+}
+
+/**
+ * Test 3: the Responder answers BUSY once, then DIGESTS.
+ * Expected Behavior: after BUSY the request is built again and waits retry_delay_time before it
+ * is sent, then the request completes with LIBSPDM_STATUS_SUCCESS.
+ **/
+static void req_async_case3(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    void *message;
+    size_t message_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x3;
+    libspdm_async_test_init_context(spdm_context);
+    spdm_context->retry_times = 1;
+    spdm_context->retry_delay_time = 100;
+
+    status = libspdm_get_digest_async(spdm_context, NULL, &slot_mask, total_digest_buffer);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_async_message_sent(spdm_context);
+    message_size = libspdm_async_test_error_response(spdm_context, SPDM_ERROR_CODE_BUSY,
+                                                     &message);
+    status = libspdm_async_receive_message(spdm_context, message_size, message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(event.timeout, 100);
+
+    libspdm_async_message_sent(spdm_context);
+    message_size = libspdm_async_test_digests_response(spdm_context, &message);
+    status = libspdm_async_receive_message(spdm_context, message_size, message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_DONE);
+    assert_int_equal(event.status, LIBSPDM_STATUS_SUCCESS);
+}
+
+/**
+ * Test 4: the Responder answers BUSY and no retry is left.
+ * Expected Behavior: the request is done with LIBSPDM_STATUS_BUSY_PEER.
+ **/
+static void req_async_case4(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    void *message;
+    size_t message_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x4;
+    libspdm_async_test_init_context(spdm_context);
+    spdm_context->retry_times = 0;
+
+    status = libspdm_get_digest_async(spdm_context, NULL, &slot_mask, total_digest_buffer);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_async_message_sent(spdm_context);
+    message_size = libspdm_async_test_error_response(spdm_context, SPDM_ERROR_CODE_BUSY,
+                                                     &message);
+    status = libspdm_async_receive_message(spdm_context, message_size, message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_DONE);
+    assert_int_equal(event.status, LIBSPDM_STATUS_BUSY_PEER);
+}
+
+/**
+ * Test 5: the connection is set up through the asynchronous API.
+ * Expected Behavior: GET_VERSION, GET_CAPABILITIES and NEGOTIATE_ALGORITHMS are sent in order
+ * without a delay, and the connection is negotiated with LIBSPDM_STATUS_SUCCESS.
+ **/
+static void req_async_case5(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    void *message;
+    size_t message_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x5;
+    spdm_context->local_context.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->local_context.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+
+    status = libspdm_init_connection_async(spdm_context, false);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(libspdm_async_test_request(&event)->request_response_code,
+                     SPDM_GET_VERSION);
+
+    message_size = libspdm_async_test_version_response(spdm_context, &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(event.timeout, 0);
+    assert_int_equal(libspdm_async_test_request(&event)->request_response_code,
+                     SPDM_GET_CAPABILITIES);
+
+    message_size = libspdm_async_test_capabilities_response(spdm_context, &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(libspdm_async_test_request(&event)->request_response_code,
+                     SPDM_NEGOTIATE_ALGORITHMS);
+
+    message_size = libspdm_async_test_algorithms_response(spdm_context, &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_DONE);
+    assert_int_equal(event.status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(spdm_context->connection_info.connection_state,
+                     LIBSPDM_CONNECTION_STATE_NEGOTIATED);
+    assert_int_equal(spdm_context->connection_info.algorithm.base_hash_algo,
+                     m_libspdm_use_hash_algo);
+}
+
+/**
+ * Test 6: a certificate chain that needs several portions is read through the asynchronous API,
+ * and the Responder answers BUSY to the second portion.
+ * Expected Behavior: each portion is requested at the next offset, BUSY starts the chain over
+ * from offset 0 after retry_delay_time, and the verified chain is returned with
+ * LIBSPDM_STATUS_SUCCESS.
+ **/
+static void req_async_case6(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    size_t cert_chain_size;
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+    void *data;
+    size_t data_size;
+    void *hash;
+    size_t hash_size;
+    const uint8_t *root_cert;
+    size_t root_cert_size;
+    void *message;
+    size_t message_size;
+    size_t offset;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x6;
+    libspdm_async_test_init_context(spdm_context);
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->retry_times = 1;
+    spdm_context->retry_delay_time = 100;
+    if (!libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                         m_libspdm_use_asym_algo, &data,
+                                                         &data_size, &hash, &hash_size)) {
+        assert(false);
+    }
+    if (!libspdm_x509_get_cert_from_cert_chain(
+            (uint8_t *)data + sizeof(spdm_cert_chain_t) + hash_size,
+            data_size - sizeof(spdm_cert_chain_t) - hash_size, 0, &root_cert, &root_cert_size)) {
+        assert(false);
+    }
+    assert_true(data_size > LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN);
+    spdm_context->local_context.peer_root_cert_provision_size[0] = root_cert_size;
+    spdm_context->local_context.peer_root_cert_provision[0] = root_cert;
+
+    cert_chain_size = sizeof(cert_chain);
+    libspdm_zero_mem(cert_chain, sizeof(cert_chain));
+    status = libspdm_get_certificate_async(spdm_context, NULL, 0,
+                                           LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN,
+                                           &cert_chain_size, cert_chain, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    libspdm_async_get_event(spdm_context, &event);
+    message_size = libspdm_async_test_certificate_response(spdm_context, data, data_size,
+                                                           &event, &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(event.timeout, 0);
+    assert_int_equal(((const spdm_get_certificate_request_t *)
+                      libspdm_async_test_request(&event))->offset,
+                     LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN);
+
+    message_size = libspdm_async_test_error_response(spdm_context, SPDM_ERROR_CODE_BUSY,
+                                                     &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(event.timeout, 100);
+
+    for (offset = 0; offset < data_size; offset += LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN) {
+        assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+        assert_int_equal(((const spdm_get_certificate_request_t *)
+                          libspdm_async_test_request(&event))->offset, offset);
+        message_size = libspdm_async_test_certificate_response(spdm_context, data, data_size,
+                                                               &event, &message);
+        libspdm_async_test_exchange(spdm_context, message_size, message);
+        libspdm_async_get_event(spdm_context, &event);
+    }
+
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_DONE);
+    assert_int_equal(event.status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(cert_chain_size, data_size);
+    assert_memory_equal(cert_chain, data, data_size);
+
+    spdm_context->local_context.peer_root_cert_provision_size[0] = 0;
+    spdm_context->local_context.peer_root_cert_provision[0] = NULL;
+    free(data);
+}
+
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+/**
+ * Test 7: the Responder answers CHALLENGE with an ERROR response.
+ * Expected Behavior: the request is done with LIBSPDM_STATUS_ERROR_PEER.
+ **/
+static void req_async_case7(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+    void *message;
+    size_t message_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x7;
+    libspdm_async_test_init_context(spdm_context);
+    spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+
+    status = libspdm_challenge_async(spdm_context, 0, NULL,
+                                     SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                     measurement_hash, NULL, NULL, NULL, NULL, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(libspdm_async_test_request(&event)->request_response_code, SPDM_CHALLENGE);
+
+    message_size = libspdm_async_test_error_response(
+        spdm_context, SPDM_ERROR_CODE_UNEXPECTED_REQUEST, &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_DONE);
+    assert_int_equal(event.status, LIBSPDM_STATUS_ERROR_PEER);
+}
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/**
+ * Test 8: a session is started through the asynchronous API, and the Responder answers
+ * KEY_EXCHANGE with BUSY and then with an ERROR response.
+ * Expected Behavior: after BUSY KEY_EXCHANGE is built again with a new key exchange context, and
+ * the ERROR response ends the request with LIBSPDM_STATUS_ERROR_PEER and frees the context.
+ **/
+static void req_async_case8(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_async_event_t event;
+    uint32_t session_id;
+    uint8_t heartbeat_period;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+    void *message;
+    size_t message_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x8;
+    libspdm_async_test_init_context(spdm_context);
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group = m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite = m_libspdm_use_aead_algo;
+    spdm_context->retry_times = 1;
+    spdm_context->retry_delay_time = 100;
+
+    heartbeat_period = 0;
+    status = libspdm_start_session_async(spdm_context,
+                                         SPDM_KEY_EXCHANGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                         0, 0, &session_id, &heartbeat_period,
+                                         measurement_hash);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(libspdm_async_test_request(&event)->request_response_code,
+                     SPDM_KEY_EXCHANGE);
+    assert_non_null(spdm_context->async_context.param.start_session.state.dhe_context);
+
+    message_size = libspdm_async_test_error_response(spdm_context, SPDM_ERROR_CODE_BUSY,
+                                                     &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_NEED_SEND);
+    assert_int_equal(event.timeout, 100);
+    assert_int_equal(libspdm_async_test_request(&event)->request_response_code,
+                     SPDM_KEY_EXCHANGE);
+    assert_non_null(spdm_context->async_context.param.start_session.state.dhe_context);
+
+    message_size = libspdm_async_test_error_response(
+        spdm_context, SPDM_ERROR_CODE_UNEXPECTED_REQUEST, &message);
+    libspdm_async_test_exchange(spdm_context, message_size, message);
+    libspdm_async_get_event(spdm_context, &event);
+    assert_int_equal(event.state, LIBSPDM_ASYNC_STATE_DONE);
+    assert_int_equal(event.status, LIBSPDM_STATUS_ERROR_PEER);
+    assert_null(spdm_context->async_context.param.start_session.state.dhe_context);
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+int libspdm_req_async_test(void)
+{
+    const struct CMUnitTest test_cases[] = {
+        cmocka_unit_test(req_async_case1),
+        cmocka_unit_test(req_async_case2),
+        cmocka_unit_test(req_async_case3),
+        cmocka_unit_test(req_async_case4),
+        cmocka_unit_test(req_async_case5),
+        cmocka_unit_test(req_async_case6),
+#if LIBSPDM_SEND_CHALLENGE_SUPPORT
+        cmocka_unit_test(req_async_case7),
+#endif /* LIBSPDM_SEND_CHALLENGE_SUPPORT */
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+        cmocka_unit_test(req_async_case8),
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+    };
+
+    libspdm_test_context_t test_context = {
+        LIBSPDM_TEST_CONTEXT_VERSION,
+        true,
+        send_message,
+        receive_message,
+    };
+
+    libspdm_setup_test_context(&test_context);
+
+    return cmocka_run_group_tests(test_cases,
+                                  libspdm_unit_test_group_setup,
+                                  libspdm_unit_test_group_teardown);
+}
+
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT && LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
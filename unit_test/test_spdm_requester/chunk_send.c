@@ -145,6 +145,9 @@ static libspdm_return_t send_message(
     if (spdm_test_context->case_id == 15) {
         return LIBSPDM_STATUS_SUCCESS;
     }
+    if (spdm_test_context->case_id == 16) {
+        return LIBSPDM_STATUS_SUCCESS;
+    }
     return LIBSPDM_STATUS_SEND_FAIL;
 }
 
@@ -162,7 +165,7 @@ static libspdm_return_t receive_message(
     spdm_test_context = libspdm_get_test_context();
 
     if ((spdm_test_context->case_id == 1) || (spdm_test_context->case_id == 10) ||
-        (spdm_test_context->case_id == 11)) {
+        (spdm_test_context->case_id == 11) || (spdm_test_context->case_id == 16)) {
         /* Successful chunk send of algorithms request */
         chunk_send_ack_rsp
             = (void*) ((uint8_t*) *response + sizeof(libspdm_test_message_header_t));
@@ -661,6 +664,37 @@ static void req_chunk_send_case15(void** state)
     assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
 }
 
+/**
+ * Test 16: Request Algorithms successfully sent in chunks. The chunks are read from the request
+ * in the sender buffer, so the large message section of the scratch buffer only receives the
+ * response.
+ * Expected behavior: returns LIBSPDM_STATUS_SUCCESS, and the large message section past the
+ * response is left as it was.
+ **/
+static void req_chunk_send_case16(void** state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t* spdm_test_context;
+    libspdm_context_t* spdm_context;
+    uint8_t* scratch_buffer;
+    size_t scratch_buffer_size;
+    uint8_t* large_message;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+
+    libspdm_get_scratch_buffer(spdm_context, (void **)&scratch_buffer, &scratch_buffer_size);
+    large_message = scratch_buffer + libspdm_get_scratch_buffer_large_message_offset(spdm_context);
+    libspdm_set_mem(large_message,
+                    libspdm_get_scratch_buffer_large_message_capacity(spdm_context), 0x5A);
+
+    status = libspdm_test_requester_chunk_send_generic_test_case(state, 16);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    /* A copy of the request would have overwritten this byte. */
+    assert_int_equal(large_message[spdm_context->last_spdm_request_size - 1], 0x5A);
+}
+
 int libspdm_req_chunk_send_test(void)
 {
     /* Test the CHUNK_SEND handlers in various requester handlers */
@@ -697,6 +731,8 @@ int libspdm_req_chunk_send_test(void)
         cmocka_unit_test(req_chunk_send_case14),
         /* Request Algorithms successfully sent in chunks, with SPDM 1.4 */
         cmocka_unit_test(req_chunk_send_case15),
+        /* Request Algorithms sent in chunks without copying the request */
+        cmocka_unit_test(req_chunk_send_case16),
     };
 
     libspdm_test_context_t test_context = {
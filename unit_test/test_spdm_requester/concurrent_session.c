@@ -0,0 +1,581 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "internal/libspdm_requester_lib.h"
+#include "internal/libspdm_secured_message_lib.h"
+
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0 0xFFFFFFFF
+#define LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_1 0xFFFEFFFE
+
+/* The first byte is neither LIBSPDM_TEST_MESSAGE_TYPE_SPDM nor
+ * LIBSPDM_TEST_MESSAGE_TYPE_SECURED_TEST, so the decoded message is an APP message. */
+#define LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_TYPE 0x7F
+#define LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE 16
+
+/* The state of the emulated Responder, per entry of the session table. */
+static uint8_t m_libspdm_concurrent_session_response
+[LIBSPDM_MAX_SESSION_COUNT][LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+static size_t m_libspdm_concurrent_session_send_count[LIBSPDM_MAX_SESSION_COUNT];
+static size_t m_libspdm_concurrent_session_receive_count[LIBSPDM_MAX_SESSION_COUNT];
+/* If not 0, the response with this number, counted from 1, fails to decrypt. */
+static size_t m_libspdm_concurrent_session_corrupt_response[LIBSPDM_MAX_SESSION_COUNT];
+
+/* If set, the exchange of that session runs while the first request waits for its response. */
+static const uint32_t *m_libspdm_concurrent_session_interleaved_session_id;
+static libspdm_return_t m_libspdm_concurrent_session_interleaved_status;
+
+static size_t libspdm_concurrent_session_test_get_index(libspdm_context_t *spdm_context,
+                                                        uint32_t session_id)
+{
+    libspdm_session_info_t *session_info;
+
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, session_id);
+    assert_non_null(session_info);
+    return (size_t)(session_info - spdm_context->session_info);
+}
+
+/* Check whether the message lies in the area of the session in the scratch buffer. */
+static bool libspdm_concurrent_session_test_is_in_area(libspdm_context_t *spdm_context,
+                                                       size_t session_index,
+                                                       const void *message, size_t message_size)
+{
+    uint8_t *scratch_buffer;
+    size_t scratch_buffer_size;
+    const uint8_t *area;
+    size_t area_size;
+
+    libspdm_get_scratch_buffer(spdm_context, (void **)&scratch_buffer, &scratch_buffer_size);
+    area = scratch_buffer +
+           libspdm_get_scratch_buffer_session_message_offset(spdm_context, session_index);
+    area_size = libspdm_get_scratch_buffer_session_message_capacity(spdm_context);
+
+    return ((const uint8_t *)message >= area) &&
+           ((const uint8_t *)message + message_size <= area + area_size);
+}
+
+/* Decrypt the request of the emulated Responder, and build the response, which echoes the
+ * request with the index of the session in the table. */
+static void libspdm_concurrent_session_test_build_response(libspdm_context_t *spdm_context,
+                                                           size_t session_index,
+                                                           size_t request_size,
+                                                           const void *request)
+{
+    libspdm_return_t status;
+    uint32_t *session_id;
+    bool is_app_message;
+    uint8_t *app_message;
+    size_t app_message_size;
+    uint8_t decode_buffer[LIBSPDM_MAX_SENDER_RECEIVER_BUFFER_SIZE];
+    uint8_t transport_message[LIBSPDM_MAX_SENDER_RECEIVER_BUFFER_SIZE];
+    libspdm_session_info_t *session_info;
+    libspdm_secured_message_context_t *secured_message_context;
+
+    /* WALKAROUND: If just use single context to encode message and then decode message */
+    session_info = &spdm_context->session_info[session_index];
+    secured_message_context = session_info->secured_message_context;
+    secured_message_context->application_secret.request_data_sequence_number--;
+
+    libspdm_copy_mem(transport_message, sizeof(transport_message), request, request_size);
+    app_message = decode_buffer;
+    app_message_size = sizeof(decode_buffer);
+    status = libspdm_transport_test_decode_message(spdm_context, &session_id, &is_app_message,
+                                                   true, request_size, transport_message,
+                                                   &app_message_size, (void **)&app_message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_true(is_app_message);
+    assert_int_equal(libspdm_concurrent_session_test_get_index(spdm_context, *session_id),
+                     session_index);
+
+    assert_int_equal(app_message_size, LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE);
+    libspdm_copy_mem(m_libspdm_concurrent_session_response[session_index],
+                     sizeof(m_libspdm_concurrent_session_response[session_index]),
+                     app_message, app_message_size);
+    m_libspdm_concurrent_session_response[session_index][1] = (uint8_t)session_index;
+}
+
+static void libspdm_concurrent_session_test_build_request(uint8_t *request, uint8_t fill)
+{
+    libspdm_set_mem(request, LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE, fill);
+    request[0] = LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_TYPE;
+}
+
+static libspdm_return_t send_message(
+    void *spdm_context, size_t request_size, const void *request, uint64_t timeout)
+{
+    size_t session_index;
+    uint8_t request_copy[LIBSPDM_MAX_SENDER_RECEIVER_BUFFER_SIZE];
+    uint8_t app_request[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    uint8_t response[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    size_t response_size;
+    const uint32_t *interleaved_session_id;
+
+    /* The test transport header is followed by the session ID of the secured message. */
+    session_index = libspdm_concurrent_session_test_get_index(
+        spdm_context, libspdm_read_uint32((const uint8_t *)request +
+                                          sizeof(libspdm_test_message_header_t)));
+    assert_true(libspdm_concurrent_session_test_is_in_area(spdm_context, session_index,
+                                                           request, request_size));
+    m_libspdm_concurrent_session_send_count[session_index]++;
+
+    if (m_libspdm_concurrent_session_interleaved_session_id != NULL) {
+        /* Another session runs a full exchange while this request is in flight. */
+        interleaved_session_id = m_libspdm_concurrent_session_interleaved_session_id;
+        m_libspdm_concurrent_session_interleaved_session_id = NULL;
+        libspdm_copy_mem(request_copy, sizeof(request_copy), request, request_size);
+        libspdm_concurrent_session_test_build_request(app_request, 0x44);
+        libspdm_set_mem(response, sizeof(response), 0);
+        response_size = sizeof(response);
+        m_libspdm_concurrent_session_interleaved_status = libspdm_send_receive_data(
+            spdm_context, interleaved_session_id, true, app_request, sizeof(app_request),
+            response, &response_size);
+        assert_int_equal(response_size, sizeof(response));
+        assert_int_equal(response[1], libspdm_concurrent_session_test_get_index(
+                             spdm_context, *interleaved_session_id));
+        assert_int_equal(response[2], 0x44);
+        /* The request of this session is left untouched. */
+        assert_memory_equal(request_copy, request, request_size);
+    }
+
+    libspdm_concurrent_session_test_build_response(spdm_context, session_index,
+                                                   request_size, request);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t receive_message(
+    void *spdm_context, size_t *response_size, void **response, uint64_t timeout)
+{
+    libspdm_context_t *context;
+    libspdm_return_t status;
+    uint32_t session_id;
+    size_t session_index;
+    libspdm_session_info_t *session_info;
+    libspdm_secured_message_context_t *secured_message_context;
+    uint8_t app_message[LIBSPDM_TEST_TRANSPORT_HEADER_SIZE +
+                        LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE +
+                        LIBSPDM_TEST_TRANSPORT_TAIL_SIZE];
+
+    /* The response is received in the area of the session that sent the request. */
+    context = spdm_context;
+    for (session_index = 0; session_index < context->max_session_count; session_index++) {
+        if (libspdm_concurrent_session_test_is_in_area(context, session_index,
+                                                       *response, *response_size)) {
+            break;
+        }
+    }
+    assert_true(session_index < context->max_session_count);
+    session_info = &context->session_info[session_index];
+    session_id = session_info->session_id;
+
+    /* The APP message is encoded in place, with its header before it and padding after it. */
+    libspdm_copy_mem(app_message + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE,
+                     sizeof(app_message) - LIBSPDM_TEST_TRANSPORT_HEADER_SIZE,
+                     m_libspdm_concurrent_session_response[session_index],
+                     LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE);
+    status = libspdm_transport_test_encode_message(
+        spdm_context, &session_id, true, false,
+        LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE,
+        app_message + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE, response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    m_libspdm_concurrent_session_receive_count[session_index]++;
+    if (m_libspdm_concurrent_session_receive_count[session_index] ==
+        m_libspdm_concurrent_session_corrupt_response[session_index]) {
+        /* Flip the first byte of the cipher text. */
+        ((uint8_t *)*response)[sizeof(libspdm_test_message_header_t) +
+                               sizeof(spdm_secured_message_a_data_header1_t) +
+                               LIBSPDM_TEST_SEQUENCE_NUMBER_COUNT +
+                               sizeof(spdm_secured_message_a_data_header2_t)] ^= 0xFF;
+    }
+
+    /* WALKAROUND: If just use single context to encode message and then decode message */
+    secured_message_context = session_info->secured_message_context;
+    secured_message_context->application_secret.response_data_sequence_number--;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Set up a negotiated connection with an established session in the first and in the last entry
+ * of the session table. */
+static void libspdm_concurrent_session_test_init_context(libspdm_context_t *spdm_context)
+{
+    libspdm_session_info_t *session_info;
+
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group = m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite = m_libspdm_use_aead_algo;
+
+    session_info = &spdm_context->session_info[0];
+    libspdm_session_info_init(spdm_context, session_info,
+                              LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0,
+                              SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT, false);
+    libspdm_secured_message_set_session_state(session_info->secured_message_context,
+                                              LIBSPDM_SESSION_STATE_ESTABLISHED);
+
+    session_info = &spdm_context->session_info[spdm_context->max_session_count - 1];
+    libspdm_session_info_init(spdm_context, session_info,
+                              LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_1,
+                              SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT, false);
+    libspdm_secured_message_set_session_state(session_info->secured_message_context,
+                                              LIBSPDM_SESSION_STATE_ESTABLISHED);
+
+    libspdm_zero_mem(m_libspdm_concurrent_session_send_count,
+                     sizeof(m_libspdm_concurrent_session_send_count));
+    libspdm_zero_mem(m_libspdm_concurrent_session_receive_count,
+                     sizeof(m_libspdm_concurrent_session_receive_count));
+    libspdm_zero_mem(m_libspdm_concurrent_session_corrupt_response,
+                     sizeof(m_libspdm_concurrent_session_corrupt_response));
+    m_libspdm_concurrent_session_interleaved_session_id = NULL;
+    m_libspdm_concurrent_session_interleaved_status = LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_concurrent_session_test_free_context(libspdm_context_t *spdm_context)
+{
+    libspdm_session_info_init(spdm_context, &spdm_context->session_info[0],
+                              INVALID_SESSION_ID,
+                              SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT, false);
+    libspdm_session_info_init(spdm_context,
+                              &spdm_context->session_info[spdm_context->max_session_count - 1],
+                              INVALID_SESSION_ID,
+                              SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT, false);
+}
+
+/**
+ * Test 1: An APP message of the session in the last entry of the session table is encoded and
+ * decoded in the area of that session, at the end of the scratch buffer.
+ * Expected Behavior: the response is returned, and the sender and receiver buffers are not used.
+ **/
+static void req_concurrent_session_case1(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    uint32_t session_id;
+    uint8_t request[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    uint8_t response[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    size_t response_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_concurrent_session_test_init_context(spdm_context);
+
+    libspdm_force_error(LIBSPDM_ERR_ACQUIRE_SENDER_BUFFER);
+    libspdm_force_error(LIBSPDM_ERR_ACQUIRE_RECEIVER_BUFFER);
+
+    session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_1;
+    libspdm_concurrent_session_test_build_request(request, 0x11);
+    response_size = sizeof(response);
+    status = libspdm_send_receive_data(spdm_context, &session_id, true,
+                                       request, sizeof(request), response, &response_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(response_size, sizeof(response));
+    assert_int_equal(response[0], LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_TYPE);
+    assert_int_equal(response[1], spdm_context->max_session_count - 1);
+    assert_int_equal(response[2], 0x11);
+
+    libspdm_release_error(LIBSPDM_ERR_ACQUIRE_SENDER_BUFFER);
+    libspdm_release_error(LIBSPDM_ERR_ACQUIRE_RECEIVER_BUFFER);
+    libspdm_concurrent_session_test_free_context(spdm_context);
+}
+
+/**
+ * Test 2: The exchange of a second session runs between the request and the response of the
+ * first session.
+ * Expected Behavior: both sessions get their own response, and the request of the first session
+ * is not overwritten.
+ **/
+static void req_concurrent_session_case2(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    uint32_t session_id;
+    uint32_t interleaved_session_id;
+    uint8_t request[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    uint8_t response[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    size_t response_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_concurrent_session_test_init_context(spdm_context);
+
+    interleaved_session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_1;
+    m_libspdm_concurrent_session_interleaved_session_id = &interleaved_session_id;
+
+    session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0;
+    libspdm_concurrent_session_test_build_request(request, 0x22);
+    response_size = sizeof(response);
+    status = libspdm_send_receive_data(spdm_context, &session_id, true,
+                                       request, sizeof(request), response, &response_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_concurrent_session_interleaved_status, LIBSPDM_STATUS_SUCCESS);
+    assert_null(m_libspdm_concurrent_session_interleaved_session_id);
+    assert_int_equal(response_size, sizeof(response));
+    assert_int_equal(response[1], 0);
+    assert_int_equal(response[2], 0x22);
+
+    libspdm_concurrent_session_test_free_context(spdm_context);
+}
+
+/**
+ * Test 3: The session is unknown, the request does not fit in the area of the session, or the
+ * scratch buffer does not hold the area of the session.
+ * Expected Behavior: LIBSPDM_STATUS_INVALID_PARAMETER, and nothing is sent.
+ **/
+static void req_concurrent_session_case3(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    uint32_t session_id;
+    uint8_t request[LIBSPDM_MAX_SPDM_MSG_SIZE + LIBSPDM_TEST_TRANSPORT_HEADER_SIZE +
+                    LIBSPDM_TEST_TRANSPORT_TAIL_SIZE];
+    uint8_t response[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    size_t response_size;
+    size_t scratch_buffer_size;
+    size_t session_index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_concurrent_session_test_init_context(spdm_context);
+    libspdm_concurrent_session_test_build_request(request, 0x33);
+
+    session_id = 0x12345678;
+    response_size = sizeof(response);
+    status = libspdm_send_receive_data(spdm_context, &session_id, true,
+                                       request, LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE,
+                                       response, &response_size);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+
+    session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0;
+    response_size = sizeof(response);
+    status = libspdm_send_receive_data(
+        spdm_context, &session_id, true, request,
+        libspdm_get_scratch_buffer_session_message_capacity(spdm_context) / 2,
+        response, &response_size);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+
+    /* The scratch buffer ends before the area of the last entry of the session table. */
+    session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_1;
+    session_index = spdm_context->max_session_count - 1;
+    scratch_buffer_size = spdm_context->scratch_buffer_size;
+    spdm_context->scratch_buffer_size =
+        libspdm_get_scratch_buffer_session_message_offset(spdm_context, session_index) +
+        libspdm_get_scratch_buffer_session_message_capacity(spdm_context) - 1;
+    response_size = sizeof(response);
+    status = libspdm_send_receive_data(spdm_context, &session_id, true,
+                                       request, LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE,
+                                       response, &response_size);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+    spdm_context->scratch_buffer_size = scratch_buffer_size;
+
+    for (session_index = 0; session_index < spdm_context->max_session_count; session_index++) {
+        assert_int_equal(m_libspdm_concurrent_session_send_count[session_index], 0);
+    }
+
+    libspdm_concurrent_session_test_free_context(spdm_context);
+}
+
+#if (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) || (LIBSPDM_ENABLE_CAPABILITY_PSK_CAP)
+#define LIBSPDM_CONCURRENT_SESSION_TEST_THREAD_EXCHANGE_COUNT 64
+#define LIBSPDM_CONCURRENT_SESSION_TEST_CORRUPT_RESPONSE 10
+
+/* The APP messages of one session, sent by one thread. The results are checked by the main
+ * thread, after the thread returned. */
+typedef struct {
+    libspdm_context_t *spdm_context;
+    uint32_t session_id;
+    size_t session_index;
+    size_t exchange_count;
+    libspdm_return_t status;
+    bool response_matched;
+} libspdm_concurrent_session_test_thread_t;
+
+static void libspdm_concurrent_session_test_run_thread(
+    libspdm_concurrent_session_test_thread_t *thread)
+{
+    uint8_t request[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    uint8_t response[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    size_t response_size;
+
+    thread->status = LIBSPDM_STATUS_SUCCESS;
+    thread->response_matched = true;
+    for (thread->exchange_count = 0;
+         thread->exchange_count < LIBSPDM_CONCURRENT_SESSION_TEST_THREAD_EXCHANGE_COUNT;
+         thread->exchange_count++) {
+        libspdm_concurrent_session_test_build_request(request, (uint8_t)thread->exchange_count);
+        libspdm_set_mem(response, sizeof(response), 0);
+        response_size = sizeof(response);
+        thread->status = libspdm_send_receive_data(thread->spdm_context, &thread->session_id,
+                                                   true, request, sizeof(request),
+                                                   response, &response_size);
+        if (LIBSPDM_STATUS_IS_ERROR(thread->status)) {
+            break;
+        }
+        if ((response_size != sizeof(response)) ||
+            (response[1] != (uint8_t)thread->session_index) ||
+            (response[2] != (uint8_t)thread->exchange_count)) {
+            thread->response_matched = false;
+        }
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI libspdm_concurrent_session_test_thread(LPVOID parameter)
+{
+    libspdm_concurrent_session_test_run_thread(parameter);
+    return 0;
+}
+#else
+static void *libspdm_concurrent_session_test_thread(void *parameter)
+{
+    libspdm_concurrent_session_test_run_thread(parameter);
+    return NULL;
+}
+#endif
+
+/**
+ * Test 4: Two threads exchange APP messages of their own session at the same time, and one
+ * response of the first session fails to decrypt.
+ * Expected Behavior: the first session gets LIBSPDM_STATUS_SESSION_MSG_ERROR and ends, while the
+ * second session completes all its exchanges. The ended session stays in the session table, is
+ * refused without sending, and is freed by libspdm_stop_session without END_SESSION.
+ **/
+static void req_concurrent_session_case4(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    uint32_t session_id;
+    libspdm_session_info_t *session_info;
+    libspdm_concurrent_session_test_thread_t thread[2];
+    uint8_t request[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    uint8_t response[LIBSPDM_CONCURRENT_SESSION_TEST_APP_MESSAGE_SIZE];
+    size_t response_size;
+    size_t index;
+#if defined(_WIN32)
+    HANDLE thread_handle[2];
+#else
+    pthread_t thread_handle[2];
+#endif
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_concurrent_session_test_init_context(spdm_context);
+
+    libspdm_zero_mem(thread, sizeof(thread));
+    thread[0].session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0;
+    thread[0].session_index = 0;
+    thread[1].session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_1;
+    thread[1].session_index = spdm_context->max_session_count - 1;
+    m_libspdm_concurrent_session_corrupt_response[0] =
+        LIBSPDM_CONCURRENT_SESSION_TEST_CORRUPT_RESPONSE;
+
+    for (index = 0; index < LIBSPDM_ARRAY_SIZE(thread); index++) {
+        thread[index].spdm_context = spdm_context;
+#if defined(_WIN32)
+        thread_handle[index] = CreateThread(NULL, 0, libspdm_concurrent_session_test_thread,
+                                            &thread[index], 0, NULL);
+        assert_non_null(thread_handle[index]);
+#else
+        assert_int_equal(pthread_create(&thread_handle[index], NULL,
+                                        libspdm_concurrent_session_test_thread,
+                                        &thread[index]), 0);
+#endif
+    }
+    for (index = 0; index < LIBSPDM_ARRAY_SIZE(thread); index++) {
+#if defined(_WIN32)
+        WaitForSingleObject(thread_handle[index], INFINITE);
+        CloseHandle(thread_handle[index]);
+#else
+        pthread_join(thread_handle[index], NULL);
+#endif
+    }
+
+    assert_int_equal(thread[0].status, LIBSPDM_STATUS_SESSION_MSG_ERROR);
+    assert_int_equal(thread[0].exchange_count,
+                     LIBSPDM_CONCURRENT_SESSION_TEST_CORRUPT_RESPONSE - 1);
+    assert_true(thread[0].response_matched);
+    assert_int_equal(thread[1].status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(thread[1].exchange_count,
+                     LIBSPDM_CONCURRENT_SESSION_TEST_THREAD_EXCHANGE_COUNT);
+    assert_true(thread[1].response_matched);
+
+    /* The ended session is kept until libspdm_stop_session. */
+    session_info = libspdm_get_session_info_via_session_id(
+        spdm_context, LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0);
+    assert_non_null(session_info);
+    assert_true(session_info->free_pending);
+    session_info = libspdm_get_session_info_via_session_id(
+        spdm_context, LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_1);
+    assert_non_null(session_info);
+    assert_false(session_info->free_pending);
+
+    session_id = LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0;
+    libspdm_concurrent_session_test_build_request(request, 0x44);
+    response_size = sizeof(response);
+    status = libspdm_send_receive_data(spdm_context, &session_id, true,
+                                       request, sizeof(request), response, &response_size);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_STATE_LOCAL);
+    assert_int_equal(m_libspdm_concurrent_session_send_count[0],
+                     LIBSPDM_CONCURRENT_SESSION_TEST_CORRUPT_RESPONSE);
+
+    status = libspdm_stop_session(spdm_context, LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0, 0);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_concurrent_session_send_count[0],
+                     LIBSPDM_CONCURRENT_SESSION_TEST_CORRUPT_RESPONSE);
+    assert_null(libspdm_get_session_info_via_session_id(
+                    spdm_context, LIBSPDM_CONCURRENT_SESSION_TEST_SESSION_ID_0));
+
+    libspdm_concurrent_session_test_free_context(spdm_context);
+}
+#endif /* (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) || (LIBSPDM_ENABLE_CAPABILITY_PSK_CAP) */
+
+int libspdm_req_concurrent_session_test(void)
+{
+    const struct CMUnitTest test_cases[] = {
+        cmocka_unit_test(req_concurrent_session_case1),
+        cmocka_unit_test(req_concurrent_session_case2),
+        cmocka_unit_test(req_concurrent_session_case3),
+#if (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) || (LIBSPDM_ENABLE_CAPABILITY_PSK_CAP)
+        cmocka_unit_test(req_concurrent_session_case4),
+#endif /* (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) || (LIBSPDM_ENABLE_CAPABILITY_PSK_CAP) */
+    };
+
+    libspdm_test_context_t test_context = {
+        LIBSPDM_TEST_CONTEXT_VERSION,
+        true,
+        send_message,
+        receive_message,
+    };
+
+    libspdm_setup_test_context(&test_context);
+
+    return cmocka_run_group_tests(test_cases,
+                                  libspdm_unit_test_group_setup,
+                                  libspdm_unit_test_group_teardown);
+}
+
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
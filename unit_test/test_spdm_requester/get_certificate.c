@@ -24,6 +24,9 @@ static uint8_t m_slot_id;
 
 static size_t m_calling_index;
 
+static uint16_t m_get_cert_offset;
+static uint16_t m_get_cert_length;
+static uint16_t m_max_get_cert_length;
 
 /* Loading the target expiration certificate chain and saving root certificate hash
  * "rsa3072_Expiration/bundle_responder.certchain.der"*/
@@ -185,6 +188,18 @@ static libspdm_return_t send_message(
     case 0x20:
     case 0x21:
         return LIBSPDM_STATUS_SUCCESS;
+    case 0x22: {
+        const spdm_get_certificate_request_t *spdm_request;
+
+        spdm_request = (const void *)((const uint8_t *)request +
+                                      sizeof(libspdm_test_message_header_t));
+        m_get_cert_offset = spdm_request->offset;
+        m_get_cert_length = spdm_request->length;
+        if (m_get_cert_length > m_max_get_cert_length) {
+            m_max_get_cert_length = m_get_cert_length;
+        }
+    }
+        return LIBSPDM_STATUS_SUCCESS;
     default:
         return LIBSPDM_STATUS_SEND_FAIL;
     }
@@ -2348,6 +2363,55 @@ static libspdm_return_t receive_message(
                                               response);
     }
         return LIBSPDM_STATUS_SUCCESS;
+    case 0x22: {
+        spdm_certificate_response_t *spdm_response;
+        size_t spdm_response_size;
+        size_t transport_header_size;
+        uint16_t portion_length;
+
+        if (m_get_cert_offset == 0) {
+            free(m_libspdm_local_certificate_chain);
+            libspdm_read_responder_public_certificate_chain(
+                m_libspdm_use_hash_algo, m_libspdm_use_asym_algo,
+                &m_libspdm_local_certificate_chain,
+                &m_libspdm_local_certificate_chain_size, NULL, NULL);
+        }
+        if ((m_libspdm_local_certificate_chain == NULL) ||
+            (m_get_cert_offset >= m_libspdm_local_certificate_chain_size)) {
+            return LIBSPDM_STATUS_RECEIVE_FAIL;
+        }
+        portion_length = (uint16_t)LIBSPDM_MIN(
+            m_get_cert_length, m_libspdm_local_certificate_chain_size - m_get_cert_offset);
+
+        spdm_response_size = sizeof(spdm_certificate_response_t) + portion_length;
+        transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
+        spdm_response = (void *)((uint8_t *)*response + transport_header_size);
+
+        spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+        spdm_response->header.request_response_code = SPDM_CERTIFICATE;
+        spdm_response->header.param1 = 0;
+        spdm_response->header.param2 = 0;
+        spdm_response->portion_length = portion_length;
+        spdm_response->remainder_length =
+            (uint16_t)(m_libspdm_local_certificate_chain_size - m_get_cert_offset -
+                       portion_length);
+        libspdm_copy_mem(spdm_response + 1,
+                         (size_t)(*response) + *response_size - (size_t)(spdm_response + 1),
+                         (uint8_t *)m_libspdm_local_certificate_chain + m_get_cert_offset,
+                         portion_length);
+
+        libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                              false, spdm_response_size,
+                                              spdm_response, response_size,
+                                              response);
+
+        if (spdm_response->remainder_length == 0) {
+            free(m_libspdm_local_certificate_chain);
+            m_libspdm_local_certificate_chain = NULL;
+            m_libspdm_local_certificate_chain_size = 0;
+        }
+    }
+        return LIBSPDM_STATUS_SUCCESS;
     default:
         return LIBSPDM_STATUS_RECEIVE_FAIL;
     }
@@ -4722,6 +4786,82 @@ static void req_get_certificate_case33(void **state)
     assert_int_equal(status, LIBSPDM_STATUS_INVALID_MSG_FIELD);
 }
 
+/**
+ * Test 34: Normal case, request the certificate chain with portions that fit in DataTransferSize.
+ * Expected Behavior: receives the correct certificate chain without any request exceeding
+ * DataTransferSize.
+ **/
+static void req_get_certificate_case34(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_data_parameter_t parameter;
+    size_t cert_chain_size;
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+    void *data;
+    size_t data_size;
+    void *hash;
+    size_t hash_size;
+    const uint8_t *root_cert;
+    size_t root_cert_size;
+    uint32_t data_transfer_size;
+    bool portion_within_data_transfer_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x22;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_10 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AFTER_DIGESTS;
+    spdm_context->connection_info.capability.flags =
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+    if (!libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                         m_libspdm_use_asym_algo, &data,
+                                                         &data_size, &hash, &hash_size)) {
+        assert(false);
+    }
+    if (!libspdm_x509_get_cert_from_cert_chain(
+            (uint8_t *)data + sizeof(spdm_cert_chain_t) + hash_size,
+            data_size - sizeof(spdm_cert_chain_t) - hash_size, 0, &root_cert, &root_cert_size)) {
+        assert(false);
+    }
+    spdm_context->local_context.peer_root_cert_provision_size[0] = 0;
+    spdm_context->local_context.peer_root_cert_provision[0] = NULL;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.req_base_asym_alg = m_libspdm_use_req_asym_algo;
+    spdm_context->local_context.is_requester = true;
+    libspdm_reset_message_b(spdm_context);
+
+    data_transfer_size = spdm_context->local_context.capability.data_transfer_size;
+    spdm_context->local_context.capability.data_transfer_size = 0x200;
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    portion_within_data_transfer_size = true;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PORTION_WITHIN_DATA_TRANSFER_SIZE,
+                              &parameter, &portion_within_data_transfer_size,
+                              sizeof(portion_within_data_transfer_size));
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    m_max_get_cert_length = 0;
+
+    cert_chain_size = sizeof(cert_chain);
+    libspdm_zero_mem(cert_chain, sizeof(cert_chain));
+    status = libspdm_get_certificate(spdm_context, NULL, 0, &cert_chain_size, cert_chain);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(cert_chain_size, data_size);
+    assert_memory_equal(cert_chain, data, data_size);
+    assert_int_equal(m_max_get_cert_length, 0x200 - sizeof(spdm_certificate_response_t));
+
+    portion_within_data_transfer_size = false;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_PORTION_WITHIN_DATA_TRANSFER_SIZE,
+                     &parameter, &portion_within_data_transfer_size,
+                     sizeof(portion_within_data_transfer_size));
+    spdm_context->local_context.capability.data_transfer_size = data_transfer_size;
+    free(data);
+}
+
 int libspdm_req_get_certificate_test(void)
 {
     const struct CMUnitTest test_cases[] = {
@@ -4794,6 +4934,8 @@ int libspdm_req_get_certificate_test(void)
         cmocka_unit_test(req_get_certificate_case32),
         /* Fail response: get slot storage size, portion length not zero */
         cmocka_unit_test(req_get_certificate_case33),
+        /* Successful response: portions fit in DataTransferSize */
+        cmocka_unit_test(req_get_certificate_case34),
     };
 
     libspdm_test_context_t test_context = {
@@ -2746,6 +2746,7 @@ static libspdm_return_t receive_message(
         uint8_t curr_rsp_enc_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
         uint8_t curr_rsp_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
         uint64_t curr_rsp_sequence_number;
+        void *curr_rsp_aead_context;
 
         spdm_response_size = sizeof(spdm_key_update_response_t);
         transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
@@ -2760,6 +2761,10 @@ static libspdm_return_t receive_message(
         secured_message_context = session_info->secured_message_context;
 
         /*use previous key to send*/
+        /* The keyed AEAD context holds the new key, so encode with the raw key. */
+        curr_rsp_aead_context = secured_message_context->application_secret
+                                .response_data_aead_context;
+        secured_message_context->application_secret.response_data_aead_context = NULL;
         libspdm_copy_mem(curr_rsp_enc_key, sizeof(curr_rsp_enc_key),
                          secured_message_context
                          ->application_secret.response_data_encryption_key,
@@ -2802,6 +2807,8 @@ static libspdm_return_t receive_message(
                                               spdm_response, response_size, response);
 
         /*restore new key*/
+        secured_message_context->application_secret.response_data_aead_context =
+            curr_rsp_aead_context;
         libspdm_copy_mem(secured_message_context->application_secret
                          .response_data_encryption_key,
                          sizeof(secured_message_context->application_secret
@@ -2832,6 +2839,7 @@ static libspdm_return_t receive_message(
         uint8_t curr_rsp_enc_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
         uint8_t curr_rsp_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
         uint64_t curr_rsp_sequence_number;
+        void *curr_rsp_aead_context;
 
         spdm_response_size = sizeof(spdm_key_update_response_t);
         transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
@@ -2846,6 +2854,10 @@ static libspdm_return_t receive_message(
         secured_message_context = session_info->secured_message_context;
 
         /*use previous key to send*/
+        /* The keyed AEAD context holds the new key, so encode with the raw key. */
+        curr_rsp_aead_context = secured_message_context->application_secret
+                                .response_data_aead_context;
+        secured_message_context->application_secret.response_data_aead_context = NULL;
         libspdm_copy_mem(curr_rsp_enc_key, sizeof(curr_rsp_enc_key),
                          secured_message_context
                          ->application_secret.response_data_encryption_key,
@@ -2891,6 +2903,8 @@ static libspdm_return_t receive_message(
                                               spdm_response, response_size, response);
 
         /*restore new key*/
+        secured_message_context->application_secret.response_data_aead_context =
+            curr_rsp_aead_context;
         libspdm_copy_mem(secured_message_context->application_secret
                          .response_data_encryption_key,
                          sizeof(secured_message_context->application_secret
@@ -2938,8 +2952,13 @@ static libspdm_return_t receive_message(
             uint8_t curr_rsp_enc_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
             uint8_t curr_rsp_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
             uint64_t curr_rsp_sequence_number;
+            void *curr_rsp_aead_context;
 
             /*use previous key to send*/
+            /* The keyed AEAD context holds the new key, so encode with the raw key. */
+            curr_rsp_aead_context = secured_message_context->application_secret
+                                    .response_data_aead_context;
+            secured_message_context->application_secret.response_data_aead_context = NULL;
             libspdm_copy_mem(curr_rsp_enc_key, sizeof(curr_rsp_enc_key),
                              secured_message_context
                              ->application_secret.response_data_encryption_key,
@@ -2985,6 +3004,8 @@ static libspdm_return_t receive_message(
                                                   response_size, response);
 
             /*restore new key*/
+            secured_message_context->application_secret.response_data_aead_context =
+                curr_rsp_aead_context;
             libspdm_copy_mem(secured_message_context->application_secret
                              .response_data_encryption_key,
                              sizeof(secured_message_context->application_secret
@@ -3086,6 +3107,7 @@ static libspdm_return_t receive_message(
         uint8_t curr_rsp_enc_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
         uint8_t curr_rsp_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
         uint64_t curr_rsp_sequence_number;
+        void *curr_rsp_aead_context;
 
         spdm_response_size = sizeof(spdm_error_response_t);
         transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
@@ -3100,6 +3122,10 @@ static libspdm_return_t receive_message(
         secured_message_context = session_info->secured_message_context;
 
         /*use previous key to send*/
+        /* The keyed AEAD context holds the new key, so encode with the raw key. */
+        curr_rsp_aead_context = secured_message_context->application_secret
+                                .response_data_aead_context;
+        secured_message_context->application_secret.response_data_aead_context = NULL;
         libspdm_copy_mem(curr_rsp_enc_key, sizeof(curr_rsp_enc_key),
                          secured_message_context
                          ->application_secret.response_data_encryption_key,
@@ -3142,6 +3168,8 @@ static libspdm_return_t receive_message(
                                               spdm_response, response_size, response);
 
         /*restore new key*/
+        secured_message_context->application_secret.response_data_aead_context =
+            curr_rsp_aead_context;
         libspdm_copy_mem(secured_message_context->application_secret
                          .response_data_encryption_key,
                          sizeof(secured_message_context->application_secret
@@ -3172,6 +3200,7 @@ static libspdm_return_t receive_message(
         uint8_t curr_rsp_enc_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
         uint8_t curr_rsp_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
         uint64_t curr_rsp_sequence_number;
+        void *curr_rsp_aead_context;
 
         spdm_response_size = sizeof(spdm_error_response_data_response_not_ready_t);
         transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
@@ -3186,6 +3215,10 @@ static libspdm_return_t receive_message(
         secured_message_context = session_info->secured_message_context;
 
         /*use previous key to send*/
+        /* The keyed AEAD context holds the new key, so encode with the raw key. */
+        curr_rsp_aead_context = secured_message_context->application_secret
+                                .response_data_aead_context;
+        secured_message_context->application_secret.response_data_aead_context = NULL;
         libspdm_copy_mem(curr_rsp_enc_key, sizeof(curr_rsp_enc_key),
                          secured_message_context
                          ->application_secret.response_data_encryption_key,
@@ -3236,6 +3269,8 @@ static libspdm_return_t receive_message(
                                               spdm_response, response_size, response);
 
         /*restore new key*/
+        secured_message_context->application_secret.response_data_aead_context =
+            curr_rsp_aead_context;
         libspdm_copy_mem(secured_message_context->application_secret
                          .response_data_encryption_key,
                          sizeof(secured_message_context->application_secret
@@ -3280,12 +3315,17 @@ static libspdm_return_t receive_message(
             uint8_t curr_rsp_enc_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
             uint8_t curr_rsp_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
             uint64_t curr_rsp_sequence_number;
+            void *curr_rsp_aead_context;
 
             spdm_response_size = sizeof(spdm_error_response_data_response_not_ready_t);
             transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
             spdm_response = (void *)((uint8_t *)*response + transport_header_size);
 
             /*use previous key to send*/
+            /* The keyed AEAD context holds the new key, so encode with the raw key. */
+            curr_rsp_aead_context = secured_message_context->application_secret
+                                    .response_data_aead_context;
+            secured_message_context->application_secret.response_data_aead_context = NULL;
             libspdm_copy_mem(curr_rsp_enc_key, sizeof(curr_rsp_enc_key),
                              secured_message_context
                              ->application_secret.response_data_encryption_key,
@@ -3337,6 +3377,8 @@ static libspdm_return_t receive_message(
                                                   response_size, response);
 
             /*restore new key*/
+            secured_message_context->application_secret.response_data_aead_context =
+                curr_rsp_aead_context;
             libspdm_copy_mem(secured_message_context->application_secret
                              .response_data_encryption_key,
                              sizeof(secured_message_context->application_secret
@@ -3441,6 +3483,7 @@ static libspdm_return_t receive_message(
         uint8_t curr_rsp_enc_key[LIBSPDM_MAX_AEAD_KEY_SIZE];
         uint8_t curr_rsp_salt[LIBSPDM_MAX_AEAD_IV_SIZE];
         uint64_t curr_rsp_sequence_number;
+        void *curr_rsp_aead_context;
 
         spdm_response_size = sizeof(spdm_error_response_t);
         transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
@@ -3460,6 +3503,10 @@ static libspdm_return_t receive_message(
                 error_code++;
             }
             /*use previous key to send*/
+            /* The keyed AEAD context holds the new key, so encode with the raw key. */
+            curr_rsp_aead_context = secured_message_context->application_secret
+                                    .response_data_aead_context;
+            secured_message_context->application_secret.response_data_aead_context = NULL;
             libspdm_copy_mem(curr_rsp_enc_key, sizeof(curr_rsp_enc_key),
                              secured_message_context
                              ->application_secret.response_data_encryption_key,
@@ -3505,6 +3552,8 @@ static libspdm_return_t receive_message(
                                                   response_size, response);
 
             /*restore new key*/
+            secured_message_context->application_secret.response_data_aead_context =
+                curr_rsp_aead_context;
             libspdm_copy_mem(secured_message_context->application_secret
                              .response_data_encryption_key,
                              sizeof(secured_message_context->application_secret
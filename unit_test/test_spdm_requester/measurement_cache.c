@@ -0,0 +1,469 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2025 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "internal/libspdm_requester_lib.h"
+#include "internal/libspdm_secured_message_lib.h"
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+
+#define LIBSPDM_MEASUREMENT_CACHE_TEST_SESSION_ID 0xFFFFFFFF
+
+/* The L1/L2 messages the Responder signs with the next signed MEASUREMENTS response. */
+static uint8_t m_libspdm_meas_cache_l1l2[LIBSPDM_MAX_MESSAGE_L1L2_BUFFER_SIZE];
+static size_t m_libspdm_meas_cache_l1l2_size;
+
+/* The state of the emulated Responder. */
+static bool m_libspdm_meas_cache_in_session;
+static uint8_t m_libspdm_meas_cache_measurement_value;
+static uint8_t m_libspdm_meas_cache_content_changed;
+static bool m_libspdm_meas_cache_last_request_signed;
+static uint8_t m_libspdm_meas_cache_last_request_operation;
+
+/* The number of GET_MEASUREMENTS requests, with and without signature. */
+static size_t m_libspdm_meas_cache_signed_count;
+static size_t m_libspdm_meas_cache_unsigned_count;
+
+static void libspdm_meas_cache_test_append_l1l2(const void *message, size_t message_size)
+{
+    libspdm_copy_mem(m_libspdm_meas_cache_l1l2 + m_libspdm_meas_cache_l1l2_size,
+                     sizeof(m_libspdm_meas_cache_l1l2) - m_libspdm_meas_cache_l1l2_size,
+                     message, message_size);
+    m_libspdm_meas_cache_l1l2_size += message_size;
+}
+
+static libspdm_return_t send_message(
+    void *spdm_context, size_t request_size, const void *request, uint64_t timeout)
+{
+    libspdm_context_t *context;
+    const spdm_get_measurements_request_t *spdm_request;
+
+    /* The plain request is kept by the requester before it is encoded for the transport. */
+    context = spdm_context;
+    spdm_request = context->last_spdm_request;
+    assert_int_equal(spdm_request->header.request_response_code, SPDM_GET_MEASUREMENTS);
+
+    m_libspdm_meas_cache_last_request_signed =
+        (spdm_request->header.param1 &
+         SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0;
+    m_libspdm_meas_cache_last_request_operation = spdm_request->header.param2;
+    if (m_libspdm_meas_cache_last_request_signed) {
+        m_libspdm_meas_cache_signed_count++;
+    } else {
+        m_libspdm_meas_cache_unsigned_count++;
+    }
+    libspdm_meas_cache_test_append_l1l2(context->last_spdm_request,
+                                        context->last_spdm_request_size);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t receive_message(
+    void *spdm_context, size_t *response_size, void **response, uint64_t timeout)
+{
+    spdm_measurements_response_t *spdm_response;
+    spdm_measurement_block_dmtf_t *measurement_block;
+    size_t measurement_hash_size;
+    size_t measurement_block_size;
+    size_t spdm_response_size;
+    size_t transport_header_size;
+    size_t sig_size;
+    uint32_t session_id;
+    libspdm_session_info_t *session_info;
+    uint8_t *scratch_buffer;
+    size_t scratch_buffer_size;
+    uint8_t *ptr;
+
+    measurement_hash_size = libspdm_get_measurement_hash_size(m_libspdm_use_measurement_hash_algo);
+    measurement_block_size = sizeof(spdm_measurement_block_dmtf_t) + measurement_hash_size;
+    transport_header_size = LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
+    spdm_response = (void *)((uint8_t *)*response + transport_header_size);
+
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0;
+    if (m_libspdm_meas_cache_last_request_signed) {
+        spdm_response->header.param2 = m_libspdm_meas_cache_content_changed;
+    }
+    spdm_response->number_of_blocks = 1;
+    libspdm_write_uint24(spdm_response->measurement_record_length,
+                         (uint32_t)measurement_block_size);
+
+    measurement_block = (void *)(spdm_response + 1);
+    libspdm_set_mem(measurement_block, measurement_block_size,
+                    m_libspdm_meas_cache_measurement_value);
+    measurement_block->measurement_block_common_header.index =
+        m_libspdm_meas_cache_last_request_operation;
+    measurement_block->measurement_block_common_header.measurement_specification =
+        SPDM_MEASUREMENT_SPECIFICATION_DMTF;
+    measurement_block->measurement_block_common_header.measurement_size =
+        (uint16_t)(sizeof(spdm_measurement_block_dmtf_header_t) + measurement_hash_size);
+    measurement_block->measurement_block_dmtf_header.dmtf_spec_measurement_value_type =
+        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_IMMUTABLE_ROM;
+    measurement_block->measurement_block_dmtf_header.dmtf_spec_measurement_value_size =
+        (uint16_t)measurement_hash_size;
+
+    ptr = (uint8_t *)measurement_block + measurement_block_size;
+    libspdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+    ptr += SPDM_NONCE_SIZE;
+    libspdm_write_uint16(ptr, 0);
+    ptr += sizeof(uint16_t);
+    spdm_response_size = ptr - (uint8_t *)spdm_response;
+
+    libspdm_meas_cache_test_append_l1l2(spdm_response, spdm_response_size);
+    if (m_libspdm_meas_cache_last_request_signed) {
+        sig_size = libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+        libspdm_responder_data_sign(
+            spdm_context,
+            spdm_response->header.spdm_version << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                0, SPDM_MEASUREMENTS,
+                m_libspdm_use_asym_algo, m_libspdm_use_pqc_asym_algo, m_libspdm_use_hash_algo,
+                false, m_libspdm_meas_cache_l1l2, m_libspdm_meas_cache_l1l2_size,
+                ptr, &sig_size);
+        spdm_response_size += sig_size;
+        m_libspdm_meas_cache_l1l2_size = 0;
+    }
+
+    if (!m_libspdm_meas_cache_in_session) {
+        libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                              spdm_response_size, spdm_response,
+                                              response_size, response);
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+
+    /* For secure message, message is in sender buffer, we need copy it to scratch buffer.
+     * transport_message is always in sender buffer. */
+    session_id = LIBSPDM_MEASUREMENT_CACHE_TEST_SESSION_ID;
+    libspdm_get_scratch_buffer(spdm_context, (void **)&scratch_buffer, &scratch_buffer_size);
+    libspdm_copy_mem(scratch_buffer + transport_header_size,
+                     scratch_buffer_size - transport_header_size,
+                     spdm_response, spdm_response_size);
+    spdm_response = (void *)(scratch_buffer + transport_header_size);
+    libspdm_transport_test_encode_message(spdm_context, &session_id, false, false,
+                                          spdm_response_size, spdm_response,
+                                          response_size, response);
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, session_id);
+    if (session_info == NULL) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    /* WALKAROUND: If just use single context to encode message and then decode message */
+    ((libspdm_secured_message_context_t *)(session_info->secured_message_context))
+    ->application_secret.response_data_sequence_number--;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Set up an authenticated SPDM 1.2 connection with the certificate chain of slot 0, and
+ * optionally a session that was established with that certificate chain. */
+static void libspdm_meas_cache_test_init_context(libspdm_context_t *spdm_context,
+                                                 bool in_session)
+{
+    libspdm_session_info_t *session_info;
+    void *data;
+    size_t data_size;
+    void *hash;
+    size_t hash_size;
+
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+    spdm_context->local_context.algorithm.measurement_spec = SPDM_MEASUREMENT_SPECIFICATION_DMTF;
+    spdm_context->connection_info.algorithm.measurement_spec = m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group = m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite = m_libspdm_use_aead_algo;
+
+    if (!libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                         m_libspdm_use_asym_algo, &data,
+                                                         &data_size, &hash, &hash_size)) {
+        assert(false);
+    }
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain[0].buffer_size = data_size;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain[0].buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain[0].buffer),
+                     data, data_size);
+#else
+    libspdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+                     data, data_size,
+                     spdm_context->connection_info.peer_used_cert_chain[0].buffer_hash);
+    spdm_context->connection_info.peer_used_cert_chain[0].buffer_hash_size =
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+    if (spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key == NULL) {
+        libspdm_get_leaf_cert_public_key_from_cert_chain(
+            spdm_context->connection_info.algorithm.base_hash_algo,
+            spdm_context->connection_info.algorithm.base_asym_algo,
+            data, data_size,
+            &spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
+    }
+#endif
+    free(data);
+
+    libspdm_reset_message_a(spdm_context);
+    libspdm_reset_message_m(spdm_context, NULL);
+    session_info = &spdm_context->session_info[0];
+    libspdm_session_info_init(spdm_context, session_info,
+                              in_session ? LIBSPDM_MEASUREMENT_CACHE_TEST_SESSION_ID :
+                              INVALID_SESSION_ID,
+                              SECURED_SPDM_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT, false);
+    if (in_session) {
+        session_info->peer_used_cert_chain_slot_id = 0;
+        libspdm_secured_message_set_session_state(session_info->secured_message_context,
+                                                  LIBSPDM_SESSION_STATE_ESTABLISHED);
+    }
+    libspdm_reset_measurement_cache(spdm_context);
+
+    m_libspdm_meas_cache_in_session = in_session;
+    m_libspdm_meas_cache_measurement_value = 1;
+    m_libspdm_meas_cache_content_changed = 0;
+    m_libspdm_meas_cache_l1l2_size = 0;
+    m_libspdm_meas_cache_signed_count = 0;
+    m_libspdm_meas_cache_unsigned_count = 0;
+}
+
+static libspdm_return_t libspdm_meas_cache_test_get_measurement(libspdm_context_t *spdm_context,
+                                                                bool *unchanged)
+{
+    uint32_t session_id;
+    uint8_t number_of_blocks;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    libspdm_return_t status;
+
+    session_id = LIBSPDM_MEASUREMENT_CACHE_TEST_SESSION_ID;
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_cached(spdm_context,
+                                            m_libspdm_meas_cache_in_session ? &session_id : NULL,
+                                            1, 0, unchanged, &number_of_blocks,
+                                            &measurement_record_length, measurement_record);
+    if (!LIBSPDM_STATUS_IS_ERROR(status)) {
+        assert_int_equal(number_of_blocks, 1);
+        assert_int_equal(measurement_record_length,
+                         sizeof(spdm_measurement_block_dmtf_t) +
+                         libspdm_get_measurement_hash_size(m_libspdm_use_measurement_hash_algo));
+        assert_int_equal(measurement_record[sizeof(spdm_measurement_block_dmtf_t)],
+                         m_libspdm_meas_cache_measurement_value);
+    }
+    return status;
+}
+
+/**
+ * Test 1: Outside of a session every request asks for a signature, and a record that matches the
+ * previous signed record is reported as unchanged.
+ * Expected Behavior: three signed requests, and only the second record is unchanged.
+ **/
+static void req_measurement_cache_case1(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    bool unchanged;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_meas_cache_test_init_context(spdm_context, false);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_true(unchanged);
+
+    m_libspdm_meas_cache_measurement_value = 2;
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 3);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 0);
+}
+
+/**
+ * Test 2: Inside a session established with the certificate chain of the slot, an unchanged record
+ * is read without a signature once it has been cached.
+ * Expected Behavior: one signed request, then one unsigned request for each further read.
+ **/
+static void req_measurement_cache_case2(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    bool unchanged;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_meas_cache_test_init_context(spdm_context, true);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 1);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 0);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_true(unchanged);
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_true(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 1);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 2);
+}
+
+/**
+ * Test 3: Inside a session, a record that differs from the cached one is read again with a
+ * signature, and the new record is cached.
+ * Expected Behavior: the changed record costs an unsigned and a signed request, and the next read
+ * of it is unsigned.
+ **/
+static void req_measurement_cache_case3(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    bool unchanged;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_meas_cache_test_init_context(spdm_context, true);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    m_libspdm_meas_cache_measurement_value = 2;
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 2);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 1);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_true(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 2);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 2);
+}
+
+/**
+ * Test 4: The signed response reports that the measurements changed while the transcript was
+ * built.
+ * Expected Behavior: the cache is emptied, so the next read is signed again.
+ **/
+static void req_measurement_cache_case4(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    bool unchanged;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_meas_cache_test_init_context(spdm_context, true);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    m_libspdm_meas_cache_measurement_value = 2;
+    m_libspdm_meas_cache_content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED;
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 2);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 1);
+
+    m_libspdm_meas_cache_content_changed = 0;
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 3);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 1);
+}
+
+/**
+ * Test 5: The total number of measurements is not cached, and the cache is emptied by
+ * libspdm_reset_measurement_cache and when the certificate chain of the slot is read again.
+ * Expected Behavior: LIBSPDM_STATUS_INVALID_PARAMETER without a request, and a signed read after
+ * each invalidation.
+ **/
+static void req_measurement_cache_case5(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    uint32_t session_id;
+    uint8_t number_of_blocks;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    bool unchanged;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    libspdm_meas_cache_test_init_context(spdm_context, true);
+
+    session_id = LIBSPDM_MEASUREMENT_CACHE_TEST_SESSION_ID;
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_cached(
+        spdm_context, &session_id,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS, 0,
+        &unchanged, &number_of_blocks, &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+    assert_int_equal(m_libspdm_meas_cache_signed_count + m_libspdm_meas_cache_unsigned_count, 0);
+
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_reset_measurement_cache(spdm_context);
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 2);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 0);
+
+    libspdm_invalidate_measurement_cache_slot(spdm_context, 0);
+    status = libspdm_meas_cache_test_get_measurement(spdm_context, &unchanged);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(unchanged);
+    assert_int_equal(m_libspdm_meas_cache_signed_count, 3);
+    assert_int_equal(m_libspdm_meas_cache_unsigned_count, 0);
+}
+
+int libspdm_req_measurement_cache_test(void)
+{
+    const struct CMUnitTest test_cases[] = {
+        cmocka_unit_test(req_measurement_cache_case1),
+        cmocka_unit_test(req_measurement_cache_case2),
+        cmocka_unit_test(req_measurement_cache_case3),
+        cmocka_unit_test(req_measurement_cache_case4),
+        cmocka_unit_test(req_measurement_cache_case5),
+    };
+
+    libspdm_test_context_t test_context = {
+        LIBSPDM_TEST_CONTEXT_VERSION,
+        true,
+        send_message,
+        receive_message,
+    };
+
+    libspdm_setup_test_context(&test_context);
+
+    return cmocka_run_group_tests(test_cases,
+                                  libspdm_unit_test_group_setup,
+                                  libspdm_unit_test_group_teardown);
+}
+
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
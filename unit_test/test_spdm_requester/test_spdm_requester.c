@@ -88,6 +88,18 @@ int libspdm_req_chunk_get_test(void);
 int libspdm_req_chunk_send_test(void);
 #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
+#if LIBSPDM_ASYNC_REQUESTER_SUPPORT && LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+int libspdm_req_async_test(void);
+#endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT && LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+int libspdm_req_measurement_cache_test(void);
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+#if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+int libspdm_req_concurrent_session_test(void);
+#endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
+
 #if LIBSPDM_EVENT_RECIPIENT_SUPPORT
 int libspdm_req_get_supported_event_types_test(void);
 int libspdm_req_get_supported_event_types_error_test(void);
@@ -301,6 +313,24 @@ int main(void)
     }
     #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
+    #if LIBSPDM_ASYNC_REQUESTER_SUPPORT && LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT
+    if (libspdm_req_async_test() != 0) {
+        return_value = 1;
+    }
+    #endif /* LIBSPDM_ASYNC_REQUESTER_SUPPORT && LIBSPDM_SEND_GET_CERTIFICATE_SUPPORT */
+
+    #if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    if (libspdm_req_measurement_cache_test() != 0) {
+        return_value = 1;
+    }
+    #endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+    #if LIBSPDM_CONCURRENT_SESSION_SUPPORT
+    if (libspdm_req_concurrent_session_test() != 0) {
+        return_value = 1;
+    }
+    #endif /* LIBSPDM_CONCURRENT_SESSION_SUPPORT */
+
     #if LIBSPDM_EVENT_RECIPIENT_SUPPORT
     if (libspdm_req_get_supported_event_types_test() != 0) {
         return_value = 1;
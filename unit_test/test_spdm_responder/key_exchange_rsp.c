@@ -2186,6 +2186,114 @@ static void rsp_key_exchange_rsp_case24(void **state)
     free(data1);
 }
 
+static uint8_t m_libspdm_pooled_dhe_public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+static size_t m_libspdm_pooled_dhe_public_key_size;
+static size_t m_libspdm_acquire_dhe_key_pair_count;
+
+static void *libspdm_test_acquire_dhe_key_pair(void *spdm_context, uint16_t dhe_named_group,
+                                               uint8_t *public_key, size_t *public_key_size)
+{
+    void *dhe_context;
+
+    m_libspdm_acquire_dhe_key_pair_count++;
+    dhe_context = libspdm_dhe_new(0, dhe_named_group, false);
+    m_libspdm_pooled_dhe_public_key_size = *public_key_size;
+    libspdm_dhe_generate_key(dhe_named_group, dhe_context, m_libspdm_pooled_dhe_public_key,
+                             &m_libspdm_pooled_dhe_public_key_size);
+    libspdm_copy_mem(public_key, *public_key_size,
+                     m_libspdm_pooled_dhe_public_key, m_libspdm_pooled_dhe_public_key_size);
+    *public_key_size = m_libspdm_pooled_dhe_public_key_size;
+    return dhe_context;
+}
+
+static void rsp_key_exchange_rsp_case25(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_key_exchange_response_t *spdm_response;
+    void *data1;
+    size_t data_size1;
+    uint8_t *ptr;
+    size_t dhe_key_size;
+    void *dhe_context;
+    size_t opaque_key_exchange_req_size;
+    uint32_t session_id;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x19;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+    spdm_context->local_context.capability.flags &=
+        ~SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec = m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group = m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite = m_libspdm_use_aead_algo;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data1,
+                                                    &data_size1, NULL, NULL);
+    spdm_context->local_context.local_cert_chain_provision[0] = data1;
+    spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
+
+    libspdm_reset_message_a(spdm_context);
+
+    spdm_context->local_context.secured_message_version.secured_message_version_count = 1;
+
+    status = libspdm_register_dhe_key_pair_func(spdm_context, libspdm_test_acquire_dhe_key_pair);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    m_libspdm_acquire_dhe_key_pair_count = 0;
+
+    libspdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
+                              m_libspdm_key_exchange_request1.random_data);
+    m_libspdm_key_exchange_request1.req_session_id = 0xFFFF;
+    m_libspdm_key_exchange_request1.reserved = 0;
+    ptr = m_libspdm_key_exchange_request1.exchange_data;
+    dhe_key_size = libspdm_get_dhe_pub_key_size(m_libspdm_use_dhe_algo);
+    dhe_context = libspdm_dhe_new(spdm_context->connection_info.version, m_libspdm_use_dhe_algo,
+                                  false);
+    libspdm_dhe_generate_key(m_libspdm_use_dhe_algo, dhe_context, ptr, &dhe_key_size);
+    ptr += dhe_key_size;
+    libspdm_dhe_free(m_libspdm_use_dhe_algo, dhe_context);
+    opaque_key_exchange_req_size =
+        libspdm_get_opaque_data_supported_version_data_size(spdm_context);
+    *(uint16_t *)ptr = (uint16_t)opaque_key_exchange_req_size;
+    ptr += sizeof(uint16_t);
+    libspdm_build_opaque_data_supported_version_data(
+        spdm_context, &opaque_key_exchange_req_size, ptr);
+    ptr += opaque_key_exchange_req_size;
+    response_size = sizeof(response);
+    status = libspdm_get_response_key_exchange(
+        spdm_context, m_libspdm_key_exchange_request1_size,
+        &m_libspdm_key_exchange_request1, &response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code, SPDM_KEY_EXCHANGE_RSP);
+    assert_int_equal(m_libspdm_acquire_dhe_key_pair_count, 1);
+    assert_int_equal(m_libspdm_pooled_dhe_public_key_size, dhe_key_size);
+    assert_memory_equal(spdm_response + 1, m_libspdm_pooled_dhe_public_key, dhe_key_size);
+
+    session_id = libspdm_generate_session_id(m_libspdm_key_exchange_request1.req_session_id,
+                                             spdm_response->rsp_session_id);
+    libspdm_free_session_id(spdm_context, session_id);
+    libspdm_register_dhe_key_pair_func(spdm_context, NULL);
+    free(data1);
+}
+
 int libspdm_rsp_key_exchange_rsp_test(void)
 {
     const struct CMUnitTest test_cases[] = {
@@ -2233,6 +2341,8 @@ int libspdm_rsp_key_exchange_rsp_test(void)
         /* The Responder requires mutual authentication, but the Requester does not support it */
         cmocka_unit_test(rsp_key_exchange_rsp_case23),
         cmocka_unit_test(rsp_key_exchange_rsp_case24),
+        /* The Integrator provides the DHE key pair */
+        cmocka_unit_test(rsp_key_exchange_rsp_case25),
     };
 
     libspdm_test_context_t test_context = {
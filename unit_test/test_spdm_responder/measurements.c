@@ -1638,8 +1638,9 @@ static void rsp_measurements_case26(void **state)
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
 #endif
+    /* the first signed MEASUREMENTS of the context reports a change */
     assert_int_equal(spdm_response->header.param2, m_libspdm_get_measurements_request15.slot_id_param|
-                     (SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED &
+                     (SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED &
                       SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK));
 
     free(data);
@@ -2757,6 +2758,152 @@ static void rsp_measurements_case36(void **state)
     assert_int_equal(spdm_response->header.param2, 0);
 }
 
+/* Read all measurements with a signature, and return the reported content change. */
+static uint8_t libspdm_test_get_measurement_content_changed(void *spdm_context)
+{
+    libspdm_return_t status;
+    uint8_t measurement_record[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    size_t measurement_record_size;
+    uint8_t measurements_count;
+    uint8_t content_changed;
+
+    measurement_record_size = sizeof(measurement_record);
+    status = libspdm_measurement_collection(
+        spdm_context, SPDM_MESSAGE_VERSION_13 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        m_libspdm_use_measurement_spec, m_libspdm_use_measurement_hash_algo,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0, NULL,
+        &content_changed, &measurements_count, measurement_record, &measurement_record_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    return content_changed;
+}
+
+/**
+ * Test 37: Append an entry to the measurement extension log
+ * Expected Behavior: the HEM measurement block is extended with the new entry, and the change is
+ * reported once to each context, in its next signed measurements
+ **/
+static void rsp_measurements_case37(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t measurement_record[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    size_t measurement_record_size;
+    uint8_t measurements_count;
+    uint8_t content_changed;
+    spdm_measurement_block_dmtf_t *measurement_block;
+    uint8_t verify_hem[LIBSPDM_MAX_HASH_SIZE + sizeof(spdm_mel_entry_dmtf_t) + sizeof(uint32_t)];
+    spdm_mel_entry_dmtf_t *mel_entry;
+    uint8_t expected_hem[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t version;
+    size_t hash_size;
+    void *other_spdm_context;
+    uint8_t evicting_context[64];
+    size_t index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 37;
+    hash_size = libspdm_get_measurement_hash_size(m_libspdm_use_measurement_hash_algo);
+    measurement_block = (void *)measurement_record;
+
+    libspdm_reset_mel();
+    measurement_record_size = sizeof(measurement_record);
+    status = libspdm_measurement_collection(
+        spdm_context, SPDM_MESSAGE_VERSION_13 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        m_libspdm_use_measurement_spec, m_libspdm_use_measurement_hash_algo,
+        LIBSPDM_MEASUREMENT_INDEX_HEM, 0, 0, NULL, &content_changed, &measurements_count,
+        measurement_record, &measurement_record_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(measurements_count, 1);
+    assert_int_equal(measurement_record_size, sizeof(spdm_measurement_block_dmtf_t) + hash_size);
+
+    version = 0x0100030B;
+    libspdm_copy_mem(verify_hem, sizeof(verify_hem), measurement_block + 1, hash_size);
+    mel_entry = (void *)(verify_hem + hash_size);
+    mel_entry->mel_index = 4;
+    mel_entry->meas_index = LIBSPDM_MEASUREMENT_INDEX_HEM;
+    libspdm_write_uint24(mel_entry->reserved, 0);
+    mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_type =
+        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_VERSION |
+        SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
+    mel_entry->measurement_block_dmtf_header.dmtf_spec_measurement_value_size = sizeof(version);
+    libspdm_copy_mem(mel_entry + 1, sizeof(version), &version, sizeof(version));
+    libspdm_measurement_hash_all(m_libspdm_use_measurement_hash_algo, verify_hem,
+                                 hash_size + sizeof(spdm_mel_entry_dmtf_t) + sizeof(version),
+                                 expected_hem);
+
+    assert_true(libspdm_append_mel_entry(
+                    LIBSPDM_MEASUREMENT_INDEX_HEM,
+                    SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_VERSION |
+                    SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM,
+                    &version, sizeof(version)));
+
+    measurement_record_size = sizeof(measurement_record);
+    status = libspdm_measurement_collection(
+        spdm_context, SPDM_MESSAGE_VERSION_13 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        m_libspdm_use_measurement_spec, m_libspdm_use_measurement_hash_algo,
+        LIBSPDM_MEASUREMENT_INDEX_HEM, 0, 0, NULL, &content_changed, &measurements_count,
+        measurement_record, &measurement_record_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_memory_equal(measurement_block + 1, expected_hem, hash_size);
+
+    /* the change is reported once to each context, in its next signed MEASUREMENTS */
+    measurement_record_size = sizeof(measurement_record);
+    status = libspdm_measurement_collection(
+        spdm_context, SPDM_MESSAGE_VERSION_13 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        m_libspdm_use_measurement_spec, m_libspdm_use_measurement_hash_algo,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0, NULL,
+        &content_changed, &measurements_count, measurement_record, &measurement_record_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(content_changed, SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+
+    measurement_record_size = sizeof(measurement_record);
+    status = libspdm_measurement_collection(
+        spdm_context, SPDM_MESSAGE_VERSION_13 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        m_libspdm_use_measurement_spec, m_libspdm_use_measurement_hash_algo,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0, NULL,
+        &content_changed, &measurements_count, measurement_record, &measurement_record_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(content_changed, SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+
+    /* a context without a report is told of a change, then every context gets it once */
+    other_spdm_context = malloc(libspdm_get_context_size());
+    assert_non_null(other_spdm_context);
+    libspdm_init_context(other_spdm_context);
+    assert_int_equal(libspdm_test_get_measurement_content_changed(other_spdm_context),
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+    assert_int_equal(libspdm_test_get_measurement_content_changed(other_spdm_context),
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+    assert_true(libspdm_append_mel_entry(
+                    LIBSPDM_MEASUREMENT_INDEX_HEM,
+                    SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_VERSION |
+                    SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM,
+                    &version, sizeof(version)));
+    assert_int_equal(libspdm_test_get_measurement_content_changed(other_spdm_context),
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+    assert_int_equal(libspdm_test_get_measurement_content_changed(other_spdm_context),
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+    assert_int_equal(libspdm_test_get_measurement_content_changed(spdm_context),
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+
+    /* a context whose report was evicted by many others is told of a change again */
+    for (index = 0; index < sizeof(evicting_context); index++) {
+        libspdm_test_get_measurement_content_changed(&evicting_context[index]);
+    }
+    assert_int_equal(libspdm_test_get_measurement_content_changed(other_spdm_context),
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+    assert_int_equal(libspdm_test_get_measurement_content_changed(other_spdm_context),
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+    libspdm_deinit_context(other_spdm_context);
+    free(other_spdm_context);
+
+    libspdm_reset_mel();
+}
+
 int libspdm_rsp_measurements_test(void)
 {
     m_libspdm_get_measurements_request11.slot_id_param = SPDM_MAX_SLOT_COUNT - 1;
@@ -2835,6 +2982,8 @@ int libspdm_rsp_measurements_test(void)
         cmocka_unit_test(rsp_measurements_case35),
         /* The key usage bit mask is not set, failed Case*/
         cmocka_unit_test(rsp_measurements_case36),
+        /* Appending a MEL entry extends the HEM */
+        cmocka_unit_test(rsp_measurements_case37),
     };
 
     libspdm_test_context_t test_context = {
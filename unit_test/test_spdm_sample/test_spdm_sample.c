@@ -85,6 +85,99 @@ void libspdm_test_spdm_verify_cert_chain_callback_function(void **state)
     free(spdm_context);
 }
 
+static size_t m_libspdm_cert_chain_verify_count;
+
+static bool libspdm_test_verify_spdm_cert_chain_counted(void *spdm_context, uint8_t slot_id,
+                                                        size_t cert_chain_size,
+                                                        const void *cert_chain,
+                                                        const void **trust_anchor,
+                                                        size_t *trust_anchor_size)
+{
+    m_libspdm_cert_chain_verify_count++;
+    return libspdm_verify_spdm_cert_chain_with_dice(spdm_context, slot_id, cert_chain_size,
+                                                    cert_chain, trust_anchor, trust_anchor_size);
+}
+
+void libspdm_test_spdm_verify_cert_chain_with_cache(void **state)
+{
+    bool status;
+    libspdm_context_t *spdm_context[2];
+    size_t index;
+    void *cert_chain;
+    size_t cert_chain_size;
+    void *root_cert;
+    size_t root_cert_size;
+    const void *trust_anchor;
+    size_t trust_anchor_size;
+    uint8_t cert_chain_hash[LIBSPDM_MAX_HASH_SIZE];
+
+    status = libspdm_read_dice_certificate_chain(&root_cert, &root_cert_size, false);
+    assert_true(status);
+    status = libspdm_read_dice_certificate_chain(&cert_chain, &cert_chain_size, true);
+    assert_true(status);
+
+    for (index = 0; index < LIBSPDM_ARRAY_SIZE(spdm_context); index++) {
+        spdm_context[index] = (void *)malloc(libspdm_get_context_size());
+        assert_non_null(spdm_context[index]);
+        libspdm_init_context(spdm_context[index]);
+        spdm_context[index]->local_context.is_requester = true;
+        spdm_context[index]->connection_info.algorithm.base_hash_algo =
+            SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384;
+        spdm_context[index]->connection_info.algorithm.base_asym_algo =
+            SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384;
+        spdm_context[index]->local_context.peer_root_cert_provision_size[0] = root_cert_size;
+        spdm_context[index]->local_context.peer_root_cert_provision[0] = root_cert;
+    }
+
+    libspdm_cert_chain_cache_flush();
+    libspdm_cert_chain_cache_set_verify_func(libspdm_test_verify_spdm_cert_chain_counted);
+    m_libspdm_cert_chain_verify_count = 0;
+
+    /* The first context verifies the chain. */
+    status = libspdm_verify_spdm_cert_chain_with_cache(spdm_context[0], 0, cert_chain_size,
+                                                       cert_chain, NULL, NULL);
+    assert_true(status);
+    assert_int_equal(m_libspdm_cert_chain_verify_count, 1);
+
+    /* The second context finds the verified chain and its trust anchor in the cache. */
+    trust_anchor = NULL;
+    trust_anchor_size = 0;
+    status = libspdm_verify_spdm_cert_chain_with_cache(spdm_context[1], 0, cert_chain_size,
+                                                       cert_chain, &trust_anchor,
+                                                       &trust_anchor_size);
+    assert_true(status);
+    assert_int_equal(m_libspdm_cert_chain_verify_count, 1);
+    assert_ptr_equal(trust_anchor, root_cert);
+    assert_int_equal(trust_anchor_size, root_cert_size);
+
+    /* The digest from DIGESTS installs the chain without GET_CERTIFICATE. */
+    status = libspdm_hash_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+                              cert_chain, cert_chain_size, cert_chain_hash);
+    assert_true(status);
+    status = libspdm_cert_chain_cache_set_peer_cert_chain(spdm_context[1], 1, cert_chain_hash);
+    assert_true(status);
+
+    /* A different trust anchor does not match the cached result. */
+    spdm_context[1]->local_context.peer_root_cert_provision_size[0] = root_cert_size - 1;
+    status = libspdm_cert_chain_cache_set_peer_cert_chain(spdm_context[1], 1, cert_chain_hash);
+    assert_false(status);
+
+    libspdm_cert_chain_cache_flush();
+    status = libspdm_verify_spdm_cert_chain_with_cache(spdm_context[0], 0, cert_chain_size,
+                                                       cert_chain, NULL, NULL);
+    assert_true(status);
+    assert_int_equal(m_libspdm_cert_chain_verify_count, 2);
+
+    libspdm_cert_chain_cache_flush();
+    libspdm_cert_chain_cache_set_verify_func(NULL);
+    for (index = 0; index < LIBSPDM_ARRAY_SIZE(spdm_context); index++) {
+        libspdm_deinit_context(spdm_context[index]);
+        free(spdm_context[index]);
+    }
+    free(root_cert);
+    free(cert_chain);
+}
+
 void libspdm_test_spdm_verify_cert_dicetcdinfo(void **state)
 {
     bool status;
@@ -104,6 +197,113 @@ void libspdm_test_spdm_verify_cert_dicetcdinfo(void **state)
     free(file_data);
 }
 
+/* Sign a message with the responder key of key_pair_id, using the sample device secret library. */
+static bool libspdm_test_sign_with_key_pair(libspdm_context_t *spdm_context, uint8_t key_pair_id)
+{
+    uint8_t message[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t signature[LIBSPDM_MAX_ASYM_SIG_SIZE];
+    size_t signature_size;
+
+    libspdm_set_mem(message, sizeof(message), (uint8_t)key_pair_id);
+    signature_size = sizeof(signature);
+    return libspdm_responder_data_sign(
+        spdm_context, SPDM_MESSAGE_VERSION_13 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        key_pair_id, SPDM_CHALLENGE_AUTH,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384, 0,
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, false,
+        message, sizeof(message), signature, &signature_size);
+}
+
+static bool libspdm_test_is_key_pair_cached(uint8_t key_pair_id)
+{
+    return libspdm_is_signing_key_cached(
+        false, key_pair_id, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384, 0);
+}
+
+void libspdm_test_signing_key_cache(void **state)
+{
+    bool status;
+    libspdm_context_t *spdm_context;
+    uint8_t key_pair_id;
+#if (LIBSPDM_ENABLE_CAPABILITY_SET_KEY_PAIR_INFO_CAP) || (LIBSPDM_ENABLE_CAPABILITY_SET_CERT_CAP)
+    bool need_reset;
+#endif
+#if LIBSPDM_ENABLE_CAPABILITY_SET_CERT_CAP
+    uint8_t cert_chain[0x10];
+    bool is_busy;
+#endif
+
+    spdm_context = (void *)malloc(libspdm_get_context_size());
+    assert_non_null(spdm_context);
+    libspdm_init_context(spdm_context);
+    spdm_context->connection_info.multi_key_conn_rsp = true;
+
+    libspdm_clear_signing_key_cache();
+    assert_false(libspdm_test_is_key_pair_cached(1));
+
+    /* The first signature reads the key and the second one finds it in the cache. */
+    status = libspdm_test_sign_with_key_pair(spdm_context, 1);
+    assert_true(status);
+    assert_true(libspdm_test_is_key_pair_cached(1));
+    status = libspdm_test_sign_with_key_pair(spdm_context, 1);
+    assert_true(status);
+    assert_true(libspdm_test_is_key_pair_cached(1));
+
+    /* Fill the cache. A hit does not take a new entry, so key pair 1 is the next one evicted. */
+    for (key_pair_id = 2; key_pair_id <= 8; key_pair_id++) {
+        status = libspdm_test_sign_with_key_pair(spdm_context, key_pair_id);
+        assert_true(status);
+    }
+    status = libspdm_test_sign_with_key_pair(spdm_context, 1);
+    assert_true(status);
+    status = libspdm_test_sign_with_key_pair(spdm_context, 9);
+    assert_true(status);
+    assert_false(libspdm_test_is_key_pair_cached(1));
+    for (key_pair_id = 2; key_pair_id <= 9; key_pair_id++) {
+        assert_true(libspdm_test_is_key_pair_cached(key_pair_id));
+    }
+
+    libspdm_clear_signing_key_cache();
+    for (key_pair_id = 1; key_pair_id <= 9; key_pair_id++) {
+        assert_false(libspdm_test_is_key_pair_cached(key_pair_id));
+    }
+
+#if LIBSPDM_ENABLE_CAPABILITY_SET_KEY_PAIR_INFO_CAP
+    /* Changing a key pair drops the cached keys. */
+    status = libspdm_test_sign_with_key_pair(spdm_context, 1);
+    assert_true(status);
+    assert_true(libspdm_test_is_key_pair_cached(1));
+    need_reset = false;
+    status = libspdm_write_key_pair_info(
+        spdm_context, 1, SPDM_SET_KEY_PAIR_INFO_GENERATE_OPERATION,
+        SPDM_KEY_USAGE_BIT_MASK_CHALLENGE_USE,
+        SPDM_KEY_PAIR_ASYM_ALGO_CAP_ECC384, 0, 0x02, &need_reset);
+    assert_true(status);
+    assert_false(libspdm_test_is_key_pair_cached(1));
+#endif
+
+#if LIBSPDM_ENABLE_CAPABILITY_SET_CERT_CAP
+    /* Writing a certificate chain drops the cached keys. */
+    status = libspdm_test_sign_with_key_pair(spdm_context, 1);
+    assert_true(status);
+    assert_true(libspdm_test_is_key_pair_cached(1));
+    libspdm_set_mem(cert_chain, sizeof(cert_chain), 0x5a);
+    need_reset = false;
+    is_busy = false;
+    status = libspdm_write_certificate_to_nvm(
+        spdm_context, 1, cert_chain, sizeof(cert_chain),
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384, 0, &need_reset, &is_busy);
+    assert_true(status);
+    assert_false(libspdm_test_is_key_pair_cached(1));
+    remove("slot_id_1_cert_chain.der");
+#endif
+
+    libspdm_clear_signing_key_cache();
+    libspdm_deinit_context(spdm_context);
+    free(spdm_context);
+}
+
 int libspdm_spdm_sample_setup(void **state)
 {
     return 0;
@@ -121,6 +321,10 @@ int libspdm_spdm_sample_test_main(void)
             libspdm_test_spdm_verify_cert_chain_callback_function),
         cmocka_unit_test(
             libspdm_test_spdm_verify_cert_dicetcdinfo),
+        cmocka_unit_test(
+            libspdm_test_spdm_verify_cert_chain_with_cache),
+        cmocka_unit_test(
+            libspdm_test_signing_key_cache),
     };
 
     return cmocka_run_group_tests(spdm_sample_tests,
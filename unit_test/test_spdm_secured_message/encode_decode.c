@@ -897,6 +897,206 @@ static void libspdm_test_secured_message_encode_case12(void **state)
                      decode_secured_message_context.application_secret.request_data_sequence_number);
 }
 
+/**
+ * Test 13: Test decryption with the replay window enabled.
+ *          Messages within the window are accepted out of order, replayed messages and messages
+ *          that fall behind the window are rejected.
+ **/
+static void libspdm_test_secured_message_encode_case13(void **state)
+{
+    libspdm_return_t status;
+    uint8_t encode_app_message[16];
+    uint8_t secured_message[3][0x100];
+    size_t secured_message_size[3];
+    libspdm_secured_message_context_t encode_secured_message_context;
+    libspdm_secured_message_context_t decode_secured_message_context;
+    void *decode_app_message;
+    size_t decode_app_message_size;
+    const uint8_t decode_order[] = { 1, 0, 0, 2, 0 };
+    const libspdm_return_t decode_status[] = {
+        LIBSPDM_STATUS_SUCCESS, LIBSPDM_STATUS_SUCCESS, LIBSPDM_STATUS_INVALID_MSG_FIELD,
+        LIBSPDM_STATUS_SUCCESS, LIBSPDM_STATUS_INVALID_MSG_FIELD
+    };
+
+    const uint32_t session_id = 0x00112233;
+
+    initialize_secured_message_context();
+    libspdm_copy_mem(&encode_secured_message_context, sizeof(encode_secured_message_context),
+                     &m_secured_message_context, sizeof(m_secured_message_context));
+    encode_secured_message_context.sequence_number_endian =
+        LIBSPDM_DATA_SESSION_SEQ_NUM_ENC_LITTLE_DEC_LITTLE;
+
+    for (uint8_t message = 0; message < 3; message++) {
+        for (uint8_t index = 0; index < 16; index++) {
+            encode_app_message[index] = message + index;
+        }
+        secured_message_size[message] = sizeof(secured_message[message]);
+        status = libspdm_encode_secured_message(
+            &encode_secured_message_context, session_id, true,
+            sizeof(encode_app_message), encode_app_message, &secured_message_size[message],
+            secured_message[message], &m_secured_message_callbacks);
+        assert_int_equal(LIBSPDM_STATUS_SUCCESS, status);
+    }
+
+    libspdm_copy_mem(&decode_secured_message_context, sizeof(decode_secured_message_context),
+                     &m_secured_message_context, sizeof(m_secured_message_context));
+    decode_secured_message_context.sequence_number_endian =
+        LIBSPDM_DATA_SESSION_SEQ_NUM_ENC_LITTLE_DEC_LITTLE;
+    libspdm_secured_message_set_replay_window_size(&decode_secured_message_context, 2);
+
+    for (uint8_t step = 0; step < sizeof(decode_order); step++) {
+        decode_app_message = m_app_message;
+        decode_app_message_size = sizeof(m_app_message);
+        status = libspdm_decode_secured_message(
+            &decode_secured_message_context, session_id, true,
+            secured_message_size[decode_order[step]], secured_message[decode_order[step]],
+            &decode_app_message_size, &decode_app_message, &m_secured_message_callbacks);
+        assert_int_equal(decode_status[step], status);
+
+        if (status == LIBSPDM_STATUS_SUCCESS) {
+            for (uint8_t index = 0; index < 16; index++) {
+                assert_int_equal(decode_order[step] + index,
+                                 ((uint8_t *)decode_app_message)[index]);
+            }
+        }
+    }
+
+    /* The next expected sequence number follows the highest one received. */
+    assert_int_equal(3,
+                     decode_secured_message_context.application_secret.request_data_sequence_number);
+    assert_int_equal(0x7,
+                     decode_secured_message_context.application_secret.request_data_replay_bitmap);
+}
+
+/**
+ * Test 14: Test encryption from fragments. The first fragment already sits at its place in the
+ *          secured message and the second one is gathered into it.
+ *          This has the same result as test 1.
+ **/
+static void libspdm_test_secured_message_encode_case14(void **state)
+{
+    libspdm_return_t status;
+    uint8_t app_message[16];
+    libspdm_secured_message_fragment_t fragments[2];
+    size_t secured_message_size = sizeof(m_secured_message);
+    const uint32_t session_id = 0x00112233;
+    size_t offset;
+    uint8_t *ptr;
+
+    initialize_secured_message_context();
+
+    for (uint8_t index = 0; index < 16; index++) {
+        app_message[index] = index;
+    }
+
+    offset = libspdm_secured_message_get_app_message_offset(&m_secured_message_context,
+                                                            &m_secured_message_callbacks);
+    assert_int_equal(4 + PARTIAL_SEQ_NUM_SIZE + 2 + 2, offset);
+
+    libspdm_zero_mem(m_secured_message, sizeof(m_secured_message));
+    libspdm_copy_mem(m_secured_message + offset, sizeof(m_secured_message) - offset,
+                     app_message, 5);
+    fragments[0].data = m_secured_message + offset;
+    fragments[0].size = 5;
+    fragments[1].data = app_message + 5;
+    fragments[1].size = sizeof(app_message) - 5;
+
+    status = libspdm_encode_secured_message_fragments(
+        &m_secured_message_context, session_id, true,
+        LIBSPDM_ARRAY_SIZE(fragments), fragments, &secured_message_size, m_secured_message,
+        &m_secured_message_callbacks);
+
+    assert_int_equal(LIBSPDM_STATUS_SUCCESS, status);
+    assert_int_equal(4 + PARTIAL_SEQ_NUM_SIZE + 2 + 0x22, secured_message_size);
+    assert_memory_equal(&session_id, &m_secured_message, 4);
+    assert_int_equal(0x0022, *(uint16_t*)&m_secured_message[4 + PARTIAL_SEQ_NUM_SIZE]);
+
+    ptr = (uint8_t *)&m_secured_message + 6 + PARTIAL_SEQ_NUM_SIZE;
+
+    uint8_t expected_cipher_text[] = {0x9b, 0xfe, 0xd3, 0xb7, 0x04, 0x3d, 0x32, 0x86, 0x60, 0x3d,
+                                      0x86, 0x17, 0x33, 0xd6, 0x7f, 0x95, 0x9a, 0x20};
+    uint8_t expected_mac[] = {0x3d, 0x4f, 0xac, 0x58, 0xcb, 0x70, 0x6c, 0xf5, 0xa0, 0x27, 0x0a,
+                              0xf6, 0x73, 0xf0, 0xfe, 0x36};
+
+    assert_memory_equal(expected_cipher_text, ptr, sizeof(expected_cipher_text));
+    ptr += sizeof(expected_cipher_text);
+    assert_memory_equal(expected_mac, ptr, sizeof(expected_mac));
+
+    assert_int_equal(1, m_secured_message_context.application_secret.request_data_sequence_number);
+}
+
+/**
+ * Test 15: Test decryption in place. The application message is returned inside of the secured
+ *          message, and a message that fails to authenticate leaves no plain text behind.
+ *          This uses the same plaintext as test 1.
+ **/
+static void libspdm_test_secured_message_encode_case15(void **state)
+{
+    libspdm_return_t status;
+    size_t app_message_size;
+    void *app_message;
+    const uint32_t session_id = 0x00112233;
+
+    uint8_t secured_message[] = {
+        /* Session id. */
+        0x33, 0x22, 0x11, 0x00,
+        /* Sequence number. */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        /* Total length. */
+        0x22, 0x00,
+        /* Encrypted application data length. */
+        0x9b, 0xfe,
+        /* Encrypted application data. */
+        0xd3, 0xb7, 0x04, 0x3d, 0x32, 0x86, 0x60, 0x3d,
+        0x86, 0x17, 0x33, 0xd6, 0x7f, 0x95, 0x9a, 0x20,
+        /* MAC. */
+        0x3d, 0x4f, 0xac, 0x58, 0xcb, 0x70, 0x6c, 0xf5,
+        0xa0, 0x27, 0x0a, 0xf6, 0x73, 0xf0, 0xfe, 0x36
+    };
+
+    initialize_secured_message_context();
+    m_secured_message_context.sequence_number_endian =
+        LIBSPDM_DATA_SESSION_SEQ_NUM_ENC_LITTLE_DEC_LITTLE;
+
+    libspdm_copy_mem(m_secured_message, sizeof(m_secured_message),
+                     secured_message, sizeof(secured_message));
+
+    status = libspdm_decode_secured_message_in_place(
+        &m_secured_message_context, session_id, true,
+        sizeof(secured_message), m_secured_message, &app_message_size, &app_message,
+        &m_secured_message_callbacks);
+
+    assert_int_equal(LIBSPDM_STATUS_SUCCESS, status);
+    assert_int_equal(16, app_message_size);
+    assert_ptr_equal(m_secured_message + 6 + PARTIAL_SEQ_NUM_SIZE + 2, app_message);
+
+    for (int index = 0; index < 16; index++) {
+        assert_int_equal(index, ((uint8_t *)app_message)[index]);
+    }
+
+    assert_int_equal(1, m_secured_message_context.application_secret.request_data_sequence_number);
+
+    /* Corrupt the MAC. */
+    initialize_secured_message_context();
+    m_secured_message_context.sequence_number_endian =
+        LIBSPDM_DATA_SESSION_SEQ_NUM_ENC_LITTLE_DEC_LITTLE;
+
+    libspdm_copy_mem(m_secured_message, sizeof(m_secured_message),
+                     secured_message, sizeof(secured_message));
+    m_secured_message[sizeof(secured_message) - 1] ^= 0xff;
+
+    status = libspdm_decode_secured_message_in_place(
+        &m_secured_message_context, session_id, true,
+        sizeof(secured_message), m_secured_message, &app_message_size, &app_message,
+        &m_secured_message_callbacks);
+
+    assert_int_equal(LIBSPDM_STATUS_CRYPTO_ERROR, status);
+
+    for (int index = 6 + PARTIAL_SEQ_NUM_SIZE; index < 6 + PARTIAL_SEQ_NUM_SIZE + 18; index++) {
+        assert_int_equal(0, m_secured_message[index]);
+    }
+}
+
 libspdm_test_context_t m_libspdm_common_context_data_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     true,
@@ -919,6 +1119,9 @@ int libspdm_secured_message_encode_decode_test_main(void)
         cmocka_unit_test(libspdm_test_secured_message_encode_case10),
         cmocka_unit_test(libspdm_test_secured_message_encode_case11),
         cmocka_unit_test(libspdm_test_secured_message_encode_case12),
+        cmocka_unit_test(libspdm_test_secured_message_encode_case13),
+        cmocka_unit_test(libspdm_test_secured_message_encode_case14),
+        cmocka_unit_test(libspdm_test_secured_message_encode_case15),
     };
 
     libspdm_setup_test_context(&m_libspdm_common_context_data_test_context);